@@ -426,6 +426,36 @@ static void CommitToText(const char* stream, uint32 *curPos, PQExpBuffer res)
     }
 }
 
+/*
+ * summarize a column block of decode style 'c'
+ */
+static void ColumnBlockToText(const char* stream, PQExpBuffer res)
+{
+    uint32 pos = 1;
+    appendPQExpBufferStr(res, "COLUMN BLOCK ");
+    if (stream[pos] == 'L') {
+        pos++;
+        uint32 rawLen = ntohl(*(uint32 *)(&stream[pos]));
+        appendPQExpBuffer(res, "compressed raw_len: %u", rawLen);
+        return;
+    }
+    pos++;
+    char dtype = stream[pos];
+    pos++;
+    uint32 nrows = ntohl(*(uint32 *)(&stream[pos]));
+    pos += sizeof(nrows);
+    appendPQExpBuffer(res, "%s rows: %u table: ", dtype == 'I' ? "INSERT" : (dtype == 'U' ? "UPDATE" : "DELETE"),
+        nrows);
+    uint16 schemaLen = ntohs(*(uint16 *)(stream + pos));
+    pos += sizeof(schemaLen);
+    appendBinaryPQExpBuffer(res, stream + pos, schemaLen);
+    pos += schemaLen;
+    appendPQExpBufferChar(res, '.');
+    uint16 tableLen = ntohs(*(uint16 *)(stream + pos));
+    pos += sizeof(tableLen);
+    appendBinaryPQExpBuffer(res, stream + pos, tableLen);
+}
+
 /*
  * decode binary style log stream to text
  */
@@ -446,6 +476,9 @@ static void StreamToText(const char* stream, PQExpBuffer res)
     appendPQExpBuffer(res, "current_lsn: %X/%X ", LSNupper, LSNlower);
     if (stream[pos] == 'B') {
         BeginToText(stream, &pos, res);
+    } else if (stream[pos] == 'K') {
+        ColumnBlockToText(stream + pos, res);
+        pos = sizeof(dmlLen) + dmlLen;
     } else if (stream[pos] == 'C') {
         CommitToText(stream, &pos, res);
     } else if (stream[pos] != 'P' && stream[pos] != 'F') {
@@ -727,7 +760,7 @@ static void StreamLogicalLog(void)
 
         PQExpBuffer res = createPQExpBuffer();
         char *resultStream = copybuf + hdr_len;
-        if (g_parallel_decode && !g_raw && g_decode_style == 'b') {
+        if (g_parallel_decode && !g_raw && (g_decode_style == 'b' || g_decode_style == 'c')) {
             StreamToText(copybuf +  hdr_len, res);
             bytes_left = res->len;
             resultStream = res->data;
@@ -750,7 +783,7 @@ static void StreamLogicalLog(void)
             bytes_left -= ret;
         }
 
-        if (g_parallel_decode && (g_decode_style == 'b' || g_batch_sending)) {
+        if (g_parallel_decode && (g_decode_style == 'b' || g_decode_style == 'c' || g_batch_sending)) {
             continue;
         }
         if (write(outfd, "\n", 1) != 1) {
@@ -1136,6 +1136,36 @@ Datum pg_stat_get_cu_hdd_asyn(PG_FUNCTION_ARGS)
     PG_RETURN_INT64(result);
 }
 
+/**
+ * @Description:  get cu stat evictions caused by loading cu of the relation
+ * @return  datum
+ */
+Datum pg_stat_get_cu_mem_evict(PG_FUNCTION_ARGS)
+{
+    Oid relid = PG_GETARG_OID(0);
+    int64 result = 0;
+    List* stat_list = NIL;
+    ListCell* stat_cell = NULL;
+    PgStat_StatTabKey tabkey;
+    PgStat_StatTabEntry* tabentry = NULL;
+    pg_stat_get_stat_list(&stat_list, &tabkey.statFlag, relid);
+
+    foreach (stat_cell, stat_list) {
+        tabkey.tableid = lfirst_oid(stat_cell);
+        tabentry = pgstat_fetch_stat_tabentry(&tabkey);
+
+        if (PointerIsValid(tabentry)) {
+            result += (int64)(tabentry->cu_mem_evict);
+        }
+    }
+
+    if (PointerIsValid(stat_list)) {
+        list_free(stat_list);
+    }
+
+    PG_RETURN_INT64(result);
+}
+
 Datum pg_stat_get_last_data_changed_time(PG_FUNCTION_ARGS)
 {
     Oid relid = PG_GETARG_OID(0);
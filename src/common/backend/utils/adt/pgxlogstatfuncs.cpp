@@ -80,6 +80,7 @@ const int STAT_XLOG_FLUSH_STAT_OFF = -1;
 const int STAT_XLOG_FLUSH_STAT_ON = 0;
 const int STAT_XLOG_FLUSH_STAT_GET = 1;
 const int STAT_XLOG_FLUSH_STAT_CLEAR = 2;
+const int STAT_XLOG_FLUSH_HISTOGRAM = 4;
 
 static void ReadAllWalInsertStatusTable(int64 walInsertStatusEntryCount, TupleDesc *tupleDesc,
     Tuplestorestate *tupstore)
@@ -269,6 +270,19 @@ static void ClearWalwriterFlushStat(TupleDesc *tupleDesc, Tuplestorestate *tupst
     g_instance.wal_cxt.xlogFlushStats->currOpenXlogSegNo = 0;
     g_instance.wal_cxt.xlogFlushStats->lastRestTime = GetCurrentTimestamp();
 
+    errno_t rc = memset_s(g_instance.wal_cxt.xlogFlushStats->flushTimeHist,
+        sizeof(g_instance.wal_cxt.xlogFlushStats->flushTimeHist), 0,
+        sizeof(g_instance.wal_cxt.xlogFlushStats->flushTimeHist));
+    securec_check(rc, "\0", "\0");
+    rc = memset_s(g_instance.wal_cxt.xlogFlushStats->flushBytesHist,
+        sizeof(g_instance.wal_cxt.xlogFlushStats->flushBytesHist), 0,
+        sizeof(g_instance.wal_cxt.xlogFlushStats->flushBytesHist));
+    securec_check(rc, "\0", "\0");
+    rc = memset_s(g_instance.wal_cxt.xlogFlushStats->flushWaitersHist,
+        sizeof(g_instance.wal_cxt.xlogFlushStats->flushWaitersHist), 0,
+        sizeof(g_instance.wal_cxt.xlogFlushStats->flushWaitersHist));
+    securec_check(rc, "\0", "\0");
+
     GetWalwriterFlushStat(tupleDesc, tupstore);
 }
 
@@ -360,4 +374,67 @@ Datum gs_walwriter_flush_stat(PG_FUNCTION_ARGS)
     }
 
     PG_RETURN_VOID();
-}
\ No newline at end of file
+}
+
+/*
+ * One row per bucket, bucket i holds values in [lower_bound, upper_bound),
+ * the last bucket has no upper bound.
+ */
+static void ReadFlushHistogram(const char *name, const uint64 *hist, TupleDesc *tupleDesc, Tuplestorestate *tupstore)
+{
+    for (int i = 0; i < XLOG_FLUSH_HIST_BUCKETS; i++) {
+        bool nulls[STAT_XLOG_FLUSH_HISTOGRAM] = {false};
+        Datum values[STAT_XLOG_FLUSH_HISTOGRAM];
+
+        values[ARR_0] = CStringGetTextDatum(name);
+        values[ARR_1] = Int64GetDatum((i == 0) ? 0 : ((int64)1 << (i - 1)));
+        if (i == XLOG_FLUSH_HIST_BUCKETS - 1) {
+            values[ARR_2] = (Datum)0;
+            nulls[ARR_2] = true;
+        } else {
+            values[ARR_2] = Int64GetDatum((int64)1 << i);
+        }
+        values[ARR_3] = Int64GetDatum((int64)hist[i]);
+        tuplestore_putvalues(tupstore, *tupleDesc, values, nulls);
+    }
+}
+
+Datum gs_walwriter_flush_histogram(PG_FUNCTION_ARGS)
+{
+    ReturnSetInfo *rsinfo = (ReturnSetInfo *)fcinfo->resultinfo;
+    TupleDesc tupDesc;
+    Tuplestorestate *tupstore = NULL;
+    MemoryContext per_query_ctx;
+    MemoryContext oldcontext;
+
+    if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo)) {
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+            errmsg("set-valued function called in context that cannot accept a set")));
+        PG_RETURN_VOID();
+    }
+    if (!(rsinfo->allowedModes & SFRM_Materialize)) {
+        ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+            errmsg("materialize mode required, but it is not allowed in this context")));
+        PG_RETURN_VOID();
+    }
+
+    if (get_call_result_type(fcinfo, NULL, &tupDesc) != TYPEFUNC_COMPOSITE) {
+        elog(ERROR, "return type must be a row type");
+        PG_RETURN_VOID();
+    }
+
+    per_query_ctx = rsinfo->econtext->ecxt_per_query_memory;
+    oldcontext = MemoryContextSwitchTo(per_query_ctx);
+    tupstore = tuplestore_begin_heap(true, false, u_sess->attr.attr_memory.work_mem);
+    rsinfo->returnMode = SFRM_Materialize;
+    rsinfo->setResult = tupstore;
+    rsinfo->setDesc = tupDesc;
+
+    ReadFlushHistogram("flush_time_us", g_instance.wal_cxt.xlogFlushStats->flushTimeHist, &tupDesc, tupstore);
+    ReadFlushHistogram("flush_bytes", g_instance.wal_cxt.xlogFlushStats->flushBytesHist, &tupDesc, tupstore);
+    ReadFlushHistogram("flush_waiters", g_instance.wal_cxt.xlogFlushStats->flushWaitersHist, &tupDesc, tupstore);
+    tuplestore_donestoring(tupstore);
+    MemoryContextSwitchTo(oldcontext);
+
+    PG_RETURN_VOID();
+}
@@ -1364,8 +1364,7 @@ static void GPCFillPlanCache(CachedPlanSource* plansource, bool isBuildingCustom
         pfree_ext(plansource->gpc.key);
         MemoryContext oldcxt = MemoryContextSwitchTo(plansource->context);
         plansource->gpc.key = (GPCKey*)palloc0(sizeof(GPCKey));
-        plansource->gpc.key->query_string = plansource->query_string;
-        plansource->gpc.key->query_length = strlen(plansource->query_string);
+        GPCKeySetQuery(plansource->gpc.key, plansource->query_string, strlen(plansource->query_string));
         plansource->gpc.key->spi_signature = plansource->spi_signature;
         GlobalPlanCache::EnvFill(&plansource->gpc.key->env, plansource->dependsOnRole);
         plansource->gpc.key->env.search_path = plansource->search_path;
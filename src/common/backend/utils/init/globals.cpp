@@ -59,7 +59,7 @@ bool open_join_children = true;
 bool will_shutdown = false;
 
 /* hard-wired binary version number */
-const uint32 GRAND_VERSION_NUM = 92613;
+const uint32 GRAND_VERSION_NUM = 92617;
 
 const uint32 PREDPUSH_SAME_LEVEL_VERSION_NUM = 92522;
 const uint32 UPSERT_WHERE_VERSION_NUM = 92514;
@@ -141,6 +141,10 @@ const uint32 PITR_INIT_VERSION_NUM = 92599;
 
 const uint32 COMMENT_SUPPORT_VERSION_NUM = 92612;
 
+const uint32 BTREE_DEDUP_VERSION_NUM = 92616;
+
+const uint32 TOPLEVEL_XID_WAL_VERSION_NUM = 92617;
+
 #ifdef PGXC
 bool useLocalXid = false;
 #endif
@@ -358,6 +358,7 @@ const char* sync_guc_variable_namelist[] = {"work_mem",
     "enable_fast_allocate",
     "enable_adio_debug",
     "enable_adio_function",
+    "enable_uring_prefetch",
     "fast_extend_file_size",
     "enable_global_stats",
     "enable_hypo_index",
@@ -393,6 +394,7 @@ const char* sync_guc_variable_namelist[] = {"work_mem",
     "enable_sonic_optspill",
     "enable_sonic_hashjoin",
     "enable_sonic_hashagg",
+    "enable_parallel_hash",
 #ifdef ENABLE_MULTIPLE_NODES
     "enable_stream_recursive",
 #endif
@@ -2441,6 +2443,21 @@ static void InitConfigureNamesInt()
             NULL,
             NULL,
             NULL},
+
+        {{"thread_pool_steal_threshold",
+            PGC_POSTMASTER,
+            NODE_ALL,
+            CLIENT_CONN,
+            gettext_noop("Sets the ready session backlog from which idle workers of other "
+                         "thread pool groups take sessions of a group."),
+            gettext_noop("Workers on another NUMA node need twice this backlog. 0 disables it.")},
+            &g_instance.attr.attr_common.thread_pool_steal_threshold,
+            4,
+            0,
+            10000,
+            NULL,
+            NULL,
+            NULL},
         {{"datanode_heartbeat_interval",
             PGC_SIGHUP,
             NODE_ALL,
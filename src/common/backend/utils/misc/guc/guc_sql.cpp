@@ -540,6 +540,17 @@ static void InitSqlConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_parallel_hash",
+            PGC_USERSET,
+            NODE_ALL,
+            QUERY_TUNING_METHOD,
+            gettext_noop("Enables the SMP threads of a hashjoin to share one hash table built from a local broadcast."),
+            NULL},
+            &u_sess->attr.attr_sql.enable_parallel_hash,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"enable_csqual_pushdown",
             PGC_SUSET,
             NODE_ALL,
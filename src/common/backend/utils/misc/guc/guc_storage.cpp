@@ -654,6 +654,17 @@ static void InitStorageConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"enable_logical_replication_streaming",
+            PGC_SIGHUP,
+            NODE_SINGLENODE,
+            REPLICATION,
+            gettext_noop("Asks publishers to stream large in-progress transactions to the apply workers."),
+            NULL},
+            &u_sess->attr.attr_storage.enable_logical_replication_streaming,
+            false,
+            NULL,
+            NULL,
+            NULL},
 #endif
         {{"ha_module_debug",
             PGC_USERSET,
@@ -775,6 +786,17 @@ static void InitStorageConfigureNamesBool()
             check_adio_function_guc,
             NULL,
             NULL},
+        {{"enable_uring_prefetch",
+            PGC_USERSET,
+            NODE_ALL,
+            RESOURCES_ASYNCHRONOUS,
+            gettext_noop("Enables reading prefetched pages through io_uring when adio is not running."),
+            NULL},
+            &u_sess->attr.attr_storage.enable_uring_prefetch,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"gds_debug_mod",
             PGC_USERSET,
             NODE_DISTRIBUTE,
@@ -820,6 +842,18 @@ static void InitStorageConfigureNamesBool()
             NULL,
             NULL,
             NULL},
+        {{"numa_buffer_partition",
+            PGC_POSTMASTER,
+            NODE_ALL,
+            RESOURCES_MEM,
+            gettext_noop("Splits shared buffers into one pool per NUMA node with its own clock sweep."),
+            NULL,
+            },
+            &g_instance.attr.attr_storage.numa_buffer_partition,
+            false,
+            NULL,
+            NULL,
+            NULL},
         {{"enable_incremental_checkpoint",
             PGC_POSTMASTER,
             NODE_ALL,
@@ -2113,6 +2147,21 @@ static void InitStorageConfigureNamesInt()
             NULL,
             NULL,
             NULL},
+        {{"wal_flush_max_window",
+            PGC_SIGHUP,
+            NODE_ALL,
+            WAL_SETTINGS,
+            gettext_noop("Sets the longest time in microseconds the wal writer holds a flush to let concurrent "
+                         "commits join it."),
+            gettext_noop("The wait adapts to half of the recent flush time. Zero disables it."),
+            GUC_NOT_IN_SAMPLE},
+            &g_instance.attr.attr_storage.wal_flush_max_window,
+            0,
+            0,
+            1000000,
+            NULL,
+            NULL,
+            NULL},
         {{"wal_flush_delay",
             PGC_SIGHUP,
             NODE_ALL,
@@ -2246,6 +2295,20 @@ static void InitStorageConfigureNamesInt()
             NULL,
             NULL},
 
+        {{"max_parallel_apply_workers_per_subscription",
+            PGC_SIGHUP,
+            NODE_SINGLENODE,
+            REPLICATION,
+            gettext_noop("Maximum number of parallel apply workers per subscription."),
+            NULL},
+            &u_sess->attr.attr_storage.max_parallel_apply_workers_per_subscription,
+            0,
+            0,
+            MAX_BACKENDS,
+            NULL,
+            NULL,
+            NULL},
+
         {{"recovery_time_target",
             PGC_SIGHUP,
             NODE_ALL,
@@ -3908,6 +3971,18 @@ static void InitStorageConfigureNamesString()
             NULL,
             NULL,
             NULL},
+        {{"numa_aware_lwlock_tranches",
+            PGC_POSTMASTER,
+            NODE_ALL,
+            LOCK_MANAGEMENT,
+            gettext_noop("LWLock tranches which hand over exclusive ownership within a NUMA node first."),
+            NULL,
+            GUC_LIST_INPUT | GUC_LIST_QUOTE | GUC_SUPERUSER_ONLY},
+            &g_instance.attr.attr_storage.numa_aware_lwlock_tranches,
+            "",
+            NULL,
+            NULL,
+            NULL},
         /* Get the cross_cluster_ReplConnInfo1 from postgresql.conf and assign to cross_cluster_ReplConnArray1. */
         {{"cross_cluster_replconninfo1",
             PGC_SIGHUP,
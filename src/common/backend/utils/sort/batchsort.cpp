@@ -43,6 +43,9 @@
 #include "utils/batchsort.h"
 #include "utils/numeric.h"
 #include "utils/numeric_gs.h"
+#include "utils/date.h"
+#include "utils/timestamp.h"
+#include "utils/pg_locale.h"
 #include "access/tuptoaster.h"
 
 typedef int (*LLVM_CMC_func)(const MultiColumns* a, const MultiColumns* b, Batchsortstate* state);
@@ -71,6 +74,8 @@ Datum CmpNumericFunc(PG_FUNCTION_ARGS);
 
 int CompareIntMutiColumn(const MultiColumns* a, const MultiColumns* b, Batchsortstate* state);
 
+static int* GetNormKeyTypes(Batchsortstate* state);
+
 Batchsortstate* batchsort_begin_heap(TupleDesc tupDesc, int nkeys, AttrNumber* attNums, Oid* sortOperators,
     Oid* sortCollations, const bool* nullsFirstFlags, int64 workMem, bool randomAccess, int64 maxMem, int planId,
     int dop)
@@ -157,6 +162,8 @@ Batchsortstate* batchsort_begin_heap(TupleDesc tupDesc, int nkeys, AttrNumber* a
         state->m_isSortKey[attNums[i] - 1] = true;
     }
 
+    state->m_normKeyTypes = GetNormKeyTypes(state);
+
     state->abbrevNext = 10;
     /* Prepare SortSupport data for the first column */
     state->sortKeys = (SortSupport)palloc0(sizeof(SortSupportData));
@@ -783,9 +790,442 @@ bool Batchsortstate::ConsiderAbortCommon()
     return false;
 }
 
+/*
+ * Normalized keys
+ *
+ * When every sort key has one of the types below, compared by its default
+ * btree comparator (and text in C collation), the in-memory sort encodes all
+ * keys of a row into one fixed width byte string whose memcmp() order is the
+ * order CompareMultiColumn() gives.  Each key is a null byte that places
+ * NULLs first or last, then the value (inverted for DESC, zeroes for NULL).
+ * The row number closes the key, so that all keys differ and equal rows keep
+ * their input order.  The keys are sorted with an MSD radix sort that leaves
+ * short buckets to a comparison sort, then the rows are permuted.
+ *
+ * Text is encoded only if every value is at most NORMKEY_MAX_TEXT_LEN bytes,
+ * zero padded; text has no NUL bytes, so the padded order is memcmp() then
+ * length, as varstr_cmp() does in C collation.  Numeric is encoded as sign,
+ * weight and NBASE digits when no value has more than NORMKEY_MAX_NUMERIC_DIGITS
+ * digits.  Otherwise, or when the keys would not fit in the sort memory, the
+ * sort falls back to qsort with CompareMultiColumn().  Sorts that spill or are
+ * bounded keep using the comparator too.
+ */
+#define NORMKEY_NONE 0
+#define NORMKEY_UINT8 1
+#define NORMKEY_INT16 2
+#define NORMKEY_INT32 3
+#define NORMKEY_INT64 4
+#define NORMKEY_NUMERIC 5
+#define NORMKEY_TEXT 6
+
+#define NORMKEY_MAX_WIDTH 256
+#define NORMKEY_MAX_TEXT_LEN 64
+#define NORMKEY_MAX_NUMERIC_DIGITS 16
+#define NORMKEY_ROWNUM_LEN 4
+
+/* buckets up to this many rows are finished by a comparison sort */
+#define NORMKEY_COMPARE_SORT_ROWS 32
+
+/* numeric sign bytes, in sort order */
+#define NORMKEY_NUMERIC_NEG 0
+#define NORMKEY_NUMERIC_ZERO 1
+#define NORMKEY_NUMERIC_POS 2
+#define NORMKEY_NUMERIC_NAN 3
+
+/*
+ * Which encoding each sort key uses, or NULL if some key has none.
+ */
+static int* GetNormKeyTypes(Batchsortstate* state)
+{
+    int* types = (int*)palloc(state->m_nKeys * sizeof(int));
+
+    for (int nkey = 0; nkey < state->m_nKeys; nkey++) {
+        ScanKey scanKey = &state->m_scanKeys[nkey];
+        PGFunction cmp = scanKey->sk_func.fn_addr;
+        int type = NORMKEY_NONE;
+
+        switch (state->tupDesc->attrs[scanKey->sk_attno - 1]->atttypid) {
+            case INT1OID:
+                type = (cmp == int1cmp) ? NORMKEY_UINT8 : NORMKEY_NONE;
+                break;
+            case INT2OID:
+                type = (cmp == btint2cmp) ? NORMKEY_INT16 : NORMKEY_NONE;
+                break;
+            case INT4OID:
+                type = (cmp == btint4cmp) ? NORMKEY_INT32 : NORMKEY_NONE;
+                break;
+            case DATEOID:
+                type = (cmp == date_cmp) ? NORMKEY_INT32 : NORMKEY_NONE;
+                break;
+            case INT8OID:
+                type = (cmp == btint8cmp) ? NORMKEY_INT64 : NORMKEY_NONE;
+                break;
+            case TIMESTAMPOID:
+            case TIMESTAMPTZOID:
+                type = (cmp == timestamp_cmp) ? NORMKEY_INT64 : NORMKEY_NONE;
+                break;
+            case NUMERICOID:
+                type = (cmp == numeric_cmp) ? NORMKEY_NUMERIC : NORMKEY_NONE;
+                break;
+            case TEXTOID:
+            case VARCHAROID:
+                type = (cmp == bttextcmp && lc_collate_is_c(scanKey->sk_collation)) ? NORMKEY_TEXT : NORMKEY_NONE;
+                break;
+            default:
+                break;
+        }
+
+        if (type == NORMKEY_NONE) {
+            pfree(types);
+            return NULL;
+        }
+        types[nkey] = type;
+    }
+
+    return types;
+}
+
+/*
+ * Unpack a numeric sort value to the plain format, *copied tells if the
+ * result must be freed.
+ */
+static Numeric NormKeyGetNumeric(Datum value, bool* copied)
+{
+    Numeric num = DatumGetNumeric(value);
+    Numeric normal = NULL;
+
+    *copied = (Pointer)num != DatumGetPointer(value);
+    if (NUMERIC_IS_BI(num)) {
+        normal = makeNumericNormal(num);
+        if (*copied)
+            pfree(num);
+        *copied = true;
+        num = normal;
+    }
+    return num;
+}
+
+/* number of NBASE digits, leading and trailing zero digits excluded */
+static int NormKeyNumericDigits(Numeric num, int* firstDigit)
+{
+    NumericDigit* digits = NUMERIC_DIGITS(num);
+    int ndigits = NUMERIC_NDIGITS(num);
+    int first = 0;
+
+    while (first < ndigits && digits[first] == 0)
+        first++;
+    while (ndigits > first && digits[ndigits - 1] == 0)
+        ndigits--;
+
+    *firstDigit = first;
+    return ndigits - first;
+}
+
+static inline void NormKeyPutUint16(char* p, uint16 v)
+{
+    p[0] = (char)(v >> 8);
+    p[1] = (char)v;
+}
+
+static inline void NormKeyPutUint32(char* p, uint32 v)
+{
+    p[0] = (char)(v >> 24);
+    p[1] = (char)(v >> 16);
+    p[2] = (char)(v >> 8);
+    p[3] = (char)v;
+}
+
+static inline void NormKeyPutUint64(char* p, uint64 v)
+{
+    NormKeyPutUint32(p, (uint32)(v >> 32));
+    NormKeyPutUint32(p + 4, (uint32)v);
+}
+
+/*
+ * Encode a numeric as sign, weight and width - 3 bytes of digits.  Negative
+ * values are inverted, so that a larger magnitude sorts first.
+ */
+static void NormKeyPutNumeric(char* p, Datum value, int width)
+{
+    bool copied = false;
+    Numeric num = NormKeyGetNumeric(value, &copied);
+    int first = 0;
+    int ndigits;
+    NumericDigit* digits = NULL;
+    bool negative = false;
+
+    if (NUMERIC_IS_NAN(num)) {
+        p[0] = NORMKEY_NUMERIC_NAN;
+    } else if ((ndigits = NormKeyNumericDigits(num, &first)) == 0) {
+        p[0] = NORMKEY_NUMERIC_ZERO;
+    } else {
+        negative = (NUMERIC_SIGN(num) == NUMERIC_NEG);
+        p[0] = negative ? NORMKEY_NUMERIC_NEG : NORMKEY_NUMERIC_POS;
+        /* leading zero digits lower the weight */
+        NormKeyPutUint16(p + 1, (uint16)(NUMERIC_WEIGHT(num) - first + PG_INT16_MAX + 1));
+        digits = NUMERIC_DIGITS(num) + first;
+        for (int i = 0; i < ndigits; i++)
+            NormKeyPutUint16(p + 3 + i * sizeof(uint16), (uint16)digits[i]);
+        if (negative) {
+            for (int i = 1; i < width; i++)
+                p[i] = (char)~p[i];
+        }
+    }
+
+    if (copied)
+        pfree(num);
+}
+
+/*
+ * Width of the encoded values of a key column, -1 if some value can not be
+ * encoded.
+ */
+static int NormKeyDataWidth(int type, int colIdx, MultiColumns* rows, int nrows)
+{
+    int maxLen = 0;
+
+    switch (type) {
+        case NORMKEY_UINT8:
+            return sizeof(uint8);
+        case NORMKEY_INT16:
+            return sizeof(uint16);
+        case NORMKEY_INT32:
+            return sizeof(uint32);
+        case NORMKEY_INT64:
+            return sizeof(uint64);
+        case NORMKEY_TEXT:
+            for (int row = 0; row < nrows; row++) {
+                if (IS_NULL(rows[row].m_nulls[colIdx]))
+                    continue;
+                Pointer val = DatumGetPointer(rows[row].m_values[colIdx]);
+                if (VARATT_IS_EXTENDED(val) && !VARATT_IS_SHORT(val))
+                    return -1;
+                maxLen = Max(maxLen, (int)VARSIZE_ANY_EXHDR(val));
+                if (maxLen > NORMKEY_MAX_TEXT_LEN)
+                    return -1;
+            }
+            return maxLen;
+        case NORMKEY_NUMERIC:
+            for (int row = 0; row < nrows; row++) {
+                bool copied = false;
+                int first = 0;
+                Numeric num = NULL;
+
+                if (IS_NULL(rows[row].m_nulls[colIdx]))
+                    continue;
+                num = NormKeyGetNumeric(rows[row].m_values[colIdx], &copied);
+                if (!NUMERIC_IS_NAN(num))
+                    maxLen = Max(maxLen, NormKeyNumericDigits(num, &first));
+                if (copied)
+                    pfree(num);
+                if (maxLen > NORMKEY_MAX_NUMERIC_DIGITS)
+                    return -1;
+            }
+            return 1 + sizeof(uint16) + maxLen * sizeof(uint16);
+        default:
+            return -1;
+    }
+}
+
+/*
+ * Encode key column colIdx of all rows at offset off of the keys.  The key
+ * bytes start zeroed.
+ */
+static void NormKeyEncodeColumn(int type, ScanKey scanKey, MultiColumns* rows, int nrows, char* keys, int keyWidth,
+    int off, int dataWidth)
+{
+    int colIdx = scanKey->sk_attno - 1;
+    bool nullsFirst = (scanKey->sk_flags & SK_BT_NULLS_FIRST) != 0;
+    bool desc = (scanKey->sk_flags & SK_BT_DESC) != 0;
+    char* p = keys + off;
+
+    for (int row = 0; row < nrows; row++, p += keyWidth) {
+        Datum value = rows[row].m_values[colIdx];
+
+        if (IS_NULL(rows[row].m_nulls[colIdx])) {
+            p[0] = nullsFirst ? 0 : 1;
+            continue;
+        }
+        p[0] = nullsFirst ? 1 : 0;
+
+        switch (type) {
+            case NORMKEY_UINT8:
+                p[1] = (char)DatumGetUInt8(value);
+                break;
+            case NORMKEY_INT16:
+                NormKeyPutUint16(p + 1, (uint16)DatumGetInt16(value) ^ 0x8000);
+                break;
+            case NORMKEY_INT32:
+                NormKeyPutUint32(p + 1, (uint32)DatumGetInt32(value) ^ 0x80000000U);
+                break;
+            case NORMKEY_INT64:
+                NormKeyPutUint64(p + 1, (uint64)DatumGetInt64(value) ^ UINT64CONST(0x8000000000000000));
+                break;
+            case NORMKEY_TEXT: {
+                Pointer val = DatumGetPointer(value);
+                errno_t rc = EOK;
+                if (VARSIZE_ANY_EXHDR(val) > 0) {
+                    rc = memcpy_s(p + 1, dataWidth, VARDATA_ANY(val), VARSIZE_ANY_EXHDR(val));
+                    securec_check(rc, "\0", "\0");
+                }
+                break;
+            }
+            case NORMKEY_NUMERIC:
+                NormKeyPutNumeric(p + 1, value, dataWidth);
+                break;
+            default:
+                Assert(false);
+                break;
+        }
+
+        if (desc) {
+            for (int i = 1; i <= dataWidth; i++)
+                p[i] = (char)~p[i];
+        }
+    }
+}
+
+static int NormKeyCompare(const void* a, const void* b, void* arg)
+{
+    return memcmp(a, b, *(int*)arg);
+}
+
+/*
+ * Sort the n keys of the given width whose first depth bytes are equal.
+ * counts holds one histogram per key byte, tmp has room for n keys.
+ */
+static void NormKeyRadixSort(char* keys, char* tmp, size_t n, int width, int depth, uint32 (*counts)[256])
+{
+    uint32* count = NULL;
+    uint32 start = 0;
+    errno_t rc = EOK;
+
+    check_stack_depth();
+
+    for (;;) {
+        if (n <= NORMKEY_COMPARE_SORT_ROWS) {
+            /* the keys only differ in the tail bytes now */
+            qsort_arg(keys, n, width, NormKeyCompare, &width);
+            return;
+        }
+
+        count = counts[depth];
+        rc = memset_s(count, sizeof(uint32) * 256, 0, sizeof(uint32) * 256);
+        securec_check(rc, "\0", "\0");
+        for (size_t i = 0; i < n; i++)
+            count[(uint8)keys[i * width + depth]]++;
+
+        /* skip a byte all keys share */
+        if (count[(uint8)keys[depth]] != n)
+            break;
+        depth++;
+        Assert(depth < width);
+    }
+
+    /* turn the counts into bucket starts, the scatter leaves them at the bucket ends */
+    for (int b = 0; b < 256; b++) {
+        uint32 size = count[b];
+        count[b] = start;
+        start += size;
+    }
+    for (size_t i = 0; i < n; i++) {
+        uint8 b = (uint8)keys[i * width + depth];
+        rc = memcpy_s(tmp + (size_t)count[b] * width, width, keys + i * width, width);
+        securec_check(rc, "\0", "\0");
+        count[b]++;
+    }
+    rc = memcpy_s(keys, n * width, tmp, n * width);
+    securec_check(rc, "\0", "\0");
+
+    start = 0;
+    for (int b = 0; b < 256; b++) {
+        if (count[b] - start > 1)
+            NormKeyRadixSort(keys + (size_t)start * width, tmp, count[b] - start, width, depth + 1, counts);
+        start = count[b];
+    }
+}
+
+/*
+ * Sort the rows in memory by their normalized keys.  Return false, with the
+ * rows untouched, when the keys can not be used.
+ */
+bool Batchsortstate::SortInMemNormKeys()
+{
+    MultiColumns* rows = m_storeColumns.m_memValues;
+    int nrows = m_storeColumns.m_memRowNum;
+    int* dataWidths = (int*)palloc(m_nKeys * sizeof(int));
+    int keyWidth = NORMKEY_ROWNUM_LEN;
+    int64 needMem;
+    char* keys = NULL;
+    char* tmp = NULL;
+    uint32(*counts)[256] = NULL;
+    MultiColumns* sorted = NULL;
+    int off = 0;
+    errno_t rc = EOK;
+
+    for (int nkey = 0; nkey < m_nKeys; nkey++) {
+        dataWidths[nkey] = NormKeyDataWidth(m_normKeyTypes[nkey], m_scanKeys[nkey].sk_attno - 1, rows, nrows);
+        if (dataWidths[nkey] < 0) {
+            pfree(dataWidths);
+            return false;
+        }
+        keyWidth += 1 + dataWidths[nkey];
+    }
+
+    /* keys, scatter buffer, histograms and the permuted rows */
+    needMem = (int64)nrows * keyWidth * 2 + (int64)keyWidth * sizeof(uint32) * 256 + (int64)nrows * sizeof(MultiColumns);
+    if (keyWidth > NORMKEY_MAX_WIDTH || (Size)nrows * keyWidth > MaxAllocSize || needMem > m_availMem) {
+        pfree(dataWidths);
+        return false;
+    }
+
+#ifdef TRACE_SORT
+    if (u_sess->attr.attr_common.trace_sort) {
+        elog(LOG, "sorting %d rows by %d byte normalized keys: %s", nrows, keyWidth, pg_rusage_show(&m_ruStart));
+    }
+#endif
+
+    keys = (char*)palloc0((Size)nrows * keyWidth);
+    tmp = (char*)palloc((Size)nrows * keyWidth);
+    counts = (uint32(*)[256])palloc(keyWidth * sizeof(uint32) * 256);
+    UseMem(needMem);
+
+    /* build the keys column by column */
+    for (int nkey = 0; nkey < m_nKeys; nkey++) {
+        NormKeyEncodeColumn(m_normKeyTypes[nkey], &m_scanKeys[nkey], rows, nrows, keys, keyWidth, off,
+            dataWidths[nkey]);
+        off += 1 + dataWidths[nkey];
+    }
+    for (int row = 0; row < nrows; row++)
+        NormKeyPutUint32(keys + (Size)row * keyWidth + off, (uint32)row);
+
+    NormKeyRadixSort(keys, tmp, nrows, keyWidth, 0, counts);
+
+    sorted = (MultiColumns*)palloc((Size)nrows * sizeof(MultiColumns));
+    for (int i = 0; i < nrows; i++) {
+        const uint8* rownum = (const uint8*)keys + (Size)i * keyWidth + off;
+        uint32 row = ((uint32)rownum[0] << 24) | ((uint32)rownum[1] << 16) | ((uint32)rownum[2] << 8) | rownum[3];
+        sorted[i] = rows[row];
+    }
+    rc = memcpy_s(rows, (Size)nrows * sizeof(MultiColumns), sorted, (Size)nrows * sizeof(MultiColumns));
+    securec_check(rc, "\0", "\0");
+
+    pfree(sorted);
+    pfree(counts);
+    pfree(tmp);
+    pfree(keys);
+    pfree(dataWidths);
+    FreeMem(needMem);
+
+    return true;
+}
+
 void Batchsortstate::SortInMem()
 {
     if (m_storeColumns.m_memRowNum > 1) {
+        if (m_normKeyTypes != NULL && m_storeColumns.m_memRowNum > NORMKEY_COMPARE_SORT_ROWS && SortInMemNormKeys())
+            return;
+
         qsort_arg(m_storeColumns.m_memValues,
             m_storeColumns.m_memRowNum,
             sizeof(MultiColumns),
@@ -8977,9 +8977,11 @@ static bool CheckForeignScanExpr(Plan* resultPlan, VectorPlanContext* planContex
         resultPlan->vec_output = false;
     }
 #ifdef ENABLE_MOT
-    /* do not support row to vector for mot table */
-    if (IsSpecifiedFDWFromRelid(fscan->scan_relid, MOT_FDW)) {
-        resultPlan->vec_output = false;
+    /*
+     * do not support row to vector for mot table, only the scans which mot fdw
+     * produces as vector batches itself can be vectorized
+     */
+    if (IsSpecifiedFDWFromRelid(fscan->scan_relid, MOT_FDW) && !resultPlan->vec_output) {
         return true;
     }
 #endif
@@ -36,6 +36,8 @@
 #include "opfusion/opfusion.h"
 #include "pgxc/groupmgr.h"
 #include "pgxc/pgxcnode.h"
+#include "storage/ipc.h"
+#include "utils/bloom_filter.h"
 #include "utils/dynahash.h"
 #include "utils/globalplancache.h"
 #include "utils/memutils.h"
@@ -135,10 +137,27 @@ GPCCompareEnv(GPCEnv *env1, GPCEnv *env2)
     return false;
 }
 
+/*
+ * Set the query text of a gpc key together with its 128-bit fingerprint, so
+ * hashing and most mismatches never need to look at the query text again.
+ */
+void GPCKeySetQuery(GPCKey *key, const char *query_string, uint32 query_length)
+{
+    key->query_string = query_string;
+    key->query_length = query_length;
+    key->fingerprint.hi = (uint64)filter::Murmur3::hash64(query_string, (int32)query_length, GPC_FINGERPRINT_SEED_HI);
+    key->fingerprint.lo = (uint64)filter::Murmur3::hash64(query_string, (int32)query_length, GPC_FINGERPRINT_SEED_LO);
+}
+
+static inline bool GPCFingerprintEqual(const GPCFingerprint *left, const GPCFingerprint *right)
+{
+    return left->hi == right->hi && left->lo == right->lo;
+}
+
 uint32 GPCHashFunc(const void *key, Size keysize)
 {
     const GPCKey *item = (const GPCKey *) key;
-    uint32 val1 = DatumGetUInt32(hash_any((const unsigned char *)item->query_string, item->query_length));
+    uint32 val1 = (uint32)(item->fingerprint.lo ^ (item->fingerprint.lo >> 32));
     uint32 val2 = DatumGetUInt32(hash_any((const unsigned char *)(&item->env.plainenv), sizeof(GPCPlainEnv)));
     uint32 val3 = DatumGetUInt32(hash_any((const unsigned char *)(&item->spi_signature), sizeof(SPISign)));
     val1 ^= val2;
@@ -159,6 +178,11 @@ int GPCKeyMatch(const void *left, const void *right, Size keysize)
         return 1;
     }
 
+    if (!GPCFingerprintEqual(&leftItem->fingerprint, &rightItem->fingerprint)) {
+        return 1;
+    }
+
+    /* fingerprints only tell texts apart, a real match still has to be verified */
     if(strncmp(leftItem->query_string, rightItem->query_string, leftItem->query_length)) {
         return 1;
     }
@@ -197,6 +221,17 @@ void GPCKeyDeepCopy(const GPCKey *srcGpckey, GPCKey *destGpckey)
 
 GlobalPlanCache::GlobalPlanCache()
 {
+    /*
+     * Reader slots and retire generations are read without any lock, keep them
+     * out of the gpc memory which GPCResetAll resets. Epoch 0 means "not
+     * reading" in a reader slot, so start from 1.
+     */
+    void *slots = MemoryContextAllocZero(g_instance.instance_context,
+                                         sizeof(GPCReaderSlot) * GPC_MAX_READER_SLOTS + PG_CACHE_LINE_SIZE);
+    m_reader_slots = (GPCReaderSlot *)CACHELINEALIGN(slots);
+    m_retire_gen = (volatile uint32 *)MemoryContextAllocZero(g_instance.instance_context,
+                                                             sizeof(uint32) * GPC_RETIRE_GEN_NUM);
+    m_epoch = 1;
     Init();
 }
 
@@ -247,6 +282,157 @@ void GlobalPlanCache::Init()
     }
 
     m_invalid_list = NULL;
+
+    ResetReaderSlots();
+}
+
+/*
+ * Forget all readers and retire every session cache entry. Init runs when the
+ * gpc is created or reset, no session is running then.
+ */
+void GlobalPlanCache::ResetReaderSlots()
+{
+    for (int i = 0; i < GPC_MAX_READER_SLOTS; i++) {
+        m_reader_slots[i].slot.epoch = 0;
+        m_reader_slots[i].slot.inuse = 0;
+    }
+    m_reader_slots_hwm = 0;
+    for (int i = 0; i < GPC_RETIRE_GEN_NUM; i++) {
+        (void)pg_atomic_fetch_add_u32(&m_retire_gen[i], 1);
+    }
+    (void)pg_atomic_fetch_add_u64(&m_epoch, 1);
+}
+
+/*
+ * Get the reader slot of the current session, claim a free one on first use.
+ * Return -1 if all slots are taken, then the caller has to use the locked path.
+ * The slot is released at session exit, see GPCCleanUpSessionSavedPlan.
+ */
+int GlobalPlanCache::GetReaderSlot()
+{
+    if (likely(u_sess->pcache_cxt.gpc_reader_slot >= 0)) {
+        return u_sess->pcache_cxt.gpc_reader_slot;
+    }
+
+    for (int i = 0; i < GPC_MAX_READER_SLOTS; i++) {
+        uint32 expect = 0;
+        if (m_reader_slots[i].slot.inuse == 0 &&
+            pg_atomic_compare_exchange_u32(&m_reader_slots[i].slot.inuse, &expect, 1)) {
+            m_reader_slots[i].slot.epoch = 0;
+            /* raise the high water mark so CanReclaim looks at this slot */
+            uint32 hwm = pg_atomic_read_u32(&m_reader_slots_hwm);
+            while (hwm < (uint32)(i + 1) &&
+                   !pg_atomic_compare_exchange_u32(&m_reader_slots_hwm, &hwm, (uint32)(i + 1))) {
+            }
+            u_sess->pcache_cxt.gpc_reader_slot = i;
+            return i;
+        }
+    }
+    return -1;
+}
+
+void GlobalPlanCache::ReleaseReaderSlot(int slot)
+{
+    Assert(slot >= 0 && slot < GPC_MAX_READER_SLOTS);
+    m_reader_slots[slot].slot.epoch = 0;
+    pg_memory_barrier();
+    pg_atomic_write_u32(&m_reader_slots[slot].slot.inuse, 0);
+}
+
+/*
+ * A plansource retired in retire_epoch can be freed once no lock-free reader
+ * entered in that epoch or before is still inside, since readers entering later
+ * can not find it anymore. Must be checked before RefCountZero(), a reader pins
+ * the plansource before it leaves.
+ */
+bool GlobalPlanCache::CanReclaim(uint64 retire_epoch)
+{
+    pg_memory_barrier();
+    uint32 hwm = pg_atomic_read_u32(&m_reader_slots_hwm);
+    for (uint32 i = 0; i < hwm; i++) {
+        uint64 epoch = pg_atomic_read_u64(&m_reader_slots[i].slot.epoch);
+        if (epoch != 0 && epoch <= retire_epoch) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Whether a plansource of the invalid list can be freed now */
+bool GlobalPlanCache::CanDrop(CachedPlanSource* plansource)
+{
+    if (!CanReclaim(plansource->gpc.retire_epoch)) {
+        return false;
+    }
+    /* a reader pins the plansource before it leaves its epoch, see FetchFromSessionCache */
+    pg_read_barrier();
+    return plansource->gpc.status.RefCountZero();
+}
+
+/*
+ * Look up the session cache without taking any lock. The entry is trusted only
+ * if no plansource with a fingerprint in the same retire generation has left
+ * the share table since it was filled. Return the plansource pinned, or NULL.
+ */
+CachedPlanSource* GlobalPlanCache::FetchFromSessionCache(GPCKey* key)
+{
+    GPCSessionCacheEnt *cache = u_sess->pcache_cxt.gpc_session_cache;
+    if (cache == NULL) {
+        return NULL;
+    }
+
+    GPCSessionCacheEnt *ent = &cache[key->fingerprint.lo & (GPC_SESSION_CACHE_SIZE - 1)];
+    if (ent->plansource == NULL || ent->query_length != key->query_length ||
+        !GPCFingerprintEqual(&ent->fingerprint, &key->fingerprint)) {
+        return NULL;
+    }
+
+    int slot = GetReaderSlot();
+    if (slot < 0) {
+        return NULL;
+    }
+
+    /*
+     * Enter the epoch, then check the plansource was not retired since the entry
+     * was filled. AddInvalidList bumps the retire generation before the epoch,
+     * so if it retired the plansource before our epoch we see the new generation.
+     */
+    uint64 epoch = pg_atomic_read_u64(&m_epoch);
+    pg_atomic_write_u64(&m_reader_slots[slot].slot.epoch, epoch);
+    pg_memory_barrier();
+    if (pg_atomic_read_u32(&m_retire_gen[GPCRetireGenIndex(key->fingerprint)]) != ent->retire_gen) {
+        m_reader_slots[slot].slot.epoch = 0;
+        ent->plansource = NULL;
+        return NULL;
+    }
+    CachedPlanSource* psrc = ent->plansource;
+    psrc->gpc.status.AddRefcount();
+    /* the pin must be visible before we leave the epoch, pairs with the read barrier in CanDrop */
+    pg_write_barrier();
+    m_reader_slots[slot].slot.epoch = 0;
+
+    /* pinned now, do the full comparison outside of the epoch */
+    if (memcmp(&psrc->gpc.key->spi_signature, &key->spi_signature, sizeof(SPISign)) != 0 ||
+        GPCKeyMatch(psrc->gpc.key, key, sizeof(GPCKey)) != 0 || !psrc->gpc.status.IsValid()) {
+        psrc->gpc.status.SubRefCount();
+        ent->plansource = NULL;
+        return NULL;
+    }
+    return psrc;
+}
+
+void GlobalPlanCache::FillSessionCache(GPCKey* key, CachedPlanSource* psrc, uint32 retire_gen)
+{
+    if (u_sess->pcache_cxt.gpc_session_cache == NULL) {
+        u_sess->pcache_cxt.gpc_session_cache = (GPCSessionCacheEnt *)MemoryContextAllocZero(
+            u_sess->cache_mem_cxt, sizeof(GPCSessionCacheEnt) * GPC_SESSION_CACHE_SIZE);
+    }
+    GPCSessionCacheEnt *ent =
+        &u_sess->pcache_cxt.gpc_session_cache[key->fingerprint.lo & (GPC_SESSION_CACHE_SIZE - 1)];
+    ent->fingerprint = key->fingerprint;
+    ent->query_length = key->query_length;
+    ent->retire_gen = retire_gen;
+    ent->plansource = psrc;
 }
 
 bool GlobalPlanCache::TryStore(CachedPlanSource *plansource,  PreparedStatement *ps)
@@ -287,7 +473,7 @@ bool GlobalPlanCache::TryStore(CachedPlanSource *plansource,  PreparedStatement
         entry->key.query_length = key->query_length;
         /* Set the magic number. */
         entry->val.plansource = plansource;
-        entry->val.used_count = 0;
+        plansource->gpc.used_count = 0;
         INSTR_TIME_SET_CURRENT(entry->val.last_use_time);
         /* off the link */
         plansource->next_saved = NULL;
@@ -360,8 +546,7 @@ CachedPlanSource* GlobalPlanCache::Fetch(const char *query_string, uint32 query_
 {
     GPCKey key;
     key.env.filled = false;
-    key.query_string = query_string;
-    key.query_length = query_len;
+    GPCKeySetQuery(&key, query_string, query_len);
     EnvFill(&key.env, false);
     key.env.search_path = NULL;
     key.env.num_params = num_params;
@@ -371,6 +556,16 @@ CachedPlanSource* GlobalPlanCache::Fetch(const char *query_string, uint32 query_
     else
         key.spi_signature = {(uint32)-1, 0, (uint32)-1, -1};
 
+    CachedPlanSource* cached = FetchFromSessionCache(&key);
+    if (cached != NULL) {
+        if (ENABLE_DN_GPC)
+            u_sess->pcache_cxt.private_refcount++;
+        pg_atomic_fetch_add_u32(&cached->gpc.used_count, 1);
+        return cached;
+    }
+
+    /* read before the lookup, a plansource retired after this is not trusted by the session cache */
+    uint32 retire_gen = pg_atomic_read_u32(&m_retire_gen[GPCRetireGenIndex(key.fingerprint)]);
     uint32 hashCode = GPCHashFunc((const void *) &key, sizeof(key));
 
     uint32 bucket_id = GetBucket(hashCode);
@@ -403,9 +598,10 @@ CachedPlanSource* GlobalPlanCache::Fetch(const char *query_string, uint32 query_
         }
         if (ENABLE_DN_GPC)
             u_sess->pcache_cxt.private_refcount++;
-        pg_atomic_fetch_add_u32(&entry->val.used_count, 1);
+        pg_atomic_fetch_add_u32(&psrc->gpc.used_count, 1);
         MemoryContextSwitchTo(oldcontext);
         LWLockRelease(GetMainLWLockByIndex(lock_id));
+        FillSessionCache(&key, psrc, retire_gen);
         return psrc;
     }
 
@@ -420,6 +616,9 @@ void GlobalPlanCache::AddInvalidList(CachedPlanSource* plansource)
     plansource->gpc.status.SetLoc(GPC_SHARE_IN_SHARE_TABLE_INVALID_LIST);
     m_invalid_list = dlappend(m_invalid_list, plansource);
     plansource->gpc.status.SetStatus(GPC_INVALID);
+    /* session cache entries filled before no longer trust the plansource, see FetchFromSessionCache */
+    (void)pg_atomic_fetch_add_u32(&m_retire_gen[GPCRetireGenIndex(plansource->gpc.key->fingerprint)], 1);
+    plansource->gpc.retire_epoch = pg_atomic_fetch_add_u64(&m_epoch, 1);
     END_CRIT_SECTION();
     MemoryContextSwitchTo(oldcontext);
     LWLockRelease(GPCClearLock);
@@ -432,7 +631,7 @@ void GlobalPlanCache::DropInvalid()
         DListCell *cell = m_invalid_list->head;
         while (cell != NULL) {
             CachedPlanSource *curr = (CachedPlanSource *)cell->data.ptr_value;
-            if (curr->gpc.status.RefCountZero()) {
+            if (CanDrop(curr)) {
                 Assert(curr->next_saved == NULL);
                 DListCell *next = cell->next;
                 GPC_LOG("drop invalid shared plancache", curr, curr->stmt_name);
@@ -886,6 +1085,7 @@ void GlobalPlanCache::SPITryStore(CachedPlanSource* plansource, SPIPlanPtr spipl
         entry->key.spi_signature = key->spi_signature;
         /* Set the magic number. */
         entry->val.plansource = plansource;
+        plansource->gpc.used_count = 0;
         //off the link
         plansource->next_saved = NULL;
         INSTR_TIME_SET_CURRENT(entry->val.last_use_time);
@@ -1024,12 +1224,12 @@ void GlobalPlanCache::CleanUpByTime()
 
         hash_seq_init(&hash_seq, m_array[bucket_id].hash_tbl);
         while ((entry = (GPCEntry*)hash_seq_search(&hash_seq)) != NULL) {
-            if (entry->val.used_count > 0) {
+            cur_plansource = entry->val.plansource;
+            if (cur_plansource->gpc.used_count > 0) {
                 entry->val.last_use_time = curTime;
-                entry->val.used_count = 0;
+                cur_plansource->gpc.used_count = 0;
                 continue;
             }
-            cur_plansource = entry->val.plansource;
             if (cur_plansource->gpc.status.RefCountZero() &&
                 INSTR_TIME_GET_DOUBLE(curTime) - INSTR_TIME_GET_DOUBLE(entry->val.last_use_time) >
                 u_sess->attr.attr_common.gpc_clean_timeout) {
@@ -1060,17 +1260,11 @@ void GlobalPlanCache::CleanUpByTime()
                     if (cur_plansource->gpc.status.RefCountZero() &&
                         INSTR_TIME_GET_DOUBLE(curTime) - INSTR_TIME_GET_DOUBLE(entry->val.last_use_time) >
                         u_sess->attr.attr_common.gpc_clean_timeout) {
+                        /* session caches may still point to it, free it through the invalid list */
                         GPC_LOG("drop shared plancache by time", cur_plansource, cur_plansource->stmt_name);
-                        DropCachedPlanInternal(cur_plansource);
                         hash_search(m_array[bucket_id].hash_tbl, (void *) key, HASH_REMOVE, &found);
-                        cur_plansource->magic = 0;
-                        MemoryContextUnSeal(cur_plansource->context);
-                        MemoryContextUnSeal(cur_plansource->query_context);
-                        if (cur_plansource->opFusionObj) {
-                            OpFusion::DropGlobalOpfusion((OpFusion*)(cur_plansource->opFusionObj));
-                        }
-                        MemoryContextDelete(cur_plansource->context);
                         m_array[bucket_id].count--;
+                        AddInvalidList(cur_plansource);
                     }
                 }
                 pfree((void *)key->query_string);
@@ -1080,6 +1274,7 @@ void GlobalPlanCache::CleanUpByTime()
                 pfree_ext(key);
             }
             LWLockRelease(GetMainLWLockByIndex(lock_id));
+            DropInvalid();
 
             list_free_ext(gpckey_list);
         }
@@ -305,6 +305,10 @@ void GPCCleanUpSessionSavedPlan()
     if (!ENABLE_GPC) {
         return;
     }
+    if (u_sess->pcache_cxt.gpc_reader_slot >= 0) {
+        g_instance.plan_cache->ReleaseReaderSlot(u_sess->pcache_cxt.gpc_reader_slot);
+        u_sess->pcache_cxt.gpc_reader_slot = -1;
+    }
     if (u_sess->pcache_cxt.first_saved_plan == NULL &&
         u_sess->pcache_cxt.unnamed_stmt_psrc == NULL &&
         u_sess->pcache_cxt.ungpc_saved_plan == NULL) {
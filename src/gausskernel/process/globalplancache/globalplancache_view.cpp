@@ -188,16 +188,10 @@ Datum GlobalPlanCache::PlanClean()
             cur = entry->val.plansource;
             if(cur->gpc.status.RefCountZero()) {
                 bool found = false;
-                DropCachedPlanInternal(cur);
-                cur->magic = 0;
+                /* session caches may still point to it, free it through the invalid list below */
                 hash_search(m_array[bucket_id].hash_tbl, (void *) &(entry->key), HASH_REMOVE, &found);
-                MemoryContextUnSeal(cur->context);
-                MemoryContextUnSeal(cur->query_context);
-                if (cur->opFusionObj) {
-                    OpFusion::DropGlobalOpfusion((OpFusion*)(cur->opFusionObj));
-                }
-                MemoryContextDelete(cur->context);
                 m_array[bucket_id].count--;
+                AddInvalidList(cur);
             }
         }
         LWLockRelease(GetMainLWLockByIndex(lock_id));
@@ -207,13 +201,16 @@ Datum GlobalPlanCache::PlanClean()
         cell = m_invalid_list->head;
         while (cell != NULL) {
             CachedPlanSource *curr = (CachedPlanSource *)cell->data.ptr_value;
-            if (curr->gpc.status.RefCountZero()) {
+            if (CanDrop(curr)) {
                 DListCell *next = cell->next;
                 m_invalid_list = dlist_delete_cell(m_invalid_list, cell, false);
                 DropCachedPlanInternal(curr);
                 curr->magic = 0;
                 MemoryContextUnSeal(curr->context);
                 MemoryContextUnSeal(curr->query_context);
+                if (curr->opFusionObj) {
+                    OpFusion::DropGlobalOpfusion((OpFusion*)(curr->opFusionObj));
+                }
                 MemoryContextDelete(curr->context);
                 cell = next;
             } else {
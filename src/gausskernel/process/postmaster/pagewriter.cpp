@@ -45,6 +45,10 @@
 #include "gstrace/gstrace_infra.h"
 #include "gstrace/postmaster_gstrace.h"
 
+#ifdef __USE_NUMA
+#include <numa.h>
+#endif
+
 #define MIN(A, B) ((B) < (A) ? (B) : (A))
 #define MAX(A, B) ((B) > (A) ? (B) : (A))
 #define FULL_CKPT g_instance.ckpt_cxt_ctl->flush_all_dirty_page
@@ -349,6 +353,68 @@ void candidate_buf_init(void)
     }
 }
 
+/*
+ * With several NUMA buffer pools, hand each pool its own group of sub threads
+ * and split the pool among them, so that a candidate list never mixes buffers
+ * of two nodes. When there are fewer sub threads than pools, fall back to the
+ * plain split and tag each list with the pool of its first buffer.
+ */
+static void init_candidate_list_pools(int thread_num)
+{
+    int num_pools = StrategyNumPools();
+
+    for (int i = 1; i <= thread_num; i++) {
+        PageWriterProc *pgwr = &g_instance.ckpt_cxt_ctl->pgwr_procs.writer_proc[i];
+        pgwr->pool_id = 0;
+    }
+    if (num_pools == 1) {
+        return;
+    }
+
+    if (thread_num < num_pools) {
+        for (int i = 1; i <= thread_num; i++) {
+            PageWriterProc *pgwr = &g_instance.ckpt_cxt_ctl->pgwr_procs.writer_proc[i];
+            int first_buf;
+            int num_bufs;
+
+            for (int pool = num_pools - 1; pool >= 0; pool--) {
+                StrategyPoolRange(pool, &first_buf, &num_bufs);
+                if (pgwr->buf_id_start >= first_buf) {
+                    pgwr->pool_id = pool;
+                    break;
+                }
+            }
+        }
+        ereport(WARNING, (errmodule(MOD_INCRE_CKPT),
+            errmsg("pagewriter_thread_num %d is less than the %d NUMA buffer pools, "
+                   "candidate lists are not kept per node", thread_num, num_pools)));
+        return;
+    }
+
+    for (int pool = 0; pool < num_pools; pool++) {
+        int first_thread = thread_num * pool / num_pools + 1;
+        int pool_threads = thread_num * (pool + 1) / num_pools + 1 - first_thread;
+        int first_buf;
+        int num_bufs;
+
+        StrategyPoolRange(pool, &first_buf, &num_bufs);
+        int avg_num = num_bufs / pool_threads;
+        for (int j = 0; j < pool_threads; j++) {
+            PageWriterProc *pgwr = &g_instance.ckpt_cxt_ctl->pgwr_procs.writer_proc[first_thread + j];
+            int start = first_buf + avg_num * j;
+            int end = start + avg_num;
+            if (j == pool_threads - 1) {
+                end += num_bufs % pool_threads;
+            }
+
+            pgwr->pool_id = pool;
+            pgwr->buf_id_start = start;
+            pgwr->cand_list_size = end - start;
+            pgwr->cand_buf_list = &g_instance.ckpt_cxt_ctl->candidate_buffers[start];
+        }
+    }
+}
+
 static void init_candidate_list()
 {
     int thread_num = g_instance.ckpt_cxt_ctl->pgwr_procs.sub_num;
@@ -392,6 +458,8 @@ static void init_candidate_list()
         pgwr->seg_cand_buf_list = &g_instance.ckpt_cxt_ctl->candidate_buffers[seg_start];
         pgwr->seg_id_start = seg_start;
     }
+
+    init_candidate_list_pools(thread_num);
 }
 
 int get_dirty_page_queue_head_buffer()
@@ -1677,6 +1745,20 @@ void ckpt_pagewriter_main(void)
         InitSync();
     }
 
+#ifdef __USE_NUMA
+    /* A sub thread runs on the node of the buffer pool its candidate list covers */
+    if (t_thrd.pagewriter_cxt.pagewriter_id > 0 && StrategyNumPools() > 1) {
+        int pool_id = g_instance.ckpt_cxt_ctl->pgwr_procs.writer_proc[t_thrd.pagewriter_cxt.pagewriter_id].pool_id;
+        if (numa_run_on_node(pool_id) == -1) {
+            ereport(WARNING, (errmodule(MOD_INCRE_CKPT),
+                errmsg("pagewriter thread %d could not run on NUMA node %d, errno: %d",
+                       t_thrd.pagewriter_cxt.pagewriter_id, pool_id, errno)));
+        } else {
+            numa_set_localalloc();
+        }
+    }
+#endif
+
     pg_time_t now = (pg_time_t) time(NULL);
     t_thrd.pagewriter_cxt.next_flush_time = now + u_sess->attr.attr_storage.pageWriterSleep;
     t_thrd.pagewriter_cxt.next_scan_time = now +
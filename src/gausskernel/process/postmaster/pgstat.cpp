@@ -5690,6 +5690,7 @@ static PgStat_StatTabEntry* pgstat_get_tab_entry(
         result->cu_mem_hit = 0;
         result->cu_hdd_sync = 0;
         result->cu_hdd_asyn = 0;
+        result->cu_mem_evict = 0;
         result->vacuum_timestamp = 0;
         result->vacuum_count = 0;
         result->autovac_vacuum_timestamp = 0;
@@ -6594,6 +6595,7 @@ static void pgstat_recv_tabstat(PgStat_MsgTabstat* msg, int len)
             tabentry->cu_mem_hit = tabmsg->t_counts.t_cu_mem_hit;
             tabentry->cu_hdd_sync = tabmsg->t_counts.t_cu_hdd_sync;
             tabentry->cu_hdd_asyn = tabmsg->t_counts.t_cu_hdd_asyn;
+            tabentry->cu_mem_evict = tabmsg->t_counts.t_cu_mem_evict;
 
             tabentry->vacuum_timestamp = 0;
             tabentry->vacuum_count = 0;
@@ -6632,6 +6634,7 @@ static void pgstat_recv_tabstat(PgStat_MsgTabstat* msg, int len)
             tabentry->cu_mem_hit += tabmsg->t_counts.t_cu_mem_hit;
             tabentry->cu_hdd_sync += tabmsg->t_counts.t_cu_hdd_sync;
             tabentry->cu_hdd_asyn += tabmsg->t_counts.t_cu_hdd_asyn;
+            tabentry->cu_mem_evict += tabmsg->t_counts.t_cu_mem_evict;
         }
 
         /* Clamp n_live_tuples in case of negative delta_live_tuples */
@@ -6683,6 +6686,7 @@ static void pgstat_recv_tabstat(PgStat_MsgTabstat* msg, int len)
             tabentry->cu_mem_hit = tabmsg->t_counts.t_cu_mem_hit;
             tabentry->cu_hdd_sync = tabmsg->t_counts.t_cu_hdd_sync;
             tabentry->cu_hdd_asyn = tabmsg->t_counts.t_cu_hdd_asyn;
+            tabentry->cu_mem_evict = tabmsg->t_counts.t_cu_mem_evict;
 
             tabentry->vacuum_timestamp = 0;
             tabentry->vacuum_count = 0;
@@ -6716,6 +6720,7 @@ static void pgstat_recv_tabstat(PgStat_MsgTabstat* msg, int len)
             tabentry->cu_mem_hit += tabmsg->t_counts.t_cu_mem_hit;
             tabentry->cu_hdd_sync += tabmsg->t_counts.t_cu_hdd_sync;
             tabentry->cu_hdd_asyn += tabmsg->t_counts.t_cu_hdd_asyn;
+            tabentry->cu_mem_evict += tabmsg->t_counts.t_cu_mem_evict;
         }
     }
 }
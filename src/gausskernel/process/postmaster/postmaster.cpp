@@ -2508,15 +2508,6 @@ static void CheckExtremeRtoGUCConflicts(void)
                     minReceiverBufSize / 1024),
                 errhint("recommend config \"wal_receiver_buffer_size=64MB\"")));
     }
-
-#ifndef ENABLE_MULTIPLE_NODES
-    if ((g_instance.attr.attr_storage.recovery_parse_workers > 1) && g_instance.attr.attr_storage.EnableHotStandby) {
-        ereport(ERROR,
-            (errcode(ERRCODE_SYSTEM_ERROR),
-                errmsg("extreme rto could not support hot standby."),
-                errhint("Either turn off extreme rto, or turn off hot_standby.")));
-    }
-#endif
 }
 static void CheckRecoveryParaConflict()
 {
@@ -1659,6 +1659,10 @@ void StreamNodeGroup::MarkSyncControllerStopFlagAll()
         foreach (lc, u_sess->stream_cxt.global_obj->m_syncControllers) {
             SyncController* controller = (SyncController*)lfirst(lc);
             controller->executor_stop = true;
+
+            /* wake up the threads waiting for a shared hash table */
+            if (controller->controller_type == T_HashJoin)
+                pthread_cond_broadcast(&((HashJoinSharedController*)controller)->cond);
         }
         u_sess->stream_cxt.global_obj->m_errorStop = true;
         streamLock.unLock();
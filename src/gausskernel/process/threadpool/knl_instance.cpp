@@ -134,7 +134,7 @@ static void knl_g_wal_init(knl_g_wal_context *const wal_cxt)
     wal_cxt->isWalWriterSleeping = false;
     wal_cxt->criticalEntryMutex = PTHREAD_MUTEX_INITIALIZER;
     wal_cxt->globalEndPosSegNo = InvalidXLogSegPtr;
-    wal_cxt->walWaitFlushCount = 0;
+    pg_atomic_init_u32(&wal_cxt->walWaitFlushCount, 0);
     wal_cxt->lastWalStatusEntryFlushed = -1;
     wal_cxt->lastLRCScanned = WAL_SCANNED_LRC_INIT;
     wal_cxt->lastLRCFlushed = WAL_SCANNED_LRC_INIT;
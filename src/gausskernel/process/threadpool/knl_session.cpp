@@ -524,6 +524,8 @@ static void knl_u_plancache_init(knl_u_plancache_context* pcache_cxt)
     pcache_cxt->gpc_first_send = true;
     pcache_cxt->gpc_in_try_store = false;
     pcache_cxt->gpc_in_batch = false;
+    pcache_cxt->gpc_session_cache = NULL;
+    pcache_cxt->gpc_reader_slot = -1;
 }
 
 static void knl_u_typecache_init(knl_u_typecache_context* tycache_cxt)
@@ -964,6 +964,8 @@ static void knl_t_parallel_decode_init(knl_t_parallel_decode_worker_context* par
     parallel_decode_cxt->shutdown_requested = false;
     parallel_decode_cxt->got_SIGHUP = false;
     parallel_decode_cxt->sleep_long = false;
+    parallel_decode_cxt->columnarMetaCache = NULL;
+    parallel_decode_cxt->columnarMetaCxt = NULL;
 }
 
 static void knl_t_parallel_decode_reader_init(knl_t_logical_read_worker_context* parallel_decode_reader_cxt)
@@ -1076,6 +1078,11 @@ static void KnlTApplyWorkerInit(knl_t_apply_worker_context* applyWorkerCxt)
     applyWorkerCxt->messageContext = NULL;
     applyWorkerCxt->logicalRepRelMapContext = NULL;
     applyWorkerCxt->applyContext = NULL;
+    applyWorkerCxt->parallelLeader = NULL;
+    applyWorkerCxt->streaming = false;
+    applyWorkerCxt->streamXid = InvalidTransactionId;
+    applyWorkerCxt->streamFile = NULL;
+    applyWorkerCxt->streamFiles = NULL;
 }
 
 static void KnlTPublicationInit(knl_t_publication_context* publicationCxt)
@@ -1299,6 +1306,8 @@ static void knl_t_storage_init(knl_t_storage_context* storage_cxt)
     storage_cxt->InProgressAioDispatchCount = 0;
     storage_cxt->InProgressAioBuf = NULL;
     storage_cxt->InProgressAioType = AioUnkown;
+    storage_cxt->InProgressUringBufs = NULL;
+    storage_cxt->InProgressUringCount = 0;
     storage_cxt->is_btree_split = false;
     storage_cxt->PrivateRefCountArray =
         (PrivateRefCountEntry*)palloc0(sizeof(PrivateRefCountEntry) * REFCOUNT_ARRAY_ENTRIES);
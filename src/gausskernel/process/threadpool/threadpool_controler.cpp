@@ -160,6 +160,10 @@ void ThreadPoolControler::Init(bool enableNumaDistribute)
         m_groups[i]->WaitReady();
     }
 
+    for (int i = 0; i < m_groupNum; i++) {
+        m_groups[i]->InitStealOrder(m_groups, m_groupNum);
+    }
+
 #ifdef __USE_NUMA
     if (enableNumaDistribute) {
         /* Set to interleave mode for other than worker thread */
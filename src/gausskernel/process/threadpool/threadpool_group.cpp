@@ -22,7 +22,9 @@
  *
  * ---------------------------------------------------------------------------------------
  */
-
+#ifdef __USE_NUMA
+#include <numa.h>
+#endif
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
@@ -73,6 +75,8 @@ ThreadPoolGroup::ThreadPoolGroup(int maxWorkerNum, int expectWorkerNum, int maxS
       m_waitServeSessionCount(0),
       m_processTaskCount(0),
       m_hasHanged(0),
+      m_giveAway(0),
+      m_lentSessionNum(0),
       m_groupId(groupId),
       m_numaId(numaId),
       m_groupCpuNum(cpuNum),
@@ -80,7 +84,9 @@ ThreadPoolGroup::ThreadPoolGroup(int maxWorkerNum, int expectWorkerNum, int maxS
       m_enableNumaDistribute(false),
       m_enableBindCpuNuma(enableBindCpuNuma),
       m_workers(NULL),
-      m_context(NULL)
+      m_context(NULL),
+      m_stealOrder(NULL),
+      m_stealOrderNum(0)
 {
     pthread_mutex_init(&m_mutex, NULL);
     CPU_ZERO(&m_nodeCpuSet);
@@ -100,6 +106,7 @@ ThreadPoolGroup::~ThreadPoolGroup()
 
     m_freeStreamList = NULL;
     m_streams = NULL;
+    m_stealOrder = NULL;
 }
 
 void ThreadPoolGroup::Init(bool enableNumaDistribute)
@@ -392,6 +399,87 @@ bool ThreadPoolGroup::IsGroupHanged()
     return m_hasHanged != 0;
 }
 
+/*
+ * Order the other groups by NUMA distance for work stealing. Groups at the
+ * same distance are taken starting right after this group, so that the groups
+ * of one node do not all pick the same victim first.
+ */
+void ThreadPoolGroup::InitStealOrder(ThreadPoolGroup** groups, int groupNum)
+{
+    ThreadPoolGroup** order = (ThreadPoolGroup**)palloc(sizeof(ThreadPoolGroup*) * groupNum);
+    int num = 0;
+
+    for (int i = 1; i < groupNum; i++) {
+        ThreadPoolGroup* other = groups[(m_groupId + i) % groupNum];
+        int distance = GetNumaDistance(other);
+        int j = num++;
+        while (j > 0 && GetNumaDistance(order[j - 1]) > distance) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = other;
+    }
+
+    /* workers are already running, publish the array before its length */
+    m_stealOrder = order;
+    pg_write_barrier();
+    m_stealOrderNum = num;
+}
+
+int ThreadPoolGroup::GetNumaDistance(const ThreadPoolGroup* other) const
+{
+    if (m_numaId < 0 || other->m_numaId < 0 || m_numaId == other->m_numaId) {
+        return 0;
+    }
+#ifdef __USE_NUMA
+    if (numa_available() >= 0) {
+        return numa_distance(m_numaId, other->m_numaId);
+    }
+#endif
+    return 1;
+}
+
+/*
+ * Whether a worker of thief may take a ready session of this group. The group
+ * gives sessions away only when none of its own workers is idle, from the
+ * moment its backlog reaches thread_pool_steal_threshold until it drops to half
+ * of that again. A thief on another NUMA node needs twice the threshold, so
+ * sessions only leave their node when the imbalance is large.
+ */
+bool ThreadPoolGroup::CanGiveAwaySession(const ThreadPoolGroup* thief)
+{
+    int threshold = g_instance.attr.attr_common.thread_pool_steal_threshold;
+    if (threshold <= 0 || m_idleWorkerNum != 0) {
+        return false;
+    }
+
+    /*
+     * Workers of all groups come here concurrently, flip the state only from the
+     * one we saw so that a stale backlog cannot undo a newer transition, and
+     * leave the cache line alone while the state does not change.
+     */
+    int backlog = m_waitServeSessionCount;
+    uint32 expected;
+    if (backlog >= threshold) {
+        expected = 0;
+        (void)pg_atomic_compare_exchange_u32(&m_giveAway, &expected, 1);
+    } else if (backlog <= threshold / 2) {
+        expected = 1;
+        (void)pg_atomic_compare_exchange_u32(&m_giveAway, &expected, 0);
+    }
+
+    if (GetNumaDistance(thief) > 0) {
+        return backlog >= threshold * 2;
+    }
+    return pg_atomic_read_u32(&m_giveAway) != 0;
+}
+
+/* Whether an idle worker of this group can serve a session of another group right now. */
+bool ThreadPoolGroup::CanTakeSession() const
+{
+    return m_idleWorkerNum > 0 && m_waitServeSessionCount == 0;
+}
+
 void ThreadPoolGroup::AttachThreadToCPU(ThreadId thread, int cpu)
 {
     cpu_set_t cpuset;
@@ -243,11 +243,15 @@ void ThreadPoolListener::AddEpoll(knl_session_context* session)
 
 bool ThreadPoolListener::TryFeedWorker(ThreadPoolWorker* worker)
 {
+    ThreadPoolGroup* group = m_group;
     Dlelem* sc = GetReadySession(worker);
+    if (sc == NULL) {
+        sc = StealReadySession(worker, &group);
+    }
     if (sc != NULL) {
-        worker->SetSession((knl_session_context*)sc->dle_val);
-        pg_atomic_fetch_sub_u32((volatile uint32*)&m_group->m_waitServeSessionCount, 1);
-        pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_processTaskCount, 1);
+        worker->SetSession((knl_session_context*)sc->dle_val, group);
+        pg_atomic_fetch_sub_u32((volatile uint32*)&group->m_waitServeSessionCount, 1);
+        pg_atomic_fetch_add_u32((volatile uint32*)&group->m_processTaskCount, 1);
         return true;
     } else {
         if (EnableLocalSysCache()) {
@@ -309,11 +313,11 @@ void ThreadPoolListener::ReaperAllSession()
                         " encounter FATAL problems before session close.")));
             abort();
         }
-        /* m_sessionCount should be sum of the list length of m_idleSessionList and m_readySessionList
-           and worker's attached session */
+        /* m_sessionCount should be sum of the list length of m_idleSessionList and m_readySessionList,
+           worker's attached session and the sessions lent to workers of other groups */
         pg_memory_barrier();
         if (m_idleSessionList->IsEmpty() && m_readySessionList->IsEmpty() &&
-            m_group->m_workerNum - m_group->m_idleWorkerNum == 0) {
+            m_group->m_workerNum - m_group->m_idleWorkerNum == 0 && m_group->m_lentSessionNum == 0) {
             ereport(WARNING, (errmsg("SessionCount should be zero when no session in this group.")));
             m_group->m_sessionCount = 0;
         }
@@ -432,10 +436,12 @@ void ThreadPoolListener::DispatchSession(knl_session_context* session)
             ereport(DEBUG2,
                     (errmodule(MOD_THREAD_POOL),
                      errmsg("%s remove session:%lu from idleSessionList to worker", __func__, session->session_id)));
-            if (((ThreadPoolWorker*)DLE_VAL(sc))->WakeUpToWork(session)) {
+            if (((ThreadPoolWorker*)DLE_VAL(sc))->WakeUpToWork(session, m_group)) {
                 pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_processTaskCount, 1);
                 break;
            }
+        } else if (DispatchSessionToOtherGroup(session)) {
+            break;
         } else {
             ereport(DEBUG2,
                     (errmodule(MOD_THREAD_POOL),
@@ -455,6 +461,70 @@ void ThreadPoolListener::DispatchSession(knl_session_context* session)
     }
 }
 
+/*
+ * Hand a session to an idle worker of another group when this group is
+ * overloaded, see ThreadPoolGroup::CanGiveAwaySession. The worker returns the
+ * session to this listener when it detaches.
+ */
+bool ThreadPoolListener::DispatchSessionToOtherGroup(knl_session_context* session)
+{
+    int num = m_group->m_stealOrderNum;
+    for (int i = 0; i < num; i++) {
+        ThreadPoolGroup* thief = m_group->m_stealOrder[i];
+        if (!thief->CanTakeSession() || !m_group->CanGiveAwaySession(thief)) {
+            continue;
+        }
+
+        Dlelem* sc = thief->GetListener()->GetFreeWorker(session);
+        if (sc == NULL) {
+            continue;
+        }
+        pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_lentSessionNum, 1);
+        if (((ThreadPoolWorker*)DLE_VAL(sc))->WakeUpToWork(session, m_group)) {
+            ereport(DEBUG2,
+                    (errmodule(MOD_THREAD_POOL),
+                     errmsg("%s dispatch session:%lu of group %d to a worker of group %d",
+                            __func__, session->session_id, m_group->GetGroupId(), thief->GetGroupId())));
+            pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_processTaskCount, 1);
+            return true;
+        }
+        pg_atomic_fetch_sub_u32((volatile uint32*)&m_group->m_lentSessionNum, 1);
+    }
+    return false;
+}
+
+/*
+ * Take a ready session of another group for an idle worker of this group. The
+ * groups are tried closest NUMA node first and at most one session is taken,
+ * the worker looks at its own group again before it steals the next one.
+ */
+Dlelem *ThreadPoolListener::StealReadySession(ThreadPoolWorker* worker, ThreadPoolGroup** victim)
+{
+    int num = m_group->m_stealOrderNum;
+    for (int i = 0; i < num; i++) {
+        ThreadPoolGroup* group = m_group->m_stealOrder[i];
+        if (!group->CanGiveAwaySession(m_group)) {
+            continue;
+        }
+
+        /* count the session as lent before it leaves the ready list, ReaperAllSession looks for it */
+        pg_atomic_fetch_add_u32((volatile uint32*)&group->m_lentSessionNum, 1);
+        Dlelem* sc = group->GetListener()->GetReadySession(worker);
+        if (sc == NULL) {
+            pg_atomic_fetch_sub_u32((volatile uint32*)&group->m_lentSessionNum, 1);
+        } else {
+            ereport(DEBUG2,
+                    (errmodule(MOD_THREAD_POOL),
+                     errmsg("%s steal session:%lu of group %d for a worker of group %d", __func__,
+                            ((knl_session_context*)DLE_VAL(sc))->session_id, group->GetGroupId(),
+                            m_group->GetGroupId())));
+            *victim = group;
+            return sc;
+        }
+    }
+    return NULL;
+}
+
 void ThreadPoolListener::DelSessionFromEpoll(knl_session_context* session)
 {
     if (ENABLE_THREAD_POOL_DN_LOGICCONN) {
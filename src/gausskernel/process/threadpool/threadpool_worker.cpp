@@ -79,6 +79,7 @@ ThreadPoolWorker::ThreadPoolWorker(uint idx, ThreadPoolGroup* group, pthread_mut
 {
     m_idx = idx;
     m_group = group;
+    m_sessionGroup = group;
     m_tid = InvalidTid;
     m_threadStatus = THREAD_UNINIT;
     m_currentSession = NULL;
@@ -93,6 +94,7 @@ ThreadPoolWorker::~ThreadPoolWorker()
 {
     m_currentSession = NULL;
     m_group = NULL;
+    m_sessionGroup = NULL;
     m_mutex = NULL;
     m_cond = NULL;
 }
@@ -244,12 +246,13 @@ void ThreadPoolWorker::WaitMission()
     ShutDownIfNecessary();
 }
 
-bool ThreadPoolWorker::WakeUpToWork(knl_session_context* session)
+bool ThreadPoolWorker::WakeUpToWork(knl_session_context* session, ThreadPoolGroup* sessionGroup)
 {
     bool succ = true;
     pthread_mutex_lock(m_mutex);
     if (likely(m_threadStatus != THREAD_EXIT && m_threadStatus != THREAD_PENDING)) {
         m_currentSession = session;
+        m_sessionGroup = sessionGroup;
         pthread_cond_signal(m_cond);
     } else {
         succ = false;
@@ -531,6 +534,17 @@ void ThreadPoolWorker::CleanThread()
     }
 }
 
+/*
+ * A session of another group is back in the hands of its listener, it no longer
+ * counts as lent, see ThreadPoolListener::ReaperAllSession.
+ */
+void ThreadPoolWorker::ReturnLentSession()
+{
+    if (m_sessionGroup != m_group) {
+        pg_atomic_fetch_sub_u32((volatile uint32*)&m_sessionGroup->m_lentSessionNum, 1);
+    }
+}
+
 void ThreadPoolWorker::DetachSessionFromThread()
 {
     /* session attach thread success, we record relation of sock with worker */
@@ -565,8 +579,9 @@ void ThreadPoolWorker::DetachSessionFromThread()
     pgstat_deinitialize_session();
     m_currentSession->attachPid = (ThreadId)-1;
 
-    /* should restore the data before return to listener. */
-    m_group->GetListener()->AddEpoll(m_currentSession);
+    /* should restore the data before return to listener, a stolen session goes back to its own group. */
+    m_sessionGroup->GetListener()->AddEpoll(m_currentSession);
+    ReturnLentSession();
     m_currentSession = NULL;
     u_sess = NULL;
 }
@@ -716,7 +731,8 @@ void ThreadPoolWorker::CleanUpSession(bool threadexit)
         }
 
         /* Close Session. */
-        m_group->GetListener()->DelSessionFromEpoll(m_currentSession);
+        m_sessionGroup->GetListener()->DelSessionFromEpoll(m_currentSession);
+        ReturnLentSession();
 
         if (m_currentSession->proc_cxt.PassConnLimit) {
             SpinLockAcquire(&g_instance.conn_cxt.ConnCountLock);
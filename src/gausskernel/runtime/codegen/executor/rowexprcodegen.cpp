@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * rowexprcodegen.cpp
+ *     codegeneration of qual expressions evaluated by the row engine
+ *
+ * IDENTIFICATION
+ *     Code/src/gausskernel/runtime/codegen/executor/rowexprcodegen.cpp
+ *
+ * -----------------------------------------------------------------------
+ */
+#include "codegen/gscodegen.h"
+#include "codegen/rowexprcodegen.h"
+#include "codegen/foreignscancodegen.h"
+#include "catalog/pg_operator.h"
+#include "utils/lsyscache.h"
+
+using namespace llvm;
+using namespace dorado;
+
+namespace dorado {
+static bool IsJittableIntType(Oid typeOid)
+{
+    return (typeOid == INT2OID || typeOid == INT4OID || typeOid == INT8OID);
+}
+
+bool RowExprCodeGen::IsJittableExpr(Expr* expr)
+{
+    if (expr == NULL || !IsA(expr, OpExpr))
+        return false;
+
+    OpExpr* op = (OpExpr*)expr;
+    if (list_length(op->args) != 2)
+        return false;
+
+    /* The operators supported are the same as the ones of HDFS predicates */
+    if (!ForeignScanCodeGen::IsJittableExpr(expr))
+        return false;
+
+    Node* leftop = (Node*)linitial(op->args);
+    Node* rightop = (Node*)lsecond(op->args);
+    if (!IsA(leftop, Var) || !IsA(rightop, Const))
+        return false;
+
+    Var* var = (Var*)leftop;
+    Const* con = (Const*)rightop;
+
+    /* whole-row and system attributes go through the interpreter */
+    if (var->varattno <= 0)
+        return false;
+
+    /* A null constant makes the strict operator return NULL, not false */
+    if (con->constisnull)
+        return false;
+
+    return IsJittableIntType(var->vartype) && IsJittableIntType(con->consttype);
+}
+
+bool RowExprCodeGen::OperCodeGen(Expr* expr, PlanState* parent, void** jittedFunc)
+{
+    /*
+     * The predicate takes the Var value as its only argument, so turn
+     * "Const op Var" into "Var commutator Const" first.
+     */
+    if (expr != NULL && IsA(expr, OpExpr) && list_length(((OpExpr*)expr)->args) == 2) {
+        OpExpr* op = (OpExpr*)expr;
+        Node* leftop = (Node*)linitial(op->args);
+        Node* rightop = (Node*)lsecond(op->args);
+
+        if (IsA(leftop, Const) && IsA(rightop, Var)) {
+            Oid commutator = get_commutator(op->opno);
+            OpExpr* commuted = NULL;
+
+            if (!OidIsValid(commutator))
+                return false;
+
+            commuted = (OpExpr*)copyObject(op);
+            commuted->opno = commutator;
+            commuted->opfuncid = get_opcode(commutator);
+            commuted->args = list_make2(rightop, leftop);
+            expr = (Expr*)commuted;
+        }
+    }
+
+    if (!IsJittableExpr(expr))
+        return false;
+
+    return ForeignScanCodeGen::ScanCodeGen(expr, parent, jittedFunc);
+}
+}  // namespace dorado
+
+bool RowOperExprCodeGen(Expr* expr, PlanState* parent, void** jittedFunc)
+{
+    return RowExprCodeGen::OperCodeGen(expr, parent, jittedFunc);
+}
@@ -41,6 +41,7 @@
 #include "access/tupconvert.h"
 #include "access/tableam.h"
 #include "catalog/pg_cast.h"
+#include "catalog/pg_language.h"
 #include "catalog/pg_type.h"
 #include "commands/typecmds.h"
 #include "executor/exec/execdebug.h"
@@ -113,6 +114,12 @@ static Datum ExecMakeFunctionResultNoSets(
     FuncExprState* fcache, ExprContext* econtext, bool* isNull, ExprDoneCond* isDone);
 static Datum ExecEvalFunc(FuncExprState* fcache, ExprContext* econtext, bool* isNull, ExprDoneCond* isDone);
 static Datum ExecEvalOper(FuncExprState* fcache, ExprContext* econtext, bool* isNull, ExprDoneCond* isDone);
+static bool ExecInitOperArgSteps(FuncExprState* fcache);
+static Datum ExecEvalOperFast(FuncExprState* fcache, ExprContext* econtext, bool* isNull, ExprDoneCond* isDone);
+#ifdef ENABLE_LLVM_COMPILE
+static bool ExecOperConsiderCodeGen(PlanState* parent);
+static Datum ExecEvalOperJitted(FuncExprState* fcache, ExprContext* econtext, bool* isNull, ExprDoneCond* isDone);
+#endif
 static Datum ExecEvalDistinct(FuncExprState* fcache, ExprContext* econtext, bool* isNull, ExprDoneCond* isDone);
 static Datum ExecEvalScalarArrayOp(
     ScalarArrayOpExprState* sstate, ExprContext* econtext, bool* isNull, ExprDoneCond* isDone);
@@ -153,6 +160,13 @@ static Datum ExecEvalGroupingIdExpr(
 static bool func_has_refcursor_args(Oid Funcid, FunctionCallInfoData* fcinfo);
 extern struct varlena *heap_tuple_fetch_and_copy(Relation rel, struct varlena *attr, bool needcheck);
 static void check_huge_clob_paramter(FunctionCallInfoData* fcinfo, bool is_have_huge_clob);
+#ifdef ENABLE_LLVM_COMPILE
+extern bool CodeGenThreadObjectReady();
+extern bool CodeGenPassThreshold(double rows, int dn_num, int dop);
+extern bool RowOperExprCodeGen(Expr* expr, PlanState* parent, void** jittedFunc);
+
+typedef bool (*RowJittedIntPredicate)(int64 value);
+#endif
 
 THR_LOCAL PLpgSQL_execstate* plpgsql_estate = NULL;
 
@@ -573,6 +587,41 @@ static Datum ExecEvalWindowFunc(WindowFuncExprState* wfunc, ExprContext* econtex
     return econtext->ecxt_aggvalues[wfunc->wfuncno];
 }
 
+/*
+ * Return the slot a Var with the given varno is fetched from.
+ */
+static inline TupleTableSlot* ExecVarSlot(ExprContext* econtext, Index varno)
+{
+    switch (varno) {
+        case INNER_VAR: /* get the tuple from the inner node */
+            return econtext->ecxt_innertuple;
+
+        case OUTER_VAR: /* get the tuple from the outer node */
+            return econtext->ecxt_outertuple;
+
+            /* INDEX_VAR is handled by default case */
+        default: /* get the tuple from the relation being scanned */
+            return econtext->ecxt_scantuple;
+    }
+}
+
+/*
+ * Same for a Var flattened into an ExprArgStep by ExecInitOperArgSteps.
+ */
+static inline TupleTableSlot* ExecArgStepSlot(ExprContext* econtext, const ExprArgStep* step)
+{
+    Assert(step->kind != EEOP_ARG_CONST);
+
+    switch (step->kind) {
+        case EEOP_ARG_INNER_VAR:
+            return econtext->ecxt_innertuple;
+        case EEOP_ARG_OUTER_VAR:
+            return econtext->ecxt_outertuple;
+        default:
+            return econtext->ecxt_scantuple;
+    }
+}
+
 /* ----------------------------------------------------------------
  *		ExecEvalScalarVar
  *
@@ -594,20 +643,7 @@ static Datum ExecEvalScalarVar(ExprState* exprstate, ExprContext* econtext, bool
         *isDone = ExprSingleResult;
 
     /* Get the input slot and attribute number we want */
-    switch (variable->varno) {
-        case INNER_VAR: /* get the tuple from the inner node */
-            slot = econtext->ecxt_innertuple;
-            break;
-
-        case OUTER_VAR: /* get the tuple from the outer node */
-            slot = econtext->ecxt_outertuple;
-            break;
-
-            /* INDEX_VAR is handled by default case */
-        default: /* get the tuple from the relation being scanned */
-            slot = econtext->ecxt_scantuple;
-            break;
-    }
+    slot = ExecVarSlot(econtext, variable->varno);
 
     Assert(slot != NULL);
 
@@ -681,20 +717,7 @@ static Datum ExecEvalScalarVarFast(ExprState* exprstate, ExprContext* econtext,
         *isDone = ExprSingleResult;
 
     /* Get the input slot and attribute number we want */
-    switch (variable->varno) {
-        case INNER_VAR: /* get the tuple from the inner node */
-            slot = econtext->ecxt_innertuple;
-            break;
-
-        case OUTER_VAR: /* get the tuple from the outer node */
-            slot = econtext->ecxt_outertuple;
-            break;
-
-            /* INDEX_VAR is handled by default case */
-        default: /* get the tuple from the relation being scanned */
-            slot = econtext->ecxt_scantuple;
-            break;
-    }
+    slot = ExecVarSlot(econtext, variable->varno);
 
     attnum = variable->varattno;
 
@@ -3281,13 +3304,232 @@ static Datum ExecEvalOper(FuncExprState* fcache, ExprContext* econtext, bool* is
                 fcache->xprstate.evalfunc = (ExprStateEvalFunc)ExecMakeFunctionResultNoSets<false, true>;
                 return ExecMakeFunctionResultNoSets<false, true>(fcache, econtext, isNull, isDone);
             } else {
-                fcache->xprstate.evalfunc = (ExprStateEvalFunc)ExecMakeFunctionResultNoSets<false, false>;
+                /*
+                 * Simple operators get the flattened fast path from the next
+                 * call on.  The first call still goes through the generic
+                 * path so that the argument Vars do their one-time checks.
+                 */
+                if (ExecInitOperArgSteps(fcache))
+                    fcache->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalOperFast;
+                else
+                    fcache->xprstate.evalfunc = (ExprStateEvalFunc)ExecMakeFunctionResultNoSets<false, false>;
                 return ExecMakeFunctionResultNoSets<false, false>(fcache, econtext, isNull, isDone);
             }
         }
     }
 }
 
+/* ----------------------------------------------------------------
+ *		ExecInitOperArgSteps
+ *
+ *		Try to flatten the argument evaluation of an operator into an
+ *		array of fetch steps.  This is possible when the operator is a
+ *		strict built-in function and each argument is a plain Var or Const,
+ *		possibly under a binary-compatible RelabelType, which covers most
+ *		"col op const" and "col op col" quals.  Anything else needs the
+ *		bookkeeping done by ExecMakeFunctionResultNoSets, and so does
+ *		function usage tracking, which the flattened path leaves out.
+ *
+ *		Returns true and sets fcache->argSteps on success.
+ * ----------------------------------------------------------------
+ */
+static bool ExecInitOperArgSteps(FuncExprState* fcache)
+{
+    FmgrInfo* flinfo = &fcache->func;
+    int nargs = list_length(fcache->args);
+    ExprArgStep* steps = NULL;
+    ListCell* arg = NULL;
+    int i = 0;
+
+    if (u_sess->attr.attr_common.pgstat_track_functions != TRACK_FUNC_OFF)
+        return false;
+
+    if (!flinfo->fn_strict || flinfo->fn_retset || flinfo->fn_fenced ||
+        flinfo->fn_languageId != INTERNALlanguageId)
+        return false;
+
+    if (nargs == 0 || nargs > FUNC_PREALLOCED_ARGS)
+        return false;
+
+    /* Do all the checks before allocating anything */
+    foreach (arg, fcache->args) {
+        ExprState* argstate = (ExprState*)lfirst(arg);
+        Expr* argexpr = argstate->expr;
+
+        while (argexpr != NULL && IsA(argexpr, RelabelType))
+            argexpr = ((RelabelType*)argexpr)->arg;
+
+        if (argexpr == NULL)
+            return false;
+
+        /* huge clob arguments need the detoast and permission checks */
+        if (argstate->resultType == CLOBOID || argstate->resultType == BLOBOID)
+            return false;
+
+        if (IsA(argexpr, Var)) {
+            if (((Var*)argexpr)->varattno == InvalidAttrNumber)
+                return false;
+        } else if (!IsA(argexpr, Const)) {
+            return false;
+        }
+    }
+
+    steps = (ExprArgStep*)MemoryContextAllocZero(flinfo->fn_mcxt, nargs * sizeof(ExprArgStep));
+    foreach (arg, fcache->args) {
+        Expr* argexpr = ((ExprState*)lfirst(arg))->expr;
+
+        while (IsA(argexpr, RelabelType))
+            argexpr = ((RelabelType*)argexpr)->arg;
+
+        if (IsA(argexpr, Var)) {
+            Var* variable = (Var*)argexpr;
+
+            switch (variable->varno) {
+                case INNER_VAR:
+                    steps[i].kind = EEOP_ARG_INNER_VAR;
+                    break;
+                case OUTER_VAR:
+                    steps[i].kind = EEOP_ARG_OUTER_VAR;
+                    break;
+                default:
+                    steps[i].kind = EEOP_ARG_SCAN_VAR;
+                    break;
+            }
+            steps[i].attnum = variable->varattno;
+        } else {
+            Const* con = (Const*)argexpr;
+
+            steps[i].kind = EEOP_ARG_CONST;
+            steps[i].constvalue = con->constvalue;
+            steps[i].constisnull = con->constisnull;
+        }
+        i++;
+    }
+
+    fcache->argSteps = steps;
+    return true;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecEvalOperFast
+ *
+ *		Evaluate an operator whose arguments were flattened by
+ *		ExecInitOperArgSteps.  Arguments are fetched in one loop and the
+ *		strictness check is folded into it, so a NULL argument returns
+ *		before the remaining ones are even fetched.
+ * ----------------------------------------------------------------
+ */
+static Datum ExecEvalOperFast(FuncExprState* fcache, ExprContext* econtext, bool* isNull, ExprDoneCond* isDone)
+{
+    FunctionCallInfo fcinfo = &fcache->fcinfo_data;
+    const ExprArgStep* step = fcache->argSteps;
+    int nargs = fcinfo->nargs;
+    Datum result;
+
+    /* track_functions was turned on since the steps were set up */
+    if (unlikely(u_sess->attr.attr_common.pgstat_track_functions != TRACK_FUNC_OFF))
+        return ExecMakeFunctionResultNoSets<false, false>(fcache, econtext, isNull, isDone);
+
+    if (isDone != NULL)
+        *isDone = ExprSingleResult;
+
+    econtext->plpgsql_estate = plpgsql_estate;
+    plpgsql_estate = NULL;
+
+    for (int i = 0; i < nargs; i++, step++) {
+        if (step->kind == EEOP_ARG_CONST) {
+            fcinfo->arg[i] = step->constvalue;
+            fcinfo->argnull[i] = step->constisnull;
+        } else {
+            fcinfo->arg[i] = tableam_tslot_getattr(ExecArgStepSlot(econtext, step), step->attnum, &fcinfo->argnull[i]);
+        }
+
+        /* operator is known strict */
+        if (fcinfo->argnull[i]) {
+            *isNull = true;
+            return (Datum)0;
+        }
+    }
+
+    fcinfo->can_ignore = econtext->can_ignore;
+    fcinfo->isnull = false;
+    result = FunctionCallInvoke(fcinfo);
+    *isNull = fcinfo->isnull;
+
+    return result;
+}
+
+#ifdef ENABLE_LLVM_COMPILE
+/* ----------------------------------------------------------------
+ *		ExecOperConsiderCodeGen
+ *
+ *		Decide whether an operator of a row engine plan node is worth
+ *		compiling.  Like the vectorized engine we skip short queries,
+ *		as compiling the module costs more than it saves for them.
+ * ----------------------------------------------------------------
+ */
+static bool ExecOperConsiderCodeGen(PlanState* parent)
+{
+    if (parent == NULL || parent->plan == NULL || parent->plan->vec_output)
+        return false;
+
+    if (parent->state == NULL || parent->state->es_plannedstmt == NULL)
+        return false;
+
+    return CodeGenThreadObjectReady() && CodeGenPassThreshold(parent->plan->plan_rows,
+                                                              parent->state->es_plannedstmt->num_nodes,
+                                                              parent->plan->dop);
+}
+
+/* ----------------------------------------------------------------
+ *		ExecEvalOperJitted
+ *
+ *		Evaluate an operator through the machine code generated by
+ *		RowOperExprCodeGen.  The first call goes through ExecEvalOper to
+ *		do the permission and argument checks and to set up the argument
+ *		steps; if the module did not get compiled we stay on whatever
+ *		path ExecEvalOper has chosen.
+ * ----------------------------------------------------------------
+ */
+static Datum ExecEvalOperJitted(FuncExprState* fcache, ExprContext* econtext, bool* isNull, ExprDoneCond* isDone)
+{
+    const ExprArgStep* step = fcache->argSteps;
+    Datum value;
+
+    if (fcache->func.fn_oid == InvalidOid) {
+        Datum result = ExecEvalOper(fcache, econtext, isNull, isDone);
+
+        if (fcache->jittedFunc != NULL && fcache->argSteps != NULL)
+            fcache->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalOperJitted;
+        return result;
+    }
+
+    if (unlikely(u_sess->attr.attr_common.pgstat_track_functions != TRACK_FUNC_OFF))
+        return ExecMakeFunctionResultNoSets<false, false>(fcache, econtext, isNull, isDone);
+
+    if (isDone != NULL)
+        *isDone = ExprSingleResult;
+
+    /* one argument is the Var, "Const op Var" was commuted by RowExprCodeGen */
+    Assert(step != NULL);
+    if (step->kind == EEOP_ARG_CONST)
+        step++;
+
+    value = tableam_tslot_getattr(ExecArgStepSlot(econtext, step), step->attnum, isNull);
+    if (*isNull)
+        return (Datum)0;
+
+    switch (fcache->fcinfo_data.argTypes[step - fcache->argSteps]) {
+        case INT2OID:
+            return BoolGetDatum(((RowJittedIntPredicate)fcache->jittedFunc)((int64)DatumGetInt16(value)));
+        case INT4OID:
+            return BoolGetDatum(((RowJittedIntPredicate)fcache->jittedFunc)((int64)DatumGetInt32(value)));
+        default:
+            return BoolGetDatum(((RowJittedIntPredicate)fcache->jittedFunc)(DatumGetInt64(value)));
+    }
+}
+#endif
+
 /* ----------------------------------------------------------------
  *		ExecEvalDistinct
  *
@@ -5378,6 +5620,11 @@ ExprState* ExecInitExpr(Expr* node, PlanState* parent)
             fstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalOper;
             fstate->args = (List*)ExecInitExpr((Expr*)opexpr->args, parent);
             fstate->func.fn_oid = InvalidOid; /* not initialized */
+#ifdef ENABLE_LLVM_COMPILE
+            /* Generate IR for simple quals of row engine plans */
+            if (ExecOperConsiderCodeGen(parent) && RowOperExprCodeGen((Expr*)opexpr, parent, &fstate->jittedFunc))
+                fstate->xprstate.evalfunc = (ExprStateEvalFunc)ExecEvalOperJitted;
+#endif
             state = (ExprState*)fstate;
         } break;
         case T_DistinctExpr: {
@@ -1417,8 +1417,7 @@ void GPCFillMsgForLp(CachedPlanSource* psrc)
         pfree_ext(psrc->gpc.key);
         MemoryContext oldcxt = MemoryContextSwitchTo(psrc->context);
         psrc->gpc.key = (GPCKey*)palloc0(sizeof(GPCKey));
-        psrc->gpc.key->query_string = psrc->query_string;
-        psrc->gpc.key->query_length = (uint32)strlen(psrc->query_string);
+        GPCKeySetQuery(psrc->gpc.key, psrc->query_string, (uint32)strlen(psrc->query_string));
         psrc->gpc.key->spi_signature = psrc->spi_signature;
         GlobalPlanCache::EnvFill(&psrc->gpc.key->env, psrc->dependsOnRole);
         psrc->gpc.key->env.search_path = psrc->search_path;
@@ -1268,7 +1268,7 @@ void BitmapHeapPrefetchNext(
 
     Assert(node->tbm == tbm);
 
-    ADIO_RUN()
+    ASYNC_PREFETCH_RUN()
     {
         /* prefetch next asynchronously */
         BitmapHeapPrefetchNextAsync(node, scan, tbm, prefetch_iterator);
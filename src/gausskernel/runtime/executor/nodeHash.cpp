@@ -27,10 +27,12 @@
 #include "catalog/pg_partition_fn.h"
 #include "catalog/pg_statistic.h"
 #include "commands/tablespace.h"
+#include "distributelayer/streamCore.h"
 #include "executor/exec/execdebug.h"
 #include "executor/hashjoin.h"
 #include "executor/node/nodeHash.h"
 #include "executor/node/nodeHashjoin.h"
+#include "executor/node/nodeRecursiveunion.h"
 #include "miscadmin.h"
 #include "optimizer/clauses.h"
 #include "optimizer/streamplan.h"
@@ -258,51 +260,134 @@ void ExecEndHash(HashState* node)
 }
 
 /* ----------------------------------------------------------------
- *		ExecHashTableCreate
+ *		ExecHashTableChooseSize
  *
- *		create an empty hashtable data structure for hashjoin.
+ *		compute the size of the hash table of a Hash node.  A shared
+ *		table cannot spill or spread, so it gets no skew buckets and no
+ *		auto spread; it is held to the work memory of one thread.
  * ----------------------------------------------------------------
  */
-HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNulls)
+static void ExecHashTableChooseSize(
+    Hash* node, bool shared, int* nbuckets, int* nbatch, int* num_skew_mcvs, int64* work_mem, int64* max_mem)
 {
-    HashJoinTable hashtable;
-    Plan* outerNode = NULL;
-    int nbuckets;
-    int nbatch;
-    int num_skew_mcvs;
-    int log2_nbuckets;
-    int nkeys;
-    int i;
-    int64 local_work_mem = SET_NODEMEM(node->plan.operatorMemKB[0], node->plan.dop);
-    int64 max_mem = (node->plan.operatorMaxMem > 0) ? SET_NODEMEM(node->plan.operatorMaxMem, node->plan.dop) : 0;
-    ListCell* ho = NULL;
-    MemoryContext oldcxt;
-
     /*
      * Get information about the size of the relation to be hashed (it's the
      * "outer" subtree of this node, but the inner relation of the hashjoin).
-     * Compute the appropriate size of the hash table.
      */
-    outerNode = outerPlan(node);
+    Plan* outerNode = outerPlan(node);
+
+    *work_mem = SET_NODEMEM(node->plan.operatorMemKB[0], node->plan.dop);
+    *max_mem = (node->plan.operatorMaxMem > 0) ? SET_NODEMEM(node->plan.operatorMaxMem, node->plan.dop) : 0;
+    if (shared)
+        *max_mem = 0;
 
     ExecChooseHashTableSize(PLAN_LOCAL_ROWS(outerNode) / SET_DOP(node->plan.dop),
         outerNode->plan_width,
-        OidIsValid(node->skewTable),
-        &nbuckets,
-        &nbatch,
-        &num_skew_mcvs,
-        local_work_mem);
+        OidIsValid(node->skewTable) && !shared,
+        nbuckets,
+        nbatch,
+        num_skew_mcvs,
+        *work_mem);
 
     /*
      * If we allows mem auto spread, we should set nbatch to 1 to avoid disk
      * spill if estimation from optimizer differs from that from executor
      */
-    if (node->plan.operatorMaxMem > 0 && nbatch > 1 && nbuckets < INT_MAX / nbatch) {
-        if (nbuckets * nbatch < (int)(MaxAllocSize / sizeof(HashJoinTuple))) {
-            nbuckets *= nbatch;
-            nbatch = 1;
+    if (*max_mem > 0 && *nbatch > 1 && *nbuckets < INT_MAX / *nbatch) {
+        if (*nbuckets * *nbatch < (int)(MaxAllocSize / sizeof(HashJoinTuple))) {
+            *nbuckets *= *nbatch;
+            *nbatch = 1;
         }
     }
+}
+
+/*
+ * ExecHashTableCanShare
+ *	  Can the inner relation of this Hash node be built as one in-memory
+ *	  table shared by all the SMP threads?  A shared table cannot spill, so the
+ *	  estimated inner relation must fit in a single batch within the work
+ *	  memory of one thread; otherwise every thread builds its own table, which
+ *	  can spill.  Every thread comes to the same answer.
+ */
+bool ExecHashTableCanShare(Hash* node)
+{
+    int nbuckets;
+    int nbatch;
+    int num_skew_mcvs;
+    int64 work_mem;
+    int64 max_mem;
+
+    ExecHashTableChooseSize(node, true, &nbuckets, &nbatch, &num_skew_mcvs, &work_mem, &max_mem);
+
+    return nbatch == 1;
+}
+
+/*
+ * Look up the hash functions of each hash key, and remember whether the
+ * join operators are strict.
+ */
+static void ExecHashTableInitHashFunctions(HashJoinTable hashtable, List* hashOperators)
+{
+    int nkeys;
+    int i;
+    ListCell* ho = NULL;
+
+    nkeys = list_length(hashOperators);
+    hashtable->outer_hashfunctions = (FmgrInfo*)palloc(nkeys * sizeof(FmgrInfo));
+    hashtable->inner_hashfunctions = (FmgrInfo*)palloc(nkeys * sizeof(FmgrInfo));
+    hashtable->hashStrict = (bool*)palloc(nkeys * sizeof(bool));
+    i = 0;
+    foreach (ho, hashOperators) {
+        Oid hashop = lfirst_oid(ho);
+        Oid left_hashfn;
+        Oid right_hashfn;
+
+        if (!get_op_hash_functions(hashop, &left_hashfn, &right_hashfn))
+            ereport(ERROR,
+                (errcode(ERRCODE_UNDEFINED_FUNCTION),
+                    errmodule(MOD_EXECUTOR),
+                    errmsg("could not find hash function for hash operator %u", hashop)));
+        fmgr_info(left_hashfn, &hashtable->outer_hashfunctions[i]);
+        fmgr_info(right_hashfn, &hashtable->inner_hashfunctions[i]);
+        hashtable->hashStrict[i] = op_strict(hashop);
+        i++;
+    }
+}
+
+/* ----------------------------------------------------------------
+ *		ExecHashTableCreate
+ *
+ *		create an empty hashtable data structure for hashjoin.
+ *
+ *		If shared is true, the working storage is created under the
+ *		stream runtime context so that the other SMP threads of the
+ *		stream group can attach to it once it is built, see
+ *		ExecHashTableAttach.
+ * ----------------------------------------------------------------
+ */
+HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNulls, bool shared)
+{
+    HashJoinTable hashtable;
+    int nbuckets;
+    int nbatch;
+    int num_skew_mcvs;
+    int log2_nbuckets;
+    int64 local_work_mem;
+    int64 max_mem;
+    MemoryContext oldcxt;
+    MemoryContext parentcxt = CurrentMemoryContext;
+    MemoryContextType cxttype = STANDARD_CONTEXT;
+
+    /*
+     * Compute the appropriate size of the hash table.
+     */
+    ExecHashTableChooseSize(node, shared, &nbuckets, &nbatch, &num_skew_mcvs, &local_work_mem, &max_mem);
+
+    if (shared) {
+        Assert(nbatch == 1 && u_sess->stream_cxt.global_obj != NULL);
+        parentcxt = u_sess->stream_cxt.global_obj->m_streamRuntimeContext;
+        cxttype = SHARED_CONTEXT;
+    }
 
 #ifdef HJDEBUG
     printf("nbatch = %d, nbuckets = %d\n", nbatch, nbuckets);
@@ -332,7 +417,8 @@ HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNull
     hashtable->curbatch = 0;
     hashtable->nbatch_original = nbatch;
     hashtable->nbatch_outstart = nbatch;
-    hashtable->growEnabled = true;
+    /* a shared table has other readers waiting for it, so it must not spill */
+    hashtable->growEnabled = !shared;
     hashtable->totalTuples = 0;
     hashtable->innerBatchFile = NULL;
     hashtable->outerBatchFile = NULL;
@@ -350,42 +436,24 @@ HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNull
     /* should we allow auto mem spread in query mem mode? */
     hashtable->maxMem = max_mem * 1024L;
     hashtable->spreadNum = 0;
+    hashtable->sharedController = NULL;
 
     /*
      * Get info about the hash functions to be used for each hash key. Also
      * remember whether the join operators are strict.
      */
-    nkeys = list_length(hashOperators);
-    hashtable->outer_hashfunctions = (FmgrInfo*)palloc(nkeys * sizeof(FmgrInfo));
-    hashtable->inner_hashfunctions = (FmgrInfo*)palloc(nkeys * sizeof(FmgrInfo));
-    hashtable->hashStrict = (bool*)palloc(nkeys * sizeof(bool));
-    i = 0;
-    foreach (ho, hashOperators) {
-        Oid hashop = lfirst_oid(ho);
-        Oid left_hashfn;
-        Oid right_hashfn;
-
-        if (!get_op_hash_functions(hashop, &left_hashfn, &right_hashfn))
-            ereport(ERROR,
-                (errcode(ERRCODE_UNDEFINED_FUNCTION),
-                    errmodule(MOD_EXECUTOR),
-                    errmsg("could not find hash function for hash operator %u", hashop)));
-        fmgr_info(left_hashfn, &hashtable->outer_hashfunctions[i]);
-        fmgr_info(right_hashfn, &hashtable->inner_hashfunctions[i]);
-        hashtable->hashStrict[i] = op_strict(hashop);
-        i++;
-    }
+    ExecHashTableInitHashFunctions(hashtable, hashOperators);
 
     /*
      * Create temporary memory contexts in which to keep the hashtable working
      * storage.  See notes in executor/hashjoin.h.
      */
-    hashtable->hashCxt = AllocSetContextCreate(CurrentMemoryContext,
+    hashtable->hashCxt = AllocSetContextCreate(parentcxt,
         "HashTableContext",
         ALLOCSET_DEFAULT_MINSIZE,
         ALLOCSET_DEFAULT_INITSIZE,
         ALLOCSET_DEFAULT_MAXSIZE,
-        STANDARD_CONTEXT,
+        cxttype,
         local_work_mem * 1024L);
 
     hashtable->batchCxt = AllocSetContextCreate(hashtable->hashCxt,
@@ -393,7 +461,7 @@ HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNull
         ALLOCSET_DEFAULT_MINSIZE,
         ALLOCSET_DEFAULT_INITSIZE,
         ALLOCSET_DEFAULT_MAXSIZE,
-        STANDARD_CONTEXT,
+        cxttype,
         local_work_mem * 1024L);
 
     /* Allocate data that will live for the life of the hashjoin */
@@ -900,6 +968,65 @@ void ExecChooseSonicHashTableSize(Path* inner_path, List* hashclauses, int* inne
     MEMCTL_LOG(DEBUG2, "[ExecChooseSonicHashTableSize] nbuckets: %ld, nbatch: %d", nbuckets, nbatch);
 }
 
+/* ----------------------------------------------------------------
+ *		ExecHashTableAttach
+ *
+ *		create a private control block for a hash table shared by the
+ *		SMP threads of a stream group.  The buckets and tuples are used
+ *		in place, read-only; only the per-thread scan state and the
+ *		hash function lookup data are our own.
+ * ----------------------------------------------------------------
+ */
+HashJoinTable ExecHashTableAttach(HashJoinSharedController* controller, List* hashOperators)
+{
+    HashJoinTable hashtable;
+    errno_t rc;
+
+    Assert(controller->hashtable != NULL);
+
+    hashtable = (HashJoinTable)palloc(sizeof(HashJoinTableData));
+    rc = memcpy_s(hashtable, sizeof(HashJoinTableData), controller->hashtable, sizeof(HashJoinTableData));
+    securec_check(rc, "\0", "\0");
+
+    /* the builder's lookup data lives in its own executor memory */
+    ExecHashTableInitHashFunctions(hashtable, hashOperators);
+    hashtable->curbatch = 0;
+    hashtable->spill_size = NULL;
+    hashtable->sharedController = controller;
+
+    return hashtable;
+}
+
+/*
+ * Drop our reference to a shared hash table.  The last thread to detach
+ * releases the working storage.
+ */
+static void ExecHashTableDetach(HashJoinTable hashtable)
+{
+    HashJoinSharedController* controller = hashtable->sharedController;
+    MemoryContext hashCxt = NULL;
+    HashJoinTable snapshot = NULL;
+    StreamNodeGroup* group = u_sess->stream_cxt.global_obj;
+
+    Assert(group != NULL);
+
+    AutoMutexLock streamLock(group->GetRecursiveMutex());
+    streamLock.lock();
+    Assert(controller->refcount > 0);
+    if (--controller->refcount == 0) {
+        snapshot = controller->hashtable;
+        hashCxt = snapshot->hashCxt;
+        controller->hashtable = NULL;
+        controller->status = HJ_SHARED_RELEASED;
+    }
+    streamLock.unLock();
+
+    if (hashCxt != NULL) {
+        MemoryContextDelete(hashCxt);
+        pfree_ext(snapshot);
+    }
+}
+
 /* ----------------------------------------------------------------
  *		ExecHashTableDestroy
  *
@@ -928,7 +1055,10 @@ void ExecHashTableDestroy(HashJoinTable hashtable)
     pfree_ext(hashtable->hashStrict);
 
     /* Release working memory (batchCxt is a child, so it goes away too) */
-    MemoryContextDelete(hashtable->hashCxt);
+    if (hashtable->sharedController != NULL)
+        ExecHashTableDetach(hashtable);
+    else
+        MemoryContextDelete(hashtable->hashCxt);
 
     /* And drop the control block */
     pfree_ext(hashtable);
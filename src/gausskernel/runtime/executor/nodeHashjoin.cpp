@@ -16,12 +16,15 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "distributelayer/streamCore.h"
 #include "executor/executor.h"
 #include "executor/exec/execStream.h"
 #include "executor/hashjoin.h"
 #include "executor/node/nodeHash.h"
 #include "executor/node/nodeHashjoin.h"
+#include "executor/node/nodeRecursiveunion.h"
 #include "miscadmin.h"
+#include "optimizer/streamplan.h"
 #include "utils/anls_opt.h"
 #include "utils/memutils.h"
 
@@ -44,6 +47,8 @@ static TupleTableSlot* ExecHashJoinOuterGetTuple(PlanState* outerNode, HashJoinS
 static TupleTableSlot* ExecHashJoinGetSavedTuple(
     HashJoinState* hjstate, BufFile* file, uint32* hashvalue, TupleTableSlot* tupleSlot);
 static bool ExecHashJoinNewBatch(HashJoinState* hjstate);
+static bool ExecHashJoinCanShareHashtable(HashJoinState* hjstate);
+static HashJoinTable ExecHashJoinBuildSharedHashtable(HashJoinState* node, HashState* hashNode, bool* incomplete);
 
 /* ----------------------------------------------------------------
  *		ExecHashJoin
@@ -113,6 +118,24 @@ TupleTableSlot* ExecHashJoin(HashJoinState* node)
                  * First time through: build hash table for inner relation.
                  */
                 Assert(hashtable == NULL);
+
+                /*
+                 * Shared hash table: the other SMP threads may be waiting for
+                 * us to build it, so we never skip the build here.
+                 */
+                if (node->hj_sharedHashtable) {
+                    bool incomplete = false;
+
+                    node->hj_FirstOuterTupleSlot = NULL;
+                    hashtable = ExecHashJoinBuildSharedHashtable(node, hashNode, &incomplete);
+                    if (incomplete)
+                        return NULL;
+                    if (hashtable == NULL) {
+                        /* the shared table was already released, build our own */
+                        node->hj_sharedHashtable = false;
+                    }
+                }
+
                 /*
                  * If the outer relation is completely empty, and it's not
                  * right/full join, we can quit without building the hash
@@ -137,7 +160,9 @@ TupleTableSlot* ExecHashJoin(HashJoinState* node)
                  * it away for later consumption by ExecHashJoinOuterGetTuple.
                  */
                 // remove node->hj_streamBothSides after stream hang problem sloved.
-                if (HJ_FILL_INNER(node)) {
+                if (hashtable != NULL) {
+                    /* shared hash table is already attached */
+                } else if (HJ_FILL_INNER(node)) {
                     /* no chance to not build the hash table */
                     node->hj_FirstOuterTupleSlot = NULL;
                 } else if ((HJ_FILL_OUTER(node) || (outerNode->plan->startup_cost < hashNode->ps.plan->total_cost &&
@@ -167,23 +192,25 @@ TupleTableSlot* ExecHashJoin(HashJoinState* node)
                 } else
                     node->hj_FirstOuterTupleSlot = NULL;
 
-                /*
-                 * create the hash table, sometimes we should keep nulls
-                 */
-                oldcxt = MemoryContextSwitchTo(hashNode->ps.nodeContext);
-                hashtable = ExecHashTableCreate((Hash*)hashNode->ps.plan, node->hj_HashOperators,
-                    HJ_FILL_INNER(node) || node->js.nulleqqual != NIL);
-                MemoryContextSwitchTo(oldcxt);
-                node->hj_HashTable = hashtable;
+                if (hashtable == NULL) {
+                    /*
+                     * create the hash table, sometimes we should keep nulls
+                     */
+                    oldcxt = MemoryContextSwitchTo(hashNode->ps.nodeContext);
+                    hashtable = ExecHashTableCreate((Hash*)hashNode->ps.plan, node->hj_HashOperators,
+                        HJ_FILL_INNER(node) || node->js.nulleqqual != NIL);
+                    MemoryContextSwitchTo(oldcxt);
+                    node->hj_HashTable = hashtable;
 
-                /*
-                 * execute the Hash node, to build the hash table
-                 */
-                WaitState oldStatus = pgstat_report_waitstatus(STATE_EXEC_HASHJOIN_BUILD_HASH);
-                hashNode->hashtable = hashtable;
-                hashNode->ps.hbktScanSlot.currSlot = node->js.ps.hbktScanSlot.currSlot;
-                (void)MultiExecProcNode((PlanState*)hashNode);
-                (void)pgstat_report_waitstatus(oldStatus);
+                    /*
+                     * execute the Hash node, to build the hash table
+                     */
+                    WaitState oldStatus = pgstat_report_waitstatus(STATE_EXEC_HASHJOIN_BUILD_HASH);
+                    hashNode->hashtable = hashtable;
+                    hashNode->ps.hbktScanSlot.currSlot = node->js.ps.hbktScanSlot.currSlot;
+                    (void)MultiExecProcNode((PlanState*)hashNode);
+                    (void)pgstat_report_waitstatus(oldStatus);
+                }
 
                 /* Early free right tree after hash table built */
                 ExecEarlyFree((PlanState*)hashNode);
@@ -332,7 +359,9 @@ TupleTableSlot* ExecHashJoin(HashJoinState* node)
                         if (jointype == JOIN_RIGHT_ANTI || jointype == JOIN_RIGHT_ANTI_FULL)
                             continue;
                     } else {
-                        HeapTupleHeaderSetMatch(HJTUPLE_MINTUPLE(node->hj_CurTuple));
+                        /* tuples of a shared table are read-only, and nobody needs their match flags */
+                        if (hashtable->sharedController == NULL)
+                            HeapTupleHeaderSetMatch(HJTUPLE_MINTUPLE(node->hj_CurTuple));
 
                         /* Anti join: we never return a matched tuple */
                         if (jointype == JOIN_ANTI || jointype == JOIN_LEFT_ANTI_FULL) {
@@ -658,10 +687,240 @@ HashJoinState* ExecInitHashJoin(HashJoin* node, EState* estate, int eflags)
     hjstate->hj_JoinState = HJ_BUILD_HASHTABLE;
     hjstate->hj_MatchedOuter = false;
     hjstate->hj_OuterNotEmpty = false;
+    hjstate->hj_sharedHashtable = ExecHashJoinCanShareHashtable(hjstate);
 
     return hjstate;
 }
 
+/*
+ * ExecHashJoinCanShareHashtable
+ *	  With a local broadcast below the Hash node, every SMP thread of the
+ *	  stream group receives the whole inner relation and would build an
+ *	  identical hash table.  Decide whether the threads can build it once and
+ *	  share it instead.  The table must be read-only once built, so joins that
+ *	  mark or delete inner tuples are out, and it must fit in memory in a
+ *	  single batch since the other threads throw their copy of the inner rows
+ *	  away.  Every thread makes the same decision from the same plan.
+ */
+static bool ExecHashJoinCanShareHashtable(HashJoinState* hjstate)
+{
+    HashJoin* node = (HashJoin*)hjstate->js.ps.plan;
+    Hash* hashNode = (Hash*)innerPlan(node);
+    Plan* inner = outerPlan(hashNode);
+
+    if (!u_sess->attr.attr_sql.enable_parallel_hash)
+        return false;
+
+    if (!StreamThreadAmI() || u_sess->stream_cxt.global_obj == NULL || SET_DOP(node->join.plan.dop) <= 1)
+        return false;
+
+    if (node->join.plan.ispwj || EXEC_IN_RECURSIVE_MODE(node) || hjstate->hj_rebuildHashtable)
+        return false;
+
+    switch (hjstate->js.jointype) {
+        case JOIN_INNER:
+        case JOIN_LEFT:
+        case JOIN_SEMI:
+        case JOIN_ANTI:
+            break;
+        default:
+            return false;
+    }
+
+    if (inner == NULL || !IsA(inner, Stream) || ((Stream*)inner)->smpDesc.distriType != LOCAL_BROADCAST)
+        return false;
+
+    return ExecHashTableCanShare(hashNode);
+}
+
+/*
+ * Find the controller of a shared hash table in the stream node group,
+ * registering it if we are the first thread to get here.
+ */
+static HashJoinSharedController* ExecHashJoinGetSharedController(HashJoinState* node)
+{
+    StreamNodeGroup* group = u_sess->stream_cxt.global_obj;
+    int plannodeid = node->js.ps.plan->plan_node_id;
+    HashJoinSharedController* result = NULL;
+    ListCell* lc = NULL;
+
+    AutoMutexLock streamLock(group->GetRecursiveMutex());
+    streamLock.lock();
+    foreach (lc, group->m_syncControllers) {
+        SyncController* controller = (SyncController*)lfirst(lc);
+
+        if (controller->controller_type == T_HashJoin && controller->controller_plannodeid == plannodeid) {
+            result = (HashJoinSharedController*)controller;
+            break;
+        }
+    }
+
+    if (result == NULL) {
+        /* SyncController is allocated in StreamRunTime Memory Context */
+        MemoryContext oldcxt = MemoryContextSwitchTo(group->m_streamRuntimeContext);
+
+        result = (HashJoinSharedController*)palloc0(sizeof(HashJoinSharedController));
+        result->controller.controller_type = T_HashJoin;
+        result->controller.controller_plannodeid = plannodeid;
+        result->controller.controlnode_xcnodeid = u_sess->pgxc_cxt.PGXCNodeId;
+        result->controller.controller_planstate = NULL;
+        result->controller.executor_stop = false;
+        result->status = HJ_SHARED_INIT;
+        result->refcount = 0;
+        result->hashtable = NULL;
+        pthread_cond_init(&result->cond, NULL);
+        group->m_syncControllers = lappend(group->m_syncControllers, result);
+
+        (void)MemoryContextSwitchTo(oldcxt);
+    }
+    streamLock.unLock();
+
+    return result;
+}
+
+/*
+ * ExecHashJoinBuildSharedHashtable
+ *	  Build or attach to the hash table shared by the SMP threads.
+ *
+ *	  The first thread to get here builds the table from its copy of the
+ *	  broadcast inner relation.  Threads that arrive during the build take a
+ *	  reference, drain and discard their own copy so that the local broadcast
+ *	  producer never blocks on them, and then wait for the builder.  Threads
+ *	  that arrive after the build attach right away.
+ *
+ *	  Returns NULL if the table has already been released by every thread that
+ *	  used it; our inner input is untouched then and the caller builds a
+ *	  private table.  *incomplete is set if the builder stopped early.
+ */
+static HashJoinTable ExecHashJoinBuildSharedHashtable(HashJoinState* node, HashState* hashNode, bool* incomplete)
+{
+    StreamNodeGroup* group = u_sess->stream_cxt.global_obj;
+    HashJoinSharedController* controller = ExecHashJoinGetSharedController(node);
+    HashJoinTable hashtable = NULL;
+    MemoryContext oldcxt;
+    int status;
+
+    AutoMutexLock streamLock(group->GetRecursiveMutex());
+    streamLock.lock();
+    status = controller->status;
+    if (status == HJ_SHARED_INIT)
+        controller->status = HJ_SHARED_BUILDING;
+    if (status != HJ_SHARED_RELEASED && status != HJ_SHARED_FAILED)
+        controller->refcount++;
+    streamLock.unLock();
+
+    if (status == HJ_SHARED_RELEASED)
+        return NULL;
+
+    if (status == HJ_SHARED_FAILED) {
+        *incomplete = true;
+        return NULL;
+    }
+
+    if (status == HJ_SHARED_INIT) {
+        HashJoinTable snapshot = NULL;
+        errno_t rc;
+
+        oldcxt = MemoryContextSwitchTo(hashNode->ps.nodeContext);
+        hashtable = ExecHashTableCreate((Hash*)hashNode->ps.plan, node->hj_HashOperators,
+            node->js.nulleqqual != NIL, true);
+        MemoryContextSwitchTo(oldcxt);
+        node->hj_HashTable = hashtable;
+
+        WaitState oldStatus = pgstat_report_waitstatus(STATE_EXEC_HASHJOIN_BUILD_HASH);
+        hashNode->hashtable = hashtable;
+        hashNode->ps.hbktScanSlot.currSlot = node->js.ps.hbktScanSlot.currSlot;
+        (void)MultiExecProcNode((PlanState*)hashNode);
+        (void)pgstat_report_waitstatus(oldStatus);
+
+        /* publish a copy of the control block that outlives our executor state */
+        oldcxt = MemoryContextSwitchTo(group->m_streamRuntimeContext);
+        snapshot = (HashJoinTable)palloc(sizeof(HashJoinTableData));
+        MemoryContextSwitchTo(oldcxt);
+        rc = memcpy_s(snapshot, sizeof(HashJoinTableData), hashtable, sizeof(HashJoinTableData));
+        securec_check(rc, "\0", "\0");
+
+        streamLock.lock();
+        controller->hashtable = snapshot;
+        controller->status = u_sess->exec_cxt.executorStopFlag ? HJ_SHARED_FAILED : HJ_SHARED_DONE;
+        hashtable->sharedController = controller;
+        status = controller->status;
+        pthread_cond_broadcast(&controller->cond);
+        streamLock.unLock();
+    } else {
+        if (status == HJ_SHARED_BUILDING) {
+            PlanState* innerNode = outerPlanState(hashNode);
+            TupleTableSlot* slot = NULL;
+            bool stop = false;
+
+            WaitState oldStatus = pgstat_report_waitstatus(STATE_EXEC_HASHJOIN_BUILD_HASH);
+            for (;;) {
+                slot = ExecProcNode(innerNode);
+                if (TupIsNull(slot))
+                    break;
+            }
+
+            /*
+             * Sleep until the builder publishes the table, or the stream group
+             * is stopped because some thread failed.  Both broadcast the
+             * condition; the timeout is only there to serve cancel requests.
+             */
+            for (;;) {
+                struct timespec ts;
+
+                CHECK_FOR_INTERRUPTS();
+
+                streamLock.lock();
+                status = controller->status;
+                stop = controller->controller.executor_stop;
+                if (status == HJ_SHARED_BUILDING && !stop) {
+                    (void)clock_gettime(CLOCK_REALTIME, &ts);
+                    ts.tv_sec += 1;
+                    (void)pthread_cond_timedwait(&controller->cond, group->GetRecursiveMutex(), &ts);
+                    status = controller->status;
+                    stop = controller->controller.executor_stop;
+                }
+                streamLock.unLock();
+
+                if (status != HJ_SHARED_BUILDING)
+                    break;
+
+                /* the builder failed, the whole query is going down */
+                if (stop)
+                    ereport(ERROR, (errcode(ERRCODE_RU_STOP_QUERY), errmsg("error happened during execute query")));
+            }
+            (void)pgstat_report_waitstatus(oldStatus);
+        }
+
+        /* our reference keeps the table alive until we detach */
+        streamLock.lock();
+        Assert(controller->status == HJ_SHARED_DONE || controller->status == HJ_SHARED_FAILED);
+        status = controller->status;
+        oldcxt = MemoryContextSwitchTo(hashNode->ps.nodeContext);
+        hashtable = ExecHashTableAttach(controller, node->hj_HashOperators);
+        MemoryContextSwitchTo(oldcxt);
+        streamLock.unLock();
+
+        hashtable->spill_size = &hashNode->spill_size;
+        node->hj_HashTable = hashtable;
+        hashNode->hashtable = hashtable;
+    }
+
+    if (status == HJ_SHARED_FAILED) {
+        /*
+         * The builder was told to stop early, which only happens when nobody
+         * needs the output of the stream group any more.  Drop our reference.
+         */
+        ExecHashTableDestroy(hashtable);
+        node->hj_HashTable = NULL;
+        hashNode->hashtable = NULL;
+        *incomplete = true;
+        return NULL;
+    }
+
+    return hashtable;
+}
+
 /* ----------------------------------------------------------------
  *		ExecEndHashJoin
  *
@@ -1049,6 +1308,9 @@ void ExecReScanHashJoin(HashJoinState* node)
             node->hj_HashTable = NULL;
             node->hj_JoinState = HJ_BUILD_HASHTABLE;
 
+            /* the other threads do not rescan with us, so build a private table from now on */
+            node->hj_sharedHashtable = false;
+
             /*
              * if chgParam of subnode is not null then plan will be re-scanned
              * by first ExecProcNode.
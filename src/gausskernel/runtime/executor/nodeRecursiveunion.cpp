@@ -826,6 +826,10 @@ void ExecSyncControllerDelete(SyncController* controller)
 
         pfree_ext(ru_controller->none_recursive_tuples);
         pfree_ext(ru_controller->recursive_tuples);
+    } else if (T_HashJoin == controller_type) {
+        HashJoinSharedController* hj_controller = (HashJoinSharedController*)controller;
+
+        pthread_cond_destroy(&hj_controller->cond);
     }
 
     /* The caller will free the controller pointer itself */
@@ -978,7 +978,7 @@ SeqScanState* ExecInitSeqScan(SeqScan* node, EState* estate, int eflags)
 
     InitScanRelation(scanstate, estate, eflags);
 
-    ADIO_RUN()
+    ASYNC_PREFETCH_RUN()
     {
         /* add prefetch related information */
         scanstate->ss_scanaccessor = (SeqScanAccessor*)palloc(sizeof(SeqScanAccessor));
@@ -1181,12 +1181,8 @@ void ExecEndSeqScan(SeqScanState* node)
         }
     }
 
-    ADIO_RUN()
-    {
-        /* add prefetch related information */
-        pfree_ext(node->ss_scanaccessor);
-    }
-    ADIO_END();
+    /* add prefetch related information */
+    pfree_ext(node->ss_scanaccessor);
 
     /*
      * close the heap relation.
@@ -1318,22 +1314,18 @@ static void ExecInitNextPartitionForSeqScan(SeqScanState* node)
 
         /* update partition scan-related fileds in SeqScanState  */
         node->ss_currentScanDesc = InitBeginScan(node, currentSubPartitionRel);
-        ADIO_RUN()
-        {
+        if (node->ss_scanaccessor != NULL) {
             SeqScan_Init(node->ss_currentScanDesc, node->ss_scanaccessor, currentSubPartitionRel);
         }
-        ADIO_END();
     } else {
         node->ss_currentPartition = currentpartitionrel;
         /* add qual for redis */
 
         /* update partition scan-related fileds in SeqScanState  */
         node->ss_currentScanDesc = InitBeginScan(node, currentpartitionrel);
-        ADIO_RUN()
-        {
+        if (node->ss_scanaccessor != NULL) {
             SeqScan_Init(node->ss_currentScanDesc, node->ss_scanaccessor, currentpartitionrel);
         }
-        ADIO_END();
     }
 
     if (node->scanBatchMode) {
@@ -36,6 +36,7 @@
 #include "storage/cstore/cstore_compress.h"
 #include "access/cstore_am.h"
 #include "optimizer/clauses.h"
+#include "optimizer/var.h"
 #include "nodes/params.h"
 #include "utils/lsyscache.h"
 #include "utils/datum.h"
@@ -175,6 +176,104 @@ void OptimizeProjectionAndFilter(CStoreScanState* node)
     node->m_fSimpleMap = simple_map;
 }
 
+/*
+ * Split the scan qual into an early qual and a late qual. The early qual is the first
+ * conjunct, which is the cheapest one after the planner ordered them, plus all the
+ * conjuncts reading no other columns. The columns only read by the late qual are
+ * decompressed after the early qual, for the rows passing it.
+ */
+static void InitCStoreLateQual(CStoreScanState* node)
+{
+    ProjectionInfo* proj = node->ps.ps_ProjInfo;
+    List* early_qual = NIL;
+    List* late_qual = NIL;
+    Bitmapset* early_attrs = NULL;
+    Bitmapset* late_attrs = NULL;
+    ListCell* lc = NULL;
+
+    if (list_length(node->ps.qual) < 2 || node->isSampleScan || u_sess->attr.attr_sql.enable_cluster_resize ||
+        contain_volatile_functions((Node*)node->ps.plan->qual)) {
+        return;
+    }
+
+    foreach (lc, node->ps.qual) {
+        ExprState* clause = (ExprState*)lfirst(lc);
+        List* vars = pull_var_clause((Node*)clause->expr, PVC_RECURSE_AGGREGATES, PVC_RECURSE_PLACEHOLDERS);
+        Bitmapset* attrs = NULL;
+        bool whole_row = false;
+        ListCell* vl = NULL;
+
+        foreach (vl, vars) {
+            Var* var = (Var*)lfirst(vl);
+            if (var->varattno == 0) {
+                whole_row = true;
+            } else if (var->varattno > 0) {
+                attrs = bms_add_member(attrs, var->varattno);
+            }
+        }
+        list_free_ext(vars);
+
+        if (early_qual == NIL || whole_row || bms_is_subset(attrs, early_attrs)) {
+            early_qual = lappend(early_qual, clause);
+            early_attrs = bms_add_members(early_attrs, attrs);
+        } else {
+            late_qual = lappend(late_qual, clause);
+            late_attrs = bms_add_members(late_attrs, attrs);
+        }
+        bms_free_ext(attrs);
+    }
+
+    if (late_qual == NIL) {
+        list_free_ext(early_qual);
+        bms_free_ext(early_attrs);
+        return;
+    }
+
+    node->ps.qual = early_qual;
+    node->m_lateQual = late_qual;
+
+    late_attrs = bms_del_members(late_attrs, early_attrs);
+    int attno = -1;
+    while ((attno = bms_next_member(late_attrs, attno)) >= 0) {
+        node->m_lateQualVars = lappend_int(node->m_lateQualVars, attno);
+    }
+
+    /* The columns filled before the late qual, which have to be moved by the first pack */
+    List* early_vars = list_difference_int(proj->pi_acessedVarNumbers, proj->pi_lateAceessVarNumbers);
+    node->m_earlyPackVars = list_difference_int(early_vars, node->m_lateQualVars);
+    list_free_ext(early_vars);
+
+    bms_free_ext(early_attrs);
+    bms_free_ext(late_attrs);
+}
+
+/*
+ * Pack the rows passing the early qual, fill the columns of the late qual for them
+ * and evaluate the late qual. Return false if no row passes.
+ */
+static bool ApplyLateQual(CStoreScanState* node, VectorBatch* p_scan_batch)
+{
+    ExprContext* econtext = node->ps.ps_ExprContext;
+    int late_read_ctid = node->m_CStore->GetLateReadCtid();
+
+    if (econtext->ecxt_scanbatch->m_sel) {
+        if (u_sess->attr.attr_sql.enable_codegen && !node->ss_deltaScan && late_read_ctid != -1) {
+            p_scan_batch->OptimizePackForLateRead(econtext->ecxt_scanbatch->m_sel, node->m_earlyPackVars,
+                late_read_ctid);
+        } else {
+            p_scan_batch->Pack(econtext->ecxt_scanbatch->m_sel);
+        }
+    }
+
+    if (!node->ss_deltaScan) {
+        VECCSTORE_SCAN_TRACE_START(node, FILL_LATER_BATCH);
+        node->m_CStore->FillScanBatchLateQualIfNeed(p_scan_batch);
+        VECCSTORE_SCAN_TRACE_END(node, FILL_LATER_BATCH);
+    }
+
+    return ExecVecQual(node->m_lateQual, econtext, false) != NULL;
+}
+
 VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan_batch, ExprDoneCond* done)
 {
     List* qual = NIL;
@@ -218,6 +317,14 @@ VectorBatch* ApplyProjectionAndFilter(CStoreScanState* node, VectorBatch* p_scan
                 goto done;
             }
 
+            // The columns of late qual are decompressed only for the rows passing the early qual,
+            // the other late read columns only for the rows passing both.
+            //
+            if (node->m_lateQual != NIL && !ApplyLateQual(node, p_scan_batch)) {
+                p_out_batch->m_rows = 0;
+                goto done;
+            }
+
             /*
              * Call optimized PackT function when codegen is turned on.
              */
@@ -612,6 +719,7 @@ CStoreScanState* ExecInitCStoreScan(
     PlanState* plan_stat = NULL;
     ScalarDesc unknown_desc;
     TableSampleClause* tsc = NULL;
+    bool qual_jitted = false;
 
     // Column store can only be a leaf node
     //
@@ -703,8 +811,10 @@ CStoreScanState* ExecInitCStoreScan(
             CodeGenPassThreshold(((Plan*)node)->plan_rows, estate->es_plannedstmt->num_nodes, ((Plan*)node)->dop);
         if (consider_codegen) {
             jitted_vecqual = dorado::VecExprCodeGen::QualCodeGen(scan_stat->ps.qual, (PlanState*)scan_stat);
-            if (jitted_vecqual != NULL)
+            if (jitted_vecqual != NULL) {
                 llvm_code_gen->addFunctionToMCJit(jitted_vecqual, reinterpret_cast<void**>(&(scan_stat->jitted_vecqual)));
+                qual_jitted = true;
+            }
         }
     }
 #endif
@@ -798,6 +908,11 @@ CStoreScanState* ExecInitCStoreScan(
         &scan_stat->m_pScanRunTimeKeys,
         &scan_stat->m_ScanRunTimeKeysNum);
 
+    /* The jitted qual evaluates all the conjuncts at once, so keep it as a whole */
+    if (!qual_jitted) {
+        InitCStoreLateQual(scan_stat);
+    }
+
     scan_stat->m_CStore = New(CurrentMemoryContext) CStore();
     scan_stat->m_CStore->InitScan(scan_stat, GetActiveSnapshot());
     OptimizeProjectionAndFilter(scan_stat);
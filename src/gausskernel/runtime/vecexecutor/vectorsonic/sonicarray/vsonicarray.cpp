@@ -436,6 +436,30 @@ void SonicDatumArray::getArrayAtomIdx(int nrows, uint32* locs, ArrayIdx* array_i
     }
 }
 
+/*
+ * @Description: Prefetch the elements at the given positions, so that
+ * 	a later gather over the same positions finds them in cache.
+ * @in nrows - the number of positions.
+ * @in locs - the element positions in the array.
+ */
+void SonicDatumArray::prefetchArray(int nrows, uint32* locs)
+{
+    Assert(nrows <= BatchMaxSize);
+    int mask = m_atomSize - 1;
+    atom* cur_atom = NULL;
+    int atom_idx;
+
+    for (int i = 0; i < nrows; i++) {
+        cur_atom = m_arr[getArrayIndx(*locs, m_nbit)];
+        atom_idx = getArrayLoc(*locs, mask);
+        __builtin_prefetch(cur_atom->data + atom_idx * m_atomTypeSize);
+        if (m_nullFlag) {
+            __builtin_prefetch(cur_atom->nullFlag + atom_idx);
+        }
+        locs++;
+    }
+}
+
 /*
  * @Description:  update data in atom. Notice that if *val* is a temporary variable,
  * free of it after the call of replaceVariable.
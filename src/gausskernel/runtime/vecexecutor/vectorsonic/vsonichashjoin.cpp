@@ -76,6 +76,7 @@ SonicHashJoin::SonicHashJoin(int size, VecHashJoinState* node)
       m_complicatekey(false),
       m_runtime(node),
       m_outRawBatch(NULL),
+      m_prefetchProbe(false),
       m_matchLocIndx(0),
       m_probeIdx(0),
       m_arrayExpandSize(0),
@@ -966,6 +967,8 @@ void SonicHashJoin::initHashTable(uint8 byteSize, uint32 curPartIdx)
     SonicHashMemPartition* mem_partition = NULL;
     mem_partition = (SonicHashMemPartition*)m_innerPartitions[curPartIdx];
 
+    m_prefetchProbe = false;
+
     /* This partition hasn't any data. So return directly. */
     if (mem_partition == NULL)
         return;
@@ -992,6 +995,10 @@ void SonicHashJoin::initHashTable(uint8 byteSize, uint32 curPartIdx)
     /* Check whether size of one palloc larger than the limit. */
     bool useSegHashTable = (sz_hash * byteSize >= (int64)MaxAllocSize);
 
+    /* Only prefetch once the bucket array outgrows the cache. */
+    m_prefetchProbe =
+        !useSegHashTable && ((int64)mem_partition->m_hashSize * byteSize >= SONIC_PREFETCH_MIN_HASH_SIZE);
+
     if (!useSegHashTable) {
         mem_partition->m_bucket = (char*)palloc0(byteSize * mem_partition->m_hashSize);
         /* One more cell is need for the zero in next array. */
@@ -1098,6 +1105,9 @@ void SonicHashJoin::buildHashTable(uint32 curPartIdx)
             loc_id = GETLOCID(*hash_val, mask);
 
             if (!isSegHashTable) {
+                if (m_prefetchProbe && j + SONIC_BUILD_PREFETCH_DISTANCE < arrSize) {
+                    __builtin_prefetch(&hashBucket[GETLOCID(hash_val[SONIC_BUILD_PREFETCH_DISTANCE], mask)], 1);
+                }
                 hashNext[tup_idx] = hashBucket[loc_id];
                 hashBucket[loc_id] = tup_idx;
             } else {
@@ -1113,6 +1123,55 @@ void SonicHashJoin::buildHashTable(uint32 curPartIdx)
     }
 }
 
+/*
+ * @Description: Compute the bucket index of each probe row into m_bucketLoc
+ * 	and prefetch the bucket, before any of them is read.
+ * @in hashBucket - bucket array of the current hash table.
+ * @in mask - bucket mask of the current hash table.
+ * @in nrows - number of hash values in m_hashVal.
+ */
+template <typename BucketType>
+inline void SonicHashJoin::prefetchBuckets(BucketType* hashBucket, uint32 mask, int nrows)
+{
+    uint32* hash_val = m_hashVal;
+    uint32* bucket_loc = m_bucketLoc;
+
+    for (int i = 0; i < nrows; i++) {
+        *bucket_loc = GETLOCID(*hash_val, mask);
+        __builtin_prefetch(&hashBucket[*bucket_loc]);
+        bucket_loc++;
+        hash_val++;
+    }
+}
+
+/*
+ * @Description: Prefetch the conflict array entries and the join keys of the
+ * 	inner tuples in m_loc, which innerJoin() reads next to match keys and to
+ * 	walk the conflict chains.
+ * @in memPartition - partition holding the current hash table.
+ */
+template <typename BucketType, bool complicateJoinKey>
+inline void SonicHashJoin::prefetchConflicts(SonicHashMemPartition* memPartition)
+{
+    BucketType* hash_next = (BucketType*)memPartition->m_next;
+    int i;
+
+    for (i = 0; i < m_selectRows; i++) {
+        __builtin_prefetch(&hash_next[m_loc[i]]);
+    }
+
+    /* A complicate join key is evaluated over every inner column. */
+    if (complicateJoinKey) {
+        for (i = 0; i < m_buildOp.cols; i++) {
+            memPartition->m_data[i]->prefetchArray(m_selectRows, m_loc);
+        }
+    } else {
+        for (i = 0; i < m_buildOp.keyNum; i++) {
+            memPartition->m_data[m_buildOp.keyIndx[i]]->prefetchArray(m_selectRows, m_loc);
+        }
+    }
+}
+
 /*
  * @Description: Probe side main function.
  * 	Call probeMemory or probeGrace by m_strategy.
@@ -1175,6 +1234,10 @@ inline VectorBatch* SonicHashJoin::probeMemoryTable(SonicHashSource* probeP)
                         m_outRawBatch, (void*)m_probeOp.hashFunc, m_probeOp.hashFmgr, m_probeOp.keyIndx, m_hashVal);
                 }
 
+                if (!isSegHashTable && m_prefetchProbe) {
+                    prefetchBuckets<BucketType>(hashBucket, mask, nrows);
+                }
+
                 m_selectRows = 0;
                 loc3 = m_hashVal;
                 loc1 = m_selectIndx;
@@ -1186,6 +1249,8 @@ inline VectorBatch* SonicHashJoin::probeMemoryTable(SonicHashSource* probeP)
                 for (int i = 0; i < nrows; i++, loc3++) {
                     if (isSegHashTable) {
                         loc_id = (BucketType)mem_partition->m_segBucket->getNthDatum(GETLOCID(*loc3, mask));
+                    } else if (m_prefetchProbe) {
+                        loc_id = hashBucket[m_bucketLoc[i]];
                     } else {
                         loc_id = hashBucket[GETLOCID(*loc3, mask)];
                     }
@@ -1487,6 +1552,10 @@ inline VectorBatch* SonicHashJoin::innerJoin(VectorBatch* batch)
     BucketType* hashNext = (BucketType*)mem_partition->m_next;
 
     while (m_selectRows) {
+        if (!isSegHashTable && m_prefetchProbe) {
+            prefetchConflicts<BucketType, complicateJoinKey>(mem_partition);
+        }
+
         /* match inner and outer keys. */
         if (complicateJoinKey) {
             matchComplicateKey<false>(batch, mem_partition);
@@ -1687,6 +1756,11 @@ inline VectorBatch* SonicHashJoin::probePartition(SonicHashSource* probeP)
                         m_outRawBatch, (void*)m_probeOp.hashFunc, m_probeOp.hashFmgr, m_probeOp.keyIndx, m_hashVal);
                 }
 
+                bool prefetched = !isSegHashTable && m_prefetchProbe && hash_bucket != NULL;
+                if (prefetched) {
+                    prefetchBuckets<BucketType>(hash_bucket, mask, nrows);
+                }
+
                 m_selectRows = 0;
                 loc3 = m_hashVal;
                 loc1 = m_selectIndx;
@@ -1723,6 +1797,8 @@ inline VectorBatch* SonicHashJoin::probePartition(SonicHashSource* probeP)
 
                     if (isSegHashTable) {
                         loc_id = (BucketType)seg_bucket->getNthDatum(GETLOCID(*loc3, mask));
+                    } else if (prefetched) {
+                        loc_id = hash_bucket[m_bucketLoc[i]];
                     } else {
                         loc_id = hash_bucket[GETLOCID(*loc3, mask)];
                     }
@@ -3005,6 +3081,7 @@ void SonicHashJoin::ResetNecessary()
     errno_t rc = memset_s(m_memPartFlag, sizeof(m_memPartFlag), 0, SONIC_PART_MAX_NUM * sizeof(m_memPartFlag[0]));
     securec_check(rc, "\0", "\0");
     m_diskPartNum = 0;
+    m_prefetchProbe = false;
 
     /*
      * If chgParam of subnode is not null then plan will be re-scanned
@@ -111,6 +111,7 @@ static relopt_bool boolRelOpts[] = {
     {{ "primarynode", "Enables primarynode for replicatition relation", RELOPT_KIND_HEAP }, false },
     {{ "on_commit_delete_rows", "global temp table on commit options", RELOPT_KIND_HEAP}, true},
     {{ "crossbucket", "Enables cross bucket index creation in this index relation", RELOPT_KIND_BTREE}, false },
+    {{ "deduplicate_items", "Enables merging of duplicate keys into posting lists", RELOPT_KIND_BTREE}, false },
     {{ "enable_tde", "enable table's level transparent data encryption", RELOPT_KIND_HEAP }, false },
     {{ "hasuids", "Enables uids in this relation", RELOPT_KIND_HEAP }, false },
     {{ "compress_byte_convert", "Whether do byte convert in compression", RELOPT_KIND_HEAP | RELOPT_KIND_BTREE},
@@ -1957,6 +1958,7 @@ bytea *default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
         { "bucketcnt", RELOPT_TYPE_INT, offsetof(StdRdOptions, bucketcnt)},
         { "parallel_workers", RELOPT_TYPE_INT, offsetof(StdRdOptions, parallel_workers)},
         { "crossbucket", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, crossbucket)},
+        { "deduplicate_items", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, deduplicate_items)},
         { "wait_clean_cbi", RELOPT_TYPE_STRING, offsetof(StdRdOptions, wait_clean_cbi)},
         { "dek_cipher", RELOPT_TYPE_STRING, offsetof(StdRdOptions, dek_cipher)},
         { "cmk_id", RELOPT_TYPE_STRING, offsetof(StdRdOptions, cmk_id)},
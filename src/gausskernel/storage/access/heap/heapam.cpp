@@ -422,7 +422,7 @@ void heapgetpage(TableScanDesc sscan, BlockNumber page)
  */
 void heap_prefetch(HeapScanDesc scan, ScanDirection dir)
 {
-    ADIO_RUN()
+    ASYNC_PREFETCH_RUN()
     {
         /* if tuples in page are all deleted, need prefetch also for performance */
         if (scan->rs_base.rs_ss_accessor != NULL) {
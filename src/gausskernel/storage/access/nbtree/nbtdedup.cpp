@@ -0,0 +1,354 @@
+/* -------------------------------------------------------------------------
+ *
+ * nbtdedup.cpp
+ *	  Deduplicate items in openGauss btrees.
+ *
+ * A leaf page full of equal keys is compacted by merging runs of adjacent
+ * tuples whose key attributes are binary equal into a single posting list
+ * tuple that carries all of their heap TIDs.  This is done lazily, only when
+ * an insertion would otherwise have to split the page, so workloads without
+ * duplicates pay nothing for it.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ * Portions Copyright (c) 1996-2012, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/nbtree/nbtdedup.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+#include "access/heapam.h"
+#include "access/nbtree.h"
+#include "miscadmin.h"
+#include "storage/buf/bufmgr.h"
+#include "utils/rel.h"
+#include "utils/rel_gs.h"
+
+/* Working state of one run of equal keys while a page is being rewritten */
+typedef struct BTDedupState {
+    IndexTuple base;        /* first tuple of the current run, on the original page */
+    Size basesize;          /* size of base's key part, without its posting list */
+    int nitems;             /* number of original tuples merged into the run */
+    int nhtids;             /* number of heap TIDs collected in htids */
+    ItemPointerData* htids; /* heap TIDs of the run */
+    Size maxpostingsize;    /* largest posting list tuple we are willing to form */
+} BTDedupState;
+
+static Size _bt_keysize(IndexTuple itup);
+static bool _bt_keys_equal(IndexTuple a, IndexTuple b);
+static void _bt_dedup_start_run(BTDedupState* state, IndexTuple itup);
+static bool _bt_dedup_save_htids(BTDedupState* state, IndexTuple itup);
+static int _bt_dedup_finish_run(BTDedupState* state, Page newpage, Relation rel);
+static int _bt_itemptr_cmp(const void* a, const void* b);
+
+/*
+ * Can tuples of this index be merged into posting lists?
+ *
+ * Unique indexes gain little and _bt_check_unique() expects one heap TID per
+ * tuple; indexes with INCLUDE columns may hold different non-key values for
+ * equal keys; global partition and crossbucket indexes carry a per-tuple
+ * partition oid or bucket id; and column store indexes use their TIDs as CU
+ * positions.  Keep all of those as they are.
+ */
+bool _bt_dedup_is_possible(Relation rel, Relation heapRel)
+{
+    if (!RelationAmIsBtree(rel) || !RelationDeduplicateItems(rel)) {
+        return false;
+    }
+    if (rel->rd_index->indisunique) {
+        return false;
+    }
+    if (IndexRelationGetNumberOfKeyAttributes(rel) != IndexRelationGetNumberOfAttributes(rel)) {
+        return false;
+    }
+    if (RelationIsGlobalIndex(rel) || RelationIsCrossBucketIndex(rel)) {
+        return false;
+    }
+    if (RelationIsValid(heapRel) && RelationIsCUFormat(heapRel)) {
+        return false;
+    }
+
+    /* binaries a grey upgrade can still roll back to cannot read posting lists */
+    return t_thrd.proc->workingVersionNum >= BTREE_DEDUP_VERSION_NUM;
+}
+
+/*
+ * _bt_dedup_one_page() -- try to make room on a leaf page by merging
+ *		equal keys into posting lists.
+ *
+ * The caller holds a write lock on buf and is about to split the page to fit
+ * an item of newitemsz bytes.  Returns true if the page was rewritten, in
+ * which case the caller must search the page again for its insert location;
+ * the new item may or may not fit now.
+ *
+ * The page is rebuilt in a temporary copy and then installed and WAL-logged
+ * as a full page image.  No heap TID is removed and no tuple moves right, so
+ * concurrent scans that hold only a pin are not disturbed: _bt_killitems()
+ * matches items by heap TID and at worst fails to set a hint.
+ */
+bool _bt_dedup_one_page(Relation rel, Buffer buf, Size newitemsz)
+{
+    Page page = BufferGetPage(buf);
+    BTPageOpaqueInternal opaque = (BTPageOpaqueInternal)PageGetSpecialPointer(page);
+    OffsetNumber minoff = P_FIRSTDATAKEY(opaque);
+    OffsetNumber maxoff = PageGetMaxOffsetNumber(page);
+    OffsetNumber offnum;
+    BTDedupState state;
+    Page newpage;
+    int nmerged = 0;
+
+    Assert(P_ISLEAF(opaque));
+
+    /* Need at least two data items for anything to merge */
+    if (minoff >= maxoff) {
+        return false;
+    }
+
+    state.base = NULL;
+    state.basesize = 0;
+    state.nitems = 0;
+    state.nhtids = 0;
+    state.htids = (ItemPointerData*)palloc(MaxTIDsPerBTreePage * sizeof(ItemPointerData));
+    state.maxpostingsize = Min(BTMaxItemSize(page) / 2, INDEX_SIZE_MASK);
+
+    newpage = PageGetTempPageCopySpecial(page);
+    PageSetLSN(newpage, PageGetLSN(page));
+
+    /* The high key, if any, is copied over unchanged */
+    if (!P_RIGHTMOST(opaque)) {
+        ItemId hitemid = PageGetItemId(page, P_HIKEY);
+        Item hitem = PageGetItem(page, hitemid);
+
+        if (PageAddItem(newpage, hitem, ItemIdGetLength(hitemid), P_HIKEY, false, false) == InvalidOffsetNumber) {
+            ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                            errmsg("failed to copy high key while deduplicating block %u of index \"%s\"",
+                                   BufferGetBlockNumber(buf), RelationGetRelationName(rel))));
+        }
+    }
+
+    for (offnum = minoff; offnum <= maxoff; offnum = OffsetNumberNext(offnum)) {
+        ItemId itemid = PageGetItemId(page, offnum);
+        IndexTuple itup = (IndexTuple)PageGetItem(page, itemid);
+
+        if (ItemIdIsDead(itemid)) {
+            /* Leave LP_DEAD items alone, they are removed by _bt_vacuum_one_page() */
+            OffsetNumber newoff;
+
+            nmerged += _bt_dedup_finish_run(&state, newpage, rel);
+            newoff = PageAddItem(newpage, (Item)itup, ItemIdGetLength(itemid),
+                                 OffsetNumberNext(PageGetMaxOffsetNumber(newpage)), false, false);
+            if (newoff == InvalidOffsetNumber) {
+                ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                                errmsg("failed to copy item while deduplicating block %u of index \"%s\"",
+                                       BufferGetBlockNumber(buf), RelationGetRelationName(rel))));
+            }
+            ItemIdMarkDead(PageGetItemId(newpage, newoff));
+            continue;
+        }
+
+        if (state.base != NULL && _bt_keys_equal(state.base, itup) && _bt_dedup_save_htids(&state, itup)) {
+            state.nitems++;
+            continue;
+        }
+
+        nmerged += _bt_dedup_finish_run(&state, newpage, rel);
+        _bt_dedup_start_run(&state, itup);
+    }
+    nmerged += _bt_dedup_finish_run(&state, newpage, rel);
+
+    pfree(state.htids);
+
+    if (nmerged == 0) {
+        pfree(newpage);
+        return false;
+    }
+
+    ereport(DEBUG2, (errmsg("merged %d duplicate items of block %u of index \"%s\", %lu bytes free, %lu needed",
+                            nmerged, BufferGetBlockNumber(buf), RelationGetRelationName(rel),
+                            (unsigned long)PageGetFreeSpace(newpage), (unsigned long)newitemsz)));
+
+    /* No ereport(ERROR) until changes are logged */
+    START_CRIT_SECTION();
+
+    PageRestoreTempPage(newpage, page);
+    MarkBufferDirty(buf);
+
+    if (RelationNeedsWAL(rel)) {
+        TdeInfo tde_info = {0};
+
+        if (RelationisEncryptEnable(rel)) {
+            GetTdeInfoFromRel(rel, &tde_info);
+        }
+        log_newpage_buffer(buf, true, &tde_info);
+    }
+
+    END_CRIT_SECTION();
+
+    return true;
+}
+
+/*
+ * _bt_form_posting() -- build a leaf tuple with the key of base and the
+ *		given heap TIDs, which must be sorted.
+ *
+ * With a single TID the result is an ordinary leaf tuple.  The result is
+ * palloc'd in the current memory context.
+ */
+IndexTuple _bt_form_posting(IndexTuple base, ItemPointer htids, int nhtids)
+{
+    Size keysize = _bt_keysize(base);
+    Size newsize;
+    IndexTuple itup;
+    errno_t rc;
+
+    Assert(nhtids > 0 && nhtids <= BTMaxPostingTids);
+    Assert(keysize == MAXALIGN(keysize));
+
+    if (nhtids > 1) {
+        newsize = MAXALIGN(keysize + nhtids * sizeof(ItemPointerData));
+    } else {
+        newsize = keysize;
+    }
+
+    itup = (IndexTuple)palloc0(newsize);
+    rc = memcpy_s(itup, newsize, base, keysize);
+    securec_check(rc, "", "");
+    itup->t_info &= ~INDEX_SIZE_MASK;
+    itup->t_info |= newsize;
+
+    if (nhtids > 1) {
+        BTreeTupleSetPosting(itup, nhtids, keysize);
+        rc = memcpy_s(BTreeTupleGetPosting(itup), nhtids * sizeof(ItemPointerData), htids,
+                      nhtids * sizeof(ItemPointerData));
+        securec_check(rc, "", "");
+    } else {
+        itup->t_info &= ~INDEX_ALT_TID_MASK;
+        ItemPointerCopy(htids, &itup->t_tid);
+    }
+
+    return itup;
+}
+
+/*
+ * _bt_strip_posting() -- copy a leaf tuple without its posting list.
+ *
+ * The copy points at the first heap TID of the original.  Used where a key
+ * is needed on its own, such as a new high key during a page split.
+ */
+IndexTuple _bt_strip_posting(IndexTuple itup)
+{
+    if (!BTreeTupleIsPosting(itup)) {
+        return CopyIndexTuple(itup);
+    }
+    return _bt_form_posting(itup, BTreeTupleGetPosting(itup), 1);
+}
+
+/* Size of the key part of a leaf tuple, i.e. where its posting list would start */
+static Size _bt_keysize(IndexTuple itup)
+{
+    if (BTreeTupleIsPosting(itup)) {
+        return BTreeTupleGetPostingOffset(itup);
+    }
+    return IndexTupleSize(itup);
+}
+
+/*
+ * Are the keys of two leaf tuples binary equal?  Equal bytes always compare
+ * equal under the opclass; the converse does not hold, but missing a merge
+ * is harmless.
+ */
+static bool _bt_keys_equal(IndexTuple a, IndexTuple b)
+{
+    const unsigned short mask = INDEX_NULL_MASK | INDEX_VAR_MASK;
+    Size keysize = _bt_keysize(a);
+
+    if ((a->t_info & mask) != (b->t_info & mask) || keysize != _bt_keysize(b)) {
+        return false;
+    }
+
+    return memcmp((char*)a + sizeof(IndexTupleData), (char*)b + sizeof(IndexTupleData),
+                  keysize - sizeof(IndexTupleData)) == 0;
+}
+
+static void _bt_dedup_start_run(BTDedupState* state, IndexTuple itup)
+{
+    state->base = itup;
+    state->basesize = _bt_keysize(itup);
+    state->nitems = 1;
+    state->nhtids = 0;
+    (void)_bt_dedup_save_htids(state, itup);
+}
+
+/*
+ * Add the heap TIDs of itup to the current run, unless that would make the
+ * posting list tuple too large.
+ */
+static bool _bt_dedup_save_htids(BTDedupState* state, IndexTuple itup)
+{
+    int nhtids = BTreeTupleIsPosting(itup) ? BTreeTupleGetNPosting(itup) : 1;
+    Size newsize = MAXALIGN(state->basesize + (state->nhtids + nhtids) * sizeof(ItemPointerData));
+
+    if (state->nhtids > 0 &&
+        (newsize > state->maxpostingsize || state->nhtids + nhtids > BTMaxPostingTids)) {
+        return false;
+    }
+
+    if (BTreeTupleIsPosting(itup)) {
+        errno_t rc = memcpy_s(state->htids + state->nhtids,
+                              (MaxTIDsPerBTreePage - state->nhtids) * sizeof(ItemPointerData),
+                              BTreeTupleGetPosting(itup), nhtids * sizeof(ItemPointerData));
+        securec_check(rc, "", "");
+    } else {
+        state->htids[state->nhtids] = itup->t_tid;
+    }
+    state->nhtids += nhtids;
+
+    return true;
+}
+
+/*
+ * Write the current run to newpage, as a posting list tuple if it merged
+ * several items.  Returns the number of items that went away.
+ */
+static int _bt_dedup_finish_run(BTDedupState* state, Page newpage, Relation rel)
+{
+    IndexTuple itup;
+    int nmerged;
+
+    if (state->base == NULL) {
+        return 0;
+    }
+
+    if (state->nitems == 1) {
+        itup = state->base;
+    } else {
+        qsort(state->htids, state->nhtids, sizeof(ItemPointerData), _bt_itemptr_cmp);
+        itup = _bt_form_posting(state->base, state->htids, state->nhtids);
+    }
+
+    if (PageAddItem(newpage, (Item)itup, MAXALIGN(IndexTupleSize(itup)),
+                    OffsetNumberNext(PageGetMaxOffsetNumber(newpage)), false, false) == InvalidOffsetNumber) {
+        ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                        errmsg("failed to add item while deduplicating index \"%s\"", RelationGetRelationName(rel))));
+    }
+
+    if (itup != state->base) {
+        pfree(itup);
+    }
+
+    nmerged = state->nitems - 1;
+    state->base = NULL;
+    state->nitems = 0;
+    state->nhtids = 0;
+
+    return nmerged;
+}
+
+static int _bt_itemptr_cmp(const void* a, const void* b)
+{
+    return ItemPointerCompare((ItemPointer)a, (ItemPointer)b);
+}
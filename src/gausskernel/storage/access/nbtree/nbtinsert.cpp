@@ -692,7 +692,8 @@ next:
  *		any existing equal keys because of the way _bt_binsrch() works.
  *
  *		If there's not enough room in the space, we try to make room by
- *		removing any LP_DEAD tuples.
+ *		removing any LP_DEAD tuples, and before splitting the page, by
+ *		merging duplicate keys into posting lists.
  *
  *		On entry, *buf and *offsetptr point to the first legal position
  *		where the new tuple could be inserted.	The caller should hold an
@@ -781,8 +782,17 @@ static void _bt_findinsertloc(Relation rel, Buffer *bufptr, OffsetNumber *offset
          * nope, so check conditions (b) and (c) enumerated above
          */
         if (P_RIGHTMOST(lpageop) || _bt_compare(rel, keysz, scankey, page, P_HIKEY) != 0 ||
-            random() <= (MAX_RANDOM_VALUE / 100))
+            random() <= (MAX_RANDOM_VALUE / 100)) {
+            /*
+             * We are going to split this page.  As a last resort, merge
+             * duplicate keys into posting lists, which may free enough space
+             * to avoid the split, or at least delay the next one.
+             */
+            if (P_ISLEAF(lpageop) && _bt_dedup_is_possible(rel, heapRel) && _bt_dedup_one_page(rel, buf, itemsz)) {
+                vacuumed = true;
+            }
             break;
+        }
 
         /*
          * step right to next non-dead page
@@ -1261,6 +1271,11 @@ static Buffer _bt_split(Relation rel, Buffer buf, Buffer cbuf, OffsetNumber firs
         lefthikey = _bt_nonkey_truncate(rel, item);
         itemsz = IndexTupleSize(lefthikey);
         itemsz = MAXALIGN(itemsz);
+    } else if (isleaf && BTreeTupleIsPosting(item)) {
+        /* high keys never carry a posting list */
+        lefthikey = _bt_strip_posting(item);
+        itemsz = IndexTupleSize(lefthikey);
+        itemsz = MAXALIGN(itemsz);
     } else {
         lefthikey = item;
     }
@@ -811,6 +811,72 @@ void _bt_delitems_vacuum(const Relation rel, Buffer buf, OffsetNumber *itemnos,
     END_CRIT_SECTION();
 }
 
+/*
+ * Delete item(s) from a btree leaf page during VACUUM, and replace posting
+ * list tuples that lost some of their heap TIDs by the smaller versions the
+ * caller built.
+ *
+ * Works like _bt_delitems_vacuum(), whose comments apply here as well.  Both
+ * offset arrays must be in increasing order.  Updates are applied first; they
+ * do not change any item's offset, so the deletable offsets stay valid.
+ */
+void _bt_delitems_vacuum_posting(const Relation rel, Buffer buf, OffsetNumber *deletable, int ndeletable,
+                                 OffsetNumber *updatable, IndexTuple *updated, int nupdatable,
+                                 BlockNumber lastBlockVacuumed)
+{
+    Page page = BufferGetPage(buf);
+    BTPageOpaqueInternal opaque;
+    int i;
+
+    Assert(nupdatable > 0);
+
+    /* No ereport(ERROR) until changes are logged */
+    START_CRIT_SECTION();
+
+    /* Fix the page */
+    for (i = 0; i < nupdatable; i++) {
+        _bt_update_posting(page, updatable[i], updated[i]);
+    }
+    if (ndeletable > 0) {
+        PageIndexMultiDelete(page, deletable, ndeletable);
+    }
+
+    opaque = (BTPageOpaqueInternal)PageGetSpecialPointer(page);
+    opaque->btpo_cycleid = 0;
+    opaque->btpo_flags &= ~BTP_HAS_GARBAGE;
+
+    MarkBufferDirty(buf);
+
+    /* XLOG stuff */
+    if (RelationNeedsWAL(rel)) {
+        XLogRecPtr recptr;
+        xl_btree_vacuum_posting xlrec_vacuum;
+
+        xlrec_vacuum.lastBlockVacuumed = lastBlockVacuumed;
+        xlrec_vacuum.ndeleted = (uint16)ndeletable;
+        xlrec_vacuum.nupdated = (uint16)nupdatable;
+
+        XLogBeginInsert();
+        XLogRegisterBuffer(0, buf, REGBUF_STANDARD);
+        XLogRegisterData((char *)&xlrec_vacuum, SizeOfBtreeVacuumPosting);
+
+        /* As in _bt_delitems_vacuum, none of this is needed with a full-page image */
+        if (ndeletable > 0) {
+            XLogRegisterBufData(0, (char *)deletable, ndeletable * sizeof(OffsetNumber));
+        }
+        XLogRegisterBufData(0, (char *)updatable, nupdatable * sizeof(OffsetNumber));
+        for (i = 0; i < nupdatable; i++) {
+            XLogRegisterBufData(0, (char *)updated[i], MAXALIGN(IndexTupleSize(updated[i])));
+        }
+
+        recptr = XLogInsert(RM_BTREE_ID, XLOG_BTREE_VACUUM_POSTING);
+
+        PageSetLSN(page, recptr);
+    }
+
+    END_CRIT_SECTION();
+}
+
 /*
  * Delete item(s) from a btree page during single-page cleanup.
  *
@@ -52,6 +52,8 @@ typedef struct {
 static void btvacuumscan(IndexVacuumInfo *info, IndexBulkDeleteResult *stats, IndexBulkDeleteCallback callback,
                          void *callback_state, BTCycleId cycleid);
 static void btvacuumpage(BTVacState *vstate, BlockNumber blkno, BlockNumber orig_blkno);
+static IndexTuple btreevacuumposting(BTVacState *vstate, IndexTuple posting, Oid partOid, int2 bktId,
+                                     int *nremaining);
 
 static IndexTuple btgetindextuple(IndexScanDesc scan, ScanDirection dir, BlockNumber heapTupleBlkOffset);
 
@@ -396,6 +398,7 @@ Datum btbeginscan(PG_FUNCTION_ARGS)
     /* allocate private workspace */
     so = (BTScanOpaque)palloc(sizeof(BTScanOpaqueData));
     so->currPos.buf = so->markPos.buf = InvalidBuffer;
+    _bt_initscanpos(so);
     if (scan->numberOfKeys > 0) {
         so->keyData = (ScanKey)palloc(scan->numberOfKeys * sizeof(ScanKeyData));
     } else {
@@ -527,6 +530,8 @@ Datum btendscan(PG_FUNCTION_ARGS)
     }
     FREE_POINTER(so->killedItems);
     FREE_POINTER(so->currTuples);
+    pfree(so->currPos.items);
+    pfree(so->markPos.items);
 
     /* so->markTuples should not be pfree'd, see btrescan */
     pfree(so);
@@ -601,14 +606,10 @@ Datum btrestrpos(PG_FUNCTION_ARGS)
         if (BTScanPosIsValid(so->markPos)) {
             /* bump pin on mark buffer for assignment to current buffer */
             IncrBufferRefCount(so->markPos.buf);
-            errno_t rc = memcpy_s(&so->currPos,
-                                  offsetof(BTScanPosData, items[1]) + so->markPos.lastItem * sizeof(BTScanPosItem),
-                                  &so->markPos,
-                                  offsetof(BTScanPosData, items[1]) + so->markPos.lastItem * sizeof(BTScanPosItem));
-            securec_check(rc, "", "");
+            _bt_copyscanpos(so, &so->currPos, &so->markPos);
             if (so->currTuples) {
-                rc = memcpy_s(so->currTuples, (size_t)so->markPos.nextTupleOffset, so->markTuples,
-                              (size_t)so->markPos.nextTupleOffset);
+                errno_t rc = memcpy_s(so->currTuples, (size_t)so->markPos.nextTupleOffset, so->markTuples,
+                                      (size_t)so->markPos.nextTupleOffset);
                 securec_check(rc, "", "");
             }
         }
@@ -893,6 +894,11 @@ restart:
     } else if (P_ISLEAF(opaque)) {
         OffsetNumber deletable[MaxOffsetNumber];
         int ndeletable;
+        OffsetNumber updatable[MaxOffsetNumber];
+        IndexTuple updated[MaxOffsetNumber];
+        int nupdatable;
+        int nhtidsdead;
+        int nhtidslive;
         OffsetNumber offnum, minoff, maxoff;
 
         /*
@@ -929,6 +935,9 @@ restart:
          * callback function.
          */
         ndeletable = 0;
+        nupdatable = 0;
+        nhtidsdead = 0;
+        nhtidslive = 0;
         minoff = P_FIRSTDATAKEY(opaque);
         maxoff = PageGetMaxOffsetNumber(page);
         if (callback) {
@@ -965,8 +974,24 @@ restart:
                 if (RelationIsCrossBucketIndex(rel)) {
                     bktId = index_getattr_bucketid(rel, itup);
                 }
-                if (callback(htup, callback_state, partOid, bktId)) {
+                if (BTreeTupleIsPosting(itup)) {
+                    int nremaining;
+                    IndexTuple newitup = btreevacuumposting(vstate, itup, partOid, bktId, &nremaining);
+
+                    if (newitup != NULL) {
+                        /* some TIDs are dead, replace the tuple by a smaller one */
+                        updatable[nupdatable] = offnum;
+                        updated[nupdatable++] = newitup;
+                    } else if (nremaining == 0) {
+                        deletable[ndeletable++] = offnum;
+                    }
+                    nhtidsdead += BTreeTupleGetNPosting(itup) - nremaining;
+                    nhtidslive += nremaining;
+                } else if (callback(htup, callback_state, partOid, bktId)) {
                     deletable[ndeletable++] = offnum;
+                    nhtidsdead++;
+                } else {
+                    nhtidslive++;
                 }
             }
         }
@@ -975,7 +1000,7 @@ restart:
          * Apply any needed deletes.  We issue just one _bt_delitems_vacuum()
          * call per page, so as to minimize WAL traffic.
          */
-        if (ndeletable > 0) {
+        if (ndeletable > 0 || nupdatable > 0) {
             /*
              * Notice that the issued XLOG_BTREE_VACUUM WAL record includes an
              * instruction to the replay code to get cleanup lock on all pages
@@ -987,7 +1012,15 @@ restart:
              * doesn't seem worth the amount of bookkeeping it'd take to avoid
              * that.
              */
-            _bt_delitems_vacuum(rel, buf, deletable, ndeletable, vstate->lastBlockVacuumed);
+            if (nupdatable == 0) {
+                _bt_delitems_vacuum(rel, buf, deletable, ndeletable, vstate->lastBlockVacuumed);
+            } else {
+                _bt_delitems_vacuum_posting(rel, buf, deletable, ndeletable, updatable, updated, nupdatable,
+                                            vstate->lastBlockVacuumed);
+                for (int i = 0; i < nupdatable; i++) {
+                    pfree(updated[i]);
+                }
+            }
 
             /*
              * Remember highest leaf page number we've issued a
@@ -997,7 +1030,7 @@ restart:
                 vstate->lastBlockVacuumed = blkno;
             }
 
-            stats->tuples_removed += ndeletable;
+            stats->tuples_removed += nhtidsdead;
             /* must recompute maxoff */
             maxoff = PageGetMaxOffsetNumber(page);
         } else {
@@ -1023,6 +1056,8 @@ restart:
          */
         if (minoff > maxoff) {
             delete_now = (blkno == orig_blkno);
+        } else if (callback) {
+            stats->num_index_tuples += nhtidslive;
         } else {
             stats->num_index_tuples += maxoff - minoff + 1;
         }
@@ -1058,6 +1093,51 @@ restart:
     }
 }
 
+/*
+ * btreevacuumposting --- determine which heap TIDs of a posting list tuple
+ * are dead.
+ *
+ * Returns NULL if the tuple should be kept as is or deleted entirely; the two
+ * cases are told apart by *nremaining, the number of live TIDs.  Otherwise
+ * returns a palloc'd replacement tuple that holds only the live TIDs.
+ */
+static IndexTuple btreevacuumposting(BTVacState *vstate, IndexTuple posting, Oid partOid, int2 bktId,
+                                     int *nremaining)
+{
+    int nhtids = BTreeTupleGetNPosting(posting);
+    ItemPointer htids = BTreeTupleGetPosting(posting);
+    ItemPointer live = NULL;
+    int nlive = 0;
+    IndexTuple result = NULL;
+
+    for (int i = 0; i < nhtids; i++) {
+        if (vstate->callback(htids + i, vstate->callback_state, partOid, bktId)) {
+            if (live == NULL) {
+                /* first dead TID, start collecting the survivors */
+                live = (ItemPointer)palloc(nhtids * sizeof(ItemPointerData));
+                for (nlive = 0; nlive < i; nlive++) {
+                    live[nlive] = htids[nlive];
+                }
+            }
+        } else if (live != NULL) {
+            live[nlive++] = htids[i];
+        }
+    }
+
+    if (live == NULL) {
+        *nremaining = nhtids;
+        return NULL;
+    }
+
+    *nremaining = nlive;
+    if (nlive > 0) {
+        result = _bt_form_posting(posting, live, nlive);
+    }
+    pfree(live);
+
+    return result;
+}
+
 /*
  *	btcanreturn() -- Check whether btree indexes support index-only scans.
  *
@@ -32,6 +32,10 @@
 static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber offnum);
 static void _bt_saveitem(BTScanOpaque so, int itemIndex, OffsetNumber offnum, IndexTuple itup, Oid partOid,
     int2 bucketid);
+static int _bt_setuppostingitems(BTScanOpaque so, int itemIndex, OffsetNumber offnum, ItemPointer heapTid,
+    IndexTuple itup, Oid partOid, int2 bucketid);
+static void _bt_savepostingitem(BTScanOpaque so, int itemIndex, OffsetNumber offnum, ItemPointer heapTid,
+    int tupleOffset, Oid partOid, int2 bucketid);
 static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir);
 static bool _bt_endpoint(IndexScanDesc scan, ScanDirection dir);
 static void _bt_check_natts_correct(const Relation index, Page page, OffsetNumber offnum);
@@ -956,6 +960,8 @@ bool _bt_first(IndexScanDesc scan, ScanDirection dir)
     scan->xs_ctup.t_self = currItem->heapTid;
     if (scan->xs_want_itup) {
         scan->xs_itup = (IndexTuple)(so->currTuples + currItem->tupleOffset);
+        /* a key copied from a posting list is shared by several items */
+        scan->xs_itup->t_tid = currItem->heapTid;
     }
     if (scan->xs_want_ext_oid && GPIScanCheckPartOid(scan->xs_gpi_scan, currItem->partitionOid)) {
         GPISetCurrPartOid(scan->xs_gpi_scan, currItem->partitionOid);
@@ -1015,8 +1021,11 @@ bool _bt_next(IndexScanDesc scan, ScanDirection dir)
     /* OK, itemIndex says what to return */
     currItem = &so->currPos.items[so->currPos.itemIndex];
     scan->xs_ctup.t_self = currItem->heapTid;
-    if (scan->xs_want_itup)
+    if (scan->xs_want_itup) {
         scan->xs_itup = (IndexTuple)(so->currTuples + currItem->tupleOffset);
+        /* a key copied from a posting list is shared by several items */
+        scan->xs_itup->t_tid = currItem->heapTid;
+    }
 
     if (scan->xs_want_ext_oid && GPIScanCheckPartOid(scan->xs_gpi_scan, currItem->partitionOid)) {
         GPISetCurrPartOid(scan->xs_gpi_scan, currItem->partitionOid);
@@ -1095,8 +1104,23 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
                 /* Get bucketid for crossbucket index. */
                 bucketid = scan->xs_want_bucketid ? index_getattr_bucketid(scan->indexRelation, itup) : InvalidBktId;
                 /* tuple passes all scan key conditions, so remember it */
-                _bt_saveitem(so, itemIndex, offnum, itup, partOid, bucketid);
-                itemIndex++;
+                if (itemIndex + BTreeTupleGetNItems(itup) > so->maxItems) {
+                    _bt_growscanpos(so);
+                }
+                if (!BTreeTupleIsPosting(itup)) {
+                    _bt_saveitem(so, itemIndex, offnum, itup, partOid, bucketid);
+                    itemIndex++;
+                } else {
+                    /* one item per heap TID, all sharing a single copy of the key */
+                    int tupleOffset = _bt_setuppostingitems(so, itemIndex, offnum, BTreeTupleGetPostingN(itup, 0),
+                                                            itup, partOid, bucketid);
+                    itemIndex++;
+                    for (int i = 1; i < BTreeTupleGetNPosting(itup); i++) {
+                        _bt_savepostingitem(so, itemIndex, offnum, BTreeTupleGetPostingN(itup, i), tupleOffset,
+                                            partOid, bucketid);
+                        itemIndex++;
+                    }
+                }
             }
             if (!continuescan) {
                 /* there can't be any more matches, so stop */
@@ -1107,13 +1131,13 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
             offnum = OffsetNumberNext(offnum);
         }
 
-        Assert(itemIndex <= MaxIndexTuplesPerPage);
+        Assert(itemIndex <= so->maxItems);
         so->currPos.firstItem = 0;
         so->currPos.lastItem = itemIndex - 1;
         so->currPos.itemIndex = 0;
     } else {
         /* load items[] in descending order */
-        itemIndex = MaxIndexTuplesPerPage;
+        itemIndex = so->maxItems;
 
         offnum = Min(offnum, maxoff);
 
@@ -1123,8 +1147,36 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
                 partOid = scan->xs_want_ext_oid ? index_getattr_tableoid(scan->indexRelation, itup) : heapOid;
                 bucketid = scan->xs_want_bucketid ? index_getattr_bucketid(scan->indexRelation, itup) : InvalidBktId;
                 /* tuple passes all scan key conditions, so remember it */
-                itemIndex--;
-                _bt_saveitem(so, itemIndex, offnum, itup, partOid, bucketid);
+                if (itemIndex < BTreeTupleGetNItems(itup)) {
+                    /* keep the items loaded so far at the end of the enlarged array */
+                    int oldMaxItems = so->maxItems;
+
+                    _bt_growscanpos(so);
+                    if (oldMaxItems < so->maxItems) {
+                        int shift = so->maxItems - oldMaxItems;
+                        errno_t rc = memmove_s(&so->currPos.items[itemIndex + shift],
+                                               (oldMaxItems - itemIndex) * sizeof(BTScanPosItem),
+                                               &so->currPos.items[itemIndex],
+                                               (oldMaxItems - itemIndex) * sizeof(BTScanPosItem));
+                        securec_check(rc, "", "");
+                        itemIndex += shift;
+                    }
+                }
+                if (!BTreeTupleIsPosting(itup)) {
+                    itemIndex--;
+                    _bt_saveitem(so, itemIndex, offnum, itup, partOid, bucketid);
+                } else {
+                    int tupleOffset;
+
+                    itemIndex--;
+                    tupleOffset = _bt_setuppostingitems(so, itemIndex, offnum, BTreeTupleGetPostingN(itup, 0), itup,
+                                                        partOid, bucketid);
+                    for (int i = 1; i < BTreeTupleGetNPosting(itup); i++) {
+                        itemIndex--;
+                        _bt_savepostingitem(so, itemIndex, offnum, BTreeTupleGetPostingN(itup, i), tupleOffset,
+                                            partOid, bucketid);
+                    }
+                }
             }
             if (!continuescan) {
                 /* there can't be any more matches, so stop */
@@ -1137,8 +1189,8 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
 
         Assert(itemIndex >= 0);
         so->currPos.firstItem = itemIndex;
-        so->currPos.lastItem = MaxIndexTuplesPerPage - 1;
-        so->currPos.itemIndex = MaxIndexTuplesPerPage - 1;
+        so->currPos.lastItem = so->maxItems - 1;
+        so->currPos.itemIndex = so->maxItems - 1;
     }
 
     return (so->currPos.firstItem <= so->currPos.lastItem);
@@ -1165,6 +1217,58 @@ static void _bt_saveitem(BTScanOpaque so, int itemIndex, OffsetNumber offnum, co
     }
 }
 
+/*
+ * Set up state to save the heap TIDs of a posting list tuple, and save the
+ * first one into so->currPos.items[itemIndex].  For an index-only scan a
+ * single copy of the key, without the posting list, goes into the tuple
+ * workspace; returns its offset for use by _bt_savepostingitem().
+ */
+static int _bt_setuppostingitems(BTScanOpaque so, int itemIndex, OffsetNumber offnum, ItemPointer heapTid,
+    IndexTuple itup, Oid partOid, int2 bucketid)
+{
+    BTScanPosItem *currItem = &so->currPos.items[itemIndex];
+
+    Assert(BTreeTupleIsPosting(itup));
+
+    currItem->heapTid = *heapTid;
+    currItem->indexOffset = offnum;
+    currItem->partitionOid = partOid;
+    currItem->bucketid = bucketid;
+
+    if (so->currTuples) {
+        Size itupsz = BTreeTupleGetPostingOffset(itup);
+        IndexTuple base = (IndexTuple)(so->currTuples + so->currPos.nextTupleOffset);
+
+        currItem->tupleOffset = (uint16)so->currPos.nextTupleOffset;
+        errno_t rc = memcpy_s(base, itupsz, itup, itupsz);
+        securec_check(rc, "", "");
+        /* Make the copy an ordinary leaf tuple */
+        base->t_info &= ~(INDEX_SIZE_MASK | INDEX_ALT_TID_MASK);
+        base->t_info |= itupsz;
+        base->t_tid = *heapTid;
+        so->currPos.nextTupleOffset += MAXALIGN(itupsz);
+        return currItem->tupleOffset;
+    }
+
+    return 0;
+}
+
+/* Save one more heap TID of the posting list set up by _bt_setuppostingitems() */
+static void _bt_savepostingitem(BTScanOpaque so, int itemIndex, OffsetNumber offnum, ItemPointer heapTid,
+    int tupleOffset, Oid partOid, int2 bucketid)
+{
+    BTScanPosItem *currItem = &so->currPos.items[itemIndex];
+
+    currItem->heapTid = *heapTid;
+    currItem->indexOffset = offnum;
+    currItem->partitionOid = partOid;
+    currItem->bucketid = bucketid;
+
+    if (so->currTuples) {
+        currItem->tupleOffset = (uint16)tupleOffset;
+    }
+}
+
 /*
  *	_bt_steppage() -- Step to next page containing valid data for scan
  *
@@ -1198,13 +1302,10 @@ static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir)
     if (so->markItemIndex >= 0) {
         /* bump pin on current buffer for assignment to mark buffer */
         IncrBufferRefCount(so->currPos.buf);
-        errno_t rc =
-            memcpy_s(&so->markPos, offsetof(BTScanPosData, items[1]) + so->currPos.lastItem * sizeof(BTScanPosItem),
-                     &so->currPos, offsetof(BTScanPosData, items[1]) + so->currPos.lastItem * sizeof(BTScanPosItem));
-        securec_check(rc, "", "");
+        _bt_copyscanpos(so, &so->markPos, &so->currPos);
         if (so->markTuples) {
-            rc = memcpy_s(so->markTuples, (size_t)so->currPos.nextTupleOffset, so->currTuples,
-                          (size_t)so->currPos.nextTupleOffset);
+            errno_t rc = memcpy_s(so->markTuples, (size_t)so->currPos.nextTupleOffset, so->currTuples,
+                                  (size_t)so->currPos.nextTupleOffset);
             securec_check(rc, "", "");
         }
         so->markPos.itemIndex = so->markItemIndex;
@@ -1561,8 +1662,11 @@ static bool _bt_endpoint(IndexScanDesc scan, ScanDirection dir)
     /* OK, itemIndex says what to return */
     currItem = &so->currPos.items[so->currPos.itemIndex];
     scan->xs_ctup.t_self = currItem->heapTid;
-    if (scan->xs_want_itup)
+    if (scan->xs_want_itup) {
         scan->xs_itup = (IndexTuple)(so->currTuples + currItem->tupleOffset);
+        /* a key copied from a posting list is shared by several items */
+        scan->xs_itup->t_tid = currItem->heapTid;
+    }
 
     if (scan->xs_want_ext_oid && GPIScanCheckPartOid(scan->xs_gpi_scan, currItem->partitionOid)) {
         GPISetCurrPartOid(scan->xs_gpi_scan, currItem->partitionOid);
@@ -1621,8 +1725,8 @@ bool _bt_gettuple_internal(IndexScanDesc scan, ScanDirection dir)
                  * just forget any excess entries.
                  */
                 if (so->killedItems == NULL)
-                    so->killedItems = (int *)palloc(MaxIndexTuplesPerPage * sizeof(int));
-                if (so->numKilled < MaxIndexTuplesPerPage)
+                    so->killedItems = (int *)palloc(MaxTIDsPerBTreePage * sizeof(int));
+                if (so->numKilled < MaxTIDsPerBTreePage)
                     so->killedItems[so->numKilled++] = so->currPos.itemIndex;
             }
 
@@ -38,6 +38,8 @@ static int _bt_compare_array_elements(const void *a, const void *b, void *arg);
 static bool _bt_compare_scankey_args(IndexScanDesc scan, ScanKey op, ScanKey leftarg, ScanKey rightarg, bool *result);
 static bool _bt_fix_scankey_strategy(ScanKey skey, const int16 *indoption);
 static void _bt_mark_scankey_required(ScanKey skey);
+static bool _bt_posting_contains(IndexTuple posting, ItemPointer htid);
+static bool _bt_posting_all_killed(BTScanOpaque so, OffsetNumber indexOffset, IndexTuple posting);
 
 /*
  * _bt_mkscankey
@@ -1534,6 +1536,55 @@ bool _bt_check_rowcompare(ScanKey skey, IndexTuple tuple, TupleDesc tupdesc, Sca
     return result;
 }
 
+/* Does the sorted TID array of a posting list tuple contain htid? */
+static bool _bt_posting_contains(IndexTuple posting, ItemPointer htid)
+{
+    ItemPointer htids = BTreeTupleGetPosting(posting);
+    int low = 0;
+    int high = BTreeTupleGetNPosting(posting) - 1;
+
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        int32 cmp = ItemPointerCompare(htid, htids + mid);
+
+        if (cmp == 0) {
+            return true;
+        } else if (cmp < 0) {
+            high = mid - 1;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return false;
+}
+
+/*
+ * Were all heap TIDs of a posting list tuple, read from indexOffset when the
+ * page was loaded, reported as killed?
+ */
+static bool _bt_posting_all_killed(BTScanOpaque so, OffsetNumber indexOffset, IndexTuple posting)
+{
+    int nhtids = BTreeTupleGetNPosting(posting);
+
+    for (int i = 0; i < nhtids; i++) {
+        ItemPointer htid = BTreeTupleGetPostingN(posting, i);
+        bool found = false;
+
+        for (int j = 0; j < so->numKilled; j++) {
+            BTScanPosItem *kitem = &so->currPos.items[so->killedItems[j]];
+
+            if (kitem->indexOffset == indexOffset && ItemPointerEquals(&kitem->heapTid, htid)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /*
  * _bt_killitems - set LP_DEAD state for items an indexscan caller has
  * told us were killed
@@ -1595,7 +1646,20 @@ void _bt_killitems(IndexScanDesc scan, bool haveLock)
             IndexTuple ituple = (IndexTuple)PageGetItem(page, iid);
             Oid currPartOid = scan->xs_want_ext_oid ? index_getattr_tableoid(scan->indexRelation, ituple) : heapOid;
             int2 currbktid = scan->xs_want_bucketid ? index_getattr_bucketid(scan->indexRelation, ituple) : bucketid;
-            if (ItemPointerEquals(&ituple->t_tid, &kitem->heapTid) && currPartOid == partOid && currbktid == bucketid) {
+            if (BTreeTupleIsPosting(ituple)) {
+                /*
+                 * A posting list tuple can only be marked dead once every
+                 * heap TID in it was killed by this scan.
+                 */
+                if (_bt_posting_contains(ituple, &kitem->heapTid)) {
+                    if (_bt_posting_all_killed(so, kitem->indexOffset, ituple)) {
+                        ItemIdMarkDead(iid);
+                        killedsomething = true;
+                    }
+                    break; /* out of inner search loop */
+                }
+            } else if (ItemPointerEquals(&ituple->t_tid, &kitem->heapTid) && currPartOid == partOid &&
+                       currbktid == bucketid) {
                 /* found the item */
                 ItemIdMarkDead(iid);
                 killedsomething = true;
@@ -1629,6 +1693,53 @@ void _bt_killitems(IndexScanDesc scan, bool haveLock)
     so->numKilled = 0;
 }
 
+/*
+ * _bt_initscanpos() -- allocate the items arrays of currPos and markPos
+ *
+ * They are sized for a page without posting lists; _bt_growscanpos enlarges
+ * both once a scan meets a page that needs more.
+ */
+void _bt_initscanpos(BTScanOpaque so)
+{
+    so->maxItems = MaxIndexTuplesPerPage;
+    so->currPos.items = (BTScanPosItem*)palloc(so->maxItems * sizeof(BTScanPosItem));
+    so->markPos.items = (BTScanPosItem*)palloc(so->maxItems * sizeof(BTScanPosItem));
+}
+
+/*
+ * _bt_growscanpos() -- make room for every heap TID a leaf page can hold
+ *
+ * Items already saved keep their indexes, callers loading a page backwards
+ * have to move them to the end of the enlarged array themselves.
+ */
+void _bt_growscanpos(BTScanOpaque so)
+{
+    if (so->maxItems >= MaxTIDsPerBTreePage) {
+        return;
+    }
+    so->maxItems = MaxTIDsPerBTreePage;
+    so->currPos.items = (BTScanPosItem*)repalloc(so->currPos.items, so->maxItems * sizeof(BTScanPosItem));
+    so->markPos.items = (BTScanPosItem*)repalloc(so->markPos.items, so->maxItems * sizeof(BTScanPosItem));
+}
+
+/*
+ * _bt_copyscanpos() -- copy a scan position up to its last valid item
+ *
+ * dst keeps its own items array.
+ */
+void _bt_copyscanpos(BTScanOpaque so, BTScanPos dst, const BTScanPosData* src)
+{
+    BTScanPosItem* items = dst->items;
+
+    *dst = *src;
+    dst->items = items;
+    if (src->lastItem >= 0) {
+        errno_t rc = memcpy_s(items, so->maxItems * sizeof(BTScanPosItem), src->items,
+                              (src->lastItem + 1) * sizeof(BTScanPosItem));
+        securec_check(rc, "", "");
+    }
+}
+
 /*
  * The following routines manage a shared-memory area in which we track
  * assignment of "vacuum cycle IDs" to currently-active btree vacuuming
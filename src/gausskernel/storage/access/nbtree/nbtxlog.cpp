@@ -541,7 +541,7 @@ static void btree_xlog_split(bool onleft, bool isroot, XLogReaderState *record,
     log_incomplete_split(&rnode, leftsib, rightsib, leftpblk, rightpblk, isroot);
 }
 
-static void btree_xlog_vacuum(XLogReaderState *record)
+static void btree_xlog_vacuum(uint8 info, XLogReaderState *record)
 {
     xl_btree_vacuum *xlrec = (xl_btree_vacuum *)XLogRecGetData(record);
     RedoBufferInfo redobuf;
@@ -606,7 +606,11 @@ static void btree_xlog_vacuum(XLogReaderState *record)
         Size len;
 
         ptr = XLogRecGetBlockData(record, BTREE_VACUUM_ORIG_BLOCK_NUM, &len);
-        BtreeXlogVacuumOperatorPage(&redobuf, (void *)xlrec, (void *)ptr, len);
+        if (info == XLOG_BTREE_VACUUM_POSTING) {
+            BtreeXlogVacuumPostingOperatorPage(&redobuf, XLogRecGetData(record), (void *)ptr, len);
+        } else {
+            BtreeXlogVacuumOperatorPage(&redobuf, (void *)xlrec, (void *)ptr, len);
+        }
         MarkBufferDirty(redobuf.buf);
     }
     if (BufferIsValid(redobuf.buf))
@@ -948,8 +952,8 @@ bool IsBtreeVacuum(const XLogReaderState *record)
     uint8 info = (XLogRecGetInfo(record) & (~XLR_INFO_MASK));
 
     if (XLogRecGetRmid(record) == RM_BTREE_ID) {
-        if ((info == XLOG_BTREE_REUSE_PAGE) || (info == XLOG_BTREE_VACUUM) || (info == XLOG_BTREE_DELETE) ||
-            (info == XLOG_BTREE_UNLINK_PAGE) || (info == XLOG_BTREE_UNLINK_PAGE_META) ||
+        if ((info == XLOG_BTREE_REUSE_PAGE) || (info == XLOG_BTREE_VACUUM) || (info == XLOG_BTREE_VACUUM_POSTING) ||
+            (info == XLOG_BTREE_DELETE) || (info == XLOG_BTREE_UNLINK_PAGE) || (info == XLOG_BTREE_UNLINK_PAGE_META) ||
             (info == XLOG_BTREE_MARK_PAGE_HALFDEAD)) {
             return true;
         }
@@ -1010,7 +1014,8 @@ void btree_redo(XLogReaderState *record)
             btree_xlog_split(false, true, record, issplitupgrade);
             break;
         case XLOG_BTREE_VACUUM:
-            btree_xlog_vacuum(record);
+        case XLOG_BTREE_VACUUM_POSTING:
+            btree_xlog_vacuum(info, record);
             break;
         case XLOG_BTREE_DELETE:
             btree_xlog_delete(record);
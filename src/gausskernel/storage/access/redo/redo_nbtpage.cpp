@@ -38,3 +38,20 @@ void _bt_pageinit(Page page, Size size)
     PageInit(page, size, sizeof(BTPageOpaqueData));
     BTPageGetSpecial(page)->xact = 0;
 }
+
+/*
+ * _bt_update_posting() -- replace the tuple at offnum by a smaller one.
+ *
+ * The offsets of all other items are unchanged.  Used by VACUUM and its
+ * redo, so failures are reported as PANIC.
+ */
+void _bt_update_posting(Page page, OffsetNumber offnum, IndexTuple itup)
+{
+    Size itemsz = MAXALIGN(IndexTupleSize(itup));
+
+    PageIndexTupleDelete(page, offnum);
+    if (PageAddItem(page, (Item)itup, itemsz, offnum, false, false) == InvalidOffsetNumber) {
+        ereport(PANIC, (errcode(ERRCODE_INDEX_CORRUPTED),
+                        errmsg("failed to replace posting list tuple at offset %u", (uint32)offnum)));
+    }
+}
@@ -295,6 +295,49 @@ void BtreeXlogVacuumOperatorPage(RedoBufferInfo *redobuffer, void *recorddata, v
     }
 }
 
+void BtreeXlogVacuumPostingOperatorPage(RedoBufferInfo *redobuffer, void *recorddata, void *blkdata, Size len)
+{
+    xl_btree_vacuum_posting *xlrec = (xl_btree_vacuum_posting *)recorddata;
+    Page page = redobuffer->pageinfo.page;
+    char *ptr = (char *)blkdata;
+    OffsetNumber *deleted = (OffsetNumber *)ptr;
+    OffsetNumber *updated = deleted + xlrec->ndeleted;
+    char *tuples = (char *)(updated + xlrec->nupdated);
+    BTPageOpaqueInternal opaque;
+
+    Assert(len >= (xlrec->ndeleted + xlrec->nupdated) * sizeof(OffsetNumber));
+
+    if (module_logging_is_on(MOD_REDO)) {
+        DumpBtreeDeleteInfo(redobuffer->lsn, deleted, xlrec->ndeleted);
+        DumpPageInfo(page, redobuffer->lsn);
+    }
+
+    /* Replace shrunk posting list tuples first, their offsets are stable */
+    for (int i = 0; i < xlrec->nupdated; i++) {
+        IndexTuple itup = (IndexTuple)tuples;
+
+        Assert(tuples + IndexTupleSize(itup) <= ptr + len);
+        _bt_update_posting(page, updated[i], itup);
+        tuples += MAXALIGN(IndexTupleSize(itup));
+    }
+
+    if (xlrec->ndeleted > 0) {
+        PageIndexMultiDelete(page, deleted, xlrec->ndeleted);
+    }
+
+    /*
+     * Mark the page as not containing any LP_DEAD items --- see comments in
+     * _bt_delitems_vacuum().
+     */
+    opaque = (BTPageOpaqueInternal)PageGetSpecialPointer(page);
+    opaque->btpo_flags &= ~BTP_HAS_GARBAGE;
+
+    PageSetLSN(page, redobuffer->lsn);
+    if (module_logging_is_on(MOD_REDO)) {
+        DumpPageInfo(page, redobuffer->lsn);
+    }
+}
+
 void BtreeXlogDeleteOperatorPage(RedoBufferInfo *buffer, void *recorddata, Size recorddatalen)
 {
     xl_btree_delete *xlrec = (xl_btree_delete *)recorddata;
@@ -818,6 +861,7 @@ XLogRecParseState *BtreeRedoParseToBlock(XLogReaderState *record, uint32 *blockn
             recordblockstate = BtreeXlogSplitParseBlock(record, blocknum);
             break;
         case XLOG_BTREE_VACUUM:
+        case XLOG_BTREE_VACUUM_POSTING:
             recordblockstate = BtreeXlogVacuumParseBlock(record, blocknum);
             break;
         case XLOG_BTREE_DELETE:
@@ -941,6 +985,25 @@ static void BtreeXlogVacuumBlock(XLogBlockHead *blockhead, XLogBlockDataParse *b
     }
 }
 
+static void BtreeXlogVacuumPostingBlock(XLogBlockHead *blockhead, XLogBlockDataParse *blockdatarec,
+                                        RedoBufferInfo *bufferinfo)
+{
+    XLogBlockDataParse *datadecode = blockdatarec;
+    XLogRedoAction action;
+    action = XLogCheckBlockDataRedoAction(datadecode, bufferinfo);
+    if (action == BLK_NEEDS_REDO) {
+        char *maindata = XLogBlockDataGetMainData(datadecode, NULL);
+        Size blkdatalen = 0;
+        char *blkdata = NULL;
+
+        blkdata = XLogBlockDataGetBlockData(datadecode, &blkdatalen);
+
+        BtreeXlogVacuumPostingOperatorPage(bufferinfo, (void *)maindata, (void *)blkdata, blkdatalen);
+
+        MakeRedoBufferDirty(bufferinfo);
+    }
+}
+
 static void BtreeXlogDeleteBlock(XLogBlockHead *blockhead, XLogBlockDataParse *blockdatarec, RedoBufferInfo *bufferinfo)
 {
     XLogBlockDataParse *datadecode = blockdatarec;
@@ -1056,6 +1119,9 @@ void BtreeRedoDataBlock(XLogBlockHead *blockhead, XLogBlockDataParse *blockdatar
         case XLOG_BTREE_VACUUM:
             BtreeXlogVacuumBlock(blockhead, blockdatarec, bufferinfo);
             break;
+        case XLOG_BTREE_VACUUM_POSTING:
+            BtreeXlogVacuumPostingBlock(blockhead, blockdatarec, bufferinfo);
+            break;
         case XLOG_BTREE_DELETE:
             BtreeXlogDeleteBlock(blockhead, blockdatarec, bufferinfo);
             break;
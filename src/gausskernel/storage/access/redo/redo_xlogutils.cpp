@@ -1583,7 +1583,7 @@ static inline bool IsBtreeVacuum(const XLogBlockHead *blockhead)
     uint8 info = blockhead->xl_info & (~XLR_INFO_MASK);
     RmgrId rmid = blockhead->xl_rmid;
 
-    return (rmid == RM_BTREE_ID) && (info == XLOG_BTREE_VACUUM);
+    return (rmid == RM_BTREE_ID) && (info == XLOG_BTREE_VACUUM || info == XLOG_BTREE_VACUUM_POSTING);
 }
 
 static inline bool GetCleanupLock(const XLogBlockHead *blockhead)
@@ -56,6 +56,10 @@ const char* btree_type_name(uint8 subtype)
             return "bt_vacuum";
             break;
         }
+        case XLOG_BTREE_VACUUM_POSTING: {
+            return "bt_vacuum_posting";
+            break;
+        }
         case XLOG_BTREE_DELETE: {
             return "bt_delete";
             break;
@@ -154,6 +158,13 @@ void btree_desc(StringInfo buf, XLogReaderState *record)
             appendStringInfo(buf, "vacuum: lastBlockVacuumed %u ", xlrec->lastBlockVacuumed);
             break;
         }
+        case XLOG_BTREE_VACUUM_POSTING: {
+            xl_btree_vacuum_posting *xlrec = (xl_btree_vacuum_posting *)rec;
+
+            appendStringInfo(buf, "vacuum posting: lastBlockVacuumed %u; ndeleted %u; nupdated %u ",
+                             xlrec->lastBlockVacuumed, (uint32)xlrec->ndeleted, (uint32)xlrec->nupdated);
+            break;
+        }
         case XLOG_BTREE_DELETE: {
             xl_btree_delete *xlrec = (xl_btree_delete *)rec;
             int bucket_id = XLogRecGetBucketId(record);
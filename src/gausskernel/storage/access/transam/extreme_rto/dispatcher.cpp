@@ -190,7 +190,7 @@ static const RmgrDispatchData g_dispatchTable[RM_MAX_ID + 1] = {
 
     { DispatchHeap2Record, RmgrRecordInfoValid, RM_HEAP2_ID, XLOG_HEAP2_FREEZE, XLOG_HEAP2_LOGICAL_NEWPAGE },
     { DispatchHeapRecord, RmgrRecordInfoValid, RM_HEAP_ID, XLOG_HEAP_INSERT, XLOG_HEAP_INPLACE },
-    { DispatchBtreeRecord, RmgrRecordInfoValid, RM_BTREE_ID, XLOG_BTREE_INSERT_LEAF, XLOG_BTREE_REUSE_PAGE },
+    { DispatchBtreeRecord, RmgrRecordInfoValid, RM_BTREE_ID, XLOG_BTREE_INSERT_LEAF, XLOG_BTREE_VACUUM_POSTING },
     { DispatchHashRecord, RmgrRecordInfoValid, RM_HASH_ID, XLOG_HASH_INIT_META_PAGE, XLOG_HASH_VACUUM_ONE_PAGE },
     { DispatchGinRecord, RmgrRecordInfoValid, RM_GIN_ID, XLOG_GIN_CREATE_INDEX, XLOG_GIN_VACUUM_DATA_LEAF_PAGE },
     /* XLOG_GIST_PAGE_DELETE is not used and info isn't continus  */
@@ -1844,6 +1844,36 @@ uint32 GetAllWorkerCount()
     return g_dispatcher == NULL ? 0 : g_dispatcher->allWorkersCnt;
 }
 
+/*
+ * Publish the buffer a redo thread waits on for a cleanup lock, or -1 when it
+ * stops waiting. Hot standby backends holding a pin on it are cancelled, see
+ * HoldingBufferPinThatDelaysRecovery. Page workers take cleanup locks too, so
+ * every worker has its own slot besides the startup one.
+ */
+void SetStartupBufferPinWaitBufId(int bufid)
+{
+    if (g_instance.proc_base->startupProcPid == t_thrd.proc->pid) {
+        g_instance.proc_base->startupBufferPinWaitBufId = bufid;
+    }
+    if (g_redoWorker != NULL) {
+        g_redoWorker->bufferPinWaitBufId = bufid;
+    }
+}
+
+uint32 GetStartupBufferPinWaitBufLen()
+{
+    return GetAllWorkerCount() + 1;
+}
+
+/* Used by backends when they receive a request to check for buffer pin waits. */
+void GetStartupBufferPinWaitBufId(int *bufids, uint32 len)
+{
+    for (uint32 i = 0; i < len - 1; i++) {
+        bufids[i] = g_dispatcher->allWorkers[i]->bufferPinWaitBufId;
+    }
+    bufids[len - 1] = g_instance.proc_base->startupBufferPinWaitBufId;
+}
+
 /* Run from the dispatcher thread. */
 uint32 GetBatchCount()
 {
@@ -1944,6 +1974,26 @@ void GetReplayedRecPtr(XLogRecPtr *startPtr, XLogRecPtr *endPtr)
     *endPtr = minEnd;
 }
 
+/*
+ * The smallest end position replayed by all page workers, the page changes of
+ * every record ending before it are in the buffers.
+ */
+XLogRecPtr GetPageReplayedRecPtr()
+{
+    XLogRecPtr minEnd = MAX_XLOG_REC_PTR;
+    for (uint32 i = 0; i < g_dispatcher->allWorkersCnt; ++i) {
+        if (g_dispatcher->allWorkers[i]->role == REDO_PAGE_WORKER) {
+            XLogRecPtr tmpStart = MAX_XLOG_REC_PTR;
+            XLogRecPtr tmpEnd = MAX_XLOG_REC_PTR;
+            GetCompletedReadEndPtr(g_dispatcher->allWorkers[i], &tmpStart, &tmpEnd);
+            if (XLByteLT(tmpEnd, minEnd)) {
+                minEnd = tmpEnd;
+            }
+        }
+    }
+    return minEnd;
+}
+
 RedoWaitInfo redo_get_io_event(int32 event_id)
 {
     WaitStatisticsInfo *tmpStatics = NULL;
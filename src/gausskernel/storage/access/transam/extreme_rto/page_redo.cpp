@@ -194,6 +194,7 @@ PageRedoWorker *CreateWorker(uint32 id)
     worker->index = 0;
     worker->tid.thid = InvalidTid;
     worker->proc = NULL;
+    worker->bufferPinWaitBufId = -1;
     worker->initialServerMode = (ServerMode)t_thrd.xlog_cxt.server_mode;
     worker->initialTimeLineID = t_thrd.xlog_cxt.ThisTimeLineID;
     worker->expectedTLIs = t_thrd.xlog_cxt.expectedTLIs;
@@ -932,6 +933,28 @@ static void WaitNextBarrier(XLogRecParseState *parseState)
     }
 }
 
+/*
+ * Cancel the standby queries that can still see the tuples a cleanup record removes.
+ * The data blocks of the record are distributed to the page workers only after the
+ * whole batch is parsed, so the conflict is resolved before the cleanup is applied.
+ */
+static void PageManagerResolveSnapshotConflict(XLogRecParseState *preState)
+{
+    if (g_redoWorker->standbyState >= STANDBY_SNAPSHOT_READY) {
+        XLogBlockHead *blockhead = &preState->blockparse.blockhead;
+        RelFileNode rnode;
+
+        rnode.spcNode = XLogBlockHeadGetSpcNode(blockhead);
+        rnode.dbNode = XLogBlockHeadGetDbNode(blockhead);
+        rnode.relNode = XLogBlockHeadGetRelNode(blockhead);
+        rnode.bucketNode = XLogBlockHeadGetBucketId(blockhead);
+        rnode.opt = 0;
+        ResolveRecoveryConflictWithSnapshot(preState->blockparse.extra_rec.blockinvalidmsg.cutoffxid, rnode,
+                                            XLogBlockHeadGetLSN(blockhead));
+    }
+    XLogBlockParseStateRelease(preState);
+}
+
 void PageManagerRedoParseState(XLogRecParseState *preState)
 {
     HTAB *hashMap = g_dispatcher->pageLines[g_redoWorker->slotId].managerThd->redoItemHash;
@@ -1003,6 +1026,9 @@ void PageManagerRedoParseState(XLogRecParseState *preState)
             RedoPageManagerDistributeBlockRecord(hashMap, preState);
             WaitNextBarrier(preState);
             break;
+        case BLOCK_DATA_INVALIDMSG_TYPE:
+            PageManagerResolveSnapshotConflict(preState);
+            break;
         default:
             XLogBlockParseStateRelease(preState);
             break;
@@ -1249,6 +1275,42 @@ bool CheckFullSyncCheckpoint(RedoItem *item)
     return false;
 }
 
+static inline bool IsXactCommitInfo(RmgrId rmid, uint8 info)
+{
+    if (rmid != RM_XACT_ID) {
+        return false;
+    }
+
+    info &= ~XLR_INFO_MASK;
+    return (info == XLOG_XACT_COMMIT || info == XLOG_XACT_COMMIT_PREPARED || info == XLOG_XACT_COMMIT_COMPACT);
+}
+
+static inline bool IsXactCommitRecord(XLogReaderState *record)
+{
+    return IsXactCommitInfo(XLogRecGetRmid(record), XLogRecGetInfo(record));
+}
+
+/*
+ * Hot standby queries take their snapshot from the transactions replayed by this
+ * worker, while the page workers apply the data pages asynchronously. Hold a commit
+ * back until every page worker has passed it, so a query that sees the transaction
+ * as committed also finds its changes on the pages. Commits that drop relation files
+ * are already synchronized with the page pipelines by the managers and the dispatcher.
+ */
+static void TrxnWaitPageReplayedForCommit(RedoItem *item)
+{
+    XLogReaderState *record = &item->record;
+
+    if (!g_instance.attr.attr_storage.EnableHotStandby || g_redoWorker->standbyState < STANDBY_SNAPSHOT_READY ||
+        !IsXactCommitRecord(record) || XactWillRemoveRelFiles(record)) {
+        return;
+    }
+
+    while (XLByteLT(GetPageReplayedRecPtr(), record->ReadRecPtr)) {
+        RedoInterruptCallBack();
+    }
+}
+
 void TrxnWorkMain()
 {
 #ifdef ENABLE_MOT
@@ -1280,6 +1342,7 @@ void TrxnWorkMain()
             t_thrd.xlog_cxt.needImmediateCkp = item->needImmediateCheckpoint;
             bool fullSync = item->record.isFullSync;
             GetRedoStartTime(g_redoWorker->timeCostList[TIME_COST_STEP_3]);
+            TrxnWaitPageReplayedForCommit(item);
             ApplySinglePageRecord(item);
             CountAndGetRedoTime(g_redoWorker->timeCostList[TIME_COST_STEP_3],
                 g_redoWorker->timeCostList[TIME_COST_STEP_4]);
@@ -1516,6 +1579,9 @@ void RedoPageWorkerMain()
         updateFsm = XlogNeedUpdateFsm(redoblockstateHead, &bufferinfo);
         bool needWait = redoblockstateHead->isFullSync;
         if (needWait) {
+            /* everything before the record is applied, publish it for the trxn worker we wait on */
+            SetCompletedReadEndPtr(g_redoWorker, redoblockstateHead->blockparse.blockhead.start_ptr,
+                                   redoblockstateHead->blockparse.blockhead.end_ptr);
             pg_atomic_write_u32(&g_redoWorker->fullSyncFlag, 1);
         }
         XLogBlockParseStateRelease(redoblockstateHead);
@@ -1581,9 +1647,28 @@ static inline bool ReadPageWorkerStop()
     return g_dispatcher->recoveryStop;
 }
 
+/*
+ * A commit read under hot standby waits in the trxn worker until all page workers
+ * passed it. Page workers only move on with records or LSN forwarders, so one is
+ * sent as soon as the previous forwarder is done, see PushToWorkerLsn.
+ */
+static bool g_commitForwardPending = false;
+
+static inline void NoteCommitForForwarder(const XLogRecord *record)
+{
+    if (g_instance.attr.attr_storage.EnableHotStandby && IsXactCommitInfo(record->xl_rmid, record->xl_info)) {
+        g_commitForwardPending = true;
+    }
+}
+
 void PushToWorkerLsn(bool force)
 {
-    const uint32 max_record_count = PAGE_WORK_QUEUE_SIZE;
+    /*
+     * Commits wait for the page workers under hot standby, forward the LSN more
+     * often so they become visible quickly and never wait on a full trxn queue.
+     */
+    const uint32 max_record_count = g_instance.attr.attr_storage.EnableHotStandby ?
+        HOT_STANDBY_LSN_FORWARD_INTERVAL : PAGE_WORK_QUEUE_SIZE;
     static uint32 cur_recor_count = 0;
 
     cur_recor_count++;
@@ -1599,16 +1684,18 @@ void PushToWorkerLsn(bool force)
             RedoInterruptCallBack();
         } while (refCount != 0 && !ReadPageWorkerStop());
         cur_recor_count = 0;
+        g_commitForwardPending = false;
         SendLsnFowarder();
     } else {
         uint32 refCount = pg_atomic_read_u32(&g_GlobalLsnForwarder.record.refcount);
 
-        if (refCount != 0 || cur_recor_count < max_record_count) {
+        if (refCount != 0 || (cur_recor_count < max_record_count && !g_commitForwardPending)) {
             return;
         }
 
         SendLsnFowarder();
         cur_recor_count = 0;
+        g_commitForwardPending = false;
     }
 }
 
@@ -1975,6 +2062,7 @@ void XLogReadPageWorkerMain()
         if (ReadPageWorkerStop()) {
             break;
         }
+        NoteCommitForForwarder(record);
         GetRedoStartTime(g_redoWorker->timeCostList[TIME_COST_STEP_3]);
         XLogReaderState *newxlogreader = NewReaderState(xlogreader);
         CountAndGetRedoTime(g_redoWorker->timeCostList[TIME_COST_STEP_3], g_redoWorker->timeCostList[TIME_COST_STEP_4]);
@@ -136,6 +136,33 @@ void MultiRedoUpdateStandbyState(HotStandbyState newState)
     }
 }
 
+/* The redo threads waiting for a cleanup lock, for the buffer pin recovery conflicts */
+void MultiRedoSetBufferPinWaitBufId(int bufid)
+{
+    if (IsExtremeRedo()) {
+        extreme_rto::SetStartupBufferPinWaitBufId(bufid);
+    } else {
+        parallel_recovery::SetStartupBufferPinWaitBufId(bufid);
+    }
+}
+
+uint32 MultiRedoGetBufferPinWaitBufLen()
+{
+    if (IsExtremeRedo()) {
+        return extreme_rto::GetStartupBufferPinWaitBufLen();
+    }
+    return parallel_recovery::GetStartupBufferPinWaitBufLen();
+}
+
+void MultiRedoGetBufferPinWaitBufId(int *bufids, uint32 len)
+{
+    if (IsExtremeRedo()) {
+        extreme_rto::GetStartupBufferPinWaitBufId(bufids, len);
+    } else {
+        parallel_recovery::GetStartupBufferPinWaitBufId(bufids, len);
+    }
+}
+
 uint32 MultiRedoGetWorkerId()
 {
     if (IsExtremeRedo()) {
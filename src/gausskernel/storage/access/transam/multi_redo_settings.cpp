@@ -56,7 +56,8 @@ void ConfigRecoveryParallelism()
                              g_instance.attr.attr_storage.recovery_parse_workers,
                              g_instance.attr.attr_storage.recovery_redo_workers_per_paser_worker,
                              total_recovery_parallelism)));
-        g_supportHotStandby = false;
+        /* page managers resolve the snapshot conflicts of cleanup records for hot standby queries */
+        g_supportHotStandby = g_instance.attr.attr_storage.EnableHotStandby;
         SetConfigOption("recovery_parallelism", buf, PGC_POSTMASTER, PGC_S_OVERRIDE);
     } else if (g_instance.attr.attr_storage.max_recovery_parallelism > 1) {
         g_instance.comm_cxt.predo_cxt.redoType = PARALLEL_REDO;
@@ -223,6 +223,7 @@ struct TransactionStateData {
                                                           * parent if any */
     bool perform_undo;
     bool  subXactLock;
+    bool topXidLogged; /* has the toplevel xid been included in a WAL record of this subxact? */
 };
 
 /*
@@ -800,6 +801,40 @@ void MarkCurrentTransactionIdLoggedIfAny(void)
         CurrentTransactionState->didLogXid = true;
 }
 
+/*
+ * IsSubTransactionAssignmentPending
+ *
+ * With wal_level=logical the first WAL record of a subtransaction carries the
+ * toplevel xid, so logical decoding knows which toplevel transaction the
+ * subtransaction belongs to before its first change. That is what allows
+ * decoding to stream large in-progress transactions.
+ */
+bool IsSubTransactionAssignmentPending(void)
+{
+    if (!XLogLogicalInfoActive() || !IsSubTransaction()) {
+        return false;
+    }
+
+    /* no xid, nothing to assign */
+    if (!TransactionIdIsValid(GetCurrentTransactionIdIfAny())) {
+        return false;
+    }
+
+    return !CurrentTransactionState->topXidLogged;
+}
+
+/*
+ * MarkSubTransactionAssigned
+ *
+ * Remember that the toplevel xid has been logged for the current subtransaction.
+ */
+void MarkSubTransactionAssigned(void)
+{
+    Assert(IsSubTransactionAssignmentPending());
+
+    CurrentTransactionState->topXidLogged = true;
+}
+
 /*
  * @Description: set the didLogXid of the current transaction state to true.
  * @out state: the current transaction state.
@@ -952,8 +987,13 @@ static void AssignTransactionId(TransactionState s)
 
         /*
          * ensure this test matches similar one in RecoverPreparedTransactions()
+         *
+         * With wal_level=logical the first WAL record of the subtransaction
+         * carries the toplevel xid. Until the cluster is upgraded to a binary
+         * that reads it, the assignment is logged right away instead.
          */
-        if (t_thrd.xact_cxt.nUnreportedXids >= PGPROC_MAX_CACHED_SUBXIDS || log_unknown_top) {
+        if (t_thrd.xact_cxt.nUnreportedXids >= PGPROC_MAX_CACHED_SUBXIDS || log_unknown_top ||
+            (XLogLogicalInfoActive() && t_thrd.proc->workingVersionNum < TOPLEVEL_XID_WAL_VERSION_NUM)) {
             xl_xact_assignment xlrec;
 
             /*
@@ -3191,6 +3191,11 @@ void XLogWaitFlush(XLogRecPtr recptr)
 
     volatile XLogRecPtr flushTo = gs_compare_and_swap_u64(&g_instance.wal_cxt.flushResult, 0, 0);
 
+    /* Tell the flusher one more commit is waiting, see XLogFlushWaitWindow() */
+    if (XLByteLT(flushTo, recptr)) {
+        (void)pg_atomic_fetch_add_u32(&g_instance.wal_cxt.walWaitFlushCount, 1);
+    }
+
     while (XLByteLT(flushTo, recptr)) {
         if (!g_instance.wal_cxt.isWalWriterUp) {
             XLogSelfFlush();
@@ -3220,8 +3225,71 @@ void XLogWaitBufferInit(XLogRecPtr recptr)
     return;
 }
 
+static inline int XLogFlushHistBucket(uint64 value)
+{
+    int bucket = 0;
+
+    while (value != 0 && bucket < XLOG_FLUSH_HIST_BUCKETS - 1) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+/*
+ * Account one flush in the flush histograms and the flush time estimate.
+ * Caller holds WALWriteLock, so there is a single writer.
+ */
+static void XLogRecordFlushStat(uint64 flushTime, uint64 flushBytes, uint32 waiters)
+{
+    XlogFlushStatistics *stats = g_instance.wal_cxt.xlogFlushStats;
+    const uint64 estimateWeight = 8;
+
+    stats->flushTimeHist[XLogFlushHistBucket(flushTime)]++;
+    stats->flushBytesHist[XLogFlushHistBucket(flushBytes)]++;
+    stats->flushWaitersHist[XLogFlushHistBucket(waiters)]++;
+
+    if (stats->flushTimeEstimate == 0) {
+        stats->flushTimeEstimate = flushTime;
+    } else {
+        stats->flushTimeEstimate =
+            stats->flushTimeEstimate - stats->flushTimeEstimate / estimateWeight + flushTime / estimateWeight;
+    }
+}
+
+/*
+ * How long XLogBackgroundFlush() may hold a flush back while later records
+ * are still being copied.
+ *
+ * By default that is wal_flush_timeout. With wal_flush_max_window set and
+ * several commits waiting, the flush is held for up to half of a recent
+ * flush instead: the first committer pays at most that much, while every
+ * commit arriving meanwhile shares this fsync rather than queueing for the
+ * next one.
+ */
+static uint64 XLogFlushWaitWindow(bool *adaptive)
+{
+    uint64 window = (uint64)g_instance.attr.attr_storage.wal_flush_timeout;
+
+    *adaptive = false;
+    if (g_instance.attr.attr_storage.wal_flush_max_window > 0 &&
+        pg_atomic_read_u32(&g_instance.wal_cxt.walWaitFlushCount) > 1) {
+        uint64 halfFlush = g_instance.wal_cxt.xlogFlushStats->flushTimeEstimate / 2;
+
+        window = Max(window, Min(halfFlush, (uint64)g_instance.attr.attr_storage.wal_flush_max_window));
+        *adaptive = true;
+    }
+    return window;
+}
+
 static void XLogFlushCore(XLogRecPtr writeRqstPtr)
 {
+    XLogRecPtr oldFlush = t_thrd.shemem_ptr_cxt.XLogCtl->LogwrtResult.Flush;
+    uint32 waiters = pg_atomic_exchange_u32(&g_instance.wal_cxt.walWaitFlushCount, 0);
+    instr_time startTime;
+    instr_time endTime;
+
+    INSTR_TIME_SET_CURRENT(startTime);
     START_CRIT_SECTION();
 
     XLogwrtRqst WriteRqst;
@@ -3231,6 +3299,12 @@ static void XLogFlushCore(XLogRecPtr writeRqstPtr)
     XLogWrite(WriteRqst, false);
     END_CRIT_SECTION();
 
+    INSTR_TIME_SET_CURRENT(endTime);
+    INSTR_TIME_SUBTRACT(endTime, startTime);
+    if (XLByteLT(oldFlush, t_thrd.xlog_cxt.LogwrtResult->Flush)) {
+        XLogRecordFlushStat(INSTR_TIME_GET_MICROSEC(endTime), t_thrd.xlog_cxt.LogwrtResult->Flush - oldFlush, waiters);
+    }
+
     pg_memory_barrier();
 
     /* wake up walsenders now that we've released heavily contended locks */
@@ -3329,6 +3403,13 @@ bool XLogBackgroundFlush(void)
     uint64 averageXlogFlushBytes = (totalXlogIterTimes == 0) ? 0 : totalXlogIterBytes / totalXlogIterTimes;
     uint64 curAverageXlogFlushBytes = (averageXlogFlushBytes == 0) ? XLOG_FLUSH_SIZE_INIT :
                                       (averageXlogFlushBytes / PAGE_SIZE_BYTES + 1) * PAGE_SIZE_BYTES;
+
+    /*
+     * Under a commit storm the average flush is small, so the size target
+     * would cut every batch short. The adaptive window alone decides then.
+     */
+    bool adaptiveWindow = false;
+    uint64 flushWaitWindow = XLogFlushWaitWindow(&adaptiveWindow);
     do {
         curr_entry_ptr = next_entry_ptr;
         curr_entry_idx = next_entry_idx;
@@ -3357,8 +3438,8 @@ bool XLogBackgroundFlush(void)
          * an entry associated with the first uncopied record found in the current loop.
          */
         if (next_entry_ptr->status == WAL_NOT_COPIED) {
-            if (((curr_entry_ptr->endLSN - startLSN) > curAverageXlogFlushBytes) ||
-                (GetCurrentTimestamp() - stTime >= (uint64)g_instance.attr.attr_storage.wal_flush_timeout)) {
+            if ((!adaptiveWindow && (curr_entry_ptr->endLSN - startLSN) > curAverageXlogFlushBytes) ||
+                (GetCurrentTimestamp() - stTime >= flushWaitWindow)) {
                 break;
             }
             pg_usleep(g_instance.attr.attr_storage.wal_flush_delay);
@@ -16394,13 +16475,17 @@ int ParallelXLogReadWorkBufRead(XLogReaderState *xlogreader, XLogRecPtr targetPa
                 SwitchToReadXlogFromFile(targetPagePtr);
                 return -1;
             }
+            /*
+             * Forward the LSN before going idle, so commits already read do not
+             * wait for more WAL to become visible to hot standby queries.
+             */
+            extreme_rto::PushToWorkerLsn(waitXLogCount == pushLsnCount);
+            ++waitXLogCount;
             /*
              * Wait for more WAL to arrive, or timeout to be reached
              */
             WaitLatch(&t_thrd.shemem_ptr_cxt.XLogCtl->recoveryWakeupLatch, WL_LATCH_SET | WL_TIMEOUT, 1000L);
             ResetLatch(&t_thrd.shemem_ptr_cxt.XLogCtl->recoveryWakeupLatch);
-            extreme_rto::PushToWorkerLsn(waitXLogCount == pushLsnCount);
-            ++waitXLogCount;
         }
 
         RedoInterruptCallBack();
@@ -63,13 +63,14 @@ typedef struct registered_buffer {
 } registered_buffer;
 
 #define SizeOfXlogOrigin (sizeof(RepOriginId) + sizeof(char))
+#define SizeOfXLogTransactionId (sizeof(TransactionId) + sizeof(char))
 
 #define HEADER_SCRATCH_SIZE \
     (SizeOfXLogRecord + MaxSizeOfXLogRecordBlockHeader * (XLR_MAX_BLOCK_ID + 1) + \
-    SizeOfXLogRecordDataHeaderLong + SizeOfXlogOrigin)
+    SizeOfXLogRecordDataHeaderLong + SizeOfXlogOrigin + SizeOfXLogTransactionId)
 
 static XLogRecData *XLogRecordAssemble(RmgrId rmid, uint8 info, XLogFPWInfo fpw_info, XLogRecPtr *fpw_lsn,
-                                       int bucket_id = -1, bool istoast = false);
+                                       int bucket_id = -1, bool istoast = false, bool *topxid_included = NULL);
 static void XLogResetLogicalPage(void);
 
 /*
@@ -528,6 +529,8 @@ XLogRecPtr XLogInsert(RmgrId rmid, uint8 info, int bucket_id, bool istoast)
         return EndPos;
     }
 
+    bool topxid_included = false;
+
     do {
         XLogRecPtr fpw_lsn;
         XLogFPWInfo fpw_info;
@@ -540,11 +543,16 @@ XLogRecPtr XLogInsert(RmgrId rmid, uint8 info, int bucket_id, bool istoast)
          */
         GetFullPageWriteInfo(&fpw_info);
 
-        rdt = XLogRecordAssemble(rmid, info, fpw_info, &fpw_lsn, bucket_id, istoast);
+        rdt = XLogRecordAssemble(rmid, info, fpw_info, &fpw_lsn, bucket_id, istoast, &topxid_included);
 
         EndPos = XLogInsertRecord(rdt, fpw_lsn);
     } while (XLByteEQ(EndPos, InvalidXLogRecPtr));
 
+    /* the toplevel xid of the subtransaction is in WAL now, see XLogRecordAssemble */
+    if (topxid_included) {
+        MarkSubTransactionAssigned();
+    }
+
     /*
      * too much log may slow down the speed of xlog, so only write log
      * when log level belows DEBUG4
@@ -675,7 +683,7 @@ static bool XLogNeedVMPhysicalLocation(RmgrId rmi, uint8 info, int blockId)
  * 
  */
 static XLogRecData *XLogRecordAssemble(RmgrId rmid, uint8 info, XLogFPWInfo fpw_info, XLogRecPtr *fpw_lsn,
-    int bucket_id, bool istoast)
+    int bucket_id, bool istoast, bool *topxid_included)
 {
     XLogRecData *rdt = NULL;
     uint32 total_len = 0;
@@ -962,6 +970,29 @@ static XLogRecData *XLogRecordAssemble(RmgrId rmid, uint8 info, XLogFPWInfo fpw_
         XLOG_ASSEMBLE_ONE_ITEM(scratch, sizeof(m_session_id), &m_session_id, remained_size);
     }
 
+    /*
+     * followed by the toplevel xid, on the first record of a subtransaction
+     * under wal_level=logical, so logical decoding learns about the
+     * subtransaction before its first change. UHeap records carry the
+     * toplevel xid as xl_xid anyway. Older binaries cannot read this block
+     * id, they get an XLOG_XACT_ASSIGNMENT record instead, see
+     * AssignTransactionId.
+     */
+    if (topxid_included != NULL) {
+        *topxid_included = false;
+        bool isUHeapRecord = (rmid >= RM_UHEAP_ID) && (rmid <= RM_UHEAPUNDO_ID);
+        if (!isUHeapRecord && IsSubTransactionAssignmentPending() &&
+            t_thrd.proc->workingVersionNum >= TOPLEVEL_XID_WAL_VERSION_NUM) {
+            TransactionId xid = GetTopTransactionIdIfAny();
+
+            Assert(remained_size > 0);
+            *(scratch++) = XLR_BLOCK_ID_TOPLEVEL_XID;
+            remained_size--;
+            XLOG_ASSEMBLE_ONE_ITEM(scratch, sizeof(TransactionId), &xid, remained_size);
+            *topxid_included = true;
+        }
+    }
+
     /* followed by main data, if any */
     if (t_thrd.xlog_cxt.mainrdata_len > 0) {
         if (t_thrd.xlog_cxt.mainrdata_len > 255) {
@@ -979,6 +979,7 @@ bool DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errorms
 
     state->decoded_record = record;
     state->record_origin = InvalidRepOriginId;
+    state->toplevel_xid = InvalidTransactionId;
 
     ptr = (char *)record;
     ptr += SizeOfXLogRecord;
@@ -1022,6 +1023,13 @@ bool DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errorms
             ptr += sizeof(RepOriginId);
             remaining -= sizeof(RepOriginId);
 
+        } else if (block_id == XLR_BLOCK_ID_TOPLEVEL_XID) {
+            if (remaining < sizeof(TransactionId))
+                goto shortdata_err;
+            errno_t rc = memcpy_s(&state->toplevel_xid, sizeof(TransactionId), ptr, sizeof(TransactionId));
+            securec_check(rc, "", "");
+            ptr += sizeof(TransactionId);
+            remaining -= sizeof(TransactionId);
         } else if (BKID_GET_BKID(block_id) <= XLR_MAX_BLOCK_ID) {
             /* XLogRecordBlockHeader */
             DecodedBkpBlock *blk = NULL;
@@ -1081,7 +1089,7 @@ bool DecodeXLogRecord(XLogReaderState *state, XLogRecord *record, char **errorms
                 blk->rnode.bucketNode = InvalidBktId;
                 blk->rnode.opt = 0;
                 errno_t rc = memcpy_s(&blk->rnode, filenodelen, ptr, filenodelen);
-                securec_check(rc, "\0", "\0");
+                securec_check(rc, "", "");
                 /* support decode old version of relfileNode */
                 CompressTableRecord(&blk->rnode);
                 ptr += filenodelen;
@@ -376,6 +376,7 @@ Datum ubtbeginscan(PG_FUNCTION_ARGS)
     /* allocate private workspace */
     so = (BTScanOpaque)palloc(sizeof(BTScanOpaqueData));
     so->currPos.buf = so->markPos.buf = InvalidBuffer;
+    _bt_initscanpos(so);
     if (scan->numberOfKeys > 0) {
         so->keyData = (ScanKey)palloc(scan->numberOfKeys * sizeof(ScanKeyData));
     } else {
@@ -522,6 +523,8 @@ Datum ubtendscan(PG_FUNCTION_ARGS)
     }
     FREE_POINTER(so->killedItems);
     FREE_POINTER(so->currTuples);
+    pfree(so->currPos.items);
+    pfree(so->markPos.items);
 
     FREE_POINTER(so->lastSelfModifiedItup);
     if (so->fakeEstate != NULL) {
@@ -602,14 +605,10 @@ Datum ubtrestrpos(PG_FUNCTION_ARGS)
         if (BTScanPosIsValid(so->markPos)) {
             /* bump pin on mark buffer for assignment to current buffer */
             IncrBufferRefCount(so->markPos.buf);
-            errno_t rc = memcpy_s(&so->currPos,
-                                  offsetof(BTScanPosData, items[1]) + so->markPos.lastItem * sizeof(BTScanPosItem),
-                                  &so->markPos,
-                                  offsetof(BTScanPosData, items[1]) + so->markPos.lastItem * sizeof(BTScanPosItem));
-            securec_check(rc, "", "");
+            _bt_copyscanpos(so, &so->currPos, &so->markPos);
             if (so->currTuples) {
-                rc = memcpy_s(so->currTuples, (size_t)so->markPos.nextTupleOffset, so->markTuples,
-                              (size_t)so->markPos.nextTupleOffset);
+                errno_t rc = memcpy_s(so->currTuples, (size_t)so->markPos.nextTupleOffset, so->markTuples,
+                                      (size_t)so->markPos.nextTupleOffset);
                 securec_check(rc, "", "");
             }
         }
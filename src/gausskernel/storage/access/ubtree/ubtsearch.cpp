@@ -1382,13 +1382,10 @@ static bool UBTreeStepPage(IndexScanDesc scan, ScanDirection dir)
     if (so->markItemIndex >= 0) {
         /* bump pin on current buffer for assignment to mark buffer */
         IncrBufferRefCount(so->currPos.buf);
-        errno_t rc =
-            memcpy_s(&so->markPos, offsetof(BTScanPosData, items[1]) + so->currPos.lastItem * sizeof(BTScanPosItem),
-                &so->currPos, offsetof(BTScanPosData, items[1]) + so->currPos.lastItem * sizeof(BTScanPosItem));
-        securec_check(rc, "", "");
+        _bt_copyscanpos(so, &so->markPos, &so->currPos);
         if (so->markTuples) {
-            rc = memcpy_s(so->markTuples, (size_t)so->currPos.nextTupleOffset, so->currTuples,
-                          (size_t)so->currPos.nextTupleOffset);
+            errno_t rc = memcpy_s(so->markTuples, (size_t)so->currPos.nextTupleOffset, so->currTuples,
+                                  (size_t)so->currPos.nextTupleOffset);
             securec_check(rc, "", "");
         }
         so->markPos.itemIndex = so->markItemIndex;
@@ -27,6 +27,10 @@
 #include "postmaster/bgwriter.h"
 #include "utils/palloc.h"
 
+#ifdef __USE_NUMA
+#include <numa.h>
+#endif
+
 const int PAGE_QUEUE_SLOT_MULTI_NBUFFERS = 5;
 
 /*
@@ -60,6 +64,41 @@ const int PAGE_QUEUE_SLOT_MULTI_NBUFFERS = 5;
  *		shared refcount isn't increased if a individual backend pins a buffer
  *		multiple times. Check the PrivateRefCount infrastructure in bufmgr.c.
  */
+#ifdef __USE_NUMA
+/* Bind the whole pages inside [addr, addr + len) to a NUMA node */
+static void BindMemoryToNumaNode(char *addr, Size len, int node)
+{
+    Size page_size = (Size)sysconf(_SC_PAGESIZE);
+    uintptr_t start = TYPEALIGN(page_size, (uintptr_t)addr);
+    uintptr_t end = TYPEALIGN_DOWN(page_size, (uintptr_t)addr + len);
+
+    if (end > start) {
+        numa_tonode_memory((void *)start, end - start, node);
+    }
+}
+
+/*
+ * Place the pages and descriptors of each NUMA buffer pool on its node. This
+ * must run before the memory is first touched, the kernel allocates the
+ * physical pages on the bound node at the first fault.
+ */
+static void BindBufferPoolsToNuma(void)
+{
+    int num_pools = StrategyNumPools();
+
+    for (int pool = 0; pool < num_pools; pool++) {
+        int first_buf;
+        int num_bufs;
+
+        StrategyPoolRange(pool, &first_buf, &num_bufs);
+        BindMemoryToNumaNode(t_thrd.storage_cxt.BufferBlocks + (Size)first_buf * BLCKSZ, (Size)num_bufs * BLCKSZ,
+                             pool);
+        BindMemoryToNumaNode((char *)GetBufferDescriptor(first_buf), (Size)num_bufs * sizeof(BufferDescPadded),
+                             pool);
+    }
+}
+#endif
+
 /*
  * Initialize shared buffer pool
  *
@@ -136,6 +175,12 @@ void InitBufferPool(void)
     } else {
         int i;
 
+#ifdef __USE_NUMA
+        if (StrategyNumPools() > 1) {
+            BindBufferPoolsToNuma();
+        }
+#endif
+
         /*
          * Initialize all the buffer headers.
          */
@@ -63,6 +63,7 @@
 #include "storage/proc.h"
 #include "storage/smgr/segment.h"
 #include "storage/standby.h"
+#include "storage/uring.h"
 #include "utils/aiomem.h"
 #include "utils/guc.h"
 #include "utils/plog.h"
@@ -372,6 +373,7 @@ extern void PageListBackWrite(
 #ifndef ENABLE_LITE_MODE
 static volatile BufferDesc* PageListBufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
                                                 BlockNumber blockNum, BufferAccessStrategy strategy, bool* foundPtr);
+static void PageListPrefetchUring(Relation reln, ForkNumber forkNum, BlockNumber* blockList, int32 n);
 #endif
 static bool ConditionalStartBufferIO(BufferDesc* buf, bool forInput);
 
@@ -850,8 +852,14 @@ void PageListPrefetch(Relation reln, ForkNumber fork_num, BlockNumber *block_lis
     AioDispatchDesc_t **dis_list; /* AIO dispatch list */
     bool is_local_buf = false;    /* local buf flag */
 
-    /* Exit without complaint, if there is no completer started yet */
+    /*
+     * Exit without complaint, if there is no completer started yet,
+     * unless the list can be read through io_uring instead.
+     */
     if (AioCompltrIsReady() == false) {
+        if (u_sess->attr.attr_storage.enable_uring_prefetch) {
+            PageListPrefetchUring(reln, fork_num, block_list, n);
+        }
         return;
     }
 
@@ -999,6 +1007,145 @@ void PageListPrefetch(Relation reln, ForkNumber fork_num, BlockNumber *block_lis
 #endif
 }
 
+#ifndef ENABLE_LITE_MODE
+/*
+ * @Description: read the buffers collected by PageListPrefetchUring() and
+ * release them.  On entry they are pinned, marked IO_IN_PROGRESS and their
+ * io_in_progress_lock is held.
+ * @Param[IN] smgr: smgr relation
+ * @Param[IN] fork_num: fork Num
+ * @Param[IN] count: buffer count
+ * @See also:
+ */
+static void PageListUringReadBatch(SMgrRelation smgr, ForkNumber fork_num, int count)
+{
+    BufferDesc **buf_list = t_thrd.storage_cxt.InProgressUringBufs;
+    BlockNumber *block_list = (BlockNumber *)palloc(sizeof(BlockNumber) * count);
+    char **block_ptrs = (char **)palloc(sizeof(char *) * count);
+    bool *read_ok = (bool *)palloc(sizeof(bool) * count);
+    bool batched = false;
+
+    for (int i = 0; i < count; i++) {
+        block_list[i] = buf_list[i]->tag.blockNum;
+        block_ptrs[i] = (char *)BufHdrGetBlock(buf_list[i]);
+    }
+
+    batched = smgrreadbatch(smgr, fork_num, block_list, block_ptrs, read_ok, count);
+
+    /* Nothing below can fail, the buffers are released in any case */
+    t_thrd.storage_cxt.InProgressUringCount = 0;
+
+    for (int i = 0; i < count; i++) {
+        uint32 set_flag_bits = 0;
+
+        /*
+         * A block that was not read or does not verify is left invalid.
+         * Whoever needs it reads it again, and reports the error if any.
+         */
+        if (batched && read_ok[i] && PageIsVerified((Page)block_ptrs[i], block_list[i])) {
+            PageDataDecryptIfNeed((Page)block_ptrs[i]);
+            set_flag_bits = BM_VALID;
+        }
+        AsyncTerminateBufferIO((void *)buf_list[i], false, set_flag_bits);
+        UnpinBuffer(buf_list[i], true);
+    }
+
+    pfree(block_list);
+    pfree(block_ptrs);
+    pfree(read_ok);
+}
+
+/*
+ * @Description: PageListPrefetch() when the ADIO completers are not running.
+ * The blocks not yet in the buffer pool are read with one io_uring
+ * submission per MAX_PREFETCH_REQSIZ buffers, which works with buffered
+ * data files as well.  Each batch is waited for by this thread, so unlike
+ * the ADIO path no completer thread takes over the buffers.
+ * @Param[IN] reln: relation
+ * @Param[IN] fork_num: fork Num
+ * @Param[IN] block_list: block number list
+ * @Param[IN] n: block count
+ * @See also: PageListPrefetch
+ */
+static void PageListPrefetchUring(Relation reln, ForkNumber fork_num, BlockNumber *block_list, int32 n)
+{
+    SMgrRelation smgr = NULL;
+
+    /* The kernel or the build may not support it, then just skip */
+    if (!UringIsAvailable()) {
+        return;
+    }
+
+    /* Open it at the smgr level if not already done */
+    RelationOpenSmgr(reln);
+    smgr = reln->rd_smgr;
+
+    /* Sorry, no prefetch on local bufs now */
+    if (SmgrIsTemp(smgr)) {
+        return;
+    }
+    if (RELATION_IS_OTHER_TEMP(reln)) {
+        ereport(ERROR,
+                (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("cannot access temporary tables of other sessions")));
+    }
+
+    t_thrd.storage_cxt.InProgressUringBufs = (BufferDesc **)palloc(sizeof(BufferDesc *) * MAX_PREFETCH_REQSIZ);
+    t_thrd.storage_cxt.InProgressUringCount = 0;
+
+    for (int i = 0; i < n; i++) {
+        BufferDesc *buf_desc = NULL;
+        bool found = false;
+
+        /* Should not be extending the relation during prefetch */
+        if (block_list[i] == P_NEW) {
+            continue;
+        }
+
+        /* Make sure we will have room to remember the buffer pin */
+        ResourceOwnerEnlargeBuffers(t_thrd.utils_cxt.CurrentResourceOwner);
+
+        /* Skip blocks that are cached, in progress, or find no clean buffer */
+        buf_desc = (BufferDesc *)PageListBufferAlloc(smgr, reln->rd_rel->relpersistence, fork_num, block_list[i],
+                                                     NULL, &found);
+        if (buf_desc == NULL) {
+            continue;
+        }
+        t_thrd.storage_cxt.InProgressUringBufs[t_thrd.storage_cxt.InProgressUringCount++] = buf_desc;
+
+        if (t_thrd.storage_cxt.InProgressUringCount >= MAX_PREFETCH_REQSIZ) {
+            PageListUringReadBatch(smgr, fork_num, t_thrd.storage_cxt.InProgressUringCount);
+        }
+    }
+
+    if (t_thrd.storage_cxt.InProgressUringCount > 0) {
+        PageListUringReadBatch(smgr, fork_num, t_thrd.storage_cxt.InProgressUringCount);
+    }
+
+    pfree(t_thrd.storage_cxt.InProgressUringBufs);
+    t_thrd.storage_cxt.InProgressUringBufs = NULL;
+}
+#endif
+
+/*
+ * @Description: clean up the buffers of an interrupted io_uring prefetch,
+ * they still hold the io_in_progress_lock unless the locks were already
+ * released.  The pins go with the resource owner.
+ * @See also:
+ */
+static void PageListPrefetchUringAbort(void)
+{
+    BufferDesc **buf_list = t_thrd.storage_cxt.InProgressUringBufs;
+
+    for (int i = 0; i < t_thrd.storage_cxt.InProgressUringCount; i++) {
+        TerminateBufferIO_common(buf_list[i], false, BM_IO_ERROR);
+        if (LWLockHeldByMe(buf_list[i]->io_in_progress_lock)) {
+            LWLockRelease(buf_list[i]->io_in_progress_lock);
+        }
+    }
+    t_thrd.storage_cxt.InProgressUringBufs = NULL;
+    t_thrd.storage_cxt.InProgressUringCount = 0;
+}
+
 /*
  * @Description: aio clean up I/O status for prefetch
  * @See also:
@@ -5673,11 +5820,11 @@ void LockBufferForCleanup(Buffer buffer)
         /* Wait to be signaled by UnpinBuffer() */
         if (InHotStandby && g_supportHotStandby) {
             /* Publish the bufid that Startup process waits on */
-            parallel_recovery::SetStartupBufferPinWaitBufId(buffer - 1);
+            MultiRedoSetBufferPinWaitBufId(buffer - 1);
             /* Set alarm and then wait to be signaled by UnpinBuffer() */
             ResolveRecoveryConflictWithBufferPin();
             /* Reset the published bufid */
-            parallel_recovery::SetStartupBufferPinWaitBufId(-1);
+            MultiRedoSetBufferPinWaitBufId(-1);
 
         } else {
             ProcWaitForSignal();
@@ -5709,9 +5856,9 @@ void LockBufferForCleanup(Buffer buffer)
  */
 bool HoldingBufferPinThatDelaysRecovery(void)
 {
-    uint32 bufLen = parallel_recovery::GetStartupBufferPinWaitBufLen();
+    uint32 bufLen = MultiRedoGetBufferPinWaitBufLen();
     int bufids[MAX_RECOVERY_THREAD_NUM + 1];
-    parallel_recovery::GetStartupBufferPinWaitBufId(bufids, bufLen);
+    MultiRedoGetBufferPinWaitBufId(bufids, bufLen);
 
     for (uint32 i = 0; i < bufLen; i++) {
 
@@ -6090,6 +6237,9 @@ static void TerminateBufferIO_common(BufferDesc *buf, bool clear_dirty, uint32 s
  */
 void AbortAsyncListIO(void)
 {
+    if (t_thrd.storage_cxt.InProgressUringCount > 0) {
+        PageListPrefetchUringAbort();
+    }
     if (t_thrd.storage_cxt.InProgressAioType == AioUnkown) {
         return;
     }
@@ -32,6 +32,39 @@
 
 #define INT_ACCESS_ONCE(var) ((int)(*((volatile int *)&(var))))
 
+/* A NUMA node gets its own buffer pool only when the pool is at least this big */
+#define MIN_BUFFER_POOL_SIZE 1024
+
+/*
+ * Clock sweep state of one buffer pool.
+ *
+ * With numa_buffer_partition on, the normal shared buffers are split into one
+ * contiguous pool per NUMA node. The pages of a pool live on its node, and a
+ * backend sweeps the pool of its own node before it looks at remote pools.
+ * Otherwise there is a single pool covering all normal shared buffers.
+ */
+typedef struct BufferPoolStrategy {
+    /*
+     * Clock sweep hand: index of next buffer to consider grabbing, relative to
+     * firstBuffer. Note that this isn't a concrete buffer - we only ever
+     * increase the value. So, to get an actual buffer, it needs to be used
+     * modulo numBuffers.
+     */
+    pg_atomic_uint32 nextVictimBuffer;
+
+    /* Complete cycles of the clock sweep, protected by buffer_strategy_lock */
+    uint32 completePasses;
+
+    int firstBuffer; /* first buffer id of the pool */
+    int numBuffers;  /* number of buffers in the pool */
+} BufferPoolStrategy;
+
+/* Each pool on its own cache line, the hands are hit by every allocation */
+typedef union BufferPoolStrategyPadded {
+    BufferPoolStrategy pool;
+    char pad[PG_CACHE_LINE_SIZE];
+} BufferPoolStrategyPadded;
+
 /*
  * The shared freelist control information.
  */
@@ -39,18 +72,14 @@ typedef struct BufferStrategyControl {
     /* Spinlock: protects the values below */
     slock_t buffer_strategy_lock;
 
-    /*
-     * Clock sweep hand: index of next buffer to consider grabbing. Note that
-     * this isn't a concrete buffer - we only ever increase the value. So, to
-     * get an actual buffer, it needs to be used modulo NBuffers.
-     */
-    pg_atomic_uint32 nextVictimBuffer;
+    /* Clock sweep state of each pool, see BufferPoolStrategy */
+    int numPools;
+    BufferPoolStrategyPadded* pools;
 
     /*
      * Statistics.	These counters should be wide enough that they can't
      * overflow during a single bgwriter cycle.
      */
-    uint32 completePasses;            /* Complete cycles of the clock sweep */
     pg_atomic_uint32 numBufferAllocs; /* Buffers allocated since last reset */
 
     /*
@@ -100,13 +129,75 @@ static void perform_delay(StrategyDelayStatus *status)
 }
 
 
+/*
+ * StrategyNumPools -- number of buffer pools the normal shared buffers are
+ *		split into
+ *
+ * This only depends on settings fixed at postmaster start, so the pagewriter
+ * can lay out its candidate lists before the strategy control block exists.
+ *
+ * The pools need the incremental checkpoint. Without it the bgwriter cleans
+ * ahead of the clock sweep, see BgBufferSync, and that expects a single hand
+ * moving over all normal buffers.
+ */
+int StrategyNumPools(void)
+{
+    int num_pools = g_instance.shmem_cxt.numaNodeNum;
+
+    if (!g_instance.attr.attr_storage.numa_buffer_partition || !ENABLE_INCRE_CKPT || num_pools <= 1 ||
+        NORMAL_SHARED_BUFFER_NUM / num_pools < MIN_BUFFER_POOL_SIZE) {
+        return 1;
+    }
+    return num_pools;
+}
+
+/*
+ * StrategyPoolRange -- buffer ids covered by a pool
+ *
+ * Pool i serves NUMA node i. The last pool takes the remainder.
+ */
+void StrategyPoolRange(int pool, int* first_buf, int* num_bufs)
+{
+    int num_pools = StrategyNumPools();
+    int avg_num = NORMAL_SHARED_BUFFER_NUM / num_pools;
+
+    Assert(pool >= 0 && pool < num_pools);
+    *first_buf = avg_num * pool;
+    *num_bufs = avg_num;
+    if (pool == num_pools - 1) {
+        *num_bufs += NORMAL_SHARED_BUFFER_NUM % num_pools;
+    }
+}
+
+/*
+ * StrategyLocalPool -- pool of the NUMA node the current thread runs on
+ */
+int StrategyLocalPool(void)
+{
+    int num_pools = t_thrd.storage_cxt.StrategyControl->numPools;
+
+    if (num_pools == 1) {
+        return 0;
+    }
+    return GetCurrentNumaNode() % num_pools;
+}
+
+/* Number of buffers of a pool the clock sweep may hand out */
+static inline int PoolBufferCanUse(BufferPoolStrategy* pool, bool am_standby)
+{
+    if (!am_standby) {
+        return pool->numBuffers;
+    }
+    return Max(int(pool->numBuffers * u_sess->attr.attr_storage.shared_buffers_fraction), 1);
+}
+
 /*
  * ClockSweepTick - Helper routine for StrategyGetBuffer()
  *
- * Move the clock hand one buffer ahead of its current position and return the
- * id of the buffer now under the hand.
+ * Move the clock hand of the pool one buffer ahead of its current position
+ * and return the id of the buffer now under the hand.
  */
-static inline uint32 ClockSweepTick(int max_nbuffer_can_use)
+static inline uint32 ClockSweepTick(BufferPoolStrategy* pool, int max_nbuffer_can_use)
 {
     uint32 victim;
 
@@ -115,7 +206,7 @@ static inline uint32 ClockSweepTick(int max_nbuffer_can_use)
      * doing this, this can lead to buffers being returned slightly out of
      * apparent order.
      */
-    victim = pg_atomic_fetch_add_u32(&t_thrd.storage_cxt.StrategyControl->nextVictimBuffer, 1);
+    victim = pg_atomic_fetch_add_u32(&pool->nextVictimBuffer, 1);
     if (victim >= (uint32)max_nbuffer_can_use) {
         uint32 original_victim = victim;
 
@@ -148,15 +239,14 @@ static inline uint32 ClockSweepTick(int max_nbuffer_can_use)
 
                 wrapped = expected % max_nbuffer_can_use;
 
-                success = pg_atomic_compare_exchange_u32(&t_thrd.storage_cxt.StrategyControl->nextVictimBuffer,
-                                                         &expected, wrapped);
+                success = pg_atomic_compare_exchange_u32(&pool->nextVictimBuffer, &expected, wrapped);
                 if (success)
-                    t_thrd.storage_cxt.StrategyControl->completePasses++;
+                    pool->completePasses++;
                 SpinLockRelease(&t_thrd.storage_cxt.StrategyControl->buffer_strategy_lock);
             }
         }
     }
-    return victim;
+    return pool->firstBuffer + victim;
 }
 
 /*
@@ -176,6 +266,10 @@ static inline uint32 ClockSweepTick(int max_nbuffer_can_use)
  *  buffers and always run the "clock sweep" in shared_buffers_fraction * NBuffers.
  *  If the fraction is too small, we will increase dynamiclly to avoid elog(ERROR)
  *  in `Startup' process because of ERROR will promote to FATAL.
+ *
+ *  With several buffer pools, the clock sweep starts in the pool of the local
+ *  NUMA node and only moves on to the other pools when every buffer of the
+ *  local one is in use.
  */
 BufferDesc* StrategyGetBuffer(BufferAccessStrategy strategy, uint32* buf_state)
 {
@@ -187,6 +281,10 @@ BufferDesc* StrategyGetBuffer(BufferAccessStrategy strategy, uint32* buf_state)
     bool am_standby = RecoveryInProgress();
     StrategyDelayStatus retry_lock_status = { 0, 0 };
     StrategyDelayStatus retry_buf_status = { 0, 0 };
+    int num_pools = t_thrd.storage_cxt.StrategyControl->numPools;
+    int pool_id;
+    int pools_left;
+    BufferPoolStrategy* pool = NULL;
 
     /*
      * If given a strategy object, see whether it can select a buffer. We
@@ -260,14 +358,14 @@ BufferDesc* StrategyGetBuffer(BufferAccessStrategy strategy, uint32* buf_state)
 
 retry:
     /* Nothing on the freelist, so run the "clock sweep" algorithm */
-    if (am_standby)
-        max_buffer_can_use = int(NORMAL_SHARED_BUFFER_NUM * u_sess->attr.attr_storage.shared_buffers_fraction);
-    else
-        max_buffer_can_use = NORMAL_SHARED_BUFFER_NUM;
+    pool_id = StrategyLocalPool();
+    pools_left = num_pools;
+    pool = &t_thrd.storage_cxt.StrategyControl->pools[pool_id].pool;
+    max_buffer_can_use = PoolBufferCanUse(pool, am_standby);
     try_counter = max_buffer_can_use;
     int try_get_loc_times = max_buffer_can_use;
     for (;;) {
-        buf = GetBufferDescriptor(ClockSweepTick(max_buffer_can_use));
+        buf = GetBufferDescriptor(ClockSweepTick(pool, max_buffer_can_use));
         /*
          * If the buffer is pinned, we cannot use it.
          */
@@ -300,6 +398,16 @@ retry:
              */
             UnlockBufHdr(buf, local_buf_state);
 
+            /* Before giving up, sweep the pools of the other NUMA nodes */
+            if (--pools_left > 0) {
+                pool_id = (pool_id + 1) % num_pools;
+                pool = &t_thrd.storage_cxt.StrategyControl->pools[pool_id].pool;
+                max_buffer_can_use = PoolBufferCanUse(pool, am_standby);
+                try_counter = max_buffer_can_use;
+                try_get_loc_times = max_buffer_can_use;
+                continue;
+            }
+
             if (am_standby && u_sess->attr.attr_storage.shared_buffers_fraction < 1.0) {
                 ereport(WARNING, (errmsg("no unpinned buffers available")));
                 u_sess->attr.attr_storage.shared_buffers_fraction =
@@ -336,18 +444,24 @@ retry:
  * the higher-order bits of nextVictimBuffer) and the count of recent buffer
  * allocs if non-NULL pointers are passed.	The alloc count is reset after
  * being read.
+ *
+ * Only the bgwriter calls this, which does not run with several buffer pools,
+ * see StrategyNumPools.
  */
 int StrategySyncStart(uint32 *complete_passes, uint32 *num_buf_alloc)
 {
+    BufferPoolStrategy* pool = &t_thrd.storage_cxt.StrategyControl->pools[0].pool;
     uint32 next_victim_buffer;
     int result;
 
+    Assert(t_thrd.storage_cxt.StrategyControl->numPools == 1);
+
     SpinLockAcquire(&t_thrd.storage_cxt.StrategyControl->buffer_strategy_lock);
-    next_victim_buffer = pg_atomic_read_u32(&t_thrd.storage_cxt.StrategyControl->nextVictimBuffer);
+    next_victim_buffer = pg_atomic_read_u32(&pool->nextVictimBuffer);
     result = next_victim_buffer % TOTAL_BUFFER_NUM;
 
     if (complete_passes != NULL) {
-        *complete_passes = t_thrd.storage_cxt.StrategyControl->completePasses;
+        *complete_passes = pool->completePasses;
         /*
          * Additionally add the number of wraparounds that happened before
          * completePasses could be incremented. C.f. ClockSweepTick().
@@ -400,6 +514,10 @@ Size StrategyShmemSize(void)
     /* size of the shared replacement strategy control block */
     size = add_size(size, MAXALIGN(sizeof(BufferStrategyControl)));
 
+    /* size of the clock sweep state of the buffer pools */
+    size = add_size(size, mul_size(StrategyNumPools(), sizeof(BufferPoolStrategyPadded)));
+    size = add_size(size, PG_CACHE_LINE_SIZE);
+
     return size;
 }
 
@@ -413,6 +531,8 @@ Size StrategyShmemSize(void)
 void StrategyInitialize(bool init)
 {
     bool found = false;
+    bool found_pools = false;
+    int num_pools = StrategyNumPools();
 
     /*
      * Initialize the shared buffer lookup hashtable.
@@ -431,19 +551,39 @@ void StrategyInitialize(bool init)
      */
     t_thrd.storage_cxt.StrategyControl =
         (BufferStrategyControl *)ShmemInitStruct("Buffer Strategy Status", sizeof(BufferStrategyControl), &found);
+    BufferPoolStrategyPadded *pools = (BufferPoolStrategyPadded *)CACHELINEALIGN(ShmemInitStruct(
+        "Buffer Strategy Pools", num_pools * sizeof(BufferPoolStrategyPadded) + PG_CACHE_LINE_SIZE, &found_pools));
 
     if (!found) {
         /*
          * Only done once, usually in postmaster
          */
-        Assert(init);
+        Assert(init && !found_pools);
         SpinLockInit(&t_thrd.storage_cxt.StrategyControl->buffer_strategy_lock);
 
-        /* Initialize the clock sweep pointer */
-        pg_atomic_init_u32(&t_thrd.storage_cxt.StrategyControl->nextVictimBuffer, 0);
+        /* Initialize the clock sweep pointer of each pool */
+        t_thrd.storage_cxt.StrategyControl->numPools = num_pools;
+        t_thrd.storage_cxt.StrategyControl->pools = pools;
+        for (int i = 0; i < num_pools; i++) {
+            BufferPoolStrategy *pool = &pools[i].pool;
+
+            pg_atomic_init_u32(&pool->nextVictimBuffer, 0);
+            pool->completePasses = 0;
+            StrategyPoolRange(i, &pool->firstBuffer, &pool->numBuffers);
+        }
+
+        if (g_instance.attr.attr_storage.numa_buffer_partition) {
+            if (num_pools > 1) {
+                ereport(LOG, (errmsg("shared buffers are split into %d NUMA buffer pools", num_pools)));
+            } else {
+                ereport(WARNING, (errmsg("numa_buffer_partition is ignored, it needs enable_incremental_checkpoint and "
+                                         "numa_distribute_mode \"all\" on a machine with several NUMA nodes and at "
+                                         "least %d buffers per node",
+                                         MIN_BUFFER_POOL_SIZE)));
+            }
+        }
 
         /* Clear statistics */
-        t_thrd.storage_cxt.StrategyControl->completePasses = 0;
         pg_atomic_init_u32(&t_thrd.storage_cxt.StrategyControl->numBufferAllocs, 0);
 
         /* No pending notification */
@@ -712,6 +852,7 @@ static BufferDesc* get_buf_from_candidate_list(BufferAccessStrategy strategy, ui
     int buf_id = 0;
     int list_num = g_instance.ckpt_cxt_ctl->pgwr_procs.sub_num;
     int list_id = 0;
+    int local_pool;
     volatile PgBackendStatus* beentry = t_thrd.shemem_ptr_cxt.MyBEEntry;
     Buffer *candidate_dirty_list = NULL;
     int dirty_list_num = 0;
@@ -726,11 +867,17 @@ static BufferDesc* get_buf_from_candidate_list(BufferAccessStrategy strategy, ui
     }
 
     list_id = beentry->st_tid > 0 ? (beentry->st_tid % list_num) : (beentry->st_sessionid % list_num);
+    local_pool = StrategyLocalPool();
 
-    for (int i = 0; i < list_num; i++) {
+    /* The lists of the local NUMA node's pool go first, then the remote ones */
+    for (int i = 0; i < list_num * 2; i++) {
         /* the pagewriter sub thread store normal buffer pool, sub thread starts from 1 */
         int thread_id = (list_id + i) % list_num + 1;
         Assert(thread_id > 0 && thread_id <= list_num);
+        bool is_local = (g_instance.ckpt_cxt_ctl->pgwr_procs.writer_proc[thread_id].pool_id == local_pool);
+        if (is_local != (i < list_num)) {
+            continue;
+        }
         while (candidate_buf_pop(&buf_id, thread_id)) {
             Assert(buf_id < SegmentBufferStartID);
             buf = GetBufferDescriptor(buf_id);
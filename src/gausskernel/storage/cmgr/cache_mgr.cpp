@@ -105,6 +105,44 @@ int64 CacheMgrCalcSizeByType(MgrCacheType type)
     return cache_size;
 }
 
+/*
+ * @Description: create a ring strategy for bulk scan
+ * @IN ring_size: max number of cache blocks in the ring
+ * @IN max_bytes: max bytes of the cache blocks in the ring
+ * @Return: the strategy, freed by FreeCacheAccessStrategy()
+ * @See also: GetAccessStrategy
+ */
+CacheAccessStrategy GetCacheAccessStrategy(int ring_size, int64 max_bytes)
+{
+    Assert(ring_size > 0 && max_bytes > 0);
+
+    Size slotsSize = MAXALIGN(offsetof(CacheAccessStrategyData, slots) + ring_size * sizeof(CacheSlotId_t));
+    CacheAccessStrategy strategy = (CacheAccessStrategy)palloc(slotsSize + ring_size * sizeof(int));
+    strategy->ring_size = ring_size;
+    strategy->nslots = ring_size;
+    strategy->current = 0;
+    strategy->max_bytes = max_bytes;
+    strategy->ring_bytes = 0;
+    strategy->sizes = (int*)((char*)strategy + slotsSize);
+    for (int i = 0; i < ring_size; ++i) {
+        strategy->slots[i] = CACHE_BLOCK_INVALID_IDX;
+        strategy->sizes[i] = 0;
+    }
+    return strategy;
+}
+
+/*
+ * @Description: free a ring strategy, the blocks of the ring stay in cache
+ * @IN strategy: the strategy to free
+ * @See also:
+ */
+void FreeCacheAccessStrategy(CacheAccessStrategy strategy)
+{
+    if (strategy != NULL) {
+        pfree(strategy);
+    }
+}
+
 /*
  * @Description: init all resource of cache instance
  * @IN cache_size: to tal cache size
@@ -468,18 +506,91 @@ CacheSlotId_t CacheMgr::EvictCacheBlock(int size, int retryNum)
     return slotId;
 }
 
+/*
+ * @Description: get the next block of the ring for reuse. The block must be valid, unpinned,
+ * out of IO, and not used since it was loaded, else the caller puts a new block into the ring.
+ * @IN strategy: ring strategy
+ * @Return: the evicted block with pinned, or CACHE_BLOCK_INVALID_IDX
+ * @See also: GetBufferFromRing
+ */
+CacheSlotId_t CacheMgr::GetRingCacheBlock(CacheAccessStrategy strategy)
+{
+    if (++strategy->current >= strategy->nslots) {
+        strategy->current = 0;
+    }
+
+    CacheSlotId_t slotId = strategy->slots[strategy->current];
+    if (!IsValidCacheSlotID(slotId)) {
+        return CACHE_BLOCK_INVALID_IDX;
+    }
+
+    LockCacheDescHeader(slotId);
+    CacheDesc* desc = m_CacheDesc + slotId;
+    if ((desc->m_flag & CACHE_BLOCK_VALID) && !(desc->m_flag & CACHE_BLOCK_IOBUSY) && desc->m_refcount == 0 &&
+        desc->m_usage_count <= 1 && desc->m_ring_count == 0) {
+        ereport(DEBUG2, (errmodule(MOD_CACHE), errmsg("reuse ring cache block, solt(%d), flag(%d - %d)", slotId,
+                                                      desc->m_flag, CACHE_BLOCK_INFREE)));
+        desc->m_flag = CACHE_BLOCK_INFREE;  // !Valid
+        PinCacheBlock_Locked(slotId);       // Released header lock
+        return slotId;
+    }
+    UnLockCacheDescHeader(slotId);
+
+    return CACHE_BLOCK_INVALID_IDX;
+}
+
+/*
+ * @Description: put a block of the given size into the current slot of the ring. If that makes
+ * the ring exceed its byte budget, the ring ends with this slot and the blocks of the slots
+ * behind it are left to the clock sweep.
+ * @IN strategy: ring strategy
+ * @IN slotId: the block just taken for the scan
+ * @IN size: cache memory size of the block
+ * @See also:
+ */
+void CacheMgr::RememberRingCacheBlock(CacheAccessStrategy strategy, CacheSlotId_t slotId, int size)
+{
+    int current = strategy->current;
+
+    strategy->ring_bytes += size - strategy->sizes[current];
+    strategy->slots[current] = slotId;
+    strategy->sizes[current] = size;
+
+    if (strategy->ring_bytes > strategy->max_bytes && current + 1 < strategy->nslots) {
+        for (int i = current + 1; i < strategy->nslots; ++i) {
+            strategy->ring_bytes -= strategy->sizes[i];
+            strategy->slots[i] = CACHE_BLOCK_INVALID_IDX;
+            strategy->sizes[i] = 0;
+        }
+        strategy->nslots = current + 1;
+        ereport(DEBUG2, (errmodule(MOD_CACHE), errmsg("ring of cache blocks cut to %d blocks, %ld bytes",
+                                                      strategy->nslots, strategy->ring_bytes)));
+    }
+}
+
 /*
  * @Description:  get an Invalid cache block, first try get from free list cache, if without space,
  * second evict from used cache block, if all cache block are using, return error
  * @IN size: cache memory size needed
+ * @IN strategy: ring strategy of bulk scan, NULL for normal access
+ * @OUT evicted: increased by the number of blocks evicted by clock sweep, can be NULL
  * @Return: return valid block index with pinned  or error return
  * @See also:
  */
-CacheSlotId_t CacheMgr::GetFreeCacheBlock(int size)
+CacheSlotId_t CacheMgr::GetFreeCacheBlock(int size, CacheAccessStrategy strategy, int* evicted)
 {
     CacheSlotId_t slotId = CACHE_BLOCK_INVALID_IDX;
     int retryNum = 0;
 
+    /* A bulk scan reuses the blocks of its own ring first */
+    if (strategy != NULL) {
+        slotId = GetRingCacheBlock(strategy);
+        if (IsValidCacheSlotID(slotId)) {
+            RememberRingCacheBlock(strategy, slotId, size);
+            return slotId;
+        }
+    }
+
 RETRY_FIND_FREESPACE:
 
     retryNum++;
@@ -497,6 +608,10 @@ RETRY_FIND_FREESPACE:
 
             PinCacheBlock_Locked(slotId);  // Released header lock
 
+            if (strategy != NULL) {
+                RememberRingCacheBlock(strategy, slotId, size);
+            }
+
             /* purposely returning pinned Invalid slot !!!
              * Returning from here means we have reserved the memory and
              * a new free slot */
@@ -518,6 +633,13 @@ RETRY_FIND_FREESPACE:
         goto RETRY_FIND_FREESPACE;
     }
 
+    if (evicted != NULL) {
+        (*evicted)++;
+    }
+    if (strategy != NULL) {
+        RememberRingCacheBlock(strategy, slotId, size);
+    }
+
     return slotId;
 }
 
@@ -963,10 +1085,13 @@ void CacheMgr::AllocateBlockFromCacheWithSlotId(CacheSlotId_t slotId)
  * @Param[IN/OUT] hasFound: found in cache
  * @Param[IN] hashCode: hash code
  * @Param[IN] size: block size
+ * @Param[IN] strategy: ring strategy of bulk scan, NULL for normal access
+ * @Param[OUT] evicted: number of blocks evicted by clock sweep, can be NULL
  * @Return: block index
  * @See also:
  */
-CacheSlotId_t CacheMgr::AllocateBlockFromCache(CacheTag *cacheTag, uint32 hashCode, int size, bool &hasFound)
+CacheSlotId_t CacheMgr::AllocateBlockFromCache(CacheTag *cacheTag, uint32 hashCode, int size, bool &hasFound,
+    CacheAccessStrategy strategy, int *evicted)
 {
     CacheLookupEnt *result = NULL;
     int old_size = 0;
@@ -976,7 +1101,7 @@ CacheSlotId_t CacheMgr::AllocateBlockFromCache(CacheTag *cacheTag, uint32 hashCo
 
     /* try allocate block from free list */
     while (1) {
-        slot = GetFreeCacheBlock(size);
+        slot = GetFreeCacheBlock(size, strategy, evicted);
         Assert(slot >= 0 && slot <= m_CaccheSlotMax && slot < m_CacheSlotsNum);
         Assert(m_CacheDesc[slot].m_refcount == 1);  // Only ours
 
@@ -1205,15 +1330,18 @@ bool CacheMgr::ReserveCstoreCacheBlockWithSlotId(CacheSlotId_t slotId)
  * @IN cacheTag: block unique identification
  * @OUT hasFound: found in cache
  * @IN size: cache block memory size
+ * @IN strategy: ring strategy of bulk scan, NULL for normal access
+ * @OUT evicted: increased by the number of blocks evicted by clock sweep, can be NULL
  * @Return:
  * @See also:
  */
-CacheSlotId_t CacheMgr::ReserveCacheBlock(CacheTag *cacheTag, int size, bool &hasFound)
+CacheSlotId_t CacheMgr::ReserveCacheBlock(CacheTag *cacheTag, int size, bool &hasFound, CacheAccessStrategy strategy,
+    int *evicted)
 {
     int slot;
     uint32 hashCode = GetHashCode(cacheTag);
 
-    slot = AllocateBlockFromCache(cacheTag, hashCode, size, hasFound);
+    slot = AllocateBlockFromCache(cacheTag, hashCode, size, hasFound, strategy, evicted);
     Assert(slot >= 0 && slot <= m_CaccheSlotMax && slot < m_CacheSlotsNum);
     if (hasFound) {
         /* add m_usage_count here may not ok, so need think more about it */
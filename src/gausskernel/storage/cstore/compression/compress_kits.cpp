@@ -23,6 +23,7 @@
  */
 #include "access/hash.h"
 #include "storage/compress_kits.h"
+#include "storage/delta_decode_impl.h"
 #include "utils/memutils.h"
 #include "utils/memprot.h"
 #include "nodes/memnodes.h"
@@ -363,6 +364,35 @@ static FORCE_INLINE void writeData(char* out, unsigned int* outpos, int64 data)
     *outpos += datasize;
 }
 
+// the runs shorter than this are written value by value
+#define RLE_RUN_COPY_THRESHOLD 16
+
+// write <repeat> copies of data. a long run is filled by doubling memcpy_s()
+// calls, which use the widest stores of the platform whatever the value size is.
+template <short datasize>
+static FORCE_INLINE void fillRuns(char* out, unsigned int* outpos, int64 data, unsigned int repeat)
+{
+    if (repeat < RLE_RUN_COPY_THRESHOLD) {
+        for (unsigned int i = 0; i < repeat; ++i) {
+            writeData<datasize>(out, outpos, data);
+        }
+        return;
+    }
+
+    char* start = out + *outpos;
+    unsigned int total = repeat * datasize;
+    unsigned int filled = 0;
+
+    writeData<datasize>(start, &filled, data);
+    while (filled < total) {
+        unsigned int chunk = Min(filled, total - filled);
+        errno_t rc = memcpy_s(start + filled, chunk, start, chunk);
+        securec_check(rc, "", "");
+        filled += chunk;
+    }
+    *outpos += total;
+}
+
 /*************************************************************************
  *                             RLE Compression
  *
@@ -617,10 +647,8 @@ int RleCoder::InnerDecompress(char* inbuf, char* outbuf, const int insize, const
                 Assert(symbolCount >= this->m_minRepeats && symbolCount <= RleCoder::RleMaxRepeats);
 
                 symbol = readData<eachValSize>(inptr, &inpos);
-                for (uint16 i = 0; i < symbolCount; ++i) {
-                    writeData<eachValSize>(outbuf, &outpos, symbol);
-                    Assert(outpos <= (unsigned int)outsize);
-                }
+                fillRuns<eachValSize>(outbuf, &outpos, symbol, symbolCount);
+                Assert(outpos <= (unsigned int)outsize);
                 outcnt += symbolCount;
             } else {
                 // [1, RleMinRepeats - 1] indicates that symbol is the same to marker itself,
@@ -882,6 +910,20 @@ int64 DeltaCoder::Compress(
 
 int64 DeltaCoder::Decompress(
     _in_ char* inbuf, _out_ char* outbuf, _in_ int insize, _in_ int outsize, _in_ short inDataSize)
+{
+    Assert(insize > 0);
+    Assert(insize == ((insize / inDataSize) * inDataSize));
+
+    uint32 nvals = (uint32)(insize / inDataSize);
+    if (DeltaDecodeSimd(inbuf, outbuf, nvals, inDataSize, m_outValSize, m_mindata)) {
+        return (int64)nvals * m_outValSize;
+    }
+
+    return DecompressScalar(inbuf, outbuf, insize, outsize, inDataSize);
+}
+
+int64 DeltaCoder::DecompressScalar(
+    _in_ char* inbuf, _out_ char* outbuf, _in_ int insize, _in_ int outsize, _in_ short inDataSize)
 {
     int64 ret = 0;
     Assert(insize > 0);
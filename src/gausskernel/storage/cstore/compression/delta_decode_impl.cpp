@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * delta_decode_impl.cpp
+ *      SIMD kernels of delta decompressing
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/cstore/compression/delta_decode_impl.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "storage/delta_decode_impl.h"
+
+#include <pthread.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define USE_DELTA_DECODE_X86_SIMD
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define USE_DELTA_DECODE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(USE_DELTA_DECODE_X86_SIMD) || defined(USE_DELTA_DECODE_NEON)
+/*
+ * SIMD kernels of delta decompressing. A delta is an unsigned little-endian
+ * integer of 1 ~ 7 bytes, and the output value is the delta plus the min value,
+ * truncated to 2, 4 or 8 bytes. A byte shuffle widens a whole register of
+ * deltas at once, whatever their size, then one add applies the min value.
+ * The values a full 16-byte load does not fit in are left to the scalar tail,
+ * so the kernels never read past the input.
+ */
+typedef void (*DeltaDecodeFunc)(const char* inbuf, char* outbuf, uint32 nvals, short inValSize, int64 minVal);
+
+/* the shuffle control that widens 16 / outValSize deltas of inValSize bytes */
+static void DeltaDecodeShuffleMask(uint8* mask, short inValSize, short outValSize)
+{
+    for (int lane = 0; lane < 16 / outValSize; lane++) {
+        for (int i = 0; i < outValSize; i++) {
+            /* an index with the high bit set makes the shuffle write zero */
+            mask[lane * outValSize + i] = (i < inValSize) ? (uint8)(lane * inValSize + i) : 0x80;
+        }
+    }
+}
+
+template <typename outType>
+static void DeltaDecodeTail(const char* inbuf, char* outbuf, uint32 nvals, short inValSize, int64 minVal)
+{
+    outType* out = (outType*)outbuf;
+    const uint8* in = (const uint8*)inbuf;
+
+    for (uint32 i = 0; i < nvals; i++) {
+        uint64 delta = 0;
+        for (short b = 0; b < inValSize; b++) {
+            delta |= (uint64)in[b] << (8 * b);
+        }
+        out[i] = (outType)(delta + (uint64)minVal);
+        in += inValSize;
+    }
+}
+#endif
+
+#ifdef USE_DELTA_DECODE_X86_SIMD
+template <typename outType>
+__attribute__((target("ssse3"))) static inline __m128i DeltaDecodeAdd128(__m128i vals, int64 minVal)
+{
+    if (sizeof(outType) == sizeof(uint16)) {
+        return _mm_add_epi16(vals, _mm_set1_epi16((int16)minVal));
+    } else if (sizeof(outType) == sizeof(uint32)) {
+        return _mm_add_epi32(vals, _mm_set1_epi32((int32)minVal));
+    }
+    return _mm_add_epi64(vals, _mm_set1_epi64x(minVal));
+}
+
+template <typename outType>
+__attribute__((target("avx2"))) static inline __m256i DeltaDecodeAdd256(__m256i vals, int64 minVal)
+{
+    if (sizeof(outType) == sizeof(uint16)) {
+        return _mm256_add_epi16(vals, _mm256_set1_epi16((int16)minVal));
+    } else if (sizeof(outType) == sizeof(uint32)) {
+        return _mm256_add_epi32(vals, _mm256_set1_epi32((int32)minVal));
+    }
+    return _mm256_add_epi64(vals, _mm256_set1_epi64x(minVal));
+}
+
+template <typename outType>
+__attribute__((target("ssse3"))) static void DeltaDecodeSsse3(
+    const char* inbuf, char* outbuf, uint32 nvals, short inValSize, int64 minVal)
+{
+    const uint32 lanes = 16 / sizeof(outType);
+    const char* inEnd = inbuf + (size_t)nvals * inValSize;
+    uint8 maskBytes[16];
+    uint32 i = 0;
+
+    DeltaDecodeShuffleMask(maskBytes, inValSize, sizeof(outType));
+    const __m128i mask = _mm_loadu_si128((const __m128i*)maskBytes);
+
+    for (; inbuf + 16 <= inEnd; i += lanes) {
+        __m128i vals = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)inbuf), mask);
+        _mm_storeu_si128((__m128i*)(outbuf + i * sizeof(outType)), DeltaDecodeAdd128<outType>(vals, minVal));
+        inbuf += lanes * inValSize;
+    }
+    DeltaDecodeTail<outType>(inbuf, outbuf + i * sizeof(outType), nvals - i, inValSize, minVal);
+}
+
+template <typename outType>
+__attribute__((target("avx2"))) static void DeltaDecodeAvx2(
+    const char* inbuf, char* outbuf, uint32 nvals, short inValSize, int64 minVal)
+{
+    /* the shuffle works within each 128-bit half, so each half gets its own load */
+    const uint32 halfLanes = 16 / sizeof(outType);
+    const uint32 halfBytes = halfLanes * inValSize;
+    const char* inEnd = inbuf + (size_t)nvals * inValSize;
+    uint8 maskBytes[16];
+    uint32 i = 0;
+
+    DeltaDecodeShuffleMask(maskBytes, inValSize, sizeof(outType));
+    const __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)maskBytes));
+
+    for (; inbuf + halfBytes + 16 <= inEnd; i += 2 * halfLanes) {
+        __m256i vals = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)inbuf)),
+                                               _mm_loadu_si128((const __m128i*)(inbuf + halfBytes)), 1);
+        vals = _mm256_shuffle_epi8(vals, mask);
+        _mm256_storeu_si256((__m256i*)(outbuf + i * sizeof(outType)), DeltaDecodeAdd256<outType>(vals, minVal));
+        inbuf += 2 * halfBytes;
+    }
+    DeltaDecodeTail<outType>(inbuf, outbuf + i * sizeof(outType), nvals - i, inValSize, minVal);
+}
+
+/* XCR0, the register states the OS saves on context switch */
+static uint64 DeltaDecodeXgetbv(void)
+{
+    uint32 eax, edx;
+
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64)edx << 32) | eax;
+}
+
+static const DeltaDecodeFunc g_deltaDecodeSsse3[] = {
+    DeltaDecodeSsse3<uint16>, DeltaDecodeSsse3<uint32>, DeltaDecodeSsse3<uint64>};
+static const DeltaDecodeFunc g_deltaDecodeAvx2[] = {
+    DeltaDecodeAvx2<uint16>, DeltaDecodeAvx2<uint32>, DeltaDecodeAvx2<uint64>};
+
+static const DeltaDecodeFunc* DeltaDecodeChooseKernels(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return NULL;
+    }
+    const DeltaDecodeFunc* kernels = ((ecx & (1 << 9)) != 0) ? g_deltaDecodeSsse3 : NULL;
+
+    /* AVX2 also needs OSXSAVE and the XMM/YMM states enabled */
+    if ((ecx & (1 << 27)) != 0 && (DeltaDecodeXgetbv() & 0x6) == 0x6 && __get_cpuid_max(0, NULL) >= 7) {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        if ((ebx & (1 << 5)) != 0) {
+            kernels = g_deltaDecodeAvx2;
+        }
+    }
+    return kernels;
+}
+#endif /* USE_DELTA_DECODE_X86_SIMD */
+
+#ifdef USE_DELTA_DECODE_NEON
+template <typename outType>
+static void DeltaDecodeNeon(const char* inbuf, char* outbuf, uint32 nvals, short inValSize, int64 minVal)
+{
+    const uint32 lanes = 16 / sizeof(outType);
+    const char* inEnd = inbuf + (size_t)nvals * inValSize;
+    uint8 maskBytes[16];
+    uint32 i = 0;
+
+    /* tbl writes zero for an out of range index, as pshufb does for the high bit */
+    DeltaDecodeShuffleMask(maskBytes, inValSize, sizeof(outType));
+    const uint8x16_t mask = vld1q_u8(maskBytes);
+
+    for (; inbuf + 16 <= inEnd; i += lanes) {
+        uint8x16_t vals = vqtbl1q_u8(vld1q_u8((const uint8*)inbuf), mask);
+        char* out = outbuf + i * sizeof(outType);
+        if (sizeof(outType) == sizeof(uint16)) {
+            vst1q_u16((uint16*)out, vaddq_u16(vreinterpretq_u16_u8(vals), vdupq_n_u16((uint16)minVal)));
+        } else if (sizeof(outType) == sizeof(uint32)) {
+            vst1q_u32((uint32*)out, vaddq_u32(vreinterpretq_u32_u8(vals), vdupq_n_u32((uint32)minVal)));
+        } else {
+            vst1q_u64((uint64*)out, vaddq_u64(vreinterpretq_u64_u8(vals), vdupq_n_u64((uint64)minVal)));
+        }
+        inbuf += lanes * inValSize;
+    }
+    DeltaDecodeTail<outType>(inbuf, outbuf + i * sizeof(outType), nvals - i, inValSize, minVal);
+}
+
+static const DeltaDecodeFunc g_deltaDecodeNeon[] = {
+    DeltaDecodeNeon<uint16>, DeltaDecodeNeon<uint32>, DeltaDecodeNeon<uint64>};
+
+/* Advanced SIMD is always there on aarch64 */
+static const DeltaDecodeFunc* DeltaDecodeChooseKernels(void)
+{
+    return g_deltaDecodeNeon;
+}
+#endif /* USE_DELTA_DECODE_NEON */
+
+#if defined(USE_DELTA_DECODE_X86_SIMD) || defined(USE_DELTA_DECODE_NEON)
+/* kernels for 2, 4 and 8 byte output values, NULL if the CPU has none */
+static const DeltaDecodeFunc* g_deltaDecodeKernels = NULL;
+static pthread_once_t g_deltaDecodeKernelsOnce = PTHREAD_ONCE_INIT;
+
+static void DeltaDecodeInitKernels(void)
+{
+    g_deltaDecodeKernels = DeltaDecodeChooseKernels();
+}
+
+/*
+ * Probed on the first call since CPUID may trap to a hypervisor. pthread_once
+ * makes the choice visible to every thread that gets past it.
+ */
+static DeltaDecodeFunc DeltaDecodeGetKernel(short inValSize, short outValSize)
+{
+    (void)pthread_once(&g_deltaDecodeKernelsOnce, DeltaDecodeInitKernels);
+    if (g_deltaDecodeKernels == NULL || inValSize >= outValSize) {
+        return NULL;
+    }
+
+    switch (outValSize) {
+        case sizeof(uint16):
+            return g_deltaDecodeKernels[0];
+        case sizeof(uint32):
+            return g_deltaDecodeKernels[1];
+        case sizeof(uint64):
+            return g_deltaDecodeKernels[2];
+        default:
+            return NULL;
+    }
+}
+#endif
+
+bool DeltaDecodeSimd(const char* inbuf, char* outbuf, uint32 nvals, short inValSize, short outValSize, int64 minVal)
+{
+#if defined(USE_DELTA_DECODE_X86_SIMD) || defined(USE_DELTA_DECODE_NEON)
+    DeltaDecodeFunc kernel = DeltaDecodeGetKernel(inValSize, outValSize);
+    if (kernel != NULL) {
+        kernel(inbuf, outbuf, nvals, inValSize, minVal);
+        return true;
+    }
+#endif
+    return false;
+}
@@ -89,6 +89,11 @@
 
 #define CSTORE_MIN_PREFETCH_COUNT 8
 
+/* ring size of CU cache blocks for a bulk scan, in CUs and as a part of the CU cache */
+#define CSTORE_CACHE_RING_MIN_SIZE 16
+#define CSTORE_CACHE_RING_CUS_PER_COLUMN 4
+#define CSTORE_CACHE_RING_CACHE_FRACTION 16
+
 #define InitFillColFunction(i, attlen)                                            \
     do {                                                                          \
         m_colFillFunArrary[i].colFillFun[0] = &CStore::FillVector<false, attlen>; \
@@ -105,6 +110,7 @@ CStore::CStore()
       m_colId(NULL),
       m_sysColId(NULL),
       m_lateRead(NULL),
+      m_lateQualRead(NULL),
       m_cuStorage(NULL),
       m_CUDescInfo(NULL),
       m_virtualCUDescInfo(NULL),
@@ -138,7 +144,10 @@ CStore::CStore()
       m_useBtreeIndex(false),
       m_firstColIdx(0),
       m_cuDescIdx(-1),
-      m_laterReadCtidColIdx(-1)
+      m_laterReadCtidColIdx(-1),
+      m_lateReadCtidIdx(-1),
+      m_cacheMissBytes(0),
+      m_cacheStrategy(NULL)
 {
     // if you intend to allocate any space in cstore constructor/init scan function
     // please remind that you must put the space deallocate in the deconstructor function
@@ -237,6 +246,7 @@ void CStore::InitFillVecEnv(CStoreScanState* state)
         m_colNum = list_length(pColList);
         m_colId = (int*)palloc(sizeof(int) * m_colNum);
         m_lateRead = (bool*)palloc0(sizeof(bool) * m_colNum);
+        m_lateQualRead = (bool*)palloc0(sizeof(bool) * m_colNum);
 
         int i = 0;
         ListCell* cell = NULL;
@@ -272,6 +282,26 @@ void CStore::InitFillVecEnv(CStoreScanState* state)
             }
         }
 
+        // Columns only read by the late qual are late read too, but filled before the late qual runs
+        foreach (cell, state->m_lateQualVars) {
+            int colId = lfirst_int(cell) - 1;
+            for (i = 0; i < m_colNum; ++i) {
+                if (colId == m_colId[i]) {
+                    m_lateRead[i] = true;
+                    m_lateQualRead[i] = true;
+                    break;
+                }
+            }
+        }
+
+        // Prefer a column filled after the late qual to hold ctid, so that
+        // filling the late qual columns does not overwrite it.
+        for (i = 0; i < m_colNum; ++i) {
+            if (m_lateRead[i] && (m_lateReadCtidIdx < 0 || (m_lateQualRead[m_lateReadCtidIdx] && !m_lateQualRead[i]))) {
+                m_lateReadCtidIdx = i;
+            }
+        }
+
         m_scanPosInCU = (int*)palloc0(sizeof(int) * m_colNum);
         m_CUDescInfo = (LoadCUDescCtl**)palloc(sizeof(LoadCUDescCtl*) * m_colNum);
         m_colFillFunArrary = (colFillArray*)palloc(sizeof(colFillArray) * m_colNum);
@@ -397,6 +427,8 @@ CStore::~CStore()
     m_scanPosInCU = NULL;
     m_colId = NULL;
     m_lateRead = NULL;
+    m_lateQualRead = NULL;
+    m_cacheStrategy = NULL;
     m_scanMemContext = NULL;
     m_snapshot = NULL;
     m_fillVectorByTids = NULL;
@@ -508,7 +540,9 @@ void CStore::CUPrefetch(CUDesc* cudesc, int col, AioDispatchCUDesc_t** dList, in
         return;
     }
 
-    slotId = CUCache->ReserveDataBlock(&dataSlotTag, cudesc->cu_size, found);
+    int evicted = 0;
+    slotId = CUCache->ReserveDataBlock(&dataSlotTag, cudesc->cu_size, found, NULL, &evicted);
+    pgstat_count_cu_mem_evict(m_relation, evicted);
     if (found) {
         CUCache->UnPinDataBlock(slotId);
         return;
@@ -1417,8 +1451,11 @@ bool CStore::IsLateRead(int id) const
 
 void CStore::ResetLateRead()
 {
-    for (int i = 0; i < m_colNum; ++i)
+    for (int i = 0; i < m_colNum; ++i) {
         m_lateRead[i] = false;
+        m_lateQualRead[i] = false;
+    }
+    m_lateReadCtidIdx = -1;
 }
 
 /*
@@ -2444,23 +2481,30 @@ int CStore::FillVecBatch(_out_ VectorBatch* vecBatchOut)
             if (!IsLateRead(i)) {
                 int funIdx = m_hasDeadRow ? 1 : 0;
                 deadRows = (this->*m_colFillFunArrary[i].colFillFun[funIdx])(i, cuDescPtr, vec);
-            } else {
-                // We haven't fill ctid for late read columns
-                if (!hasCtidForLateRead) {
-                    if (!m_hasDeadRow)
-                        deadRows = FillTidForLateRead<false>(cuDescPtr, vec);
-                    else
-                        deadRows = FillTidForLateRead<true>(cuDescPtr, vec);
-
-                    hasCtidForLateRead = true;
-                    this->m_laterReadCtidColIdx = colIdx;
-                } else
-                    vec->m_rows = vecBatchOut->m_rows;
-            }
+            } else if (i == m_lateReadCtidIdx) {
+                // Fill ctid into the column holding it for late read
+                if (!m_hasDeadRow)
+                    deadRows = FillTidForLateRead<false>(cuDescPtr, vec);
+                else
+                    deadRows = FillTidForLateRead<true>(cuDescPtr, vec);
+
+                hasCtidForLateRead = true;
+                this->m_laterReadCtidColIdx = colIdx;
+            } else
+                continue;
             vecBatchOut->m_rows = vec->m_rows;
         }
     }
 
+    // The other late read columns get the row count of ctid column
+    if (hasCtidForLateRead) {
+        for (i = 0; i < m_colNum; ++i) {
+            if (IsLateRead(i) && i != m_lateReadCtidIdx) {
+                vecBatchOut->m_arr[m_colId[i]].m_rows = vecBatchOut->m_rows;
+            }
+        }
+    }
+
     // Step 2: fill sys columns if need
     for (i = 0; i < m_sysColNum; ++i) {
         int sysColIdx = m_sysColId[i];
@@ -3081,31 +3125,43 @@ void CStore::FillVectorByTids(_in_ int colIdx, _in_ ScalarVector* tids, _out_ Sc
 
 void CStore::FillScanBatchLateIfNeed(__inout VectorBatch* vecBatch)
 {
-    ScalarVector* tidVec = NULL;
-    int ctidId = -1, colIdx;
+    FillLateReadColumns(vecBatch, false);
+}
+
+// Fill the columns of late qual before it runs, the other late read columns
+// are filled by FillScanBatchLateIfNeed() after it.
+void CStore::FillScanBatchLateQualIfNeed(__inout VectorBatch* vecBatch)
+{
+    FillLateReadColumns(vecBatch, true);
+}
+
+void CStore::FillLateReadColumns(__inout VectorBatch* vecBatch, bool lateQual)
+{
+    int ctidId = m_lateReadCtidIdx;
+    int colIdx;
 
-    // Step 1: fill the late read columns except the first late read column
+    if (ctidId < 0) {
+        return;
+    }
+
+    ScalarVector* tidVec = vecBatch->m_arr + m_colId[ctidId];
+
+    // Step 1: fill the late read columns except the column holding ctid
     for (int i = 0; i < m_colNum; ++i) {
         colIdx = m_colId[i];
-        if (IsLateRead(i) && colIdx >= 0) {
+        if (IsLateRead(i) && m_lateQualRead[i] == lateQual && i != ctidId && colIdx >= 0) {
             Assert(colIdx < vecBatch->m_cols);
 
-            if (tidVec != NULL) {
-                CUDesc* cuDescPtr = this->m_CUDescInfo[i]->cuDescArray + this->m_cuDescIdx;
-                this->GetCUDeleteMaskIfNeed(cuDescPtr->cu_id, this->m_snapshot);
-                (this->*m_fillVectorLateRead[i])(colIdx, tidVec, cuDescPtr, vecBatch->m_arr + colIdx);
-            } else {
-                // The first late read column should be filled with ctid
-                tidVec = vecBatch->m_arr + colIdx;
-                ctidId = i;
-            }
+            CUDesc* cuDescPtr = this->m_CUDescInfo[i]->cuDescArray + this->m_cuDescIdx;
+            this->GetCUDeleteMaskIfNeed(cuDescPtr->cu_id, this->m_snapshot);
+            (this->*m_fillVectorLateRead[i])(colIdx, tidVec, cuDescPtr, vecBatch->m_arr + colIdx);
         }
     }
 
-    // Step 2: fill the first late read column
-    if (ctidId >= 0) {
+    // Step 2: fill the column holding ctid
+    if (IsLateRead(ctidId) && m_lateQualRead[ctidId] == lateQual) {
         colIdx = m_colId[ctidId];
-        Assert(IsLateRead(ctidId) && colIdx >= 0);
+        Assert(colIdx >= 0);
 
         CUDesc* cuDescPtr = this->m_CUDescInfo[ctidId]->cuDescArray + this->m_cuDescIdx;
         this->GetCUDeleteMaskIfNeed(cuDescPtr->cu_id, this->m_snapshot);
@@ -3495,6 +3551,23 @@ void CStore::CheckConsistenceOfCUData(CUDesc* cuDescPtr, CU* cu, AttrNumber col)
 
 #define GetUncompressErrMsg(ret_code) ((CU_ERR_CRC == (ret_code)) ? "incorrect checksum" : "incorrect magic")
 
+// A scan having loaded more than a quarter of CU cache is a bulk scan. It goes on with
+// a ring of cache blocks, so that it does not flush the CUs cached for the other sessions.
+// The ring holds at most a sixteenth of the CU cache, however wide the CUs are.
+void CStore::UseCacheStrategyIfNeed(int cuSize)
+{
+    m_cacheMissBytes += cuSize;
+    if (m_cacheStrategy == NULL && m_cacheMissBytes > CUCache->m_cstoreMaxSize / 4) {
+        AutoContextSwitch newMemCnxt(m_scanMemContext);
+        m_cacheStrategy =
+            GetCacheAccessStrategy(Max(CSTORE_CACHE_RING_MIN_SIZE, m_colNum * CSTORE_CACHE_RING_CUS_PER_COLUMN),
+                                   Max(CUCache->m_cstoreMaxSize / CSTORE_CACHE_RING_CACHE_FRACTION, 1));
+        ereport(DEBUG1, (errmodule(MOD_CACHE),
+                         errmsg("scan of relation %s uses a ring of CU cache blocks after loading %ld bytes",
+                                RelationGetRelationName(m_relation), m_cacheMissBytes)));
+    }
+}
+
 // Put the CU in the cache and return a pointer to the CU data.
 // The CU is returned pinned, callers must unpin it when finished.
 // 1. Record a fetch (read).
@@ -3553,8 +3626,13 @@ RETRY_LOAD_CU:
     if (IsValidCacheSlotID(slotId)) {
         hasFound = true;
     } else {
+        int evicted = 0;
         hasFound = false;
-        slotId = CUCache->ReserveDataBlock(&dataSlotTag, cuDescPtr->cu_size, hasFound);
+        slotId = CUCache->ReserveDataBlock(&dataSlotTag, cuDescPtr->cu_size, hasFound, m_cacheStrategy, &evicted);
+        pgstat_count_cu_mem_evict(m_relation, evicted);
+        if (!hasFound) {
+            UseCacheStrategyIfNeed(cuDescPtr->cu_size);
+        }
     }
 
     // Use the cached CU
@@ -267,16 +267,19 @@ bool DataCacheMgr::ReserveCstoreDataBlockWithSlotId(CacheSlotId_t slotId)
  * @IN dataSlotTag: data slot tag
  * @IN hasFound: whether found or not
  * @IN size: need block size
+ * @IN strategy: ring strategy of bulk scan, NULL for normal access
+ * @OUT evicted: increased by the number of blocks evicted for this one, can be NULL
  * @Return: slot id
  * @See also:
  */
-CacheSlotId_t DataCacheMgr::ReserveDataBlock(DataSlotTag* dataSlotTag, int size, bool& hasFound)
+CacheSlotId_t DataCacheMgr::ReserveDataBlock(DataSlotTag* dataSlotTag, int size, bool& hasFound,
+    CacheAccessStrategy strategy, int* evicted)
 {
     CacheSlotId_t slot = CACHE_BLOCK_INVALID_IDX;
     CacheTag cacheTag = {0};
 
     m_cache_mgr->InitCacheBlockTag(&cacheTag, dataSlotTag->slotType, &dataSlotTag->slotTag, sizeof(DataSlotTagKey));
-    slot = m_cache_mgr->ReserveCacheBlock(&cacheTag, size, hasFound);
+    slot = m_cache_mgr->ReserveCacheBlock(&cacheTag, size, hasFound, strategy, evicted);
     if (!hasFound) {
         /* remember block slot in process */
         Assert(!IsValidCacheSlotID(t_thrd.storage_cxt.CacheBlockInProgressIO));
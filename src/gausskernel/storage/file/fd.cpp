@@ -83,6 +83,7 @@
 #include "storage/vfd.h"
 #include "storage/ipc.h"
 #include "storage/shmem.h"
+#include "storage/uring.h"
 #include "threadpool/threadpool.h"
 #include "utils/guc.h"
 #include "utils/plog.h"
@@ -2486,6 +2487,36 @@ int FileAsyncCUWrite(AioDispatchCUDesc_t** dList, int32 dn)
 }
 #endif
 
+/*
+ * @Description: read a batch through the thread's io_uring and wait for it
+ * @Param[IN/OUT] reqs: vfd, buf, len and offset in, result out
+ * @Param[IN] nreqs: request count
+ * @See also: UringReadBatch
+ */
+void FileUringRead(UringIoReq* reqs, int nreqs)
+{
+    vfd *vfdcache = GetVfdCache();
+
+    for (int i = 0; i < nreqs; i++) {
+        File file = reqs[i].file;
+        int returnCode;
+
+        Assert(FileIsValid(file));
+        DO_DB(ereport(LOG, (errmsg("FileUringRead: fd(%d), filename(%s), offset(%ld)", file,
+                                   vfdcache[file].fileName, (int64)reqs[i].offset))));
+
+        returnCode = FileAccess(file);
+        if (returnCode < 0) {
+            ereport(ERROR, (errcode_for_file_access(), errmsg("FileUringRead, file access failed %d", returnCode)));
+        }
+        reqs[i].fd = vfdcache[file].fd;
+    }
+
+    pgstat_report_waitevent(WAIT_EVENT_DATA_FILE_PREFETCH);
+    UringReadBatch(reqs, nreqs);
+    pgstat_report_waitevent(WAIT_EVENT_END);
+}
+
 void FileFastExtendFile(File file, uint32 offset, uint32 size, bool keep_size)
 {
     int returnCode;
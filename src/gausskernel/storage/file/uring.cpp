@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * uring.cpp
+ *        Batched block I/O through a per-thread Linux io_uring
+ *
+ * Unlike the libaio path of the ADIO completers, io_uring also works on
+ * files opened without O_DIRECT, so it can serve the ordinary buffered
+ * data files.  Every thread that asks for it gets a private ring, created
+ * on first use and destroyed at thread exit.  A batch is queued on the
+ * submission ring, handed to the kernel with a single io_uring_enter(),
+ * and reaped by the same thread before UringReadBatch() returns, so there
+ * is no completer thread and nothing is left in flight across calls.
+ * This is synchronous batching: the caller waits for the batch, what it
+ * saves is one system call and one wait per block.
+ *
+ * When the memlock limit allows, the shared buffer pool is registered
+ * with the ring, and reads into shared buffers use IORING_OP_READ_FIXED,
+ * which saves the kernel from pinning the target pages on every request.
+ * Every registration pins the whole pool again, so the rings of all
+ * threads together stay within the limit.  Other targets use
+ * IORING_OP_READV.
+ *
+ * The ring is driven through the raw system calls, so no liburing is
+ * needed; if the build headers or the running kernel lack io_uring,
+ * UringIsAvailable() just returns false.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/file/uring.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#include "storage/barrier.h"
+#include "storage/ipc.h"
+#include "storage/uring.h"
+#include "utils/atomic.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define USE_IO_URING
+#endif
+#endif
+
+#ifdef USE_IO_URING
+
+/* the io_uring system calls share one number on every architecture */
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+/* the kernel refuses to register a single buffer larger than 1GB */
+#define URING_FIXED_CHUNK ((Size)1024 * 1024 * 1024)
+#define URING_MAX_FIXED_VECS 1024
+/* how long a failed ring is polled for reads still in flight */
+#define URING_DRAIN_TIMEOUT_US 60000000L
+#define URING_DRAIN_INTERVAL_US 1000L
+
+typedef struct UringRing {
+    int fd;
+
+    /* submission ring */
+    unsigned* sqHead;
+    unsigned* sqTail;
+    unsigned sqMask;
+    unsigned sqEntries;
+    unsigned* sqArray;
+    struct io_uring_sqe* sqes;
+
+    /* completion ring */
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned cqMask;
+    struct io_uring_cqe* cqes;
+
+    /* mappings, cqPtr equals sqPtr when the kernel maps both rings at once */
+    void* sqPtr;
+    size_t sqSize;
+    void* cqPtr;
+    size_t cqSize;
+    size_t sqesSize;
+
+    /* registered shared buffer pool, fixedBase is NULL if not registered */
+    char* fixedBase;
+    Size fixedSize;
+
+    /* iovecs for the READV requests of the batch in flight */
+    struct iovec iovecs[URING_RING_ENTRIES];
+} UringRing;
+
+static THR_LOCAL UringRing* t_uring = NULL;
+static THR_LOCAL bool t_uring_failed = false;
+
+/* set once the kernel turned io_uring down; no point in asking again */
+static volatile bool uring_unsupported = false;
+
+/* memory pinned by the buffer registrations of all rings */
+static pg_atomic_uint64 uring_registered_bytes = 0;
+
+static void UringDestroy(UringRing* ring)
+{
+    if (ring->fixedBase != NULL) {
+        (void)pg_atomic_fetch_sub_u64(&uring_registered_bytes, (uint64)ring->fixedSize);
+    }
+    if (ring->sqes != NULL && ring->sqes != MAP_FAILED) {
+        (void)munmap(ring->sqes, ring->sqesSize);
+    }
+    if (ring->cqPtr != NULL && ring->cqPtr != MAP_FAILED && ring->cqPtr != ring->sqPtr) {
+        (void)munmap(ring->cqPtr, ring->cqSize);
+    }
+    if (ring->sqPtr != NULL && ring->sqPtr != MAP_FAILED) {
+        (void)munmap(ring->sqPtr, ring->sqSize);
+    }
+    if (ring->fd >= 0) {
+        (void)close(ring->fd);
+    }
+    free(ring);
+}
+
+static void UringAtExit(int code, Datum arg)
+{
+    if (t_uring != NULL) {
+        UringDestroy(t_uring);
+        t_uring = NULL;
+    }
+}
+
+/*
+ * Reserve size bytes of RLIMIT_MEMLOCK for a buffer registration.  The
+ * pinned pages are charged once per ring, so the registrations of all
+ * rings are counted together against the limit.
+ */
+static bool UringReserveLockedMemory(Size size)
+{
+    struct rlimit rlim;
+    uint64 used;
+
+    if (getrlimit(RLIMIT_MEMLOCK, &rlim) != 0) {
+        return false;
+    }
+    if (rlim.rlim_cur == RLIM_INFINITY) {
+        (void)pg_atomic_fetch_add_u64(&uring_registered_bytes, (uint64)size);
+        return true;
+    }
+
+    used = pg_atomic_read_u64(&uring_registered_bytes);
+    do {
+        if (used + size > (uint64)rlim.rlim_cur) {
+            return false;
+        }
+    } while (!pg_atomic_compare_exchange_u64(&uring_registered_bytes, &used, used + size));
+    return true;
+}
+
+/*
+ * Register the shared buffer pool with the ring, if the memlock limit
+ * still covers another copy of it; reads then go through READV.
+ */
+static void UringRegisterBuffers(UringRing* ring)
+{
+    char* base = t_thrd.storage_cxt.BufferBlocks;
+    Size size = (Size)g_instance.attr.attr_storage.NBuffers * BLCKSZ;
+    int nvecs = (int)((size + URING_FIXED_CHUNK - 1) / URING_FIXED_CHUNK);
+    struct iovec* vecs = NULL;
+
+    if (base == NULL || size == 0 || nvecs > URING_MAX_FIXED_VECS) {
+        return;
+    }
+    if (!UringReserveLockedMemory(size)) {
+        return;
+    }
+
+    vecs = (struct iovec*)malloc(sizeof(struct iovec) * nvecs);
+    if (vecs == NULL) {
+        (void)pg_atomic_fetch_sub_u64(&uring_registered_bytes, (uint64)size);
+        return;
+    }
+    for (int i = 0; i < nvecs; i++) {
+        Size start = (Size)i * URING_FIXED_CHUNK;
+
+        vecs[i].iov_base = base + start;
+        vecs[i].iov_len = Min(URING_FIXED_CHUNK, size - start);
+    }
+
+    if (syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS, vecs, nvecs) == 0) {
+        ring->fixedBase = base;
+        ring->fixedSize = size;
+    } else {
+        (void)pg_atomic_fetch_sub_u64(&uring_registered_bytes, (uint64)size);
+        ereport(DEBUG1, (errmsg("could not register shared buffers with io_uring: %m")));
+    }
+    free(vecs);
+}
+
+static UringRing* UringSetup(void)
+{
+    struct io_uring_params params;
+    UringRing* ring = NULL;
+    char* sq = NULL;
+    char* cq = NULL;
+    errno_t rc;
+
+    ring = (UringRing*)malloc(sizeof(UringRing));
+    if (ring == NULL) {
+        return NULL;
+    }
+    rc = memset_s(ring, sizeof(UringRing), 0, sizeof(UringRing));
+    securec_check(rc, "\0", "\0");
+    rc = memset_s(&params, sizeof(params), 0, sizeof(params));
+    securec_check(rc, "\0", "\0");
+
+    ring->fd = (int)syscall(__NR_io_uring_setup, URING_RING_ENTRIES, &params);
+    if (ring->fd < 0) {
+        if (errno == ENOSYS || errno == EPERM) {
+            uring_unsupported = true;
+            ereport(LOG, (errmsg("io_uring is not available, io_uring prefetch is disabled: %m")));
+        } else {
+            ereport(DEBUG1, (errmsg("could not set up io_uring: %m")));
+        }
+        free(ring);
+        return NULL;
+    }
+
+    ring->sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+#ifdef IORING_FEAT_SINGLE_MMAP
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->sqSize = ring->cqSize = Max(ring->sqSize, ring->cqSize);
+    }
+#endif
+    ring->sqPtr = mmap(NULL, ring->sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+        IORING_OFF_SQ_RING);
+    if (ring->sqPtr == MAP_FAILED) {
+        goto fail;
+    }
+#ifdef IORING_FEAT_SINGLE_MMAP
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cqPtr = ring->sqPtr;
+    } else
+#endif
+    {
+        ring->cqPtr = mmap(NULL, ring->cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+            IORING_OFF_CQ_RING);
+        if (ring->cqPtr == MAP_FAILED) {
+            goto fail;
+        }
+    }
+    ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if ((void*)ring->sqes == MAP_FAILED) {
+        goto fail;
+    }
+
+    sq = (char*)ring->sqPtr;
+    ring->sqHead = (unsigned*)(sq + params.sq_off.head);
+    ring->sqTail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sqMask = *(unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sqEntries = *(unsigned*)(sq + params.sq_off.ring_entries);
+    ring->sqArray = (unsigned*)(sq + params.sq_off.array);
+
+    cq = (char*)ring->cqPtr;
+    ring->cqHead = (unsigned*)(cq + params.cq_off.head);
+    ring->cqTail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cqMask = *(unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+
+    UringRegisterBuffers(ring);
+    on_proc_exit(UringAtExit, 0);
+    return ring;
+
+fail:
+    ereport(DEBUG1, (errmsg("could not map io_uring rings: %m")));
+    UringDestroy(ring);
+    return NULL;
+}
+
+static UringRing* UringGetRing(void)
+{
+    if (t_uring == NULL && !t_uring_failed && !uring_unsupported) {
+        t_uring = UringSetup();
+        t_uring_failed = (t_uring == NULL);
+    }
+    return t_uring;
+}
+
+static void UringPrepRead(UringRing* ring, UringIoReq* req, unsigned slot, unsigned tail)
+{
+    unsigned idx = tail & ring->sqMask;
+    struct io_uring_sqe* sqe = &ring->sqes[idx];
+    errno_t rc = memset_s(sqe, sizeof(*sqe), 0, sizeof(*sqe));
+    securec_check(rc, "\0", "\0");
+
+    sqe->fd = req->fd;
+    sqe->off = (uint64)req->offset;
+    sqe->user_data = slot;
+    if (ring->fixedBase != NULL && req->buf >= ring->fixedBase &&
+        req->buf + req->len <= ring->fixedBase + ring->fixedSize) {
+        Size pos = (Size)(req->buf - ring->fixedBase);
+
+        sqe->opcode = IORING_OP_READ_FIXED;
+        sqe->addr = (uint64)(uintptr_t)req->buf;
+        sqe->len = req->len;
+        sqe->buf_index = (uint16)(pos / URING_FIXED_CHUNK);
+    } else {
+        ring->iovecs[slot].iov_base = req->buf;
+        ring->iovecs[slot].iov_len = req->len;
+        sqe->opcode = IORING_OP_READV;
+        sqe->addr = (uint64)(uintptr_t)&ring->iovecs[slot];
+        sqe->len = 1;
+    }
+    ring->sqArray[idx] = idx;
+}
+
+/* Move the completions posted so far into reqs, returns how many there were. */
+static unsigned UringReapCompletions(UringRing* ring, UringIoReq* reqs, unsigned nreqs)
+{
+    unsigned head = *ring->cqHead;
+    unsigned cqtail = *(volatile unsigned*)ring->cqTail;
+    unsigned reaped = 0;
+
+    pg_read_barrier();
+    while (head != cqtail) {
+        struct io_uring_cqe* cqe = &ring->cqes[head & ring->cqMask];
+
+        Assert(cqe->user_data < nreqs);
+        reqs[cqe->user_data].result = cqe->res;
+        head++;
+        reaped++;
+    }
+    pg_memory_barrier();
+    *(volatile unsigned*)ring->cqHead = head;
+    return reaped;
+}
+
+/*
+ * io_uring_enter() cannot wait for us any more, but the reads the kernel has
+ * taken still complete and post to the completion queue.  Poll it until every
+ * submitted read is back, so that no read can land in a buffer after we give
+ * it up.  Returns false if they do not all come back in time.
+ */
+static bool UringDrainCompletions(UringRing* ring, UringIoReq* reqs, unsigned nreqs, unsigned* reaped,
+    unsigned queued)
+{
+    for (long waited = 0; waited < URING_DRAIN_TIMEOUT_US; waited += URING_DRAIN_INTERVAL_US) {
+        *reaped += UringReapCompletions(ring, reqs, nreqs);
+        if (*reaped >= queued) {
+            return true;
+        }
+        pg_usleep(URING_DRAIN_INTERVAL_US);
+    }
+    *reaped += UringReapCompletions(ring, reqs, nreqs);
+    return *reaped >= queued;
+}
+
+/*
+ * Submit up to sqEntries requests and wait for all of them.  This does not
+ * throw while the kernel owns some of the requests, since the target buffers
+ * must not be reused before their completions are reaped.  If waiting itself
+ * fails, the completion queue is polled until all submitted reads are back,
+ * then the ring is torn down and this thread reads synchronously from then
+ * on.  If the reads do not come back we cannot release their buffers, PANIC.
+ */
+static void UringReadRound(UringRing* ring, UringIoReq* reqs, unsigned nreqs)
+{
+    unsigned tail = *ring->sqTail;
+    unsigned queued = nreqs;
+    unsigned submitted = 0;
+    unsigned reaped = 0;
+
+    for (unsigned i = 0; i < nreqs; i++) {
+        UringPrepRead(ring, &reqs[i], i, tail + i);
+    }
+    pg_write_barrier();
+    *(volatile unsigned*)ring->sqTail = tail + nreqs;
+
+    while (reaped < queued) {
+        long ret = syscall(__NR_io_uring_enter, ring->fd, queued - submitted, queued - reaped,
+            IORING_ENTER_GETEVENTS, NULL, 0);
+
+        if (ret >= 0) {
+            submitted += (unsigned)ret;
+        } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            int err = errno;
+
+            if (submitted == queued) {
+                if (!UringDrainCompletions(ring, reqs, nreqs, &reaped, queued)) {
+                    ereport(PANIC, (errmsg("io_uring_enter() failed while waiting for reads and %u reads are "
+                                           "still in flight: %s", queued - reaped, strerror(err))));
+                }
+                UringDestroy(ring);
+                t_uring = NULL;
+                t_uring_failed = true;
+                ereport(ERROR, (errcode_for_file_access(),
+                    errmsg("io_uring_enter() failed while waiting for reads, falling back to synchronous reads: %s",
+                        strerror(err))));
+            }
+
+            /*
+             * Hard failure: take back what the kernel has not consumed and
+             * fail those requests, then keep waiting for the others.
+             */
+            *(volatile unsigned*)ring->sqTail = tail + submitted;
+            for (unsigned i = submitted; i < queued; i++) {
+                reqs[i].result = -err;
+            }
+            queued = submitted;
+        }
+
+        reaped += UringReapCompletions(ring, reqs, nreqs);
+    }
+}
+
+#endif /* USE_IO_URING */
+
+/*
+ * @Description: whether this thread can do batched reads through io_uring,
+ *  sets up the thread's ring on first call
+ * @Return: true if UringReadBatch() may be used
+ */
+bool UringIsAvailable(void)
+{
+#ifdef USE_IO_URING
+    return UringGetRing() != NULL;
+#else
+    return false;
+#endif
+}
+
+/*
+ * @Description: read a batch and wait for all of it, the caller must have
+ *  checked UringIsAvailable()
+ * @Param[IN/OUT] reqs: fd, buf, len and offset in, result out
+ * @Param[IN] nreqs: request count
+ * @See also: FileUringRead
+ */
+void UringReadBatch(UringIoReq* reqs, int nreqs)
+{
+#ifdef USE_IO_URING
+    UringRing* ring = UringGetRing();
+    int done = 0;
+
+    Assert(ring != NULL);
+    while (done < nreqs) {
+        unsigned round = Min((unsigned)(nreqs - done), Min(ring->sqEntries, (unsigned)URING_RING_ENTRIES));
+
+        UringReadRound(ring, reqs + done, round);
+        done += (int)round;
+    }
+#else
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("io_uring is not supported by this build")));
+#endif
+}
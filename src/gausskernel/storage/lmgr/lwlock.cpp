@@ -86,6 +86,7 @@
 #include "replication/slot.h"
 #include "storage/ipc.h"
 #include "storage/lock/lwlock_be.h"
+#include "storage/lock/lwlock_cohort.h"
 #include "storage/predicate.h"
 #include "storage/proc.h"
 #include "storage/lock/s_lock.h"
@@ -197,7 +198,11 @@ static const char *BuiltinTrancheNames[] = {
     "AuditIndextblLock"
 };
 
+/* native tranches listed in numa_aware_lwlock_tranches, set once by the postmaster */
+static bool NumaAwareTranches[LWTRANCHE_NATIVE_TRANCHE_NUM];
+
 static void RegisterLWLockTranches(void);
+static void InitializeNumaAwareTranches(void);
 static void InitializeLWLocks(int numLocks);
 
 #ifdef LWLOCK_STATS
@@ -506,10 +511,58 @@ void CreateLWLocks(void)
     LWLockCounter[0] = (int)NumFixedLWLocks;
     LWLockCounter[1] = numLocks;
 
+    InitializeNumaAwareTranches();
     InitializeLWLocks(numLocks);
     RegisterLWLockTranches();
 }
 
+static int FindNativeTrancheId(const char *name)
+{
+    int i;
+    for (i = 0; i < NUM_INDIVIDUAL_LWLOCKS; i++) {
+        if (pg_strcasecmp(name, MainLWLockNames[i]) == 0) {
+            return i;
+        }
+    }
+    for (i = 0; i < (int)lengthof(BuiltinTrancheNames); i++) {
+        if (pg_strcasecmp(name, BuiltinTrancheNames[i]) == 0) {
+            return NUM_INDIVIDUAL_LWLOCKS + i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Parse numa_aware_lwlock_tranches, a comma separated list of native tranche
+ * names such as "ProcArrayLock,WALInsertLock,BufMappingLock". Locks of these
+ * tranches hand over exclusive ownership NUMA node locally first.
+ */
+static void InitializeNumaAwareTranches(void)
+{
+    errno_t rc = memset_s(NumaAwareTranches, sizeof(NumaAwareTranches), 0, sizeof(NumaAwareTranches));
+    securec_check(rc, "\0", "\0");
+
+    char* attr = TrimStr(g_instance.attr.attr_storage.numa_aware_lwlock_tranches);
+    if (attr == NULL || attr[0] == '\0') {
+        return;
+    }
+    const char* pdelimiter = ",";
+    char* nextToken = NULL;
+    char* token = strtok_s(attr, pdelimiter, &nextToken);
+    while (token != NULL) {
+        char* name = TrimStr(token);
+        int trancheId = (name != NULL) ? FindNativeTrancheId(name) : -1;
+        if (trancheId < 0) {
+            ereport(FATAL, (errcode(ERRCODE_OPERATE_INVALID_PARAM),
+                errmsg("numa_aware_lwlock_tranches attr has invalid lwlock tranche name: %s.", token)));
+        }
+        NumaAwareTranches[trancheId] = true;
+        pfree(name);
+        token = strtok_s(NULL, pdelimiter, &nextToken);
+    }
+    pfree(attr);
+}
+
 /*
  * Initialize LWLocks that are fixed and those belonging to named tranches.
  */
@@ -782,6 +835,9 @@ void LWLockInitialize(LWLock *lock, int tranche_id)
     pg_atomic_init_u32(&lock->nwaiters, 0);
 #endif
     lock->tranche = tranche_id;
+    lock->numa_aware = (tranche_id >= 0 && tranche_id < LWTRANCHE_NATIVE_TRANCHE_NUM) ?
+        NumaAwareTranches[tranche_id] : false;
+    lock->cohort_passes = 0;
     dlist_init(&lock->waiters);
 }
 
@@ -955,6 +1011,37 @@ static void LWLockWaitListUnlock(LWLock *lock)
     Assert(old_state & LW_FLAG_LOCKED);
 }
 
+/*
+ * For a NUMA aware lock whose queue head is the exclusive waiter head, choose
+ * the exclusive waiter to hand the lock over to, see lwlock_cohort.h.
+ * Must hold the wait list lock.
+ *
+ * PGPROC.nodeno is handed out round-robin and says nothing about where an
+ * unbound thread runs, so both sides use the node of their current CPU: the
+ * waiters recorded it when they queued, the releaser looks it up now.
+ */
+static PGPROC *LWLockCohortPick(LWLock *lock, PGPROC *head)
+{
+    LWLockCohortWaiter waiters[LWLOCK_COHORT_SCAN_DEPTH];
+    PGPROC *procs[LWLOCK_COHORT_SCAN_DEPTH];
+    int nwaiters = 0;
+    dlist_node *cur = &head->lwWaitLink;
+
+    while (true) {
+        PGPROC *waiter = dlist_container(PGPROC, lwWaitLink, cur);
+        procs[nwaiters] = waiter;
+        waiters[nwaiters].nodeno = waiter->lwWaitNode;
+        waiters[nwaiters].exclusive = (waiter->lwWaitMode == LW_EXCLUSIVE);
+        nwaiters++;
+        if (nwaiters >= LWLOCK_COHORT_SCAN_DEPTH || !dlist_has_next(&lock->waiters, cur)) {
+            break;
+        }
+        cur = dlist_next_node(&lock->waiters, cur);
+    }
+
+    return procs[LWLockCohortChoose(waiters, nwaiters, GetCurrentNumaNode(), &lock->cohort_passes)];
+}
+
 /*
  * Wakeup all the lockers that currently have a chance to acquire the lock.
  */
@@ -965,6 +1052,8 @@ static void LWLockWakeup(LWLock *lock)
     dlist_head wakeup;
     dlist_mutable_iter iter;
 
+    bool cohort = lock->numa_aware && t_thrd.proc != NULL && g_instance.shmem_cxt.numaNodeNum > 1;
+
     dlist_init(&wakeup);
 
     /* lock wait list while collecting backends to wake up */
@@ -977,6 +1066,11 @@ static void LWLockWakeup(LWLock *lock)
             continue;
         }
 
+        /* the only one to wake is an exclusive waiter, keep the lock in this node if possible */
+        if (cohort && !wokeup_somebody && waiter->lwWaitMode == LW_EXCLUSIVE) {
+            waiter = LWLockCohortPick(lock, waiter);
+        }
+
         dlist_delete(&waiter->lwWaitLink);
         dlist_push_tail(&wakeup, &waiter->lwWaitLink);
 
@@ -1085,6 +1179,9 @@ static void LWLockQueueSelf(LWLock *lock, LWLockMode mode)
 
     t_thrd.proc->lwWaiting = true;
     t_thrd.proc->lwWaitMode = mode;
+    if (lock->numa_aware) {
+        t_thrd.proc->lwWaitNode = GetCurrentNumaNode();
+    }
 
     /* LW_WAIT_UNTIL_FREE waiters are always at the front of the queue */
     if (mode == LW_WAIT_UNTIL_FREE) {
@@ -38,6 +38,7 @@
 #include <sys/time.h>
 #ifdef __USE_NUMA
     #include <numa.h>
+    #include <sched.h>
 #endif
 #include "access/double_write.h"
 #include "access/transam.h"
@@ -210,6 +211,32 @@ static void FiniNuma(int code, Datum arg)
 #endif
 }
 
+/*
+ * NUMA node of the CPU the current thread runs on.
+ *
+ * PGPROC.nodeno is assigned round-robin and only matches the node a thread runs
+ * on when the thread was bound to it, so ask the kernel. The node of the last
+ * CPU seen is cached, a thread rarely migrates.
+ */
+int GetCurrentNumaNode(void)
+{
+#ifdef __USE_NUMA
+    static THR_LOCAL int lastCpu = -1;
+    static THR_LOCAL int lastNode = 0;
+
+    if (g_instance.shmem_cxt.numaNodeNum > 1) {
+        int cpu = sched_getcpu();
+        if (cpu >= 0 && cpu != lastCpu) {
+            int node = numa_node_of_cpu(cpu);
+            lastCpu = cpu;
+            lastNode = (node >= 0) ? node : 0;
+        }
+        return lastNode;
+    }
+#endif
+    return 0;
+}
+
 int GetThreadPoolStreamProcNum()
 {
     int thread_pool_stream_thread_num = g_threadPoolControler->GetStreamThreadNum();
@@ -804,6 +831,7 @@ void InitProcess(void)
         t_thrd.pgxact->vacuumFlags |= PROC_IS_AUTOVACUUM;
     t_thrd.proc->lwWaiting = false;
     t_thrd.proc->lwWaitMode = 0;
+    t_thrd.proc->lwWaitNode = 0;
     t_thrd.proc->lwIsVictim = false;
     t_thrd.proc->waitLock = NULL;
     t_thrd.proc->waitProcLock = NULL;
@@ -1028,6 +1056,7 @@ void InitAuxiliaryProcess(void)
     t_thrd.pgxact->vacuumFlags = 0;
     t_thrd.proc->lwWaiting = false;
     t_thrd.proc->lwWaitMode = 0;
+    t_thrd.proc->lwWaitNode = 0;
     t_thrd.proc->lwIsVictim = false;
     t_thrd.proc->waitLock = NULL;
     t_thrd.proc->waitProcLock = NULL;
@@ -0,0 +1,473 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.cpp
+ *    Lock-free resizable hash index implementation using split-ordered lists.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/storage/index/hash_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "hash_index.h"
+#include "mot_engine.h"
+#include "mm_global_api.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(HashIndex, Storage);
+
+uint64_t HashIndex::HashKey(const uint8_t* buf, uint32_t len)
+{
+    // MurmurHash64A
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+    uint64_t h = 0x8445d61a4e774912ULL ^ (len * m);
+    const uint8_t* end = buf + (len & ~7U);
+
+    for (const uint8_t* p = buf; p != end; p += sizeof(uint64_t)) {
+        uint64_t k;
+        errno_t erc = memcpy_s(&k, sizeof(uint64_t), p, sizeof(uint64_t));
+        securec_check(erc, "\0", "\0");
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    uint32_t tail = len & 7U;
+    if (tail != 0) {
+        uint64_t k = 0;
+        for (uint32_t i = 0; i < tail; i++) {
+            k |= (uint64_t)end[i] << (8 * i);
+        }
+        h ^= k;
+        h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+RC HashIndex::IndexInitImpl(void** args)
+{
+    m_nodePool = ObjAllocInterface::GetObjPool(sizeof(HashIndexNode) + sizeof(Key) + ALIGN8(m_keyLength), false);
+    if (m_nodePool == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash node pool");
+        DestroyBuckets();
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    m_bucketPool = ObjAllocInterface::GetObjPool(sizeof(HashIndexNode), false);
+    if (m_bucketPool == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash bucket pool");
+        DestroyBuckets();
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    // bucket 0 is the head of the list and the ancestor of all other buckets
+    BucketSlot* slot = GetBucketSlot(0);
+    HashIndexNode* head = (slot != nullptr) ? reinterpret_cast<HashIndexNode*>(m_bucketPool->Alloc()) : nullptr;
+    if (head == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to allocate hash index head bucket");
+        DestroyBuckets();
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+    head->m_splitKey = BucketSplitKey(0);
+    head->m_next.store(0, std::memory_order_relaxed);
+    head->m_value = nullptr;
+    slot->store(head, std::memory_order_release);
+
+    m_count.store(0, std::memory_order_relaxed);
+    m_bucketCount.store(HASH_INDEX_INITIAL_BUCKETS, std::memory_order_release);
+    m_initialized = true;
+    return RC_OK;
+}
+
+void HashIndex::DestroyBuckets()
+{
+    // freeing the pools releases all nodes at once
+    if (m_nodePool != nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+    }
+    if (m_bucketPool != nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_bucketPool);
+        m_bucketPool = nullptr;
+    }
+
+    for (uint32_t i = 0; i < HASH_INDEX_DIRECTORY_SIZE; i++) {
+        BucketSlot* segment = m_directory[i].load(std::memory_order_relaxed);
+        if (segment != nullptr) {
+            MemGlobalFree(segment);
+            m_directory[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    m_bucketCount.store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+}
+
+HashIndex::BucketSlot* HashIndex::GetBucketSlot(uint64_t bucket)
+{
+    std::atomic<BucketSlot*>& dirEntry = m_directory[bucket / HASH_INDEX_SEGMENT_SIZE];
+    BucketSlot* segment = dirEntry.load(std::memory_order_acquire);
+
+    if (segment == nullptr) {
+        BucketSlot* newSegment =
+            reinterpret_cast<BucketSlot*>(MemGlobalAlloc(HASH_INDEX_SEGMENT_SIZE * sizeof(BucketSlot)));
+        if (newSegment == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Hash Index", "Failed to allocate bucket segment for index %s",
+                m_name.c_str());
+            return nullptr;
+        }
+        for (uint32_t i = 0; i < HASH_INDEX_SEGMENT_SIZE; i++) {
+            new (&newSegment[i]) BucketSlot(nullptr);
+        }
+
+        // another thread may have installed the segment meanwhile
+        if (dirEntry.compare_exchange_strong(segment, newSegment, std::memory_order_acq_rel)) {
+            segment = newSegment;
+        } else {
+            MemGlobalFree(newSegment);
+        }
+    }
+
+    return &segment[bucket % HASH_INDEX_SEGMENT_SIZE];
+}
+
+HashIndexNode* HashIndex::GetBucket(uint64_t bucket)
+{
+    BucketSlot* slot = GetBucketSlot(bucket);
+    if (slot == nullptr) {
+        return nullptr;
+    }
+
+    HashIndexNode* node = slot->load(std::memory_order_acquire);
+    if (node == nullptr) {
+        node = InitializeBucket(bucket, slot);
+    }
+    return node;
+}
+
+HashIndexNode* HashIndex::GetBucketForRead(uint64_t bucket) const
+{
+    // an uninitialized bucket is still covered by the range of its parent
+    while (true) {
+        BucketSlot* segment = m_directory[bucket / HASH_INDEX_SEGMENT_SIZE].load(std::memory_order_acquire);
+        if (segment != nullptr) {
+            HashIndexNode* node = segment[bucket % HASH_INDEX_SEGMENT_SIZE].load(std::memory_order_acquire);
+            if (node != nullptr) {
+                return node;
+            }
+        }
+        MOT_ASSERT(bucket != 0);
+        bucket = ParentBucket(bucket);
+    }
+}
+
+HashIndexNode* HashIndex::InitializeBucket(uint64_t bucket, BucketSlot* slot)
+{
+    HashIndexNode* parent = GetBucket(ParentBucket(bucket));
+    if (parent == nullptr) {
+        return nullptr;
+    }
+
+    HashIndexNode* node = reinterpret_cast<HashIndexNode*>(m_bucketPool->Alloc());
+    if (node == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Hash Index", "Failed to allocate bucket for index %s", m_name.c_str());
+        return nullptr;
+    }
+    node->m_splitKey = BucketSplitKey(bucket);
+    node->m_value = nullptr;
+
+    std::atomic<uintptr_t>* prev = nullptr;
+    HashIndexNode* curr = nullptr;
+    while (true) {
+        if (FindNode(parent, node->m_splitKey, nullptr, 0, prev, curr)) {
+            // lost the race, bucket nodes are never removed so the existing one can be used
+            m_bucketPool->Release(node);
+            node = curr;
+            break;
+        }
+        node->m_next.store(reinterpret_cast<uintptr_t>(curr), std::memory_order_relaxed);
+        uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+        if (prev->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node), std::memory_order_release)) {
+            break;
+        }
+    }
+
+    slot->store(node, std::memory_order_release);
+    return node;
+}
+
+bool HashIndex::FindNode(HashIndexNode* head, uint64_t splitKey, const uint8_t* key, uint32_t len,
+    std::atomic<uintptr_t>*& prev, HashIndexNode*& curr)
+{
+retry:
+    prev = &head->m_next;
+    curr = GetNode(prev->load(std::memory_order_acquire));
+    while (curr != nullptr) {
+        uintptr_t next = curr->m_next.load(std::memory_order_acquire);
+        if (prev->load(std::memory_order_acquire) != reinterpret_cast<uintptr_t>(curr)) {
+            goto retry;
+        }
+
+        if (IsMarked(next)) {
+            // help the remover: unlink the logically deleted node, whoever unlinks it retires it
+            uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+            if (!prev->compare_exchange_strong(expected, next & ~(uintptr_t)1, std::memory_order_acq_rel)) {
+                goto retry;
+            }
+            RetireNode(curr);
+            curr = GetNode(next);
+            continue;
+        }
+
+        int cmp = CompareNode(curr, splitKey, key, len);
+        if (cmp >= 0) {
+            return (cmp == 0);
+        }
+        prev = &curr->m_next;
+        curr = GetNode(next);
+    }
+    return false;
+}
+
+HashIndexNode* HashIndex::LookupNode(HashIndexNode* head, uint64_t splitKey, const uint8_t* key, uint32_t len) const
+{
+    HashIndexNode* curr = GetNode(head->m_next.load(std::memory_order_acquire));
+    while (curr != nullptr) {
+        uintptr_t next = curr->m_next.load(std::memory_order_acquire);
+        if (!IsMarked(next) && CompareNode(curr, splitKey, key, len) >= 0) {
+            return curr;
+        }
+        curr = GetNode(next);
+    }
+    return nullptr;
+}
+
+HashIndexNode* HashIndex::NextNode(const HashIndexNode* node) const
+{
+    HashIndexNode* curr = GetNode(node->m_next.load(std::memory_order_acquire));
+    while (curr != nullptr) {
+        uintptr_t next = curr->m_next.load(std::memory_order_acquire);
+        if (!IsMarked(next) && !curr->IsBucket()) {
+            return curr;
+        }
+        curr = GetNode(next);
+    }
+    return nullptr;
+}
+
+void HashIndex::RetireNode(HashIndexNode* node)
+{
+    GcManager* gc = MOTEngine::GetInstance()->GetCurrentGcSession();
+    if (gc != nullptr) {
+        gc->GcRecordObject(GetIndexId(), (void*)m_nodePool, node, DeallocateNodeCallBack, m_nodePool->m_size);
+    } else {
+        // no session, hence no concurrent readers (e.g. recovery)
+        m_nodePool->Release(node);
+    }
+}
+
+Sentinel* HashIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    const uint8_t* buf = key->GetKeyBuf();
+    uint64_t hash = HashKey(buf, GetKeySizeNoSuffix());
+    uint64_t splitKey = RegularSplitKey(hash);
+
+    inserted = false;
+    HashIndexNode* head = GetBucket(hash & (GetBucketCount() - 1));
+    if (head == nullptr) {
+        return nullptr;
+    }
+
+    HashIndexNode* node = nullptr;
+    std::atomic<uintptr_t>* prev = nullptr;
+    HashIndexNode* curr = nullptr;
+    while (true) {
+        if (FindNode(head, splitKey, buf, m_keyLength, prev, curr)) {
+            // key mapping already exists in unique index
+            if (node != nullptr) {
+                m_nodePool->Release(node);
+            }
+            return curr->m_value;
+        }
+
+        if (node == nullptr) {
+            node = reinterpret_cast<HashIndexNode*>(m_nodePool->Alloc());
+            if (node == nullptr) {
+                MOT_REPORT_ERROR(
+                    MOT_ERROR_OOM, "Hash Index Insert", "Failed to allocate node for index %s", m_name.c_str());
+                return nullptr;
+            }
+            node->m_splitKey = splitKey;
+            node->m_value = sentinel;
+            Key* nodeKey =
+                new (node->GetKey()) Key(m_keyLength, IsPrimaryKey() ? KeyType::PRIMARY_KEY : KeyType::SECONDARY_KEY);
+            nodeKey->CpKey(buf, m_keyLength);
+        }
+
+        node->m_next.store(reinterpret_cast<uintptr_t>(curr), std::memory_order_relaxed);
+        uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+        if (prev->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node), std::memory_order_release)) {
+            break;
+        }
+    }
+    inserted = true;
+
+    // grow by doubling the bucket count, new buckets are split lazily on first access
+    uint64_t count = m_count.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t buckets = GetBucketCount();
+    if (count > buckets * HASH_INDEX_LOAD_FACTOR && buckets < HASH_INDEX_MAX_BUCKETS) {
+        (void)m_bucketCount.compare_exchange_strong(buckets, buckets * 2, std::memory_order_acq_rel);
+    }
+    return nullptr;
+}
+
+Sentinel* HashIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    const uint8_t* buf = key->GetKeyBuf();
+    uint64_t hash = HashKey(buf, GetKeySizeNoSuffix());
+    uint64_t splitKey = RegularSplitKey(hash);
+
+    // Operation does not allocate memory from pools nor remove nodes
+    HashIndexNode* head = GetBucketForRead(hash & (GetBucketCount() - 1));
+    HashIndexNode* node = LookupNode(head, splitKey, buf, m_keyLength);
+    if (node != nullptr && CompareNode(node, splitKey, buf, m_keyLength) == 0) {
+        return node->m_value;
+    }
+    return nullptr;
+}
+
+Sentinel* HashIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    const uint8_t* buf = key->GetKeyBuf();
+    uint64_t hash = HashKey(buf, GetKeySizeNoSuffix());
+    uint64_t splitKey = RegularSplitKey(hash);
+
+    HashIndexNode* head = GetBucket(hash & (GetBucketCount() - 1));
+    if (head == nullptr) {
+        return nullptr;
+    }
+
+    std::atomic<uintptr_t>* prev = nullptr;
+    HashIndexNode* curr = nullptr;
+    while (true) {
+        if (!FindNode(head, splitKey, buf, m_keyLength, prev, curr)) {
+            return nullptr;
+        }
+
+        // logical delete: mark the next pointer, the thread that sets the mark owns the removal
+        uintptr_t next = curr->m_next.load(std::memory_order_acquire);
+        if (IsMarked(next) ||
+            !curr->m_next.compare_exchange_strong(next, next | 1, std::memory_order_acq_rel)) {
+            continue;
+        }
+
+        Sentinel* sentinel = curr->m_value;
+        uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+        if (prev->compare_exchange_strong(expected, next, std::memory_order_acq_rel)) {
+            RetireNode(curr);
+        } else {
+            // physical delete failed, let FindNode() unlink and retire it
+            (void)FindNode(head, splitKey, buf, m_keyLength, prev, curr);
+        }
+        m_count.fetch_sub(1, std::memory_order_relaxed);
+        return sentinel;
+    }
+}
+
+uint64_t HashIndex::GetIndexSize()
+{
+    PoolStatsSt stats;
+    ObjAllocInterface* pools[] = {m_keyPool, m_sentinelPool, m_nodePool, m_bucketPool};
+    uint64_t res = 0;
+    uint64_t netto = 0;
+
+    for (ObjAllocInterface* pool : pools) {
+        errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+        securec_check(erc, "\0", "\0");
+        stats.m_type = PoolStatsT::POOL_STATS_ALL;
+        pool->GetStats(stats);
+        res += stats.m_poolCount * stats.m_poolGrossSize;
+        netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+    }
+
+    for (uint32_t i = 0; i < HASH_INDEX_DIRECTORY_SIZE; i++) {
+        if (m_directory[i].load(std::memory_order_relaxed) != nullptr) {
+            res += HASH_INDEX_SEGMENT_SIZE * sizeof(BucketSlot);
+            netto += HASH_INDEX_SEGMENT_SIZE * sizeof(BucketSlot);
+        }
+    }
+
+    MOT_LOG_INFO("Index %s memory size: gross: %lu, netto: %lu", m_name.c_str(), res, netto);
+    return res;
+}
+
+// Iterator API
+IndexIterator* HashIndex::Begin(uint32_t pid, bool passive) const
+{
+    HashIndexNode* head = GetBucketForRead(0);
+    IndexIterator* itr = new (std::nothrow) HashIterator(this, NextNode(head), false);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Hash Index Begin", "Failed to allocate iterator for index %s", m_name.c_str());
+    }
+    return itr;
+}
+
+IndexIterator* HashIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    // Operation does not allocate memory from pools nor remove nodes
+    const uint8_t* buf = key->GetKeyBuf();
+    uint32_t prefixLen = GetKeySizeNoSuffix();
+    uint64_t hash = HashKey(buf, prefixLen);
+    uint64_t splitKey = RegularSplitKey(hash);
+
+    // keys of the same prefix are adjacent, the list is ordered by the full key within a split key
+    HashIndexNode* head = GetBucketForRead(hash & (GetBucketCount() - 1));
+    HashIndexNode* node = LookupNode(head, splitKey, buf, prefixLen);
+    found = (node != nullptr && CompareNode(node, splitKey, buf, prefixLen) == 0);
+    if (!found) {
+        node = nullptr;
+    }
+
+    IndexIterator* itr = new (std::nothrow) HashIterator(this, node, true);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(
+            MOT_ERROR_OOM, "Hash Index Search", "Failed to allocate iterator for index %s", m_name.c_str());
+    }
+    return itr;
+}
+
+void HashIndex::HashIterator::Next()
+{
+    if (m_node == nullptr) {
+        return;
+    }
+
+    m_node = m_index->NextNode(m_node);
+    if (m_bounded && m_node != nullptr &&
+        CompareNode(m_node, m_first->m_splitKey, m_first->GetKey()->GetKeyBuf(), m_index->GetKeySizeNoSuffix()) !=
+            0) {
+        m_node = nullptr;
+    }
+}
+}  // namespace MOT
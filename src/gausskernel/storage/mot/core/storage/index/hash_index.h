@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.h
+ *    Lock-free resizable hash index implementation using split-ordered lists.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/storage/index/hash_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HASH_INDEX_H
+#define HASH_INDEX_H
+
+#include <atomic>
+#include "index.h"
+#include "utilities.h"
+
+namespace MOT {
+/**
+ * @struct HashIndexNode
+ * @brief A node in the split-ordered list of a hash index. Bucket nodes carry no key, regular
+ * nodes are followed in memory by the index key.
+ */
+struct HashIndexNode {
+    /** @var Bit-reversed hash code, orders the list such that every bucket is a contiguous run. */
+    uint64_t m_splitKey;
+
+    /** @var Next node, the lowest bit marks this node as logically deleted. */
+    std::atomic<uintptr_t> m_next;
+
+    /** @var The sentinel mapped to the key, null pointer for bucket nodes. */
+    Sentinel* m_value;
+
+    inline Key* GetKey() const
+    {
+        return reinterpret_cast<Key*>(const_cast<HashIndexNode*>(this) + 1);
+    }
+
+    inline bool IsBucket() const
+    {
+        return (m_splitKey & 1) == 0;
+    }
+};
+
+/**
+ * @class HashIndex
+ * @brief Hash index implementation for point lookups.
+ * @detail All nodes live in a single lock-free linked list sorted by the bit-reversed hash code
+ * (Shalev and Shavit, split-ordered lists). Buckets are shortcuts into the list, so doubling the
+ * bucket count never moves a node: a new bucket is initialized lazily by inserting its bucket node
+ * after the bucket node of its parent. Removed nodes are retired to the GC, concurrent readers never
+ * block. The index does not keep keys in order, it supports full scans and lookups of a full key
+ * (or of the key prefix of a non-unique index), but no range scans.
+ */
+class HashIndex : public Index {
+private:
+    /**
+     * @class HashIterator
+     * @brief Forward iterator over a hash index. A bounded iterator visits only the nodes of a
+     * single key (or key prefix of a non-unique index), an unbounded iterator visits all nodes.
+     */
+    class HashIterator : public IndexIterator {
+    public:
+        HashIterator(const HashIndex* index, HashIndexNode* node, bool bounded)
+            : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false, node != nullptr),
+              m_index(index),
+              m_node(node),
+              m_first(node),
+              m_bounded(bounded)
+        {}
+
+        virtual ~HashIterator()
+        {
+            m_node = nullptr;
+            m_first = nullptr;
+        }
+
+        virtual bool IsValid() const
+        {
+            return m_valid && m_node != nullptr;
+        }
+
+        virtual void Invalidate()
+        {
+            m_valid = false;
+        }
+
+        virtual const void* GetKey() const
+        {
+            return (m_node != nullptr) ? m_node->GetKey() : nullptr;
+        }
+
+        virtual Row* GetRow() const
+        {
+            return m_node->m_value->GetData();
+        }
+
+        virtual Sentinel* GetPrimarySentinel() const
+        {
+            return m_node->m_value;
+        }
+
+        virtual void Next();
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Not supported, the list is singly linked.
+         */
+        virtual void Prev()
+        {
+            MOT_ASSERT(false);
+        }
+
+        virtual bool Equals(const IndexIterator* rhs) const
+        {
+            return m_node == static_cast<const HashIterator*>(rhs)->m_node;
+        }
+
+        virtual void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const
+        {}
+
+        virtual void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff)
+        {}
+
+    private:
+        /** @var The iterated index. */
+        const HashIndex* m_index;
+
+        /** @var The current node. */
+        HashIndexNode* m_node;
+
+        /** @var The first node of a bounded iteration, holds the searched key prefix. */
+        HashIndexNode* m_first;
+
+        /** @var Stop at the end of the searched key instead of the end of the list. */
+        bool m_bounded;
+    };
+
+public:
+    HashIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_HASH),
+          m_nodePool(nullptr),
+          m_bucketPool(nullptr),
+          m_bucketCount(0),
+          m_count(0),
+          m_initialized(false)
+    {
+        for (uint32_t i = 0; i < HASH_INDEX_DIRECTORY_SIZE; i++) {
+            m_directory[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    virtual ~HashIndex()
+    {
+        if (m_initialized) {
+            m_initialized = false;
+            DestroyBuckets();
+        }
+    }
+
+    virtual uint64_t GetIndexSize() override;
+
+    /**
+     * @brief Retrieves the number of rows stored in the index.
+     * @return The number of rows stored in the index.
+     */
+    virtual uint64_t GetSize() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destroy all nodes and init index again.
+     */
+    virtual RC ReInitIndex()
+    {
+        m_initialized = false;
+        DestroyBuckets();
+        return IndexInitImpl(nullptr);
+    }
+
+    // Iterator API
+    virtual IndexIterator* Begin(uint32_t pid, bool passive = false) const;
+
+    /**
+     * @brief Searches for a key in the index.
+     * @detail Only the key prefix of a non-unique index is significant, the resulting iterator
+     * visits all the rows of the searched key and is invalid if no row matches. The search
+     * direction and matchKey are ignored, a hash index does not keep keys in order.
+     */
+    virtual IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const;
+
+    /**
+     * @brief Static callback function for deallocate retired nodes.
+     * @param pool Pool to deallocate from.
+     * @param ptr Pointer to the retired node.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateNodeCallBack(void* pool, void* ptr, bool dropIndex)
+    {
+        // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+        ObjAllocInterface* localPoolPtr = (ObjAllocInterface*)pool;
+
+        if (dropIndex == false) {
+            localPoolPtr->Release(ptr);
+        }
+        return localPoolPtr->m_size;
+    }
+
+protected:
+    virtual RC IndexInitImpl(void** args);
+
+    virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid);
+
+    virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
+
+    virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
+
+private:
+    /** @var Number of bucket slots in a directory segment. */
+    static constexpr uint32_t HASH_INDEX_SEGMENT_SIZE = 4096;
+
+    /** @var Number of segments in the bucket directory. */
+    static constexpr uint32_t HASH_INDEX_DIRECTORY_SIZE = 4096;
+
+    /** @var Upper limit of buckets, later inserts make the chains longer. */
+    static constexpr uint64_t HASH_INDEX_MAX_BUCKETS = (uint64_t)HASH_INDEX_SEGMENT_SIZE * HASH_INDEX_DIRECTORY_SIZE;
+
+    /** @var Number of buckets of a new index. */
+    static constexpr uint64_t HASH_INDEX_INITIAL_BUCKETS = 1024;
+
+    /** @var Average number of nodes per bucket that doubles the bucket count. */
+    static constexpr uint64_t HASH_INDEX_LOAD_FACTOR = 2;
+
+    typedef std::atomic<HashIndexNode*> BucketSlot;
+
+    /** @var Memory pool for regular nodes and their keys. */
+    ObjAllocInterface* m_nodePool;
+
+    /** @var Memory pool for bucket nodes. */
+    ObjAllocInterface* m_bucketPool;
+
+    /** @var Current number of buckets, always a power of two. */
+    std::atomic<uint64_t> m_bucketCount;
+
+    /** @var Number of keys in the index. */
+    std::atomic<uint64_t> m_count;
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    /** @var Bucket directory, segments are allocated on first use. */
+    std::atomic<BucketSlot*> m_directory[HASH_INDEX_DIRECTORY_SIZE];
+
+    static uint64_t HashKey(const uint8_t* buf, uint32_t len);
+
+    static inline uint64_t ReverseBits(uint64_t value)
+    {
+        value = ((value >> 1) & 0x5555555555555555ULL) | ((value & 0x5555555555555555ULL) << 1);
+        value = ((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+        value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        return __builtin_bswap64(value);
+    }
+
+    static inline uint64_t RegularSplitKey(uint64_t hash)
+    {
+        return ReverseBits(hash | 0x8000000000000000ULL);
+    }
+
+    static inline uint64_t BucketSplitKey(uint64_t bucket)
+    {
+        return ReverseBits(bucket);
+    }
+
+    static inline uint64_t ParentBucket(uint64_t bucket)
+    {
+        return bucket & ~(1ULL << (63 - __builtin_clzll(bucket)));
+    }
+
+    static inline bool IsMarked(uintptr_t next)
+    {
+        return (next & 1) != 0;
+    }
+
+    static inline HashIndexNode* GetNode(uintptr_t next)
+    {
+        return reinterpret_cast<HashIndexNode*>(next & ~(uintptr_t)1);
+    }
+
+    /**
+     * @brief Compares a node with a search position, the key is compared only within the same split
+     * key. A null key denotes the bucket node of the split key.
+     */
+    static inline int CompareNode(const HashIndexNode* node, uint64_t splitKey, const uint8_t* key, uint32_t len)
+    {
+        if (node->m_splitKey != splitKey) {
+            return (node->m_splitKey < splitKey) ? -1 : 1;
+        }
+        if (key == nullptr) {
+            return 0;
+        }
+        return memcmp(node->GetKey()->GetKeyBuf(), key, len);
+    }
+
+    inline uint64_t GetBucketCount() const
+    {
+        return m_bucketCount.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Retrieves the directory slot of a bucket, allocating its segment on first use.
+     */
+    BucketSlot* GetBucketSlot(uint64_t bucket);
+
+    HashIndexNode* GetBucket(uint64_t bucket);
+
+    /**
+     * @brief Retrieves the nearest initialized ancestor of a bucket without modifying the index.
+     */
+    HashIndexNode* GetBucketForRead(uint64_t bucket) const;
+
+    /**
+     * @brief Links the bucket node of a bucket into the list after the bucket node of its parent.
+     */
+    HashIndexNode* InitializeBucket(uint64_t bucket, BucketSlot* slot);
+
+    /**
+     * @brief Finds the insert position of a key after the given bucket node, unlinking logically
+     * deleted nodes on the way.
+     * @param[out] prev The link that points to the position.
+     * @param[out] curr The first node not smaller than the key or null pointer.
+     * @return True if curr matches the key.
+     */
+    bool FindNode(HashIndexNode* head, uint64_t splitKey, const uint8_t* key, uint32_t len,
+        std::atomic<uintptr_t>*& prev, HashIndexNode*& curr);
+
+    /**
+     * @brief Read-only variant of FindNode(), skips logically deleted nodes without unlinking them.
+     * @return The first live node not smaller than the key or null pointer.
+     */
+    HashIndexNode* LookupNode(HashIndexNode* head, uint64_t splitKey, const uint8_t* key, uint32_t len) const;
+
+    /**
+     * @brief Retrieves the first live regular node after the given node.
+     */
+    HashIndexNode* NextNode(const HashIndexNode* node) const;
+
+    void RetireNode(HashIndexNode* node);
+
+    void DestroyBuckets();
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* HASH_INDEX_H */
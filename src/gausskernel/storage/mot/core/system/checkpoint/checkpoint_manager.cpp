@@ -58,7 +58,12 @@ CheckpointManager::CheckpointManager()
       m_inProgressId(CheckpointControlFile::invalidId),
       m_lastReplayLsn(0),
       m_inProcessTxnsLsn(0),
-      m_numSerializedEntries(0)
+      m_numSerializedEntries(0),
+      m_chainMaxCsn(0),
+      m_isDelta(false),
+      m_inProgressMaxCsn(0),
+      m_threadDeletedKeys(nullptr),
+      m_deletedKeysLost{false, false}
 {}
 
 bool CheckpointManager::Initialize()
@@ -69,6 +74,13 @@ bool CheckpointManager::Initialize()
         return false;
     }
 
+    m_threadDeletedKeys = new (std::nothrow) ThreadDeletedKeys[GetMaxThreadCount()];
+    if (m_threadDeletedKeys == nullptr) {
+        MOT_LOG_ERROR("Failed to initialize CheckpointManager, could not allocate deleted keys buffers");
+        (void)pthread_rwlock_destroy(&m_fetchLock);
+        return false;
+    }
+
     return true;
 }
 
@@ -85,6 +97,10 @@ CheckpointManager::~CheckpointManager()
         delete m_checkpointers;
         m_checkpointers = nullptr;
     }
+    if (m_threadDeletedKeys != nullptr) {
+        delete[] m_threadDeletedKeys;
+        m_threadDeletedKeys = nullptr;
+    }
     (void)pthread_rwlock_destroy(&m_fetchLock);
 }
 
@@ -105,6 +121,10 @@ bool CheckpointManager::CreateSnapShot()
 
     ResetFlags();
 
+    // Parallel redo replay commits transactions out of LSN order. Hold it until the snapshot point
+    // is taken, so that the checkpoint contains exactly the transactions up to the last replay LSN.
+    bool redoHeld = MOTEngine::GetInstance()->IsRecovering() && GetRecoveryManager()->HoldRedoReplay();
+
     // Ensure that there are no transactions that started in Checkpoint COMPLETE
     // phase that are not yet completed
     WaitPrevPhaseCommittedTxnComplete();
@@ -127,10 +147,26 @@ bool CheckpointManager::CreateSnapShot()
     FillTasksQueue();
 
     if (!CreateCheckpointDir()) {
+        if (redoHeld) {
+            GetRecoveryManager()->ReleaseRedoReplay();
+        }
+        m_chain.clear();
+        return false;
+    }
+
+    if (!PrepareDeltaCheckpoint()) {
+        if (redoHeld) {
+            GetRecoveryManager()->ReleaseRedoReplay();
+        }
+        m_chain.clear();
         return false;
     }
 
     if (!CreateTpcRecoveryFile()) {
+        if (redoHeld) {
+            GetRecoveryManager()->ReleaseRedoReplay();
+        }
+        m_chain.clear();
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create tpc recovery file");
         return false;
     }
@@ -140,6 +176,10 @@ bool CheckpointManager::CreateSnapShot()
     MoveToNextPhase();
     m_lock.WrUnlock();
 
+    if (redoHeld) {
+        GetRecoveryManager()->ReleaseRedoReplay();
+    }
+
     return !m_errorSet;
 }
 
@@ -189,6 +229,13 @@ bool CheckpointManager::BeginCheckpoint()
         CompleteCheckpoint();
     }
 
+    // A failed checkpoint drops its deleted keys and does not extend the chain,
+    // so the next checkpoint must be a full checkpoint.
+    ClearDeletedKeys();
+    if (m_errorSet) {
+        m_chain.clear();
+    }
+
     // No locking required here, as the checkpoint workers have already exited.
     UnlockAndClearTables(m_tasksList);
     m_numCpTasks = 0;
@@ -234,6 +281,10 @@ bool CheckpointManager::Abort()
         UnlockAndClearTables(m_finishedTasks);
         m_numCpTasks = 0;
 
+        // The deleted keys of this checkpoint are dropped, so the next one must be a full checkpoint.
+        ClearDeletedKeys();
+        m_chain.clear();
+
         // Move to rest
         m_lock.WrLock();
         MoveToNextPhase();
@@ -459,6 +510,191 @@ void CheckpointManager::ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType
             MOT_LOG_ERROR("Unknown transaction start phase: %s", CheckpointManager::PhaseToString(startPhase));
             MOT_ASSERT(false);
     }
+
+    if (type == DEL) {
+        RecordDeletedKey(txnMan, origRow);
+    }
+}
+
+bool CheckpointManager::DeletedKeys::Append(const uint8_t* key, uint16_t keyLen)
+{
+    CheckpointUtils::DelEntryHeader entryHeader{keyLen};
+    size_t needed = m_size + sizeof(CheckpointUtils::DelEntryHeader) + keyLen;
+    if (needed > m_capacity) {
+        size_t capacity = std::max(needed, std::max(m_capacity * 2, (size_t)MAX_KEY_SIZE));
+        char* keys = (char*)realloc(m_keys, capacity);
+        if (keys == nullptr) {
+            return false;
+        }
+        m_keys = keys;
+        m_capacity = capacity;
+    }
+
+    errno_t erc =
+        memcpy_s(m_keys + m_size, m_capacity - m_size, &entryHeader, sizeof(CheckpointUtils::DelEntryHeader));
+    securec_check(erc, "\0", "\0");
+    m_size += sizeof(CheckpointUtils::DelEntryHeader);
+    erc = memcpy_s(m_keys + m_size, m_capacity - m_size, key, keyLen);
+    securec_check(erc, "\0", "\0");
+    m_size += keyLen;
+    m_numKeys++;
+    return true;
+}
+
+bool CheckpointManager::DeletedKeys::Merge(const DeletedKeys& other)
+{
+    size_t needed = m_size + other.m_size;
+    if (needed > m_capacity) {
+        char* keys = (char*)realloc(m_keys, needed);
+        if (keys == nullptr) {
+            return false;
+        }
+        m_keys = keys;
+        m_capacity = needed;
+    }
+
+    if (other.m_size > 0) {
+        errno_t erc = memcpy_s(m_keys + m_size, m_capacity - m_size, other.m_keys, other.m_size);
+        securec_check(erc, "\0", "\0");
+        m_size += other.m_size;
+        m_numKeys += other.m_numKeys;
+    }
+    return true;
+}
+
+void CheckpointManager::RecordDeletedKey(TxnManager* txn, Row* row)
+{
+    // Deletes that started commit before the CAPTURE phase are not part of the current checkpoint's
+    // snapshot, so they belong to it. The rest belong to the next checkpoint, which uses the other NA bit.
+    CheckpointPhase startPhase = txn->m_checkpointPhase;
+    bool nextCheckpoint = (startPhase == CAPTURE || startPhase == COMPLETE);
+    int bucket = (txn->m_checkpointNABit != nextCheckpoint) ? 1 : 0;
+
+    MOTThreadId tid = MOTCurrThreadId;
+    if (tid == INVALID_THREAD_ID || tid >= GetMaxThreadCount()) {
+        m_deltaLock.lock();
+        m_deletedKeysLost[bucket] = true;
+        m_deltaLock.unlock();
+        return;
+    }
+
+    ThreadDeletedKeys& threadKeys = m_threadDeletedKeys[tid];
+    if (GetGlobalConfiguration().m_maxCheckpointDeltas == 0) {
+        // not tracked, the checkpoint this delete belongs to cannot be a delta checkpoint
+        threadKeys.m_lock.lock();
+        threadKeys.m_lost[bucket] = true;
+        threadKeys.m_lock.unlock();
+        return;
+    }
+
+    MaxKey key;
+    Table* table = row->GetTable();
+    Index* index = table->GetPrimaryIndex();
+    key.InitKey(index->GetKeyLength());
+    index->BuildKey(table, row, &key);
+
+    // the lock of our own buffer is only contended by the checkpoint taking the keys
+    threadKeys.m_lock.lock();
+    if (!threadKeys.m_lost[bucket]) {
+        DeletedKeys& keys = threadKeys.m_keys[bucket][table->GetTableId()];
+        if (!keys.Append(key.GetKeyBuf(), key.GetKeyLength())) {
+            MOT_LOG_WARN("Failed to record deleted key of table %u, next checkpoint will be a full checkpoint",
+                table->GetTableId());
+            threadKeys.m_lost[bucket] = true;
+        }
+    }
+    threadKeys.m_lock.unlock();
+}
+
+bool CheckpointManager::CollectDeletedKeys(std::unordered_map<uint32_t, DeletedKeys>& deletedKeys)
+{
+    int bucket = m_availableBit ? 0 : 1;
+    bool keysLost = false;
+
+    m_deltaLock.lock();
+    keysLost = m_deletedKeysLost[bucket];
+    m_deltaLock.unlock();
+
+    for (uint16_t i = 0; i < GetMaxThreadCount(); ++i) {
+        ThreadDeletedKeys& threadKeys = m_threadDeletedKeys[i];
+        std::unordered_map<uint32_t, DeletedKeys> keys;
+
+        // take the buffer, so that the thread is not held while we merge it
+        threadKeys.m_lock.lock();
+        keys.swap(threadKeys.m_keys[bucket]);
+        keysLost = keysLost || threadKeys.m_lost[bucket];
+        threadKeys.m_lock.unlock();
+
+        if (keysLost) {
+            continue;
+        }
+
+        for (std::unordered_map<uint32_t, DeletedKeys>::iterator it = keys.begin(); it != keys.end(); ++it) {
+            if (!deletedKeys[it->first].Merge(it->second)) {
+                MOT_LOG_ERROR("CollectDeletedKeys: failed to merge the deleted keys of table %u", it->first);
+                keysLost = true;
+                break;
+            }
+        }
+    }
+    return !keysLost;
+}
+
+bool CheckpointManager::DeletedKeysLost()
+{
+    int bucket = m_availableBit ? 0 : 1;
+
+    m_deltaLock.lock();
+    bool keysLost = m_deletedKeysLost[bucket];
+    m_deltaLock.unlock();
+
+    for (uint16_t i = 0; i < GetMaxThreadCount() && !keysLost; ++i) {
+        ThreadDeletedKeys& threadKeys = m_threadDeletedKeys[i];
+        threadKeys.m_lock.lock();
+        keysLost = threadKeys.m_lost[bucket];
+        threadKeys.m_lock.unlock();
+    }
+    return keysLost;
+}
+
+void CheckpointManager::OnTableTruncate(Table* table)
+{
+    m_deltaLock.lock();
+    (void)m_truncatedTables.insert(table->GetTableId());
+    m_deltaLock.unlock();
+}
+
+uint64_t CheckpointManager::GetDeltaBaseCsn(Table* table)
+{
+    uint32_t tableId = table->GetTableId();
+    m_deltaLock.lock();
+    bool reset = (m_truncatedTables.erase(tableId) > 0) || !m_isDelta;
+    if (!reset) {
+        // a table that is not in the chain (or was re-created with the same id) is written in full
+        std::map<uint32_t, uint64_t>::iterator it = m_chainTables.find(tableId);
+        reset = (it == m_chainTables.end() || it->second != table->GetTableExId());
+    }
+    if (reset && m_isDelta) {
+        (void)m_resetTables.insert(tableId);
+    }
+    m_deltaLock.unlock();
+    return reset ? 0 : m_chainMaxCsn;
+}
+
+void CheckpointManager::ClearDeletedKeys()
+{
+    int bucket = m_availableBit ? 0 : 1;
+    m_deltaLock.lock();
+    m_deletedKeysLost[bucket] = false;
+    m_deltaLock.unlock();
+
+    for (uint16_t i = 0; i < GetMaxThreadCount(); ++i) {
+        ThreadDeletedKeys& threadKeys = m_threadDeletedKeys[i];
+        threadKeys.m_lock.lock();
+        threadKeys.m_keys[bucket].clear();
+        threadKeys.m_lost[bucket] = false;
+        threadKeys.m_lock.unlock();
+    }
 }
 
 void CheckpointManager::FillTasksQueue()
@@ -486,7 +722,7 @@ void CheckpointManager::UnlockAndClearTables(std::list<Table*>& tables)
     tables.clear();
 }
 
-void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
+void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, uint64_t maxCsn, bool success)
 {
     MOT_ASSERT(table);
     if (success) { /* only successful tasks are added to the map file */
@@ -502,6 +738,8 @@ void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
             std::lock_guard<std::mutex> guard(m_tasksMutex);
             m_mapfileInfo.push_back(entry);
             m_finishedTasks.push_back(table);
+            m_inProgressTables[entry->m_tableId] = table->GetTableExId();
+            m_inProgressMaxCsn = std::max(m_inProgressMaxCsn, maxCsn);
         } else {
             OnError(CheckpointWorkerPool::ErrCodes::MEMORY, "Failed to allocate map file entry");
             return;
@@ -521,6 +759,16 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    if (m_isDelta && !CreateDeltaFiles()) {
+        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create delta files");
+        return;
+    }
+
+    if (!CreateChainFile()) {
+        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create chain file");
+        return;
+    }
+
     if (!CreateCheckpointMap()) {
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create map file");
         return;
@@ -554,10 +802,22 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    if (!m_isDelta) {
+        m_chain.clear();
+        m_chainMaxCsn = 0;
+    }
+    m_chain.push_back(m_inProgressId);
+    m_chainMaxCsn = std::max(m_chainMaxCsn, m_inProgressMaxCsn);
+    m_chainTables.swap(m_inProgressTables);
+    m_inProgressTables.clear();
+
     RemoveOldCheckpoints(m_inProgressId);
     m_inProcessTxnsLsn = 0;
     m_numSerializedEntries = 0;
-    MOT_LOG_INFO("Checkpoint [%lu] completed", m_inProgressId);
+    MOT_LOG_INFO("Checkpoint [%lu] completed (%s, chain length %lu)",
+        m_inProgressId,
+        m_isDelta ? "delta" : "full",
+        m_chain.size());
 }
 
 void CheckpointManager::DestroyCheckpointers()
@@ -570,8 +830,8 @@ void CheckpointManager::DestroyCheckpointers()
 
 void CheckpointManager::CreateCheckpointers()
 {
-    m_checkpointers = new (std::nothrow)
-        CheckpointWorkerPool(m_numThreads, !m_availableBit, m_tasksList, m_cpSegThreshold, m_inProgressId, *this);
+    m_checkpointers = new (std::nothrow) CheckpointWorkerPool(
+        m_numThreads, !m_availableBit, m_tasksList, m_cpSegThreshold, m_inProgressId, m_isDelta, *this);
 }
 
 void CheckpointManager::Capture()
@@ -731,6 +991,234 @@ bool CheckpointManager::CreateCheckpointMap()
     return ret;
 }
 
+static bool IsChainFile(const char* name)
+{
+    // data, deleted keys and map files of the previous checkpoints are needed to recover a delta checkpoint
+    const char* suffixes[] = {
+        CheckpointUtils::cpFileSuffix, CheckpointUtils::delFileSuffix, CheckpointUtils::mapFileSuffix};
+    size_t nameLen = strlen(name);
+    for (const char* suffix : suffixes) {
+        size_t suffixLen = strlen(suffix);
+        if (nameLen > suffixLen && strcmp(name + nameLen - suffixLen, suffix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CheckpointManager::PrepareDeltaCheckpoint()
+{
+    m_isDelta = false;
+    m_inProgressMaxCsn = 0;
+    m_inProgressTables.clear();
+    m_resetTables.clear();
+
+    // a full checkpoint is taken when the chain is empty or already holds the maximal number of deltas
+    uint32_t maxDeltas = GetGlobalConfiguration().m_maxCheckpointDeltas;
+    if (maxDeltas == 0 || m_chain.empty() || m_chain.size() > maxDeltas || m_chain.back() != GetId()) {
+        return true;
+    }
+
+    if (DeletedKeysLost()) {
+        MOT_LOG_INFO("Deleted keys were not recorded, checkpoint %lu will be a full checkpoint", m_inProgressId);
+        return true;
+    }
+
+    std::string parentDir;
+    std::string workingDir;
+    if (!CheckpointUtils::SetWorkingDir(parentDir, GetId()) ||
+        !CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "failed to setup working dir");
+        return false;
+    }
+
+    // Link the files of the previous checkpoints, so that each checkpoint directory is self-contained
+    // and old directories can still be removed once a new checkpoint is completed.
+    DIR* dir = opendir(parentDir.c_str());
+    if (dir == nullptr) {
+        MOT_LOG_ERROR("PrepareDeltaCheckpoint: failed to open dir: %s, error %d - %s",
+            parentDir.c_str(),
+            errno,
+            gs_strerror(errno));
+        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "failed to open previous checkpoint dir", parentDir.c_str());
+        return false;
+    }
+
+    bool ret = true;
+    struct dirent* p;
+    std::string srcName;
+    std::string dstName;
+    while ((p = readdir(dir))) {
+        if (!IsChainFile(p->d_name)) {
+            continue;
+        }
+        CheckpointUtils::MakeFilename(srcName, parentDir);
+        srcName.append(p->d_name);
+        CheckpointUtils::MakeFilename(dstName, workingDir);
+        dstName.append(p->d_name);
+        if (!CheckpointUtils::LinkFile(srcName, dstName)) {
+            OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "failed to link previous checkpoint file", p->d_name);
+            ret = false;
+            break;
+        }
+    }
+    closedir(dir);
+
+    if (ret) {
+        m_isDelta = true;
+        MOT_LOG_INFO("Checkpoint %lu is a delta checkpoint of %lu (base %lu, csn %lu)",
+            m_inProgressId,
+            GetId(),
+            m_chain.front(),
+            m_chainMaxCsn);
+    }
+    return ret;
+}
+
+bool CheckpointManager::CreateDeltaFiles()
+{
+    std::string workingDir;
+    if (!CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+        return false;
+    }
+
+    // take the deleted keys of this checkpoint, so that committing transactions are not held during the writes
+    std::unordered_map<uint32_t, DeletedKeys> deletedKeys;
+    if (!CollectDeletedKeys(deletedKeys)) {
+        MOT_LOG_ERROR("CreateDeltaFiles: deleted keys were not recorded");
+        return false;
+    }
+
+    for (std::map<uint32_t, uint64_t>::iterator it = m_inProgressTables.begin(); it != m_inProgressTables.end();
+         ++it) {
+        uint32_t tableId = it->first;
+        uint64_t flags = 0;
+        DeletedKeys* keys = nullptr;
+        if (m_resetTables.find(tableId) != m_resetTables.end()) {
+            flags |= CheckpointUtils::DELTA_FLAG_RESET;
+        } else {
+            std::unordered_map<uint32_t, DeletedKeys>::iterator keysIt = deletedKeys.find(tableId);
+            if (keysIt != deletedKeys.end()) {
+                keys = &keysIt->second;
+            }
+        }
+
+        if (!CreateDeltaFile(workingDir, tableId, it->second, flags, keys)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CheckpointManager::CreateDeltaFile(
+    std::string& workingDir, uint32_t tableId, uint64_t exId, uint64_t flags, DeletedKeys* keys)
+{
+    int fd = -1;
+    std::string fileName;
+    bool ret = false;
+
+    CheckpointUtils::MakeDelFilename(tableId, fileName, workingDir, m_inProgressId);
+    if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+        MOT_LOG_ERROR(
+            "CreateDeltaFile: failed to create file '%s' - %d - %s", fileName.c_str(), errno, gs_strerror(errno));
+        return false;
+    }
+
+    do {
+        CheckpointUtils::DelFileHeader delFileHeader{
+            {CP_MGR_MAGIC, tableId, exId, (keys != nullptr) ? keys->m_numKeys : 0}, flags};
+        size_t wrStat = CheckpointUtils::WriteFile(fd, (char*)&delFileHeader, sizeof(CheckpointUtils::DelFileHeader));
+        if (wrStat != sizeof(CheckpointUtils::DelFileHeader)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to write header (%d) %d %s", wrStat, errno, gs_strerror(errno));
+            break;
+        }
+
+        if (keys != nullptr && keys->m_size > 0) {
+            wrStat = CheckpointUtils::WriteFile(fd, keys->m_keys, keys->m_size);
+            if (wrStat != keys->m_size) {
+                MOT_LOG_ERROR("CreateDeltaFile: failed to write %lu deleted keys of table %u (%d) %d %s",
+                    keys->m_numKeys,
+                    tableId,
+                    wrStat,
+                    errno,
+                    gs_strerror(errno));
+                break;
+            }
+        }
+
+        if (CheckpointUtils::FlushFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaFile: failed to flush file");
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    if (CheckpointUtils::CloseFile(fd)) {
+        MOT_LOG_ERROR("CreateDeltaFile: failed to close file");
+        ret = false;
+    }
+    return ret;
+}
+
+bool CheckpointManager::CreateChainFile()
+{
+    int fd = -1;
+    std::string fileName;
+    std::string workingDir;
+    bool ret = false;
+
+    std::vector<uint64_t> chain;
+    if (m_isDelta) {
+        chain = m_chain;
+    }
+    chain.push_back(m_inProgressId);
+
+    do {
+        if (!CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+            break;
+        }
+
+        CheckpointUtils::MakeChainFilename(fileName, workingDir, m_inProgressId);
+        if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+            MOT_LOG_ERROR(
+                "CreateChainFile: failed to create file '%s' - %d - %s", fileName.c_str(), errno, gs_strerror(errno));
+            break;
+        }
+
+        CheckpointUtils::ChainFileHeader chainFileHeader{
+            CP_MGR_MAGIC, chain.size(), std::max(m_isDelta ? m_chainMaxCsn : 0, m_inProgressMaxCsn)};
+        size_t wrStat =
+            CheckpointUtils::WriteFile(fd, (char*)&chainFileHeader, sizeof(CheckpointUtils::ChainFileHeader));
+        if (wrStat != sizeof(CheckpointUtils::ChainFileHeader)) {
+            MOT_LOG_ERROR(
+                "CreateChainFile: failed to write chain file's header (%d) %d %s", wrStat, errno, gs_strerror(errno));
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        size_t chainSize = chain.size() * sizeof(uint64_t);
+        if (CheckpointUtils::WriteFile(fd, (char*)chain.data(), chainSize) != chainSize) {
+            MOT_LOG_ERROR("CreateChainFile: failed to write chain file's entries");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::FlushFile(fd)) {
+            MOT_LOG_ERROR("CreateChainFile: failed to flush chain file");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::CloseFile(fd)) {
+            MOT_LOG_ERROR("CreateChainFile: failed to close chain file");
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    return ret;
+}
+
 void CheckpointManager::OnError(int errCode, const char* errMsg, const char* optionalMsg)
 {
     m_stopFlag = true;
@@ -27,6 +27,10 @@
 
 #include <atomic>
 #include <iostream>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
 #include <pthread.h>
 #include "rw_lock.h"
 #include "global.h"
@@ -109,14 +113,23 @@ public:
      */
     void ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType type);
 
+    /**
+     * @brief Records that a table was truncated, so the next checkpoint writes it in full.
+     * @param table The table's pointer.
+     */
+    void OnTableTruncate(Table* table);
+
     /**
      * @brief Checkpoint task completion callback
      * @param checkpointId The checkpoint's id.
      * @param table The table's pointer.
      * @param numSegs number of segments written.
+     * @param maxCsn The maximal commit sequence number of the rows written.
      * @param success Indicates a success or a failure.
      */
-    virtual void TaskDone(Table* table, uint32_t numSegs, bool success);
+    virtual void TaskDone(Table* table, uint32_t numSegs, uint64_t maxCsn, bool success);
+
+    virtual uint64_t GetDeltaBaseCsn(Table* table);
 
     virtual bool ShouldStop() const
     {
@@ -176,6 +189,19 @@ public:
         return m_lastReplayLsn;
     }
 
+    /**
+     * @brief Sets the delta checkpoint chain of the last valid checkpoint, used after recovery.
+     * @param chain The checkpoint ids of the chain, the full checkpoint first.
+     * @param maxCsn The maximal commit sequence number contained in the chain.
+     * @param tables The tables contained in the chain (internal id to external id).
+     */
+    void SetChain(const std::vector<uint64_t>& chain, uint64_t maxCsn, const std::map<uint32_t, uint64_t>& tables)
+    {
+        m_chain = chain;
+        m_chainMaxCsn = maxCsn;
+        m_chainTables = tables;
+    }
+
     void FetchRdLock()
     {
         (void)pthread_rwlock_rdlock(&m_fetchLock);
@@ -200,6 +226,65 @@ public:
     };
 
 private:
+    /**
+     * @struct DeletedKeys
+     * @brief Primary keys of the rows of a table that were deleted since the previous checkpoint,
+     * serialized as a sequence of DelEntryHeader and key.
+     */
+    struct DeletedKeys {
+        DeletedKeys() : m_numKeys(0), m_size(0), m_capacity(0), m_keys(nullptr)
+        {}
+
+        ~DeletedKeys()
+        {
+            if (m_keys != nullptr) {
+                free(m_keys);
+                m_keys = nullptr;
+            }
+        }
+
+        DeletedKeys(const DeletedKeys& orig) = delete;
+
+        DeletedKeys& operator=(const DeletedKeys&) = delete;
+
+        /**
+         * @brief Appends a key to the buffer.
+         * @return Boolean value denoting success or failure.
+         */
+        bool Append(const uint8_t* key, uint16_t keyLen);
+
+        /**
+         * @brief Appends all the keys of another buffer to this buffer.
+         * @return Boolean value denoting success or failure.
+         */
+        bool Merge(const DeletedKeys& other);
+
+        uint64_t m_numKeys;
+
+        size_t m_size;
+
+        size_t m_capacity;
+
+        char* m_keys;
+    };
+
+    /**
+     * @struct ThreadDeletedKeys
+     * @brief The deleted keys recorded by the transactions of one thread, zigzag on the NA bit.
+     * Only the owning thread and the checkpoint thread take the lock, so deletes of different
+     * threads never contend. The checkpoint merges the buffers of all threads.
+     */
+    struct ThreadDeletedKeys {
+        ThreadDeletedKeys() : m_lost{false, false}
+        {}
+
+        spin_lock m_lock;
+
+        std::unordered_map<uint32_t, DeletedKeys> m_keys[2];
+
+        bool m_lost[2];
+    };
+
     RwLock m_lock;
 
     RedoLogHandler* m_redoLogHandler;
@@ -277,6 +362,41 @@ private:
     // this lock guards gs_ctl checkpoint fetching
     pthread_rwlock_t m_fetchLock;
 
+    // The checkpoint ids of the last valid checkpoint's chain, the full checkpoint first.
+    // Empty when the next checkpoint must be a full one.
+    std::vector<uint64_t> m_chain;
+
+    // The maximal commit sequence number contained in the chain
+    uint64_t m_chainMaxCsn;
+
+    // The tables contained in the chain (internal id to external id)
+    std::map<uint32_t, uint64_t> m_chainTables;
+
+    // Current (in-progress) checkpoint writes only the rows that changed since the previous one
+    bool m_isDelta;
+
+    // The maximal commit sequence number written by the current checkpoint
+    uint64_t m_inProgressMaxCsn;
+
+    // The tables written by the current checkpoint (internal id to external id)
+    std::map<uint32_t, uint64_t> m_inProgressTables;
+
+    // The tables written in full by the current delta checkpoint
+    std::set<uint32_t> m_resetTables;
+
+    // The tables truncated since they were last checkpointed
+    std::set<uint32_t> m_truncatedTables;
+
+    // Deleted keys recorded by each thread, indexed by thread id
+    ThreadDeletedKeys* m_threadDeletedKeys;
+
+    // Deleted keys of a thread without a valid thread id could not be recorded,
+    // the checkpoint they belong to must be a full one
+    bool m_deletedKeysLost[2];
+
+    // Spinlock for the delta checkpoint tracking
+    spin_lock m_deltaLock;
+
     CheckpointPhase GetPhase() const
     {
         return m_phase;
@@ -383,6 +503,60 @@ private:
      */
     bool CreateTpcRecoveryFile();
 
+    /**
+     * @brief Decides whether the current checkpoint is a delta checkpoint and links the
+     * files of the previous checkpoint into its directory.
+     * @return Boolean value denoting success or failure.
+     */
+    bool PrepareDeltaCheckpoint();
+
+    /**
+     * @brief Records the primary key of a row deleted by a committing transaction.
+     * @param txn Transaction's TxnManger pointer.
+     * @param row The deleted row.
+     */
+    void RecordDeletedKey(TxnManager* txn, Row* row);
+
+    /**
+     * @brief Writes the deleted keys file of each table of a delta checkpoint.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateDeltaFiles();
+
+    /**
+     * @brief Writes the deleted keys file of a table.
+     * @param workingDir The checkpoint directory.
+     * @param tableId The table's id.
+     * @param exId The table's external id.
+     * @param flags The delta flags of the table.
+     * @param keys The deleted keys of the table, or null if there are none.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateDeltaFile(std::string& workingDir, uint32_t tableId, uint64_t exId, uint64_t flags, DeletedKeys* keys);
+
+    /**
+     * @brief Writes the chain file that lists the checkpoints needed to recover the current one.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateChainFile();
+
+    /**
+     * @brief Takes the deleted keys that belong to the current checkpoint out of the buffers of all threads.
+     * @param deletedKeys Receives the deleted keys, per table.
+     * @return False if some deleted keys could not be recorded.
+     */
+    bool CollectDeletedKeys(std::unordered_map<uint32_t, DeletedKeys>& deletedKeys);
+
+    /**
+     * @brief Checks whether some deleted keys that belong to the current checkpoint could not be recorded.
+     */
+    bool DeletedKeysLost();
+
+    /**
+     * @brief Drops the deleted keys that belong to the current checkpoint.
+     */
+    void ClearDeletedKeys();
+
     /**
      * @brief Creates a file that indicates checkpoint completion.
      * @return Boolean value denoting success or failure.
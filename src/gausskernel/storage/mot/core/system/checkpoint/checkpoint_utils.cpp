@@ -132,6 +132,15 @@ int FlushFile(int fd)
     return rc;
 }
 
+bool LinkFile(const std::string& srcName, const std::string& dstName)
+{
+    if (link(srcName.c_str(), dstName.c_str()) != 0) {
+        MOT_REPORT_SYSTEM_ERROR(link, "N/A", "Failed to link file %s to %s", srcName.c_str(), dstName.c_str());
+        return false;
+    }
+    return true;
+}
+
 bool SeekFile(int fd, uint64_t offset)
 {
     int rc = lseek(fd, offset, SEEK_SET);
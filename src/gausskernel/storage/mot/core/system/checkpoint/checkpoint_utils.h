@@ -124,6 +124,14 @@ int FlushFile(int fd);
  */
 bool SeekFile(int fd, uint64_t offset);
 
+/**
+ * @brief A wrapper function that creates a hard link to a file.
+ * @param srcName The existing file.
+ * @param dstName The link to create.
+ * @return Boolean value denoting success or failure.
+ */
+bool LinkFile(const std::string& srcName, const std::string& dstName);
+
 /**
  * @brief Frees a row's stable version row.
  * @param row The row which stable version needs to be freed.
@@ -180,6 +188,12 @@ static const char* tpcFileSuffix = ".tpc";
 // End file suffix
 static const char* validFileSuffix = ".end";
 
+// Deleted keys file suffix (delta checkpoints)
+static const char* delFileSuffix = ".del";
+
+// Checkpoint chain file suffix
+static const char* chainFileSuffix = ".chain";
+
 // Max path len
 static const size_t maxPath = 1024;
 
@@ -250,17 +264,40 @@ inline void MakeMapFilename(std::string& fileName, std::string& workingDir, uint
  * @param fileName The returned filename string.
  * @param workingDir The directory in which the file should be located.
  * @param seg The segment number.
+ * @param deltaId The id of the delta checkpoint that wrote the file, zero for a full checkpoint.
  */
-inline void MakeCpFilename(uint64_t tableId, std::string& fileName, std::string& workingDir, int seg = 0)
+inline void MakeCpFilename(
+    uint64_t tableId, std::string& fileName, std::string& workingDir, int seg = 0, uint64_t deltaId = 0)
 {
     MakeFilename(fileName, workingDir);
     fileName.append("tab_");
     fileName.append(std::to_string(tableId));
     fileName.append("_");
     fileName.append(std::to_string(seg));
+    if (deltaId != 0) {
+        fileName.append("_");
+        fileName.append(std::to_string(deltaId));
+    }
     fileName.append(cpFileSuffix);
 }
 
+/**
+ * @brief Creates a delta checkpoint deleted keys filename
+ * @param tableId The tabled id that this file contains.
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param deltaId The id of the delta checkpoint that wrote the file.
+ */
+inline void MakeDelFilename(uint64_t tableId, std::string& fileName, std::string& workingDir, uint64_t deltaId)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append("tab_");
+    fileName.append(std::to_string(tableId));
+    fileName.append("_");
+    fileName.append(std::to_string(deltaId));
+    fileName.append(delFileSuffix);
+}
+
 /**
  * @brief Creates a checkpoint table metadata filename
  * @param tableId The tabled id that this file contains.
@@ -287,6 +324,19 @@ inline void MakeTpcFilename(std::string& fileName, std::string& workingDir, uint
     fileName.append(tpcFileSuffix);
 }
 
+/**
+ * @brief Creates a checkpoint chain filename
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param cpId The checkpoint id.
+ */
+inline void MakeChainFilename(std::string& fileName, std::string& workingDir, uint64_t cpId)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append(std::to_string(cpId));
+    fileName.append(chainFileSuffix);
+}
+
 /**
  * @brief Creates a checkpoint end/valid filename
  * @param fileName The returned filename string.
@@ -348,6 +398,24 @@ struct TpcEntryHeader {
     uint64_t m_len;
 };
 
+/** @var The table was written in full, the checkpoints below the delta should be ignored for it. */
+static const uint64_t DELTA_FLAG_RESET = 0x1;
+
+struct DelFileHeader {
+    FileHeader m_fileHeader;
+    uint64_t m_flags;
+};
+
+struct DelEntryHeader {
+    uint16_t m_keyLen;
+};
+
+struct ChainFileHeader {
+    uint64_t m_magic;
+    uint64_t m_numLevels;
+    uint64_t m_maxCsn;
+};
+
 /**
  * @brief Produces a pretty hex printout of a given buffer to stderr
  * @param msg A text the will be displayed before the hex data printout.
@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------
  */
 
+#include <algorithm>
 #include <thread>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -122,7 +123,8 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     return true;
 }
 
-int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted)
+int CheckpointWorkerPool::Checkpoint(
+    Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted, uint64_t minCsn, uint64_t& maxCsn)
 {
     Row* mainRow = sentinel->GetData();
     Row* stableRow = nullptr;
@@ -163,15 +165,19 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                 break;
             }
 
-            if (!Write(buffer, stableRow, fd)) {
-                wrote = -1;
-            } else {
-                if (isDeleted == false) {
-                    CheckpointUtils::DestroyStableRow(stableRow);
-                    sentinel->SetStable(nullptr);
+            // a delta checkpoint skips rows that did not change since the previous checkpoint
+            if (stableRow->GetCommitSequenceNumber() > minCsn) {
+                if (!Write(buffer, stableRow, fd)) {
+                    wrote = -1;
+                    break;
                 }
+                maxCsn = std::max(maxCsn, stableRow->GetCommitSequenceNumber());
                 wrote = 1;
             }
+            if (isDeleted == false) {
+                CheckpointUtils::DestroyStableRow(stableRow);
+                sentinel->SetStable(nullptr);
+            }
             break;
         } else { /* no stable version */
             if (stableRow == nullptr) {
@@ -180,10 +186,13 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                     break;
                 }
                 sentinel->SetStableStatus(!m_na);
-                if (!Write(buffer, mainRow, fd)) {
-                    wrote = -1;  // we failed to write, set error
-                } else {
-                    wrote = 1;
+                if (mainRow->GetCommitSequenceNumber() > minCsn) {
+                    if (!Write(buffer, mainRow, fd)) {
+                        wrote = -1;  // we failed to write, set error
+                    } else {
+                        maxCsn = std::max(maxCsn, mainRow->GetCommitSequenceNumber());
+                        wrote = 1;
+                    }
                 }
                 break;
             }
@@ -274,6 +283,7 @@ void CheckpointWorkerPool::WorkerFunc()
         uint32_t tableId = 0;
         uint64_t exId = 0;
         uint32_t maxSegId = 0;
+        uint64_t maxCsn = 0;
         bool taskSucceeded = false;
 
         if (m_cpManager.ShouldStop()) {
@@ -299,7 +309,8 @@ void CheckpointWorkerPool::WorkerFunc()
                 uint64_t numOps = 0;
                 clock_gettime(CLOCK_MONOTONIC, &start);
 
-                errCode = WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, maxSegId, numOps);
+                errCode =
+                    WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, maxSegId, numOps, maxCsn);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR(
                         "CheckpointWorkerPool::WorkerFunc: failed to write table data file for table %u", tableId);
@@ -322,7 +333,7 @@ void CheckpointWorkerPool::WorkerFunc()
                     numOps);
             } while (0);
 
-            m_cpManager.TaskDone(table, maxSegId, taskSucceeded);
+            m_cpManager.TaskDone(table, maxSegId, maxCsn, taskSucceeded);
 
             if (!taskSucceeded) {
                 break;
@@ -340,7 +351,7 @@ void CheckpointWorkerPool::WorkerFunc()
 bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId)
 {
     std::string fileName;
-    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg, m_isDelta ? m_checkpointId : 0);
     if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
         MOT_LOG_ERROR("CheckpointWorkerPool::BeginFile: failed to create file: %s", fileName.c_str());
         return false;
@@ -465,7 +476,8 @@ bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
 }
 
 CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* table, Buffer* buffer,
-    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps)
+    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps,
+    uint64_t& maxCsn)
 {
     uint32_t tableId = table->GetTableId();
     uint64_t exId = table->GetTableExId();
@@ -476,6 +488,8 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
 
     maxSegId = 0;
     numOps = 0;
+    maxCsn = 0;
+    uint64_t minCsn = m_cpManager.GetDeltaBaseCsn(table);
     Index* index = table->GetPrimaryIndex();
     if (index == nullptr) {
         MOT_LOG_ERROR("CheckpointWorkerPool::WriteTableDataFile: failed to get primary index for table %u", tableId);
@@ -506,7 +520,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
             it->Next();
             continue;
         }
-        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted);
+        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted, minCsn, maxCsn);
         if (isDeleted) {
             deletedList[deletedListLocation++] = sentinel;
             ExecuteMicroGcTransaction(deletedList, gcSession, table, deletedListLocation, DELETE_LIST_SIZE);
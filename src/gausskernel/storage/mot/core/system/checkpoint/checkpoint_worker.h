@@ -50,9 +50,17 @@ public:
      * @param checkpointId The checkpoint's id.
      * @param table The table's pointer.
      * @param numSegs number of segments written.
+     * @param maxCsn The maximal commit sequence number of the rows written.
      * @param success Indicates a success or a failure.
      */
-    virtual void TaskDone(Table* table, uint32_t numSegs, bool success) = 0;
+    virtual void TaskDone(Table* table, uint32_t numSegs, uint64_t maxCsn, bool success) = 0;
+
+    /**
+     * @brief Retrieves which rows of a table a delta checkpoint should write.
+     * @param table The table's pointer.
+     * @return Rows with a higher commit sequence number are written, zero means all the rows.
+     */
+    virtual uint64_t GetDeltaBaseCsn(Table* table) = 0;
 
     /**
      * @brief Checks if the thread should terminate it work
@@ -78,8 +86,15 @@ public:
  */
 class CheckpointWorkerPool {
 public:
-    CheckpointWorkerPool(int n, bool b, std::list<Table*>& l, uint32_t s, uint64_t id, CheckpointManagerCallbacks& m)
-        : m_numWorkers(n), m_tasksList(l), m_checkpointId(id), m_na(b), m_cpManager(m), m_checkpointSegsize(s)
+    CheckpointWorkerPool(int n, bool b, std::list<Table*>& l, uint32_t s, uint64_t id, bool delta,
+        CheckpointManagerCallbacks& m)
+        : m_numWorkers(n),
+          m_tasksList(l),
+          m_checkpointId(id),
+          m_na(b),
+          m_isDelta(delta),
+          m_cpManager(m),
+          m_checkpointSegsize(s)
     {
         Start();
     }
@@ -114,9 +129,12 @@ private:
      * @param fd The file descriptor to write to.
      * @param threadId The thread id.
      * @param isDeleted The row delete status.
+     * @param minCsn Only a row version with a higher commit sequence number is written.
+     * @param maxCsn The maximal commit sequence number of the rows written so far.
      * @return -1 on error, 0 if nothing was written and 1 if the row was written.
      */
-    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted);
+    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted, uint64_t minCsn,
+        uint64_t& maxCsn);
 
     /**
      * @brief Pops a task (table pointer) from the tasks queue.
@@ -169,10 +187,11 @@ private:
      * @param threadId The thread id.
      * @param maxSegId The maximum segment ID of the table.
      * @param numOps The number of rows written.
+     * @param maxCsn The maximal commit sequence number of the rows written.
      * @return Returns the error code of type ErrCodes.
      */
     ErrCodes WriteTableDataFile(Table* table, Buffer* buffer, Sentinel** deletedList, GcManager* gcSession,
-        uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps);
+        uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps, uint64_t& maxCsn);
 
     bool FlushBuffer(int fd, Buffer* buffer);
 
@@ -196,6 +215,9 @@ private:
     // The current NotAvailable bit
     bool m_na;
 
+    // Writes only the rows that changed since the previous checkpoint
+    bool m_isDelta;
+
     // Checkpoint manager callbacks
     CheckpointManagerCallbacks& m_cpManager;
 
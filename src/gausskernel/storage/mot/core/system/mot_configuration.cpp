@@ -69,10 +69,16 @@ constexpr uint64_t MOTConfiguration::MAX_CHECKPOINT_SEGSIZE_BYTES;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_MAX_CHECKPOINT_DELTAS;
+constexpr uint32_t MOTConfiguration::MIN_MAX_CHECKPOINT_DELTAS;
+constexpr uint32_t MOTConfiguration::MAX_MAX_CHECKPOINT_DELTAS;
 // recovery configuration members
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_REDO_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::MIN_REDO_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::MAX_REDO_RECOVERY_WORKERS;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_LOG_RECOVERY_STATS;
 // machine configuration members
 constexpr uint16_t MOTConfiguration::DEFAULT_NUMA_NODES;
@@ -449,7 +455,9 @@ MOTConfiguration::MOTConfiguration()
       m_checkpointDir(DEFAULT_CHECKPOINT_DIR),
       m_checkpointSegThreshold(DEFAULT_CHECKPOINT_SEGSIZE_BYTES),
       m_checkpointWorkers(DEFAULT_CHECKPOINT_WORKERS),
+      m_maxCheckpointDeltas(DEFAULT_MAX_CHECKPOINT_DELTAS),
       m_checkpointRecoveryWorkers(DEFAULT_CHECKPOINT_RECOVERY_WORKERS),
+      m_redoRecoveryWorkers(DEFAULT_REDO_RECOVERY_WORKERS),
       m_abortBufferEnable(true),
       m_preAbort(true),
       m_validationLock(TxnValidation::TXN_VALIDATION_NO_WAIT),
@@ -555,7 +563,9 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseString(name, "checkpoint_dir", value, &m_checkpointDir)) {
     } else if (ParseUint64(name, "checkpoint_segsize", value, &m_checkpointSegThreshold)) {
     } else if (ParseUint32(name, "checkpoint_workers", value, &m_checkpointWorkers)) {
+    } else if (ParseUint32(name, "max_checkpoint_deltas", value, &m_maxCheckpointDeltas)) {
     } else if (ParseUint32(name, "checkpoint_recovery_workers", value, &m_checkpointRecoveryWorkers)) {
+    } else if (ParseUint32(name, "redo_recovery_workers", value, &m_redoRecoveryWorkers)) {
     } else if (ParseBool(name, "abort_buffer_enable", value, &m_abortBufferEnable)) {
     } else if (ParseBool(name, "pre_abort", value, &m_preAbort)) {
     } else if (ParseValidation(name, "validation_lock", value, &m_validationLock)) {
@@ -941,6 +951,11 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_WORKERS,
         MIN_CHECKPOINT_WORKERS,
         MAX_CHECKPOINT_WORKERS);
+    UPDATE_INT_CFG(m_maxCheckpointDeltas,
+        "max_checkpoint_deltas",
+        DEFAULT_MAX_CHECKPOINT_DELTAS,
+        MIN_MAX_CHECKPOINT_DELTAS,
+        MAX_MAX_CHECKPOINT_DELTAS);
 
     // Recovery configuration
     UPDATE_INT_CFG(m_checkpointRecoveryWorkers,
@@ -948,6 +963,11 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_RECOVERY_WORKERS,
         MIN_CHECKPOINT_RECOVERY_WORKERS,
         MAX_CHECKPOINT_RECOVERY_WORKERS);
+    UPDATE_INT_CFG(m_redoRecoveryWorkers,
+        "redo_recovery_workers",
+        DEFAULT_REDO_RECOVERY_WORKERS,
+        MIN_REDO_RECOVERY_WORKERS,
+        MAX_REDO_RECOVERY_WORKERS);
 
     // Tx configuration - not configurable yet
     if (m_loadExtraParams) {
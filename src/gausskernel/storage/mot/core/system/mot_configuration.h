@@ -172,6 +172,9 @@ public:
     /** @var number of worker threads to spawn to perform checkpoint. */
     uint32_t m_checkpointWorkers;
 
+    /** @var Maximum number of delta checkpoints between two full checkpoints (zero disables delta checkpoints). */
+    uint32_t m_maxCheckpointDeltas;
+
     /**********************************************************************/
     // Recovery configuration
     /**********************************************************************/
@@ -179,6 +182,9 @@ public:
     /** @var Specifies the number of workers used to recover from checkpoint. */
     uint32_t m_checkpointRecoveryWorkers;
 
+    /** @var Specifies the number of workers used to replay the redo log. */
+    uint32_t m_redoRecoveryWorkers;
+
     /**********************************************************************/
     // Transaction management variables (not configurable)
     /**********************************************************************/
@@ -456,12 +462,22 @@ public:
     static constexpr uint32_t MIN_CHECKPOINT_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_WORKERS = 1024;
 
+    /** @var Default maximum number of delta checkpoints between two full checkpoints. */
+    static constexpr uint32_t DEFAULT_MAX_CHECKPOINT_DELTAS = 0;
+    static constexpr uint32_t MIN_MAX_CHECKPOINT_DELTAS = 0;
+    static constexpr uint32_t MAX_MAX_CHECKPOINT_DELTAS = 64;
+
     /** ------------------ Default Recovery Configuration ------------ */
     /** @var Default number of workers used in recovery from checkpoint. */
     static constexpr uint32_t DEFAULT_CHECKPOINT_RECOVERY_WORKERS = 3;
     static constexpr uint32_t MIN_CHECKPOINT_RECOVERY_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_RECOVERY_WORKERS = 1024;
 
+    /** @var Default number of workers used in redo log replay (one means serial replay by the caller). */
+    static constexpr uint32_t DEFAULT_REDO_RECOVERY_WORKERS = 1;
+    static constexpr uint32_t MIN_REDO_RECOVERY_WORKERS = 1;
+    static constexpr uint32_t MAX_REDO_RECOVERY_WORKERS = 1024;
+
     /** @var Default enable log recovery statistics. */
     static constexpr bool DEFAULT_ENABLE_LOG_RECOVERY_STATS = false;
 
@@ -93,7 +93,7 @@ bool CheckpointRecovery::Recover()
         return true;
     }
 
-    if (m_tasksList.size() > 0) {
+    if (!m_tableIds.empty()) {
         if (GetGlobalConfiguration().m_enableIncrementalCheckpoint) {
             MOT_LOG_ERROR(
                 "CheckpointRecovery: recovery of MOT tables failed. MOT does not support incremental checkpoint");
@@ -122,9 +122,26 @@ bool CheckpointRecovery::Recover()
      */
     engine->GetCheckpointManager()->SetId(m_checkpointId);
 
-    MOT_LOG_INFO("Checkpoint Recovery: finished recovering %lu tables from checkpoint id: %lu",
+    /*
+     * Restore the delta checkpoint chain, so the next checkpoint can be a delta
+     * of the recovered one.
+     */
+    if (m_hasChainFile) {
+        std::map<uint32_t, uint64_t> chainTables;
+        for (auto it = m_tableIds.begin(); it != m_tableIds.end(); ++it) {
+            Table* table = GetTableManager()->GetTable(*it);
+            if (table != nullptr) {
+                chainTables[*it] = table->GetTableExId();
+            }
+        }
+        engine->GetCheckpointManager()->SetChain(m_chain, m_chainMaxCsn, chainTables);
+        GetRecoveryManager()->SetCsn(m_chainMaxCsn);
+    }
+
+    MOT_LOG_INFO("Checkpoint Recovery: finished recovering %lu tables from checkpoint id: %lu (chain length %lu)",
         m_tableIds.size(),
-        m_checkpointId);
+        m_checkpointId,
+        m_chain.size());
 
     m_tableIds.clear();
     MOTEngine::GetInstance()->GetCheckpointManager()->RemoveOldCheckpoints(m_checkpointId);
@@ -144,6 +161,24 @@ bool CheckpointRecovery::PerformRecovery()
         }
     }
 
+    // The full checkpoint is inserted first. Then each delta removes the deleted rows and the rows
+    // it replaces, and inserts its own rows.
+    static const TaskType stages[] = {TASK_REMOVE_DELETED_ROWS, TASK_REMOVE_ROWS, TASK_INSERT_ROWS};
+    const uint32_t numStages = sizeof(stages) / sizeof(stages[0]);
+    for (uint32_t level = 0; level < m_chain.size(); ++level) {
+        for (uint32_t stage = (level == 0) ? numStages - 1 : 0; stage < numStages && !m_errorSet; ++stage) {
+            if (!FillLevelTasks(level, stages[stage])) {
+                return false;
+            }
+            RunWorkers();
+        }
+    }
+
+    return true;
+}
+
+void CheckpointRecovery::RunWorkers()
+{
     std::vector<std::thread> threadPool;
     for (uint32_t i = 0; i < m_numWorkers; ++i) {
         threadPool.push_back(std::thread(CheckpointRecoveryWorker, this));
@@ -160,7 +195,42 @@ bool CheckpointRecovery::PerformRecovery()
             worker.join();
         }
     }
+}
+
+bool CheckpointRecovery::FillLevelTasks(uint32_t level, TaskType type)
+{
+    uint64_t deltaId = (level == 0) ? 0 : m_chain[level];
+    for (auto it = m_tableIds.begin(); it != m_tableIds.end(); ++it) {
+        uint32_t tableId = *it;
+        uint32_t firstLevel = m_tablesFirstLevel[tableId];
+        // a table is empty before its first level, so there is nothing to remove there
+        if (level < firstLevel || (level == firstLevel && type != TASK_INSERT_ROWS)) {
+            continue;
+        }
+
+        std::map<uint32_t, uint32_t>::iterator segIt = m_chainSegs[level].find(tableId);
+        if (segIt == m_chainSegs[level].end()) {
+            MOT_LOG_ERROR("CheckpointRecovery::FillLevelTasks: table %u is missing in checkpoint %lu",
+                tableId,
+                m_chain[level]);
+            return false;
+        }
 
+        uint32_t maxSegId = (type == TASK_REMOVE_DELETED_ROWS) ? 0 : segIt->second;
+        for (uint32_t seg = 0; seg <= maxSegId; seg++) {
+            Task* recoveryTask = new (std::nothrow) Task(tableId, seg, deltaId, type);
+            if (recoveryTask == nullptr) {
+                MOT_LOG_ERROR("CheckpointRecovery::FillLevelTasks: failed to allocate task object");
+                return false;
+            }
+            m_tasksList.push_back(recoveryTask);
+        }
+    }
+
+    MOT_LOG_DEBUG("CheckpointRecovery::FillLevelTasks: checkpoint %lu, type %u, %lu tasks",
+        m_chain[level],
+        (unsigned)type,
+        m_tasksList.size());
     return true;
 }
 
@@ -170,53 +240,186 @@ int CheckpointRecovery::FillTasksFromMapFile()
         return 0;  // fresh install probably. no error
     }
 
+    if (!ReadChainFile()) {
+        return -1;
+    }
+
+    m_chainSegs.resize(m_chain.size());
+    for (uint32_t level = 0; level < m_chain.size(); ++level) {
+        if (!ReadMapFile(m_chain[level], m_chainSegs[level])) {
+            return -1;
+        }
+    }
+
+    // the tables of the checkpoint are the ones in its own map file
+    for (auto it = m_chainSegs.back().begin(); it != m_chainSegs.back().end(); ++it) {
+        m_tableIds.insert(it->first);
+    }
+
+    if (!FindTablesFirstLevel()) {
+        return -1;
+    }
+
+    MOT_LOG_INFO("CheckpointRecovery::fillTasksFromMapFile: %lu tables in a chain of %lu checkpoints",
+        m_tableIds.size(),
+        m_chain.size());
+    return 1;
+}
+
+bool CheckpointRecovery::ReadChainFile()
+{
+    std::string chainFile;
+    m_chain.clear();
+    CheckpointUtils::MakeChainFilename(chainFile, m_workingDir, m_checkpointId);
+    if (!CheckpointUtils::IsFileExists(chainFile)) {
+        // a full checkpoint taken before delta checkpoints were supported
+        m_chain.push_back(m_checkpointId);
+        m_hasChainFile = false;
+        return true;
+    }
+
+    int fd = -1;
+    if (!CheckpointUtils::OpenFileRead(chainFile, fd)) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadChainFile: failed to open chain file '%s'", chainFile.c_str());
+        return false;
+    }
+
+    CheckpointUtils::ChainFileHeader chainFileHeader;
+    if (CheckpointUtils::ReadFile(fd, (char*)&chainFileHeader, sizeof(CheckpointUtils::ChainFileHeader)) !=
+        sizeof(CheckpointUtils::ChainFileHeader)) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadChainFile: failed to read chain file '%s' header", chainFile.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    if (chainFileHeader.m_magic != CP_MGR_MAGIC || chainFileHeader.m_numLevels == 0 ||
+        chainFileHeader.m_numLevels > MOTConfiguration::MAX_MAX_CHECKPOINT_DELTAS + 1) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadChainFile: failed to verify chain file '%s'", chainFile.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    m_chain.resize(chainFileHeader.m_numLevels);
+    size_t chainSize = chainFileHeader.m_numLevels * sizeof(uint64_t);
+    if (CheckpointUtils::ReadFile(fd, (char*)m_chain.data(), chainSize) != chainSize) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadChainFile: failed to read chain file '%s' entries", chainFile.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+    CheckpointUtils::CloseFile(fd);
+
+    if (m_chain.back() != m_checkpointId) {
+        MOT_LOG_ERROR("CheckpointRecovery::ReadChainFile: chain file '%s' ends with checkpoint %lu",
+            chainFile.c_str(),
+            m_chain.back());
+        return false;
+    }
+
+    m_chainMaxCsn = chainFileHeader.m_maxCsn;
+    m_hasChainFile = true;
+    return true;
+}
+
+bool CheckpointRecovery::ReadMapFile(uint64_t mapId, std::map<uint32_t, uint32_t>& segs)
+{
     std::string mapFile;
-    CheckpointUtils::MakeMapFilename(mapFile, m_workingDir, m_checkpointId);
+    CheckpointUtils::MakeMapFilename(mapFile, m_workingDir, mapId);
     int fd = -1;
     if (!CheckpointUtils::OpenFileRead(mapFile, fd)) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to open map file '%s'", mapFile.c_str());
-        return -1;
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to open map file '%s'", mapFile.c_str());
+        return false;
     }
 
     CheckpointUtils::MapFileHeader mapFileHeader;
     if (CheckpointUtils::ReadFile(fd, (char*)&mapFileHeader, sizeof(CheckpointUtils::MapFileHeader)) !=
         sizeof(CheckpointUtils::MapFileHeader)) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to read map file '%s' header", mapFile.c_str());
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to read map file '%s' header", mapFile.c_str());
         CheckpointUtils::CloseFile(fd);
-        return -1;
+        return false;
     }
 
     if (mapFileHeader.m_magic != CP_MGR_MAGIC) {
-        MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to verify map file'%s'", mapFile.c_str());
+        MOT_LOG_ERROR("CheckpointRecovery::ReadMapFile: failed to verify map file'%s'", mapFile.c_str());
         CheckpointUtils::CloseFile(fd);
-        return -1;
+        return false;
     }
 
     CheckpointManager::MapFileEntry entry;
     for (uint64_t i = 0; i < mapFileHeader.m_numEntries; i++) {
         if (CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointManager::MapFileEntry)) !=
             sizeof(CheckpointManager::MapFileEntry)) {
-            MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to read map file '%s' entry: %lu",
-                mapFile.c_str(),
-                i);
+            MOT_LOG_ERROR(
+                "CheckpointRecovery::ReadMapFile: failed to read map file '%s' entry: %lu", mapFile.c_str(), i);
             CheckpointUtils::CloseFile(fd);
-            return -1;
-        }
-        m_tableIds.insert(entry.m_tableId);
-        for (uint32_t i = 0; i <= entry.m_maxSegId; i++) {
-            Task* recoveryTask = new (std::nothrow) Task(entry.m_tableId, i);
-            if (recoveryTask == nullptr) {
-                CheckpointUtils::CloseFile(fd);
-                MOT_LOG_ERROR("CheckpointRecovery::fillTasksFromMapFile: failed to allocate task object");
-                return -1;
-            }
-            m_tasksList.push_back(recoveryTask);
+            return false;
         }
+        segs[entry.m_tableId] = entry.m_maxSegId;
     }
 
     CheckpointUtils::CloseFile(fd);
-    MOT_LOG_INFO("CheckpointRecovery::fillTasksFromMapFile: filled %lu tasks", m_tasksList.size());
-    return 1;
+    return true;
+}
+
+bool CheckpointRecovery::OpenDelFile(
+    uint32_t tableId, uint64_t deltaId, int& fd, CheckpointUtils::DelFileHeader& header)
+{
+    std::string fileName;
+    CheckpointUtils::MakeDelFilename(tableId, fileName, m_workingDir, deltaId);
+    if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
+        MOT_LOG_ERROR("CheckpointRecovery::OpenDelFile: failed to open file: %s", fileName.c_str());
+        return false;
+    }
+
+    size_t reader = CheckpointUtils::ReadFile(fd, (char*)&header, sizeof(CheckpointUtils::DelFileHeader));
+    if (reader != sizeof(CheckpointUtils::DelFileHeader)) {
+        MOT_LOG_ERROR("CheckpointRecovery::OpenDelFile: failed to read file header, reader %lu", reader);
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    if (header.m_fileHeader.m_magic != CP_MGR_MAGIC || header.m_fileHeader.m_tableId != tableId) {
+        MOT_LOG_ERROR("CheckpointRecovery::OpenDelFile: file: %s is corrupted", fileName.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+    return true;
+}
+
+bool CheckpointRecovery::FindTablesFirstLevel()
+{
+    for (auto it = m_tableIds.begin(); it != m_tableIds.end(); ++it) {
+        uint32_t tableId = *it;
+        uint32_t firstLevel = 0;
+        for (uint32_t level = m_chain.size() - 1; level > 0; --level) {
+            if (m_chainSegs[level].find(tableId) == m_chainSegs[level].end()) {
+                MOT_LOG_ERROR("CheckpointRecovery::FindTablesFirstLevel: table %u is missing in checkpoint %lu",
+                    tableId,
+                    m_chain[level]);
+                return false;
+            }
+
+            int fd = -1;
+            CheckpointUtils::DelFileHeader delFileHeader;
+            if (!OpenDelFile(tableId, m_chain[level], fd, delFileHeader)) {
+                return false;
+            }
+            CheckpointUtils::CloseFile(fd);
+
+            if (delFileHeader.m_flags & CheckpointUtils::DELTA_FLAG_RESET) {
+                firstLevel = level;
+                break;
+            }
+        }
+
+        if (m_chainSegs[firstLevel].find(tableId) == m_chainSegs[firstLevel].end()) {
+            MOT_LOG_ERROR("CheckpointRecovery::FindTablesFirstLevel: table %u is missing in checkpoint %lu",
+                tableId,
+                m_chain[firstLevel]);
+            return false;
+        }
+        m_tablesFirstLevel[tableId] = firstLevel;
+    }
+    return true;
 }
 
 bool CheckpointRecovery::RecoverTableMetadata(uint32_t tableId)
@@ -380,7 +583,13 @@ void CheckpointRecovery::CheckpointRecoveryWorker(CheckpointRecovery* checkpoint
         CheckpointRecovery::Task* task = checkpointRecovery->GetTask();
         if (task != nullptr) {
             bool hadError = false;
-            if (!checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status)) {
+            bool recovered = false;
+            if (task->m_type == TASK_INSERT_ROWS) {
+                recovered = checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status);
+            } else {
+                recovered = checkpointRecovery->RemoveTableRows(task, keyData, entryData, status);
+            }
+            if (!recovered) {
                 MOT_LOG_ERROR("CheckpointRecovery::WorkerFunc recovery of table %lu's data failed", task->m_tableId);
                 checkpointRecovery->OnError(status,
                     "CheckpointRecovery::WorkerFunc failed to recover table: ",
@@ -433,7 +642,7 @@ bool CheckpointRecovery::RecoverTableRows(
     }
 
     std::string fileName;
-    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg, task->m_deltaId);
     if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to open file: %s", fileName.c_str());
         return false;
@@ -542,6 +751,111 @@ bool CheckpointRecovery::RecoverTableRows(
     return (status == RC_OK);
 }
 
+bool CheckpointRecovery::RemoveTableRows(Task* task, char* keyData, char* entryData, RC& status)
+{
+    if (task == nullptr) {
+        MOT_LOG_ERROR("CheckpointRecovery::RemoveTableRows: no task given");
+        return false;
+    }
+
+    int fd = -1;
+    uint32_t seg = task->m_segId;
+    uint32_t tableId = task->m_tableId;
+
+    Table* table = GetTableManager()->GetTable(tableId);
+    if (table == nullptr) {
+        MOT_REPORT_ERROR(
+            MOT_ERROR_INTERNAL, "CheckpointRecovery::RemoveTableRows", "Table %llu does not exist", tableId);
+        return false;
+    }
+
+    CheckpointUtils::FileHeader fileHeader;
+    bool deletedKeys = (task->m_type == TASK_REMOVE_DELETED_ROWS);
+    if (deletedKeys) {
+        CheckpointUtils::DelFileHeader delFileHeader;
+        if (!OpenDelFile(tableId, task->m_deltaId, fd, delFileHeader)) {
+            return false;
+        }
+        fileHeader = delFileHeader.m_fileHeader;
+    } else {
+        std::string fileName;
+        CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg, task->m_deltaId);
+        if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
+            MOT_LOG_ERROR("CheckpointRecovery::RemoveTableRows: failed to open file: %s", fileName.c_str());
+            return false;
+        }
+
+        size_t reader = CheckpointUtils::ReadFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader));
+        if (reader != sizeof(CheckpointUtils::FileHeader) || fileHeader.m_magic != CP_MGR_MAGIC ||
+            fileHeader.m_tableId != tableId) {
+            MOT_LOG_ERROR("CheckpointRecovery::RemoveTableRows: file: %s is corrupted", fileName.c_str());
+            CheckpointUtils::CloseFile(fd);
+            return false;
+        }
+    }
+
+    if (table->GetTableExId() != fileHeader.m_exId) {
+        MOT_LOG_ERROR("CheckpointRecovery::RemoveTableRows: exId mismatch: my %lu - pkt %lu",
+            table->GetTableExId(),
+            fileHeader.m_exId);
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
+        uint16_t keyLen = 0;
+        uint32_t dataLen = 0;
+        size_t reader = 0;
+        if (deletedKeys) {
+            CheckpointUtils::DelEntryHeader entry;
+            reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::DelEntryHeader));
+            keyLen = entry.m_keyLen;
+            reader = (reader == sizeof(CheckpointUtils::DelEntryHeader)) ? reader : 0;
+        } else {
+            CheckpointUtils::EntryHeader entry;
+            reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
+            keyLen = entry.m_keyLen;
+            dataLen = entry.m_dataLen;
+            reader = (reader == sizeof(CheckpointUtils::EntryHeader)) ? reader : 0;
+        }
+
+        if (reader == 0 || keyLen > MAX_KEY_SIZE || dataLen > MAX_TUPLE_SIZE) {
+            MOT_LOG_ERROR("CheckpointRecovery::RemoveTableRows: invalid entry (elem: %lu / %lu), keyLen %u, dataLen %u",
+                i,
+                fileHeader.m_numOps,
+                keyLen,
+                dataLen);
+            status = RC_ERROR;
+            break;
+        }
+
+        if (CheckpointUtils::ReadFile(fd, keyData, keyLen) != keyLen ||
+            CheckpointUtils::ReadFile(fd, entryData, dataLen) != dataLen) {
+            MOT_LOG_ERROR(
+                "CheckpointRecovery::RemoveTableRows: failed to read entry (elem: %lu / %lu)", i, fileHeader.m_numOps);
+            status = RC_ERROR;
+            break;
+        }
+
+        RemoveRow(table, keyData, keyLen, MOTCurrThreadId, status);
+        if (status != RC_OK) {
+            MOT_LOG_ERROR(
+                "CheckpointRecovery: failed to remove row %s (error code: %d)", RcToString(status), (int)status);
+            break;
+        }
+    }
+    CheckpointUtils::CloseFile(fd);
+
+    MOT_LOG_DEBUG("[%u] CheckpointRecovery::RemoveTableRows table %u:%u, delta %lu, %lu keys (%s)",
+        MOTCurrThreadId,
+        tableId,
+        seg,
+        task->m_deltaId,
+        fileHeader.m_numOps,
+        (status == RC_OK) ? "OK" : "Error");
+    return (status == RC_OK);
+}
+
 CheckpointRecovery::Task* CheckpointRecovery::GetTask()
 {
     Task* task = nullptr;
@@ -608,6 +922,22 @@ void CheckpointRecovery::InsertRow(Table* table, char* keyData, uint16_t keyLen,
     }
 }
 
+void CheckpointRecovery::RemoveRow(Table* table, char* keyData, uint16_t keyLen, uint32_t tid, RC& status)
+{
+    MaxKey key;
+    Row* row = nullptr;
+    key.CpKey((const uint8_t*)keyData, keyLen);
+    if (table->FindRow(&key, row, tid) != RC_OK) {
+        // the row was inserted after the previous checkpoint and deleted before this one
+        return;
+    }
+
+    if (table->RemoveRow(row, tid) == nullptr) {
+        status = RC_ERROR;
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "Checkpoint Recovery Remove Row", "failed to remove row");
+    }
+}
+
 bool CheckpointRecovery::RecoverInProcessTxns()
 {
     int fd = -1;
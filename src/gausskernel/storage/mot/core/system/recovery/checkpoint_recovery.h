@@ -25,13 +25,16 @@
 #ifndef CHECKPOINT_RECOVERY_H
 #define CHECKPOINT_RECOVERY_H
 
+#include <map>
 #include <set>
 #include <list>
 #include <mutex>
+#include <vector>
 #include "global.h"
 #include "spin_lock.h"
 #include "table.h"
 #include "surrogate_state.h"
+#include "checkpoint_utils.h"
 
 namespace MOT {
 class CheckpointRecovery {
@@ -40,6 +43,8 @@ public:
         : m_checkpointId(0),
           m_lsn(0),
           m_lastReplayLsn(0),
+          m_chainMaxCsn(0),
+          m_hasChainFile(false),
           m_numWorkers(GetGlobalConfiguration().m_checkpointRecoveryWorkers),
           m_stopWorkers(false),
           m_errorSet(false),
@@ -66,17 +71,39 @@ public:
         return m_stopWorkers;
     }
 
+    /**
+     * @enum TaskType
+     * @brief What a checkpoint recovery task does with its file.
+     */
+    enum TaskType : uint8_t {
+        /** @var Inserts the rows of a data file. */
+        TASK_INSERT_ROWS,
+
+        /** @var Removes the existing rows that are replaced by the rows of a delta data file. */
+        TASK_REMOVE_ROWS,
+
+        /** @var Removes the rows listed in a delta deleted keys file. */
+        TASK_REMOVE_DELETED_ROWS
+    };
+
     /**
      * @struct Task
-     * @brief Describes a checkpoint recovery task by its table id and
-     * segment file number.
+     * @brief Describes a checkpoint recovery task by its table id,
+     * segment file number and the delta checkpoint that wrote the file.
      */
     struct Task {
-        explicit Task(uint32_t tableId = 0, uint32_t segId = 0) : m_tableId(tableId), m_segId(segId)
+        explicit Task(
+            uint32_t tableId = 0, uint32_t segId = 0, uint64_t deltaId = 0, TaskType type = TASK_INSERT_ROWS)
+            : m_tableId(tableId), m_segId(segId), m_deltaId(deltaId), m_type(type)
         {}
 
         uint32_t m_tableId;
         uint32_t m_segId;
+
+        /** @var The delta checkpoint that wrote the file, zero for the full checkpoint. */
+        uint64_t m_deltaId;
+
+        TaskType m_type;
     };
 
     /**
@@ -99,6 +126,16 @@ public:
     bool RecoverTableRows(
         Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status);
 
+    /**
+     * @brief Removes the rows whose keys appear in a delta checkpoint data or deleted keys file
+     * @param task The task (tableid / segment / delta) to recover from.
+     * @param keyData A key buffer.
+     * @param entryData A row buffer.
+     * @param status RC returned from the remove function.
+     * @return Boolean value denoting success or failure.
+     */
+    bool RemoveTableRows(Task* task, char* keyData, char* entryData, RC& status);
+
     uint64_t GetLsn() const
     {
         return m_lsn;
@@ -120,13 +157,58 @@ private:
     bool RecoverTableMetadata(uint32_t tableId);
 
     /**
-     * @brief Reads the checkpoint map file and fills the tasks queue
-     * with the relevant information.
+     * @brief Reads the checkpoint chain and map files and collects the tables
+     * and segments of each checkpoint in the chain.
      * @return Int value where 0 indicates no tasks (empty checkpoint),
      * -1 denotes an error has occurred and 1 means a success.
      */
     int FillTasksFromMapFile();
 
+    /**
+     * @brief Reads the checkpoint chain file. A checkpoint without a chain file is a full checkpoint.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReadChainFile();
+
+    /**
+     * @brief Reads a map file of the chain.
+     * @param mapId The checkpoint id of the map file.
+     * @param segs The returned max segment id of each table.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReadMapFile(uint64_t mapId, std::map<uint32_t, uint32_t>& segs);
+
+    /**
+     * @brief Finds, for each table, the first checkpoint of the chain to recover from,
+     * which is the last one that wrote the table in full.
+     * @return Boolean value denoting success or failure.
+     */
+    bool FindTablesFirstLevel();
+
+    /**
+     * @brief Opens a delta checkpoint deleted keys file and reads its header.
+     * @param tableId The table's id.
+     * @param deltaId The delta checkpoint that wrote the file.
+     * @param fd The returned file descriptor.
+     * @param header The returned file header.
+     * @return Boolean value denoting success or failure.
+     */
+    bool OpenDelFile(uint32_t tableId, uint64_t deltaId, int& fd, CheckpointUtils::DelFileHeader& header);
+
+    /**
+     * @brief Fills the tasks queue with the tasks of a recovery stage. Each checkpoint of the
+     * chain is recovered in stages, so that a key is never removed and inserted concurrently.
+     * @param level The checkpoint's index in the chain.
+     * @param type The type of the stage's tasks.
+     * @return Boolean value denoting success or failure.
+     */
+    bool FillLevelTasks(uint32_t level, TaskType type);
+
+    /**
+     * @brief Runs the checkpoint recovery workers until the tasks queue is drained.
+     */
+    void RunWorkers();
+
     /**
      * @brief Checks if there are any more tasks left in the queue
      * @return Int value where 0 means failure and 1 success
@@ -165,6 +247,16 @@ private:
     void InsertRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen, uint64_t csn,
         uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId);
 
+    /**
+     * @brief Removes a row from the database in a non transactional manner, if it exists.
+     * @param table the table's object pointer.
+     * @param keyData key's data buffer.
+     * @param keyLen key's data buffer len.
+     * @param tid the thread id of the recovering thread.
+     * @param status the returned status of the operation
+     */
+    void RemoveRow(Table* table, char* keyData, uint16_t keyLen, uint32_t tid, RC& status);
+
     /**
      * @brief performs table creation.
      * @param data the table's data
@@ -194,6 +286,19 @@ private:
 
     uint64_t m_lastReplayLsn;
 
+    // The checkpoint ids of the chain, the full checkpoint first
+    std::vector<uint64_t> m_chain;
+
+    uint64_t m_chainMaxCsn;
+
+    bool m_hasChainFile;
+
+    // The max segment id of each table, per checkpoint in the chain
+    std::vector<std::map<uint32_t, uint32_t>> m_chainSegs;
+
+    // The index in the chain of the first checkpoint to recover each table from
+    std::map<uint32_t, uint32_t> m_tablesFirstLevel;
+
     uint32_t m_numWorkers;
 
     std::string m_workingDir;
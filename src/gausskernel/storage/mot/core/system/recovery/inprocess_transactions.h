@@ -59,6 +59,12 @@ public:
         return RC_ERROR;
     }
 
+    /**
+     * @brief Removes a transaction from the map without applying it.
+     * @return The segments of the transaction, owned by the caller, or null pointer if not found.
+     */
+    RedoLogTransactionSegments* DetachTransaction(uint64_t internalId, uint64_t externalId);
+
     /* Attention: Caller's should acquire the lock by calling Lock() method, before calling this method. */
     template <typename T>
     RC ForEachTransactionNoLock(const T& func)
@@ -85,6 +85,13 @@ public:
     virtual void SetLastReplayLsn(uint64_t lastReplayLsn) = 0;
     virtual uint64_t GetLastReplayLsn() const = 0;
 
+    /**
+     * @brief Holds parallel redo replay until ReleaseRedoReplay() is called.
+     * @return Boolean value denoting whether redo replay was held.
+     */
+    virtual bool HoldRedoReplay() = 0;
+    virtual void ReleaseRedoReplay() = 0;
+
     virtual bool IsErrorSet() const = 0;
     virtual void AddSurrogateArrayToList(SurrogateState& surrogate) = 0;
     virtual void SetCsn(uint64_t csn) = 0;
@@ -81,7 +81,7 @@ bool RecoveryManager::RecoverDbStart()
         if (m_lsn < m_lastReplayLsn) {
             m_lsn = m_lastReplayLsn;
         }
-        return true;
+        return StartRedoReplayWorkers();
     }
 
     if (!m_checkpointRecovery.Recover()) {
@@ -90,11 +90,25 @@ bool RecoveryManager::RecoverDbStart()
 
     m_lsn = m_checkpointRecovery.GetLsn();
     m_recoverFromCkptDone = true;
-    return true;
+    return StartRedoReplayWorkers();
+}
+
+bool RecoveryManager::StartRedoReplayWorkers()
+{
+    if (m_numRedoWorkers <= 1 || m_replayPool.IsActive()) {
+        return true;
+    }
+    return m_replayPool.Start(this, m_numRedoWorkers);
 }
 
 bool RecoveryManager::RecoverDbEnd()
 {
+    // replay the transactions still queued to the workers, the workers hand over their surrogate state on exit
+    {
+        std::lock_guard<std::mutex> lock(m_dispatchLock);
+        m_replayPool.Stop();
+    }
+
     if (MOTEngine::GetInstance()->GetInProcessTransactions().GetNumTxns() != 0) {
         MOT_LOG_ERROR("MOT recovery: There are uncommitted or incomplete transactions, "
                       "ignoring and clearing those log segments.");
@@ -128,6 +142,8 @@ void RecoveryManager::CleanUp()
         return;
     }
 
+    m_replayPool.Stop();
+
     if (m_logStats != nullptr) {
         delete m_logStats;
         m_logStats = nullptr;
@@ -143,6 +159,7 @@ bool RecoveryManager::ApplyRedoLog(uint64_t redoLsn, char* data, size_t len)
         MOT_LOG_DEBUG("ApplyRedoLog - ignoring old redo record. Checkpoint LSN: %lu, redo LSN: %lu", m_lsn, redoLsn);
         return true;
     }
+    std::lock_guard<std::mutex> lock(m_dispatchLock);
     return ApplyLogSegmentFromData(data, len, redoLsn);
 }
 
@@ -214,6 +231,7 @@ bool RecoveryManager::ApplyLogSegmentFromData(char* data, size_t len, uint64_t r
 bool RecoveryManager::CommitRecoveredTransaction(uint64_t externalTransactionId)
 {
     uint64_t internalId = 0;
+    std::lock_guard<std::mutex> lock(m_dispatchLock);
     if (MOTEngine::GetInstance()->GetInProcessTransactions().FindTransactionId(externalTransactionId, internalId)) {
         return OperateOnRecoveredTransaction(internalId, externalTransactionId, RecoveryOps::RecoveryOpState::COMMIT);
     }
@@ -225,19 +243,12 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
 {
     RC status = RC_OK;
     if (rState != RecoveryOps::RecoveryOpState::ABORT) {
-        auto operateLambda = [this](RedoLogTransactionSegments* segments, uint64_t id) -> RC {
-            RC redoStatus = RC_OK;
-            LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
-            uint64_t csn = segment->m_controlBlock.m_csn;
-            for (uint32_t i = 0; i < segments->GetCount(); i++) {
-                segment = segments->GetSegment(i);
-                redoStatus = RedoSegment(segment, csn, id, RecoveryOps::RecoveryOpState::COMMIT);
-                if (redoStatus != RC_OK) {
-                    MOT_LOG_ERROR("OperateOnRecoveredTransaction failed with rc %d", redoStatus);
-                    return redoStatus;
-                }
-            }
-            return redoStatus;
+        if (m_replayPool.IsActive()) {
+            return DispatchRecoveredTransaction(internalTransactionId, externalTransactionId);
+        }
+
+        auto operateLambda = [this](RedoLogTransactionSegments* segments, uint64_t) -> RC {
+            return ReplayTransaction(segments, m_sState);
         };
 
         status = MOTEngine::GetInstance()->GetInProcessTransactions().ForUniqueTransaction(
@@ -250,8 +261,97 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
     return true;
 }
 
-RC RecoveryManager::RedoSegment(
-    LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState)
+bool RecoveryManager::DispatchRecoveredTransaction(uint64_t internalTransactionId, uint64_t externalTransactionId)
+{
+    RedoLogTransactionSegments* segments =
+        MOTEngine::GetInstance()->GetInProcessTransactions().DetachTransaction(
+            internalTransactionId, externalTransactionId);
+    if (segments == nullptr) {
+        MOT_LOG_ERROR("DispatchRecoveredTransaction: transaction %lu not found", internalTransactionId);
+        return false;
+    }
+
+    // transactions of the same table are replayed by the same worker in commit order, a transaction
+    // that spans several tables is replayed here once the workers of its tables caught up with it
+    std::set<uint32_t> workers;
+    if (GetTransactionWorkers(segments, workers)) {
+        if (workers.size() == 1) {
+            m_replayPool.Dispatch(*workers.begin(), segments);
+            return true;
+        }
+        for (uint32_t workerId : workers) {
+            m_replayPool.WaitWorker(workerId);
+        }
+    } else {
+        // DDL is a barrier for all the workers
+        m_replayPool.WaitAll();
+    }
+
+    RC status = ReplayTransaction(segments, m_sState);
+    delete segments;
+    if (status != RC_OK) {
+        MOT_LOG_ERROR("DispatchRecoveredTransaction: wal recovery failed");
+        return false;
+    }
+    return true;
+}
+
+bool RecoveryManager::GetTransactionWorkers(RedoLogTransactionSegments* segments, std::set<uint32_t>& workers)
+{
+    for (uint32_t i = 0; i < segments->GetCount(); i++) {
+        LogSegment* segment = segments->GetSegment(i);
+        uint8_t* endPosition = (uint8_t*)(segment->m_data + segment->m_len);
+        uint8_t* operationData = (uint8_t*)(segment->m_data);
+        while (operationData < endPosition) {
+            uint64_t tableExId = 0;
+            bool isRowOp = false;
+            uint32_t opLength = RecoveryOps::GetOperationTable(operationData, tableExId, isRowOp);
+            if (opLength == 0) {
+                return false;
+            }
+            if (isRowOp) {
+                (void)workers.insert(m_replayPool.GetTableWorker(tableExId));
+            }
+            operationData += opLength;
+        }
+    }
+    return true;
+}
+
+RC RecoveryManager::ReplayTransaction(RedoLogTransactionSegments* segments, SurrogateState& sState)
+{
+    RC status = RC_OK;
+    LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
+    uint64_t csn = segment->m_controlBlock.m_csn;
+    for (uint32_t i = 0; i < segments->GetCount(); i++) {
+        segment = segments->GetSegment(i);
+        status = RedoSegment(segment, csn, segments->GetTransactionId(), RecoveryOps::RecoveryOpState::COMMIT, sState);
+        if (status != RC_OK) {
+            MOT_LOG_ERROR("ReplayTransaction failed with rc %d", status);
+            return status;
+        }
+    }
+    return status;
+}
+
+bool RecoveryManager::HoldRedoReplay()
+{
+    m_dispatchLock.lock();
+    if (!m_replayPool.IsActive()) {
+        m_dispatchLock.unlock();
+        return false;
+    }
+    m_replayPool.WaitAll();
+    return true;
+}
+
+void RecoveryManager::ReleaseRedoReplay()
+{
+    m_dispatchLock.unlock();
+}
+
+RC RecoveryManager::RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId,
+    RecoveryOps::RecoveryOpState rState, SurrogateState& sState)
 {
     RC status = RC_OK;
     uint8_t* endPosition = (uint8_t*)(segment->m_data + segment->m_len);
@@ -260,8 +360,7 @@ RC RecoveryManager::RedoSegment(
     bool wasCommit = false;
 
     while (operationData < endPosition) {
-        // redo log recovery - single threaded
-        if (IsRecoveryMemoryLimitReached(NUM_REDO_RECOVERY_THREADS)) {
+        if (IsRecoveryMemoryLimitReached(m_numRedoWorkers)) {
             status = RC_ERROR;
             MOT_LOG_ERROR("Memory hard limit reached. Cannot recover datanode");
             break;
@@ -279,7 +378,7 @@ RC RecoveryManager::RedoSegment(
         }
 
         operationData += RecoveryOps::RecoverLogOperation(
-            MOTCurrTxn, operationData, csn, transactionId, MOTCurrThreadId, m_sState, status, wasCommit);
+            MOTCurrTxn, operationData, csn, transactionId, MOTCurrThreadId, sState, status, wasCommit);
 
         // check operation result status
         if (status != RC_OK) {
@@ -293,10 +392,7 @@ RC RecoveryManager::RedoSegment(
         }
     }
 
-    // single threaded, no need for locking or CAS
-    if (csn > m_maxRecoveredCsn) {
-        m_maxRecoveredCsn = csn;
-    }
+    SetCsn(csn);
     if (status != RC_OK) {
         MOT_LOG_ERROR("RecoveryManager::redoSegment: got error %u on tid %lu", status, transactionId);
     }
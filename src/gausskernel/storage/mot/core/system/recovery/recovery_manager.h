@@ -25,6 +25,8 @@
 #ifndef RECOVERY_MANAGER_H
 #define RECOVERY_MANAGER_H
 
+#include <mutex>
+#include <set>
 #include <vector>
 #include "checkpoint_ctrlfile.h"
 #include "redo_log_global.h"
@@ -36,6 +38,7 @@
 #include "surrogate_state.h"
 #include "checkpoint_recovery.h"
 #include "recovery_ops.h"
+#include "redo_replay_worker_pool.h"
 
 namespace MOT {
 /**
@@ -57,7 +60,8 @@ public:
           m_errorSet(false),
           m_clogCallback(nullptr),
           m_threadId(AllocThreadId()),
-          m_maxConnections(GetGlobalConfiguration().m_maxConnections)
+          m_maxConnections(GetGlobalConfiguration().m_maxConnections),
+          m_numRedoWorkers(GetGlobalConfiguration().m_redoRecoveryWorkers)
     {}
 
     ~RecoveryManager() override
@@ -128,8 +132,9 @@ public:
 
     inline void SetLastReplayLsn(uint64_t replayLsn) override
     {
-        if (m_lastReplayLsn < replayLsn) {
-            m_lastReplayLsn = replayLsn;
+        // redo replay workers commit concurrently
+        uint64_t currentLsn = m_lastReplayLsn;
+        while (currentLsn < replayLsn && !m_lastReplayLsn.compare_exchange_weak(currentLsn, replayLsn)) {
         }
     }
 
@@ -138,6 +143,34 @@ public:
         return m_lastReplayLsn;
     }
 
+    /**
+     * @brief Stops dispatching redo transactions and waits until the replay workers are idle, so
+     * that the replayed transactions are exactly the ones received so far.
+     * @return True if redo replay is parallel and was held, false if there is nothing to hold.
+     */
+    bool HoldRedoReplay() override;
+
+    /**
+     * @brief Resumes dispatching redo transactions after HoldRedoReplay().
+     */
+    void ReleaseRedoReplay() override;
+
+    /**
+     * @brief Replays all the segments of a committed transaction.
+     * @param segments the transaction to replay.
+     * @param sState the surrogate state of the replaying thread.
+     * @return RC value denoting the operation's status
+     */
+    RC ReplayTransaction(RedoLogTransactionSegments* segments, SurrogateState& sState);
+
+    /**
+     * @brief Fails the recovery, called by redo replay workers.
+     */
+    inline void OnReplayError()
+    {
+        m_errorSet = true;
+    }
+
     /**
      * @class LogStats
      * @brief A per-table recovery stats collector
@@ -244,8 +277,6 @@ public:
     std::map<uint64_t, RecoveryOps::TableInfo*> m_preCommitedTables;
 
 private:
-    static constexpr uint32_t NUM_REDO_RECOVERY_THREADS = 1;
-
     /**
      * @brief performs a redo on a segment, which is either a recovery op
      * or a segment that belongs to a 2pc recovered transaction.
@@ -253,9 +284,11 @@ private:
      * @param csn the segment's csn
      * @param transactionId the transaction id of the segment
      * @param rState the operation to perform on the segment.
+     * @param sState the surrogate state of the replaying thread.
      * @return RC value denoting the operation's status
      */
-    RC RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState);
+    RC RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState,
+        SurrogateState& sState);
 
     /**
      * @brief inserts a segment in to the in-process transactions map
@@ -274,6 +307,30 @@ private:
     bool OperateOnRecoveredTransaction(
         uint64_t internalTransactionId, uint64_t externalTransactionId, RecoveryOps::RecoveryOpState rState);
 
+    /**
+     * @brief hands a committed transaction over to the redo replay workers. A transaction that
+     * modifies a single table is queued to the worker of the table. Other transactions are
+     * replayed by the caller, after the workers they conflict with are idle.
+     * @param internalTransactionId the internal transaction id to replay.
+     * @param externalTransactionId the external transaction id to replay.
+     * @return Boolean value denoting success or failure.
+     */
+    bool DispatchRecoveredTransaction(uint64_t internalTransactionId, uint64_t externalTransactionId);
+
+    /**
+     * @brief collects the replay workers of the tables a transaction modifies.
+     * @param segments the transaction.
+     * @param[out] workers the replay workers.
+     * @return Boolean value that is false if the transaction contains DDL, which conflicts with all workers.
+     */
+    bool GetTransactionWorkers(RedoLogTransactionSegments* segments, std::set<uint32_t>& workers);
+
+    /**
+     * @brief spawns the redo replay workers if parallel redo replay is configured.
+     * @return Boolean value denoting success or failure.
+     */
+    bool StartRedoReplayWorkers();
+
     /**
      * @brief checks if a transaction id specified in the log segment is an mot
      * only one.
@@ -314,7 +371,7 @@ private:
 
     uint64_t m_lsn;
 
-    uint64_t m_lastReplayLsn;
+    std::atomic<uint64_t> m_lastReplayLsn;
 
     std::atomic<uint32_t> m_tid;
 
@@ -328,7 +385,7 @@ private:
 
     std::list<uint64_t*> m_surrogateList;
 
-    bool m_errorSet;
+    std::atomic<bool> m_errorSet;
 
     CommitLogStatusCallback m_clogCallback;
 
@@ -339,6 +396,14 @@ private:
     uint16_t m_maxConnections;
 
     CheckpointRecovery m_checkpointRecovery;
+
+    /** @var Number of redo replay workers, one means serial replay. */
+    uint32_t m_numRedoWorkers;
+
+    /** @var Serializes dispatching of redo transactions with HoldRedoReplay(). */
+    std::mutex m_dispatchLock;
+
+    RedoReplayWorkerPool m_replayPool;
 };
 }  // namespace MOT
 
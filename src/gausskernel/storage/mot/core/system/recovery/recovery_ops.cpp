@@ -939,6 +939,80 @@ RC RecoveryOps::BeginTransaction(TxnManager* txn, uint64_t replayLsn)
     return RC_OK;
 }
 
+uint32_t RecoveryOps::GetOperationTable(uint8_t* data, uint64_t& exId, bool& isRowOp)
+{
+    uint64_t tableId, rowLength, rowId, version;
+    uint32_t metaVersion;
+    uint16_t keyLength;
+    uint8_t* opData = data;
+
+    isRowOp = false;
+    OperationCode opCode = *(OperationCode*)data;
+    switch (opCode) {
+        case CREATE_ROW:
+        case UPDATE_ROW:
+        case OVERWRITE_ROW:
+        case REMOVE_ROW:
+            break;
+        case COMMIT_TX:
+        case COMMIT_PREPARED_TX:
+        case PARTIAL_REDO_TX:
+        case PREPARE_TX:
+        case ROLLBACK_TX:
+        case ROLLBACK_PREPARED_TX:
+            return sizeof(EndSegmentBlock);
+        default:
+            return 0;
+    }
+
+    data += sizeof(OperationCode);
+    Extract(data, metaVersion);
+    Extract(data, tableId);
+    Extract(data, exId);
+    if (opCode == CREATE_ROW) {
+        Extract(data, rowId);
+    }
+    Extract(data, keyLength);
+    (void)ExtractPtr(data, keyLength);
+
+    switch (opCode) {
+        case CREATE_ROW:
+        case OVERWRITE_ROW:
+            Extract(data, rowLength);
+            (void)ExtractPtr(data, rowLength);
+            break;
+        case REMOVE_ROW:
+            Extract(data, version);
+            break;
+        case UPDATE_ROW: {
+            // the length of a delta update depends on the updated columns
+            Extract(data, version);
+            Table* table = GetTableManager()->GetTableByExternal(exId);
+            if (table == nullptr) {
+                return 0;
+            }
+            uint16_t numColumns = table->GetFieldCount() - 1;
+            BitmapSet updatedColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+            BitmapSet validColumns(ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+            BitmapSet::BitmapSetIterator updatedColumnsIt(updatedColumns);
+            BitmapSet::BitmapSetIterator validColumnsIt(validColumns);
+            while (!updatedColumnsIt.End()) {
+                if (updatedColumnsIt.IsSet() && validColumnsIt.IsSet()) {
+                    data += table->GetField(updatedColumnsIt.GetPosition() + 1)->m_size;
+                }
+                validColumnsIt.Next();
+                updatedColumnsIt.Next();
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    isRowOp = true;
+    return (uint32_t)(data - opData);
+}
+
 RC RecoveryOps::CommitTransaction(TxnManager* txn, uint64_t csn)
 {
     txn->SetCommitSequenceNumber(csn);
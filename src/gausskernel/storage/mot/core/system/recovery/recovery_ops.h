@@ -104,6 +104,15 @@ public:
      */
     static RC BeginTransaction(TxnManager* txn, uint64_t replayLsn = 0);
 
+    /**
+     * @brief Retrieves the table of a logged operation without performing it.
+     * @param data the buffer of the operation.
+     * @param[out] exId the external id of the table.
+     * @param[out] isRowOp true if the operation modifies a row of the table.
+     * @return Int value denoting the length of the operation, zero for DDL and unknown operations.
+     */
+    static uint32_t GetOperationTable(uint8_t* data, uint64_t& exId, bool& isRowOp);
+
 private:
     /**
      * @brief performs an insert operation of a data buffer.
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * redo_replay_worker_pool.cpp
+ *    Pool of workers that replay committed redo transactions in parallel.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/system/recovery/redo_replay_worker_pool.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "mot_engine.h"
+#include "redo_replay_worker_pool.h"
+#include "recovery_manager.h"
+
+namespace MOT {
+DECLARE_LOGGER(RedoReplayWorkerPool, Recovery);
+
+bool RedoReplayWorkerPool::Start(RecoveryManager* recoveryManager, uint32_t numWorkers)
+{
+    MOT_ASSERT(m_workers == nullptr);
+    m_workers = new (std::nothrow) Worker[numWorkers];
+    if (m_workers == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Redo Replay", "Failed to allocate %u redo replay workers", numWorkers);
+        return false;
+    }
+
+    m_recoveryManager = recoveryManager;
+    m_numWorkers = numWorkers;
+    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+        m_workers[i].m_thread = std::thread(WorkerFunc, this, i);
+    }
+
+    MOT_LOG_INFO("Started %u redo replay workers", m_numWorkers);
+    return true;
+}
+
+void RedoReplayWorkerPool::Stop()
+{
+    if (m_workers == nullptr) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+        Worker& worker = m_workers[i];
+        {
+            std::lock_guard<std::mutex> lock(worker.m_lock);
+            worker.m_stop = true;
+        }
+        worker.m_queuedCV.notify_one();
+    }
+
+    // workers drain their queues before exiting
+    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+        if (m_workers[i].m_thread.joinable()) {
+            m_workers[i].m_thread.join();
+        }
+    }
+
+    delete[] m_workers;
+    m_workers = nullptr;
+    m_numWorkers = 0;
+    MOT_LOG_INFO("Stopped redo replay workers");
+}
+
+void RedoReplayWorkerPool::Dispatch(uint32_t workerId, RedoLogTransactionSegments* segments)
+{
+    Worker& worker = m_workers[workerId];
+    {
+        std::unique_lock<std::mutex> lock(worker.m_lock);
+        worker.m_doneCV.wait(lock, [&worker] { return worker.m_queue.size() < MAX_QUEUED_TRANSACTIONS; });
+        worker.m_queue.push(segments);
+    }
+    worker.m_queuedCV.notify_one();
+}
+
+void RedoReplayWorkerPool::WaitWorker(uint32_t workerId)
+{
+    Worker& worker = m_workers[workerId];
+    std::unique_lock<std::mutex> lock(worker.m_lock);
+    worker.m_doneCV.wait(lock, [&worker] { return worker.m_queue.empty() && !worker.m_busy; });
+}
+
+void RedoReplayWorkerPool::WaitAll()
+{
+    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+        WaitWorker(i);
+    }
+}
+
+void RedoReplayWorkerPool::WorkerFunc(RedoReplayWorkerPool* pool, uint32_t workerId)
+{
+    // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    RecoveryManager* recoveryManager = pool->m_recoveryManager;
+    Worker& worker = pool->m_workers[workerId];
+
+    // in a thread-pooled envelope the affinity could be disabled, so we use task affinity here
+    if (GetGlobalConfiguration().m_enableNuma && !GetTaskAffinity().SetAffinity(MOTCurrThreadId)) {
+        MOT_LOG_WARN("Failed to set affinity of redo replay worker, redo replay performance may be affected");
+    }
+
+    SurrogateState sState;
+    bool hadError = (sessionContext == nullptr || !sState.IsValid());
+    if (hadError) {
+        MOT_LOG_ERROR("RedoReplayWorkerPool::WorkerFunc: failed to initialize worker %u", workerId);
+        recoveryManager->OnReplayError();
+    }
+    MOT_LOG_DEBUG("RedoReplayWorkerPool::WorkerFunc start [%u] on cpu %lu", (unsigned)MOTCurrThreadId, sched_getcpu());
+
+    while (true) {
+        RedoLogTransactionSegments* segments = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(worker.m_lock);
+            worker.m_queuedCV.wait(lock, [&worker] { return !worker.m_queue.empty() || worker.m_stop; });
+            if (worker.m_queue.empty()) {
+                break;
+            }
+            segments = worker.m_queue.front();
+            worker.m_queue.pop();
+            worker.m_busy = true;
+        }
+        worker.m_doneCV.notify_all();
+
+        // after an error the remaining transactions are only discarded, recovery fails anyway
+        if (!hadError && recoveryManager->ReplayTransaction(segments, sState) != RC_OK) {
+            MOT_LOG_ERROR("RedoReplayWorkerPool::WorkerFunc: failed to replay transaction %lu",
+                segments->GetTransactionId());
+            recoveryManager->OnReplayError();
+            hadError = true;
+        }
+        delete segments;
+
+        {
+            std::lock_guard<std::mutex> lock(worker.m_lock);
+            worker.m_busy = false;
+        }
+        worker.m_doneCV.notify_all();
+    }
+
+    if (sState.IsValid() && !sState.IsEmpty()) {
+        recoveryManager->AddSurrogateArrayToList(sState);
+    }
+
+    if (sessionContext != nullptr) {
+        GetSessionManager()->DestroySessionContext(sessionContext);
+    }
+    engine->OnCurrentThreadEnding();
+    MOT_LOG_DEBUG("RedoReplayWorkerPool::WorkerFunc end [%u] on cpu %lu", (unsigned)MOTCurrThreadId, sched_getcpu());
+}
+}  // namespace MOT
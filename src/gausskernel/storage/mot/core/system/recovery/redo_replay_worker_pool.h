@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * redo_replay_worker_pool.h
+ *    Pool of workers that replay committed redo transactions in parallel.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/system/recovery/redo_replay_worker_pool.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef REDO_REPLAY_WORKER_POOL_H
+#define REDO_REPLAY_WORKER_POOL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include "redo_log_transaction_segments.h"
+
+namespace MOT {
+class RecoveryManager;
+
+/**
+ * @class RedoReplayWorkerPool
+ * @brief Replays committed redo transactions on a set of workers. Each worker owns a FIFO queue, so
+ * transactions dispatched to the same worker are replayed in dispatch (commit) order. The caller is
+ * responsible for dispatching conflicting transactions to the same worker, or for waiting for the
+ * workers before replaying a transaction by itself.
+ */
+class RedoReplayWorkerPool {
+public:
+    RedoReplayWorkerPool() : m_recoveryManager(nullptr), m_numWorkers(0), m_workers(nullptr)
+    {}
+
+    ~RedoReplayWorkerPool()
+    {
+        Stop();
+    }
+
+    /**
+     * @brief Spawns the workers.
+     * @param recoveryManager The recovery manager that replays the transactions.
+     * @param numWorkers The number of workers.
+     * @return Boolean value denoting success or failure.
+     */
+    bool Start(RecoveryManager* recoveryManager, uint32_t numWorkers);
+
+    /**
+     * @brief Waits for all dispatched transactions to be replayed and joins the workers.
+     */
+    void Stop();
+
+    inline bool IsActive() const
+    {
+        return (m_workers != nullptr);
+    }
+
+    inline uint32_t GetNumWorkers() const
+    {
+        return m_numWorkers;
+    }
+
+    /**
+     * @brief Retrieves the worker that replays all the transactions of a table.
+     */
+    inline uint32_t GetTableWorker(uint64_t tableExId) const
+    {
+        return (uint32_t)(tableExId % m_numWorkers);
+    }
+
+    /**
+     * @brief Queues a transaction to a worker, blocks while the queue of the worker is full.
+     * @param workerId The worker.
+     * @param segments The transaction to replay, the pool takes ownership.
+     */
+    void Dispatch(uint32_t workerId, RedoLogTransactionSegments* segments);
+
+    /**
+     * @brief Waits until a worker replayed all the transactions dispatched to it.
+     */
+    void WaitWorker(uint32_t workerId);
+
+    /**
+     * @brief Waits until all the workers replayed all the transactions dispatched to them.
+     */
+    void WaitAll();
+
+private:
+    /** @var Maximum number of queued transactions per worker. */
+    static constexpr size_t MAX_QUEUED_TRANSACTIONS = 1024;
+
+    struct Worker {
+        Worker() : m_busy(false), m_stop(false)
+        {}
+
+        std::mutex m_lock;
+
+        /** @var Signaled when a transaction is queued or the worker should stop. */
+        std::condition_variable m_queuedCV;
+
+        /** @var Signaled when a transaction is taken off the queue or replayed. */
+        std::condition_variable m_doneCV;
+
+        std::queue<RedoLogTransactionSegments*> m_queue;
+
+        /** @var A transaction is being replayed. */
+        bool m_busy;
+
+        bool m_stop;
+
+        std::thread m_thread;
+    };
+
+    static void WorkerFunc(RedoReplayWorkerPool* pool, uint32_t workerId);
+
+    RecoveryManager* m_recoveryManager;
+
+    uint32_t m_numWorkers;
+
+    Worker* m_workers;
+};
+}  // namespace MOT
+
+#endif /* REDO_REPLAY_WORKER_POOL_H */
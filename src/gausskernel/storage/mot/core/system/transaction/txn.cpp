@@ -499,6 +499,9 @@ void TxnManager::RollbackDDLs()
                 table->ReplaceRowPool(indexArr->GetRowPool());
                 table->Unlock();
                 delete indexArr;
+                if (GetGlobalConfiguration().m_enableCheckpoint) {
+                    GetCheckpointManager()->OnTableTruncate(table);
+                }
                 break;
             case DDL_ACCESS_CREATE_INDEX:
                 index = (Index*)ddl_access->GetEntry();
@@ -1140,6 +1143,11 @@ RC TxnManager::TruncateTable(Table* table)
                 table->m_primaryIndex = index_copy;
         }
         m_txnDdlAccess->Add(ddl_access);
+
+        // the rows of the table are gone, so a delta checkpoint cannot describe the change
+        if (GetGlobalConfiguration().m_enableCheckpoint) {
+            GetCheckpointManager()->OnTableTruncate(table);
+        }
     }
 
     return res;
@@ -78,6 +78,10 @@ private:
         // NOTE: parallel redo recovery also requires thread ids when invoking MOT engine (in case it is configured)
         MOT::MOTConfiguration& motCfg = MOT::GetGlobalConfiguration();
         startupThreadCount = motCfg.m_checkpointRecoveryWorkers + motCfg.m_chunkPreallocWorkerCount;
+        if (motCfg.m_redoRecoveryWorkers > 1) {
+            // redo replay workers live until recovery ends, concurrently with the runtime threads
+            startupThreadCount += motCfg.m_redoRecoveryWorkers;
+        }
         runtimeThreadCount = motCfg.m_checkpointWorkers + 1;  // add one for statistics reporting thread
 
         // get the number of threads used to manage user sessions
@@ -52,6 +52,7 @@
 #include "utils/date.h"
 #include "utils/syscache.h"
 #include "utils/partitionkey.h"
+#include "utils/guc.h"
 #include "catalog/heap.h"
 #include "optimizer/var.h"
 #include "optimizer/clauses.h"
@@ -131,6 +132,7 @@ static ForeignScan* MOTGetForeignPlan(PlannerInfo* root, RelOptInfo* baserel, Oi
 static void MOTExplainForeignScan(ForeignScanState* node, ExplainState* es);
 static void MOTBeginForeignScan(ForeignScanState* node, int eflags);
 static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node);
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node);
 static void MOTReScanForeignScan(ForeignScanState* node);
 static void MOTEndForeignScan(ForeignScanState* node);
 static void MOTAddForeignUpdateTargets(Query* parsetree, RangeTblEntry* targetRte, Relation targetRelation);
@@ -296,6 +298,7 @@ Datum mot_fdw_handler(PG_FUNCTION_ARGS)
     fdwroutine->ExplainForeignScan = MOTExplainForeignScan;
     fdwroutine->BeginForeignScan = MOTBeginForeignScan;
     fdwroutine->IterateForeignScan = MOTIterateForeignScan;
+    fdwroutine->VecIterateForeignScan = MOTVecIterateForeignScan;
     fdwroutine->ReScanForeignScan = MOTReScanForeignScan;
     fdwroutine->EndForeignScan = MOTEndForeignScan;
     fdwroutine->AnalyzeForeignTable = MOTAnalyzeForeignTable;
@@ -718,6 +721,31 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
     set_cheapest(baserel);
 }
 
+/*
+ * Tells whether the scan may be produced as vector batches by MOTVecIterateForeignScan.
+ */
+static bool IsVecScanApplicable(PlannerInfo* root, MOTFdwStateSt* planstate)
+{
+    // batches are produced only when the vector engine is asked for, OLTP plans are left untouched
+    if (!u_sess->attr.attr_sql.enable_vector_engine ||
+        u_sess->attr.attr_sql.vectorEngineStrategy == OFF_VECTOR_ENGINE) {
+        return false;
+    }
+
+    // rows which are modified or locked are still fetched one by one
+    if (root->parse->commandType != CMD_SELECT || root->parse->rowMarks != NIL) {
+        return false;
+    }
+
+    // a unique point lookup returns at most one row, there is nothing to batch
+    if (planstate->m_bestIx != nullptr && planstate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
+        planstate->m_bestIx->m_ix->GetUnique()) {
+        return false;
+    }
+
+    return true;
+}
+
 /*
  *
  */
@@ -785,7 +813,8 @@ static ForeignScan* MOTGetForeignPlan(
         list_free(tmpLocal);
 
     List* quals = planstate->m_localConds;
-    return make_foreignscan(tlist,
+    bool vecOutput = IsVecScanApplicable(root, planstate);
+    ForeignScan* fscan = make_foreignscan(tlist,
         quals,
         scanRelid,
         remote, /* no expressions to evaluate */
@@ -797,6 +826,8 @@ static ForeignScan* MOTGetForeignPlan(
         nullptr
 #endif
     );
+    ((Plan*)fscan)->vec_output = vecOutput;
+    return fscan;
 }
 
 /*
@@ -1090,6 +1121,109 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
     }
 }
 
+/*
+ * Fills the scan batch straight from MOT rows. Local quals are evaluated on the whole batch by the
+ * vector scan node, index conditions are applied by the cursor as in the row scan.
+ */
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node)
+{
+    MOT::RC rc = MOT::RC_OK;
+    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
+    VectorBatch* batch = node->m_pScanBatch;
+    bool stopAtFirst = (festate->m_bestIx && festate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
+                        festate->m_bestIx->m_ix->GetUnique() == true);
+
+    batch->Reset(true);
+    if (node->ss.is_scan_end) {
+        return batch;
+    }
+
+    MemoryContextReset(node->m_scanCxt);
+    MemoryContext oldCxt = MemoryContextSwitchTo(node->m_scanCxt);
+
+    if (stopAtFirst) {
+        // not planned as a vector scan, but a single row is served through the row path just as well
+        TupleTableSlot* slot = node->ss.ss_ScanTupleSlot;
+        (void)ExecClearTuple(slot);
+        if (IterateForeignScanStopAtFirst(node, festate, slot) != nullptr) {
+            for (int i = 0; i < batch->m_cols; i++) {
+                ScalarVector* vec = &(batch->m_arr[i]);
+                vec->m_rows++;
+                if (slot->tts_isnull[i]) {
+                    vec->SetNull(0);
+                } else if (vec->m_desc.encoded) {
+                    (void)vec->AddVar(slot->tts_values[i], 0);
+                } else {
+                    vec->m_vals[0] = slot->tts_values[i];
+                }
+            }
+            batch->m_rows = 1;
+        }
+        node->ss.is_scan_end = true;
+        (void)MemoryContextSwitchTo(oldCxt);
+        return batch;
+    }
+
+    if (!festate->m_cursorOpened) {
+        ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
+        festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
+        festate->m_econtext = node->ss.ps.ps_ExprContext;
+        CleanCursors(festate);
+        MOTAdaptor::OpenCursor(node->ss.ss_currentRelation, festate);
+
+        festate->m_cursorOpened = true;
+    }
+
+    // festate->cursor[1] might be NULL (in case it is not in use)
+    if (festate->m_cursor[0] == nullptr || !festate->m_cursor[0]->IsValid() ||
+        (festate->m_cursor[1] != nullptr && !festate->m_cursor[1]->IsValid())) {
+        node->ss.is_scan_end = true;
+        (void)MemoryContextSwitchTo(oldCxt);
+        return batch;
+    }
+
+    while (batch->m_rows < BatchMaxSize && festate->m_cursor[0]->IsValid()) {
+        MOT::Sentinel* sentinel = festate->m_cursor[0]->GetPrimarySentinel();
+        MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, sentinel, rc);
+        if (currRow == nullptr) {
+            if (rc != MOT::RC_OK) {
+                if (MOT_IS_SEVERE()) {
+                    MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTVecIterateForeignScan", "Failed to lookup row");
+                    MOT_LOG_ERROR_STACK("Failed to lookup row");
+                }
+
+                (void)MemoryContextSwitchTo(oldCxt);
+                CleanQueryStatesOnError(festate->m_currTxn);
+                report_pg_error(rc,
+                    (void*)(festate->m_currTxn->m_errIx != nullptr ? festate->m_currTxn->m_errIx->GetName().c_str()
+                                                                   : "unknown"),
+                    (void*)festate->m_currTxn->m_errMsgBuf);
+                return nullptr;
+            }
+            festate->m_cursor[0]->Next();
+            continue;
+        }
+
+        // check end condition for range search
+        if (MOTAdaptor::IsScanEnd(festate)) {
+            festate->m_cursor[0]->Invalidate();
+            break;
+        }
+
+        MOTAdaptor::UnpackRow(
+            batch, batch->m_rows, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
+        batch->m_rows++;
+        festate->m_cursor[0]->Next();
+    }
+
+    if (!festate->m_cursor[0]->IsValid()) {
+        node->ss.is_scan_end = true;
+    }
+    festate->m_rowsFound += batch->m_rows;
+    (void)MemoryContextSwitchTo(oldCxt);
+    return batch;
+}
+
 /*
  *
  */
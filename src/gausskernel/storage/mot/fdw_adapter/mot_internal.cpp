@@ -1042,8 +1042,16 @@ void MOTAdaptor::ValidateCreateIndex(IndexStmt* stmt, MOT::Table* table, MOT::Tx
         return;
     }
 
-    if (strcmp(stmt->accessMethod, "btree") != 0) {
-        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE only (btree or btree_art)")));
+    if (strcmp(stmt->accessMethod, "btree") != 0 && strcmp(stmt->accessMethod, "hash") != 0) {
+        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE or HASH only")));
+        return;
+    }
+
+    if (stmt->primary && strcmp(stmt->accessMethod, "hash") == 0) {
+        ereport(ERROR,
+            (errmodule(MOD_MOT),
+                errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("MOT does not support HASH primary indexes")));
         return;
     }
 
@@ -1090,6 +1098,11 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
     MOT::IndexingMethod indexing_method = MOT::IndexingMethod::INDEXING_METHOD_TREE;
     MOT::IndexTreeFlavor flavor = MOT::GetGlobalConfiguration().m_indexTreeFlavor;
 
+    // hash indexes serve point lookups only, see MatchIndex::GetCost()
+    if (strcmp(stmt->accessMethod, "hash") == 0) {
+        indexing_method = MOT::IndexingMethod::INDEXING_METHOD_HASH;
+    }
+
     // check if we have primary and delete previous definition
     if (stmt->primary) {
         index_order = MOT::IndexOrder::INDEX_ORDER_PRIMARY;
@@ -1850,6 +1863,56 @@ void MOTAdaptor::UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_
     }
 }
 
+void MOTAdaptor::UnpackRow(
+    VectorBatch* batch, int row, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow)
+{
+    EnsureSafeThreadAccessInline();
+    size_t len = 0;
+
+    // column count includes null bits field
+    uint64_t cols = table->GetFieldCount() - 1;
+
+    for (uint64_t i = 0; i < cols; i++) {
+        ScalarVector* vec = &(batch->m_arr[i]);
+        vec->m_rows++;
+        if (!BITMAP_GET(attrs_used, i) || !BITMAP_GET(srcRow, i)) {
+            vec->SetNull(row);
+            continue;
+        }
+
+        MOT::Column* col = table->GetField(i + 1);
+        switch (vec->m_desc.typeId) {
+            case VARCHAROID:
+            case BPCHAROID:
+            case TEXTOID:
+            case CLOBOID:
+            case BYTEAOID: {
+                // copy straight from the row into the batch buffer, no intermediate datum
+                uintptr_t tmp;
+                col->Unpack(srcRow, &tmp, len);
+                (void)vec->AddVarCharWithoutHeader((const char*)tmp, (int)len, row);
+                break;
+            }
+            case NUMERICOID: {
+                MOT::DecimalSt* d;
+                col->Unpack(srcRow, (uintptr_t*)&d, len);
+                (void)vec->AddVar(NumericGetDatum(MOTNumericToPG(d)), row);
+                break;
+            }
+            default: {
+                Datum value;
+                col->Unpack(srcRow, &value, len);
+                if (vec->m_desc.encoded) {
+                    (void)vec->AddVar(value, row);
+                } else {
+                    vec->m_vals[row] = value;
+                }
+                break;
+            }
+        }
+    }
+}
+
 // useful functions for data conversion: utils/fmgr/gmgr.cpp
 void MOTAdaptor::MOTToDatum(MOT::Table* table, const Form_pg_attribute attr, uint8_t* data, Datum* value, bool* is_null)
 {
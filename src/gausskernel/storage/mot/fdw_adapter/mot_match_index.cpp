@@ -377,6 +377,15 @@ double MatchIndex::GetCost(int numClauses)
         return INT_MAX;
     }
 
+    // hash index can serve only equality on all key columns
+    if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+        for (int i = 0; i < m_ix->GetNumFields(); i++) {
+            if (m_opers[m_start][i] != KEY_OPER::READ_KEY_EXACT) {
+                return INT_MAX;
+            }
+        }
+    }
+
     return m_cost;
 }
 
@@ -411,6 +420,11 @@ bool MatchIndex::CanApplyOrdering(const int* orderCols) const
 {
     int16_t numKeyCols = m_ix->GetNumFields();
 
+    // hash index keeps no order
+    if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+        return false;
+    }
+
     // check if order columns are overlap index matched columns or are suffix for it
     for (int16_t i = 0; i < numKeyCols; i++) {
         // overlap: we can use index ordering
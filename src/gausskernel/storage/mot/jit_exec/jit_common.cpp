@@ -67,6 +67,8 @@ extern JitCommandType ConvertCommandType(int pgCommandType, bool isPKey)
 
     if ((result == JIT_COMMAND_UPDATE) && !isPKey) {
         result = JIT_COMMAND_RANGE_UPDATE;
+    } else if ((result == JIT_COMMAND_DELETE) && !isPKey) {
+        result = JIT_COMMAND_RANGE_DELETE;
     }
 
     return result;
@@ -85,6 +87,8 @@ extern const char* CommandToString(JitCommandType commandType)
             return "Point-Delete";
         case JIT_COMMAND_RANGE_UPDATE:
             return "Range-Update";
+        case JIT_COMMAND_RANGE_DELETE:
+            return "Range-Delete";
         case JIT_COMMAND_RANGE_SELECT:
             return "Range-Select";
         case JIT_COMMAND_AGGREGATE_RANGE_SELECT:
@@ -110,6 +114,7 @@ extern bool IsRangeCommand(JitCommandType commandType)
 
     switch (commandType) {
         case JIT_COMMAND_RANGE_UPDATE:
+        case JIT_COMMAND_RANGE_DELETE:
         case JIT_COMMAND_RANGE_SELECT:
         case JIT_COMMAND_AGGREGATE_RANGE_SELECT:
         case JIT_COMMAND_POINT_JOIN:
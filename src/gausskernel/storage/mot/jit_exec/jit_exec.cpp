@@ -154,6 +154,7 @@ static void ProcessJitResult(MOT::RC result, JitContext* jitContext, int newScan
             case JIT_COMMAND_COMPOUND_SELECT:
             case JIT_COMMAND_UPDATE:
             case JIT_COMMAND_RANGE_UPDATE:
+            case JIT_COMMAND_RANGE_DELETE:
                 // this is considered as successful execution
                 JitStatisticsProvider::GetInstance().AddInvokeQuery();
                 if (newScan) {
@@ -597,6 +597,12 @@ static void ExplainRangeUpdatePlan(Query* query, JitRangeUpdatePlan* plan)
     ExplainIndexScan(query, (JitPlan*)plan, 2, &plan->_index_scan);
 }
 
+static void ExplainRangeDeletePlan(Query* query, JitRangeDeletePlan* plan)
+{
+    MOT_LOG_TRACE("[Plan] Range DELETE from table %s:", plan->_index_scan._table->GetTableName().c_str());
+    ExplainIndexScan(query, (JitPlan*)plan, 2, &plan->_index_scan);
+}
+
 static const char* JitAggregateOperatorToString(JitAggregateOperator aggregateOp)
 {
     switch (aggregateOp) {
@@ -685,6 +691,8 @@ static void ExplainRangeScanPlan(Query* query, JitRangeScanPlan* plan)
 {
     if (plan->_command_type == JIT_COMMAND_UPDATE) {
         ExplainRangeUpdatePlan(query, (JitRangeUpdatePlan*)plan);
+    } else if (plan->_command_type == JIT_COMMAND_DELETE) {
+        ExplainRangeDeletePlan(query, (JitRangeDeletePlan*)plan);
     } else if (plan->_command_type == JIT_COMMAND_SELECT) {
         ExplainRangeSelectPlan(query, (JitRangeSelectPlan*)plan);
     } else {
@@ -369,7 +369,7 @@ void buildInsertRow(JitLlvmCodeGenContext* ctx, llvm::Value* row)
 }
 
 /** @brief Adds code to delete a row. */
-void buildDeleteRow(JitLlvmCodeGenContext* ctx)
+void buildDeleteRow(JitLlvmCodeGenContext* ctx, JitLlvmRuntimeCursor* cursor /* = nullptr */)
 {
     IssueDebugLog("Deleting row");
     llvm::Value* delete_row_res = AddDeleteRow(ctx);
@@ -377,6 +377,10 @@ void buildDeleteRow(JitLlvmCodeGenContext* ctx)
     JIT_IF_BEGIN(check_delete_row)
     JIT_IF_EVAL_CMP(delete_row_res, JIT_CONST(MOT::RC_OK), JIT_ICMP_NE)
     IssueDebugLog("Row not deleted");
+    // need to emit cleanup code
+    if (cursor != nullptr) {
+        AddDestroyCursor(ctx, cursor);
+    }
     JIT_RETURN(delete_row_res);
     JIT_IF_END()
 
@@ -62,8 +62,8 @@ bool buildFilterRow(
 /** @brief Adds code to insert a new row. */
 void buildInsertRow(JitLlvmCodeGenContext* ctx, llvm::Value* row);
 
-/** @brief Adds code to delete a row. */
-void buildDeleteRow(JitLlvmCodeGenContext* ctx);
+/** @brief Adds code to delete a row (the cursor, if any, is destroyed on failure). */
+void buildDeleteRow(JitLlvmCodeGenContext* ctx, JitLlvmRuntimeCursor* cursor = nullptr);
 
 /** @brief Adds code to get row from iterator. */
 llvm::Value* buildGetRowFromIterator(JitLlvmCodeGenContext* ctx, llvm::BasicBlock* endLoopBlock,
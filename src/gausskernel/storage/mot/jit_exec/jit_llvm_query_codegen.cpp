@@ -637,6 +637,84 @@ static JitContext* JitRangeUpdateCodegen(Query* query, const char* query_string,
     return jit_context;
 }
 
+static JitContext* JitRangeDeleteCodegen(Query* query, const char* query_string, JitRangeDeletePlan* plan)
+{
+    MOT_LOG_DEBUG("Generating code for MOT range delete at thread %p", (void*)pthread_self());
+
+    GsCodeGen* code_gen = SetupCodegenEnv();
+    if (code_gen == nullptr) {
+        return nullptr;
+    }
+    GsCodeGen::LlvmBuilder builder(code_gen->context());
+
+    JitLlvmCodeGenContext cg_ctx = {0};
+    MOT::Table* table = plan->_index_scan._table;
+    if (!InitCodeGenContext(&cg_ctx, code_gen, &builder, table, table->GetPrimaryIndex())) {
+        return nullptr;
+    }
+    JitLlvmCodeGenContext* ctx = &cg_ctx;
+
+    // prepare the jitted function (declare, get arguments into context and define locals)
+    CreateJittedFunction(ctx, "MotJittedRangeDelete");
+    IssueDebugLog("Starting execution of jitted range DELETE");
+
+    // initialize rows_processed local variable
+    buildResetRowsProcessed(ctx);
+
+    // begin the WHERE clause
+    int max_arg = 0;
+    MOT_LOG_DEBUG("Generating range cursor for range DELETE query");
+    JitLlvmRuntimeCursor cursor =
+        buildRangeCursor(ctx, &plan->_index_scan, &max_arg, JIT_RANGE_SCAN_MAIN, JIT_INDEX_SCAN_FORWARD, nullptr);
+    if (cursor.begin_itr == nullptr) {
+        MOT_LOG_TRACE("Failed to generate jitted code for range DELETE query: unsupported WHERE clause type");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+
+    JIT_WHILE_BEGIN(cursor_loop)
+    llvm::Value* res = AddIsScanEnd(ctx, JIT_INDEX_SCAN_FORWARD, &cursor, JIT_RANGE_SCAN_MAIN);
+    JIT_WHILE_EVAL_NOT(res)
+    llvm::Value* row = buildGetRowFromIterator(
+        ctx, JIT_WHILE_POST_BLOCK(), MOT::AccessType::DEL, JIT_INDEX_SCAN_FORWARD, &cursor, JIT_RANGE_SCAN_MAIN);
+
+    // check for additional filters
+    if (!buildFilterRow(ctx, row, &plan->_index_scan._filters, &max_arg, JIT_WHILE_COND_BLOCK())) {
+        MOT_LOG_TRACE("Failed to generate jitted code for range DELETE query: unsupported filter");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+
+    // row is already cached in concurrency control module, so we do not need to provide an argument
+    IssueDebugLog("Deleting row");
+    buildDeleteRow(ctx, &cursor);
+
+    // the next call will be executed only if the previous call to deleteRow succeeded
+    buildIncrementRowsProcessed(ctx);
+    JIT_WHILE_END()
+
+    // cleanup
+    IssueDebugLog("Reached end of range delete loop");
+    AddDestroyCursor(ctx, &cursor);
+
+    // execute *tp_processed = rows_processed
+    AddSetTpProcessed(ctx);
+
+    // signal to envelope executor scan ended
+    AddSetScanEnded(ctx, 1);
+
+    // return success from calling function
+    builder.CreateRet(llvm::ConstantInt::get(ctx->INT32_T, (int)MOT::RC_OK, true));
+
+    // wrap up
+    JitContext* jit_context = FinalizeCodegen(ctx, max_arg, JIT_COMMAND_RANGE_DELETE);
+
+    // cleanup
+    DestroyCodeGenContext(ctx);
+
+    return jit_context;
+}
+
 static JitContext* JitInsertCodegen(Query* query, const char* query_string, JitInsertPlan* plan)
 {
     MOT_LOG_DEBUG("Generating code for MOT insert at thread %p", (void*)pthread_self());
@@ -1943,6 +2021,10 @@ static JitContext* JitRangeScanCodegen(Query* query, const char* query_string, J
             jit_context = JitRangeUpdateCodegen(query, query_string, (JitRangeUpdatePlan*)plan);
             break;
 
+        case JIT_COMMAND_DELETE:
+            jit_context = JitRangeDeleteCodegen(query, query_string, (JitRangeDeletePlan*)plan);
+            break;
+
         case JIT_COMMAND_SELECT: {
             JitRangeSelectPlan* range_select_plan = (JitRangeSelectPlan*)plan;
             if (range_select_plan->_aggregate._aggreaget_op == JIT_AGGREGATE_NONE) {
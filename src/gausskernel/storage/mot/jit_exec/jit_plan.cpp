@@ -1019,6 +1019,22 @@ static JitPlan* JitPrepareRangeUpdatePlan(Query* query, MOT::Table* table)
     return (JitPlan*)plan;
 }
 
+static JitPlan* JitPrepareRangeDeletePlan(Query* query, MOT::Table* table)
+{
+    MOT_LOG_TRACE("Preparing range DELETE plan for table %s", table->GetTableName().c_str());
+    size_t alloc_size = sizeof(JitRangeDeletePlan);
+    int index_id = 0;  // primary index
+    JitRangeDeletePlan* plan = (JitRangeDeletePlan*)JitPrepareRangeScanPlan(
+        query, table, index_id, alloc_size, JIT_COMMAND_DELETE, JoinClauseNone);
+    if (plan == nullptr) {
+        MOT_LOG_TRACE("Failed to prepare Range DELETE plan");
+    } else {
+        plan->_index_scan._sort_order = JIT_QUERY_SORT_ASCENDING;
+        plan->_index_scan._scan_direction = JIT_INDEX_SCAN_FORWARD;
+    }
+    return (JitPlan*)plan;
+}
+
 static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinClauseType join_clause_type)
 {
     MOT_LOG_TRACE("Preparing range SELECT plan for table %s", table->GetTableName().c_str());
@@ -1040,6 +1056,12 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
     size_t alloc_size = sizeof(JitRangeSelectPlan);
 
     for (int index_id = 0; index_id < (int)table->GetNumIndexes(); ++index_id) {
+        // hash indexes cannot be scanned by range, leave the point lookups to the FDW
+        if (table->GetIndex(index_id)->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+            MOT_LOG_TRACE("Skipping hash index %d", index_id);
+            continue;
+        }
+
         MOT_LOG_TRACE("Attempting to prepare plan with index %d", index_id);
         JitRangeSelectPlan* next_plan = (JitRangeSelectPlan*)JitPrepareRangeScanPlan(
             query, table, index_id, alloc_size, JIT_COMMAND_SELECT, join_clause_type);
@@ -1166,7 +1188,13 @@ static JitPlan* JitPrepareSimplePlan(Query* query)
                     plan = JitPrepareRangeSelectPlan(query, table, JoinClauseNone);
                 }
             } else {
-                MOT_LOG_TRACE("JitPrepareSimplePlan(): Disqualifying unsupported range delete query");
+                if (!CheckQueryAttributes(
+                        query, false, false, false)) {  // range delete does not expect sort clause or aggregate clause
+                    MOT_LOG_TRACE(
+                        "JitPrepareSimplePlan(): Disqualifying range delete query - Invalid query attributes");
+                } else {
+                    plan = JitPrepareRangeDeletePlan(query, table);
+                }
             }
         }
     }
@@ -126,7 +126,8 @@ struct JitRangeScanPlan {
     /** @var The type of plan being used (always @ref JIT_PLAN_RANGE_SCAN). */
     JitPlanType _plan_type;
 
-    /** @var The command type being used (either @ref JIT_COMMAND_UPDATE or @ref JIT_COMMAND_SELECT). */
+    /** @var The command type being used (either @ref JIT_COMMAND_UPDATE, @ref JIT_COMMAND_DELETE or @ref
+     * JIT_COMMAND_SELECT). */
     JitCommandType _command_type;
 
     /** @var Defines how to make the scan. */
@@ -148,6 +149,18 @@ struct JitRangeUpdatePlan {
     JitColumnExprArray _update_exprs;
 };
 
+/** @strut Plan for DELETE range queries. */
+struct JitRangeDeletePlan {
+    /** @var The type of plan being used (always @ref JIT_PLAN_RANGE_SCAN). */
+    JitPlanType _plan_type;
+
+    /** @var The command type being used (always @ref JIT_COMMAND_DELETE). */
+    JitCommandType _command_type;
+
+    /** @var Defines how to make the scan. */
+    JitIndexScan _index_scan;
+};
+
 /** @strut Plan for SELECT range queries. */
 struct JitRangeSelectPlan {
     /** @var The type of plan being used (always @ref JIT_PLAN_RANGE_SCAN). */
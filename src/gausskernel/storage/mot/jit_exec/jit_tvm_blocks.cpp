@@ -344,7 +344,7 @@ void buildInsertRow(JitTvmCodeGenContext* ctx, Instruction* row)
     IssueDebugLog("Row inserted");
 }
 
-void buildDeleteRow(JitTvmCodeGenContext* ctx)
+void buildDeleteRow(JitTvmCodeGenContext* ctx, JitTvmRuntimeCursor* cursor /* = nullptr */)
 {
     IssueDebugLog("Deleting row");
     Instruction* delete_row_res = AddDeleteRow(ctx);
@@ -352,6 +352,10 @@ void buildDeleteRow(JitTvmCodeGenContext* ctx)
     JIT_IF_BEGIN(check_delete_row)
     JIT_IF_EVAL_CMP(delete_row_res, JIT_CONST(MOT::RC_OK), JIT_ICMP_NE)
     IssueDebugLog("Row not deleted");
+    // need to emit cleanup code
+    if (cursor != nullptr) {
+        AddDestroyCursor(ctx, cursor);
+    }
     JIT_RETURN(delete_row_res);
     JIT_IF_END()
 
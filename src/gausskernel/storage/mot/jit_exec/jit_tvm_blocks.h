@@ -53,7 +53,7 @@ bool buildFilterRow(JitTvmCodeGenContext* ctx, tvm::Instruction* row, JitFilterA
 
 void buildInsertRow(JitTvmCodeGenContext* ctx, tvm::Instruction* row);
 
-void buildDeleteRow(JitTvmCodeGenContext* ctx);
+void buildDeleteRow(JitTvmCodeGenContext* ctx, JitTvmRuntimeCursor* cursor = nullptr);
 
 tvm::Instruction* buildGetRowFromIterator(JitTvmCodeGenContext* ctx, tvm::BasicBlock* endLoopBlock,
     MOT::AccessType access_mode, JitIndexScanDirection index_scan_direction, JitTvmRuntimeCursor* cursor,
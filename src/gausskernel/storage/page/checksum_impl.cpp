@@ -16,64 +16,257 @@
 #include "knl/knl_variable.h"
 #include "storage/checksum_impl.h"
 
-void ChecksumForZeroPadding(uint32 *sums, const uint32 *dataArr, uint32 currentLeft, uint32 alignSize);
+#if defined(__x86_64__) && defined(__GNUC__)
+#define USE_CHECKSUM_X86_SIMD
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define USE_CHECKSUM_NEON
+#include <arm_neon.h>
+#endif
+
+/* bytes of one row of the N_SUMS columns */
+#define CHECKSUM_ROW_SIZE (sizeof(uint32) * N_SUMS)
 
-static inline uint32 pg_checksum_init(uint32 seed, uint32 value)
+/* fold nrows rows of data into the partial checksums */
+typedef void (*ChecksumRowsFunc)(uint32* sums, const uint32* dataArr, uint32 nrows);
+
+static void pg_checksum_rows_scalar(uint32* sums, const uint32* dataArr, uint32 nrows)
 {
-    CHECKSUM_COMP(seed, value);
-    return seed;
+    uint32 localSums[N_SUMS];
+    uint32 i, j;
+
+    /* a local copy lets the compiler keep the columns in registers */
+    for (j = 0; j < N_SUMS; j++) {
+        localSums[j] = sums[j];
+    }
+
+    for (i = 0; i < nrows; i++) {
+        for (j = 0; j < N_SUMS; j += 2) {
+            CHECKSUM_COMP(localSums[j], dataArr[j]);
+            CHECKSUM_COMP(localSums[j + 1], dataArr[j + 1]);
+        }
+        dataArr += N_SUMS;
+    }
+
+    for (j = 0; j < N_SUMS; j++) {
+        sums[j] = localSums[j];
+    }
 }
 
-uint32 DataBlockChecksum(char* data, uint32 size, bool zeroing)
+#ifdef USE_CHECKSUM_X86_SIMD
+/* CHECKSUM_COMP() on 8 or 16 columns, pmulld keeps the low 32 bits like uint32 does */
+#define CHECKSUM_COMP_AVX2(sum, dataPtr)                                             \
+    do {                                                                             \
+        __m256i __tmp = _mm256_xor_si256((sum), _mm256_loadu_si256((const __m256i*)(dataPtr))); \
+        (sum) = _mm256_xor_si256(_mm256_mullo_epi32(__tmp, prime), _mm256_srli_epi32(__tmp, 17)); \
+    } while (0)
+
+#define CHECKSUM_COMP_AVX512(sum, dataPtr)                                           \
+    do {                                                                             \
+        __m512i __tmp = _mm512_xor_si512((sum), _mm512_loadu_si512((const void*)(dataPtr))); \
+        (sum) = _mm512_xor_si512(_mm512_mullo_epi32(__tmp, prime), _mm512_srli_epi32(__tmp, 17)); \
+    } while (0)
+
+__attribute__((target("avx2"))) static void pg_checksum_rows_avx2(uint32* sums, const uint32* dataArr, uint32 nrows)
 {
-    uint32 sums[N_SUMS];
-    uint32* dataArr = (uint32*)data;
-    uint32 result = 0;
-    uint32 i, j;
-    uint32 currentLeft = size;
+    const __m256i prime = _mm256_set1_epi32(FNV_PRIME);
+    __m256i sum0 = _mm256_loadu_si256((const __m256i*)sums);
+    __m256i sum1 = _mm256_loadu_si256((const __m256i*)(sums + 8));
+    __m256i sum2 = _mm256_loadu_si256((const __m256i*)(sums + 16));
+    __m256i sum3 = _mm256_loadu_si256((const __m256i*)(sums + 24));
 
-    /* ensure that the size is compatible with the algorithm */
-    uint32 alignSize = sizeof(uint32) * N_SUMS;
-    Assert(zeroing || (size % alignSize == 0));
+    for (uint32 i = 0; i < nrows; i++) {
+        CHECKSUM_COMP_AVX2(sum0, dataArr);
+        CHECKSUM_COMP_AVX2(sum1, dataArr + 8);
+        CHECKSUM_COMP_AVX2(sum2, dataArr + 16);
+        CHECKSUM_COMP_AVX2(sum3, dataArr + 24);
+        dataArr += N_SUMS;
+    }
+
+    _mm256_storeu_si256((__m256i*)sums, sum0);
+    _mm256_storeu_si256((__m256i*)(sums + 8), sum1);
+    _mm256_storeu_si256((__m256i*)(sums + 16), sum2);
+    _mm256_storeu_si256((__m256i*)(sums + 24), sum3);
+}
+
+__attribute__((target("avx512f"))) static void pg_checksum_rows_avx512(uint32* sums, const uint32* dataArr,
+                                                                       uint32 nrows)
+{
+    const __m512i prime = _mm512_set1_epi32(FNV_PRIME);
+    __m512i sum0 = _mm512_loadu_si512((const void*)sums);
+    __m512i sum1 = _mm512_loadu_si512((const void*)(sums + 16));
+
+    for (uint32 i = 0; i < nrows; i++) {
+        CHECKSUM_COMP_AVX512(sum0, dataArr);
+        CHECKSUM_COMP_AVX512(sum1, dataArr + 16);
+        dataArr += N_SUMS;
+    }
+
+    _mm512_storeu_si512((void*)sums, sum0);
+    _mm512_storeu_si512((void*)(sums + 16), sum1);
+}
+
+/* XCR0, the register states the OS saves on context switch */
+static uint64 pg_checksum_xgetbv(void)
+{
+    uint32 eax, edx;
+
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64)edx << 32) | eax;
+}
 
-    /* initialize partial checksums to their corresponding offsets */
-    auto realSize = size < alignSize ? size : alignSize;
+/* bit (1 << kernel) per usable kernel, probed once since CPUID may trap to a hypervisor */
+static volatile int g_checksumX86Kernels = -1;
 
-    uint32 *initUint32 = NULL;
-    char usedForInit[sizeof(uint32) * N_SUMS] = {0};
-    if (zeroing && size < alignSize) {
-        errno_t rc = memcpy_s(usedForInit, alignSize, (char *) dataArr, realSize);
-        securec_check(rc, "", "");
-        currentLeft -= realSize;
-        initUint32 = (uint32*)usedForInit;
-    } else {
-        initUint32 = dataArr;
-        currentLeft -= alignSize;
+static bool pg_checksum_x86_supported(ChecksumKernel kernel)
+{
+    unsigned int eax, ebx, ecx, edx;
+    uint64 xcr0;
+    int kernels = 0;
+
+    if (g_checksumX86Kernels >= 0) {
+        return (g_checksumX86Kernels & (1 << kernel)) != 0;
     }
 
-    for (j = 0; j < N_SUMS; j += 2) {
-        sums[j] = pg_checksum_init(g_checksumBaseOffsets[j], initUint32[j]);
-        sums[j + 1] = pg_checksum_init(g_checksumBaseOffsets[j + 1], initUint32[j + 1]);
+    /* OSXSAVE, without it the YMM and ZMM registers are not usable */
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1 << 27)) != 0) {
+        xcr0 = pg_checksum_xgetbv();
+        if ((xcr0 & 0x6) == 0x6 && __get_cpuid_max(0, NULL) >= 7) {
+            __cpuid_count(7, 0, eax, ebx, ecx, edx);
+            if ((ebx & (1 << 5)) != 0) {
+                kernels |= 1 << CHECKSUM_KERNEL_AVX2;
+            }
+            /* AVX-512F also needs the opmask and upper ZMM states enabled */
+            if ((xcr0 & 0xe6) == 0xe6 && (ebx & (1 << 16)) != 0) {
+                kernels |= 1 << CHECKSUM_KERNEL_AVX512;
+            }
+        }
     }
-    dataArr += N_SUMS;
+    g_checksumX86Kernels = kernels;
 
-    /* main checksum calculation */
-    for (i = 1; i < size / alignSize; i++) {
-        for (j = 0; j < N_SUMS; j += 2) {
-            CHECKSUM_COMP(sums[j], dataArr[j]);
-            CHECKSUM_COMP(sums[j + 1], dataArr[j + 1]);
+    return (kernels & (1 << kernel)) != 0;
+}
+#endif /* USE_CHECKSUM_X86_SIMD */
+
+#ifdef USE_CHECKSUM_NEON
+#define CHECKSUM_COMP_NEON(sum, dataPtr)                                   \
+    do {                                                                   \
+        uint32x4_t __tmp = veorq_u32((sum), vld1q_u32(dataPtr));           \
+        (sum) = veorq_u32(vmulq_u32(__tmp, prime), vshrq_n_u32(__tmp, 17)); \
+    } while (0)
+
+static void pg_checksum_rows_neon(uint32* sums, const uint32* dataArr, uint32 nrows)
+{
+    const uint32x4_t prime = vdupq_n_u32(FNV_PRIME);
+    uint32x4_t sum[N_SUMS / 4];
+    int j;
+
+    for (j = 0; j < N_SUMS / 4; j++) {
+        sum[j] = vld1q_u32(sums + j * 4);
+    }
+
+    for (uint32 i = 0; i < nrows; i++) {
+        for (j = 0; j < N_SUMS / 4; j++) {
+            CHECKSUM_COMP_NEON(sum[j], dataArr + j * 4);
         }
         dataArr += N_SUMS;
     }
 
-    /* checksum for zero padding */
-    currentLeft -= alignSize * (i - 1);
-    if (currentLeft > 0 && currentLeft < alignSize && zeroing) {
-        ChecksumForZeroPadding(sums, dataArr, currentLeft, alignSize);
+    for (j = 0; j < N_SUMS / 4; j++) {
+        vst1q_u32(sums + j * 4, sum[j]);
     }
+}
+#endif /* USE_CHECKSUM_NEON */
+
+static const char* const g_checksumKernelNames[CHECKSUM_KERNEL_NUM] = {"scalar", "avx2", "avx512", "neon"};
+
+static const ChecksumRowsFunc g_checksumKernels[CHECKSUM_KERNEL_NUM] = {
+    pg_checksum_rows_scalar,
+#ifdef USE_CHECKSUM_X86_SIMD
+    pg_checksum_rows_avx2,
+    pg_checksum_rows_avx512,
+#else
+    NULL,
+    NULL,
+#endif
+#ifdef USE_CHECKSUM_NEON
+    pg_checksum_rows_neon
+#else
+    NULL
+#endif
+};
+
+bool pg_checksum_kernel_supported(ChecksumKernel kernel)
+{
+    if (kernel < CHECKSUM_KERNEL_SCALAR || kernel >= CHECKSUM_KERNEL_NUM || g_checksumKernels[kernel] == NULL) {
+        return false;
+    }
+#ifdef USE_CHECKSUM_X86_SIMD
+    if (kernel == CHECKSUM_KERNEL_AVX2 || kernel == CHECKSUM_KERNEL_AVX512) {
+        return pg_checksum_x86_supported(kernel);
+    }
+#endif
+    return true;
+}
+
+const char* pg_checksum_kernel_name(ChecksumKernel kernel)
+{
+    if (kernel < CHECKSUM_KERNEL_SCALAR || kernel >= CHECKSUM_KERNEL_NUM) {
+        return "unknown";
+    }
+    return g_checksumKernelNames[kernel];
+}
+
+ChecksumKernel pg_checksum_current_kernel(void)
+{
+    /*
+     * AVX2 goes first: the 32 columns are latency bound either way, so
+     * AVX-512 is not faster and may lower the clock on some CPUs.
+     */
+    static const ChecksumKernel preferred[] = {
+        CHECKSUM_KERNEL_AVX2, CHECKSUM_KERNEL_AVX512, CHECKSUM_KERNEL_NEON};
+
+    for (uint32 i = 0; i < lengthof(preferred); i++) {
+        if (pg_checksum_kernel_supported(preferred[i])) {
+            return preferred[i];
+        }
+    }
+    return CHECKSUM_KERNEL_SCALAR;
+}
+
+static void pg_checksum_rows_choose(uint32* sums, const uint32* dataArr, uint32 nrows);
+
+/*
+ * Resolved on the first call, like pg_comp_crc32c.  Threads racing here all
+ * store the same pointer.
+ */
+static ChecksumRowsFunc pg_checksum_rows = pg_checksum_rows_choose;
+
+static void pg_checksum_rows_choose(uint32* sums, const uint32* dataArr, uint32 nrows)
+{
+    pg_checksum_rows = g_checksumKernels[pg_checksum_current_kernel()];
+    pg_checksum_rows(sums, dataArr, nrows);
+}
+
+/*
+ * Initialize partial checksums to their corresponding offsets.  Folding in
+ * the first row from there is what initializing with it used to do.
+ */
+static inline void pg_checksum_start(uint32* sums)
+{
+    errno_t rc = memcpy_s(sums, sizeof(uint32) * N_SUMS, g_checksumBaseOffsets, sizeof(g_checksumBaseOffsets));
+    securec_check(rc, "", "");
+}
+
+static inline uint32 pg_checksum_finish(uint32* sums)
+{
+    uint32 result = 0;
 
     /* finally add in two rounds of zeroes for additional mixing */
-    for (j = 0; j < N_SUMS; j++) {
+    for (uint32 j = 0; j < N_SUMS; j++) {
         CHECKSUM_COMP(sums[j], 0);
         CHECKSUM_COMP(sums[j], 0);
 
@@ -84,56 +277,61 @@ uint32 DataBlockChecksum(char* data, uint32 size, bool zeroing)
     return result;
 }
 
-void ChecksumForZeroPadding(uint32 *sums, const uint32 *dataArr, uint32 currentLeft, uint32 alignSize)
+static uint32 pg_checksum_block_rows(ChecksumRowsFunc rowsFunc, char* data, uint32 size)
 {
-    auto maxLen = sizeof(uint32) * N_SUMS;
-    char currentLeftChars[maxLen] = {0};
-    errno_t rc = memcpy_s(currentLeftChars, maxLen, (char *)dataArr, currentLeft);
-    securec_check(rc, "", "");
-    for (int j = 0; j < N_SUMS; j += 2) {
-        CHECKSUM_COMP(sums[j], ((uint32 *)currentLeftChars)[j]);
-        CHECKSUM_COMP(sums[j + 1], ((uint32 *)currentLeftChars)[j + 1]);
-    }
+    uint32 sums[N_SUMS];
+
+#ifndef ROACH_COMMON
+    /* ensure that the size is compatible with the algorithm */
+    Assert((size % CHECKSUM_ROW_SIZE) == 0);
+#endif
+
+    pg_checksum_start(sums);
+    /* the first row is always used, as the initialization step did */
+    rowsFunc(sums, (uint32*)data, Max(size / CHECKSUM_ROW_SIZE, 1));
+    return pg_checksum_finish(sums);
 }
 
-uint32 pg_checksum_block(char* data, uint32 size)
+uint32 DataBlockChecksum(char* data, uint32 size, bool zeroing)
 {
     uint32 sums[N_SUMS];
-    uint32* dataArr = (uint32*)data;
-    uint32 result = 0;
-    uint32 i, j;
+    uint32 nrows = size / CHECKSUM_ROW_SIZE;
+    uint32 currentLeft = size % CHECKSUM_ROW_SIZE;
 
-#ifndef ROACH_COMMON
     /* ensure that the size is compatible with the algorithm */
-    Assert((size % (sizeof(uint32) * N_SUMS)) == 0);
-#endif
+    Assert(zeroing || currentLeft == 0);
 
-    /* initialize partial checksums to their corresponding offsets */
-    for (j = 0; j < N_SUMS; j += 2) {
-        sums[j] = pg_checksum_init(g_checksumBaseOffsets[j], dataArr[j]);
-        sums[j + 1] = pg_checksum_init(g_checksumBaseOffsets[j + 1], dataArr[j + 1]);
-    }
-    dataArr += N_SUMS;
+    pg_checksum_start(sums);
+    pg_checksum_rows(sums, (uint32*)data, nrows);
 
-    /* main checksum calculation */
-    for (i = 1; i < size / (sizeof(uint32) * N_SUMS); i++) {
-        for (j = 0; j < N_SUMS; j += 2) {
-            CHECKSUM_COMP(sums[j], dataArr[j]);
-            CHECKSUM_COMP(sums[j + 1], dataArr[j + 1]);
+    /* checksum for zero padding, a short block is one padded row */
+    if ((currentLeft > 0 && zeroing) || nrows == 0) {
+        uint32 lastRow[N_SUMS] = {0};
+        if (currentLeft > 0) {
+            errno_t rc = memcpy_s(lastRow, sizeof(lastRow), data + nrows * CHECKSUM_ROW_SIZE, currentLeft);
+            securec_check(rc, "", "");
         }
-        dataArr += N_SUMS;
+        pg_checksum_rows_scalar(sums, lastRow, 1);
     }
 
-    /* finally add in two rounds of zeroes for additional mixing */
-    for (j = 0; j < N_SUMS; j++) {
-        CHECKSUM_COMP(sums[j], 0);
-        CHECKSUM_COMP(sums[j], 0);
+    return pg_checksum_finish(sums);
+}
 
-        /* xor fold partial checksums together */
-        result ^= sums[j];
-    }
+uint32 pg_checksum_block(char* data, uint32 size)
+{
+    return pg_checksum_block_rows(pg_checksum_rows, data, size);
+}
 
-    return result;
+/*
+ * pg_checksum_block() with the given kernel, for tests and benchmarks.  An
+ * unsupported kernel falls back to the scalar one.
+ */
+uint32 pg_checksum_block_kernel(ChecksumKernel kernel, char* data, uint32 size)
+{
+    if (!pg_checksum_kernel_supported(kernel)) {
+        kernel = CHECKSUM_KERNEL_SCALAR;
+    }
+    return pg_checksum_block_rows(g_checksumKernels[kernel], data, size);
 }
 
 /*
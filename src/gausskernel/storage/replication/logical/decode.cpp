@@ -223,6 +223,11 @@ void LogicalDecodingProcessRecord(LogicalDecodingContext *ctx, XLogReaderState *
         return;
     }
 
+    /* the first record of a subtransaction tells its toplevel transaction */
+    if (TransactionIdIsValid(XLogRecGetTopXid(record))) {
+        ReorderBufferAssignChild(ctx->reorder, XLogRecGetTopXid(record), XLogRecGetXid(record), buf.origptr);
+    }
+
     ResourceOwner tmpOwner = t_thrd.utils_cxt.CurrentResourceOwner;
     /* cast so we get a warning when new rmgrs are added */
     switch ((RmgrIds)XLogRecGetRmid(record)) {
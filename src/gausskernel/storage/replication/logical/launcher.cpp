@@ -158,7 +158,8 @@ List *logicalrep_workers_find(Oid subid, bool only_running)
 
 /*
  * Walks the workers array and searches for one that matches given
- * subscription id and relid.
+ * subscription id and relid. Parallel apply workers are owned by their
+ * leader and never returned here.
  */
 LogicalRepWorker *logicalrep_worker_find(Oid subid, Oid relid, bool only_running)
 {
@@ -169,7 +170,7 @@ LogicalRepWorker *logicalrep_worker_find(Oid subid, Oid relid, bool only_running
     /* Search for attached worker for a given subscription id. */
     for (i = 0; i < g_instance.attr.attr_storage.max_logical_replication_workers; i++) {
         LogicalRepWorker *w = &t_thrd.applylauncher_cxt.applyLauncherShm->workers[i];
-        if (w->subid == subid && w->relid == relid && (!only_running || w->proc)) {
+        if (w->subid == subid && w->relid == relid && w->parallelShared == NULL && (!only_running || w->proc)) {
             res = w;
             break;
         }
@@ -220,6 +221,8 @@ static void WaitForReplicationWorkerAttach()
         worker->subid = InvalidOid;
         worker->proc = NULL;
         worker->workerLaunchTime = 0;
+        worker->parallelId = -1;
+        worker->parallelShared = NULL;
         t_thrd.applylauncher_cxt.applyLauncherShm->startingWorker = NULL;
         LWLockRelease(LogicalRepWorkerLock);
     }
@@ -228,8 +231,12 @@ static void WaitForReplicationWorkerAttach()
 
 /*
  * Start new apply background worker.
+ *
+ * parallelId and parallelShared are only set by an apply worker starting its
+ * parallel apply workers, see parallel_apply.cpp.
  */
-void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid)
+void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid,
+    int parallelId, ParallelApplyShared *parallelShared)
 {
     int slot;
     LogicalRepWorker *worker = NULL;
@@ -279,6 +286,8 @@ void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid user
     worker->reply_lsn = InvalidXLogRecPtr;
     TIMESTAMP_NOBEGIN(worker->reply_time);
     worker->workerLaunchTime = GetCurrentTimestamp();
+    worker->parallelId = parallelId;
+    worker->parallelShared = parallelShared;
 
     t_thrd.applylauncher_cxt.applyLauncherShm->startingWorker = worker;
     LWLockRelease(LogicalRepWorkerLock);
@@ -444,6 +453,8 @@ static void logicalrep_worker_detach(void)
     t_thrd.applyworker_cxt.curWorker->subid = InvalidOid;
     t_thrd.applyworker_cxt.curWorker->proc = NULL;
     t_thrd.applyworker_cxt.curWorker->workerLaunchTime = 0;
+    t_thrd.applyworker_cxt.curWorker->parallelId = -1;
+    t_thrd.applyworker_cxt.curWorker->parallelShared = NULL;
 
     LWLockRelease(LogicalRepWorkerLock);
 }
@@ -579,6 +590,7 @@ void ApplyLauncherShmemInit(void)
             rc = memset_s(worker, sizeof(LogicalRepWorker), 0, sizeof(LogicalRepWorker));
             securec_check(rc, "", "");
             SpinLockInit(&worker->relmutex);
+            worker->parallelId = -1;
         }
     }
 }
@@ -877,6 +889,10 @@ Datum pg_stat_get_subscription(PG_FUNCTION_ARGS)
         if (OidIsValid(subid) && worker.subid != subid)
             continue;
 
+        /* Parallel apply workers are reported through their leader. */
+        if (worker.parallelShared != NULL)
+            continue;
+
         worker_pid = worker.proc->pid;
 
         rc = memset_s(values, sizeof(values), 0, sizeof(values));
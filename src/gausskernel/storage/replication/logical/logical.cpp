@@ -74,6 +74,10 @@ static void begin_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
 static void commit_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, XLogRecPtr commit_lsn);
 static void abort_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
 static void prepare_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
+static void stream_start_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
+static void stream_stop_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
+static void stream_commit_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, XLogRecPtr commit_lsn);
+static void stream_abort_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn);
 
 static void change_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, Relation relation,
                               ReorderBufferChange *change);
@@ -169,6 +173,10 @@ static LogicalDecodingContext *StartupDecodingContext(List *output_plugin_option
     ctx->reorder->begin = begin_cb_wrapper;
     ctx->reorder->apply_change = change_cb_wrapper;
     ctx->reorder->commit = commit_cb_wrapper;
+    ctx->reorder->stream_start = stream_start_cb_wrapper;
+    ctx->reorder->stream_stop = stream_stop_cb_wrapper;
+    ctx->reorder->stream_commit = stream_commit_cb_wrapper;
+    ctx->reorder->stream_abort = stream_abort_cb_wrapper;
 
     ctx->out = makeStringInfo();
     ctx->prepare_write = prepare_write;
@@ -512,6 +520,11 @@ LogicalDecodingContext *CreateDecodingContext(XLogRecPtr start_lsn, List *output
         startup_cb_wrapper(ctx, &ctx->options, false);
     (void)MemoryContextSwitchTo(old_context);
 
+    /* stream large transactions only if the plugin asked for it and can handle the streams */
+    ctx->reorder->streaming = ctx->streaming && ctx->callbacks.stream_start_cb != NULL &&
+                              ctx->callbacks.stream_stop_cb != NULL && ctx->callbacks.stream_commit_cb != NULL &&
+                              ctx->callbacks.stream_abort_cb != NULL;
+
     if (!RecoveryInProgress())
         ereport(LOG, (errmsg("starting logical decoding for slot %s", NameStr(slot->data.name)),
                       errdetail("streaming transactions committing after %X/%X, reading WAL from %X/%X",
@@ -982,6 +995,120 @@ static void change_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, Relat
     t_thrd.log_cxt.error_context_stack = errcallback.previous;
 }
 
+static void stream_start_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_start";
+    state.report_location = txn->first_lsn;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = txn->first_lsn;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_start_cb(ctx, txn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_stop_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_stop";
+    state.report_location = ctx->write_location;
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state, the location stays at the last streamed change */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_stop_cb(ctx, txn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_commit_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn, XLogRecPtr commit_lsn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_commit";
+    state.report_location = txn->final_lsn; /* beginning of commit record */
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+    ctx->write_location = txn->end_lsn; /* points to the end of the record */
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_commit_cb(ctx, txn, commit_lsn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
+static void stream_abort_cb_wrapper(ReorderBuffer *cache, ReorderBufferTXN *txn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)cache->private_data;
+    LogicalErrorCallbackState state;
+    ErrorContextCallback errcallback;
+
+    Assert(!ctx->fast_forward);
+
+    /* Push callback + info on the error context stack */
+    state.ctx = ctx;
+    state.callback_name = "stream_abort";
+    state.report_location = txn->final_lsn; /* beginning of abort record */
+    errcallback.callback = output_plugin_error_callback;
+    errcallback.arg = (void *)&state;
+    errcallback.previous = t_thrd.log_cxt.error_context_stack;
+    t_thrd.log_cxt.error_context_stack = &errcallback;
+
+    /* set output state */
+    ctx->accept_writes = true;
+    ctx->write_xid = txn->xid;
+
+    /* do the actual work: call callback */
+    ctx->callbacks.stream_abort_cb(ctx, txn);
+
+    /* Pop the error context stack */
+    t_thrd.log_cxt.error_context_stack = errcallback.previous;
+}
+
 bool filter_by_origin_cb_wrapper(LogicalDecodingContext *ctx, RepOriginId origin_id)
 {
     LogicalErrorCallbackState state;
@@ -358,6 +358,35 @@ void ParseAbortXlog(ParallelLogicalDecodingContext *ctx, XLogRecPtr lsn, Transac
     PutChangeQueue(slotId, change);
 }
 
+/*
+ * Tell the sender which toplevel transaction the subtransactions belong to,
+ * it needs to know that before their first change to stream transactions.
+ */
+void ParseAssignmentXlog(ParallelLogicalDecodingContext *ctx, TransactionId xtop, TransactionId *sub_xids,
+    int nsubxacts, ParallelDecodeReaderWorker *worker)
+{
+    ParallelReorderBufferChange *change = NULL;
+    int slotId = worker->slotId;
+
+    if (!g_Logicaldispatcher[slotId].pOptions.streaming || nsubxacts <= 0) {
+        return;
+    }
+
+    change = ParallelReorderBufferGetChange(ctx->reorder, slotId);
+
+    change->action = PARALLEL_REORDER_BUFFER_ASSIGNMENT;
+    change->xid = xtop;
+    change->lsn = ctx->reader->ReadRecPtr;
+    change->nsubxacts = nsubxacts;
+    MemoryContext oldCtx = MemoryContextSwitchTo(g_instance.comm_cxt.pdecode_cxt[slotId].parallelDecodeCtx);
+    change->subXids = (TransactionId *)palloc0(sizeof(TransactionId) * nsubxacts);
+    errno_t rc =
+        memcpy_s(change->subXids, sizeof(TransactionId) * nsubxacts, sub_xids, sizeof(TransactionId) * nsubxacts);
+    securec_check(rc, "", "");
+    MemoryContextSwitchTo(oldCtx);
+    PutChangeQueue(slotId, change);
+}
+
 /*
  * Handle rmgr HEAP2_ID records.
  */
@@ -1147,6 +1176,12 @@ void ParseProcessRecord(ParallelLogicalDecodingContext *ctx, XLogReaderState *re
     buf.record = record;
     buf.record_data = GetXlrec(record);
 
+    /* the first record of a subtransaction tells its toplevel transaction */
+    if (TransactionIdIsValid(XLogRecGetTopXid(record))) {
+        TransactionId subxid = XLogRecGetXid(record);
+        ParseAssignmentXlog(ctx, XLogRecGetTopXid(record), &subxid, 1, worker);
+    }
+
     /* cast so we get a warning when new rmgrs are added */
     switch ((RmgrIds)XLogRecGetRmid(record)) {
         /*
@@ -1269,7 +1304,12 @@ void ParseXactOp(ParallelLogicalDecodingContext *ctx, XLogRecordBuffer *buf, Par
             ParseAbortXlog(ctx, buf->origptr, XLogRecGetXid(r), sub_xids, xlrec->nsubxacts, worker);
             break;
         }
-        case XLOG_XACT_ASSIGNMENT:
+        case XLOG_XACT_ASSIGNMENT: {
+            xl_xact_assignment *xlrec = (xl_xact_assignment *)buf->record_data;
+
+            ParseAssignmentXlog(ctx, xlrec->xtop, &xlrec->xsub[0], xlrec->nsubxacts, worker);
+            break;
+        }
         case XLOG_XACT_PREPARE:
             break;
         default:
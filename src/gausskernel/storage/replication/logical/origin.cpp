@@ -982,8 +982,13 @@ static void ReplicationOriginExitCleanup(int code, Datum arg)
  * Obviously only one such cached origin can exist per process and the current
  * cached value can only be set again after the previous value is torn down
  * with replorigin_session_reset().
+ *
+ * If acquired_by is set, the origin must already be acquired by that thread
+ * and is shared with it instead of being acquired again. This is used by
+ * parallel apply workers, which commit on behalf of their leader in the
+ * leader's commit order. The sharing thread never releases the origin.
  */
-void replorigin_session_setup(RepOriginId node)
+void replorigin_session_setup(RepOriginId node, ThreadId acquired_by)
 {
     int i;
     int free_slot = -1;
@@ -1019,7 +1024,10 @@ void replorigin_session_setup(RepOriginId node)
         if (curstate->roident != node)
             continue;
 
-        else if (curstate->acquired_by != 0) {
+        else if (acquired_by != 0 && curstate->acquired_by != acquired_by) {
+            ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+                errmsg("replication identifier %d is not active for PID %lu", curstate->roident, acquired_by)));
+        } else if (acquired_by == 0 && curstate->acquired_by != 0) {
             ereport(ERROR, (errcode(ERRCODE_OBJECT_IN_USE), errmsg(
                 "replication identifier %d is already active for PID %lu", curstate->roident, curstate->acquired_by)));
         }
@@ -1028,7 +1036,10 @@ void replorigin_session_setup(RepOriginId node)
         u_sess->reporigin_cxt.curRepState = curstate;
     }
 
-    if (u_sess->reporigin_cxt.curRepState == NULL && free_slot == -1)
+    if (u_sess->reporigin_cxt.curRepState == NULL && acquired_by != 0)
+        ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+            errmsg("replication identifier %d is not active for PID %lu", node, acquired_by)));
+    else if (u_sess->reporigin_cxt.curRepState == NULL && free_slot == -1)
         ereport(ERROR, (errcode(ERRCODE_CONFIGURATION_LIMIT_EXCEEDED),
             errmsg("could not find free replication state slot for replication origin with OID %u", node),
             errhint("Increase max_replication_slots and try again.")));
@@ -1042,6 +1053,11 @@ void replorigin_session_setup(RepOriginId node)
 
     Assert(u_sess->reporigin_cxt.curRepState->roident != InvalidRepOriginId);
 
+    if (acquired_by != 0) {
+        LWLockRelease(ReplicationOriginLock);
+        return;
+    }
+
     u_sess->reporigin_cxt.curRepState->acquired_by = t_thrd.proc_cxt.MyProcPid;
 
     LWLockRelease(ReplicationOriginLock);
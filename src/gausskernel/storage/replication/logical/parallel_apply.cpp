@@ -0,0 +1,1089 @@
+/* ---------------------------------------------------------------------------------------
+ *
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * parallel_apply.cpp
+ *        Parallel apply of remote transactions for logical replication subscriptions.
+ *
+ *        When max_parallel_apply_workers_per_subscription is set, the apply worker
+ *        of a subscription becomes a leader. It buffers every remote transaction and,
+ *        at its COMMIT, hands it to one of the parallel apply workers. Every change
+ *        is described by the hash of its replica identity key and of the columns of
+ *        the local unique indexes it sets; a transaction that touches a key of a
+ *        transaction still in flight is queued behind it on the same worker,
+ *        otherwise it goes to the worker with the shortest queue. If it depends on
+ *        transactions of other workers as well, its worker waits for them to commit
+ *        before applying it, the leader goes on receiving.
+ *
+ *        Transactions are numbered in remote commit order and the workers commit
+ *        them strictly in that order, so the replication origin progress stays
+ *        exact and a crash restarts streaming from the right position. A worker
+ *        waiting for its turn waits on the transaction lock of the worker whose
+ *        turn it is, so that the deadlock detector sees the dependency. A worker
+ *        that fails before its turn, e.g. on a unique index conflict with an
+ *        earlier transaction, retries once all earlier transactions committed.
+ *
+ *        Transactions larger than PARALLEL_APPLY_MAX_TXN_SIZE are applied by the
+ *        leader itself, and the leader waits for the workers whenever tables are
+ *        being synchronized, so tablesync sees the same state as with serial apply.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/replication/logical/parallel_apply.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "miscadmin.h"
+#include "pgstat.h"
+
+#include "access/hash.h"
+#include "access/xact.h"
+
+#include "catalog/pg_class.h"
+
+#include "libpq/pqformat.h"
+
+#include "postmaster/postmaster.h"
+
+#include "replication/logicalproto.h"
+#include "replication/logicalrelation.h"
+#include "replication/origin.h"
+#include "replication/worker_internal.h"
+
+#include "storage/ipc.h"
+#include "storage/lmgr.h"
+#include "storage/proc.h"
+#include "storage/spin.h"
+
+#include "utils/guc.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+
+#define PARALLEL_APPLY_QUEUE_SIZE 64
+#define PARALLEL_APPLY_MAX_TXN_SIZE (64 * 1024 * 1024)
+#define PARALLEL_APPLY_MAX_KEYS 1000000
+#define PARALLEL_APPLY_INIT_KEYS 1024
+#define PARALLEL_APPLY_NAPTIME 10L /* max sleep time between checks (10ms) */
+
+/*
+ * Kinds of dependency keys. A row change checks the key of its row and the
+ * exclusive key of its relation, a change that cannot be described by its
+ * replica identity checks every transaction that touched the relation.
+ */
+#define PARALLEL_APPLY_KEY_ROW 0
+#define PARALLEL_APPLY_KEY_REL_TOUCH 1
+#define PARALLEL_APPLY_KEY_REL_EXCL 2
+#define PARALLEL_APPLY_KEY_UNIQUE 3
+#define PARALLEL_APPLY_MAKE_KEY(kind, value) (((uint64)(kind) << 32) | (uint32)(value))
+
+/* A remote transaction handed to a parallel apply worker */
+typedef struct ParallelApplyTxn {
+    uint64 seq;     /* position in remote commit order, starting from 1 */
+    uint64 waitSeq; /* transactions up to this one commit before it is applied */
+    int len;
+    char data[FLEXIBLE_ARRAY_MEMBER]; /* uint32 length prefixed protocol messages */
+} ParallelApplyTxn;
+
+typedef struct ParallelApplyWorkerSlot {
+    slock_t mutex;
+    PGPROC *proc;
+    uint64 curSeq;         /* transaction being applied, 0 if idle */
+    TransactionId curXid;  /* its local xid, once assigned */
+    uint64 head;
+    uint64 tail;
+    ParallelApplyTxn *queue[PARALLEL_APPLY_QUEUE_SIZE];
+} ParallelApplyWorkerSlot;
+
+/* State shared by the leader and its parallel apply workers */
+typedef struct ParallelApplyShared {
+    MemoryContext context;
+    PGPROC *leaderProc;
+    ThreadId leaderPid;
+    RepOriginId originId;
+    volatile bool shutdown;
+
+    slock_t mutex;
+    uint64 committedSeq;          /* all transactions up to this one committed */
+    uint64 retrySeq;              /* earliest transaction being retried, 0 if none */
+    XLogRecPtr committedRemoteEnd;
+    XLogRecPtr committedLocalEnd;
+
+    int nworkers;
+    ParallelApplyWorkerSlot slots[FLEXIBLE_ARRAY_MEMBER];
+} ParallelApplyShared;
+
+typedef struct ParallelApplyKeyOwner {
+    uint64 key;
+    uint64 seq;
+    int worker;
+} ParallelApplyKeyOwner;
+
+/* Leader only state, lives in t_thrd.applyworker_cxt.parallelLeader */
+typedef struct ParallelApplyLeader {
+    ParallelApplyShared *shared; /* NULL if applying serially */
+    MemoryContext context;
+    int configured;              /* max_parallel_apply_workers_per_subscription at start */
+    uint64 lastSeq;
+    XLogRecPtr lastStoredEnd;
+    HTAB *keyOwners;
+    StringInfo *pendingRel;      /* per worker RELATION messages it has not seen yet */
+    uint64 *conflictSeqs;        /* per worker latest transaction the current one depends on */
+
+    /* The remote transaction being received */
+    bool inTxn;
+    bool hasChanges;
+    bool localApply;
+    bool replaying;
+    StringInfoData txnBuf;
+    StringInfoData txnRel;
+    uint64 *keys;
+    int nkeys;
+    int maxkeys;
+} ParallelApplyLeader;
+
+static void ParallelApplyStop(ParallelApplyLeader *leader);
+
+static inline ParallelApplyShared *MyParallelApplyShared(void)
+{
+    return t_thrd.applyworker_cxt.curWorker->parallelShared;
+}
+
+static inline ParallelApplyWorkerSlot *MyParallelApplySlot(void)
+{
+    return &MyParallelApplyShared()->slots[t_thrd.applyworker_cxt.curWorker->parallelId];
+}
+
+static uint64 ParallelApplyCommittedSeq(ParallelApplyShared *shared, uint64 *retrySeq = NULL)
+{
+    uint64 committed;
+
+    SpinLockAcquire(&shared->mutex);
+    committed = shared->committedSeq;
+    if (retrySeq != NULL)
+        *retrySeq = shared->retrySeq;
+    SpinLockRelease(&shared->mutex);
+
+    return committed;
+}
+
+/* Wake up the leader and every worker, after a commit or a new transaction. */
+static void ParallelApplyWakeup(ParallelApplyShared *shared)
+{
+    for (int i = 0; i < shared->nworkers; i++) {
+        ParallelApplyWorkerSlot *slot = &shared->slots[i];
+        PGPROC *proc;
+
+        SpinLockAcquire(&slot->mutex);
+        proc = slot->proc;
+        SpinLockRelease(&slot->mutex);
+        if (proc != NULL)
+            SetLatch(&proc->procLatch);
+    }
+    SetLatch(&shared->leaderProc->procLatch);
+}
+
+static void ParallelApplyWaitLatch(void)
+{
+    int rc = WaitLatch(&t_thrd.proc->procLatch, WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH,
+        PARALLEL_APPLY_NAPTIME);
+    /* emergency bailout if postmaster has died */
+    if (rc & WL_POSTMASTER_DEATH)
+        proc_exit(1);
+
+    ResetLatch(&t_thrd.proc->procLatch);
+    CHECK_FOR_INTERRUPTS();
+}
+
+/* Count the worker slots still used by the parallel apply workers of shared. */
+static int ParallelApplyCountWorkers(ParallelApplyShared *shared)
+{
+    int count = 0;
+
+    LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+    for (int i = 0; i < g_instance.attr.attr_storage.max_logical_replication_workers; i++) {
+        if (t_thrd.applylauncher_cxt.applyLauncherShm->workers[i].parallelShared == shared)
+            count++;
+    }
+    LWLockRelease(LogicalRepWorkerLock);
+
+    return count;
+}
+
+/*
+ * Wait for something to change, as the leader. A parallel apply worker that
+ * exited takes its queued transactions with it, so the leader has to restart
+ * and stream them again.
+ */
+static void ParallelApplyLeaderWait(ParallelApplyLeader *leader)
+{
+    ParallelApplyWaitLatch();
+
+    if (ParallelApplyCountWorkers(leader->shared) < leader->shared->nworkers)
+        ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+            errmsg("logical replication parallel apply worker for subscription \"%s\" exited unexpectedly",
+                t_thrd.applyworker_cxt.mySubscription->name)));
+}
+
+static void ParallelApplyWaitCommitted(ParallelApplyLeader *leader, uint64 seq)
+{
+    while (ParallelApplyCommittedSeq(leader->shared) < seq)
+        ParallelApplyLeaderWait(leader);
+}
+
+/*
+ * Table synchronization relies on the apply worker having applied everything
+ * up to the position it reports, so wait for the workers while any table is
+ * not ready.
+ */
+static void ParallelApplySyncBarrier(ParallelApplyLeader *leader)
+{
+    if (!t_thrd.applyworker_cxt.tableStatesValid || t_thrd.applyworker_cxt.tableStates != NIL)
+        ParallelApplyWaitCommitted(leader, leader->lastSeq);
+}
+
+static void ParallelApplyAppendMessage(StringInfo buf, const char *data, int len)
+{
+    uint32 msglen = (uint32)len;
+
+    appendBinaryStringInfo(buf, (const char *)&msglen, sizeof(uint32));
+    appendBinaryStringInfo(buf, data, len);
+}
+
+/* Apply the messages buffered by ParallelApplyAppendMessage(). */
+static void ParallelApplyReplay(const char *data, int len)
+{
+    int off = 0;
+
+    while (off < len) {
+        StringInfoData s;
+        uint32 msglen;
+        errno_t rc = memcpy_s(&msglen, sizeof(uint32), data + off, sizeof(uint32));
+        securec_check(rc, "", "");
+        off += sizeof(uint32);
+
+        s.data = (char *)data + off;
+        s.len = (int)msglen;
+        s.cursor = 0;
+        s.maxlen = -1;
+
+        MemoryContextSwitchTo(t_thrd.applyworker_cxt.messageContext);
+        apply_dispatch(&s);
+        MemoryContextReset(t_thrd.applyworker_cxt.messageContext);
+
+        off += (int)msglen;
+    }
+}
+
+static void ParallelApplyResetKeys(ParallelApplyLeader *leader)
+{
+    HASHCTL ctl;
+
+    if (leader->keyOwners != NULL)
+        hash_destroy(leader->keyOwners);
+
+    errno_t rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+    securec_check(rc, "", "");
+    ctl.keysize = sizeof(uint64);
+    ctl.entrysize = sizeof(ParallelApplyKeyOwner);
+    ctl.hcxt = leader->context;
+    leader->keyOwners = hash_create("logical replication parallel apply keys", PARALLEL_APPLY_INIT_KEYS, &ctl,
+        HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+}
+
+/*
+ * Note that the current transaction touches key. If check is set, it depends
+ * on the last transaction that recorded the key; if record is set, later
+ * transactions touching the key depend on the current one.
+ */
+static void ParallelApplyAddKey(ParallelApplyLeader *leader, uint64 key, bool check, bool record)
+{
+    if (check) {
+        ParallelApplyKeyOwner *owner =
+            (ParallelApplyKeyOwner *)hash_search(leader->keyOwners, (void *)&key, HASH_FIND, NULL);
+        if (owner != NULL && owner->seq > leader->conflictSeqs[owner->worker])
+            leader->conflictSeqs[owner->worker] = owner->seq;
+    }
+
+    if (record) {
+        if (leader->nkeys >= leader->maxkeys) {
+            leader->maxkeys *= 2;
+            leader->keys = (uint64 *)repalloc(leader->keys, leader->maxkeys * sizeof(uint64));
+        }
+        leader->keys[leader->nkeys++] = key;
+    }
+}
+
+/*
+ * Hash the replica identity key of a remote tuple. Sets relLevel if the tuple
+ * can't be told apart from other tuples of the relation by its key.
+ */
+static uint32 ParallelApplyTupleKey(LogicalRepRelation *rel, LogicalRepTupleData *tuple, bool *relLevel)
+{
+    uint32 key = DatumGetUInt32(hash_uint32(rel->remoteid));
+    int attnum = -1;
+
+    /* Text forms of FULL identity tuples need not be equal for equal rows. */
+    if (rel->replident == REPLICA_IDENTITY_FULL || rel->replident == REPLICA_IDENTITY_NOTHING ||
+        bms_is_empty(rel->attkeys)) {
+        *relLevel = true;
+        return key;
+    }
+
+    while ((attnum = bms_next_member(rel->attkeys, attnum)) >= 0) {
+        uint32 colhash = 0;
+
+        if (attnum >= tuple->ncols || tuple->colstatus[attnum] == LOGICALREP_COLUMN_UNCHANGED) {
+            *relLevel = true;
+            return key;
+        }
+        if (tuple->colstatus[attnum] != LOGICALREP_COLUMN_NULL)
+            colhash = DatumGetUInt32(
+                hash_any((const unsigned char *)tuple->colvalues[attnum].data, tuple->colvalues[attnum].len));
+
+        key = ((key << 1) | (key >> 31)) ^ colhash;
+    }
+
+    return key;
+}
+
+/*
+ * Hash the values a remote tuple sets in the columns of a unique index. Returns
+ * false if the tuple can't be told to conflict on the index: a column is NULL,
+ * or its value was not sent. Conflicts we miss are caught by the retry of
+ * ParallelApplyWorkerApplyTxn().
+ */
+static bool ParallelApplyUniqueKey(LogicalRepRelation *rel, LogicalRepTupleData *tuple, Bitmapset *cols,
+    int indexno, uint32 *key)
+{
+    uint32 hash = DatumGetUInt32(hash_uint32(rel->remoteid)) ^ (uint32)indexno;
+    int attnum = -1;
+
+    while ((attnum = bms_next_member(cols, attnum)) >= 0) {
+        if (attnum >= tuple->ncols || tuple->colstatus[attnum] == LOGICALREP_COLUMN_NULL ||
+            tuple->colstatus[attnum] == LOGICALREP_COLUMN_UNCHANGED)
+            return false;
+
+        hash = ((hash << 1) | (hash >> 31)) ^
+               DatumGetUInt32(hash_any((const unsigned char *)tuple->colvalues[attnum].data,
+                   tuple->colvalues[attnum].len));
+    }
+
+    *key = hash;
+    return true;
+}
+
+/* Collect the dependency keys of an INSERT, UPDATE or DELETE message. */
+static void ParallelApplyAddChangeKeys(ParallelApplyLeader *leader, StringInfo s, char action)
+{
+    StringInfoData msg = *s;
+    LogicalRepTupleData oldtup = {NULL, NULL, 0};
+    LogicalRepTupleData newtup = {NULL, NULL, 0};
+    LogicalRepRelId relid = InvalidOid;
+    LogicalRepRelation *rel;
+    bool hasOld = false;
+    bool relLevel = false;
+    uint32 rowKeys[2];
+    int nrowKeys = 0;
+
+    (void)pq_getmsgbyte(&msg);
+    switch (action) {
+        case 'I':
+            relid = logicalrep_read_insert(&msg, &newtup);
+            break;
+        case 'U':
+            relid = logicalrep_read_update(&msg, &hasOld, &oldtup, &newtup);
+            break;
+        case 'D':
+            relid = logicalrep_read_delete(&msg, &oldtup);
+            hasOld = true;
+            break;
+        default:
+            Assert(false);
+            break;
+    }
+
+    rel = logicalrep_remoterel_lookup(relid);
+    if (rel == NULL)
+        relLevel = true;
+    if (!relLevel && action != 'D')
+        rowKeys[nrowKeys++] = ParallelApplyTupleKey(rel, &newtup, &relLevel);
+    if (!relLevel && hasOld)
+        rowKeys[nrowKeys++] = ParallelApplyTupleKey(rel, &oldtup, &relLevel);
+
+    ParallelApplyAddKey(leader, PARALLEL_APPLY_MAKE_KEY(PARALLEL_APPLY_KEY_REL_TOUCH, relid), relLevel, true);
+    if (relLevel) {
+        ParallelApplyAddKey(leader, PARALLEL_APPLY_MAKE_KEY(PARALLEL_APPLY_KEY_REL_EXCL, relid), false, true);
+        return;
+    }
+
+    ParallelApplyAddKey(leader, PARALLEL_APPLY_MAKE_KEY(PARALLEL_APPLY_KEY_REL_EXCL, relid), true, false);
+    for (int i = 0; i < nrowKeys; i++)
+        ParallelApplyAddKey(leader, PARALLEL_APPLY_MAKE_KEY(PARALLEL_APPLY_KEY_ROW, rowKeys[i]), true, true);
+
+    /* A new row value may take a unique value another transaction sets or had */
+    if (action != 'D') {
+        ListCell *lc = NULL;
+        int indexno = 0;
+
+        foreach (lc, logicalrep_rel_unique_keys(relid)) {
+            uint32 uniqueKey;
+
+            if (ParallelApplyUniqueKey(rel, &newtup, (Bitmapset *)lfirst(lc), indexno++, &uniqueKey))
+                ParallelApplyAddKey(leader, PARALLEL_APPLY_MAKE_KEY(PARALLEL_APPLY_KEY_UNIQUE, uniqueKey), true,
+                    true);
+        }
+    }
+}
+
+static void ParallelApplyBeginTxn(ParallelApplyLeader *leader)
+{
+    resetStringInfo(&leader->txnBuf);
+    resetStringInfo(&leader->txnRel);
+    leader->nkeys = 0;
+    for (int i = 0; i < leader->shared->nworkers; i++)
+        leader->conflictSeqs[i] = 0;
+    leader->inTxn = true;
+    leader->hasChanges = false;
+    leader->localApply = false;
+}
+
+/*
+ * Done with the current remote transaction, which went to worker target or
+ * to nobody if target is -1. Every other worker still has to see the
+ * RELATION messages it carried.
+ */
+static void ParallelApplyEndTxn(ParallelApplyLeader *leader, int target)
+{
+    for (int i = 0; i < leader->shared->nworkers; i++) {
+        if (i != target && leader->txnRel.len > 0)
+            appendBinaryStringInfo(leader->pendingRel[i], leader->txnRel.data, leader->txnRel.len);
+    }
+
+    /* Don't keep the memory of a huge transaction around. */
+    if (leader->txnBuf.maxlen > PARALLEL_APPLY_MAX_TXN_SIZE) {
+        MemoryContext oldctx = MemoryContextSwitchTo(leader->context);
+        pfree(leader->txnBuf.data);
+        initStringInfo(&leader->txnBuf);
+        MemoryContextSwitchTo(oldctx);
+    }
+    resetStringInfo(&leader->txnBuf);
+    resetStringInfo(&leader->txnRel);
+    leader->inTxn = false;
+    leader->hasChanges = false;
+    leader->localApply = false;
+}
+
+/*
+ * The current transaction is too large to buffer, wait for the workers and
+ * apply it ourselves. The rest of it is applied as it arrives.
+ */
+static void ParallelApplySwitchToLocal(ParallelApplyLeader *leader)
+{
+    ereport(DEBUG1, (errmsg("logical replication parallel apply leader applies large remote transaction itself")));
+
+    ParallelApplyWaitCommitted(leader, leader->lastSeq);
+
+    leader->localApply = true;
+    leader->replaying = true;
+    ParallelApplyReplay(leader->txnBuf.data, leader->txnBuf.len);
+    leader->replaying = false;
+}
+
+static int ParallelApplyShortestQueue(ParallelApplyShared *shared)
+{
+    int target = 0;
+    uint64 minLen = PG_UINT64_MAX;
+
+    for (int i = 0; i < shared->nworkers; i++) {
+        ParallelApplyWorkerSlot *slot = &shared->slots[i];
+        uint64 len;
+
+        SpinLockAcquire(&slot->mutex);
+        len = slot->tail - slot->head;
+        SpinLockRelease(&slot->mutex);
+        if (len < minLen) {
+            minLen = len;
+            target = i;
+        }
+    }
+
+    return target;
+}
+
+/* Hand the buffered transaction to a parallel apply worker. */
+static void ParallelApplyDispatchTxn(ParallelApplyLeader *leader)
+{
+    ParallelApplyShared *shared = leader->shared;
+    uint64 committed = ParallelApplyCommittedSeq(shared);
+    uint64 targetSeq = 0;
+    uint64 waitSeq = 0;
+    int target = -1;
+    ParallelApplyWorkerSlot *slot;
+    ParallelApplyTxn *txn;
+    StringInfo pending;
+    errno_t rc;
+
+    /*
+     * Queue behind the latest transaction we depend on, the worker applies its
+     * queue in order. The worker waits for dependencies on other workers to
+     * commit, they all come earlier in commit order so this can't deadlock.
+     */
+    for (int i = 0; i < shared->nworkers; i++) {
+        if (leader->conflictSeqs[i] > committed && leader->conflictSeqs[i] > targetSeq) {
+            targetSeq = leader->conflictSeqs[i];
+            target = i;
+        }
+    }
+    for (int i = 0; i < shared->nworkers; i++) {
+        if (i != target && leader->conflictSeqs[i] > committed && leader->conflictSeqs[i] > waitSeq)
+            waitSeq = leader->conflictSeqs[i];
+    }
+    if (target < 0)
+        target = ParallelApplyShortestQueue(shared);
+
+    slot = &shared->slots[target];
+    pending = leader->pendingRel[target];
+    txn = (ParallelApplyTxn *)MemoryContextAlloc(shared->context,
+        offsetof(ParallelApplyTxn, data) + pending->len + leader->txnBuf.len);
+    txn->seq = ++leader->lastSeq;
+    txn->waitSeq = waitSeq;
+    txn->len = pending->len + leader->txnBuf.len;
+    if (pending->len > 0) {
+        rc = memcpy_s(txn->data, txn->len, pending->data, pending->len);
+        securec_check(rc, "", "");
+    }
+    rc = memcpy_s(txn->data + pending->len, txn->len - pending->len, leader->txnBuf.data, leader->txnBuf.len);
+    securec_check(rc, "", "");
+    resetStringInfo(pending);
+
+    for (;;) {
+        bool queued = false;
+
+        SpinLockAcquire(&slot->mutex);
+        if (slot->tail - slot->head < PARALLEL_APPLY_QUEUE_SIZE) {
+            slot->queue[slot->tail % PARALLEL_APPLY_QUEUE_SIZE] = txn;
+            slot->tail++;
+            queued = true;
+        }
+        SpinLockRelease(&slot->mutex);
+
+        if (queued)
+            break;
+        ParallelApplyLeaderWait(leader);
+    }
+    ParallelApplyWakeup(shared);
+
+    for (int i = 0; i < leader->nkeys; i++) {
+        ParallelApplyKeyOwner *owner =
+            (ParallelApplyKeyOwner *)hash_search(leader->keyOwners, (void *)&leader->keys[i], HASH_ENTER, NULL);
+        owner->seq = txn->seq;
+        owner->worker = target;
+    }
+
+    ParallelApplyEndTxn(leader, target);
+
+    /* Entries of committed transactions are useless, start over once there are too many. */
+    if (hash_get_num_entries(leader->keyOwners) > PARALLEL_APPLY_MAX_KEYS) {
+        ParallelApplyWaitCommitted(leader, leader->lastSeq);
+        ParallelApplyResetKeys(leader);
+    }
+}
+
+bool ParallelApplyActive(void)
+{
+    ParallelApplyLeader *leader = t_thrd.applyworker_cxt.parallelLeader;
+
+    return leader != NULL && leader->shared != NULL;
+}
+
+/* Are there transactions handed to the workers but not committed yet? */
+bool ParallelApplyInFlight(void)
+{
+    ParallelApplyLeader *leader = t_thrd.applyworker_cxt.parallelLeader;
+
+    if (leader == NULL || leader->shared == NULL)
+        return false;
+
+    return ParallelApplyCommittedSeq(leader->shared) < leader->lastSeq;
+}
+
+/* Wait until the workers committed every transaction handed to them. */
+void ParallelApplyWaitAll(void)
+{
+    ParallelApplyLeader *leader = t_thrd.applyworker_cxt.parallelLeader;
+
+    ParallelApplyWaitCommitted(leader, leader->lastSeq);
+}
+
+/* Has max_parallel_apply_workers_per_subscription changed since the leader started? */
+bool ParallelApplyConfigChanged(void)
+{
+    ParallelApplyLeader *leader = t_thrd.applyworker_cxt.parallelLeader;
+
+    return leader != NULL &&
+           leader->configured != u_sess->attr.attr_storage.max_parallel_apply_workers_per_subscription;
+}
+
+/*
+ * Called by apply_dispatch() of the leader for every protocol message.
+ * Returns false if the leader should apply the message itself.
+ */
+bool ParallelApplyLeaderDispatch(StringInfo s)
+{
+    ParallelApplyLeader *leader = t_thrd.applyworker_cxt.parallelLeader;
+    char action;
+    const char *msg = s->data + s->cursor;
+    int len = s->len - s->cursor;
+
+    if (leader->replaying || len <= 0)
+        return false;
+
+    action = msg[0];
+    switch (action) {
+        /* BEGIN */
+        case 'B':
+            ParallelApplyBeginTxn(leader);
+            ParallelApplyAppendMessage(&leader->txnBuf, msg, len);
+            return false;
+        /* RELATION, the leader needs it as well to compute the keys */
+        case 'R':
+            if (!leader->inTxn) {
+                for (int i = 0; i < leader->shared->nworkers; i++)
+                    ParallelApplyAppendMessage(leader->pendingRel[i], msg, len);
+                return false;
+            }
+            ParallelApplyAppendMessage(&leader->txnRel, msg, len);
+            if (!leader->localApply)
+                ParallelApplyAppendMessage(&leader->txnBuf, msg, len);
+            return false;
+        /* TYPE, ORIGIN */
+        case 'Y':
+        case 'O':
+            if (leader->inTxn && !leader->localApply)
+                ParallelApplyAppendMessage(&leader->txnBuf, msg, len);
+            return false;
+        /* INSERT, UPDATE, DELETE */
+        case 'I':
+        case 'U':
+        case 'D':
+            if (!leader->inTxn || leader->localApply)
+                return false;
+            ParallelApplyAddChangeKeys(leader, s, action);
+            ParallelApplyAppendMessage(&leader->txnBuf, msg, len);
+            leader->hasChanges = true;
+            if (leader->txnBuf.len > PARALLEL_APPLY_MAX_TXN_SIZE)
+                ParallelApplySwitchToLocal(leader);
+            return true;
+        /* COMMIT */
+        case 'C': {
+            StringInfoData commit = *s;
+            LogicalRepCommitData commit_data;
+
+            if (!leader->inTxn)
+                return false;
+
+            /* Applied or skipped by ourselves, let apply_handle_commit() finish it. */
+            if (leader->localApply || !leader->hasChanges) {
+                ParallelApplyEndTxn(leader, -1);
+                ParallelApplySyncBarrier(leader);
+                return false;
+            }
+
+            (void)pq_getmsgbyte(&commit);
+            logicalrep_read_commit(&commit, &commit_data);
+
+            ParallelApplyAppendMessage(&leader->txnBuf, msg, len);
+            ParallelApplyDispatchTxn(leader);
+            t_thrd.applyworker_cxt.inRemoteTransaction = false;
+
+            /* Process any tables that are being synchronized in parallel. */
+            ParallelApplySyncBarrier(leader);
+            process_syncing_tables(commit_data.end_lsn);
+
+            pgstat_report_activity(STATE_IDLE, NULL);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+/*
+ * Report the progress of the workers to the flush position tracking of the
+ * leader, and make sure they are all still alive.
+ */
+void ParallelApplyLeaderProgress(void)
+{
+    ParallelApplyLeader *leader = t_thrd.applyworker_cxt.parallelLeader;
+    ParallelApplyShared *shared = leader->shared;
+    XLogRecPtr remoteEnd;
+    XLogRecPtr localEnd;
+
+    SpinLockAcquire(&shared->mutex);
+    remoteEnd = shared->committedRemoteEnd;
+    localEnd = shared->committedLocalEnd;
+    SpinLockRelease(&shared->mutex);
+
+    if (remoteEnd > leader->lastStoredEnd) {
+        store_flush_position(remoteEnd, localEnd);
+        leader->lastStoredEnd = remoteEnd;
+    }
+
+    if (ParallelApplyCountWorkers(shared) < shared->nworkers)
+        ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+            errmsg("logical replication parallel apply worker for subscription \"%s\" exited unexpectedly",
+                t_thrd.applyworker_cxt.mySubscription->name)));
+}
+
+static void ParallelApplyLeaderOnExit(int code, Datum arg)
+{
+    ParallelApplyStop(t_thrd.applyworker_cxt.parallelLeader);
+}
+
+/*
+ * Stop the parallel apply workers and wait for them to go away. Transactions
+ * they did not commit are streamed again from the origin progress.
+ */
+static void ParallelApplyStop(ParallelApplyLeader *leader)
+{
+    ParallelApplyShared *shared = leader->shared;
+
+    if (shared == NULL)
+        return;
+
+    shared->shutdown = true;
+
+    LWLockAcquire(LogicalRepWorkerLock, LW_SHARED);
+    for (int i = 0; i < g_instance.attr.attr_storage.max_logical_replication_workers; i++) {
+        LogicalRepWorker *w = &t_thrd.applylauncher_cxt.applyLauncherShm->workers[i];
+
+        if (w->parallelShared == shared && w->proc != NULL)
+            (void)gs_signal_send(w->proc->pid, SIGTERM);
+    }
+    LWLockRelease(LogicalRepWorkerLock);
+
+    while (ParallelApplyCountWorkers(shared) > 0)
+        pg_usleep(PARALLEL_APPLY_NAPTIME * USECS_PER_MSEC);
+
+    leader->shared = NULL;
+    leader->keyOwners = NULL;
+    MemoryContextDelete(shared->context);
+    MemoryContextReset(leader->context);
+}
+
+/*
+ * Start the parallel apply workers of this apply worker, if configured. Falls
+ * back to serial apply if none of them could be started.
+ */
+void ParallelApplyStart(RepOriginId originid)
+{
+    ParallelApplyLeader *leader = t_thrd.applyworker_cxt.parallelLeader;
+    LogicalRepWorker *myWorker = t_thrd.applyworker_cxt.curWorker;
+    Subscription *sub = t_thrd.applyworker_cxt.mySubscription;
+    int nworkers = u_sess->attr.attr_storage.max_parallel_apply_workers_per_subscription;
+    ParallelApplyShared *shared;
+    MemoryContext sharedContext;
+    MemoryContext oldctx;
+    int started;
+
+    if (leader == NULL) {
+        leader = (ParallelApplyLeader *)MemoryContextAllocZero(TopMemoryContext, sizeof(ParallelApplyLeader));
+        leader->context =
+            AllocSetContextCreate(TopMemoryContext, "ParallelApplyLeaderContext", ALLOCSET_DEFAULT_SIZES);
+        t_thrd.applyworker_cxt.parallelLeader = leader;
+        on_shmem_exit(ParallelApplyLeaderOnExit, (Datum)0);
+    }
+
+    ParallelApplyStop(leader);
+    leader->configured = nworkers;
+    if (nworkers == 0)
+        return;
+
+    sharedContext = AllocSetContextCreate(g_instance.instance_context, "ParallelApplySharedContext",
+        ALLOCSET_DEFAULT_MINSIZE, ALLOCSET_DEFAULT_INITSIZE, ALLOCSET_DEFAULT_MAXSIZE, SHARED_CONTEXT);
+    shared = (ParallelApplyShared *)MemoryContextAllocZero(sharedContext,
+        offsetof(ParallelApplyShared, slots) + nworkers * sizeof(ParallelApplyWorkerSlot));
+    shared->context = sharedContext;
+    shared->leaderProc = t_thrd.proc;
+    shared->leaderPid = t_thrd.proc_cxt.MyProcPid;
+    shared->originId = originid;
+    SpinLockInit(&shared->mutex);
+    for (int i = 0; i < nworkers; i++)
+        SpinLockInit(&shared->slots[i].mutex);
+    shared->nworkers = nworkers;
+
+    for (started = 0; started < nworkers; started++) {
+        logicalrep_worker_launch(myWorker->dbid, sub->oid, sub->name, myWorker->userid, InvalidOid, started, shared);
+        if (ParallelApplyCountWorkers(shared) <= started)
+            break;
+    }
+
+    if (started == 0) {
+        ereport(LOG, (errmsg("could not start parallel apply workers for subscription \"%s\", applying serially",
+            sub->name)));
+        MemoryContextDelete(sharedContext);
+        return;
+    }
+    shared->nworkers = started;
+
+    oldctx = MemoryContextSwitchTo(leader->context);
+    leader->pendingRel = (StringInfo *)palloc(started * sizeof(StringInfo));
+    for (int i = 0; i < started; i++)
+        leader->pendingRel[i] = makeStringInfo();
+    leader->conflictSeqs = (uint64 *)palloc0(started * sizeof(uint64));
+    leader->maxkeys = PARALLEL_APPLY_INIT_KEYS;
+    leader->keys = (uint64 *)palloc(leader->maxkeys * sizeof(uint64));
+    leader->nkeys = 0;
+    initStringInfo(&leader->txnBuf);
+    initStringInfo(&leader->txnRel);
+    MemoryContextSwitchTo(oldctx);
+
+    leader->lastSeq = 0;
+    leader->lastStoredEnd = InvalidXLogRecPtr;
+    leader->inTxn = false;
+    leader->hasChanges = false;
+    leader->localApply = false;
+    leader->replaying = false;
+    leader->shared = shared;
+    ParallelApplyResetKeys(leader);
+
+    ereport(LOG, (errmsg("logical replication apply worker for subscription \"%s\" applies with %d parallel workers",
+        sub->name, started)));
+}
+
+/* Publish the local xid of the transaction being applied, see ParallelApplyWaitForTurn(). */
+void ParallelApplyAssignXid(void)
+{
+    ParallelApplyWorkerSlot *slot = MyParallelApplySlot();
+    TransactionId xid = GetCurrentTransactionId();
+
+    SpinLockAcquire(&slot->mutex);
+    slot->curXid = xid;
+    SpinLockRelease(&slot->mutex);
+}
+
+static TransactionId ParallelApplyTurnHolderXid(ParallelApplyShared *shared, uint64 seq)
+{
+    TransactionId xid = InvalidTransactionId;
+    bool found = false;
+
+    for (int i = 0; i < shared->nworkers && !found; i++) {
+        ParallelApplyWorkerSlot *slot = &shared->slots[i];
+
+        SpinLockAcquire(&slot->mutex);
+        if (slot->curSeq == seq) {
+            xid = slot->curXid;
+            found = true;
+        }
+        SpinLockRelease(&slot->mutex);
+    }
+
+    return xid;
+}
+
+/*
+ * Wait until all transactions before seq committed.
+ *
+ * The worker whose turn it is never waits here, so waiting on its transaction
+ * lock makes any lock it waits for on us visible to the deadlock detector.
+ * If an earlier transaction is retried, give up our locks so it can't block
+ * on us again.
+ */
+static void ParallelApplyWaitForTurn(ParallelApplyShared *shared, uint64 seq, bool holdingTxn)
+{
+    for (;;) {
+        uint64 retrySeq;
+        uint64 committed = ParallelApplyCommittedSeq(shared, &retrySeq);
+        TransactionId holderXid = InvalidTransactionId;
+
+        if (committed + 1 >= seq)
+            return;
+
+        if (shared->shutdown)
+            proc_exit(0);
+
+        if (holdingTxn) {
+            if (retrySeq != 0 && retrySeq < seq)
+                ereport(ERROR, (errcode(ERRCODE_T_R_SERIALIZATION_FAILURE),
+                    errmsg("canceling apply of remote transaction to let an earlier transaction be retried")));
+            holderXid = ParallelApplyTurnHolderXid(shared, committed + 1);
+        }
+
+        if (TransactionIdIsValid(holderXid)) {
+            XactLockTableWait(holderXid);
+            CHECK_FOR_INTERRUPTS();
+        } else {
+            ParallelApplyWaitLatch();
+        }
+    }
+}
+
+/* Commit the remote transaction applied by a parallel apply worker, in commit order. */
+void ParallelApplyWorkerCommit(LogicalRepCommitData *commit_data)
+{
+    ParallelApplyShared *shared = MyParallelApplyShared();
+    ParallelApplyWorkerSlot *slot = MyParallelApplySlot();
+    uint64 seq = slot->curSeq;
+    bool committed = false;
+
+    ParallelApplyWaitForTurn(shared, seq, IsTransactionState());
+
+    if (IsTransactionState()) {
+        /*
+         * Update origin state so we can restart streaming from correct
+         * position in case of crash.
+         */
+        u_sess->reporigin_cxt.originTs = commit_data->committime;
+        u_sess->reporigin_cxt.originLsn = commit_data->end_lsn;
+
+        CommitTransactionCommand();
+        committed = true;
+    }
+
+    SpinLockAcquire(&shared->mutex);
+    shared->committedSeq = seq;
+    if (committed) {
+        shared->committedRemoteEnd = commit_data->end_lsn;
+        shared->committedLocalEnd = t_thrd.xlog_cxt.XactLastCommitEnd;
+    }
+    if (shared->retrySeq == seq)
+        shared->retrySeq = 0;
+    SpinLockRelease(&shared->mutex);
+
+    SpinLockAcquire(&slot->mutex);
+    slot->curXid = InvalidTransactionId;
+    SpinLockRelease(&slot->mutex);
+
+    ParallelApplyWakeup(shared);
+
+    if (committed)
+        pgstat_report_stat(false);
+}
+
+/*
+ * Apply one transaction. An error before our turn may be caused by a
+ * transaction we did not know we depend on, so retry it once everything
+ * before it committed; deadlock victims are retried as well.
+ */
+static void ParallelApplyWorkerApplyTxn(ParallelApplyShared *shared, ParallelApplyWorkerSlot *slot,
+    ParallelApplyTxn *txn)
+{
+    /* Transactions of other workers we depend on, see ParallelApplyDispatchTxn() */
+    while (ParallelApplyCommittedSeq(shared) < txn->waitSeq) {
+        if (shared->shutdown)
+            proc_exit(0);
+        ParallelApplyWaitLatch();
+    }
+
+    SpinLockAcquire(&slot->mutex);
+    slot->curSeq = txn->seq;
+    SpinLockRelease(&slot->mutex);
+
+    for (;;) {
+        volatile bool failed = false;
+        bool speculative = ParallelApplyCommittedSeq(shared) + 1 < txn->seq;
+
+        PG_TRY();
+        {
+            ParallelApplyReplay(txn->data, txn->len);
+        }
+        PG_CATCH();
+        {
+            if (!speculative && geterrcode() != ERRCODE_T_R_DEADLOCK_DETECTED)
+                PG_RE_THROW();
+
+            HOLD_INTERRUPTS();
+            EmitErrorReport();
+            FlushErrorState();
+            AbortOutOfAnyTransaction();
+            RESUME_INTERRUPTS();
+
+            MemoryContextSwitchTo(t_thrd.applyworker_cxt.applyContext);
+            MemoryContextReset(t_thrd.applyworker_cxt.messageContext);
+            logicalrep_relmap_reset_open();
+            t_thrd.applyworker_cxt.inRemoteTransaction = false;
+            failed = true;
+        }
+        PG_END_TRY();
+
+        if (!failed)
+            break;
+
+        SpinLockAcquire(&slot->mutex);
+        slot->curXid = InvalidTransactionId;
+        SpinLockRelease(&slot->mutex);
+
+        SpinLockAcquire(&shared->mutex);
+        if (shared->retrySeq == 0 || txn->seq < shared->retrySeq)
+            shared->retrySeq = txn->seq;
+        SpinLockRelease(&shared->mutex);
+
+        ereport(LOG, (errmsg("logical replication parallel apply worker for subscription \"%s\" will retry "
+                             "remote transaction once the transactions before it are applied",
+            t_thrd.applyworker_cxt.mySubscription->name)));
+
+        ParallelApplyWaitForTurn(shared, txn->seq, false);
+    }
+}
+
+/* Main loop of a parallel apply worker, started by ParallelApplyStart(). */
+void ParallelApplyWorkerMain(void)
+{
+    ParallelApplyShared *shared = MyParallelApplyShared();
+    ParallelApplyWorkerSlot *slot = MyParallelApplySlot();
+
+    /* Commit on behalf of the leader's replication origin. */
+    replorigin_session_setup(shared->originId, shared->leaderPid);
+    u_sess->reporigin_cxt.originId = shared->originId;
+
+    t_thrd.applyworker_cxt.messageContext = AllocSetContextCreate(t_thrd.applyworker_cxt.applyContext,
+        "ApplyMessageContext", ALLOCSET_DEFAULT_SIZES);
+
+    SpinLockAcquire(&slot->mutex);
+    slot->proc = t_thrd.proc;
+    SpinLockRelease(&slot->mutex);
+
+    pgstat_report_activity(STATE_IDLE, NULL);
+
+    while (!shared->shutdown) {
+        ParallelApplyTxn *txn = NULL;
+
+        SpinLockAcquire(&slot->mutex);
+        if (slot->head != slot->tail)
+            txn = slot->queue[slot->head % PARALLEL_APPLY_QUEUE_SIZE];
+        SpinLockRelease(&slot->mutex);
+
+        if (txn == NULL) {
+            if (t_thrd.applyworker_cxt.got_SIGHUP) {
+                t_thrd.applyworker_cxt.got_SIGHUP = false;
+                ProcessConfigFile(PGC_SIGHUP);
+            }
+            ParallelApplyWaitLatch();
+            continue;
+        }
+
+        ParallelApplyWorkerApplyTxn(shared, slot, txn);
+
+        SpinLockAcquire(&slot->mutex);
+        slot->head++;
+        slot->curSeq = 0;
+        SpinLockRelease(&slot->mutex);
+
+        pfree(txn);
+        SetLatch(&shared->leaderProc->procLatch);
+    }
+}
@@ -29,6 +29,7 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 
+#include "access/hash.h"
 #include "access/heapam.h"
 #include "access/transam.h"
 #include "access/xact.h"
@@ -45,6 +46,7 @@
 #include "utils/builtins.h"
 
 #include "utils/acl.h"
+#include "utils/inval.h"
 #include "utils/memutils.h"
 #include "utils/relfilenodemap.h"
 #include "utils/atomic.h"
@@ -607,6 +609,276 @@ void parallel_decode_change_to_bin(Relation relation, ParallelReorderBufferChang
     MemoryContextReset(data->context);
 }
 
+/* a relation as decode style 'c' describes it, cached per decode worker until its relcache entry is invalidated */
+typedef struct ColumnarMetaEntry {
+    Oid relid;
+    bool valid;
+    char *schema;
+    char *table;
+    uint16 ncols;
+    uint32 metaHash;
+    StringInfoData meta; /* relation and column descriptions, as sent */
+    FmgrInfo *sendFuncs; /* send function of each column, fn_oid invalid if the value is copied */
+} ColumnarMetaEntry;
+
+#define COLUMNAR_META_CACHE_SIZE 128
+
+static void ColumnarMetaCacheInvalidate(Datum arg, Oid relid)
+{
+    HTAB *cache = t_thrd.parallel_decode_cxt.columnarMetaCache;
+    if (cache == NULL) {
+        return;
+    }
+    if (OidIsValid(relid)) {
+        ColumnarMetaEntry *entry = (ColumnarMetaEntry *)hash_search(cache, &relid, HASH_FIND, NULL);
+        if (entry != NULL) {
+            entry->valid = false;
+        }
+        return;
+    }
+
+    HASH_SEQ_STATUS status;
+    ColumnarMetaEntry *entry = NULL;
+    hash_seq_init(&status, cache);
+    while ((entry = (ColumnarMetaEntry *)hash_seq_search(&status)) != NULL) {
+        entry->valid = false;
+    }
+}
+
+static void ColumnarMetaCacheInit(MemoryContext parent)
+{
+    HASHCTL ctl;
+    errno_t rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+    securec_check(rc, "", "");
+    ctl.keysize = sizeof(Oid);
+    ctl.entrysize = sizeof(ColumnarMetaEntry);
+    ctl.hcxt = AllocSetContextCreate(parent, "columnar decode meta cache", ALLOCSET_DEFAULT_SIZES);
+    t_thrd.parallel_decode_cxt.columnarMetaCxt = ctl.hcxt;
+    t_thrd.parallel_decode_cxt.columnarMetaCache = hash_create("columnar decode meta cache",
+        COLUMNAR_META_CACHE_SIZE, &ctl, HASH_ELEM | HASH_CONTEXT | HASH_BLOBS);
+    CacheRegisterThreadRelcacheCallback(ColumnarMetaCacheInvalidate, (Datum)0);
+}
+
+/*
+ * Describe the relation and its columns, used as the header of a column block.
+ * By-value columns are sent with their length, the values of the others vary
+ * in length: fixed-length types by reference go through their send function,
+ * which gives a representation independent of the byte order of the host.
+ */
+static void ColumnarMetaBuild(ColumnarMetaEntry *entry, Relation relation, MemoryContext cacheCxt)
+{
+    TupleDesc tupdesc = RelationGetDescr(relation);
+    MemoryContext old = MemoryContextSwitchTo(cacheCxt);
+
+    if (entry->meta.data != NULL) {
+        pfree(entry->schema);
+        pfree(entry->table);
+        pfree(entry->meta.data);
+        pfree(entry->sendFuncs);
+    }
+    entry->schema = get_namespace_name(RelationGetForm(relation)->relnamespace);
+    entry->table = pstrdup(NameStr(RelationGetForm(relation)->relname));
+    entry->sendFuncs = (FmgrInfo *)palloc0(sizeof(FmgrInfo) * Max(tupdesc->natts, 1));
+    initStringInfo(&entry->meta);
+
+    StringInfo s = &entry->meta;
+    AppendRelation(s, tupdesc, entry->schema, entry->table);
+    int curPos = s->len;
+    uint16 ncols = 0;
+    pq_sendint16(s, ncols);
+    for (int natt = 0; natt < tupdesc->natts; natt++) {
+        Form_pg_attribute attr = tupdesc->attrs[natt];
+        if (attr->attisdropped || attr->attnum < 0) {
+            continue;
+        }
+        int16 typlen = attr->attbyval ? attr->attlen : -1;
+        if (!attr->attbyval && attr->attlen > 0) {
+            Oid typsend = InvalidOid;
+            bool typisvarlena = false;
+            getTypeBinaryOutputInfo(attr->atttypid, &typsend, &typisvarlena);
+            fmgr_info_cxt(typsend, &entry->sendFuncs[ncols], cacheCxt);
+        }
+        ncols++;
+        const char *columnName = quote_identifier(NameStr(attr->attname));
+        pq_sendint16(s, (uint16)strlen(columnName));
+        appendStringInfoString(s, columnName);
+        pq_sendint32(s, attr->atttypid);
+        pq_sendint16(s, (uint16)typlen);
+    }
+    uint16 netCols = htons(ncols);
+    errno_t rc = memcpy_s(s->data + curPos, sizeof(uint16), &netCols, sizeof(uint16));
+    securec_check(rc, "", "");
+
+    entry->ncols = ncols;
+    entry->metaHash = DatumGetUInt32(hash_any((const unsigned char *)s->data, s->len));
+    entry->valid = true;
+    MemoryContextSwitchTo(old);
+}
+
+static ColumnarMetaEntry *ColumnarMetaLookup(Relation relation, ParallelLogicalDecodingContext *ctx)
+{
+    if (t_thrd.parallel_decode_cxt.columnarMetaCache == NULL) {
+        ColumnarMetaCacheInit(ctx->context);
+    }
+    HTAB *cache = t_thrd.parallel_decode_cxt.columnarMetaCache;
+    Oid relid = RelationGetRelid(relation);
+    bool found = false;
+    ColumnarMetaEntry *entry = (ColumnarMetaEntry *)hash_search(cache, &relid, HASH_ENTER, &found);
+    if (!found) {
+        entry->valid = false;
+        entry->meta.data = NULL;
+    }
+    if (!entry->valid) {
+        ColumnarMetaBuild(entry, relation, t_thrd.parallel_decode_cxt.columnarMetaCxt);
+    }
+    return entry;
+}
+
+static inline void AppendColumnarLength(StringInfo s, int32 len)
+{
+    appendBinaryStringInfo(s, (const char *)&len, sizeof(int32));
+}
+
+/*
+ * Append a column value in a binary representation, so that no output
+ * function has to be called: by-value types in network byte order, other
+ * fixed-length types as their send function gives them, varlena types as
+ * their detoasted payload and cstrings without the terminator.
+ */
+static void AppendColumnarValue(StringInfo s, Form_pg_attribute attr, FmgrInfo *sendFunc, Datum value, bool isnull)
+{
+    if (isnull) {
+        AppendColumnarLength(s, COLUMNAR_VALUE_NULL);
+        return;
+    }
+
+    if (attr->attbyval) {
+        AppendColumnarLength(s, attr->attlen);
+        switch (attr->attlen) {
+            case sizeof(char):
+                appendStringInfoChar(s, DatumGetChar(value));
+                break;
+            case sizeof(int16):
+                pq_sendint16(s, (uint16)DatumGetInt16(value));
+                break;
+            case sizeof(int32):
+                pq_sendint32(s, (uint32)DatumGetInt32(value));
+                break;
+            default:
+                pq_sendint64(s, (uint64)DatumGetInt64(value));
+                break;
+        }
+    } else if (attr->attlen > 0) {
+        bytea *val = SendFunctionCall(sendFunc, value);
+        int32 len = (int32)VARSIZE(val) - VARHDRSZ;
+        AppendColumnarLength(s, len);
+        appendBinaryStringInfo(s, VARDATA(val), len);
+    } else if (attr->attlen == -1) {
+        if (VARATT_IS_EXTERNAL_ONDISK_B(DatumGetPointer(value))) {
+            AppendColumnarLength(s, COLUMNAR_VALUE_UNCHANGED);
+            return;
+        }
+        struct varlena *val = PG_DETOAST_DATUM_PACKED(value);
+        int32 len = (int32)VARSIZE_ANY_EXHDR(val);
+        AppendColumnarLength(s, len);
+        appendBinaryStringInfo(s, VARDATA_ANY(val), len);
+    } else {
+        const char *str = DatumGetCString(value);
+        int32 len = (int32)strlen(str);
+        AppendColumnarLength(s, len);
+        appendBinaryStringInfo(s, str, len);
+    }
+}
+
+/* decode a tuple into the intermediate columnar form, see ColumnarChangeHeader */
+static void AppendColumnarTuple(StringInfo s, TupleDesc tupdesc, ColumnarMetaEntry *entry, HeapTuple tuple)
+{
+    bool undecodable = (tuple->tupTableType == HEAP_TUPLE) && (HEAP_TUPLE_IS_COMPRESSED(tuple->t_data) ||
+        (int)HeapTupleHeaderGetNatts(tuple->t_data, tupdesc) > tupdesc->natts);
+    int col = 0;
+
+    for (int natt = 0; natt < tupdesc->natts; natt++) {
+        Form_pg_attribute attr = tupdesc->attrs[natt];
+        if (attr->attisdropped || attr->attnum < 0) {
+            continue;
+        }
+        Assert(col < entry->ncols);
+        FmgrInfo *sendFunc = &entry->sendFuncs[col++];
+        if (undecodable) {
+            AppendColumnarLength(s, COLUMNAR_VALUE_UNCHANGED);
+            continue;
+        }
+
+        bool isnull = false;
+        Datum origval = 0;
+        if (tuple->tupTableType == HEAP_TUPLE) {
+            origval = heap_getattr(tuple, natt + 1, tupdesc, &isnull);
+        } else {
+            origval = uheap_getattr((UHeapTuple)tuple, natt + 1, tupdesc, &isnull);
+        }
+        AppendColumnarValue(s, attr, sendFunc, origval, isnull);
+    }
+}
+
+/*
+ * parallel logical decoding callback with decode style: columnar binary.
+ * The change is only brought into an intermediate form here, the sender
+ * transposes the rows of one relation into column blocks.
+ */
+void parallel_decode_change_to_columnar(Relation relation, ParallelReorderBufferChange* change,
+    logicalLog *logChange, ParallelLogicalDecodingContext* ctx, int slotId)
+{
+    logChange->type = LOGICAL_LOG_DML;
+    logChange->lsn = change->lsn;
+    logChange->xid = change->xid;
+    ParallelDecodingData *data = (ParallelDecodingData *)ctx->output_plugin_private;
+    ColumnarMetaEntry *entry = ColumnarMetaLookup(relation, ctx);
+    MemoryContext old = MemoryContextSwitchTo(data->context);
+
+    if (FilterWhiteList(entry->schema, entry->table, slotId, old, data->context)) {
+        return;
+    }
+
+    ColumnarChangeHeader header;
+    switch (change->action) {
+        case PARALLEL_REORDER_BUFFER_CHANGE_INSERT:
+        case PARALLEL_REORDER_BUFFER_CHANGE_UINSERT:
+            header.action = 'I';
+            break;
+        case PARALLEL_REORDER_BUFFER_CHANGE_UPDATE:
+        case PARALLEL_REORDER_BUFFER_CHANGE_UUPDATE:
+            header.action = 'U';
+            break;
+        case PARALLEL_REORDER_BUFFER_CHANGE_DELETE:
+        case PARALLEL_REORDER_BUFFER_CHANGE_UDELETE:
+            header.action = 'D';
+            break;
+        default:
+            MemoryContextSwitchTo(old);
+            MemoryContextReset(data->context);
+            return;
+    }
+    header.relid = RelationGetRelid(relation);
+    header.hasNew = (header.action != 'D' && change->data.tp.newtuple != NULL);
+    header.hasOld = (header.action != 'I' && change->data.tp.oldtuple != NULL);
+    header.ncols = entry->ncols;
+    header.metaLen = (uint32)entry->meta.len;
+    header.metaHash = entry->metaHash;
+
+    TupleDesc tupdesc = RelationGetDescr(relation);
+    StringInfo out = logChange->out;
+    appendBinaryStringInfo(out, (const char *)&header, sizeof(ColumnarChangeHeader));
+    appendBinaryStringInfo(out, entry->meta.data, entry->meta.len);
+    if (header.hasNew) {
+        AppendColumnarTuple(out, tupdesc, entry, &change->data.tp.newtuple->tuple);
+    }
+    if (header.hasOld) {
+        AppendColumnarTuple(out, tupdesc, entry, &change->data.tp.oldtuple->tuple);
+    }
+    MemoryContextSwitchTo(old);
+    MemoryContextReset(data->context);
+}
+
 /*
  * Use caching to reduce frequent memory requests and releases.
  * Use worker->freegetlogicalloghead to store logchanges that should be free.
@@ -852,6 +1124,20 @@ void ParallelDecodeChange(ParallelReorderBufferChange* change, ParallelLogicalDe
             break;
         }
 
+        case PARALLEL_REORDER_BUFFER_ASSIGNMENT: {
+            /* hand the subxids over to the sender, which frees them */
+            logicalLog *logChange = GetLogicalLog(worker);
+            logChange->lsn = change->lsn;
+            logChange->xid = change->xid;
+            logChange->type = LOGICAL_LOG_ASSIGNMENT;
+            logChange->nsubxacts = change->nsubxacts;
+            logChange->subXids = change->subXids;
+            change->subXids = NULL;
+            change->nsubxacts = 0;
+            LogicalQueuePut(worker->LogicalLogQueue, logChange);
+            break;
+        }
+
         case PARALLEL_REORDER_BUFFER_CHANGE_RUNNING_XACT: {
             logicalLog *logChange = GetLogicalLog(worker);
             logChange->lsn = change->lsn;
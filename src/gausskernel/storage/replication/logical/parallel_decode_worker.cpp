@@ -836,21 +836,25 @@ bool ParseStringToWhiteList(char *tableString, List **tableWhiteList)
 }
 
 /*
- * Check decode_style, 't' for text and 'j' for json.
+ * Check decode_style, 't' for text, 'j' for json, 'b' for binary and 'c' for columnar binary.
  */
 static inline void CheckDecodeStyle(ParallelDecodeOption *data, DefElem* elem)
 {
     if (elem->arg != NULL) {
         data->decode_style = *strVal(elem->arg);
-        if (data->decode_style != 'j' && data->decode_style != 't' && data->decode_style != 'b') {
+        if (data->decode_style != 'j' && data->decode_style != 't' && data->decode_style != 'b' &&
+            data->decode_style != 'c') {
             ereport(ERROR, (errmodule(MOD_LOGICAL_DECODE), errcode(ERRCODE_INVALID_PARAMETER_VALUE),
                 errmsg("could not parse value \"%s\" for parameter \"%s\"", strVal(elem->arg), elem->defname),
-                errdetail("N/A"),  errcause("Wrong input value"), erraction("Input \'j\' or \'t\'")));
+                errdetail("N/A"),  errcause("Wrong input value"),
+                erraction("Input \'j\', \'t\', \'b\' or \'c\'")));
         }
         if (data->decode_style == 'j') {
             data->decode_change = parallel_decode_change_to_json;
         } else if (data->decode_style == 't') {
             data->decode_change = parallel_decode_change_to_text;
+        } else if (data->decode_style == 'c') {
+            data->decode_change = parallel_decode_change_to_columnar;
         } else {
             data->decode_change = parallel_decode_change_to_bin;
         }
@@ -935,6 +939,10 @@ static void ParseDecodingOption(ParallelDecodeOption *data, ListCell *option)
         CheckDecodeStyle(data, elem);
     } else if (strncmp(elem->defname, "white-table-list", sizeof("white-table-list")) == 0) {
         ParseWhiteList(&data->tableWhiteList, elem);
+    } else if (strncmp(elem->defname, "streaming", sizeof("streaming")) == 0) {
+        CheckBooleanOption(elem, &data->streaming, false);
+    } else if (strncmp(elem->defname, "columnar-compression", sizeof("columnar-compression")) == 0) {
+        CheckBooleanOption(elem, &data->columnar_compression, false);
     } else if (strncmp(elem->defname, "parallel-decode-num", sizeof("parallel-decode-num")) != 0) {
         ereport(ERROR, (errmodule(MOD_LOGICAL_DECODE), errcode(ERRCODE_INVALID_PARAMETER_VALUE),
             errmsg("option \"%s\" = \"%s\" is unknown", elem->defname, elem->arg ? strVal(elem->arg) : "(null)"),
@@ -979,6 +987,8 @@ int StartLogicalLogWorkers(char* dbUser, char* dbName, char* slotname, List *opt
         pOptions->decode_style = 'b';
         pOptions->parallel_decode_num = parallelDecodeNum;
         pOptions->sending_batch = 0;
+        pOptions->streaming = false;
+        pOptions->columnar_compression = false;
         pOptions->decode_change = parallel_decode_change_to_text;
         ParseDecodingOptions(&g_Logicaldispatcher[slotId].pOptions, options);
         errno_t rc = memcpy_s(g_Logicaldispatcher[slotId].slotName, NAMEDATALEN, slotname, strlen(slotname));
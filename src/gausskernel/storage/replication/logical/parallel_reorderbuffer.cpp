@@ -64,6 +64,7 @@
 #include "utils/relcache.h"
 
 #include "utils/relfilenodemap.h"
+#include "lz4.h"
 
 static void ParallelReorderBufferSerializeReserve(ParallelReorderBuffer *rb, Size sz);
 static void ParallelReorderBufferCheckSerializeTXN(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn,
@@ -75,6 +76,9 @@ static Size ParallelReorderBufferRestoreChanges(ParallelReorderBuffer *rb, Paral
     XLogSegNo *segno, int slotId);
 static void ParallelReorderBufferRestoreChange(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn, char *data,
     int slotId);
+static bool ParallelReorderBufferCanStreamTXN(ParallelReorderBufferTXN *txn, int slotId);
+static void ParallelReorderBufferStreamTXN(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn, int slotId);
+static void ParallelReorderBufferStreamAbort(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn, int slotId);
 
 
 /* Parallel decoding batch sending unit length is set to 1MB. */
@@ -91,10 +95,40 @@ void ParallelReorderBufferQueueChange(ParallelReorderBuffer *rb, logicalLog *cha
     dlist_push_tail(&txn->changes, &change->node);
     txn->nentries++;
     txn->nentries_mem++;
+    if (change->type == LOGICAL_LOG_NEW_CID) {
+        txn->has_catalog_changes = true;
+    }
 
     ParallelReorderBufferCheckSerializeTXN(rb, txn, slotId);
 }
 
+/*
+ * Link the subtransactions of an assignment record to their toplevel
+ * transaction before their first change, see ParallelReorderBufferCanStreamTXN().
+ */
+void ParallelReorderBufferAssignChild(ParallelReorderBuffer *rb, logicalLog *change, int slotId)
+{
+    ParallelReorderBufferTXN *txn = ParallelReorderBufferTXNByXid(rb, change->xid, true, NULL, change->lsn, true);
+
+    for (int i = 0; i < change->nsubxacts; i++) {
+        bool newSub = false;
+        ParallelReorderBufferTXN *subtxn =
+            ParallelReorderBufferTXNByXid(rb, change->subXids[i], true, &newSub, change->lsn, false);
+
+        if (subtxn->is_known_as_subxact) {
+            continue;
+        }
+        /* it was assumed to be a toplevel transaction so far */
+        if (!newSub) {
+            dlist_delete(&subtxn->node);
+        }
+        subtxn->is_known_as_subxact = true;
+        subtxn->toplevel_xid = txn->xid;
+        dlist_push_tail(&txn->subtxns, &subtxn->node);
+        txn->nsubtxns++;
+    }
+}
+
 void ParallelFreeTuple(ReorderBufferTupleBuf *tuple, int slotId)
 {
     uint32 curTupleNum = g_Logicaldispatcher[slotId].curTupleNum;
@@ -748,11 +782,32 @@ static void ParallelReorderBufferSerializeReserve(ParallelReorderBuffer *rb, Siz
 static void ParallelReorderBufferCheckSerializeTXN(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn, int slotId)
 {
     if (txn->nentries_mem >= (unsigned)g_instance.attr.attr_common.max_changes_in_memory) {
-        ParallelReorderBufferSerializeTXN(rb, txn, slotId);
+        if (ParallelReorderBufferCanStreamTXN(txn, slotId)) {
+            ParallelReorderBufferStreamTXN(rb, txn, slotId);
+        } else {
+            ParallelReorderBufferSerializeTXN(rb, txn, slotId);
+        }
         Assert(txn->nentries_mem == 0);
     }
 }
 
+/*
+ * Can the in-memory changes of the transaction be streamed to the client
+ * instead of being spilled to disk? The same rules as in serial decoding
+ * apply, see ReorderBufferCanStreamTXN().
+ */
+static bool ParallelReorderBufferCanStreamTXN(ParallelReorderBufferTXN *txn, int slotId)
+{
+    if (!g_Logicaldispatcher[slotId].pOptions.streaming || txn->is_known_as_subxact || txn->nsubtxns > 0 ||
+        txn->has_catalog_changes || txn->serialized || dlist_is_empty(&txn->changes)) {
+        return false;
+    }
+
+    /* a transaction still running at this point commits after the start point, so it won't be forgotten */
+    logicalLog *last = dlist_tail_element(logicalLog, node, &txn->changes);
+    return !XLByteLT(last->lsn, g_Logicaldispatcher[slotId].startpoint);
+}
+
 /*
  * Spill data of a large transaction (and its subtransactions) to disk.
  */
@@ -1278,6 +1333,10 @@ void ParallelReorderBufferForget(ParallelReorderBuffer *rb, int slotId, Parallel
         dlist_delete(&logChange->node);
         FreeLogicalLog(logChange, slotId);
     }
+    /* the client has to throw away what it got streamed already */
+    if (txn->streamed) {
+        ParallelReorderBufferStreamAbort(rb, txn, slotId);
+    }
     ParallelReorderBufferCleanupTXN(rb, txn);
     ParallelReorderBufferIterTXNFinish(iterstate, slotId);
 }
@@ -1285,11 +1344,11 @@ void ParallelReorderBufferForget(ParallelReorderBuffer *rb, int slotId, Parallel
 /*
  * Parallel decoding check whether this batch should prepare write.
  */
-static void ParallelCheckPrepare(StringInfo out, logicalLog *change, ParallelDecodingData *pdata, int slotId,
-    MemoryContext *oldCtxPtr)
+static void ParallelCheckPrepare(StringInfo out, XLogRecPtr lsn, TransactionId xid, ParallelDecodingData *pdata,
+    int slotId, MemoryContext *oldCtxPtr)
 {
     if (!g_Logicaldispatcher[slotId].remainPatch) {
-        WalSndPrepareWriteHelper(out, change->lsn, change->xid, true);
+        WalSndPrepareWriteHelper(out, lsn, xid, true);
     }
     *oldCtxPtr = MemoryContextSwitchTo(pdata->context);
 }
@@ -1305,7 +1364,7 @@ static void ParallelCheckBatch(ParallelLogicalDecodingContext *ctx, ParallelDeco
         return;
     }
     if (ctx->out->len > g_Logicaldispatcher[slotId].pOptions.sending_batch * g_batch_unit_length) {
-        if (pdata->pOptions.decode_style == 'b') {
+        if (DecodeStyleIsBinary(pdata->pOptions.decode_style)) {
             appendStringInfoChar(ctx->out, 'F'); // the finishing char
         } else if (g_Logicaldispatcher[slotId].pOptions.sending_batch > 0) {
             pq_sendint32(ctx->out, 0);
@@ -1326,7 +1385,7 @@ static void ParallelCheckBatch(ParallelLogicalDecodingContext *ctx, ParallelDeco
         g_Logicaldispatcher[slotId].decodeTime = GetCurrentTimestamp();
         g_Logicaldispatcher[slotId].remainPatch = false;
     } else {
-        if (pdata->pOptions.decode_style == 'b') {
+        if (DecodeStyleIsBinary(pdata->pOptions.decode_style)) {
             appendStringInfoChar(ctx->out, 'P');
         }
         g_Logicaldispatcher[slotId].remainPatch = true;
@@ -1337,11 +1396,297 @@ static void ParallelCheckBatch(ParallelLogicalDecodingContext *ctx, ParallelDeco
 /*
  * Parallel decoding deal with batch sending.
  */
-static inline void ParallelHandleBatch(ParallelLogicalDecodingContext *ctx, logicalLog *change,
+static inline void ParallelHandleBatch(ParallelLogicalDecodingContext *ctx, XLogRecPtr lsn, TransactionId xid,
     ParallelDecodingData *pdata, int slotId, MemoryContext *oldCtxPtr)
 {
     ParallelCheckBatch(ctx, pdata, slotId, oldCtxPtr, false);
-    ParallelCheckPrepare(ctx->out, change, pdata, slotId, oldCtxPtr);
+    ParallelCheckPrepare(ctx->out, lsn, xid, pdata, slotId, oldCtxPtr);
+}
+
+/*
+ * Rows of decode style 'c' waiting to be sent as one column block. A block
+ * holds consecutive changes of the same action on the same relation, see
+ * ParallelColumnarFlush() for its format.
+ */
+typedef struct ParallelColumnarBlock {
+    Oid relid;
+    char action;
+    uint16 ncols;
+    int16 *typlens;    /* length of the values of each column, -1 if it varies */
+    uint32 metaHash;   /* identifies the descriptions, see ColumnarChangeHeader */
+    StringInfo meta;   /* relation and column description, as sent */
+    StringInfo rows;   /* tuples of the rows in intermediate form */
+    int nrows;
+    uint32 *newOffs;   /* offset of the new tuple of each row in rows */
+    uint32 *oldOffs;   /* offset of the old tuple of each row in rows */
+    XLogRecPtr lsn;    /* lsn of the last row */
+    StringInfo payload;
+} ParallelColumnarBlock;
+
+#define COLUMNAR_BLOCK_MAX_ROWS 4096
+#define COLUMNAR_BLOCK_MAX_BYTES (1024 * 1024)
+#define COLUMNAR_NO_TUPLE PG_UINT32_MAX
+#define COLUMNAR_MIN_COMPRESS_LEN 128
+#define COLUMNAR_FLAG_NULLS 0x01
+#define COLUMNAR_FLAG_UNCHANGED 0x02
+
+static inline int32 ColumnarReadLength(const char *data, uint32 pos)
+{
+    int32 len;
+    errno_t rc = memcpy_s(&len, sizeof(int32), data + pos, sizeof(int32));
+    securec_check(rc, "", "");
+    return len;
+}
+
+/* skip one tuple in intermediate form, returning the offset behind it */
+static uint32 ColumnarSkipTuple(const char *data, uint32 pos, uint16 ncols)
+{
+    for (uint16 col = 0; col < ncols; col++) {
+        int32 len = ColumnarReadLength(data, pos);
+        pos += sizeof(int32) + (len > 0 ? len : 0);
+    }
+    return pos;
+}
+
+/* pick up the value length of each column from the column descriptions */
+static void ColumnarParseTyplens(ParallelColumnarBlock *block)
+{
+    const char *data = block->meta->data;
+    uint32 pos = 0;
+    for (int i = 0; i < 2; i++) { /* schema and table */
+        uint16 len;
+        errno_t rc = memcpy_s(&len, sizeof(uint16), data + pos, sizeof(uint16));
+        securec_check(rc, "", "");
+        pos += sizeof(uint16) + ntohs(len);
+    }
+    pos += sizeof(uint16); /* column count */
+    for (uint16 col = 0; col < block->ncols; col++) {
+        uint16 nameLen;
+        uint16 typlen;
+        errno_t rc = memcpy_s(&nameLen, sizeof(uint16), data + pos, sizeof(uint16));
+        securec_check(rc, "", "");
+        pos += sizeof(uint16) + ntohs(nameLen) + sizeof(uint32);
+        rc = memcpy_s(&typlen, sizeof(uint16), data + pos, sizeof(uint16));
+        securec_check(rc, "", "");
+        pos += sizeof(uint16);
+        block->typlens[col] = (int16)ntohs(typlen);
+    }
+}
+
+static inline void ColumnarSetBit(bits8 *bitmap, int i)
+{
+    bitmap[i / BITS_PER_BYTE] |= (bits8)(1 << (i % BITS_PER_BYTE));
+}
+
+/*
+ * Append one tuple section of a column block: the rows having that tuple,
+ * then column by column a flag byte, the null and unchanged bitmaps if
+ * flagged, the lengths of the values if the column is not fixed-length and
+ * at last the values themselves.
+ */
+static void ColumnarAppendSection(StringInfo out, ParallelColumnarBlock *block, char kind, const uint32 *offs)
+{
+    int nrows = block->nrows;
+    int bitmapLen = (nrows + BITS_PER_BYTE - 1) / BITS_PER_BYTE;
+    uint32 *cursors = (uint32 *)palloc(sizeof(uint32) * nrows);
+    bits8 *present = (bits8 *)palloc0(bitmapLen);
+    bits8 *nulls = (bits8 *)palloc(bitmapLen);
+    bits8 *unchanged = (bits8 *)palloc(bitmapLen);
+    const char *data = block->rows->data;
+    int npresent = 0;
+
+    for (int row = 0; row < nrows; row++) {
+        if (offs[row] != COLUMNAR_NO_TUPLE) {
+            ColumnarSetBit(present, row);
+            cursors[npresent++] = offs[row];
+        }
+    }
+    appendStringInfoChar(out, kind);
+    appendBinaryStringInfo(out, (const char *)present, bitmapLen);
+
+    int presentLen = (npresent + BITS_PER_BYTE - 1) / BITS_PER_BYTE;
+    for (uint16 col = 0; col < block->ncols; col++) {
+        uint8 flags = 0;
+        errno_t rc = memset_s(nulls, bitmapLen, 0, bitmapLen);
+        securec_check(rc, "", "");
+        rc = memset_s(unchanged, bitmapLen, 0, bitmapLen);
+        securec_check(rc, "", "");
+        for (int i = 0; i < npresent; i++) {
+            int32 len = ColumnarReadLength(data, cursors[i]);
+            if (len == COLUMNAR_VALUE_NULL) {
+                ColumnarSetBit(nulls, i);
+                flags |= COLUMNAR_FLAG_NULLS;
+            } else if (len == COLUMNAR_VALUE_UNCHANGED) {
+                ColumnarSetBit(unchanged, i);
+                flags |= COLUMNAR_FLAG_UNCHANGED;
+            }
+        }
+        appendStringInfoChar(out, (char)flags);
+        if (flags & COLUMNAR_FLAG_NULLS) {
+            appendBinaryStringInfo(out, (const char *)nulls, presentLen);
+        }
+        if (flags & COLUMNAR_FLAG_UNCHANGED) {
+            appendBinaryStringInfo(out, (const char *)unchanged, presentLen);
+        }
+        if (block->typlens[col] <= 0) {
+            for (int i = 0; i < npresent; i++) {
+                int32 len = ColumnarReadLength(data, cursors[i]);
+                if (len >= 0) {
+                    pq_sendint32(out, (uint32)len);
+                }
+            }
+        }
+        for (int i = 0; i < npresent; i++) {
+            int32 len = ColumnarReadLength(data, cursors[i]);
+            cursors[i] += sizeof(int32);
+            if (len > 0) {
+                appendBinaryStringInfo(out, data + cursors[i], len);
+                cursors[i] += len;
+            }
+        }
+    }
+
+    pfree(cursors);
+    pfree(present);
+    pfree(nulls);
+    pfree(unchanged);
+}
+
+/*
+ * Send the pending rows as a column block. Like any other binary decoding
+ * result it starts with its length and lsn, followed by 'K', 'L' and the raw
+ * length if the block is LZ4 compressed or 'N' if it is not, and the block:
+ * the action, the row count, the relation and column descriptions and an 'N'
+ * section for the new and an 'O' section for the old tuples of the rows.
+ */
+static void ParallelColumnarFlush(ParallelLogicalDecodingContext *ctx, ParallelColumnarBlock *block,
+    TransactionId xid, ParallelDecodingData *pdata, int slotId, MemoryContext *oldCtxPtr)
+{
+    if (block->nrows == 0) {
+        return;
+    }
+
+    StringInfo payload = block->payload;
+    resetStringInfo(payload);
+    appendStringInfoChar(payload, block->action);
+    pq_sendint32(payload, (uint32)block->nrows);
+    appendBinaryStringInfo(payload, block->meta->data, block->meta->len);
+    if (block->action != 'D') {
+        ColumnarAppendSection(payload, block, 'N', block->newOffs);
+    }
+    if (block->action != 'I') {
+        ColumnarAppendSection(payload, block, 'O', block->oldOffs);
+    }
+
+    StringInfo out = ctx->out;
+    int curPos = out->len;
+    uint32 blockLen = 0;
+    bool compressed = false;
+    pq_sendint32(out, blockLen);
+    pq_sendint64(out, block->lsn);
+    appendStringInfoChar(out, 'K');
+    if (pdata->pOptions.columnar_compression && payload->len >= COLUMNAR_MIN_COMPRESS_LEN) {
+        const int headerLen = 1 + sizeof(uint32);
+        int bound = LZ4_compressBound(payload->len);
+        enlargeStringInfo(out, headerLen + bound);
+        int compressedLen = LZ4_compress_default(payload->data, out->data + out->len + headerLen,
+            payload->len, bound);
+        if (compressedLen > 0 && compressedLen < payload->len) {
+            uint32 rawLen = htonl((uint32)payload->len);
+            out->data[out->len] = 'L';
+            errno_t rc = memcpy_s(out->data + out->len + 1, sizeof(uint32), &rawLen, sizeof(uint32));
+            securec_check(rc, "", "");
+            out->len += headerLen + compressedLen;
+            out->data[out->len] = '\0';
+            compressed = true;
+        }
+    }
+    if (!compressed) {
+        appendStringInfoChar(out, 'N');
+        appendBinaryStringInfo(out, payload->data, payload->len);
+    }
+    blockLen = htonl((uint32)(out->len - curPos) - (uint32)sizeof(uint32));
+    errno_t rc = memcpy_s(out->data + curPos, sizeof(uint32), &blockLen, sizeof(uint32));
+    securec_check(rc, "", "");
+
+    block->nrows = 0;
+    resetStringInfo(block->rows);
+    ParallelHandleBatch(ctx, block->lsn, xid, pdata, slotId, oldCtxPtr);
+}
+
+/*
+ * Add a change decoded in columnar style to the pending block, sending the
+ * block first if the change doesn't fit into it. The descriptions are only
+ * copied when a block starts, the rows of a block are told apart from others
+ * by the hash the decode workers cached with them.
+ */
+static void ParallelColumnarAdd(ParallelLogicalDecodingContext *ctx, ParallelColumnarBlock *block,
+    logicalLog *change, TransactionId xid, ParallelDecodingData *pdata, int slotId, MemoryContext *oldCtxPtr)
+{
+    ColumnarChangeHeader header;
+    errno_t rc = memcpy_s(&header, sizeof(ColumnarChangeHeader), change->out->data, sizeof(ColumnarChangeHeader));
+    securec_check(rc, "", "");
+    const char *meta = change->out->data + sizeof(ColumnarChangeHeader);
+    const char *tuples = meta + header.metaLen;
+    uint32 tuplesLen = (uint32)change->out->len - sizeof(ColumnarChangeHeader) - header.metaLen;
+
+    if (block->nrows > 0 && (block->relid != header.relid || block->action != header.action ||
+        block->nrows >= COLUMNAR_BLOCK_MAX_ROWS || block->rows->len >= COLUMNAR_BLOCK_MAX_BYTES ||
+        block->metaHash != header.metaHash || (uint32)block->meta->len != header.metaLen)) {
+        ParallelColumnarFlush(ctx, block, xid, pdata, slotId, oldCtxPtr);
+    }
+
+    if (block->rows == NULL) {
+        block->meta = makeStringInfo();
+        block->rows = makeStringInfo();
+        block->payload = makeStringInfo();
+        block->newOffs = (uint32 *)palloc(sizeof(uint32) * COLUMNAR_BLOCK_MAX_ROWS);
+        block->oldOffs = (uint32 *)palloc(sizeof(uint32) * COLUMNAR_BLOCK_MAX_ROWS);
+    }
+    if (block->nrows == 0) {
+        block->relid = header.relid;
+        block->action = header.action;
+        block->ncols = header.ncols;
+        block->metaHash = header.metaHash;
+        resetStringInfo(block->meta);
+        appendBinaryStringInfo(block->meta, meta, header.metaLen);
+        if (block->typlens != NULL) {
+            pfree(block->typlens);
+        }
+        block->typlens = (int16 *)palloc(sizeof(int16) * Max(header.ncols, 1));
+        ColumnarParseTyplens(block);
+    }
+
+    uint32 base = (uint32)block->rows->len;
+    uint32 oldPos = 0;
+    block->newOffs[block->nrows] = COLUMNAR_NO_TUPLE;
+    block->oldOffs[block->nrows] = COLUMNAR_NO_TUPLE;
+    if (header.hasNew) {
+        block->newOffs[block->nrows] = base;
+        oldPos = ColumnarSkipTuple(tuples, 0, header.ncols);
+    }
+    if (header.hasOld) {
+        block->oldOffs[block->nrows] = base + oldPos;
+    }
+    appendBinaryStringInfo(block->rows, tuples, tuplesLen);
+    block->nrows++;
+    block->lsn = change->lsn;
+}
+
+/*
+ * Output one decoded change. Binary and text results are sent as they are,
+ * columnar ones are collected into column blocks.
+ */
+static inline void ParallelOutputChange(ParallelLogicalDecodingContext *ctx, ParallelColumnarBlock *block,
+    logicalLog *change, XLogRecPtr lsn, TransactionId xid, ParallelDecodingData *pdata, int slotId,
+    MemoryContext *oldCtxPtr)
+{
+    if (pdata->pOptions.decode_style == 'c') {
+        ParallelColumnarAdd(ctx, block, change, xid, pdata, slotId, oldCtxPtr);
+        return;
+    }
+    appendBinaryStringInfo(ctx->out, change->out->data, change->out->len);
+    ParallelHandleBatch(ctx, lsn, xid, pdata, slotId, oldCtxPtr);
 }
 
 /*
@@ -1350,7 +1695,7 @@ static inline void ParallelHandleBatch(ParallelLogicalDecodingContext *ctx, logi
 static void ParallelOutputBegin(StringInfo out, logicalLog *change, ParallelDecodingData *pdata,
     ParallelReorderBufferTXN *txn, bool batchSending)
 {
-    if (pdata->pOptions.decode_style == 'b') {
+    if (DecodeStyleIsBinary(pdata->pOptions.decode_style)) {
         int curPos = out->len;
         const uint32 beginBaseLen = 25; /* this length does not include the seperator 'P' */
         pq_sendint32(out, beginBaseLen);
@@ -1395,7 +1740,7 @@ static void ParallelOutputBegin(StringInfo out, logicalLog *change, ParallelDeco
 static void ParallelOutputCommit(StringInfo out, logicalLog *change, ParallelDecodingData *pdata,
     ParallelReorderBufferTXN *txn, bool batchSending)
 {
-    if (pdata->pOptions.decode_style == 'b') {
+    if (DecodeStyleIsBinary(pdata->pOptions.decode_style)) {
         int curPos = out->len;
         uint32 commitLen = 0;
         pq_sendint32(out, commitLen);
@@ -1441,6 +1786,137 @@ static void ParallelOutputCommit(StringInfo out, logicalLog *change, ParallelDec
     }
 }
 
+/*
+ * Parallel decoding output the messages framing a streamed transaction:
+ * 'S' stream start, 'E' stream stop, 'c' stream commit and 'A' stream abort.
+ * Streams of different transactions interleave, so they always carry the xid.
+ */
+static void ParallelOutputStream(StringInfo out, char action, XLogRecPtr lsn, ParallelDecodingData *pdata,
+    ParallelReorderBufferTXN *txn, bool firstSegment, bool batchSending)
+{
+    bool withTimestamp = (action == 'c' && pdata->pOptions.include_timestamp);
+
+    if (DecodeStyleIsBinary(pdata->pOptions.decode_style)) {
+        int curPos = out->len;
+        uint32 streamLen = 0;
+        pq_sendint32(out, streamLen);
+        pq_sendint64(out, lsn);
+        appendStringInfoChar(out, action);
+        pq_sendint64(out, txn->xid);
+        streamLen += sizeof(uint64) + 1 + sizeof(uint64);
+        if (action == 'S') {
+            appendStringInfoChar(out, firstSegment ? 1 : 0);
+            streamLen += 1;
+        }
+        if (withTimestamp) {
+            appendStringInfoChar(out, 'T');
+            const char *timeStamp = timestamptz_to_str(txn->commit_time);
+            pq_sendint32(out, (uint32)(strlen(timeStamp)));
+            appendStringInfoString(out, timeStamp);
+            streamLen += 1 + sizeof(uint32) + strlen(timeStamp);
+        }
+
+        streamLen = htonl(streamLen);
+        errno_t rc = memcpy_s(out->data + curPos, sizeof(uint32), &streamLen, sizeof(uint32));
+        securec_check(rc, "", "");
+    } else {
+        int curPos = out->len;
+        uint32 streamLen = 0;
+        if (batchSending) {
+            pq_sendint32(out, streamLen);
+            pq_sendint64(out, lsn);
+        }
+        switch (action) {
+            case 'S':
+                appendStringInfo(out, "STREAM START xid: %lu%s", txn->xid, firstSegment ? " first" : "");
+                break;
+            case 'E':
+                appendStringInfo(out, "STREAM STOP xid: %lu", txn->xid);
+                break;
+            case 'c':
+                appendStringInfo(out, "STREAM COMMIT xid: %lu", txn->xid);
+                break;
+            default:
+                appendStringInfo(out, "STREAM ABORT xid: %lu", txn->xid);
+                break;
+        }
+        if (withTimestamp) {
+            appendStringInfo(out, " (at %s)", timestamptz_to_str(txn->commit_time));
+        }
+        if (batchSending) {
+            streamLen = htonl((uint32)(out->len - curPos) - (uint32)sizeof(uint32));
+            errno_t rc = memcpy_s(out->data + curPos, sizeof(uint32), &streamLen, sizeof(uint32));
+            securec_check(rc, "", "");
+        }
+    }
+}
+
+/*
+ * Send the in-memory logical logs of a large in-progress transaction as one
+ * stream instead of spilling them to disk. The rest follows in later streams,
+ * the last one at commit.
+ */
+static void ParallelReorderBufferStreamTXN(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn, int slotId)
+{
+    ParallelLogicalDecodingContext *ctx = (ParallelLogicalDecodingContext *)rb->private_data;
+    ParallelDecodingData *pdata = (ParallelDecodingData *)t_thrd.walsender_cxt.
+        parallel_logical_decoding_ctx->output_plugin_private;
+    bool batchSending = g_Logicaldispatcher[slotId].pOptions.sending_batch > 0;
+    logicalLog *first = dlist_head_element(logicalLog, node, &txn->changes);
+    XLogRecPtr lsn = first->lsn;
+    MemoryContext oldCtx = NULL;
+    ParallelColumnarBlock block;
+    dlist_mutable_iter iter;
+
+    errno_t rc = memset_s(&block, sizeof(ParallelColumnarBlock), 0, sizeof(ParallelColumnarBlock));
+    securec_check(rc, "", "");
+    ParallelCheckPrepare(ctx->out, lsn, txn->xid, pdata, slotId, &oldCtx);
+    ParallelOutputStream(ctx->out, 'S', lsn, pdata, txn, !txn->streamed, batchSending);
+    ParallelHandleBatch(ctx, lsn, txn->xid, pdata, slotId, &oldCtx);
+
+    dlist_foreach_modify(iter, &txn->changes) {
+        logicalLog *logChange = dlist_container(logicalLog, node, iter.cur);
+
+        lsn = logChange->lsn;
+        if (logChange->out != NULL && logChange->out->len != 0) {
+            ParallelOutputChange(ctx, &block, logChange, lsn, txn->xid, pdata, slotId, &oldCtx);
+        }
+        dlist_delete(&logChange->node);
+        FreeLogicalLog(logChange, slotId);
+    }
+    ParallelColumnarFlush(ctx, &block, txn->xid, pdata, slotId, &oldCtx);
+
+    /*
+     * write_location is left alone, nothing of the transaction can be
+     * confirmed before its commit.
+     */
+    ParallelOutputStream(ctx->out, 'E', lsn, pdata, txn, false, batchSending);
+    ParallelCheckBatch(ctx, pdata, slotId, &oldCtx, false);
+    MemoryContextReset(pdata->context);
+
+    txn->nentries -= txn->nentries_mem;
+    txn->nentries_mem = 0;
+    txn->streamed = true;
+}
+
+/*
+ * Tell the client to throw away the streamed part of a transaction that is
+ * not going to be committed, or not sent.
+ */
+static void ParallelReorderBufferStreamAbort(ParallelReorderBuffer *rb, ParallelReorderBufferTXN *txn, int slotId)
+{
+    ParallelLogicalDecodingContext *ctx = (ParallelLogicalDecodingContext *)rb->private_data;
+    ParallelDecodingData *pdata = (ParallelDecodingData *)t_thrd.walsender_cxt.
+        parallel_logical_decoding_ctx->output_plugin_private;
+    MemoryContext oldCtx = NULL;
+
+    ParallelCheckPrepare(ctx->out, txn->final_lsn, txn->xid, pdata, slotId, &oldCtx);
+    ParallelOutputStream(ctx->out, 'A', txn->final_lsn, pdata, txn, false,
+        g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
+    ParallelCheckBatch(ctx, pdata, slotId, &oldCtx, false);
+    MemoryContextReset(pdata->context);
+}
+
 /*
  * Get and send all the logical logs in the ParallelReorderBufferTXN linked list.
  */
@@ -1460,11 +1936,21 @@ void ParallelReorderBufferCommit(ParallelReorderBuffer *rb, logicalLog *change,
     pdata->pOptions.xact_wrote_changes = false;
 
     MemoryContext oldCtx = NULL;
-    ParallelCheckPrepare(ctx->out, change, pdata, slotId, &oldCtx);
+    ParallelColumnarBlock block;
+    errno_t rc = memset_s(&block, sizeof(ParallelColumnarBlock), 0, sizeof(ParallelColumnarBlock));
+    securec_check(rc, "", "");
+    ParallelCheckPrepare(ctx->out, change->lsn, change->xid, pdata, slotId, &oldCtx);
 
-    if (!pdata->pOptions.skip_empty_xacts) {
+    /* the rest of a streamed transaction is sent as its last stream */
+    bool streamed = txn->streamed;
+    if (streamed) {
+        ParallelOutputStream(ctx->out, 'S', txn->first_lsn, pdata, txn, false,
+            g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
+        ParallelHandleBatch(ctx, change->lsn, change->xid, pdata, slotId, &oldCtx);
+        pdata->pOptions.xact_wrote_changes = true;
+    } else if (!pdata->pOptions.skip_empty_xacts) {
         ParallelOutputBegin(ctx->out, change, pdata, txn, g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
-        ParallelHandleBatch(ctx, change, pdata, slotId, &oldCtx);
+        ParallelHandleBatch(ctx, change->lsn, change->xid, pdata, slotId, &oldCtx);
     }
 
     ParallelReorderBufferIterTXNState *volatile iterstate = NULL;
@@ -1481,21 +1967,27 @@ void ParallelReorderBufferCommit(ParallelReorderBuffer *rb, logicalLog *change,
             if (pdata->pOptions.skip_empty_xacts && !pdata->pOptions.xact_wrote_changes) {
                 ParallelOutputBegin(ctx->out, change, pdata, txn,
                     g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
-                ParallelHandleBatch(ctx, change, pdata, slotId, &oldCtx);
+                ParallelHandleBatch(ctx, change->lsn, change->xid, pdata, slotId, &oldCtx);
                 pdata->pOptions.xact_wrote_changes = true;
             }
-            appendBinaryStringInfo(ctx->out, logChange->out->data, logChange->out->len);
-            ParallelHandleBatch(ctx, change, pdata, slotId, &oldCtx);
+            ParallelOutputChange(ctx, &block, logChange, change->lsn, change->xid, pdata, slotId, &oldCtx);
         }
         dlist_delete(&logChange->node);
 
         FreeLogicalLog(logChange, slotId);
     }
+    ParallelColumnarFlush(ctx, &block, change->xid, pdata, slotId, &oldCtx);
 
     if (XLByteLT(ctx->write_location, change->lsn)) {
         ctx->write_location = change->lsn;
     }
-    if (!pdata->pOptions.skip_empty_xacts || pdata->pOptions.xact_wrote_changes) {
+    if (streamed) {
+        ParallelOutputStream(ctx->out, 'E', change->lsn, pdata, txn, false,
+            g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
+        ParallelHandleBatch(ctx, change->lsn, change->xid, pdata, slotId, &oldCtx);
+        ParallelOutputStream(ctx->out, 'c', change->endLsn, pdata, txn, false,
+            g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
+    } else if (!pdata->pOptions.skip_empty_xacts || pdata->pOptions.xact_wrote_changes) {
         ParallelOutputCommit(ctx->out, change, pdata, txn,
             g_Logicaldispatcher[slotId].pOptions.sending_batch > 0);
     }
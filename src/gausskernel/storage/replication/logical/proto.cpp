@@ -629,3 +629,84 @@ void logicalrep_read_conninfo(StringInfo in, char** conninfo)
     int rc = strcpy_s(*conninfo, conninfoLen, conninfoTemp);
     securec_check(rc, "", "");
 }
+
+/*
+ * Write STREAM START to the output stream, the changes of the streamed
+ * transaction follow until STREAM STOP.
+ */
+void logicalrep_write_stream_start(StringInfo out, TransactionId xid, bool first_segment)
+{
+    pq_sendbyte(out, 's'); /* action STREAM START */
+
+    pq_sendint64(out, xid);
+    pq_sendbyte(out, first_segment ? 1 : 0);
+}
+
+/*
+ * Read STREAM START from the stream.
+ */
+TransactionId logicalrep_read_stream_start(StringInfo in, bool *first_segment)
+{
+    TransactionId xid = pq_getmsgint64(in);
+
+    *first_segment = (pq_getmsgbyte(in) == 1);
+    return xid;
+}
+
+/*
+ * Write STREAM STOP to the output stream.
+ */
+void logicalrep_write_stream_stop(StringInfo out)
+{
+    pq_sendbyte(out, 'E'); /* action STREAM STOP */
+}
+
+/*
+ * Write STREAM COMMIT to the output stream.
+ */
+void logicalrep_write_stream_commit(StringInfo out, ReorderBufferTXN *txn, XLogRecPtr commit_lsn)
+{
+    uint8 flags = 0;
+
+    pq_sendbyte(out, 'c'); /* action STREAM COMMIT */
+
+    pq_sendint64(out, txn->xid);
+
+    /* send the flags field (unused for now) */
+    pq_sendbyte(out, flags);
+
+    /* send fields */
+    pq_sendint64(out, commit_lsn);
+    pq_sendint64(out, txn->end_lsn);
+    pq_sendint64(out, txn->commit_time);
+}
+
+/*
+ * Read STREAM COMMIT from the stream.
+ */
+TransactionId logicalrep_read_stream_commit(StringInfo in, LogicalRepCommitData *commit_data)
+{
+    TransactionId xid = pq_getmsgint64(in);
+
+    /* the rest is the same as for COMMIT */
+    logicalrep_read_commit(in, commit_data);
+    return xid;
+}
+
+/*
+ * Write STREAM ABORT to the output stream.
+ */
+void logicalrep_write_stream_abort(StringInfo out, TransactionId xid)
+{
+    pq_sendbyte(out, 'A'); /* action STREAM ABORT */
+
+    pq_sendint64(out, xid);
+}
+
+/*
+ * Read STREAM ABORT from the stream.
+ */
+TransactionId logicalrep_read_stream_abort(StringInfo in)
+{
+    return pq_getmsgint64(in);
+}
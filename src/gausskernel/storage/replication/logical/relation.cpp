@@ -18,12 +18,15 @@
 #include "postgres.h"
 
 #include "access/sysattr.h"
+#include "access/genam.h"
 #include "access/heapam.h"
+#include "access/xact.h"
 #include "catalog/namespace.h"
 #include "nodes/makefuncs.h"
 #include "replication/logicalrelation.h"
 #include "replication/worker_internal.h"
 #include "utils/inval.h"
+#include "utils/relcache.h"
 #include "catalog/pg_subscription_rel.h"
 
 static const int DEFAULT_LOGICAL_RELMAP_HASH_ELEM = 128;
@@ -115,6 +118,48 @@ static void logicalrep_relmap_free_entry(LogicalRepRelMapEntry *entry)
 
     if (entry->attrmap)
         pfree(entry->attrmap);
+
+    if (entry->uniquekeys)
+        list_free_deep(entry->uniquekeys);
+}
+
+/*
+ * Collect the remote columns of each local unique index other than the
+ * replica identity, so changes that may conflict on them can be ordered.
+ * Indexes on expressions or on columns that are not replicated are skipped.
+ */
+static List *logicalrep_rel_build_unique_keys(LogicalRepRelMapEntry *entry)
+{
+    List *indexoids = RelationGetIndexList(entry->localrel);
+    List *uniquekeys = NIL;
+    ListCell *lc = NULL;
+
+    foreach (lc, indexoids) {
+        Relation index = index_open(lfirst_oid(lc), AccessShareLock);
+        Bitmapset *keys = NULL;
+        bool usable = index->rd_index->indisunique;
+
+        for (int i = 0; usable && i < IndexRelationGetNumberOfKeyAttributes(index); i++) {
+            AttrNumber attnum = index->rd_index->indkey.values[i];
+
+            if (!AttrNumberIsForUserDefinedAttr(attnum) || entry->attrmap[AttrNumberGetAttrOffset(attnum)] < 0) {
+                usable = false;
+                break;
+            }
+            keys = bms_add_member(keys, entry->attrmap[AttrNumberGetAttrOffset(attnum)]);
+        }
+        index_close(index, AccessShareLock);
+
+        if (usable && !bms_equal(keys, entry->remoterel.attkeys)) {
+            MemoryContext oldctx = MemoryContextSwitchTo(t_thrd.applyworker_cxt.logicalRepRelMapContext);
+            uniquekeys = lappend(uniquekeys, bms_copy(keys));
+            MemoryContextSwitchTo(oldctx);
+        }
+        bms_free(keys);
+    }
+    list_free(indexoids);
+
+    return uniquekeys;
 }
 
 /*
@@ -329,6 +374,10 @@ LogicalRepRelMapEntry *logicalrep_rel_open(LogicalRepRelId remoteid, LOCKMODE lo
             }
         }
 
+        if (entry->uniquekeys)
+            list_free_deep(entry->uniquekeys);
+        entry->uniquekeys = logicalrep_rel_build_unique_keys(entry);
+
         entry->localrelvalid = true;
     }
 
@@ -349,3 +398,70 @@ void logicalrep_rel_close(LogicalRepRelMapEntry *rel, LOCKMODE lockmode)
     rel->localrel = NULL;
 }
 
+/*
+ * Find the remote relation description for the remote relation id, without
+ * opening the local relation. Returns NULL if the publisher did not send it.
+ */
+LogicalRepRelation *logicalrep_remoterel_lookup(LogicalRepRelId remoteid)
+{
+    LogicalRepRelMapEntry *entry;
+
+    if (t_thrd.applyworker_cxt.logicalRepRelMap == NULL)
+        return NULL;
+
+    entry = (LogicalRepRelMapEntry *)hash_search(t_thrd.applyworker_cxt.logicalRepRelMap, (void *)&remoteid,
+                                                 HASH_FIND, NULL);
+
+    return entry ? &entry->remoterel : NULL;
+}
+
+/*
+ * Get the remote columns of the local unique indexes of a remote relation,
+ * see logicalrep_rel_build_unique_keys. If the cached information is stale,
+ * the local relation is opened, in a transaction of its own if we are not in one.
+ */
+List *logicalrep_rel_unique_keys(LogicalRepRelId remoteid)
+{
+    LogicalRepRelMapEntry *entry;
+
+    if (t_thrd.applyworker_cxt.logicalRepRelMap == NULL)
+        return NIL;
+
+    entry = (LogicalRepRelMapEntry *)hash_search(t_thrd.applyworker_cxt.logicalRepRelMap, (void *)&remoteid,
+                                                 HASH_FIND, NULL);
+    if (entry == NULL)
+        return NIL;
+
+    if (!entry->localrelvalid) {
+        MemoryContext oldctx = CurrentMemoryContext;
+        bool started = !IsTransactionState();
+
+        if (started)
+            StartTransactionCommand();
+        entry = logicalrep_rel_open(remoteid, AccessShareLock);
+        logicalrep_rel_close(entry, AccessShareLock);
+        if (started)
+            CommitTransactionCommand();
+        MemoryContextSwitchTo(oldctx);
+    }
+
+    return entry->uniquekeys;
+}
+
+/*
+ * Forget the local relations left open by an aborted transaction. The
+ * relcache references themselves are released by the transaction abort.
+ */
+void logicalrep_relmap_reset_open(void)
+{
+    HASH_SEQ_STATUS status;
+    LogicalRepRelMapEntry *entry;
+
+    if (t_thrd.applyworker_cxt.logicalRepRelMap == NULL)
+        return;
+
+    hash_seq_init(&status, t_thrd.applyworker_cxt.logicalRepRelMap);
+    while ((entry = (LogicalRepRelMapEntry *)hash_seq_search(&status)) != NULL)
+        entry->localrel = NULL;
+}
+
@@ -126,6 +126,8 @@ static void ReorderBufferExecuteInvalidations(ReorderBuffer *rb, ReorderBufferTX
  * ---------------------------------------
  */
 static void ReorderBufferCheckSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn);
+static bool ReorderBufferCanStreamTXN(ReorderBuffer *rb, ReorderBufferTXN *txn);
+static void ReorderBufferStreamTXN(ReorderBuffer *rb, ReorderBufferTXN *txn);
 static void ReorderBufferSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn);
 static void ReorderBufferSerializeChange(ReorderBuffer *rb, ReorderBufferTXN *txn, int fd, ReorderBufferChange *change);
 static Size ReorderBufferRestoreChanges(ReorderBuffer *rb, ReorderBufferTXN *txn, int *fd, XLogSegNo *segno);
@@ -184,6 +186,7 @@ ReorderBuffer *ReorderBufferAllocate(void)
     buffer->outbufsize = 0;
 
     buffer->current_restart_decoding_lsn = InvalidXLogRecPtr;
+    buffer->streaming = false;
 
     dlist_init(&buffer->toplevel_by_lsn);
     dlist_init(&buffer->txns_by_base_snapshot_lsn);
@@ -1066,6 +1069,17 @@ void ReorderBufferCleanupTXN(ReorderBuffer *rb, ReorderBufferTXN *txn, XLogRecPt
         dlist_delete(&txn->base_snapshot_node);
     }
 
+    /*
+     * A streamed transaction keeps the snapshot and the toast chunks it
+     * needs for the next stream, which might never come.
+     */
+    if (txn->snapshot_now != NULL) {
+        ReorderBufferFreeSnap(rb, txn->snapshot_now);
+        txn->snapshot_now = NULL;
+    }
+    if (txn->toast_hash != NULL)
+        ReorderBufferToastReset(rb, txn);
+
     /*
      * Remove TXN from its containing list.
      *
@@ -1277,7 +1291,13 @@ void ReorderBufferCommit(ReorderBuffer *rb, TransactionId xid, XLogRecPtr commit
         return;
     }
 
-    snapshot_now = txn->base_snapshot;
+    /* a streamed transaction continues with the snapshot its last stream ended with */
+    if (txn->snapshot_now != NULL) {
+        snapshot_now = txn->snapshot_now;
+        txn->snapshot_now = NULL;
+    } else {
+        snapshot_now = txn->base_snapshot;
+    }
 
     /* build data to be able to lookup the CommandIds of catalog tuples */
     ReorderBufferBuildTupleCidHash(rb, txn);
@@ -1307,7 +1327,11 @@ void ReorderBufferCommit(ReorderBuffer *rb, TransactionId xid, XLogRecPtr commit
             txn_started = true;
         }
 
-        rb->begin(rb, txn);
+        /* the rest of a streamed transaction is sent as its last stream */
+        if (txn->streamed)
+            rb->stream_start(rb, txn);
+        else
+            rb->begin(rb, txn);
 
         iterstate = ReorderBufferIterTXNInit(rb, txn);
         while ((change = ReorderBufferIterTXNNext(rb, iterstate))) {
@@ -1542,7 +1566,12 @@ void ReorderBufferCommit(ReorderBuffer *rb, TransactionId xid, XLogRecPtr commit
         iterstate = NULL;
 
         /* call commit callback */
-        rb->commit(rb, txn, commit_lsn);
+        if (txn->streamed) {
+            rb->stream_stop(rb, txn);
+            rb->stream_commit(rb, txn, commit_lsn);
+        } else {
+            rb->commit(rb, txn, commit_lsn);
+        }
 
         /* this is just a sanity check against bad output plugin behaviour */
         if (GetCurrentTransactionIdIfAny() != InvalidTransactionId)
@@ -1626,6 +1655,10 @@ void ReorderBufferAbort(ReorderBuffer *rb, TransactionId xid, XLogRecPtr lsn)
     /* cosmetic... */
     txn->final_lsn = lsn;
 
+    /* the receiver has to throw away what it got streamed already */
+    if (txn->streamed)
+        rb->stream_abort(rb, txn);
+
     /* remove potential on-disk data, and deallocate */
     ReorderBufferCleanupTXN(rb, txn);
 }
@@ -1657,6 +1690,9 @@ void ReorderBufferAbortOld(ReorderBuffer *rb, TransactionId oldestRunningXid, XL
             if (!RecoveryInProgress())
                 ereport(DEBUG2, (errmsg("aborting old transaction %lu", txn->xid)));
 
+            if (txn->streamed)
+                rb->stream_abort(rb, txn);
+
             /* remove potential on-disk data, and deallocate this tx */
             ReorderBufferCleanupTXN(rb, txn, lsn);
         } else
@@ -1712,6 +1748,10 @@ void ReorderBufferForget(ReorderBuffer *rb, TransactionId xid, XLogRecPtr lsn)
     } else
         Assert(txn->ninvalidations == 0);
 
+    /* the streamed changes of a skipped transaction must not be applied either */
+    if (txn->streamed)
+        rb->stream_abort(rb, txn);
+
     /* remove potential on-disk data, and deallocate */
     ReorderBufferCleanupTXN(rb, txn);
 }
@@ -1928,7 +1968,8 @@ static void ReorderBufferSerializeReserve(ReorderBuffer *rb, Size sz)
 }
 
 /*
- * Check whether the transaction tx should spill its data to disk.
+ * Check whether the transaction tx should spill its data to disk, or stream
+ * it to the output plugin if that's possible.
  */
 static void ReorderBufferCheckSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
 {
@@ -1937,11 +1978,194 @@ static void ReorderBufferCheckSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *
      * account here.
      */
     if (txn->nentries_mem >= (unsigned)g_instance.attr.attr_common.max_changes_in_memory) {
-        ReorderBufferSerializeTXN(rb, txn);
+        if (ReorderBufferCanStreamTXN(rb, txn))
+            ReorderBufferStreamTXN(rb, txn);
+        else
+            ReorderBufferSerializeTXN(rb, txn);
         Assert(txn->nentries_mem == 0);
     }
 }
 
+/*
+ * Can the in-memory changes of the transaction be streamed instead of being
+ * spilled to disk?
+ *
+ * Only toplevel transactions without subtransactions and catalog changes are
+ * streamed. Their changes never have to be merged with the ones of another
+ * transaction, and they can be decoded with the snapshots queued into the
+ * transaction itself. Subtransactions are assigned as soon as they get their
+ * xid while logical decoding is enabled, see AssignTransactionId().
+ */
+static bool ReorderBufferCanStreamTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
+{
+    LogicalDecodingContext *ctx = (LogicalDecodingContext *)rb->private_data;
+
+    if (!rb->streaming || txn->is_known_as_subxact || txn->nsubtxns > 0 || txn->has_catalog_changes ||
+        txn->serialized || txn->base_snapshot == NULL)
+        return false;
+
+    /* the commit of a transaction read before the start point is skipped, don't stream it either */
+    return !SnapBuildXactNeedsSkip(ctx->snapshot_builder, ctx->reader->EndRecPtr);
+}
+
+/*
+ * Pass one (user) change of a streamed transaction to the output plugin.
+ * Returns true if the change was moved into the transaction's toast hash and
+ * must not be freed yet.
+ */
+static bool ReorderBufferStreamChange(ReorderBuffer *rb, ReorderBufferTXN *txn, ReorderBufferChange *change)
+{
+    bool isUHeap = (change->action == REORDER_BUFFER_CHANGE_UINSERT ||
+                    change->action == REORDER_BUFFER_CHANGE_UUPDATE || change->action == REORDER_BUFFER_CHANGE_UDELETE);
+    RelFileNode *relnode = isUHeap ? &change->data.utp.relnode : &change->data.tp.relnode;
+    bool isSegment = isUHeap ? false : IsSegmentFileNode(*relnode);
+    bool clearToast = isUHeap ? change->data.utp.clear_toast_afterwards : change->data.tp.clear_toast_afterwards;
+    Oid partitionReltoastrelid = InvalidOid;
+    Relation relation = NULL;
+    Oid reloid;
+    bool kept = false;
+
+    u_sess->utils_cxt.HistoricSnapshot->snapshotcsn =
+        isUHeap ? change->data.utp.snapshotcsn : change->data.tp.snapshotcsn;
+
+    reloid = RelidByRelfilenode(relnode->spcNode, relnode->relNode, isSegment);
+    if (reloid == InvalidOid) {
+        reloid = PartitionRelidByRelfilenode(relnode->spcNode, relnode->relNode, partitionReltoastrelid, NULL,
+                                             isSegment);
+    }
+    if (reloid == InvalidOid) {
+        ereport(DEBUG1, (errmsg("could not lookup relation %s", relpathperm(*relnode, MAIN_FORKNUM))));
+        return false;
+    }
+
+    relation = RelationIdGetRelation(reloid);
+    if (relation == NULL) {
+        ereport(DEBUG1, (errmsg("could open relation descriptor %s", relpathperm(*relnode, MAIN_FORKNUM))));
+        return false;
+    }
+
+    if (is_role_independent(FindRoleid(reloid)) || CSTORE_NAMESPACE == get_rel_namespace(reloid) ||
+        !RelationIsLogicallyLogged(relation) || RELKIND_IS_SEQUENCE(relation->rd_rel->relkind)) {
+        RelationClose(relation);
+        return false;
+    }
+
+    if (!IsToastRelation(relation)) {
+        ReorderBufferToastReplace(rb, txn, relation, change, partitionReltoastrelid);
+        rb->apply_change(rb, txn, relation, change);
+        if (clearToast)
+            ReorderBufferToastReset(rb, txn);
+    } else if (change->action == REORDER_BUFFER_CHANGE_INSERT) {
+        /* the chunks stay in the toast hash until the toasted tuple is streamed */
+        dlist_delete(&change->node);
+        ReorderBufferToastAppendChunk(rb, txn, relation, change);
+        kept = true;
+    }
+    RelationClose(relation);
+    return kept;
+}
+
+/*
+ * Send the in-memory changes of a large in-progress transaction to the
+ * output plugin as one stream, instead of spilling them to disk. The rest of
+ * the transaction follows in later streams, the last one at commit.
+ */
+static void ReorderBufferStreamTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
+{
+    dlist_mutable_iter iter;
+    volatile Snapshot snapshot_now = txn->snapshot_now != NULL ? txn->snapshot_now : txn->base_snapshot;
+    volatile bool txn_started = false;
+    volatile bool subtxn_started = false;
+
+    u_sess->attr.attr_common.extra_float_digits = LOGICAL_DECODE_EXTRA_FLOAT_DIGITS;
+    txn->snapshot_now = NULL;
+
+    /* no catalog changes, so there are no tuplecids to look up */
+    SetupHistoricSnapshot(snapshot_now, NULL);
+
+    PG_TRY();
+    {
+        /* see ReorderBufferCommit() */
+        if (IsTransactionOrTransactionBlock()) {
+            BeginInternalSubTransaction("stream");
+            subtxn_started = true;
+        } else {
+            StartTransactionCommand();
+            txn_started = true;
+        }
+
+        rb->stream_start(rb, txn);
+
+        dlist_foreach_modify(iter, &txn->changes)
+        {
+            ReorderBufferChange *change = dlist_container(ReorderBufferChange, node, iter.cur);
+            bool kept = false;
+
+            switch (change->action) {
+                case REORDER_BUFFER_CHANGE_INSERT:
+                case REORDER_BUFFER_CHANGE_UPDATE:
+                case REORDER_BUFFER_CHANGE_DELETE:
+                case REORDER_BUFFER_CHANGE_UINSERT:
+                case REORDER_BUFFER_CHANGE_UUPDATE:
+                case REORDER_BUFFER_CHANGE_UDELETE:
+                    kept = ReorderBufferStreamChange(rb, txn, change);
+                    break;
+                case REORDER_BUFFER_CHANGE_INTERNAL_SNAPSHOT:
+                    /* the change is freed below, so always keep a copy */
+                    TeardownHistoricSnapshot(false);
+                    if (snapshot_now->copied)
+                        ReorderBufferFreeSnap(rb, snapshot_now);
+                    snapshot_now = ReorderBufferCopySnap(rb, change->data.snapshot, txn, FirstCommandId);
+                    SetupHistoricSnapshot(snapshot_now, NULL);
+                    break;
+                default:
+                    /* command ids only matter for catalog changes, which aren't streamed */
+                    break;
+            }
+
+            if (!kept) {
+                dlist_delete(&change->node);
+                ReorderBufferReturnChange(rb, change);
+            }
+        }
+
+        rb->stream_stop(rb, txn);
+
+        /* this is just a sanity check against bad output plugin behaviour */
+        if (GetCurrentTransactionIdIfAny() != InvalidTransactionId)
+            ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                            errmsg("output plugin used xid %lu", GetCurrentTransactionId())));
+
+        TeardownHistoricSnapshot(false);
+
+        if (subtxn_started)
+            RollbackAndReleaseCurrentSubTransaction();
+        else if (txn_started)
+            AbortCurrentTransaction();
+    }
+    PG_CATCH();
+    {
+        TeardownHistoricSnapshot(true);
+
+        if (snapshot_now != NULL && snapshot_now->copied)
+            ReorderBufferFreeSnap(rb, snapshot_now);
+
+        if (subtxn_started)
+            RollbackAndReleaseCurrentSubTransaction();
+        else if (txn_started)
+            AbortCurrentTransaction();
+
+        PG_RE_THROW();
+    }
+    PG_END_TRY();
+
+    /* the streamed changes are gone, only the later ones will be replayed at commit */
+    txn->snapshot_now = snapshot_now->copied ? snapshot_now : NULL;
+    txn->nentries -= txn->nentries_mem;
+    txn->nentries_mem = 0;
+    txn->streamed = true;
+}
+
 /*
  * Spill data of a large transaction (and its subtransactions) to disk.
  */
@@ -75,6 +75,7 @@
 #include "rewrite/rewriteHandler.h"
 
 #include "storage/buf/bufmgr.h"
+#include "storage/buf/buffile.h"
 #include "storage/ipc.h"
 #include "storage/lmgr.h"
 #include "storage/proc.h"
@@ -109,10 +110,8 @@ typedef struct SlotErrCallbackArg {
 } SlotErrCallbackArg;
 
 static void send_feedback(XLogRecPtr recvpos, bool force, bool requestReply);
-static void store_flush_position(XLogRecPtr remote_lsn);
 static void reread_subscription(void);
 static void ApplyWorkerProcessMsg(char type, StringInfo s, XLogRecPtr *lastRcv);
-static void apply_dispatch(StringInfo s);
 static void apply_handle_conninfo(StringInfo s);
 static void UpdateConninfo(char* standbysInfo);
 
@@ -166,6 +165,10 @@ static bool ensure_transaction(void)
     if (!t_thrd.applyworker_cxt.mySubscriptionValid)
         reread_subscription();
 
+    /* Let later transactions wait for us, see ParallelApplyWorkerCommit */
+    if (AM_PARALLEL_APPLY_WORKER)
+        ParallelApplyAssignXid();
+
     MemoryContextSwitchTo(t_thrd.applyworker_cxt.messageContext);
     return true;
 }
@@ -465,6 +468,8 @@ static void slot_modify_data(TupleTableSlot *slot, TupleTableSlot *srcslot, Logi
     ExecStoreVirtualTuple(slot);
 }
 
+static void apply_commit_local(LogicalRepCommitData *commit_data);
+
 /*
  * Handle BEGIN message.
  */
@@ -492,23 +497,39 @@ static void apply_handle_commit(StringInfo s)
 
     Assert(commit_data.commit_lsn == t_thrd.applyworker_cxt.remoteFinalLsn);
 
+    if (AM_PARALLEL_APPLY_WORKER) {
+        /* Commit in remote commit order, the leader handles table sync */
+        ParallelApplyWorkerCommit(&commit_data);
+        t_thrd.applyworker_cxt.inRemoteTransaction = false;
+        pgstat_report_activity(STATE_IDLE, NULL);
+        return;
+    }
+
+    apply_commit_local(&commit_data);
+}
+
+/*
+ * Commit the remote transaction applied by ourselves.
+ */
+static void apply_commit_local(LogicalRepCommitData *commit_data)
+{
     if (IsTransactionState()) {
         /*
          * Update origin state so we can restart streaming from correct
          * position in case of crash.
          */
-        u_sess->reporigin_cxt.originTs = commit_data.committime;
-        u_sess->reporigin_cxt.originLsn = commit_data.end_lsn;
+        u_sess->reporigin_cxt.originTs = commit_data->committime;
+        u_sess->reporigin_cxt.originLsn = commit_data->end_lsn;
 
         CommitTransactionCommand();
         pgstat_report_stat(false);
-        store_flush_position(commit_data.end_lsn);
+        store_flush_position(commit_data->end_lsn, t_thrd.xlog_cxt.XactLastCommitEnd);
     }
 
     t_thrd.applyworker_cxt.inRemoteTransaction = false;
 
     /* Process any tables that are being synchronized in parallel. */
-    process_syncing_tables(commit_data.end_lsn);
+    process_syncing_tables(commit_data->end_lsn);
 
     pgstat_report_activity(STATE_IDLE, NULL);
 }
@@ -888,12 +909,222 @@ static void apply_handle_delete(StringInfo s)
     CleanupEstate(estate, &epqstate, rel);
 }
 
+/*
+ * Streamed transactions
+ *
+ * The changes of a large transaction streamed by the publisher while it is
+ * still in progress are spooled to a temporary file per remote xid. They are
+ * applied when STREAM COMMIT arrives, and thrown away on STREAM ABORT.
+ */
+typedef struct ApplyStreamFileEnt {
+    TransactionId xid; /* hash key, must be first */
+    BufFile *file;
+} ApplyStreamFileEnt;
+
+/*
+ * Look up the spool file of a streamed transaction, a new one is created for
+ * its first stream. With remove set, the entry is taken out of the hash.
+ */
+static BufFile *apply_stream_file(TransactionId xid, bool create, bool remove)
+{
+    ApplyStreamFileEnt *ent = NULL;
+    bool found = false;
+
+    if (t_thrd.applyworker_cxt.streamFiles == NULL) {
+        HASHCTL ctl;
+        errno_t rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+        securec_check(rc, "", "");
+        ctl.keysize = sizeof(TransactionId);
+        ctl.entrysize = sizeof(ApplyStreamFileEnt);
+        ctl.hash = tag_hash;
+        ctl.hcxt = t_thrd.applyworker_cxt.applyContext;
+        t_thrd.applyworker_cxt.streamFiles =
+            hash_create("logical replication streamed transactions", 16, &ctl, HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+    }
+
+    if (create) {
+        MemoryContext oldctx;
+
+        ent = (ApplyStreamFileEnt *)hash_search(t_thrd.applyworker_cxt.streamFiles, &xid, HASH_ENTER, &found);
+        /* a transaction streamed again from its start, e.g. after the publisher restarted */
+        if (found)
+            BufFileClose(ent->file);
+        oldctx = MemoryContextSwitchTo(t_thrd.applyworker_cxt.applyContext);
+        /* the file has to outlive the local transactions applied in between streams */
+        ent->file = BufFileCreateTemp(true);
+        MemoryContextSwitchTo(oldctx);
+        return ent->file;
+    }
+
+    ent = (ApplyStreamFileEnt *)hash_search(t_thrd.applyworker_cxt.streamFiles, &xid, HASH_FIND, &found);
+    if (!found)
+        return NULL;
+    if (remove) {
+        BufFile *file = ent->file;
+        (void)hash_search(t_thrd.applyworker_cxt.streamFiles, &xid, HASH_REMOVE, NULL);
+        return file;
+    }
+    return ent->file;
+}
+
+/*
+ * Handle STREAM START message.
+ */
+static void apply_handle_stream_start(StringInfo s)
+{
+    bool first_segment = false;
+    TransactionId xid;
+
+    if (TransactionIdIsValid(t_thrd.applyworker_cxt.streamXid))
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION), errmsg("duplicate STREAM START message")));
+
+    xid = logicalrep_read_stream_start(s, &first_segment);
+    t_thrd.applyworker_cxt.streamFile = apply_stream_file(xid, first_segment, false);
+    if (t_thrd.applyworker_cxt.streamFile == NULL)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+            errmsg("STREAM START message for unknown streamed transaction %lu", xid)));
+    t_thrd.applyworker_cxt.streamXid = xid;
+
+    pgstat_report_activity(STATE_RUNNING, NULL);
+}
+
+/*
+ * Handle STREAM STOP message.
+ */
+static void apply_handle_stream_stop(StringInfo s)
+{
+    if (!TransactionIdIsValid(t_thrd.applyworker_cxt.streamXid))
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION), errmsg("STREAM STOP message without STREAM START")));
+
+    t_thrd.applyworker_cxt.streamXid = InvalidTransactionId;
+    t_thrd.applyworker_cxt.streamFile = NULL;
+
+    pgstat_report_activity(STATE_IDLE, NULL);
+}
+
+/*
+ * Handle STREAM ABORT message. A transaction we don't know about was streamed
+ * before we restarted, there is nothing to throw away then.
+ */
+static void apply_handle_stream_abort(StringInfo s)
+{
+    TransactionId xid = logicalrep_read_stream_abort(s);
+    BufFile *file = apply_stream_file(xid, false, true);
+
+    if (file != NULL)
+        BufFileClose(file);
+}
+
+/*
+ * Handle STREAM COMMIT message, apply the spooled changes and commit them
+ * like a regular remote transaction.
+ */
+static void apply_handle_stream_commit(StringInfo s)
+{
+    LogicalRepCommitData commit_data;
+    TransactionId xid = logicalrep_read_stream_commit(s, &commit_data);
+    BufFile *file = apply_stream_file(xid, false, true);
+    StringInfoData msg;
+    uint32 len;
+    size_t nread;
+
+    if (file == NULL)
+        ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+            errmsg("STREAM COMMIT message for unknown streamed transaction %lu", xid)));
+
+    /* transactions handed to parallel apply workers committed before this one */
+    if (ParallelApplyActive())
+        ParallelApplyWaitAll();
+
+    t_thrd.applyworker_cxt.inRemoteTransaction = true;
+    t_thrd.applyworker_cxt.remoteFinalLsn = commit_data.commit_lsn;
+    pgstat_report_activity(STATE_RUNNING, NULL);
+
+    if (BufFileSeek(file, 0, 0L, SEEK_SET) != 0)
+        ereport(ERROR, (errcode_for_file_access(), errmsg("could not rewind streamed transaction file")));
+
+    /* the messages are applied in messageContext, which is reset after each of them */
+    MemoryContext oldctx = MemoryContextSwitchTo(t_thrd.applyworker_cxt.applyContext);
+    initStringInfo(&msg);
+    MemoryContextSwitchTo(oldctx);
+
+    while ((nread = BufFileRead(file, &len, sizeof(len))) == sizeof(len)) {
+        StringInfoData change;
+
+        resetStringInfo(&msg);
+        enlargeStringInfo(&msg, (int)len);
+        if (BufFileRead(file, msg.data, len) != len)
+            ereport(ERROR, (errcode_for_file_access(), errmsg("could not read from streamed transaction file")));
+
+        change.data = msg.data;
+        change.len = (int)len;
+        change.cursor = 0;
+        change.maxlen = -1;
+
+        MemoryContextSwitchTo(t_thrd.applyworker_cxt.messageContext);
+        apply_dispatch(&change);
+        MemoryContextReset(t_thrd.applyworker_cxt.messageContext);
+    }
+    if (nread != 0)
+        ereport(ERROR, (errcode_for_file_access(), errmsg("could not read from streamed transaction file")));
+
+    pfree(msg.data);
+    BufFileClose(file);
+
+    apply_commit_local(&commit_data);
+}
+
+/*
+ * Spool a message received inside a stream to the file of the streamed
+ * transaction. Returns false if the message has to be handled right away.
+ */
+static bool apply_spool_stream_message(StringInfo s)
+{
+    const char *msg = s->data + s->cursor;
+    uint32 len = (uint32)(s->len - s->cursor);
+
+    if (!TransactionIdIsValid(t_thrd.applyworker_cxt.streamXid) || len == 0)
+        return false;
+
+    switch (msg[0]) {
+        /* STREAM STOP */
+        case 'E':
+            return false;
+        /*
+         * RELATION, TYPE: the publisher won't send them again even if the
+         * transaction aborts, so apply them now and again when it commits.
+         */
+        case 'R':
+        case 'Y':
+        /* INSERT, UPDATE, DELETE, ORIGIN */
+        case 'I':
+        case 'U':
+        case 'D':
+        case 'O':
+            if (BufFileWrite(t_thrd.applyworker_cxt.streamFile, &len, sizeof(len)) != sizeof(len) ||
+                BufFileWrite(t_thrd.applyworker_cxt.streamFile, (void *)msg, len) != len)
+                ereport(ERROR, (errcode_for_file_access(), errmsg("could not write to streamed transaction file")));
+            return msg[0] != 'R' && msg[0] != 'Y';
+        default:
+            ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
+                errmsg("unexpected logical replication message type \"%c\" in streamed transaction", msg[0])));
+    }
+    return false;
+}
 
 /*
  * Logical replication protocol message dispatcher.
  */
-static void apply_dispatch(StringInfo s)
+void apply_dispatch(StringInfo s)
 {
+    /* The changes of a streamed transaction are spooled until it commits */
+    if (apply_spool_stream_message(s))
+        return;
+
+    /* The parallel apply leader buffers transactions for its workers */
+    if (ParallelApplyActive() && ParallelApplyLeaderDispatch(s))
+        return;
+
     char action = pq_getmsgbyte(s);
 
     switch (action) {
@@ -932,6 +1163,22 @@ static void apply_dispatch(StringInfo s)
         case 'S':
             apply_handle_conninfo(s);
             break;
+        /* STREAM START */
+        case 's':
+            apply_handle_stream_start(s);
+            break;
+        /* STREAM STOP */
+        case 'E':
+            apply_handle_stream_stop(s);
+            break;
+        /* STREAM COMMIT */
+        case 'c':
+            apply_handle_stream_commit(s);
+            break;
+        /* STREAM ABORT */
+        case 'A':
+            apply_handle_stream_abort(s);
+            break;
         default:
             ereport(ERROR, (errcode(ERRCODE_PROTOCOL_VIOLATION),
                 errmsg("invalid logical replication message type \"%c\"", action)));
@@ -954,8 +1201,13 @@ static void apply_dispatch(StringInfo s)
 static void get_flush_position(XLogRecPtr *write, XLogRecPtr *flush, bool *have_pending_txes)
 {
     dlist_mutable_iter iter;
-    XLogRecPtr local_flush = GetFlushRecPtr();
+    XLogRecPtr local_flush;
+
+    /* Collect the commits of the parallel apply workers first */
+    if (ParallelApplyActive())
+        ParallelApplyLeaderProgress();
 
+    local_flush = GetFlushRecPtr();
     *write = InvalidXLogRecPtr;
     *flush = InvalidXLogRecPtr;
 
@@ -982,13 +1234,13 @@ static void get_flush_position(XLogRecPtr *write, XLogRecPtr *flush, bool *have_
         }
     }
 
-    *have_pending_txes = !dlist_is_empty(&t_thrd.applyworker_cxt.lsnMapping);
+    *have_pending_txes = !dlist_is_empty(&t_thrd.applyworker_cxt.lsnMapping) || ParallelApplyInFlight();
 }
 
 /*
  * Store current remote/local lsn pair in the tracking list.
  */
-static void store_flush_position(XLogRecPtr remote_lsn)
+void store_flush_position(XLogRecPtr remote_lsn, XLogRecPtr local_lsn)
 {
     FlushPosition *flushpos;
 
@@ -997,7 +1249,7 @@ static void store_flush_position(XLogRecPtr remote_lsn)
 
     /* Track commit lsn  */
     flushpos = (FlushPosition *)palloc(sizeof(FlushPosition));
-    flushpos->local_end = t_thrd.xlog_cxt.XactLastCommitEnd;
+    flushpos->local_end = local_lsn;
     flushpos->remote_end = remote_lsn;
 
     dlist_push_tail(&t_thrd.applyworker_cxt.lsnMapping, &flushpos->node);
@@ -1173,13 +1425,32 @@ static void LogicalRepApplyLoop(XLogRecPtr last_received)
             if (!t_thrd.applyworker_cxt.mySubscriptionValid)
                 reread_subscription();
 
-            /* Process any table synchronization changes. */
-            process_syncing_tables(last_received);
+            /*
+             * Process any table synchronization changes, once the parallel
+             * apply workers applied everything we received.
+             */
+            if (!ParallelApplyInFlight())
+                process_syncing_tables(last_received);
         }
 
         if (t_thrd.applyworker_cxt.got_SIGHUP) {
             t_thrd.applyworker_cxt.got_SIGHUP = false;
             ProcessConfigFile(PGC_SIGHUP);
+
+            if (ParallelApplyConfigChanged()) {
+                ereport(LOG, (errmsg("logical replication apply worker for subscription \"%s\" will restart because "
+                    "max_parallel_apply_workers_per_subscription was changed",
+                    t_thrd.applyworker_cxt.mySubscription->name)));
+                proc_exit(0);
+            }
+
+            if (!AM_TABLESYNC_WORKER && t_thrd.applyworker_cxt.streaming !=
+                u_sess->attr.attr_storage.enable_logical_replication_streaming) {
+                ereport(LOG, (errmsg("logical replication apply worker for subscription \"%s\" will restart because "
+                    "enable_logical_replication_streaming was changed",
+                    t_thrd.applyworker_cxt.mySubscription->name)));
+                proc_exit(0);
+            }
         }
 
         /* Cleanup the memory. */
@@ -1546,12 +1817,21 @@ void ApplyWorkerMain()
     if (AM_TABLESYNC_WORKER)
         ereport(LOG, (errmsg("logical replication table synchronization for subscription %s, table %s has started",
             t_thrd.applyworker_cxt.mySubscription->name, get_rel_name(t_thrd.applyworker_cxt.curWorker->relid))));
+    else if (AM_PARALLEL_APPLY_WORKER)
+        ereport(LOG, (errmsg("logical replication parallel apply worker %d for subscription \"%s\" has started",
+            t_thrd.applyworker_cxt.curWorker->parallelId, t_thrd.applyworker_cxt.mySubscription->name)));
     else
         ereport(LOG, (errmsg("logical replication apply worker for subscription \"%s\" has started",
             t_thrd.applyworker_cxt.mySubscription->name)));
 
     CommitTransactionCommand();
 
+    /* Parallel apply workers get their transactions from the apply worker, not the publisher. */
+    if (AM_PARALLEL_APPLY_WORKER) {
+        ParallelApplyWorkerMain();
+        proc_exit(0);
+    }
+
     if (AM_TABLESYNC_WORKER) {
         char *syncslotname;
 
@@ -1589,6 +1869,9 @@ void ApplyWorkerMain()
          * call it.
          */
         (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_identify_system();
+
+        /* Start the parallel apply workers, if any are configured. */
+        ParallelApplyStart(originid);
     }
 
     /*
@@ -1608,6 +1891,13 @@ void ApplyWorkerMain()
     options.binary = t_thrd.applyworker_cxt.mySubscription->binary;
     options.useSnapshot = AM_TABLESYNC_WORKER;
 
+    /* table synchronization only catches up briefly, only the apply worker streams */
+    if (!AM_TABLESYNC_WORKER && u_sess->attr.attr_storage.enable_logical_replication_streaming) {
+        options.protoVersion = LOGICALREP_PROTO_STREAM_VERSION_NUM;
+        options.streaming = true;
+        t_thrd.applyworker_cxt.streaming = true;
+    }
+
     /* Start normal logical streaming replication. */
     (WalReceiverFuncTable[GET_FUNC_IDX]).walrcv_startstreaming(&options);
 
@@ -43,11 +43,16 @@ static void pgoutput_abort_txn(LogicalDecodingContext* ctx, ReorderBufferTXN* tx
 static void pgoutput_change(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, Relation rel,
     ReorderBufferChange *change);
 static bool pgoutput_origin_filter(LogicalDecodingContext *ctx, RepOriginId origin_id);
+static void pgoutput_stream_start(LogicalDecodingContext *ctx, ReorderBufferTXN *txn);
+static void pgoutput_stream_stop(LogicalDecodingContext *ctx, ReorderBufferTXN *txn);
+static void pgoutput_stream_commit(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, XLogRecPtr commit_lsn);
+static void pgoutput_stream_abort(LogicalDecodingContext *ctx, ReorderBufferTXN *txn);
 
 static List *LoadPublications(List *pubnames);
 static void publication_invalidation_cb(Datum arg, int cacheid, uint32 hashvalue);
 static bool ReplconninfoChanged();
 static void GetConninfo(StringInfoData* standbysInfo);
+static void MaybeSendConninfo(LogicalDecodingContext *ctx);
 
 /* Entry in the map used to remember which relation schemas we sent. */
 typedef struct RelationSyncEntry {
@@ -76,6 +81,10 @@ void _PG_output_plugin_init(OutputPluginCallbacks *cb)
     cb->abort_cb = pgoutput_abort_txn;
     cb->filter_by_origin_cb = pgoutput_origin_filter;
     cb->shutdown_cb = pgoutput_shutdown;
+    cb->stream_start_cb = pgoutput_stream_start;
+    cb->stream_stop_cb = pgoutput_stream_stop;
+    cb->stream_commit_cb = pgoutput_stream_commit;
+    cb->stream_abort_cb = pgoutput_stream_abort;
 }
 
 static void parse_output_parameters(List *options, PGOutputData *data)
@@ -85,8 +94,10 @@ static void parse_output_parameters(List *options, PGOutputData *data)
     bool publication_names_given = false;
     bool binary_option_given = false;
     bool use_snapshot_given = false;
+    bool streaming_given = false;
 
     data->binary = false;
+    data->streaming = false;
 
     foreach (lc, options) {
         DefElem *defel = (DefElem *)lfirst(lc);
@@ -128,6 +139,12 @@ static void parse_output_parameters(List *options, PGOutputData *data)
             use_snapshot_given = true;
 
             t_thrd.walsender_cxt.isUseSnapshot = true;
+        } else if (strcmp(defel->defname, "streaming") == 0) {
+            if (streaming_given)
+                ereport(ERROR, (errcode(ERRCODE_SYNTAX_ERROR), errmsg("conflicting or redundant options")));
+            streaming_given = true;
+
+            data->streaming = defGetBoolean(defel);
         } else
             elog(ERROR, "unrecognized pgoutput option: %s", defel->defname);
     }
@@ -168,6 +185,12 @@ static void pgoutput_startup(LogicalDecodingContext *ctx, OutputPluginOptions *o
                 errmsg("client sent proto_version=%d but we only support protocol %d or higher", data->protocol_version,
                 LOGICALREP_PROTO_MIN_VERSION_NUM)));
 
+        if (data->streaming && data->protocol_version < LOGICALREP_PROTO_STREAM_VERSION_NUM)
+            ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("requested proto_version=%d does not support streaming, need %d or higher",
+                data->protocol_version, LOGICALREP_PROTO_STREAM_VERSION_NUM)));
+        ctx->streaming = data->streaming;
+
         if (list_length(data->publication_names) < 1)
             ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("publication_names parameter missing")));
 
@@ -227,10 +250,15 @@ static void pgoutput_commit_txn(LogicalDecodingContext *ctx, ReorderBufferTXN *t
     logicalrep_write_commit(ctx->out, txn, commit_lsn);
     OutputPluginWrite(ctx, true);
 
-    /*
-     * Send the newest connecttion information to the subscriber,
-     * when the connection information about the standby changes.
-     */
+    MaybeSendConninfo(ctx);
+}
+
+/*
+ * Send the newest connecttion information to the subscriber,
+ * when the connection information about the standby changes.
+ */
+static void MaybeSendConninfo(LogicalDecodingContext *ctx)
+{
     if (ReplconninfoChanged()) {
         StringInfoData standbysInfo;
         initStringInfo(&standbysInfo);
@@ -253,6 +281,48 @@ static void pgoutput_abort_txn(LogicalDecodingContext* ctx, ReorderBufferTXN* tx
     ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("abort transaction not currently supported")));
 }
 
+/*
+ * STREAM START callback, the changes of the streamed transaction follow
+ */
+static void pgoutput_stream_start(LogicalDecodingContext *ctx, ReorderBufferTXN *txn)
+{
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_start(ctx->out, txn->xid, !txn->streamed);
+    OutputPluginWrite(ctx, true);
+}
+
+/*
+ * STREAM STOP callback
+ */
+static void pgoutput_stream_stop(LogicalDecodingContext *ctx, ReorderBufferTXN *txn)
+{
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_stop(ctx->out);
+    OutputPluginWrite(ctx, true);
+}
+
+/*
+ * STREAM COMMIT callback, the subscriber applies what it got streamed
+ */
+static void pgoutput_stream_commit(LogicalDecodingContext *ctx, ReorderBufferTXN *txn, XLogRecPtr commit_lsn)
+{
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_commit(ctx->out, txn, commit_lsn);
+    OutputPluginWrite(ctx, true);
+
+    MaybeSendConninfo(ctx);
+}
+
+/*
+ * STREAM ABORT callback, the subscriber discards what it got streamed
+ */
+static void pgoutput_stream_abort(LogicalDecodingContext *ctx, ReorderBufferTXN *txn)
+{
+    OutputPluginPrepareWrite(ctx, true);
+    logicalrep_write_stream_abort(ctx->out, txn->xid);
+    OutputPluginWrite(ctx, true);
+}
+
 /* Check whether the buffer change type is supported, return true if supported */
 static inline bool CheckAction(ReorderBufferChangeType type, PublicationActions pubAction)
 {
@@ -4664,14 +4664,21 @@ static void LogicalLogHandleAbortOrCommit(logicalLog *logChange, ParallelReorder
         bool newSub = false;
         ParallelReorderBufferTXN *subtxn =
             ParallelReorderBufferTXNByXid(prb, subXid, false, &newSub, InvalidXLogRecPtr, false);
-        if (subtxn != NULL && !newSub && !subtxn->is_known_as_subxact) {
+        /* already linked to its toplevel transaction by an assignment record */
+        bool linked = (subtxn != NULL && subtxn->is_known_as_subxact);
+        if (subtxn != NULL && !newSub && !linked) {
             dlist_delete(&subtxn->node);
         }
         if (subtxn != NULL) {
             subtxn->is_known_as_subxact = true;
             subtxn->final_lsn = logChange->finalLsn;
             subtxn->commit_time = logChange->commitTime;
-            if (!isForget) {
+            if (linked) {
+                if (isForget) {
+                    dlist_delete(&subtxn->node);
+                    ParallelReorderBufferForget(prb, slotId, subtxn);
+                }
+            } else if (!isForget) {
                 dlist_push_tail(&txn->subtxns, &subtxn->node);
             } else {
                 ParallelReorderBufferForget(prb, slotId, subtxn);
@@ -4779,6 +4786,13 @@ void LogicalLogHandle(logicalLog *logChange)
             ParallelReorderBufferQueueChange(prb, logChange, slotId);
             break;
         }
+        case LOGICAL_LOG_ASSIGNMENT: {
+            ParallelReorderBufferAssignChild(prb, logChange, slotId);
+            pfree_ext(logChange->subXids);
+            logChange->nsubxacts = 0;
+            FreeLogicalLog(logChange, slotId);
+            break;
+        }
         default:
             break;
     }
@@ -4811,7 +4825,7 @@ void XLogSendPararllelLogical()
         ParallelLogicalDecodingContext *ctx = (ParallelLogicalDecodingContext *)prb->private_data;
         if (TimestampDifferenceExceeds(g_Logicaldispatcher[slotId].decodeTime, GetCurrentTimestamp(), expTime) &&
             g_Logicaldispatcher[slotId].remainPatch) {
-            if (g_Logicaldispatcher[slotId].pOptions.decode_style == 'b' ||
+            if (DecodeStyleIsBinary(g_Logicaldispatcher[slotId].pOptions.decode_style) ||
                 g_Logicaldispatcher[slotId].pOptions.sending_batch > 0) {
                 pq_sendint32(ctx->out, 0); /* We send a zero to display that no other decoding result is followed */
             }
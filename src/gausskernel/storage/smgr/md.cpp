@@ -37,6 +37,7 @@
 #include "storage/page_compression.h"
 #include "storage/smgr/knl_usync.h"
 #include "storage/smgr/smgr.h"
+#include "storage/uring.h"
 #include "utils/aiomem.h"
 #include "utils/hsearch.h"
 #include "utils/memutils.h"
@@ -1937,6 +1938,54 @@ SMGR_READ_STATUS mdread(SMgrRelation reln, ForkNumber forknum, BlockNumber block
     }
 }
 
+/*
+ *	mdreadbatch() -- Read a batch of blocks through the thread's io_uring.
+ *
+ *	Unlike mdread(), nothing is reported here: a block that is missing,
+ *	short or unreadable just comes back with ok[i] = false, and the caller
+ *	leaves it to a later mdread() to complain.  Page compressed forks are
+ *	not supported.
+ */
+bool mdreadbatch(SMgrRelation reln, ForkNumber forknum, const BlockNumber *blocknums, char **buffers, bool *ok,
+                 int nblocks)
+{
+    UringIoReq *reqs = NULL;
+    int *slots = NULL;
+    int nreqs = 0;
+
+    if (IS_COMPRESSED_MAINFORK(reln, forknum)) {
+        return false;
+    }
+
+    reqs = (UringIoReq *)palloc(sizeof(UringIoReq) * nblocks);
+    slots = (int *)palloc(sizeof(int) * nblocks);
+    for (int i = 0; i < nblocks; i++) {
+        MdfdVec *v = _mdfd_getseg(reln, forknum, blocknums[i], false, EXTENSION_RETURN_NULL);
+
+        ok[i] = false;
+        if (v == NULL) {
+            continue;
+        }
+        reqs[nreqs].file = v->mdfd_vfd;
+        reqs[nreqs].buf = buffers[i];
+        reqs[nreqs].len = BLCKSZ;
+        reqs[nreqs].offset = (off_t)BLCKSZ * (blocknums[i] % ((BlockNumber)RELSEG_SIZE));
+        reqs[nreqs].result = 0;
+        slots[nreqs++] = i;
+    }
+
+    if (nreqs > 0) {
+        FileUringRead(reqs, nreqs);
+    }
+    for (int i = 0; i < nreqs; i++) {
+        ok[slots[i]] = (reqs[i].result == BLCKSZ);
+    }
+
+    pfree(reqs);
+    pfree(slots);
+    return true;
+}
+
 /*
  *	mdwrite_pc() -- Write the supplied block at the appropriate location for page compressed relation.
  *
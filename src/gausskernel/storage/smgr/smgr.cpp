@@ -59,6 +59,8 @@ typedef struct f_smgr {
     void (*smgr_async_read)(SMgrRelation reln, ForkNumber forknum, AioDispatchDesc_t **dList, int32 dn);
     void (*smgr_async_write)(SMgrRelation reln, ForkNumber forknum, AioDispatchDesc_t **dList, int32 dn);
     void (*smgr_move_buckets)(const RelFileNodeBackend &dest, const RelFileNodeBackend &src, List *bList);
+    bool (*smgr_read_batch)(SMgrRelation reln, ForkNumber forknum, const BlockNumber *blocknums, char **buffers,
+                            bool *ok, int nblocks); /* may be NULL */
 } f_smgr;
 
 static const f_smgr smgrsw[] = {
@@ -79,7 +81,8 @@ static const f_smgr smgrsw[] = {
       mdimmedsync,
       mdasyncread,
       mdasyncwrite,
-      NULL
+      NULL,
+      mdreadbatch
     },
 
     /* undo file */
@@ -118,7 +121,8 @@ static const f_smgr smgrsw[] = {
         seg_immedsync,
         seg_async_read,
         seg_async_write,
-        seg_move_buckets
+        seg_move_buckets,
+        NULL
     },
 };
 
@@ -700,6 +704,23 @@ void smgrasyncwrite(SMgrRelation reln, ForkNumber forknum, AioDispatchDesc_t **d
     (*(smgrsw[reln->smgr_which].smgr_async_write))(reln, forknum, dList, dn);
 }
 
+/*
+ *	smgrreadbatch() -- Read a batch of blocks of a relation with a single
+ *	submission to the kernel.
+ *
+ *	ok[i] reports whether blocknums[i] was read in full; the pages are not
+ *	verified.  Returns false, having read nothing, if the storage manager
+ *	has no batched read for this fork.
+ */
+bool smgrreadbatch(SMgrRelation reln, ForkNumber forknum, const BlockNumber *blocknums, char **buffers, bool *ok,
+                   int nblocks)
+{
+    if (smgrsw[reln->smgr_which].smgr_read_batch == NULL) {
+        return false;
+    }
+    return (*(smgrsw[reln->smgr_which].smgr_read_batch))(reln, forknum, blocknums, buffers, ok, nblocks);
+}
+
 /*
  * smgrread() -- read a particular block from a relation into the supplied buffer.
  *
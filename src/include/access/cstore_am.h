@@ -216,6 +216,7 @@ public:
     int FillTidForLateRead(_in_ CUDesc *cuDescPtr, _out_ ScalarVector *vec);
 
     void FillScanBatchLateIfNeed(__inout VectorBatch *vecBatch);
+    void FillScanBatchLateQualIfNeed(__inout VectorBatch *vecBatch);
 
     /* Set CU range for scan in redistribute. */
     void SetScanRange();
@@ -259,6 +260,12 @@ private:  // private methods.
     void BindingFp(CStoreScanState *state);
     void InitFillVecEnv(CStoreScanState *state);
 
+    // Fill the late read columns needed (or not needed) by the late qual.
+    void FillLateReadColumns(VectorBatch *vecBatch, bool lateQual);
+
+    // Switch to a ring of CU cache blocks once the scan misses too much.
+    void UseCacheStrategyIfNeed(int cuSize);
+
     // indicate whether only accessing system column or const column.
     // true, means that m_virtualCUDescInfo is a new and single object.
     // false, means that m_virtualCUDescInfo just a pointer to m_CUDescInfo[0].
@@ -300,10 +307,12 @@ private:
     // 1. Accessed user column id
     // 2. Accessed system column id
     // 3. flags for late read
-    // 4. each CU storage fro each user column.
+    // 4. flags for late read columns needed by the late qual
+    // 5. each CU storage fro each user column.
     int *m_colId;
     int *m_sysColId;
     bool *m_lateRead;
+    bool *m_lateQualRead;
     CUStorage **m_cuStorage;
 
     // 1. The CUDesc info of accessed columns
@@ -399,6 +408,15 @@ private:
     // for late read
     // the first late read column idx which is filled with ctid.
     int m_laterReadCtidColIdx;
+
+    // for late read
+    // the index in m_colId of the late read column which holds ctid.
+    int m_lateReadCtidIdx;
+
+    // 1. bytes of CUs this scan loaded into CU cache
+    // 2. ring of CU cache blocks used by a bulk scan, NULL for normal access
+    int64 m_cacheMissBytes;
+    CacheAccessStrategy m_cacheStrategy;
 };
 
 // CStore Scan interface for sequential scan
@@ -235,6 +235,7 @@ uint32 GetBatchCount();
 uint32 GetAllWorkerCount();
 PGPROC *StartupPidGetProc(ThreadId pid);
 extern void SetStartupBufferPinWaitBufId(int bufid);
+extern uint32 GetStartupBufferPinWaitBufLen();
 extern void GetStartupBufferPinWaitBufId(int *bufids, uint32 len);
 void UpdateStandbyState(HotStandbyState newState);
 
@@ -249,6 +250,7 @@ void FreeAllocatedRedoItem();
 List *CheckImcompleteAction(List *imcompleteActionList);
 void SetPageWorkStateByThreadId(uint32 threadState);
 void GetReplayedRecPtr(XLogRecPtr *startPtr, XLogRecPtr *endPtr);
+XLogRecPtr GetPageReplayedRecPtr();
 void StartupSendFowarder(RedoItem *item);
 XLogRecPtr GetSafeMinCheckPoint();
 RedoWaitInfo redo_get_io_event(int32 event_id);
@@ -41,6 +41,8 @@
 namespace extreme_rto {
 
 static const uint32 PAGE_WORK_QUEUE_SIZE = 8192;
+/* records between two LSN forwarders when hot standby queries wait for the page workers */
+static const uint32 HOT_STANDBY_LSN_FORWARD_INTERVAL = PAGE_WORK_QUEUE_SIZE / 16;
 
 static const uint32 EXTREME_RTO_ALIGN_LEN = 16; /* need 128-bit aligned */
 static const uint32 MAX_REMOTE_READ_INFO_NUM = 100;
@@ -90,6 +92,8 @@ struct PageRedoWorker {
     RedoRole role;
     uint32 slotId;
     bool isUndoSpaceWorker;
+    /* buffer waited on for a cleanup lock, -1 if none, see SetStartupBufferPinWaitBufId */
+    int bufferPinWaitBufId;
     /* ---------------------------------------------
      * Initial context
      *
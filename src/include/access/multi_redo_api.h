@@ -93,6 +93,9 @@ void GetThreadNameIfMultiRedo(int argc, char* argv[], char** threadNamePtr);
 
 PGPROC* MultiRedoThreadPidGetProc(ThreadId pid);
 void MultiRedoUpdateStandbyState(HotStandbyState newState);
+void MultiRedoSetBufferPinWaitBufId(int bufid);
+uint32 MultiRedoGetBufferPinWaitBufLen();
+void MultiRedoGetBufferPinWaitBufId(int* bufids, uint32 len);
 uint32 MultiRedoGetWorkerId();
 bool IsAllPageWorkerExit();
 void SetPageRedoWorkerIndex(int index);
@@ -269,6 +269,9 @@ typedef struct BTMetaPageData {
 #define XLOG_BTREE_REUSE_PAGE                   \
     0xD0 /* old page is about to be reused from \
           * FSM */
+#define XLOG_BTREE_VACUUM_POSTING            \
+    0xE0 /* as XLOG_BTREE_VACUUM, but also \
+          * shrinks posting list tuples */
 
 
 enum {
@@ -434,6 +437,26 @@ typedef struct xl_btree_vacuum {
 
 #define SizeOfBtreeVacuum (offsetof(xl_btree_vacuum, lastBlockVacuumed) + sizeof(BlockNumber))
 
+/*
+ * This is what we need to know about a vacuum of a leaf page that holds
+ * posting list tuples.  Tuples whose heap TIDs are all dead are deleted as
+ * usual; tuples that only lost some of their TIDs are replaced in place by a
+ * smaller version.  lastBlockVacuumed must stay the first field so that the
+ * record can be handled like xl_btree_vacuum for the pin scan.
+ *
+ * Block data holds ndeleted deleted offsets, then nupdated updated offsets,
+ * then the nupdated replacement tuples, each padded to MAXALIGN.
+ */
+typedef struct xl_btree_vacuum_posting {
+    BlockNumber lastBlockVacuumed;
+    uint16 ndeleted;
+    uint16 nupdated;
+
+    /* DELETED TARGET OFFSET NUMBERS, UPDATED OFFSET NUMBERS AND TUPLES FOLLOW */
+} xl_btree_vacuum_posting;
+
+#define SizeOfBtreeVacuumPosting (offsetof(xl_btree_vacuum_posting, nupdated) + sizeof(uint16))
+
 /*
  * This is what we need to know about deletion of a btree page.  The target
  * identifies the tuple removed from the parent page (note that we remove
@@ -560,6 +583,48 @@ typedef struct xl_btree_newroot {
 #define BT_RESERVED_OFFSET_MASK 0xF000
 #define BT_N_KEYS_OFFSET_MASK 0x0FFF
 
+/*
+ * Posting list tuples are leaf tuples that store several heap TIDs for one
+ * set of key values.  They are marked by INDEX_ALT_TID_MASK plus the
+ * BT_IS_POSTING bit in the t_tid offset, whose low 12 bits then hold the
+ * number of heap TIDs.  The t_tid block number holds the byte offset of the
+ * TID array, which follows the key attributes and is kept in ascending
+ * order.  Posting lists are only ever formed on leaf pages by
+ * _bt_dedup_one_page(); pivot tuples and high keys never have one.
+ */
+#define BT_IS_POSTING 0x2000
+
+#define BTreeTupleIsPosting(itup)                 \
+    (((itup)->t_info & INDEX_ALT_TID_MASK) != 0 && \
+        (ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_IS_POSTING) != 0)
+
+#define BTreeTupleGetNPosting(itup) \
+    ((uint16)(ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_N_KEYS_OFFSET_MASK))
+#define BTreeTupleGetPostingOffset(itup) ItemPointerGetBlockNumberNoCheck(&(itup)->t_tid)
+#define BTreeTupleGetPosting(itup) ((ItemPointer)((char*)(itup) + BTreeTupleGetPostingOffset(itup)))
+#define BTreeTupleGetPostingN(itup, n) (BTreeTupleGetPosting(itup) + (n))
+/* number of heap TIDs a leaf tuple points to */
+#define BTreeTupleGetNItems(itup) (BTreeTupleIsPosting(itup) ? (int)BTreeTupleGetNPosting(itup) : 1)
+
+#define BTreeTupleSetPosting(itup, nhtids, postingoffset)                                 \
+    do {                                                                                \
+        Assert((nhtids) > 1 && ((nhtids) & ~BT_N_KEYS_OFFSET_MASK) == 0);               \
+        (itup)->t_info |= INDEX_ALT_TID_MASK;                                           \
+        ItemPointerSetOffsetNumber(&(itup)->t_tid, (nhtids) | BT_IS_POSTING);           \
+        ItemPointerSetBlockNumber(&(itup)->t_tid, (postingoffset));                     \
+    } while (0)
+
+/* Most heap TIDs a single posting list tuple may hold */
+#define BTMaxPostingTids BT_N_KEYS_OFFSET_MASK
+
+/*
+ * Upper bound on the number of heap TIDs a leaf page can reference once its
+ * tuples have been merged into posting lists.  Scans size their per-page
+ * item arrays with this instead of MaxIndexTuplesPerPage.
+ */
+#define MaxTIDsPerBTreePage \
+    ((int)((BLCKSZ - SizeOfPageHeaderData - sizeof(BTPageOpaqueData)) / sizeof(ItemPointerData)))
+
 /* Get/set downlink block number */
 #define BTreeInnerTupleGetDownLink(itup) ItemPointerGetBlockNumberNoCheck(&((itup)->t_tid))
 #define BTreeInnerTupleSetDownLink(itup, blkno) ItemPointerSetBlockNumber(&((itup)->t_tid), (blkno))
@@ -582,7 +647,7 @@ typedef struct xl_btree_newroot {
  * removed when BT_RESERVED_OFFSET_MASK bits will be used.
  */
 #define BTreeTupleGetNAtts(itup, rel)                                                                           \
-    ((itup)->t_info & INDEX_ALT_TID_MASK                                                                        \
+    (((itup)->t_info & INDEX_ALT_TID_MASK) && !BTreeTupleIsPosting(itup)                                        \
             ? (AssertMacro((ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_RESERVED_OFFSET_MASK) == 0), \
                   ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_N_KEYS_OFFSET_MASK)                    \
             : IndexRelationGetNumberOfAttributes(rel))
@@ -716,7 +781,13 @@ typedef struct BTScanPosData {
     int lastItem;  /* last valid index in items[] */
     int itemIndex; /* current index in items[] */
 
-    BTScanPosItem items[MaxIndexTuplesPerPage]; /* MUST BE LAST */
+    /*
+     * Only pages holding posting lists can yield more than
+     * MaxIndexTuplesPerPage items, so items[] starts at that size and is
+     * enlarged to MaxTIDsPerBTreePage when such a page is first read, see
+     * BTScanOpaqueData.maxItems.
+     */
+    BTScanPosItem* items;
 } BTScanPosData;
 
 typedef BTScanPosData* BTScanPos;
@@ -779,6 +850,7 @@ typedef struct BTScanOpaqueData {
     /* keep these last in struct for efficiency */
     BTScanPosData currPos; /* current position data */
     BTScanPosData markPos; /* marked position, if any */
+    int maxItems;          /* allocated length of currPos.items and markPos.items */
 } BTScanOpaqueData;
 
 typedef BTScanOpaqueData* BTScanOpaque;
@@ -1099,8 +1171,20 @@ extern bool _bt_page_recyclable(Page page);
 extern void _bt_delitems_delete(Relation rel, Buffer buf, OffsetNumber* itemnos, int nitems, Relation heapRel);
 extern void _bt_delitems_vacuum(
     Relation rel, Buffer buf, OffsetNumber* itemnos, int nitems, BlockNumber lastBlockVacuumed);
+extern void _bt_delitems_vacuum_posting(Relation rel, Buffer buf, OffsetNumber* deletable, int ndeletable,
+    OffsetNumber* updatable, IndexTuple* updated, int nupdatable, BlockNumber lastBlockVacuumed);
 extern int _bt_pagedel(Relation rel, Buffer buf, BTStack stack);
 extern void _bt_page_localupgrade(Page page);
+extern void _bt_update_posting(Page page, OffsetNumber offnum, IndexTuple itup);
+
+/*
+ * prototypes for functions in nbtdedup.c
+ */
+extern bool _bt_dedup_is_possible(Relation rel, Relation heapRel);
+extern bool _bt_dedup_one_page(Relation rel, Buffer buf, Size newitemsz);
+extern IndexTuple _bt_form_posting(IndexTuple base, ItemPointer htids, int nhtids);
+extern IndexTuple _bt_strip_posting(IndexTuple itup);
+
 /*
  * prototypes for functions in nbtsearch.c
  */
@@ -1137,6 +1221,9 @@ extern IndexTuple _bt_checkkeys(
 extern bool _bt_check_rowcompare(ScanKey skey, IndexTuple tuple, TupleDesc tupdesc,
     ScanDirection dir, bool *continuescan);
 extern void _bt_killitems(IndexScanDesc scan, bool haveLock);
+extern void _bt_initscanpos(BTScanOpaque so);
+extern void _bt_growscanpos(BTScanOpaque so);
+extern void _bt_copyscanpos(BTScanOpaque so, BTScanPos dst, const BTScanPosData* src);
 extern BTCycleId _bt_vacuum_cycleid(Relation rel);
 extern BTCycleId _bt_start_vacuum(Relation rel);
 extern void _bt_end_vacuum(Relation rel);
@@ -606,6 +606,12 @@ typedef struct XLogCtlData {
     slock_t info_lck; /* locks shared variables shown above */
 } XLogCtlData;
 
+/*
+ * Histograms of the WAL flushes. Bucket 0 counts the value 0 and bucket i
+ * counts values in [2^(i-1), 2^i); the last bucket takes everything above.
+ */
+#define XLOG_FLUSH_HIST_BUCKETS 32
+
 /* Xlog flush statistics*/
 struct XlogFlushStats{
     bool statSwitch;
@@ -623,6 +629,15 @@ struct XlogFlushStats{
     uint64 avgSyncTime;
     uint64 currOpenXlogSegNo;
     TimestampTz lastRestTime;
+
+    /*
+     * Maintained by the holder of WALWriteLock on every flush, regardless of
+     * statSwitch, see XLogFlushCore().
+     */
+    uint64 flushTimeHist[XLOG_FLUSH_HIST_BUCKETS];    /* microseconds to write and sync */
+    uint64 flushBytesHist[XLOG_FLUSH_HIST_BUCKETS];   /* bytes made durable */
+    uint64 flushWaitersHist[XLOG_FLUSH_HIST_BUCKETS]; /* commits waiting on the flush */
+    uint64 flushTimeEstimate; /* moving average of the flush time in microseconds */
 };
 
 extern XLogSegNo GetNewestXLOGSegNo(const char* workingPath);
@@ -116,6 +116,7 @@
 #define XLR_BLOCK_ID_DATA_SHORT 255
 #define XLR_BLOCK_ID_DATA_LONG 254
 #define XLR_BLOCK_ID_ORIGIN 253
+#define XLR_BLOCK_ID_TOPLEVEL_XID 252
 
 /*
  * The fork number fits in the lower 4 bits in the fork_flags field. The upper
@@ -264,6 +265,8 @@ struct XLogReaderState {
 
     RepOriginId record_origin;
 
+    TransactionId toplevel_xid; /* XID of top-level transaction, if the record carries it */
+
     /* ----------------------------------------
      * Decoded representation of current record
      *
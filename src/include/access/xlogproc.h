@@ -946,6 +946,7 @@ void BtreeXlogSplitOperatorNextpage(RedoBufferInfo* buffer, BlockNumber rightsib
 void BtreeXlogSplitOperatorLeftpage(
     RedoBufferInfo* lbuf, void* recorddata, BlockNumber rightsib, bool onleft, void* blkdata, Size datalen);
 void BtreeXlogVacuumOperatorPage(RedoBufferInfo* redobuffer, void* recorddata, void* blkdata, Size len);
+void BtreeXlogVacuumPostingOperatorPage(RedoBufferInfo* redobuffer, void* recorddata, void* blkdata, Size len);
 void BtreeXlogDeleteOperatorPage(RedoBufferInfo* buffer, void* recorddata, Size recorddatalen);
 void btreeXlogDeletePageOperatorRightpage(RedoBufferInfo* buffer, void* recorddata);
 
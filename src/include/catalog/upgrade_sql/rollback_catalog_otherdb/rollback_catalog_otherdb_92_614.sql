@@ -0,0 +1 @@
+DROP FUNCTION IF EXISTS pg_catalog.gs_walwriter_flush_histogram() CASCADE;
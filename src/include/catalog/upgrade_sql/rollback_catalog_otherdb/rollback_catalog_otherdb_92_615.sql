@@ -0,0 +1 @@
+DROP FUNCTION IF EXISTS pg_catalog.pg_stat_get_cu_mem_evict(oid) CASCADE;
@@ -0,0 +1,7 @@
+DROP FUNCTION IF EXISTS pg_catalog.gs_walwriter_flush_histogram() CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3251;
+CREATE FUNCTION pg_catalog.gs_walwriter_flush_histogram(OUT histogram text,
+                                                        OUT lower_bound int8,
+                                                        OUT upper_bound int8,
+                                                        OUT flushes int8)
+RETURNS SETOF record LANGUAGE INTERNAL ROWS 100 as 'gs_walwriter_flush_histogram';
@@ -0,0 +1,4 @@
+DROP FUNCTION IF EXISTS pg_catalog.pg_stat_get_cu_mem_evict(oid) CASCADE;
+SET LOCAL inplace_upgrade_next_system_object_oids = IUO_PROC, 3252;
+CREATE FUNCTION pg_catalog.pg_stat_get_cu_mem_evict(oid)
+RETURNS bigint LANGUAGE INTERNAL STABLE STRICT as 'pg_stat_get_cu_mem_evict';
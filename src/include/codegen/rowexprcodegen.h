@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * rowexprcodegen.h
+ *     Declarations of codegeneration for row engine expressions.
+ *
+ * IDENTIFICATION
+ *        src/include/codegen/rowexprcodegen.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef LLVM_ROW_EXPR_H
+#define LLVM_ROW_EXPR_H
+
+#include "codegen/gscodegen.h"
+#include "optimizer/clauses.h"
+#include "nodes/execnodes.h"
+
+namespace dorado {
+
+/*
+ * RowExprCodeGen class implements LLVM optimization for the expressions
+ * evaluated by the row engine. Just now, quals of the form "Var op Const"
+ * or "Const op Var" on integer types are compiled to a predicate function
+ * taking the Var value, the same shape as the one used for pushed down HDFS
+ * predicates.
+ */
+class RowExprCodeGen : public BaseObject {
+public:
+    /*
+     * Brief        : Check whether the operator expression could be jitted
+     *                for the row engine.
+     * Description  : The operator must be one of "=", "!=", ">", ">=", "<",
+     *                "<=" on int2, int4 and int8. The left argument must be a
+     *                plain Var and the right one a non-null Const. Float types
+     *                are excluded since the ordered LLVM comparisons do not
+     *                follow the NaN semantics of the float operators.
+     * Input        : expr, the node to be checked.
+     * Output       : None.
+     * Return Value : True if the expression could be jitted.
+     * Notes        : None.
+     */
+    static bool IsJittableExpr(Expr* expr);
+
+    /*
+     * Brief        : Generate the IR predicate for an operator expression.
+     * Description  : "Const op Var" is compiled as "Var commutator Const".
+     *                The machine code address is written to jittedFunc once
+     *                the module is compiled at executor start.
+     * Input        : expr, the operator expression.
+     *                parent, the plan state the expression belongs to.
+     * Output       : jittedFunc, the address of the predicate.
+     * Return Value : True if the IR function has been generated.
+     * Notes        : None.
+     */
+    static bool OperCodeGen(Expr* expr, PlanState* parent, void** jittedFunc);
+};
+}  // namespace dorado
+#endif
@@ -180,6 +180,13 @@ typedef struct HashJoinTableData {
     int spreadNum;          /* auto spread times */
     int64* spill_size;
     uint64 spill_count;     /* times of spilling to disk */
+
+    /*
+     * Set if the buckets and tuples are shared by the SMP threads of a stream
+     * group, see HashJoinSharedController.  Such a table has exactly one batch
+     * and is read-only once built.
+     */
+    struct HashJoinSharedController* sharedController;
 } HashJoinTableData;
 
 #endif /* HASHJOIN_H */
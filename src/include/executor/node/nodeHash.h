@@ -26,7 +26,9 @@ extern Node* MultiExecHash(HashState* node);
 extern void ExecEndHash(HashState* node);
 extern void ExecReScanHash(HashState* node);
 
-extern HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNulls);
+extern HashJoinTable ExecHashTableCreate(Hash* node, List* hashOperators, bool keepNulls, bool shared = false);
+extern bool ExecHashTableCanShare(Hash* node);
+extern HashJoinTable ExecHashTableAttach(struct HashJoinSharedController* controller, List* hashOperators);
 extern void ExecHashTableDestroy(HashJoinTable hashtable);
 extern void ExecHashTableInsert(HashJoinTable hashtable, TupleTableSlot* slot, uint32 hashvalue, int planid, int dop,
     Instrumentation* instrument = NULL);
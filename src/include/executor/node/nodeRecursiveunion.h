@@ -120,6 +120,33 @@ typedef struct RecursiveUnionController {
     RecursiveVfd recursive_vfd;
 } RecursiveUnionController;
 
+/* Build status of a shared hash table */
+#define HJ_SHARED_INIT 0     /* nobody has started the build */
+#define HJ_SHARED_BUILDING 1 /* one thread is building, the others wait */
+#define HJ_SHARED_DONE 2     /* table is ready to attach */
+#define HJ_SHARED_FAILED 3   /* builder stopped early, the table is incomplete */
+#define HJ_SHARED_RELEASED 4 /* every attached thread detached, table is gone */
+
+/*
+ * SubClass inheriented from SyncController for a HashJoin whose inner side is a
+ * local broadcast. The SMP threads of the stream group attach to the single hash
+ * table built by the first thread instead of each building an identical copy.
+ * All fields are protected by the stream node group's recursive mutex.
+ */
+typedef struct HashJoinSharedController {
+    /* base controller information */
+    SyncController controller;
+
+    int status;   /* HJ_SHARED_xxx */
+    int refcount; /* number of threads attached to hashtable */
+
+    /* signaled when status leaves HJ_SHARED_BUILDING or the query is stopped */
+    pthread_cond_t cond;
+
+    /* copy of the builder's control block, allocated in stream runtime context */
+    HashJoinTable hashtable;
+} HashJoinSharedController;
+
 /*
  * ***********************************************************************************
  *  Synchronization functions for each controller
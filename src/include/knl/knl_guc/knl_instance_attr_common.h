@@ -58,6 +58,7 @@ typedef struct knl_instance_attr_common {
     int MaxDataNodes;
     int max_changes_in_memory;
     int max_cached_tuplebufs;
+    int thread_pool_steal_threshold;
 #ifdef USE_BONJOUR
     char* bonjour_name;
 #endif
@@ -92,6 +92,7 @@ typedef struct knl_instance_attr_storage {
     bool enable_access_server_directory;
     bool enableIncrementalCheckpoint;
     bool enable_double_write;
+    bool numa_buffer_partition;
     bool enable_delta_store;
     bool enableWalLsnCheck;
     bool gucMostAvailableSync;
@@ -110,6 +111,7 @@ typedef struct knl_instance_attr_storage {
     int64 walwriter_sleep_threshold;
     int num_xloginsert_locks;
     int walwriter_cpu_bind;
+    int wal_flush_max_window;
     int wal_file_init_num;
     int XLOGbuffers;
     int max_wal_senders;
@@ -146,6 +148,7 @@ typedef struct knl_instance_attr_storage {
     knl_instance_attr_dcf dcf_attr;
     int num_internal_lock_partitions[LWLOCK_PART_KIND];
     char* num_internal_lock_partitions_str;
+    char* numa_aware_lwlock_tranches;
     int wal_insert_status_entries_power;
     int undo_zone_count;
     int64 xlog_file_size;
@@ -87,6 +87,7 @@ typedef struct knl_session_attr_storage {
     bool enable_show_any_tuples;
     bool enable_debug_vacuum;
     bool enable_adio_debug;
+    bool enable_uring_prefetch;
     bool gds_debug_mod;
     bool log_pagewriter;
     bool enable_incremental_catchup;
@@ -249,6 +250,8 @@ typedef struct knl_session_attr_storage {
     knl_session_attr_dcf dcf_attr;
     int catchup2normal_wait_time;
     int max_sync_workers_per_subscription;
+    int max_parallel_apply_workers_per_subscription;
+    bool enable_logical_replication_streaming;
 } knl_session_attr_storage;
 
 #endif /* SRC_INCLUDE_KNL_KNL_SESSION_ATTR_STORAGE */
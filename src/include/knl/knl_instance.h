@@ -948,7 +948,7 @@ typedef struct knl_g_wal_context {
     pthread_mutex_t criticalEntryMutex;
     pthread_cond_t criticalEntryCV;
     pthread_condattr_t criticalEntryAtt;
-    volatile uint32 walWaitFlushCount; /* only for xlog statistics use */
+    pg_atomic_uint32 walWaitFlushCount; /* commits that began waiting for a flush since the last one */
     volatile XLogSegNo globalEndPosSegNo; /* Global variable for init xlog segment files. */
     int lastWalStatusEntryFlushed;
     volatile int lastLRCScanned;
@@ -961,6 +961,10 @@ typedef struct knl_u_plancache_context {
     bool gpc_first_send;
     bool gpc_in_try_store;
     bool gpc_in_batch; /* true if is doing 2 ~ n batch execute, false if not in batch or doing first batch execute */
+    /* session level cache in front of the global plan cache, allocated on first use */
+    struct GPCSessionCacheEnt* gpc_session_cache;
+    /* reader slot of the session in the lock-free read path, -1 if none */
+    int gpc_reader_slot;
 } knl_u_plancache_context;
 
 typedef struct knl_u_typecache_context {
@@ -2456,6 +2456,8 @@ typedef struct knl_t_parallel_decode_worker_context {
     volatile sig_atomic_t sleep_long;
     int slotId;
     int parallelDecodeId;
+    struct HTAB* columnarMetaCache; /* relation descriptions of decode style 'c' */
+    MemoryContext columnarMetaCxt;
 } knl_t_parallel_decode_worker_context;
 
 typedef struct knl_t_logical_read_worker_context {
@@ -2524,6 +2526,9 @@ typedef struct knl_t_storage_context {
     int InProgressAioDispatchCount;
     struct BufferDesc* InProgressAioBuf;
     int InProgressAioType;
+    /* local state for io_uring prefetch clean up */
+    struct BufferDesc** InProgressUringBufs;
+    int InProgressUringCount;
     /*
      * When btree split, it will record two xlog:
      * 1. page split
@@ -3240,6 +3245,14 @@ typedef struct knl_t_apply_worker_context {
     List *tableStates;
     XLogRecPtr remoteFinalLsn;
     CommitSeqNo curRemoteCsn;
+    /* Parallel apply state of the apply worker, NULL until parallel apply is set up */
+    struct ParallelApplyLeader *parallelLeader;
+    /* Did we ask for streamed transactions, and the one whose changes are being received */
+    bool streaming;
+    TransactionId streamXid;
+    struct BufFile *streamFile;
+    /* xid => spool file of the streamed transactions not yet committed or aborted */
+    HTAB *streamFiles;
 } knl_t_apply_worker_context;
 
 typedef struct knl_t_publication_context {
@@ -827,6 +827,29 @@ typedef struct ArrayRefExprState {
     char refelemalign;   /* typalign of the element type */
 } ArrayRefExprState;
 
+/* ----------------
+ *		ExprArgStep
+ *
+ * One flattened argument fetch of a simple operator call.  When every
+ * argument of a strict built-in operator is a plain Var or Const, the
+ * arguments are evaluated by walking an array of these steps instead of
+ * recursing through ExecEvalExpr (see ExecEvalOperFast).
+ * ----------------
+ */
+typedef enum ExprArgStepKind {
+    EEOP_ARG_SCAN_VAR = 0, /* fetch attribute from ecxt_scantuple */
+    EEOP_ARG_INNER_VAR,    /* fetch attribute from ecxt_innertuple */
+    EEOP_ARG_OUTER_VAR,    /* fetch attribute from ecxt_outertuple */
+    EEOP_ARG_CONST         /* use the constant value */
+} ExprArgStepKind;
+
+typedef struct ExprArgStep {
+    ExprArgStepKind kind;
+    AttrNumber attnum; /* attribute number for Var steps */
+    bool constisnull;  /* is the constant of a Const step null? */
+    Datum constvalue;  /* constant value for Const steps */
+} ExprArgStep;
+
 /* ----------------
  *		FuncExprState node
  *
@@ -894,6 +917,18 @@ typedef struct FuncExprState {
     FunctionCallInfoData fcinfo_data;
 
     ScalarVector* tmpVec;
+
+    /*
+     * Flattened argument fetch steps, set up on the first call of a simple
+     * strict operator.  NULL if the generic evaluation path is used.
+     */
+    ExprArgStep* argSteps;
+
+    /*
+     * Machine code of the operator generated by LLVM for the row engine,
+     * filled in when the query module is compiled.  NULL if not jitted.
+     */
+    void* jittedFunc;
 } FuncExprState;
 
 /* ----------------
@@ -2226,6 +2261,7 @@ typedef struct HashJoinState {
     bool hj_OuterNotEmpty;
     bool hj_streamBothSides;
     bool hj_rebuildHashtable;
+    bool hj_sharedHashtable; /* share one hash table among the SMP threads of a local broadcast inner */
 } HashJoinState;
 
 /* ----------------------------------------------------------------
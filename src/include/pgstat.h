@@ -134,6 +134,7 @@ typedef struct PgStat_TableCounts {
     PgStat_Counter t_cu_mem_hit;
     PgStat_Counter t_cu_hdd_sync;
     PgStat_Counter t_cu_hdd_asyn;
+    PgStat_Counter t_cu_mem_evict;
 } PgStat_TableCounts;
 
 #ifdef DEBUG_UHEAP
@@ -944,7 +945,7 @@ typedef union PgStat_Msg {
  * ------------------------------------------------------------
  */
 
-#define PGSTAT_FILE_FORMAT_ID 0x01A5BC9B
+#define PGSTAT_FILE_FORMAT_ID 0x01A5BC9C
 
 /* ----------
  * PgStat_StatDBEntry			The collector's data per database
@@ -1086,6 +1087,7 @@ typedef struct PgStat_StatTabEntry {
     PgStat_Counter cu_mem_hit;
     PgStat_Counter cu_hdd_sync;
     PgStat_Counter cu_hdd_asyn;
+    PgStat_Counter cu_mem_evict;
 
     PgStat_Counter success_prune_cnt;
     PgStat_Counter total_prune_cnt;
@@ -2132,6 +2134,11 @@ static inline void pgstat_reset_waitStatePhase(WaitState waitstatus, WaitStatePh
         if ((rel)->pgstat_info != NULL)                        \
             (rel)->pgstat_info->t_counts.t_cu_hdd_asyn += (n); \
     } while (0)
+#define pgstat_count_cu_mem_evict(rel, n)                       \
+    do {                                                        \
+        if ((rel)->pgstat_info != NULL)                         \
+            (rel)->pgstat_info->t_counts.t_cu_mem_evict += (n); \
+    } while (0)
 
 extern void pgstat_count_heap_insert(Relation rel, int n);
 extern void pgstat_count_heap_update(Relation rel, bool hot);
@@ -109,6 +109,12 @@ typedef struct LogicalDecodingContext {
     TransactionId write_xid;
 
     bool random_mode;
+
+    /*
+     * Does the output plugin want large in-progress transactions to be
+     * streamed? Set by its startup callback.
+     */
+    bool streaming;
 } LogicalDecodingContext;
 
 typedef struct chosenTable {
@@ -126,13 +132,18 @@ typedef struct {
     bool skip_empty_xacts;
     bool xact_wrote_changes;
     bool only_local;
-    char decode_style; /* 'j' stands for json while 't' stands for text */
+    char decode_style; /* 'j' json, 't' text, 'b' binary, 'c' binary with column blocks */
     int parallel_decode_num;
     int sending_batch;
+    bool streaming; /* stream large in-progress transactions */
+    bool columnar_compression; /* LZ4 compress the column blocks of decode style 'c' */
     ParallelDecodeChangeCB decode_change;
     List *tableWhiteList;
 } ParallelDecodeOption;
 
+/* decode styles using the binary framing of decoding results */
+#define DecodeStyleIsBinary(style) ((style) == 'b' || (style) == 'c')
+
 typedef struct {
     MemoryContext context;
     ParallelDecodeOption pOptions;
@@ -296,6 +307,7 @@ extern bool firstCreateDispatcher;
 
 extern void CheckLogicalDecodingRequirements(Oid databaseId);
 extern void ParallelReorderBufferQueueChange(ParallelReorderBuffer *rb, logicalLog *change, int slotId);
+extern void ParallelReorderBufferAssignChild(ParallelReorderBuffer *rb, logicalLog *change, int slotId);
 extern void ParallelReorderBufferForget(ParallelReorderBuffer *rb, int slotId, ParallelReorderBufferTXN *txn);
 extern void ParallelReorderBufferCommit(ParallelReorderBuffer *rb, logicalLog *change, int slotId,
     ParallelReorderBufferTXN *txn);
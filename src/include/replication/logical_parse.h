@@ -50,6 +50,8 @@ extern void ParseProcessRecord(ParallelLogicalDecodingContext *ctx, XLogReaderSt
 extern void ParseHeapOp(ParallelLogicalDecodingContext *ctx, XLogRecordBuffer *buf, ParallelDecodeReaderWorker *worker);
 extern void ParseHeap2Op(ParallelLogicalDecodingContext *ctx, XLogRecordBuffer *buf,
     ParallelDecodeReaderWorker *worker);
+extern void ParseAssignmentXlog(ParallelLogicalDecodingContext *ctx, TransactionId xtop, TransactionId *sub_xids,
+    int nsubxacts, ParallelDecodeReaderWorker *worker);
 extern void ParseAbortXlog(ParallelLogicalDecodingContext *ctx, XLogRecPtr lsn, TransactionId xid,
     TransactionId *sub_xids, int nsubxacts, ParallelDecodeReaderWorker *worker);
 extern void ParseInsertXlog(ParallelLogicalDecodingContext *ctx, XLogRecordBuffer *buf,
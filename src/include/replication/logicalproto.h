@@ -28,7 +28,8 @@
  */
 #define LOGICALREP_PROTO_MIN_VERSION_NUM 1
 #define LOGICALREP_PROTO_VERSION_NUM 1
-#define LOGICALREP_PROTO_MAX_VERSION_NUM LOGICALREP_PROTO_VERSION_NUM
+#define LOGICALREP_PROTO_STREAM_VERSION_NUM 2
+#define LOGICALREP_PROTO_MAX_VERSION_NUM LOGICALREP_PROTO_STREAM_VERSION_NUM
 
 /*
  * This struct stores a tuple received via logical replication.
@@ -104,5 +105,12 @@ extern void logicalrep_write_typ(StringInfo out, Oid typoid);
 extern void logicalrep_read_typ(StringInfo out, LogicalRepTyp *ltyp);
 extern void logicalrep_write_conninfo(StringInfo out, char* conninfo);
 extern void logicalrep_read_conninfo(StringInfo in, char** conninfo);
+extern void logicalrep_write_stream_start(StringInfo out, TransactionId xid, bool first_segment);
+extern TransactionId logicalrep_read_stream_start(StringInfo in, bool *first_segment);
+extern void logicalrep_write_stream_stop(StringInfo out);
+extern void logicalrep_write_stream_commit(StringInfo out, ReorderBufferTXN *txn, XLogRecPtr commit_lsn);
+extern TransactionId logicalrep_read_stream_commit(StringInfo in, LogicalRepCommitData *commit_data);
+extern void logicalrep_write_stream_abort(StringInfo out, TransactionId xid);
+extern TransactionId logicalrep_read_stream_abort(StringInfo in);
 
 #endif /* LOGICALREP_PROTO_H */
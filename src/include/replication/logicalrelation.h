@@ -30,6 +30,7 @@ typedef struct LogicalRepRelMapEntry
     Relation localrel; /* relcache entry (NULL when closed) */
     AttrNumber *attrmap; /* map of local attributes to remote ones */
     bool updatable; /* Can apply updates/detetes? */
+    List *uniquekeys; /* remote columns of local unique indexes, one Bitmapset each */
 
     /* Sync state. */
     char state;
@@ -39,6 +40,9 @@ typedef struct LogicalRepRelMapEntry
 extern void logicalrep_relmap_update(LogicalRepRelation *remoterel);
 extern LogicalRepRelMapEntry *logicalrep_rel_open(LogicalRepRelId remoteid, LOCKMODE lockmode);
 extern void logicalrep_rel_close(LogicalRepRelMapEntry *rel, LOCKMODE lockmode);
+extern LogicalRepRelation *logicalrep_remoterel_lookup(LogicalRepRelId remoteid);
+extern List *logicalrep_rel_unique_keys(LogicalRepRelId remoteid);
+extern void logicalrep_relmap_reset_open(void);
 
 #endif   /* LOGICALRELATION_H */
 
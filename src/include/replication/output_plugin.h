@@ -78,6 +78,25 @@ typedef void (*LogicalDecodeAbortCB)(struct LogicalDecodingContext* ctx, Reorder
  */
 typedef void (*LogicalDecodePrepareCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
 
+/*
+ * Called before and after each chunk of changes of a streamed in-progress
+ * transaction. The changes in between are passed to the change callback.
+ */
+typedef void (*LogicalDecodeStreamStartCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+typedef void (*LogicalDecodeStreamStopCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+
+/*
+ * Called for the COMMIT of a transaction whose changes have been streamed.
+ */
+typedef void (*LogicalDecodeStreamCommitCB)(
+    struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn, XLogRecPtr commit_lsn);
+
+/*
+ * Called when a transaction whose changes have been streamed is not going to
+ * commit, or won't be replayed.
+ */
+typedef void (*LogicalDecodeStreamAbortCB)(struct LogicalDecodingContext* ctx, ReorderBufferTXN* txn);
+
 /*
  * Called to shutdown an output plugin.
  */
@@ -100,6 +119,10 @@ typedef struct OutputPluginCallbacks {
     LogicalDecodePrepareCB prepare_cb;
     LogicalDecodeShutdownCB shutdown_cb;
     LogicalDecodeFilterByOriginCB filter_by_origin_cb;
+    LogicalDecodeStreamStartCB stream_start_cb;
+    LogicalDecodeStreamStopCB stream_stop_cb;
+    LogicalDecodeStreamCommitCB stream_commit_cb;
+    LogicalDecodeStreamAbortCB stream_abort_cb;
 } OutputPluginCallbacks;
 
 typedef struct ParallelOutputPluginCallbacks {
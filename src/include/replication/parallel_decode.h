@@ -52,6 +52,26 @@ typedef struct XLogRecordBuffer {
 } XLogRecordBuffer;
 
 
+/*
+ * A change decoded in columnar style is kept in this intermediate form until
+ * the sender groups the rows of one relation into a column block. The header
+ * is followed by metaLen bytes describing the relation and its columns, then
+ * by the new and the old tuple if present: for each column an int32 length,
+ * or one of the COLUMNAR_VALUE_* markers, followed by the value bytes.
+ */
+typedef struct ColumnarChangeHeader {
+    Oid relid;
+    char action; /* 'I', 'U' or 'D' */
+    bool hasNew;
+    bool hasOld;
+    uint16 ncols;
+    uint32 metaLen;
+    uint32 metaHash; /* hash of the descriptions, equal for all changes decoded with the same ones */
+} ColumnarChangeHeader;
+
+#define COLUMNAR_VALUE_NULL (-1)
+#define COLUMNAR_VALUE_UNCHANGED (-2) /* unchanged toast value, or a tuple we can't decode */
+
 typedef enum {
     NOT_DECODE_THREAD,
     DECODE_THREAD_EXIT_NORMAL,
@@ -67,6 +87,8 @@ extern void parallel_decode_change_to_text(Relation relation, ParallelReorderBuf
     logicalLog *logChange, ParallelLogicalDecodingContext* ctx, int slotId);
 extern void parallel_decode_change_to_bin(Relation relation, ParallelReorderBufferChange* change,
     logicalLog *logChange, ParallelLogicalDecodingContext* ctx, int slotId);
+extern void parallel_decode_change_to_columnar(Relation relation, ParallelReorderBufferChange* change,
+    logicalLog *logChange, ParallelLogicalDecodingContext* ctx, int slotId);
 extern int GetDecodeParallelism(int slotId);
 extern ParallelReorderBufferTXN *ParallelReorderBufferGetOldestTXN(ParallelReorderBuffer *rb);
 extern logicalLog* GetLogicalLog(ParallelDecodeWorker *worker);
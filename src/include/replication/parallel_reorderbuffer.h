@@ -35,7 +35,8 @@ enum LogicalLogType {
     LOGICAL_LOG_EMPTY,
     LOGICAL_LOG_RUNNING_XACTS,
     LOGICAL_LOG_CONFIRM_FLUSH,
-    LOGICAL_LOG_NEW_CID
+    LOGICAL_LOG_NEW_CID,
+    LOGICAL_LOG_ASSIGNMENT
 };
 
 typedef struct logicalLog {
@@ -72,7 +73,8 @@ enum ParallelReorderBufferChangeType {
     PARALLEL_REORDER_BUFFER_CHANGE_UDELETE,
     PARALLEL_REORDER_BUFFER_INVALIDATIONS_MESSAGE,
     PARALLEL_REORDER_BUFFER_CHANGE_CONFIRM_FLUSH,
-    PARALLEL_REORDER_BUFFER_NEW_CID
+    PARALLEL_REORDER_BUFFER_NEW_CID,
+    PARALLEL_REORDER_BUFFER_ASSIGNMENT
 };
 
 
@@ -222,6 +224,9 @@ typedef struct ParallelReorderBufferTXN {
      */
     bool serialized;
 
+    /* Have parts of this transaction been streamed to the client already? */
+    bool streamed;
+
     /*
      * How many ReorderBufferChange's do we have in this txn.
      *
@@ -241,6 +241,18 @@ typedef struct ReorderBufferTXN {
      */
     bool serialized;
 
+    /*
+     * Have changes of this transaction already been streamed to the output
+     * plugin while it was still in progress?
+     */
+    bool streamed;
+
+    /*
+     * Snapshot the last streamed change was decoded with, if it differs from
+     * the base snapshot. Decoding of the next stream continues with it.
+     */
+    Snapshot snapshot_now;
+
     /*
      * List of ReorderBufferChange structs, including new Snapshots and new
      * CommandIds
@@ -348,6 +360,16 @@ struct ReorderBuffer {
     ReorderBufferAbortCB abort;
     ReorderBufferPrepareCB prepare;
 
+    /*
+     * Callbacks used to stream large in-progress transactions instead of
+     * spilling them to disk, only called if streaming is set.
+     */
+    ReorderBufferBeginCB stream_start;
+    ReorderBufferBeginCB stream_stop;
+    ReorderBufferCommitCB stream_commit;
+    ReorderBufferAbortCB stream_abort;
+    bool streaming;
+
     /*
      * Pointer that will be passed untouched to the callbacks.
      */
@@ -43,6 +43,10 @@ typedef struct LogicalRepWorker
     TimestampTz last_recv_time;
     XLogRecPtr reply_lsn;
     TimestampTz reply_time;
+
+    /* Used for parallel apply, parallelId is -1 if not a parallel apply worker. */
+    int parallelId;
+    struct ParallelApplyShared *parallelShared;
 } LogicalRepWorker;
 
 typedef struct ApplyLauncherShmStruct {
@@ -56,7 +60,8 @@ typedef struct ApplyLauncherShmStruct {
 extern void logicalrep_worker_attach();
 extern LogicalRepWorker *logicalrep_worker_find(Oid subid, Oid relid, bool only_running);
 extern List *logicalrep_workers_find(Oid subid, bool only_running);
-extern void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid);
+extern void logicalrep_worker_launch(Oid dbid, Oid subid, const char *subname, Oid userid, Oid relid,
+    int parallelId = -1, struct ParallelApplyShared *parallelShared = NULL);
 extern void logicalrep_worker_stop(Oid subid, Oid relid);
 extern void logicalrep_worker_wakeup(Oid subid, Oid relid);
 extern void logicalrep_worker_wakeup_ptr(LogicalRepWorker *worker);
@@ -70,6 +75,21 @@ extern char *LogicalRepSyncTableStart(XLogRecPtr *origin_startpos);
 void process_syncing_tables(XLogRecPtr current_lsn);
 void invalidate_syncing_table_states(Datum arg, int cacheid, uint32 hashvalue);
 
+extern void apply_dispatch(StringInfo s);
+extern void store_flush_position(XLogRecPtr remote_lsn, XLogRecPtr local_lsn);
+
+extern void ParallelApplyStart(RepOriginId originid);
+extern bool ParallelApplyActive(void);
+extern bool ParallelApplyLeaderDispatch(StringInfo s);
+extern void ParallelApplyLeaderProgress(void);
+extern bool ParallelApplyInFlight(void);
+extern void ParallelApplyWaitAll(void);
+extern bool ParallelApplyConfigChanged(void);
+extern void ParallelApplyWorkerMain(void);
+extern void ParallelApplyAssignXid(void);
+extern void ParallelApplyWorkerCommit(struct LogicalRepCommitData *commit_data);
+
 #define AM_TABLESYNC_WORKER (OidIsValid(t_thrd.applyworker_cxt.curWorker->relid))
+#define AM_PARALLEL_APPLY_WORKER (t_thrd.applyworker_cxt.curWorker->parallelId >= 0)
 
 #endif /* WORKER_INTERNAL_H */
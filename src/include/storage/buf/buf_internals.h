@@ -328,6 +328,9 @@ extern void StrategyNotifyBgWriter(int bgwprocno);
 
 extern Size StrategyShmemSize(void);
 extern void StrategyInitialize(bool init);
+extern int StrategyNumPools(void);
+extern void StrategyPoolRange(int pool, int* first_buf, int* num_bufs);
+extern int StrategyLocalPool(void);
 
 /* buf_table.c */
 extern Size BufTableShmemSize(int size);
@@ -158,6 +158,28 @@ typedef struct CacheDesc {
 int CacheMgrNumLocks(int64 cache_size, uint32 each_block_size);
 int64 CacheMgrCalcSizeByType(MgrCacheType type);
 
+/*
+ * Ring of cache blocks for a bulk scan. A scan reading much more than the cache
+ * reuses the blocks of its ring, instead of evicting the blocks of the other
+ * sessions by clock sweep. It works like the BAS_BULKREAD strategy of buffer manager.
+ * As cache blocks differ in size, the ring grows up to ring_size blocks or
+ * max_bytes bytes, whichever comes first.
+ */
+typedef struct CacheAccessStrategyData {
+    int ring_size;
+    int nslots;       /* slots in use, the ring is cut short when it exceeds max_bytes */
+    int current;      /* index of the slot last used */
+    int64 max_bytes;
+    int64 ring_bytes; /* bytes of the blocks in the ring */
+    int* sizes;       /* size of the block of each slot */
+    CacheSlotId_t slots[FLEXIBLE_ARRAY_MEMBER];
+} CacheAccessStrategyData;
+
+typedef CacheAccessStrategyData* CacheAccessStrategy;
+
+CacheAccessStrategy GetCacheAccessStrategy(int ring_size, int64 max_bytes);
+void FreeCacheAccessStrategy(CacheAccessStrategy strategy);
+
 /*
  * This class is to manage Common Cache.
  */
@@ -173,7 +195,8 @@ public:
     CacheSlotId_t FindCacheBlock(CacheTag* cacheTag, bool first_enter_block);
     void InvalidateCacheBlock(CacheTag* cacheTag);
     void DeleteCacheBlock(CacheTag* cacheTag);
-    CacheSlotId_t ReserveCacheBlock(CacheTag* cacheTag, int size, bool& hasFound);
+    CacheSlotId_t ReserveCacheBlock(CacheTag* cacheTag, int size, bool& hasFound,
+        CacheAccessStrategy strategy = NULL, int* evicted = NULL);
     bool ReserveCacheBlockWithSlotId(CacheSlotId_t slotId);
     bool ReserveCstoreCacheBlockWithSlotId(CacheSlotId_t slotId);
     void* GetCacheBlock(CacheSlotId_t slotId);
@@ -234,7 +257,9 @@ private:
 
     /* internal block operate */
     CacheSlotId_t EvictCacheBlock(int size, int retryNum);
-    CacheSlotId_t GetFreeCacheBlock(int size);
+    CacheSlotId_t GetFreeCacheBlock(int size, CacheAccessStrategy strategy, int* evicted);
+    CacheSlotId_t GetRingCacheBlock(CacheAccessStrategy strategy);
+    void RememberRingCacheBlock(CacheAccessStrategy strategy, CacheSlotId_t slotId, int size);
 
     /* memory operate */
     bool ReserveCacheMem(int size);
@@ -257,7 +282,8 @@ private:
     bool CacheBlockIsPinned(CacheSlotId_t slotId) const;
     void PinCacheBlock_Locked(CacheSlotId_t slotId);
 
-    CacheSlotId_t AllocateBlockFromCache(CacheTag* cacheTag, uint32 hashCode, int size, bool& hasFound);
+    CacheSlotId_t AllocateBlockFromCache(CacheTag* cacheTag, uint32 hashCode, int size, bool& hasFound,
+        CacheAccessStrategy strategy, int* evicted);
     void AllocateBlockFromCacheWithSlotId(CacheSlotId_t slotId);
     void WaitEvictSlot(CacheSlotId_t slotId);
 
@@ -96,6 +96,15 @@
  * to unroll the inner loop to avoid loop overhead and minimize register
  * spilling. For less sophisticated compilers it might be beneficial to
  * manually unroll the inner loop.
+ *
+ * The default x86-64 target has no pmulld, so the loop is not vectorized
+ * well by the compiler there.  Explicit AVX2 and AVX-512 kernels are built
+ * with function target attributes and chosen on the first call from what
+ * CPUID reports; aarch64 always has NEON and uses it directly.  All kernels
+ * compute the same 32 columns and return identical results.  Because every
+ * column is one chain of dependent multiplications, a page costs about
+ * 64 multiply latencies once the 32 columns are in vector registers, so
+ * wider vectors mainly save instructions rather than time.
  * ---------------------------------------------------------------------------------------
  */
 
@@ -162,3 +171,20 @@ static const uint32 g_checksumBaseOffsets[N_SUMS] = {0x5B1F36E9,
 uint32 pg_checksum_block(char* data, uint32 size);
 uint32 DataBlockChecksum(char* data, uint32 size, bool zeroing);
 uint16 pg_checksum_page(char* page, BlockNumber blkno);
+
+/*
+ * Implementations of the column loop.  pg_checksum_block() uses the best one
+ * the CPU supports, the others are reachable for testing and benchmarking.
+ */
+typedef enum ChecksumKernel {
+    CHECKSUM_KERNEL_SCALAR = 0,
+    CHECKSUM_KERNEL_AVX2,
+    CHECKSUM_KERNEL_AVX512,
+    CHECKSUM_KERNEL_NEON,
+    CHECKSUM_KERNEL_NUM
+} ChecksumKernel;
+
+bool pg_checksum_kernel_supported(ChecksumKernel kernel);
+const char* pg_checksum_kernel_name(ChecksumKernel kernel);
+ChecksumKernel pg_checksum_current_kernel(void);
+uint32 pg_checksum_block_kernel(ChecksumKernel kernel, char* data, uint32 size);
@@ -250,6 +250,10 @@ public:
     //
     int64 Decompress(char* inbuf, char* outbuf, int insize, int outsize, short inDataSize);
 
+    // the same without the SIMD kernels of delta_decode_impl.cpp.
+    //
+    int64 DecompressScalar(char* inbuf, char* outbuf, int insize, int outsize, short inDataSize);
+
 private:
     template <bool PlusDelta, short inValSize>
     int DoDeltaOperation(_in_ char* inbuf, _out_ char* outbuf, _in_ int insize, _in_ short outValSize);
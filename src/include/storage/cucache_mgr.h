@@ -111,7 +111,8 @@ public:
     DataSlotTag InitOBSSlotTag(uint32 hostNameHash, uint32 bucketNameHash, uint32 fileFirstHalfHash,
         uint32 fileSecondHalfHash, uint64 offset, uint64 length) const;
     CacheSlotId_t FindDataBlock(DataSlotTag* dataSlotTag, bool first_enter_block);
-    int ReserveDataBlock(DataSlotTag* dataSlotTag, int size, bool& hasFound);
+    int ReserveDataBlock(DataSlotTag* dataSlotTag, int size, bool& hasFound, CacheAccessStrategy strategy = NULL,
+        int* evicted = NULL);
     bool ReserveDataBlockWithSlotId(int slotId);
     bool ReserveCstoreDataBlockWithSlotId(int slotId);
     CU* GetCUBuf(int cuSlotId);
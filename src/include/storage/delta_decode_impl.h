@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * delta_decode_impl.h
+ *        SIMD kernels of delta decompressing, used by DeltaCoder::Decompress().
+ *        They need nothing from the backend, so unit tests can build them
+ *        with FRONTEND defined.
+ *
+ *
+ * IDENTIFICATION
+ *        src/include/storage/delta_decode_impl.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef DELTA_DECODE_IMPL_H
+#define DELTA_DECODE_IMPL_H
+
+/*
+ * Decode nvals deltas of inValSize bytes into values of outValSize bytes.
+ * Returns false without touching outbuf if the CPU has no kernel for the sizes.
+ */
+extern bool DeltaDecodeSimd(
+    const char* inbuf, char* outbuf, uint32 nvals, short inValSize, short outValSize, int64 minVal);
+
+#endif /* DELTA_DECODE_IMPL_H */
@@ -301,6 +301,8 @@ struct PGPROC;
 
 typedef struct LWLock {
     uint16      tranche;            /* tranche ID */
+    uint8       numa_aware;         /* tranche is in numa_aware_lwlock_tranches */
+    uint8       cohort_passes;      /* times the queue head was bypassed, see lwlock_cohort.h */
     pg_atomic_uint32 state; /* state of exlusive/nonexclusive lockers */
     dlist_head waiters;     /* list of waiting PGPROCs */
 #ifdef LOCK_DEBUG
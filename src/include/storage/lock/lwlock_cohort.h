@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * lwlock_cohort.h
+ *        NUMA cohort handover policy of LWLocks in numa_aware_lwlock_tranches.
+ *
+ * When an exclusive lock is released and the queue head is exclusive too, the
+ * lock is preferably passed to an exclusive waiter on the releaser's NUMA node,
+ * so the lock word and the data it protects stay in that node's caches. The
+ * queue head is bypassed at most LWLOCK_COHORT_MAX_PASSES times in a row, which
+ * keeps the wait bounded.
+ *
+ * IDENTIFICATION
+ *        src/include/storage/lock/lwlock_cohort.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef LWLOCK_COHORT_H
+#define LWLOCK_COHORT_H
+
+/* waiters looked at for a same-node one, bounds the wait list lock hold time */
+#define LWLOCK_COHORT_SCAN_DEPTH 16
+/* handovers that may bypass the queue head before it must be served */
+#define LWLOCK_COHORT_MAX_PASSES 32
+
+typedef struct LWLockCohortWaiter {
+    int nodeno;     /* NUMA node of the waiter */
+    bool exclusive; /* waits for LW_EXCLUSIVE */
+} LWLockCohortWaiter;
+
+/*
+ * Choose the waiter to wake among the first nwaiters lock waiters in queue
+ * order, waiters[0] being the exclusive queue head. *passes counts how often
+ * the current head has been bypassed and is updated. Returns the index.
+ */
+static inline int LWLockCohortChoose(const LWLockCohortWaiter* waiters, int nwaiters, int releaserNode, uint8* passes)
+{
+    Assert(nwaiters > 0 && waiters[0].exclusive);
+
+    if (waiters[0].nodeno != releaserNode && *passes < LWLOCK_COHORT_MAX_PASSES) {
+        for (int i = 1; i < nwaiters; i++) {
+            if (waiters[i].exclusive && waiters[i].nodeno == releaserNode) {
+                (*passes)++;
+                return i;
+            }
+        }
+    }
+
+    /* the head is served, the next head starts with a fresh budget */
+    *passes = 0;
+    return 0;
+}
+
+#endif /* LWLOCK_COHORT_H */
@@ -80,6 +80,9 @@ enum JitCommandType : uint8_t {
     /** @var Range update command. */
     JIT_COMMAND_RANGE_UPDATE,
 
+    /** @var Range delete command. */
+    JIT_COMMAND_RANGE_DELETE,
+
     /** @var Unordered range select command. */
     JIT_COMMAND_RANGE_SELECT,
 
@@ -164,6 +164,7 @@ struct PGPROC {
     bool lwWaiting;        /* true if waiting for an LW lock */
     uint8 lwWaitMode;      /* lwlock mode being waited for */
     bool lwIsVictim;       /* force to give up LWLock acquire */
+    int lwWaitNode;        /* NUMA node we ran on when queueing on a NUMA aware lock */
     dlist_node lwWaitLink; /* next waiter for same LW lock */
 
     /* Info about lock the process is currently waiting for, if any. */
@@ -448,6 +449,7 @@ extern AlarmCheckResult ConnectionOverloadChecker(Alarm* alarm, AlarmAdditionalP
 extern int ProcGlobalSemas(void);
 extern Size ProcGlobalShmemSize(void);
 extern void InitNuma(void);
+extern int GetCurrentNumaNode(void);
 extern void InitProcGlobal(void);
 extern void InitProcess(void);
 extern void InitProcessPhase2(void);
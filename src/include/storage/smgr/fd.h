@@ -100,6 +100,7 @@ extern int FileAsyncRead(AioDispatchDesc_t** dList, int32 dn);
 extern int FileAsyncWrite(AioDispatchDesc_t** dList, int32 dn);
 extern int FileAsyncCURead(AioDispatchCUDesc_t** dList, int32 dn);
 extern int FileAsyncCUWrite(AioDispatchCUDesc_t** dList, int32 dn);
+extern void FileUringRead(struct UringIoReq* reqs, int nreqs);
 extern void FileFastExtendFile(File file, uint32 offset, uint32 size, bool keep_size);
 extern int FileRead(File file, char* buffer, int amount);
 extern int FileWrite(File file, const char* buffer, int amount, off_t offset, int fastExtendSize = 0);
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * uring.h
+ *        Batched block I/O through a per-thread Linux io_uring
+ *
+ * IDENTIFICATION
+ *        src/include/storage/uring.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef URING_H
+#define URING_H
+
+/*
+ * One transfer of a batch.  The caller fills file, buf, len and offset,
+ * FileUringRead() translates file into the kernel fd, and result receives
+ * the number of bytes transferred or a negative errno.
+ */
+typedef struct UringIoReq {
+    int file;     /* virtual fd, see fd.cpp */
+    int fd;       /* kernel fd */
+    char* buf;
+    uint32 len;
+    off_t offset;
+    int result;
+} UringIoReq;
+
+/* Depth of each thread's ring, a longer batch is submitted in pieces */
+#define URING_RING_ENTRIES 512
+
+extern bool UringIsAvailable(void);
+extern void UringReadBatch(UringIoReq* reqs, int nreqs);
+
+#endif /* URING_H */
@@ -91,6 +91,10 @@ public:
     /* check for hang flag */
     void SetGroupHanged(bool isHang);
     bool IsGroupHanged();
+    /* work stealing between groups */
+    void InitStealOrder(ThreadPoolGroup** groups, int groupNum);
+    bool CanGiveAwaySession(const ThreadPoolGroup* thief);
+    bool CanTakeSession() const;
 
     inline ThreadPoolListener* GetListener()
     {
@@ -132,6 +136,7 @@ public:
     friend class ThreadPoolScheduler;
 
 private:
+    int GetNumaDistance(const ThreadPoolGroup* other) const;
     void AttachThreadToCPU(ThreadId thread, int cpu);
     void AttachThreadToNodeLevel(ThreadId thread) const;
     void AttachThreadToCpuNuma(ThreadId thread);
@@ -151,6 +156,9 @@ private:
     volatile int m_waitServeSessionCount;  // wait for worker to server
     volatile int m_processTaskCount;
     volatile int m_hasHanged;
+    /* backlog went over thread_pool_steal_threshold and has not dropped to half of it yet */
+    volatile uint32 m_giveAway;
+    volatile int m_lentSessionNum;         // sessions served by workers of other groups
 
     int m_groupId;
     int m_numaId;
@@ -168,6 +176,10 @@ private:
     ThreadStreamSentry* m_streams;
     DllistWithLock* m_freeStreamList;
 
+    /* other groups ordered by NUMA distance, closest first */
+    ThreadPoolGroup** m_stealOrder;
+    volatile int m_stealOrderNum;
+
     instr_time m_current_time;
     uint64 m_sessionId;
 };
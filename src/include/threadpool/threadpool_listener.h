@@ -84,6 +84,8 @@ private:
     void DispatchSession(knl_session_context* session);
     Dlelem *GetReadySession(ThreadPoolWorker* worker);
     Dlelem *GetSessFromReadySessionList(ThreadPoolWorker *worker);
+    Dlelem *StealReadySession(ThreadPoolWorker* worker, ThreadPoolGroup** victim);
+    bool DispatchSessionToOtherGroup(knl_session_context* session);
     void AddIdleSessionToTail(knl_session_context* session);
     void AddIdleSessionToHead(knl_session_context* session);
 
@@ -87,7 +87,7 @@ public:
     void WaitMission();
     void CleanUpSession(bool threadexit);
     void CleanUpSessionWithLock();
-    bool WakeUpToWork(knl_session_context* session);
+    bool WakeUpToWork(knl_session_context* session, ThreadPoolGroup* sessionGroup);
     void WakeUpToUpdate(ThreadStatus status);
     bool WakeUpToPendingIfFree();
 
@@ -103,9 +103,10 @@ public:
         return m_tid;
     }
 
-    inline void SetSession(knl_session_context* session)
+    inline void SetSession(knl_session_context* session, ThreadPoolGroup* sessionGroup)
     {
         m_currentSession = session;
+        m_sessionGroup = sessionGroup;
     }
     const inline knl_thrd_context *GetThreadContextPtr()
     {
@@ -129,6 +130,7 @@ private:
     void CleanThread();
     bool AttachSessionToThread();
     void DetachSessionFromThread();
+    void ReturnLentSession();
     void WaitNextSession();
     bool InitPort(Port* port);
     void FreePort(Port* port);
@@ -147,6 +149,8 @@ private:
     ThreadStayReason m_reason;
     Dlelem m_elem;
     ThreadPoolGroup* m_group;
+    /* group whose listener owns m_currentSession, differs from m_group for a stolen session */
+    ThreadPoolGroup* m_sessionGroup;
     pthread_mutex_t* m_mutex;
     pthread_cond_t* m_cond;
     knl_thrd_context *m_thrd;
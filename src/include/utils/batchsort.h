@@ -116,6 +116,12 @@ public:
      */
     int m_bound;
 
+    /*
+     * Encoding of each sort key in the normalized key of the in-memory sort,
+     * NULL if some sort key can not be encoded.  See SortInMemNormKeys().
+     */
+    int* m_normKeyTypes;
+
     MultiColumnsData m_unsortColumns;
 
     bool* m_isSortKey;
@@ -219,6 +225,8 @@ public:
 
     void SortInMem();
 
+    bool SortInMemNormKeys();
+
     int GetSortMergeOrder();
 
     void InitTapes();
@@ -1645,6 +1645,7 @@ extern Datum gs_undo_record(PG_FUNCTION_ARGS);
 extern Datum gs_stat_wal_entrytable(PG_FUNCTION_ARGS);
 extern Datum gs_walwriter_flush_position(PG_FUNCTION_ARGS);
 extern Datum gs_walwriter_flush_stat(PG_FUNCTION_ARGS);
+extern Datum gs_walwriter_flush_histogram(PG_FUNCTION_ARGS);
 
 /* Ledger */
 extern Datum get_dn_hist_relhash(PG_FUNCTION_ARGS);
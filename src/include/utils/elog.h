@@ -441,6 +441,14 @@ typedef struct FormatCallStack {
 
 #define ADIO_END() }
 
+// async prefetch of scans, done by ADIO or else by io_uring (enable_uring_prefetch)
+#ifndef ENABLE_LITE_MODE
+#define ASYNC_PREFETCH_RUN() \
+    if (g_instance.attr.attr_storage.enable_adio_function || u_sess->attr.attr_storage.enable_uring_prefetch) {
+#else
+#define ASYNC_PREFETCH_RUN() if (false) {
+#endif
+
 
 // BFIO means buffer io
 #define BFIO_RUN() if (!g_instance.attr.attr_storage.enable_adio_function) {
@@ -89,11 +89,28 @@ public:
     void RecreateSPICachePlan(SPIPlanPtr spi_plan);
     void RemovePlanCacheInSPIPlan(SPIPlanPtr plan);
 
+    /* lock-free read path */
+    void ReleaseReaderSlot(int slot);
+
 private:
+    int GetReaderSlot();
+    void ResetReaderSlots();
+    bool CanReclaim(uint64 retire_epoch);
+    bool CanDrop(CachedPlanSource* plansource);
+    CachedPlanSource* FetchFromSessionCache(GPCKey* key);
+    void FillSessionCache(GPCKey* key, CachedPlanSource* psrc, uint32 retire_gen);
 
     GPCHashCtl *m_array;
 
     DList *m_invalid_list;
+
+    /* bumped each time a plansource leaves the share table */
+    volatile uint64 m_epoch;
+    /* epochs of the sessions inside the lock-free read path */
+    GPCReaderSlot *m_reader_slots;
+    volatile uint32 m_reader_slots_hwm;
+    /* per fingerprint bucket, bumped before m_epoch when a plansource leaves the share table */
+    volatile uint32 *m_retire_gen;
 };
 
 
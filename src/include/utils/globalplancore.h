@@ -42,6 +42,16 @@
 #define GLOBALPLANCACHEKEY_MAGIC (953717831)
 #define CAS_SLEEP_DURATION (2)
 
+/* per-session direct mapped cache in front of the shared table, must be a power of 2 */
+#define GPC_SESSION_CACHE_SIZE (64)
+/* max threads which may take the lock-free read path at the same time */
+#define GPC_MAX_READER_SLOTS (2048)
+/* retire generations, a plansource leaving the share table bumps the one of its fingerprint */
+#define GPC_RETIRE_GEN_NUM (4096)
+#define GPCRetireGenIndex(fp) ((uint32)((fp).hi & (GPC_RETIRE_GEN_NUM - 1)))
+#define GPC_FINGERPRINT_SEED_HI (0x5bd1e995)
+#define GPC_FINGERPRINT_SEED_LO (0x1b873593)
+
 #define ENABLE_GPC (g_instance.attr.attr_common.enable_global_plancache == true && \
                        g_instance.attr.attr_common.enable_thread_pool == true)
 
@@ -138,9 +148,17 @@ typedef struct GPCEnv
     Oid user_oid; /* only check if has row security */
 } GPCEnv;
 
+/* 128-bit fingerprint of the query text, computed once by GPCKeySetQuery */
+typedef struct GPCFingerprint
+{
+    uint64 hi;
+    uint64 lo;
+} GPCFingerprint;
+
 typedef struct GPCKey
 {
     uint32          query_length;
+    GPCFingerprint  fingerprint;
     /* query_string is plansource->querystring */
     const char     *query_string;
     GPCEnv          env;
@@ -151,7 +169,6 @@ typedef struct GPCVal
 {
     CachedPlanSource*  plansource;
     instr_time  last_use_time;
-    volatile uint32 used_count; /* fetched times */
 } GPCVal;
 
 typedef struct GPCEntry
@@ -164,6 +181,30 @@ typedef struct GPCEntry
 
 } GPCEntry;
 
+/*
+ * Entry of the per-session plan cache. It holds no refcount on the plansource,
+ * the retire generation of its fingerprint recorded at fill time tells whether
+ * the plansource may have been retired since, see
+ * GlobalPlanCache::FetchFromSessionCache.
+ */
+typedef struct GPCSessionCacheEnt
+{
+    GPCFingerprint     fingerprint;
+    uint32             query_length;
+    uint32             retire_gen;
+    CachedPlanSource*  plansource;
+} GPCSessionCacheEnt;
+
+/* reader slot of the lock-free read path, one cache line each to avoid false sharing */
+typedef union GPCReaderSlot
+{
+    struct {
+        volatile uint64 epoch; /* epoch the reader entered in, 0 when outside */
+        volatile uint32 inuse; /* owned by a thread */
+    } slot;
+    char pad[PG_CACHE_LINE_SIZE];
+} GPCReaderSlot;
+
 typedef struct GPCViewStatus
 {
     char *query;
@@ -206,6 +247,7 @@ inline uint32 GetBucket(uint32 hashvalue)
     return (hashvalue % GPC_NUM_OF_BUCKETS);
 }
 
+extern void GPCKeySetQuery(GPCKey *key, const char *query_string, uint32 query_length);
 extern Datum GPCPlanClean(PG_FUNCTION_ARGS);
 extern void GPCResetAll();
 void GPCCleanDatanodeStatement(int dn_stmt_num, const char* stmt_name);
@@ -232,6 +232,8 @@ typedef struct GPCSource
 {
     GPCPlanStatus status;
     struct GPCKey*  key;   //remember when we generate the plan.
+    volatile uint32 used_count; /* fetched times since the last CleanUpByTime pass */
+    uint64 retire_epoch; /* gpc epoch in which the plan left the share table, see AddInvalidList */
 } GPCSource;
 
 typedef struct SPISign
@@ -359,6 +359,7 @@ typedef struct StdRdOptions {
     bool hashbucket;        /* enable hash bucket for this relation */
     bool primarynode;       /* enable primarynode mode for replication table */
     bool crossbucket;       /* enable crossbucket index creation for this index relation */
+    bool deduplicate_items; /* merge duplicate btree keys into posting lists */
     char* wait_clean_cbi;
     int bucketcnt;          /* number of bucket counts */
     int parallel_workers;   /* max number of parallel workers */
@@ -631,6 +631,9 @@ extern void PartitionDecrementReferenceCount(Partition part);
 
 #define RELOPTIONS_CROSSBUCKET(options) ((options) ? ((StdRdOptions *)(options))->crossbucket : false)
 
+#define RelationDeduplicateItems(relation) \
+    ((relation)->rd_options ? ((StdRdOptions *)(relation)->rd_options)->deduplicate_items : false)
+
 /*
  * RELATION_IS_OTHER_TEMP
  *		Test for a temporary relation that belongs to some other session.
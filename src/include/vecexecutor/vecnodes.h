@@ -240,6 +240,13 @@ typedef struct CStoreScanState : ScanState {
     vecqual_func jitted_vecqual;
 
     bool m_isReplicaTable; /* If it is a replication table? */
+
+    // Late qual: conjuncts of the scan qual reading columns that the early qual does not.
+    // Their columns are decompressed only for the rows that passed the early qual.
+    //
+    List* m_lateQual;       // ExprState list, evaluated after ps.qual
+    List* m_lateQualVars;   // attnos read late for m_lateQual
+    List* m_earlyPackVars;  // attnos already filled when packing after ps.qual
 } CStoreScanState;
 
 typedef struct DfsScanState : ScanState {
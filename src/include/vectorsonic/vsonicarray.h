@@ -160,6 +160,8 @@ public:
 
     void getArrayAtomIdx(int nrows, uint32* locs, ArrayIdx* arrayIdx);
 
+    void prefetchArray(int nrows, uint32* locs);
+
     /* set function. */
     ScalarValue replaceVariable(ScalarValue oldVal, ScalarValue val);
 
@@ -35,6 +35,17 @@
  */
 #define SONIC_PART_MAX_NUM 1024
 
+/*
+ * A hash table whose bucket array is larger than this no longer fits in the
+ * CPU cache. Probing then prefetches the buckets, conflict chains and join
+ * keys of a whole batch before reading any of them, so the cache misses of
+ * different rows overlap instead of stalling one after another.
+ */
+#define SONIC_PREFETCH_MIN_HASH_SIZE (256 * 1024)
+
+/* How many tuples ahead of the insert position the build prefetches a bucket */
+#define SONIC_BUILD_PREFETCH_DISTANCE 16
+
 typedef enum { reportTypeBuild = 1, reportTypeProbe, reportTypeRepartition } ReportType;
 
 struct BatchPos {
@@ -112,6 +123,12 @@ private:
     template <typename T, bool complicateJoinKey, bool isSegHashTable>
     VectorBatch* probePartition(SonicHashSource* probeP = NULL);
 
+    template <typename BucketType>
+    void prefetchBuckets(BucketType* hashBucket, uint32 mask, int nrows);
+
+    template <typename BucketType, bool complicateJoinKey>
+    void prefetchConflicts(SonicHashMemPartition* memPartition);
+
     /* join functions */
     template <typename bucketType, bool complicateJoinKey, bool isSegHashTable, bool isPartStatus>
     VectorBatch* innerJoin(VectorBatch* batch);
@@ -225,6 +242,12 @@ private:
     /* runtime attribute */
     VectorBatch* m_outRawBatch;
 
+    /* prefetch the current hash table while probing, see SONIC_PREFETCH_MIN_HASH_SIZE */
+    bool m_prefetchProbe;
+
+    /* bucket index of each probe row, computed when the buckets are prefetched */
+    uint32 m_bucketLoc[BatchMaxSize];
+
     /* record matched position. */
     uint32 m_innerMatchLoc[2 * BatchMaxSize];
     uint32 m_innerPartMatchLoc[2 * BatchMaxSize];
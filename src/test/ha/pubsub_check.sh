@@ -63,11 +63,122 @@ function test_1()
   fi
 }
 
+function wait_sub_equal()
+{
+  expected=$(gsql -d postgres -p $pub_port -t -A -c "$1")
+  for i in $(seq 1 60)
+  do
+    if [ "$(gsql -d postgres -p $sub_port -t -A -c "$1")" = "$expected" ]; then
+      return 0
+    fi
+    sleep 1
+  done
+  echo "subscriber differs from publisher: $1 expected $expected"
+  return 1
+}
+
+function test_2()
+{
+  echo "test parallel apply with conflicting keys"
+  gs_guc reload -D $sub_datadir -c "max_parallel_apply_workers_per_subscription = 4"
+  gsql -d postgres -p $pub_port -c "create table t3 (id int primary key, val int, tag int unique); insert into t3 select generate_series(1, 20), 0, generate_series(1, 20);"
+  gsql -d postgres -p $sub_port -c "create table t3 (id int primary key, val int, tag int unique);"
+  gsql -d postgres -p $pub_port -c "alter publication pub1 add table t3;"
+  gsql -d postgres -p $sub_port -c "alter subscription sub1 refresh publication;"
+  sleep 2
+
+  # the same rows are updated by several sessions, tag values move between rows
+  echo "\parallel on 4
+begin
+for i in 1..500 loop
+update t3 set val = val + 1 where id = i % 10 + 1;
+commit;
+end loop;
+end;
+/
+begin
+for i in 1..500 loop
+update t3 set val = val + 2 where id = i % 7 + 1;
+commit;
+end loop;
+end;
+/
+begin
+for i in 1..300 loop
+insert into t3 values (1000 + i, i, 5000);
+commit;
+delete from t3 where id = 1000 + i;
+commit;
+end loop;
+end;
+/
+begin
+for i in 1..300 loop
+update t3 set tag = 6000 where id = 20;
+commit;
+update t3 set tag = 20 where id = 20;
+commit;
+insert into t3 values (2000 + i, 0, 6000);
+commit;
+delete from t3 where id = 2000 + i;
+commit;
+end loop;
+end;
+/
+\parallel off" > pubsub_parallel_apply_tmp.sql
+  gsql -d postgres -p $pub_port -f pubsub_parallel_apply_tmp.sql > /dev/null 2>&1
+  rm pubsub_parallel_apply_tmp.sql
+
+  if wait_sub_equal "select count(*), sum(val), sum(tag) from t3;"; then
+    echo "parallel apply with conflicting keys success"
+  else
+    echo "parallel apply with conflicting keys $failed_keyword"
+    exit 1
+  fi
+  gs_guc reload -D $sub_datadir -c "max_parallel_apply_workers_per_subscription = 0"
+}
+
+function test_3()
+{
+  echo "test streaming of large in-progress transactions"
+  gs_guc set -D $pub_datadir -c "max_changes_in_memory = 100"
+  gs_guc set -D $sub_datadir -c "enable_logical_replication_streaming = on"
+  gs_ctl stop -D $pub_datadir -m fast
+  gs_ctl stop -D $sub_datadir -m fast
+  gaussdb -D $pub_datadir -p $pub_port &
+  gaussdb -D $sub_datadir -p $sub_port &
+  sleep 10
+
+  gsql -d postgres -p $pub_port -c "create table t4 (id int primary key, val text);"
+  gsql -d postgres -p $sub_port -c "create table t4 (id int primary key, val text);"
+  gsql -d postgres -p $pub_port -c "alter publication pub1 add table t4;"
+  gsql -d postgres -p $sub_port -c "alter subscription sub1 refresh publication;"
+  sleep 2
+
+  # a committed and a rolled back transaction, both far over max_changes_in_memory
+  gsql -d postgres -p $pub_port -c "insert into t4 select generate_series(1, 5000), 'committed';"
+  gsql -d postgres -p $pub_port -c "begin; insert into t4 select generate_series(10001, 15000), 'rolled back'; rollback;"
+  # aborted subtransactions inside large transactions
+  gsql -d postgres -p $pub_port -c "begin; insert into t4 select generate_series(20001, 22000), 'top'; savepoint s1; insert into t4 select generate_series(22001, 24000), 'aborted sub'; rollback to s1; savepoint s2; insert into t4 select generate_series(24001, 26000), 'sub'; release s2; commit;"
+  gsql -d postgres -p $pub_port -c "begin; savepoint s1; insert into t4 select generate_series(30001, 32000), 'sub'; release s1; savepoint s2; update t4 set val = 'aborted update' where id <= 3000; rollback to s2; commit;"
+  gsql -d postgres -p $pub_port -c "insert into t4 values (40001, 'after');"
+
+  if wait_sub_equal "select count(*), sum(id), count(distinct val) from t4;" && \
+     [ "$(gsql -d postgres -p $sub_port -t -A -c "select count(*) from t4 where val in ('rolled back', 'aborted sub', 'aborted update');")" = "0" ]; then
+    echo "streaming of large transactions success"
+  else
+    echo "streaming of large transactions $failed_keyword"
+    exit 1
+  fi
+}
+
 function tear_down() {
   ps -ef | grep -w $pub_datadir | grep -v grep | awk '{print $2}' | xargs kill -9
   ps -ef | grep -w $sub_datadir | grep -v grep | awk '{print $2}' | xargs kill -9
 }
 
 test_1 > ./results/pubsub_check.log 2>&1
+test_2 >> ./results/pubsub_check.log 2>&1
+test_3 >> ./results/pubsub_check.log 2>&1
 tear_down >> ./results/pubsub_check.log 2>&1
 echo "publication and subscription test ok."
\ No newline at end of file
@@ -53,6 +53,16 @@ function test_1()
 
   sleep 1
 
+  pg_recvlogical -d $db -p $dn1_primary_port -S slot4 --create
+  if [ $? -eq 0 ]; then
+    echo "create replication slot4 success"
+  else
+    echo "$failed_keyword: create replication slot slot4 failed."
+    exit 1
+  fi
+
+  sleep 1
+
   #start logical decoding on standby
   echo "begin to decode"
   nohup pg_recvlogical -d $db -p $dn1_standby_port -o include-xids=false -o include-timestamp=true -o skip-empty-xacts=true -o only-local=true -o white-table-list='public.*' -o parallel-decode-num=5 -o standby-connection=false -o decode-style='j' -S slot1 --start -s 2 -f $scripts_dir/data/test1.log &
@@ -79,6 +89,14 @@ function test_1()
     exit 1
   fi
 
+  nohup pg_recvlogical -d $db -p $dn1_standby_port -o parallel-decode-num=5 -o standby-connection=true -o decode-style='c' -o white-table-list='public.t1_decode' -S slot4 --start -s 2 -f $scripts_dir/data/test4.log &
+  if [ $? -eq 0 ]; then
+    echo "parallel decoding with type \'c\' start on standby success"
+  else
+    echo "$failed_keyword: parallel decoding with type \'c\' start on standby failed."
+    exit 1
+  fi
+
   #run sql for parallel decoding
   gsql -d $db -p $dn1_primary_port -f $scripts_dir/data/parallel_decode_xact.sql
   gsql -d $db -p $dn1_primary_port -c "copy t1_decode from '$scripts_dir/data/parallel_decode_data';"
@@ -90,6 +108,14 @@ function test_1()
   #kill pg_recvlogical
   ps -ef | grep pg_recvlogical | grep -v grep | awk '{print $2}' | xargs kill -9
 
+  #the copied rows of t1_decode arrive in column blocks
+  if [ $(grep -c "COLUMN BLOCK INSERT rows: [0-9]* table: public.t1_decode" $scripts_dir/data/test4.log) -gt 0 ]; then
+    echo "parallel decoding with type \'c\' sends column blocks"
+  else
+    echo "$failed_keyword: parallel decoding with type \'c\' sent no column block."
+    exit 1
+  fi
+
   #drop table
   gsql -d $db -p $dn1_primary_port -c "DROP TABLE IF EXISTS t1_decode; DROP TABLE IF EXISTS t2_decode; DROP TABLE IF EXISTS t3_decode; DROP TABLE IF EXISTS t4_decode; DROP TABLE IF EXISTS t5_decode;"
 
@@ -115,10 +141,18 @@ function test_1()
     echo "$failed_keyword: drop replication slot failed."
     exit 1
   fi
+  pg_recvlogical -d $db -p $dn1_primary_port -S slot4 --drop
+  if [ $? -eq 0 ]; then
+    echo "drop replication slot success"
+  else
+    echo "$failed_keyword: drop replication slot failed."
+    exit 1
+  fi
 
   rm $scripts_dir/data/test1.log
   rm $scripts_dir/data/test2.log
   rm $scripts_dir/data/test3.log
+  rm $scripts_dir/data/test4.log
 }
 
 test_1
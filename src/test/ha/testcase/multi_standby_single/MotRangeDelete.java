@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * Range deletes on a mot table through prepared statements, only queries parsed through
+ * the extended protocol are jitted. Prints the affected rows of every execution.
+ *
+ * IDENTIFICATION
+ *        src/test/ha/testcase/multi_standby_single/MotRangeDelete.java
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+import java.sql.*;
+import java.util.*;
+
+public
+class MotRangeDelete {
+public
+    static Connection GetConnection(String port)
+    {
+        String urls = "jdbc:postgresql://127.0.0.1:" + port + "/postgres?prepareThreshold=1&loggerLevel=off";
+        String driver = "org.postgresql.Driver";
+
+        Properties urlProps = new Properties();
+        urlProps.setProperty("user", "jit_tmp");
+        urlProps.setProperty("password", "Gauss@123");
+
+        Connection conn = null;
+        try {
+            Class.forName(driver).newInstance();
+            conn = DriverManager.getConnection(urls, urlProps);
+        } catch (Exception exception) {
+            exception.printStackTrace();
+            return null;
+        }
+
+        return conn;
+    };
+
+public
+    static void RangeDelete(Connection conn, int[][] ranges) throws SQLException
+    {
+        PreparedStatement pstmt = conn.prepareStatement("delete from mot_jit_del where x >= ? and x < ?;");
+        for (int[] range : ranges) {
+            pstmt.setInt(1, range[0]);
+            pstmt.setInt(2, range[1]);
+            System.out.println("range [" + range[0] + ", " + range[1] + "): " + pstmt.executeUpdate());
+        }
+        pstmt.close();
+    }
+
+public
+    static void FilteredRangeDelete(Connection conn, int[][] ranges) throws SQLException
+    {
+        PreparedStatement pstmt = conn.prepareStatement("delete from mot_jit_del where x > ? and x <= ? and y = ?;");
+        for (int[] range : ranges) {
+            pstmt.setInt(1, range[0]);
+            pstmt.setInt(2, range[1]);
+            pstmt.setInt(3, range[2]);
+            System.out.println(
+                "range (" + range[0] + ", " + range[1] + "] y = " + range[2] + ": " + pstmt.executeUpdate());
+        }
+        pstmt.close();
+    }
+
+public
+    static void main(String[] args)
+    {
+        Connection conn = GetConnection(args[0]);
+        if (conn == null) {
+            System.out.println("connection failed");
+            return;
+        }
+
+        try {
+            Statement stmt = conn.createStatement();
+            stmt.executeUpdate("drop foreign table if exists mot_jit_del;");
+            stmt.executeUpdate("create foreign table mot_jit_del (x int primary key, y int) server mot_server;");
+            stmt.executeUpdate("insert into mot_jit_del select generate_series(1, 1000), generate_series(1, 1000) % 4;");
+
+            /* overlapping and empty ranges, and a filter on a column out of the key */
+            RangeDelete(conn, new int[][] {{100, 200}, {150, 250}, {900, 2000}, {2000, 3000}});
+            FilteredRangeDelete(conn, new int[][] {{0, 100, 1}, {0, 100, 1}, {250, 300, 0}});
+
+            ResultSet rs = stmt.executeQuery("select count(*), sum(x) from mot_jit_del;");
+            while (rs.next()) {
+                System.out.println("left: " + rs.getLong(1) + " rows, sum " + rs.getLong(2));
+            }
+            rs.close();
+            stmt.close();
+            conn.close();
+        } catch (SQLException exception) {
+            exception.printStackTrace();
+        }
+    }
+}
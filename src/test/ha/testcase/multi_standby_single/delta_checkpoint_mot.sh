@@ -0,0 +1,87 @@
+#!/bin/sh
+
+# delta checkpoints of mot tables
+# 1. rows deleted by concurrent sessions between checkpoints stay deleted after restart
+# 2. a chain of a full checkpoint and two deltas recovers the same table as before the restart
+
+source ./util.sh
+
+function set_max_checkpoint_deltas()
+{
+    sed -i "/^max_checkpoint_deltas/d" $primary_data_dir/mot.conf
+    echo "max_checkpoint_deltas = $1" >> $primary_data_dir/mot.conf
+}
+
+function table_digest()
+{
+    gsql -d $db -p $1 -m -t -A -c "select count(*), sum(id), sum(val) from mot_delta;"
+}
+
+function check_equal()
+{
+    if [ "$1" != "$2" ]; then
+        echo "$3: expected $2, got $1, $failed_keyword"
+        exit 1
+    fi
+}
+
+function test_1()
+{
+    set_default
+    kill_cluster
+    set_max_checkpoint_deltas 2
+    start_cluster
+    echo "start cluter success!"
+
+    gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists mot_delta; CREATE FOREIGN TABLE mot_delta(id INT primary key, val INT) SERVER mot_server;"
+    gsql -d $db -p $dn1_primary_port -c "insert into mot_delta select generate_series(1, 20000), 1;"
+    # full checkpoint
+    gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+    # deletes from concurrent sessions are recorded by different threads
+    for i in 0 1 2 3
+    do
+        gsql -d $db -p $dn1_primary_port -c "delete from mot_delta where id % 4 = $i and id % 3 = 0;" &
+    done
+    wait
+    gsql -d $db -p $dn1_primary_port -c "update mot_delta set val = 2 where id % 7 = 0;"
+    # first delta
+    gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+    gsql -d $db -p $dn1_primary_port -c "delete from mot_delta where id % 5 = 0;"
+    gsql -d $db -p $dn1_primary_port -c "insert into mot_delta select generate_series(20001, 21000), 3;"
+    gsql -d $db -p $dn1_primary_port -c "delete from mot_delta where id between 20500 and 20600;"
+    # second delta
+    gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+    del_files=$(ls $primary_data_dir/chkpt_*/*.del 2>/dev/null | wc -l)
+    if [ $del_files -eq 0 ]; then
+        echo "no deleted keys file was written, $failed_keyword"
+        exit 1
+    fi
+
+    expected=$(table_digest $dn1_primary_port)
+    kill_cluster
+    start_cluster
+    check_equal "$(table_digest $dn1_primary_port)" "$expected" "primary after restart"
+    echo "delta checkpoint recovery on primary success"
+
+    # the rows are gone for good, a new full checkpoint starts from them
+    gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+    check_equal "$(table_digest $dn1_primary_port)" "$expected" "primary after checkpoint"
+    sleep 5
+    check_equal "$(table_digest $dn1_standby_port)" "$expected" "standby"
+    echo "delta checkpoint recovery on standby success"
+}
+
+function tear_down()
+{
+    sleep 1
+    gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists mot_delta;"
+    kill_cluster
+    set_max_checkpoint_deltas 0
+    start_cluster
+}
+
+test_1
+tear_down
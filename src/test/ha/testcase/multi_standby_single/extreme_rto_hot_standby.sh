@@ -0,0 +1,137 @@
+#!/bin/sh
+
+# hot standby queries while extreme rto redo is running
+# 1. a committed transaction is seen with all of its changes
+# 2. a standby cursor pinning a page does not stop the page workers for good
+
+source ./util.sh
+
+function set_extreme_rto_hot_standby()
+{
+    for element in $primary_data_dir $standby_data_dir
+    do
+        gs_guc set -Z datanode -D $element -c "recovery_max_workers = 0"
+        gs_guc set -Z datanode -D $element -c "recovery_parse_workers = 2"
+        gs_guc set -Z datanode -D $element -c "recovery_redo_workers = 2"
+        gs_guc set -Z datanode -D $element -c "hot_standby = on"
+        gs_guc set -Z datanode -D $element -c "max_standby_streaming_delay = 3s"
+    done
+}
+
+function standby_query()
+{
+    gsql -d $db -p $dn1_standby_port -t -A -c "$1"
+}
+
+function wait_standby_rows()
+{
+    expected=$(gsql -d $db -p $dn1_primary_port -t -A -c "$1")
+    for i in $(seq 1 60)
+    do
+        if [ "$(standby_query "$1")" = "$expected" ]; then
+            return 0
+        fi
+        sleep 1
+    done
+    echo "standby did not replay up to the primary: $1 expected $expected, $failed_keyword"
+    exit 1
+}
+
+function test_1()
+{
+    set_default
+    kill_cluster
+    set_extreme_rto_hot_standby
+    start_cluster
+    echo "start cluter success!"
+
+    gsql -d $db -p $dn1_primary_port -c "create table ert_account (id int primary key, balance int);"
+    gsql -d $db -p $dn1_primary_port -c "insert into ert_account select generate_series(1, 100), 1000;"
+    gsql -d $db -p $dn1_primary_port -c "create table ert_order (id int, part int);"
+    wait_standby_rows "select count(*) from ert_account;"
+
+    # transfers keep the total, every order is inserted as a pair of rows
+    echo "\parallel on 4
+begin
+for i in 1..2000 loop
+update ert_account set balance = balance - 1 where id = (i * 7) % 100 + 1;
+update ert_account set balance = balance + 1 where id = (i * 13) % 100 + 1;
+commit;
+end loop;
+end;
+/
+begin
+for i in 1..2000 loop
+update ert_account set balance = balance - 3 where id = (i * 11) % 100 + 1;
+update ert_account set balance = balance + 3 where id = (i * 17) % 100 + 1;
+commit;
+end loop;
+end;
+/
+begin
+for i in 1..2000 loop
+insert into ert_order values (i, 1), (i, 2);
+commit;
+end loop;
+end;
+/
+begin
+for i in 1..20 loop
+delete from ert_order where id % 10 = i % 10;
+commit;
+perform pg_sleep(0.1);
+end loop;
+end;
+/
+\parallel off" > extreme_rto_hot_standby_tmp.sql
+    gsql -d $db -p $dn1_primary_port -f extreme_rto_hot_standby_tmp.sql > /dev/null 2>&1 &
+    load_pid=$!
+
+    while kill -0 $load_pid 2>/dev/null
+    do
+        total=$(standby_query "select sum(balance) from ert_account;")
+        if [ "$total" != "100000" ]; then
+            echo "standby saw a partial transfer, total $total, $failed_keyword"
+            exit 1
+        fi
+        odd=$(standby_query "select count(*) from (select id from ert_order group by id having count(*) <> 2);")
+        if [ "$odd" != "0" ]; then
+            echo "standby saw a partial insert, $odd orders, $failed_keyword"
+            exit 1
+        fi
+    done
+    rm extreme_rto_hot_standby_tmp.sql
+    wait_standby_rows "select count(*) from ert_order;"
+    echo "consistent reads on extreme rto standby success"
+
+    # the cursor keeps a pin on the first page, vacuum on the primary needs its cleanup lock
+    gsql -d $db -p $dn1_primary_port -c "delete from ert_account where id % 2 = 0;"
+    wait_standby_rows "select count(*) from ert_account;"
+    gsql -d $db -p $dn1_standby_port -c "begin; declare c cursor for select * from ert_account; fetch 1 from c; select pg_sleep(30); end;" > /dev/null 2>&1 &
+    cursor_pid=$!
+    sleep 2
+    gsql -d $db -p $dn1_primary_port -c "vacuum ert_account;"
+    gsql -d $db -p $dn1_primary_port -c "insert into ert_account select generate_series(101, 200), 1000;"
+    wait_standby_rows "select count(*) from ert_account;"
+    wait $cursor_pid
+    echo "buffer pin conflict on extreme rto standby success"
+}
+
+function tear_down()
+{
+    sleep 1
+    gsql -d $db -p $dn1_primary_port -c "drop table if exists ert_account;"
+    gsql -d $db -p $dn1_primary_port -c "drop table if exists ert_order;"
+    kill_cluster
+    for element in $primary_data_dir $standby_data_dir
+    do
+        gs_guc set -Z datanode -D $element -c "recovery_max_workers = 4"
+        gs_guc set -Z datanode -D $element -c "recovery_parse_workers = 1"
+        gs_guc set -Z datanode -D $element -c "recovery_redo_workers = 1"
+        gs_guc set -Z datanode -D $element -c "max_standby_streaming_delay = 30s"
+    done
+    start_cluster
+}
+
+test_1
+tear_down
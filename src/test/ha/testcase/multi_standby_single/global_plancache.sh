@@ -0,0 +1,77 @@
+#!/bin/sh
+
+# global plan cache with thread pool
+# 1. the same query text prepared in different sessions shares one plan
+# 2. a different text does not hit that plan
+# 3. ddl invalidates the shared plan and sessions see the new table definition
+
+source ./util.sh
+
+function set_global_plancache()
+{
+    gs_guc set -Z datanode -D $primary_data_dir -c "enable_thread_pool = $1"
+    gs_guc set -Z datanode -D $primary_data_dir -c "enable_global_plancache = $1"
+}
+
+function gpc_count()
+{
+    gsql -d $db -p $dn1_primary_port -t -A -c "select count(*) from dbe_perf.global_plancache_status where query like 'select % from gpc_t where id = \$1%' $1;"
+}
+
+function check_equal()
+{
+    if [ "$1" != "$2" ]; then
+        echo "$3: expected $2, got $1, $failed_keyword"
+        exit 1
+    fi
+}
+
+function test_1()
+{
+    set_default
+    kill_cluster
+    set_global_plancache on
+    start_cluster
+    echo "start cluter success!"
+
+    gsql -d $db -p $dn1_primary_port -c "create table gpc_t (id int primary key, val int);"
+    gsql -d $db -p $dn1_primary_port -c "insert into gpc_t select generate_series(1, 100), 1;"
+
+    # fingerprint hit: both sessions end up with the same shared plan
+    for i in 1 2
+    do
+        result=$(gsql -d $db -p $dn1_primary_port -q -t -A -c "prepare p1 as select val from gpc_t where id = \$1; execute p1(10); execute p1(20);")
+        check_equal "$(echo $result)" "1 1" "execute of shared plan"
+    done
+    check_equal "$(gpc_count "and valid")" "1" "shared plans after two sessions"
+
+    # fingerprint miss: another text gets its own plan
+    gsql -d $db -p $dn1_primary_port -c "prepare p2 as select val  from gpc_t where id = \$1; execute p2(10);"
+    check_equal "$(gpc_count "and valid")" "2" "shared plans after a different text"
+
+    # invalidation: the plan of the old definition is not used after ddl
+    gsql -d $db -p $dn1_primary_port -c "alter table gpc_t alter column val type bigint;"
+    gsql -d $db -p $dn1_primary_port -c "update gpc_t set val = 4294967296 where id = 10;"
+    result=$(gsql -d $db -p $dn1_primary_port -q -t -A -c "prepare p1 as select val from gpc_t where id = \$1; execute p1(10); execute p1(10);")
+    check_equal "$(echo $result)" "4294967296 4294967296" "execute after ddl"
+
+    # a session keeping its plan across the ddl replans as well
+    result=$(gsql -d $db -p $dn1_primary_port -q -t -A -c "prepare p1 as select val from gpc_t where id = \$1; execute p1(20); alter table gpc_t add column extra int; execute p1(10); execute p1(20);")
+    check_equal "$(echo $result)" "1 4294967296 1" "execute across ddl"
+
+    gsql -d $db -p $dn1_primary_port -c "select * from dbe_perf.global_plancache_clean;"
+    check_equal "$(gpc_count "and not valid")" "0" "invalid plans after clean"
+    echo "global plan cache fingerprint and invalidation success"
+}
+
+function tear_down()
+{
+    sleep 1
+    gsql -d $db -p $dn1_primary_port -c "drop table if exists gpc_t;"
+    kill_cluster
+    set_global_plancache off
+    start_cluster
+}
+
+test_1
+tear_down
@@ -0,0 +1,88 @@
+#!/bin/sh
+
+# range delete of mot tables through prepared statements
+# 1. with mot codegen on the range deletes are jitted
+# 2. with mot codegen on and off every execution reports the same affected rows
+
+source ./util.sh
+
+jar_path=$scripts_dir/../regress/jdbc_test/gsjdbc400.jar
+jit_log_keyword="Invoking jitted mot query and query string: delete from mot_jit_del"
+expected_result="range [100, 200): 100
+range [150, 250): 50
+range [900, 2000): 101
+range [2000, 3000): 0
+range (0, 100] y = 1: 25
+range (0, 100] y = 1: 0
+range (250, 300] y = 0: 13
+left: 711 rows, sum 373562"
+
+function set_mot_codegen()
+{
+    sed -i "/^enable_mot_codegen/d" $primary_data_dir/mot.conf
+    echo "enable_mot_codegen = $1" >> $primary_data_dir/mot.conf
+    echo "enable_mot_codegen_print = $1" >> $primary_data_dir/mot.conf
+}
+
+function jit_log_count()
+{
+    cat $primary_data_dir/pg_log/*.log 2>/dev/null | grep "$jit_log_keyword" | wc -l
+}
+
+function run_range_delete()
+{
+    kill_cluster
+    set_mot_codegen $1
+    start_cluster
+
+    jit_before=$(jit_log_count)
+    result=$(java -cp $CLASSPATH:$jar_path:./results MotRangeDelete $dn1_primary_port 2>&1)
+    if [ "$result" != "$expected_result" ]; then
+        echo "range delete with mot codegen $1 returned"
+        echo "$result"
+        echo "$failed_keyword"
+        exit 1
+    fi
+    jitted=$(expr $(jit_log_count) - $jit_before)
+}
+
+function test_1()
+{
+    set_default
+    kill_cluster
+    hba_line="host    all    jit_tmp    127.0.0.1/32    sha256"
+    gs_guc set -Z datanode -D $primary_data_dir -h "$hba_line"
+    start_cluster
+    echo "start cluter success!"
+
+    gsql -d $db -p $dn1_primary_port -c "create user jit_tmp with login sysadmin password '$passwd';"
+    javac -cp $CLASSPATH:$jar_path -d ./results ./testcase/multi_standby_single/MotRangeDelete.java
+
+    run_range_delete true
+    if [ $jitted -eq 0 ]; then
+        echo "range delete was not jitted, $failed_keyword"
+        exit 1
+    fi
+    echo "jitted range delete success"
+
+    run_range_delete false
+    if [ $jitted -ne 0 ]; then
+        echo "range delete was jitted with mot codegen off, $failed_keyword"
+        exit 1
+    fi
+    echo "range delete without jit success"
+}
+
+function tear_down()
+{
+    sleep 1
+    gsql -d $db -p $dn1_primary_port -c "drop foreign table if exists mot_jit_del;"
+    gsql -d $db -p $dn1_primary_port -c "drop user if exists jit_tmp;"
+    rm -f ./results/MotRangeDelete.class
+    kill_cluster
+    sed -i "/^enable_mot_codegen/d" $primary_data_dir/mot.conf
+    start_cluster
+}
+
+test_1
+tear_down
@@ -0,0 +1,105 @@
+#!/bin/sh
+
+# shared buffers split into one pool per numa node
+# 1. with a pagewriter sub thread group per pool, a table larger than shared buffers is read and
+#    updated by concurrent sessions, and backends take buffers from the candidate lists
+# 2. the same with fewer pagewriter threads than pools, where the candidate lists mix the pools
+# needs a machine with several numa nodes, it is skipped otherwise
+
+source ./util.sh
+
+split_log="shared buffers are split into"
+fallback_log="candidate lists are not kept per node"
+
+function numa_node_count()
+{
+    numactl --hardware 2>/dev/null | awk '/^available:/ {print $2}'
+}
+
+function log_count()
+{
+    cat $primary_data_dir/pg_log/*.log 2>/dev/null | grep "$1" | wc -l
+}
+
+function set_numa_buffer_pools()
+{
+    gs_guc set -Z datanode -D $primary_data_dir -c "numa_distribute_mode = '$1'"
+    gs_guc set -Z datanode -D $primary_data_dir -c "numa_buffer_partition = $2"
+    gs_guc set -Z datanode -D $primary_data_dir -c "shared_buffers = $3"
+    gs_guc set -Z datanode -D $primary_data_dir -c "pagewriter_thread_num = $4"
+}
+
+function check_equal()
+{
+    if [ "$1" != "$2" ]; then
+        echo "$3: expected $2, got $1, $failed_keyword"
+        exit 1
+    fi
+}
+
+# 64MB of shared buffers against a table of about 150MB, so that every pool is swept over and over
+function run_workload()
+{
+    gsql -d $db -p $dn1_primary_port -c "drop table if exists numa_buf; create table numa_buf (id int, val int, pad text);"
+    gsql -d $db -p $dn1_primary_port -c "insert into numa_buf select g, 0, repeat('x', 200) from generate_series(1, 600000) g;"
+
+    for i in $(seq 0 7)
+    do
+        (
+            gsql -d $db -p $dn1_primary_port -c "update numa_buf set val = val + 1 where id % 8 = $i;"
+            gsql -d $db -p $dn1_primary_port -c "select count(*) from numa_buf where pad like 'x%';"
+            gsql -d $db -p $dn1_primary_port -c "update numa_buf set val = val + 1 where id % 8 = $i and id % 3 = 0;"
+        ) > /dev/null 2>&1 &
+    done
+    wait
+
+    check_equal "$(gsql -d $db -p $dn1_primary_port -t -A -c "select count(*), sum(val) from numa_buf;")" "600000|800000" "rows after the concurrent updates"
+    from_list=$(gsql -d $db -p $dn1_primary_port -t -A -c "select sum(get_buf_from_list) from local_candidate_stat();")
+    if [ "$from_list" = "" ] || [ $from_list -eq 0 ]; then
+        echo "no buffer was taken from a candidate list, $failed_keyword"
+        exit 1
+    fi
+}
+
+function test_1()
+{
+    nodes=$(numa_node_count)
+    if [ "$nodes" = "" ] || [ $nodes -lt 2 ]; then
+        echo "only ${nodes:-1} numa node, numa buffer pools are not tested"
+        return
+    fi
+
+    set_default
+    kill_cluster
+    split_before=$(log_count "$split_log")
+    set_numa_buffer_pools all on 64MB 16
+    start_cluster
+    echo "start cluter success!"
+
+    check_equal "$(log_count "$split_log")" "$(expr $split_before + 1)" "buffer pool split messages"
+    run_workload
+    echo "numa buffer pools with their own candidate lists success"
+
+    kill_cluster
+    fallback_before=$(log_count "$fallback_log")
+    set_numa_buffer_pools all on 64MB 1
+    start_cluster
+    check_equal "$(log_count "$fallback_log")" "$(expr $fallback_before + 1)" "shared candidate list warnings"
+    run_workload
+    echo "numa buffer pools with shared candidate lists success"
+}
+
+function tear_down()
+{
+    if [ "$nodes" = "" ] || [ $nodes -lt 2 ]; then
+        return
+    fi
+    sleep 1
+    gsql -d $db -p $dn1_primary_port -c "drop table if exists numa_buf;"
+    kill_cluster
+    set_numa_buffer_pools none off 2GB 4
+    start_cluster
+}
+
+test_1
+tear_down
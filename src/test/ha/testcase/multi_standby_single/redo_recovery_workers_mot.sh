@@ -0,0 +1,106 @@
+#!/bin/sh
+
+# replay of the mot redo log on several workers
+# 1. single table, cross table and ddl transactions written after the last checkpoint
+#    are all there after the primary crashes and replays them
+# 2. the standby replaying the same log with several workers ends up with the same tables
+
+source ./util.sh
+
+function set_redo_recovery_workers()
+{
+    for dir in $primary_data_dir $standby_data_dir
+    do
+        sed -i "/^redo_recovery_workers/d" $dir/mot.conf
+        echo "redo_recovery_workers = $1" >> $dir/mot.conf
+    done
+}
+
+function table_digest()
+{
+    for tbl in mot_rw1 mot_rw2 mot_rw3 mot_rw4
+    do
+        gsql -d $db -p $1 -m -t -A -c "select '$tbl', count(*), sum(id), sum(val) from $tbl;"
+    done
+    gsql -d $db -p $1 -m -t -A -c "select count(*) from mot_rw2 where val = 7;"
+}
+
+function check_equal()
+{
+    if [ "$1" != "$2" ]; then
+        echo "$3: expected $2, got $1, $failed_keyword"
+        exit 1
+    fi
+}
+
+function test_1()
+{
+    set_default
+    kill_cluster
+    set_redo_recovery_workers 4
+    start_cluster
+    echo "start cluter success!"
+
+    for tbl in mot_rw1 mot_rw2 mot_rw3
+    do
+        gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists $tbl; CREATE FOREIGN TABLE $tbl(id INT primary key, val INT) SERVER mot_server;"
+        gsql -d $db -p $dn1_primary_port -c "insert into $tbl select generate_series(1, 10000), 1;"
+    done
+    gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists mot_rw4;"
+    # everything below is only in the redo log
+    gsql -d $db -p $dn1_primary_port -c "checkpoint;"
+
+    # single table transactions from concurrent sessions, dispatched to different workers
+    for tbl in mot_rw1 mot_rw2 mot_rw3
+    do
+        for i in $(seq 0 3)
+        do
+            echo "update $tbl set val = val + 1 where id % 4 = $i;"
+            echo "delete from $tbl where id % 4 = $i and id % 9 = 0;"
+            echo "insert into $tbl select generate_series(10001 + $i * 100, 10100 + $i * 100), $i;"
+        done > redo_workers_$tbl.sql
+        gsql -d $db -p $dn1_primary_port -f redo_workers_$tbl.sql > /dev/null 2>&1 &
+    done
+    wait
+    rm -f redo_workers_*.sql
+
+    # cross table transactions wait for the workers of every table they touch
+    for i in $(seq 1 20)
+    do
+        gsql -d $db -p $dn1_primary_port -c "start transaction; update mot_rw1 set val = val * 2 where id = $i; delete from mot_rw2 where id = $i; insert into mot_rw3 values (20000 + $i, $i); commit;"
+    done
+
+    # ddl waits for all workers, and the tables are used again right after it
+    gsql -d $db -p $dn1_primary_port -c "create index mot_rw2_val on mot_rw2(val);"
+    gsql -d $db -p $dn1_primary_port -c "update mot_rw2 set val = 7 where id between 100 and 300;"
+    gsql -d $db -p $dn1_primary_port -c "CREATE FOREIGN TABLE mot_rw4(id INT primary key, val INT) SERVER mot_server;"
+    gsql -d $db -p $dn1_primary_port -c "start transaction; insert into mot_rw4 select generate_series(1, 500), 4; update mot_rw3 set val = 5 where id < 50; commit;"
+    gsql -d $db -p $dn1_primary_port -c "truncate mot_rw1;"
+    gsql -d $db -p $dn1_primary_port -c "insert into mot_rw1 select generate_series(1, 3000), 8;"
+
+    expected=$(table_digest $dn1_primary_port)
+    sleep 5
+    check_equal "$(table_digest $dn1_standby_port)" "$expected" "standby"
+    echo "redo replay on standby success"
+
+    # crash without a checkpoint, the restart replays all of the above
+    kill_cluster
+    start_cluster
+    check_equal "$(table_digest $dn1_primary_port)" "$expected" "primary after restart"
+    echo "redo replay on primary success"
+    sleep 5
+    check_equal "$(table_digest $dn1_standby_port)" "$expected" "standby after restart"
+    echo "redo replay on standby after restart success"
+}
+
+function tear_down()
+{
+    sleep 1
+    gsql -d $db -p $dn1_primary_port -c "DROP FOREIGN TABLE if exists mot_rw1; DROP FOREIGN TABLE if exists mot_rw2; DROP FOREIGN TABLE if exists mot_rw3; DROP FOREIGN TABLE if exists mot_rw4;"
+    kill_cluster
+    set_redo_recovery_workers 1
+    start_cluster
+}
+
+test_1
+tear_down
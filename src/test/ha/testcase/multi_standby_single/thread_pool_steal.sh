@@ -0,0 +1,85 @@
+#!/bin/sh
+
+# thread pool groups serving each other's sessions
+# 1. with one worker per group and the lowest steal threshold every session still gets all of its work done
+# 2. shutdown with sessions on workers of other groups closes them all without a session count reset
+
+source ./util.sh
+
+reset_warning="SessionCount should be zero when no session in this group"
+
+function set_thread_pool_steal()
+{
+    gs_guc set -Z datanode -D $primary_data_dir -c "enable_thread_pool = $1"
+    gs_guc set -Z datanode -D $primary_data_dir -c "thread_pool_attr = '$2'"
+    gs_guc set -Z datanode -D $primary_data_dir -c "thread_pool_steal_threshold = $3"
+}
+
+function reset_warning_count()
+{
+    cat $primary_data_dir/pg_log/*.log 2>/dev/null | grep "$reset_warning" | wc -l
+}
+
+function check_equal()
+{
+    if [ "$1" != "$2" ]; then
+        echo "$3: expected $2, got $1, $failed_keyword"
+        exit 1
+    fi
+}
+
+function test_1()
+{
+    set_default
+    kill_cluster
+    set_thread_pool_steal on "2, 2, (nobind)" 1
+    start_cluster
+    echo "start cluter success!"
+
+    gsql -d $db -p $dn1_primary_port -c "create table tp_steal (sess int, val int);"
+
+    # more sessions than workers, each detaching between its statements
+    for i in $(seq 1 16)
+    do
+        for j in $(seq 1 5)
+        do
+            echo "insert into tp_steal select $i, generate_series(1, 200);"
+            echo "select pg_sleep(0.1);"
+        done > thread_pool_steal_$i.sql
+        gsql -d $db -p $dn1_primary_port -f thread_pool_steal_$i.sql > /dev/null 2>&1 &
+    done
+    wait
+    rm -f thread_pool_steal_*.sql
+
+    check_equal "$(gsql -d $db -p $dn1_primary_port -t -A -c "select count(*) from tp_steal;")" "16000" "rows of all sessions"
+    check_equal "$(gsql -d $db -p $dn1_primary_port -t -A -c "select count(*) from (select sess from tp_steal group by sess having count(*) <> 1000);")" "0" "sessions with missing rows"
+    echo "sessions served across groups success"
+
+    # shut down while sessions are busy on workers of both groups
+    warnings=$(reset_warning_count)
+    for i in $(seq 1 8)
+    do
+        gsql -d $db -p $dn1_primary_port -c "select pg_sleep(60);" > /dev/null 2>&1 &
+    done
+    sleep 2
+    kill_cluster
+    wait
+    check_equal "$(reset_warning_count)" "$warnings" "session count resets at shutdown"
+    start_cluster
+    check_equal "$(gsql -d $db -p $dn1_primary_port -t -A -c "select count(*) from tp_steal;")" "16000" "rows after restart"
+    echo "shutdown with lent sessions success"
+}
+
+function tear_down()
+{
+    sleep 1
+    gsql -d $db -p $dn1_primary_port -c "drop table if exists tp_steal;"
+    kill_cluster
+    gs_guc set -Z datanode -D $primary_data_dir -c "enable_thread_pool = off"
+    gs_guc set -Z datanode -D $primary_data_dir -c "thread_pool_attr = '16, 2, (nobind)'"
+    gs_guc set -Z datanode -D $primary_data_dir -c "thread_pool_steal_threshold = 4"
+    start_cluster
+}
+
+test_1
+tear_down
@@ -0,0 +1,39 @@
+--
+-- B-tree deduplication of equal keys into posting lists
+--
+create table btree_dedup_tbl (id int, status int);
+create index btree_dedup_idx on btree_dedup_tbl (status) with (deduplicate_items = on);
+create index btree_nodedup_idx on btree_dedup_tbl (status);
+insert into btree_dedup_tbl select i, i % 5 from generate_series(1, 20000) i;
+
+-- duplicates are merged instead of splitting leaf pages
+select pg_relation_size('btree_dedup_idx') < pg_relation_size('btree_nodedup_idx') as shrunk;
+drop index btree_nodedup_idx;
+
+set enable_seqscan = off;
+set enable_bitmapscan = off;
+
+-- every heap TID of a posting list is returned, in both scan directions
+select count(*), sum(id) from btree_dedup_tbl where status = 3;
+select count(*), sum(id) from (select id from btree_dedup_tbl where status = 3 order by status desc) s;
+select count(distinct status) from btree_dedup_tbl where status >= 0;
+
+-- vacuum removes dead TIDs from posting lists that keep live ones
+delete from btree_dedup_tbl where id % 2 = 0;
+vacuum btree_dedup_tbl;
+select count(*), sum(id) from btree_dedup_tbl where status = 3;
+select count(*), sum(id) from (select id from btree_dedup_tbl where status = 3 order by status desc) s;
+
+-- and deletes posting lists that have none left
+delete from btree_dedup_tbl where status = 3;
+vacuum btree_dedup_tbl;
+select count(*) from btree_dedup_tbl where status = 3;
+select count(*) from btree_dedup_tbl where status = 4;
+
+alter index btree_dedup_idx set (deduplicate_items = off);
+insert into btree_dedup_tbl select i, i % 5 from generate_series(20001, 21000) i;
+select count(*) from btree_dedup_tbl where status = 4;
+
+reset enable_seqscan;
+reset enable_bitmapscan;
+drop table btree_dedup_tbl;
@@ -0,0 +1,56 @@
+--
+-- row engine quals compiled by LLVM must give the same answers as the
+-- interpreter, including NULL inputs and constants out of the column range
+--
+create schema llvm_rowexpr;
+set search_path = llvm_rowexpr;
+
+create table llvm_rowexpr_t (c2 int2, c4 int4, c8 int8);
+insert into llvm_rowexpr_t values (-32768, -2147483648, '-9223372036854775808');
+insert into llvm_rowexpr_t values (32767, 2147483647, 9223372036854775807);
+insert into llvm_rowexpr_t values (0, 0, 0);
+insert into llvm_rowexpr_t values (1, 1, 1);
+insert into llvm_rowexpr_t values (null, null, null);
+insert into llvm_rowexpr_t values (-1, -1, -1);
+insert into llvm_rowexpr_t values (100, 100000, 10000000000);
+analyze llvm_rowexpr_t;
+
+set codegen_cost_threshold = 0;
+
+set enable_codegen = on;
+select count(*) from llvm_rowexpr_t where c2 > 0;
+select count(*) from llvm_rowexpr_t where c2 < 40000;
+select count(*) from llvm_rowexpr_t where c2 >= -32768;
+select count(*) from llvm_rowexpr_t where c4 = 2147483647;
+select count(*) from llvm_rowexpr_t where c4 > 3000000000;
+select count(*) from llvm_rowexpr_t where c4 <> 1;
+select count(*) from llvm_rowexpr_t where c8 <= '-9223372036854775808'::int8;
+select count(*) from llvm_rowexpr_t where c8 > 9223372036854775806;
+select count(*) from llvm_rowexpr_t where 0 < c4;
+select count(*) from llvm_rowexpr_t where 10000000000 > c4;
+select count(*) from llvm_rowexpr_t where c8 = c4;
+select count(*) from llvm_rowexpr_t where c4 > null::int4;
+select count(*) from llvm_rowexpr_t where not (c2 > 0);
+select count(*) from llvm_rowexpr_t where c4 * 2 > 0;
+
+set enable_codegen = off;
+select count(*) from llvm_rowexpr_t where c2 > 0;
+select count(*) from llvm_rowexpr_t where c2 < 40000;
+select count(*) from llvm_rowexpr_t where c2 >= -32768;
+select count(*) from llvm_rowexpr_t where c4 = 2147483647;
+select count(*) from llvm_rowexpr_t where c4 > 3000000000;
+select count(*) from llvm_rowexpr_t where c4 <> 1;
+select count(*) from llvm_rowexpr_t where c8 <= '-9223372036854775808'::int8;
+select count(*) from llvm_rowexpr_t where c8 > 9223372036854775806;
+select count(*) from llvm_rowexpr_t where 0 < c4;
+select count(*) from llvm_rowexpr_t where 10000000000 > c4;
+select count(*) from llvm_rowexpr_t where c8 = c4;
+select count(*) from llvm_rowexpr_t where c4 > null::int4;
+select count(*) from llvm_rowexpr_t where not (c2 > 0);
+select count(*) from llvm_rowexpr_t where c4 * 2 > 0;
+
+reset enable_codegen;
+reset codegen_cost_threshold;
+drop table llvm_rowexpr_t;
+reset search_path;
+drop schema llvm_rowexpr;
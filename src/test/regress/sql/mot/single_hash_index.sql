@@ -0,0 +1,36 @@
+create foreign table mot_hash (x integer primary key, y integer, z varchar(10));
+create index mot_hash_y on mot_hash using hash (y);
+insert into mot_hash select i, i % 10, 'v' || i from generate_series(1, 100) i;
+
+-- point lookups
+explain (costs off) select * from mot_hash where y = 3 order by x;
+select * from mot_hash where y = 3 order by x;
+select count(*) from mot_hash where y = 10;
+select x from mot_hash where y = 7 and x > 50 order by x;
+
+-- duplicate keys
+insert into mot_hash values (101, 3, 'v101'), (102, 3, 'v102');
+select count(*) from mot_hash where y = 3;
+
+-- deletes
+delete from mot_hash where y = 3 and x < 50;
+select x from mot_hash where y = 3 order by x;
+delete from mot_hash where x = 101;
+select x from mot_hash where y = 3 order by x;
+delete from mot_hash where y = 3;
+select count(*) from mot_hash where y = 3;
+
+-- a deleted key can be inserted again
+insert into mot_hash values (3, 3, 'again');
+select * from mot_hash where y = 3;
+
+-- a rolled back delete leaves the key in place
+begin;
+delete from mot_hash where y = 5;
+rollback;
+select count(*) from mot_hash where y = 5;
+
+-- no equality on the key, the hash index is not used
+explain (costs off) select count(*) from mot_hash where y > 7;
+select count(*) from mot_hash where y > 7;
+drop foreign table mot_hash;
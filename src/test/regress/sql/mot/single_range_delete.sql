@@ -0,0 +1,23 @@
+create foreign table mot_range_del (x integer primary key, y integer);
+insert into mot_range_del select i, i % 3 from generate_series(1, 100) i;
+
+-- ranges on the primary key, with and without a filter
+delete from mot_range_del where x > 90 returning x;
+delete from mot_range_del where x >= 10 and x < 20 and y = 0 returning x;
+delete from mot_range_del where x > 200 returning x;
+select count(*) from mot_range_del;
+
+-- a prepared range delete, it is jitted only through the extended protocol, see the jit_range_delete_mot ha test
+prepare del_range(int, int) as delete from mot_range_del where x >= $1 and x <= $2;
+execute del_range(30, 39);
+select count(*) from mot_range_del where x between 30 and 39;
+execute del_range(30, 45);
+select count(*) from mot_range_del;
+deallocate del_range;
+
+-- a rolled back range delete
+begin;
+delete from mot_range_del where x < 10 returning x;
+rollback;
+select count(*) from mot_range_del;
+drop foreign table mot_range_del;
@@ -0,0 +1,35 @@
+--
+-- VECTORIZED SCAN
+--
+
+CREATE FOREIGN TABLE vec_mot (id int primary key, grp varchar(10), val numeric(10,2), note text) SERVER mot_server;
+
+-- more rows than a single batch holds
+INSERT INTO vec_mot SELECT g, 'g' || (g % 3), g * 1.5, CASE WHEN g % 5 = 0 THEN NULL ELSE 'n' || g END
+    FROM generate_series(1, 2500) g;
+
+SET try_vector_engine_strategy = force;
+
+EXPLAIN (COSTS OFF) SELECT count(*) AS cnt, sum(val) AS total, count(note) AS notes FROM vec_mot;
+
+SELECT count(*) AS cnt, sum(val) AS total, count(note) AS notes FROM vec_mot;
+
+-- local quals are evaluated on the batches
+SELECT grp, count(*) AS cnt, min(id) AS lo, max(id) AS hi FROM vec_mot
+    WHERE note IS NOT NULL AND id > 100 GROUP BY grp ORDER BY grp;
+
+-- index range scan
+EXPLAIN (COSTS OFF) SELECT count(*) AS cnt, sum(id) AS total FROM vec_mot WHERE id >= 900 AND id <= 2100;
+SELECT count(*) AS cnt, sum(id) AS total FROM vec_mot WHERE id >= 900 AND id <= 2100;
+
+SELECT id, note FROM vec_mot WHERE id IN (1, 5, 999, 1001, 2500) ORDER BY id;
+
+-- a unique point lookup is left to the row scan
+EXPLAIN (COSTS OFF) SELECT id, note FROM vec_mot WHERE id = 999;
+SELECT id, note FROM vec_mot WHERE id = 999;
+
+RESET try_vector_engine_strategy;
+
+SELECT count(*) AS cnt, sum(val) AS total, count(note) AS notes FROM vec_mot;
+
+DROP FOREIGN TABLE vec_mot;
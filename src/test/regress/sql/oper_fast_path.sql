@@ -0,0 +1,36 @@
+--
+-- operators evaluated through flattened argument steps must keep the
+-- strict NULL semantics, also when they are nested in other calls
+--
+create schema oper_fast_path;
+set search_path = oper_fast_path;
+
+create table fp_t (a int, b int);
+insert into fp_t values (1, 1), (1, 2), (2, null), (null, 3), (null, null), (3, 3);
+
+-- strict operators on Vars return NULL for a NULL argument
+select a, b, a + b as s, a = b as eq, a < b as lt from fp_t order by a nulls last, b nulls last;
+select count(*) from fp_t where a = b;
+select count(*) from fp_t where a < b;
+select count(*) from fp_t where a = null::int;
+select count(*) from fp_t where 2 > a;
+
+-- nested calls, the inner operator takes the flattened path, the outer one does not
+select count(*) from fp_t where (a + b) * 2 = 6;
+select count(*) from fp_t where abs(a - b) < 1;
+select count(*) from fp_t where int4pl(a, 1) > b;
+select count(*) from fp_t where coalesce(a, 0) + 1 > b;
+select count(*) from fp_t where (a = b) is null;
+
+-- function usage tracking turned on after the first executions
+prepare fp_q as select count(*) from fp_t where a < b or a = b;
+execute fp_q;
+set track_functions = 'all';
+execute fp_q;
+reset track_functions;
+execute fp_q;
+deallocate fp_q;
+
+drop table fp_t;
+reset search_path;
+drop schema oper_fast_path;
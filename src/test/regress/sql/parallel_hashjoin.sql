@@ -0,0 +1,71 @@
+--
+-- hashjoin with query_dop > 1, the SMP threads of a local broadcast share one
+-- hash table when enable_parallel_hash is on.  Row and vectorized hashjoins
+-- must return the same results with the shared table and without it.
+--
+create schema parallel_hashjoin;
+set search_path = parallel_hashjoin;
+
+create table ph_outer (a int, b int);
+insert into ph_outer select g % 200, g from generate_series(1, 10000) g;
+insert into ph_outer values (null, 0);
+create table ph_inner (a int, c int);
+insert into ph_inner select g, g from generate_series(1, 100) g;
+insert into ph_inner values (null, 0);
+create table ph_outer_col (a int, b int) with (orientation = column);
+insert into ph_outer_col select * from ph_outer;
+create table ph_inner_col (a int, c int) with (orientation = column);
+insert into ph_inner_col select * from ph_inner;
+analyze ph_outer;
+analyze ph_inner;
+analyze ph_outer_col;
+analyze ph_inner_col;
+
+set query_dop = 4;
+set enable_nestloop = off;
+set enable_mergejoin = off;
+set enable_hashjoin = on;
+
+-- per-thread hash tables
+set enable_parallel_hash = off;
+select count(*), sum(o.b) from ph_outer o join ph_inner i on o.a = i.a;
+select count(*), sum(i.c) from ph_outer o left join ph_inner i on o.a = i.a;
+select count(*), sum(o.b) from ph_outer o where exists (select 1 from ph_inner i where i.a = o.a);
+select count(*), sum(o.b) from ph_outer o where not exists (select 1 from ph_inner i where i.a = o.a);
+
+-- shared hash table
+set enable_parallel_hash = on;
+explain (costs off) select count(*), sum(o.b) from ph_outer o join ph_inner i on o.a = i.a;
+select count(*), sum(o.b) from ph_outer o join ph_inner i on o.a = i.a;
+select count(*), sum(i.c) from ph_outer o left join ph_inner i on o.a = i.a;
+select count(*), sum(o.b) from ph_outer o where exists (select 1 from ph_inner i where i.a = o.a);
+select count(*), sum(o.b) from ph_outer o where not exists (select 1 from ph_inner i where i.a = o.a);
+
+-- the same join run twice by a rescan of the subquery
+select count(*) from ph_inner x where x.a in (select o.a from ph_outer o join ph_inner i on o.a = i.a where o.b > x.c);
+
+-- vectorized hashjoin
+set enable_parallel_hash = off;
+select count(*), sum(o.b) from ph_outer_col o join ph_inner_col i on o.a = i.a;
+select count(*), sum(i.c) from ph_outer_col o left join ph_inner_col i on o.a = i.a;
+select count(*), sum(o.b) from ph_outer_col o where exists (select 1 from ph_inner_col i where i.a = o.a);
+select count(*), sum(o.b) from ph_outer_col o where not exists (select 1 from ph_inner_col i where i.a = o.a);
+
+set enable_parallel_hash = on;
+explain (costs off) select count(*), sum(o.b) from ph_outer_col o join ph_inner_col i on o.a = i.a;
+select count(*), sum(o.b) from ph_outer_col o join ph_inner_col i on o.a = i.a;
+select count(*), sum(i.c) from ph_outer_col o left join ph_inner_col i on o.a = i.a;
+select count(*), sum(o.b) from ph_outer_col o where exists (select 1 from ph_inner_col i where i.a = o.a);
+select count(*), sum(o.b) from ph_outer_col o where not exists (select 1 from ph_inner_col i where i.a = o.a);
+
+reset enable_parallel_hash;
+reset enable_hashjoin;
+reset enable_mergejoin;
+reset enable_nestloop;
+reset query_dop;
+drop table ph_outer;
+drop table ph_inner;
+drop table ph_outer_col;
+drop table ph_inner_col;
+reset search_path;
+drop schema parallel_hashjoin;
@@ -0,0 +1,55 @@
+--
+-- Scan prefetch through io_uring, results must not depend on it
+--
+create table uring_prefetch_tbl (id int, val text);
+insert into uring_prefetch_tbl select i, repeat('x', 100) from generate_series(1, 50000) i;
+create index uring_prefetch_idx on uring_prefetch_tbl (id);
+analyze uring_prefetch_tbl;
+
+-- vacuum full writes the new heap around shared buffers, so the scans below read cold blocks
+vacuum full uring_prefetch_tbl;
+
+-- sequential scan without prefetch, every block is a read of the scan
+set enable_uring_prefetch = off;
+begin;
+select count(*), sum(id) from uring_prefetch_tbl;
+select pg_stat_get_xact_blocks_hit('uring_prefetch_tbl'::regclass) * 2 <
+       pg_stat_get_xact_blocks_fetched('uring_prefetch_tbl'::regclass) as mostly_read;
+commit;
+
+vacuum full uring_prefetch_tbl;
+
+-- sequential scan with prefetch, the scan finds most blocks read already
+set enable_uring_prefetch = on;
+show enable_uring_prefetch;
+begin;
+select count(*), sum(id) from uring_prefetch_tbl;
+select pg_stat_get_xact_blocks_hit('uring_prefetch_tbl'::regclass) * 2 >
+       pg_stat_get_xact_blocks_fetched('uring_prefetch_tbl'::regclass) as mostly_prefetched;
+commit;
+select count(*) from uring_prefetch_tbl where id > 49000 and val like 'x%';
+
+vacuum full uring_prefetch_tbl;
+
+-- bitmap heap scan
+set enable_seqscan = off;
+set enable_indexscan = off;
+begin;
+select count(*), sum(id) from uring_prefetch_tbl where id between 1000 and 20000;
+select pg_stat_get_xact_blocks_hit('uring_prefetch_tbl'::regclass) * 2 >
+       pg_stat_get_xact_blocks_fetched('uring_prefetch_tbl'::regclass) as mostly_prefetched;
+commit;
+
+-- the guc can change between executor start and end of a scan
+begin;
+declare c cursor for select id from uring_prefetch_tbl where id between 1 and 3;
+fetch 1 from c;
+set enable_uring_prefetch = off;
+fetch 2 from c;
+close c;
+commit;
+
+reset enable_seqscan;
+reset enable_indexscan;
+reset enable_uring_prefetch;
+drop table uring_prefetch_tbl;
@@ -0,0 +1,35 @@
+--
+-- scan quals of column tables are evaluated in two phases, the columns read only
+-- by later conjuncts are filled for the rows passing the first one
+--
+create schema vec_late_qual;
+set current_schema = vec_late_qual;
+
+create table late_qual (a int, b int, c text, d numeric(10, 1), e int) with (orientation = column);
+insert into late_qual select i, i % 100, 'c' || (i % 7), i * 0.5, case when i % 10 = 0 then null else i % 13 end from generate_series(1, 100000) i;
+analyze late_qual;
+
+-- codegen off
+set enable_codegen = off;
+select count(*), sum(a) from late_qual where b = 3 and c = 'c5';
+select a, d, c from late_qual where b = 7 and e > 11 and a < 5000 order by a;
+select count(*) from late_qual where b = 1000 and c = 'c1';
+select count(*) from late_qual where b = 3 and c = 'c9';
+select count(*), min(a), max(a) from late_qual where b < 5 and e is null;
+select count(*), sum(a) from late_qual where b = 1 and (c = 'c1' or d > 49000);
+select count(*), sum(d), max(c) from late_qual where a > 99000 and e = 0;
+
+-- codegen on
+set enable_codegen = on;
+set codegen_cost_threshold = 0;
+select count(*), sum(a) from late_qual where b = 3 and c = 'c5';
+select a, d, c from late_qual where b = 7 and e > 11 and a < 5000 order by a;
+select count(*) from late_qual where b = 1000 and c = 'c1';
+select count(*) from late_qual where b = 3 and c = 'c9';
+select count(*), min(a), max(a) from late_qual where b < 5 and e is null;
+select count(*), sum(a) from late_qual where b = 1 and (c = 'c1' or d > 49000);
+select count(*), sum(d), max(c) from late_qual where a > 99000 and e = 0;
+
+reset codegen_cost_threshold;
+reset enable_codegen;
+drop schema vec_late_qual cascade;
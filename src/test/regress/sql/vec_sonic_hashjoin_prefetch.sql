@@ -0,0 +1,39 @@
+--
+-- Sonic hash join over a hash table large enough to be probed with prefetching
+--
+set enable_nestloop to off;
+set enable_mergejoin to off;
+set enable_hashjoin to on;
+set enable_sonic_hashjoin to on;
+set work_mem = '1GB';
+
+create table sonic_prefetch_dim (id int, name varchar(20), val numeric) with (orientation = column);
+create table sonic_prefetch_fact (dim_id int, amount bigint) with (orientation = column);
+insert into sonic_prefetch_dim select i, 'dim' || i, i * 1.5 from generate_series(1, 200000) i;
+insert into sonic_prefetch_fact select (i * 7919) % 250000, i from generate_series(1, 300000) i;
+analyze sonic_prefetch_dim;
+analyze sonic_prefetch_fact;
+
+explain (costs off) select count(*) from sonic_prefetch_fact f join sonic_prefetch_dim d on f.dim_id = d.id;
+
+select count(*), sum(f.amount), sum(d.val), count(distinct d.name)
+from sonic_prefetch_fact f join sonic_prefetch_dim d on f.dim_id = d.id;
+
+-- complicate join key
+select count(*), sum(f.amount) from sonic_prefetch_fact f join sonic_prefetch_dim d on f.dim_id + 1 = d.id + 1;
+
+-- probe rows repeatedly hitting the same buckets
+select count(*), sum(f.amount) from sonic_prefetch_fact f join sonic_prefetch_dim d on f.dim_id % 1000 = d.id;
+
+set enable_sonic_hashjoin to off;
+select count(*), sum(f.amount), sum(d.val), count(distinct d.name)
+from sonic_prefetch_fact f join sonic_prefetch_dim d on f.dim_id = d.id;
+select count(*), sum(f.amount) from sonic_prefetch_fact f join sonic_prefetch_dim d on f.dim_id % 1000 = d.id;
+
+reset enable_sonic_hashjoin;
+reset work_mem;
+reset enable_hashjoin;
+reset enable_mergejoin;
+reset enable_nestloop;
+drop table sonic_prefetch_fact;
+drop table sonic_prefetch_dim;
@@ -0,0 +1,9 @@
+--
+-- WAL flush histograms, one row per power-of-two bucket
+--
+select histogram, count(*), count(upper_bound) from gs_walwriter_flush_histogram() group by 1 order by 1;
+select lower_bound, upper_bound from gs_walwriter_flush_histogram() where histogram = 'flush_bytes' order by lower_bound limit 3;
+create table wal_flush_histogram_tbl (id int);
+insert into wal_flush_histogram_tbl select generate_series(1, 1000);
+select sum(flushes) > 0 from gs_walwriter_flush_histogram() where histogram = 'flush_time_us';
+drop table wal_flush_histogram_tbl;
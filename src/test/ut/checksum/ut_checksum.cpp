@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * ut_checksum.cpp
+ *        Every page checksum kernel must give the scalar result and the values
+ *        the checksum had before the kernels were added. With UT_BENCH set, the
+ *        benchmark prints the cost of each kernel the CPU supports.
+ *
+ *
+ * IDENTIFICATION
+ *        src/test/ut/checksum/ut_checksum.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "ut_checksum.h"
+#include "ut_bench.h"
+
+#include <stdlib.h>
+
+#include <iostream>
+
+#include "postgres.h"
+#include "storage/checksum_impl.h"
+
+using namespace std;
+
+GUNIT_TEST_REGISTRATION(UTChecksum, TestKnownAnswers)
+GUNIT_TEST_REGISTRATION(UTChecksum, TestKernelsMatchScalar)
+GUNIT_TEST_REGISTRATION(UTChecksum, TestZeroPadding)
+GUNIT_TEST_REGISTRATION(UTChecksum, TestBenchmark)
+
+#define TEST_ROW_SIZE (sizeof(uint32) * N_SUMS)
+#define TEST_PAGES 4
+#define BENCH_DEFAULT_LOOPS 100000
+
+/* a few pages, 64 bytes aligned, so that unaligned starts can be tried too */
+static uint32 g_pages[TEST_PAGES * BLCKSZ / sizeof(uint32) + 16] __attribute__((aligned(64)));
+
+static void FillRandom(unsigned int seed)
+{
+    srandom(seed);
+    for (size_t i = 0; i < lengthof(g_pages); i++) {
+        g_pages[i] = (uint32)random() ^ ((uint32)random() << 16);
+    }
+}
+
+typedef enum KnownPattern { PATTERN_ZEROES, PATTERN_ONES, PATTERN_SEQUENCE } KnownPattern;
+
+typedef struct KnownAnswer {
+    KnownPattern pattern;
+    uint32 size;
+    uint32 checksum;
+} KnownAnswer;
+
+/* computed by pg_checksum_block before the vectorized kernels were added */
+static const KnownAnswer g_knownAnswers[] = {
+    {PATTERN_ZEROES, 128, 0x8FBF3C9E},
+    {PATTERN_ZEROES, 1024, 0xD9BEB298},
+    {PATTERN_ZEROES, BLCKSZ, 0x54AF71FA},
+    {PATTERN_ONES, 128, 0xB552D7EA},
+    {PATTERN_ONES, 1024, 0x975A3047},
+    {PATTERN_ONES, BLCKSZ, 0x226FE1DD},
+    {PATTERN_SEQUENCE, 128, 0x0FED6B78},
+    {PATTERN_SEQUENCE, 1024, 0x9B3CA31E},
+    {PATTERN_SEQUENCE, BLCKSZ, 0xEFCE4236},
+};
+
+/* filled word by word, so that the answers don't depend on the byte order */
+static void FillPattern(uint32* page, KnownPattern pattern)
+{
+    for (uint32 i = 0; i < BLCKSZ / sizeof(uint32); i++) {
+        switch (pattern) {
+            case PATTERN_ZEROES:
+                page[i] = 0;
+                break;
+            case PATTERN_ONES:
+                page[i] = 0xFFFFFFFF;
+                break;
+            default:
+                page[i] = i * 2654435761U + 12345U;
+                break;
+        }
+    }
+}
+
+void UTChecksum::SetUp()
+{
+    FillRandom(1);
+}
+
+void UTChecksum::TearDown() {}
+
+void UTChecksum::TestKnownAnswers()
+{
+    for (size_t i = 0; i < lengthof(g_knownAnswers); i++) {
+        const KnownAnswer* answer = &g_knownAnswers[i];
+
+        FillPattern(g_pages, answer->pattern);
+        ASSERT_EQ(answer->checksum, pg_checksum_block((char*)g_pages, answer->size)) << i;
+        for (int k = CHECKSUM_KERNEL_SCALAR; k < CHECKSUM_KERNEL_NUM; k++) {
+            ChecksumKernel kernel = (ChecksumKernel)k;
+            if (pg_checksum_kernel_supported(kernel)) {
+                ASSERT_EQ(answer->checksum, pg_checksum_block_kernel(kernel, (char*)g_pages, answer->size))
+                    << pg_checksum_kernel_name(kernel) << " " << i;
+            }
+        }
+    }
+}
+
+void UTChecksum::TestKernelsMatchScalar()
+{
+    for (int round = 0; round < 1000; round++) {
+        char* data = (char*)g_pages + (round % 4) * sizeof(uint32);
+        uint32 size = TEST_ROW_SIZE * (1 + random() % (BLCKSZ / TEST_ROW_SIZE));
+        uint32 expected = pg_checksum_block_kernel(CHECKSUM_KERNEL_SCALAR, data, size);
+
+        for (int k = CHECKSUM_KERNEL_SCALAR + 1; k < CHECKSUM_KERNEL_NUM; k++) {
+            ChecksumKernel kernel = (ChecksumKernel)k;
+            if (pg_checksum_kernel_supported(kernel)) {
+                ASSERT_EQ(expected, pg_checksum_block_kernel(kernel, data, size)) << pg_checksum_kernel_name(kernel);
+            }
+        }
+        ASSERT_EQ(expected, pg_checksum_block(data, size));
+
+        if (round % 100 == 0) {
+            FillRandom(round);
+        }
+    }
+}
+
+void UTChecksum::TestZeroPadding()
+{
+    static uint32 padded[BLCKSZ / sizeof(uint32) + N_SUMS];
+
+    /* a partial last row counts as that row padded with zeroes */
+    for (uint32 size = 1; size <= BLCKSZ; size += 1 + random() % 97) {
+        uint32 paddedSize = (size + TEST_ROW_SIZE - 1) / TEST_ROW_SIZE * TEST_ROW_SIZE;
+
+        memset(padded, 0, sizeof(padded));
+        memcpy(padded, g_pages, size);
+        ASSERT_EQ(pg_checksum_block_kernel(CHECKSUM_KERNEL_SCALAR, (char*)padded, paddedSize),
+            DataBlockChecksum((char*)g_pages, size, true)) << size;
+    }
+}
+
+void UTChecksum::TestBenchmark()
+{
+    if (!UtBenchEnabled()) {
+        cout << "page checksum benchmark skipped, set " UT_BENCH_ENV " to run it" << endl;
+        return;
+    }
+
+    int loops = UtGetEnvInt("CHECKSUM_BENCH_LOOPS", BENCH_DEFAULT_LOOPS);
+    volatile uint32 sink = 0;
+
+    cout << "page checksum kernel in use: " << pg_checksum_kernel_name(pg_checksum_current_kernel()) << endl;
+
+    for (int k = CHECKSUM_KERNEL_SCALAR; k < CHECKSUM_KERNEL_NUM; k++) {
+        ChecksumKernel kernel = (ChecksumKernel)k;
+        double start, elapsed;
+
+        if (!pg_checksum_kernel_supported(kernel)) {
+            cout << pg_checksum_kernel_name(kernel) << ": not supported" << endl;
+            continue;
+        }
+
+        start = UtNowSeconds();
+        for (int i = 0; i < loops; i++) {
+            sink ^= pg_checksum_block_kernel(kernel, (char*)g_pages + (i % TEST_PAGES) * BLCKSZ, BLCKSZ);
+        }
+        elapsed = UtNowSeconds() - start;
+
+        cout << pg_checksum_kernel_name(kernel) << ": " << elapsed * 1e9 / loops << " ns/page, "
+             << (double)loops * BLCKSZ / elapsed / (1024 * 1024 * 1024) << " GB/s" << endl;
+    }
+    (void)sink;
+}
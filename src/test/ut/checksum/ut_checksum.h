@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * ut_checksum.h
+ *        Header file of the page checksum kernel tests and benchmark
+ *
+ *
+ * IDENTIFICATION
+ *        src/test/ut/checksum/ut_checksum.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef UT_CHECKSUM_H
+#define UT_CHECKSUM_H
+
+#include "gunit_test.h"
+
+class UTChecksum : public testing::Test {
+
+    GUNIT_TEST_SUITE(UTChecksum);
+
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+public:
+    void TestKnownAnswers();
+    void TestKernelsMatchScalar();
+    void TestZeroPadding();
+    void TestBenchmark();
+};
+
+#endif
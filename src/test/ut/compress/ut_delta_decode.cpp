@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * ut_delta_decode.cpp
+ *        The SIMD delta decompressing kernels must give the same values as
+ *        a plain byte by byte decode, for every delta and value size, any
+ *        count of values left to the tail and min values that make the
+ *        results negative or wrap around.
+ *
+ *
+ * IDENTIFICATION
+ *        src/test/ut/compress/ut_delta_decode.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "ut_delta_decode.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "postgres.h"
+#include "storage/delta_decode_impl.h"
+
+GUNIT_TEST_REGISTRATION(UTDeltaDecode, TestKernelsMatchScalar)
+GUNIT_TEST_REGISTRATION(UTDeltaDecode, TestNegativeValues)
+
+#define TEST_MAX_VALS 67 /* more than two AVX2 registers of 2 byte values, and an odd tail */
+
+static char g_deltas[TEST_MAX_VALS * 7];
+static char g_expected[TEST_MAX_VALS * sizeof(int64)];
+static char g_actual[TEST_MAX_VALS * sizeof(int64) + 1];
+
+static const short g_outValSizes[] = {sizeof(int16), sizeof(int32), sizeof(int64)};
+
+static void FillDeltas(unsigned int seed)
+{
+    srandom(seed);
+    for (size_t i = 0; i < sizeof(g_deltas); i++) {
+        g_deltas[i] = (char)random();
+    }
+}
+
+/* little-endian deltas plus the min value, truncated to outValSize bytes */
+static void DecodeReference(short inValSize, short outValSize, int nvals, int64 minVal)
+{
+    const uint8* in = (const uint8*)g_deltas;
+
+    for (int i = 0; i < nvals; i++) {
+        uint64 val = (uint64)minVal;
+        uint64 delta = 0;
+        for (short b = 0; b < inValSize; b++) {
+            delta |= (uint64)in[i * inValSize + b] << (8 * b);
+        }
+        val += delta;
+        for (short b = 0; b < outValSize; b++) {
+            g_expected[i * outValSize + b] = (char)(val >> (8 * b));
+        }
+    }
+}
+
+/* decode nvals deltas with the kernel and compare with the reference */
+static void CheckDecompress(short inValSize, short outValSize, int nvals, int64 minVal)
+{
+    int outsize = nvals * outValSize;
+
+    memset(g_actual, 0xa5, sizeof(g_actual));
+    if (!DeltaDecodeSimd(g_deltas, g_actual, (uint32)nvals, inValSize, outValSize, minVal)) {
+        /* no kernel on this CPU, nothing may be written */
+        ASSERT_EQ((char)0xa5, g_actual[0]);
+        return;
+    }
+    DecodeReference(inValSize, outValSize, nvals, minVal);
+    ASSERT_EQ(0, memcmp(g_expected, g_actual, outsize))
+        << "delta size " << inValSize << ", value size " << outValSize << ", " << nvals << " values, min " << minVal;
+
+    /* nothing is written behind the values */
+    ASSERT_EQ((char)0xa5, g_actual[outsize]);
+}
+
+void UTDeltaDecode::SetUp()
+{
+    FillDeltas(1);
+}
+
+void UTDeltaDecode::TearDown() {}
+
+void UTDeltaDecode::TestKernelsMatchScalar()
+{
+    const int64 minVals[] = {0, 1, 1000, 0x7fffffffLL, 0x123456789aLL};
+
+    for (size_t o = 0; o < lengthof(g_outValSizes); o++) {
+        short outValSize = g_outValSizes[o];
+        for (short inValSize = 1; inValSize < outValSize && inValSize <= 7; inValSize++) {
+            for (int nvals = 1; nvals <= TEST_MAX_VALS; nvals++) {
+                for (size_t m = 0; m < lengthof(minVals); m++) {
+                    CheckDecompress(inValSize, outValSize, nvals, minVals[m]);
+                }
+            }
+            FillDeltas(outValSize * 8 + inValSize);
+        }
+    }
+}
+
+void UTDeltaDecode::TestNegativeValues()
+{
+    const int64 minVals[] = {-1, -32768, -2147483648LL, -0x123456789aLL, PG_INT64_MIN, PG_INT64_MIN + 1};
+
+    /* deltas with the high bit of each byte set, so that sign extension would show */
+    memset(g_deltas, 0xff, sizeof(g_deltas));
+    for (size_t o = 0; o < lengthof(g_outValSizes); o++) {
+        short outValSize = g_outValSizes[o];
+        for (short inValSize = 1; inValSize < outValSize && inValSize <= 7; inValSize++) {
+            for (int nvals = 1; nvals <= TEST_MAX_VALS; nvals++) {
+                for (size_t m = 0; m < lengthof(minVals); m++) {
+                    CheckDecompress(inValSize, outValSize, nvals, minVals[m]);
+                }
+            }
+        }
+    }
+
+    /* small deltas on a negative min give negative values */
+    memset(g_deltas, 0x01, sizeof(g_deltas));
+    for (size_t o = 0; o < lengthof(g_outValSizes); o++) {
+        for (int nvals = 1; nvals <= TEST_MAX_VALS; nvals++) {
+            CheckDecompress(1, g_outValSizes[o], nvals, -100);
+        }
+    }
+}
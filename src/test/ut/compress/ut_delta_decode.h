@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * ut_delta_decode.h
+ *        Header file of the delta decompression kernel tests
+ *
+ *
+ * IDENTIFICATION
+ *        src/test/ut/compress/ut_delta_decode.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef UT_DELTA_DECODE_H
+#define UT_DELTA_DECODE_H
+
+#include "gunit_test.h"
+
+class UTDeltaDecode : public testing::Test {
+
+    GUNIT_TEST_SUITE(UTDeltaDecode);
+
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+public:
+    void TestKernelsMatchScalar();
+    void TestNegativeValues();
+};
+
+#endif
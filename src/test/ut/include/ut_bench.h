@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * ut_bench.h
+ *        Helpers of the benchmarks that come with some unit tests. A benchmark
+ *        only prints numbers, so it is skipped unless UT_BENCH is set in the
+ *        environment; its length is tuned by its own environment variables.
+ *
+ *
+ * IDENTIFICATION
+ *        src/test/ut/include/ut_bench.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef UT_BENCH_H
+#define UT_BENCH_H
+
+#include <stdlib.h>
+#include <time.h>
+
+#define UT_BENCH_ENV "UT_BENCH"
+
+static inline bool UtBenchEnabled()
+{
+    return getenv(UT_BENCH_ENV) != NULL;
+}
+
+static inline int UtGetEnvInt(const char* name, int defaultValue)
+{
+    const char* value = getenv(name);
+    return (value != NULL) ? atoi(value) : defaultValue;
+}
+
+static inline double UtNowSeconds()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#endif
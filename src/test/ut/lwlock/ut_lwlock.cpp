@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * ut_lwlock.cpp
+ *        The cohort policy must prefer same-node waiters while serving the queue
+ *        head within a bounded number of handovers. With UT_BENCH set, the
+ *        benchmark hands a lock over between threads with FIFO and cohort order
+ *        and prints the rate, the share of cross-node handovers and the worst
+ *        head bypass.
+ *
+ *
+ * IDENTIFICATION
+ *        src/test/ut/lwlock/ut_lwlock.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "ut_lwlock.h"
+#include "ut_bench.h"
+
+#include <pthread.h>
+
+#include <deque>
+#include <iostream>
+
+#include "postgres.h"
+#include "storage/lock/lwlock_cohort.h"
+
+using namespace std;
+
+GUNIT_TEST_REGISTRATION(UTLWLockCohort, TestPreferLocalWaiter)
+GUNIT_TEST_REGISTRATION(UTLWLockCohort, TestBoundedBypass)
+GUNIT_TEST_REGISTRATION(UTLWLockCohort, TestHandoverBenchmark)
+
+#define BENCH_DEFAULT_LOOPS 200000
+#define BENCH_DEFAULT_THREADS 16
+#define BENCH_DEFAULT_NODES 2
+#define BENCH_MAX_THREADS 256
+
+void UTLWLockCohort::SetUp() {}
+
+void UTLWLockCohort::TearDown() {}
+
+void UTLWLockCohort::TestPreferLocalWaiter()
+{
+    LWLockCohortWaiter waiters[] = {{1, true}, {1, false}, {0, false}, {0, true}, {0, true}};
+    uint8 passes = 0;
+
+    /* the first exclusive waiter of the releaser's node, shared ones are not taken out of order */
+    ASSERT_EQ(3, LWLockCohortChoose(waiters, lengthof(waiters), 0, &passes));
+    ASSERT_EQ(1, passes);
+
+    /* a local head is simply served */
+    ASSERT_EQ(0, LWLockCohortChoose(waiters, lengthof(waiters), 1, &passes));
+    ASSERT_EQ(0, passes);
+
+    /* nobody of the releaser's node waits */
+    ASSERT_EQ(0, LWLockCohortChoose(waiters, lengthof(waiters), 2, &passes));
+    ASSERT_EQ(0, passes);
+}
+
+void UTLWLockCohort::TestBoundedBypass()
+{
+    LWLockCohortWaiter waiters[] = {{1, true}, {0, true}};
+    uint8 passes = 0;
+    int bypassed = 0;
+
+    /* node 0 keeps releasing and re-queueing, the node 1 head must still get the lock */
+    while (LWLockCohortChoose(waiters, lengthof(waiters), 0, &passes) != 0) {
+        bypassed++;
+        ASSERT_LE(bypassed, LWLOCK_COHORT_MAX_PASSES);
+    }
+    ASSERT_EQ(LWLOCK_COHORT_MAX_PASSES, bypassed);
+    ASSERT_EQ(0, passes);
+}
+
+typedef struct BenchWaiter {
+    int nodeno;
+    bool granted;
+    pthread_cond_t cond;
+} BenchWaiter;
+
+/* a queue lock handing ownership over directly to the chosen waiter, like LWLockWakeup does */
+typedef struct BenchLock {
+    pthread_mutex_t mutex;
+    bool held;
+    bool cohort;
+    int holderNode;
+    uint8 passes;
+    int headBypass;
+    int maxHeadBypass;
+    long handovers;
+    long crossNode;
+    deque<BenchWaiter*> queue;
+    volatile long data[16]; /* what the lock protects, a few cache lines */
+} BenchLock;
+
+typedef struct BenchThread {
+    BenchLock* lock;
+    pthread_barrier_t* start;
+    int nodeno;
+    int loops;
+    pthread_t tid;
+} BenchThread;
+
+static void BenchAcquire(BenchLock* lock, int nodeno)
+{
+    BenchWaiter self;
+
+    pthread_mutex_lock(&lock->mutex);
+    if (!lock->held && lock->queue.empty()) {
+        lock->held = true;
+    } else {
+        self.nodeno = nodeno;
+        self.granted = false;
+        pthread_cond_init(&self.cond, NULL);
+        lock->queue.push_back(&self);
+        while (!self.granted) {
+            pthread_cond_wait(&self.cond, &lock->mutex);
+        }
+        pthread_cond_destroy(&self.cond);
+    }
+    lock->holderNode = nodeno;
+    pthread_mutex_unlock(&lock->mutex);
+}
+
+static void BenchRelease(BenchLock* lock)
+{
+    pthread_mutex_lock(&lock->mutex);
+    if (lock->queue.empty()) {
+        lock->held = false;
+        pthread_mutex_unlock(&lock->mutex);
+        return;
+    }
+
+    int chosen = 0;
+    if (lock->cohort) {
+        LWLockCohortWaiter waiters[LWLOCK_COHORT_SCAN_DEPTH];
+        int nwaiters = 0;
+        for (; nwaiters < LWLOCK_COHORT_SCAN_DEPTH && nwaiters < (int)lock->queue.size(); nwaiters++) {
+            waiters[nwaiters].nodeno = lock->queue[nwaiters]->nodeno;
+            waiters[nwaiters].exclusive = true;
+        }
+        chosen = LWLockCohortChoose(waiters, nwaiters, lock->holderNode, &lock->passes);
+    }
+    lock->headBypass = (chosen == 0) ? 0 : lock->headBypass + 1;
+    lock->maxHeadBypass = Max(lock->maxHeadBypass, lock->headBypass);
+
+    BenchWaiter* waiter = lock->queue[chosen];
+    lock->queue.erase(lock->queue.begin() + chosen);
+    lock->handovers++;
+    if (waiter->nodeno != lock->holderNode) {
+        lock->crossNode++;
+    }
+    waiter->granted = true;
+    pthread_cond_signal(&waiter->cond);
+    pthread_mutex_unlock(&lock->mutex);
+}
+
+static void* BenchThreadMain(void* arg)
+{
+    BenchThread* thread = (BenchThread*)arg;
+
+    /* all threads contend from the beginning */
+    pthread_barrier_wait(thread->start);
+    for (int i = 0; i < thread->loops; i++) {
+        BenchAcquire(thread->lock, thread->nodeno);
+        for (int j = 0; j < (int)lengthof(thread->lock->data); j++) {
+            thread->lock->data[j]++;
+        }
+        BenchRelease(thread->lock);
+    }
+    return NULL;
+}
+
+void UTLWLockCohort::TestHandoverBenchmark()
+{
+    if (!UtBenchEnabled()) {
+        cout << "lock handover benchmark skipped, set " UT_BENCH_ENV " to run it" << endl;
+        return;
+    }
+
+    int loops = UtGetEnvInt("LWLOCK_BENCH_LOOPS", BENCH_DEFAULT_LOOPS);
+    int nthreads = Min(Max(UtGetEnvInt("LWLOCK_BENCH_THREADS", BENCH_DEFAULT_THREADS), 1), BENCH_MAX_THREADS);
+    int nodes = Max(UtGetEnvInt("LWLOCK_BENCH_NODES", BENCH_DEFAULT_NODES), 1);
+    static BenchThread threads[BENCH_MAX_THREADS];
+
+    cout << "lock handover: " << nthreads << " threads on " << nodes << " nodes, " << loops << " loops in total"
+         << endl;
+
+    for (int cohort = 0; cohort <= 1; cohort++) {
+        BenchLock* lock = new BenchLock();
+        pthread_mutex_init(&lock->mutex, NULL);
+        lock->cohort = (cohort == 1);
+        pthread_barrier_t startBarrier;
+        pthread_barrier_init(&startBarrier, NULL, (unsigned)nthreads);
+
+        double start = UtNowSeconds();
+        for (int i = 0; i < nthreads; i++) {
+            threads[i].lock = lock;
+            threads[i].start = &startBarrier;
+            threads[i].nodeno = i % nodes;
+            threads[i].loops = loops / nthreads;
+            ASSERT_EQ(0, pthread_create(&threads[i].tid, NULL, BenchThreadMain, &threads[i]));
+        }
+        for (int i = 0; i < nthreads; i++) {
+            pthread_join(threads[i].tid, NULL);
+        }
+        double elapsed = UtNowSeconds() - start;
+        pthread_barrier_destroy(&startBarrier);
+
+        ASSERT_EQ((long)(loops / nthreads) * nthreads, lock->data[0]);
+        ASSERT_LE(lock->maxHeadBypass, LWLOCK_COHORT_MAX_PASSES);
+
+        cout << (lock->cohort ? "cohort" : "fifo") << ": " << (double)lock->handovers / elapsed << " handovers/s, "
+             << (lock->handovers > 0 ? 100.0 * lock->crossNode / lock->handovers : 0.0) << "% cross-node, "
+             << "max head bypass " << lock->maxHeadBypass << endl;
+
+        pthread_mutex_destroy(&lock->mutex);
+        delete lock;
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * ut_lwlock.h
+ *        Header file of the LWLock NUMA cohort handover tests and benchmark
+ *
+ *
+ * IDENTIFICATION
+ *        src/test/ut/lwlock/ut_lwlock.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef UT_LWLOCK_H
+#define UT_LWLOCK_H
+
+#include "gunit_test.h"
+
+class UTLWLockCohort : public testing::Test {
+
+    GUNIT_TEST_SUITE(UTLWLockCohort);
+
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+public:
+    void TestPreferLocalWaiter();
+    void TestBoundedBypass();
+    void TestHandoverBenchmark();
+};
+
+#endif